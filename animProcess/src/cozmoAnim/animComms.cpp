@@ -14,9 +14,7 @@
 
 #include "anki/cozmo/shared/cozmoConfig.h"
 
-#include "coretech/messaging/shared/LocalUdpClient.h"
-#include "coretech/messaging/shared/LocalUdpServer.h"
-#include "coretech/messaging/shared/SocketUtils.h"
+#include "coretech/messaging/shared/LocalTransport.h"
 #include "coretech/messaging/shared/socketConstants.h"
 #include "util/histogram/histogram.h"
 #include "util/logging/logging.h"
@@ -54,10 +52,10 @@ namespace AnimComms {
 
 namespace { // "Private members"
 
-  LocalUdpServer _engineComms;
+  LocalTransportServer _engineComms;
 
   // For comms with robot
-  LocalUdpClient _robotComms;
+  LocalTransportClient _robotComms;
 }
 
 
@@ -78,26 +76,24 @@ void InitSocketBufferStats()
   InitSocketBufferStats(_engineStats);
 }
 
-void UpdateSocketBufferStats(SocketBufferStats & stats, int socket)
+template <class Comms>
+void UpdateSocketBufferStats(SocketBufferStats & stats, const Comms & comms)
 {
-  if (socket >= 0) {
-    const auto incoming = Anki::Messaging::GetIncomingSize(socket);
-    DEV_ASSERT(incoming >= 0, "AnimComms.UpdateSocketBufferStats.InvalidIncoming");
-    if (incoming >= 0) {
-      stats._incoming->Record(incoming);
-    }
-    const auto outgoing = Anki::Messaging::GetOutgoingSize(socket);
-    DEV_ASSERT(outgoing >= 0, "AnimComms.UpdateSocketBufferStats.InvalidOutgoing");
-    if (outgoing >= 0) {
-      stats._outgoing->Record(outgoing);
-    }
+  // Sizes are -1 while there is no connection
+  const auto incoming = comms.GetIncomingSize();
+  if (incoming >= 0) {
+    stats._incoming->Record(incoming);
+  }
+  const auto outgoing = comms.GetOutgoingSize();
+  if (outgoing >= 0) {
+    stats._outgoing->Record(outgoing);
   }
 }
 
 void UpdateSocketBufferStats()
 {
-  UpdateSocketBufferStats(_robotStats, _robotComms.GetSocket());
-  UpdateSocketBufferStats(_engineStats, _engineComms.GetSocket());
+  UpdateSocketBufferStats(_robotStats, _robotComms);
+  UpdateSocketBufferStats(_engineStats, _engineComms);
 }
 
 
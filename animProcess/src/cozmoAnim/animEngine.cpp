@@ -59,10 +59,11 @@ AnimEngine::AnimEngine(Util::Data::DataPlatform* dataPlatform)
   , _animationStreamer(std::make_unique<AnimationStreamer>(_context.get()))
 {
 #if ANKI_CPU_PROFILER_ENABLED
-  // Initialize CPU profiler early and put tracing file at known location with no dependencies on other systems
+  // Initialize CPU profiler early and put trace captures at known location with no dependencies on other systems.
+  // Every process captures to the same directory, so their traces can be loaded side by side.
   Anki::Util::CpuProfiler::GetInstance();
-  Anki::Util::CpuThreadProfiler::SetChromeTracingFile(
-      dataPlatform->pathToResource(Util::Data::Scope::Cache, "vic-anim-tracing.json").c_str());
+  Anki::Util::CpuTraceRecorder::GetInstance().Init(
+      dataPlatform->pathToResource(Util::Data::Scope::Cache, "tracing"), "vic-anim");
   Anki::Util::CpuThreadProfiler::SendToWebVizCallback([&](const Json::Value& json) { _context->GetWebService()->SendToWebViz("cpuprofile", json); });
 #endif
 
@@ -84,6 +85,11 @@ AnimEngine::~AnimEngine()
   AnimComms::ReportSocketBufferStats();
 #endif
 
+#if ANKI_CPU_PROFILER_ENABLED
+  // Close off any capture still running, so the trace isn't left unfinished
+  Anki::Util::CpuTraceRecorder::GetInstance().StopCapture();
+#endif
+
   if (Anki::Util::gTickTimeProvider == BaseStationTimer::getInstance()) {
     Anki::Util::gTickTimeProvider = nullptr;
   }
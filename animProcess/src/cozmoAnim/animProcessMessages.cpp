@@ -963,6 +963,7 @@ Result AnimProcessMessages::Update(BaseStationTime_t currTime_nanosec)
         LOG_WARNING("AnimProcessMessages.Update.EngineToRobot.InvalidData", "Invalid message from engine");
         continue;
       }
+      ANKI_CPU_TRACE_SPAN("message", RobotInterface::EngineToRobot::TagToString(msg.tag));
       ProcessMessageFromEngine(msg);
     }
   }
@@ -986,6 +987,7 @@ Result AnimProcessMessages::Update(BaseStationTime_t currTime_nanosec)
         LOG_WARNING("AnimProcessMessages.Update.RobotToEngine.InvalidData", "Invalid message from robot");
         continue;
       }
+      ANKI_CPU_TRACE_SPAN("message", RobotInterface::RobotToEngine::TagToString(msg.tag));
       ProcessMessageFromRobot(msg);
       _proceduralAudioClient->ProcessMessage(msg);
     }
@@ -406,7 +406,7 @@ namespace Anim {
     DEV_ASSERT(nullptr != _context, "AnimationStreamer.Init.NullContext");
     DEV_ASSERT(nullptr != _context->GetDataLoader(), "AnimationStreamer.Init.NullRobotDataLoader");
     const std::string neutralFaceAnimName = "anim_neutral_eyes_01";
-    _neutralFaceAnimation = _context->GetDataLoader()->GetCannedAnimation(neutralFaceAnimName);
+    _neutralFaceAnimation = _context->GetDataLoader()->GetPinnedCannedAnimation(neutralFaceAnimName);
     if (nullptr != _neutralFaceAnimation)
     {
       auto frame = _neutralFaceAnimation->GetTrack<ProceduralFaceKeyFrame>().GetFirstKeyFrame();
@@ -472,9 +472,19 @@ namespace Anim {
       Abort();
       return RESULT_OK;
     }
-    auto* anim = _context->GetDataLoader()->GetCannedAnimation(name);
-    return SetStreamingAnimation(anim, tag, numLoops, startAt_ms, interruptRunning,
-                                 shouldOverrideEyeHue, shouldRenderInEyeHue, false);
+    // Pinned until it stops streaming, since it may have been lazily loaded and other animations are looked up
+    // (and so may cause it to be freed) while it streams
+    auto* anim = _context->GetDataLoader()->GetPinnedCannedAnimation(name);
+    const Result result = SetStreamingAnimation(anim, tag, numLoops, startAt_ms, interruptRunning,
+                                                shouldOverrideEyeHue, shouldRenderInEyeHue, false);
+    if ((nullptr != anim) && (_streamingAnimation == anim)) {
+      // Setting it aborted and unpinned whatever was streaming before
+      DEV_ASSERT(_pinnedAnimationName.empty(), "AnimationStreamer.SetStreamingAnimation.AlreadyPinned");
+      _pinnedAnimationName = name;
+    } else {
+      _context->GetDataLoader()->UnpinCannedAnimation(name);
+    }
+    return result;
   }
 
   void AnimationStreamer::SetPendingStreamingAnimation(const std::string& name, u32 numLoops)
@@ -819,6 +829,7 @@ namespace Anim {
     // Hack: if _streamingAnimation == _proceduralAnimation, the subsequent CopyIntoProceduralAnimation call
     // will delete *_streamingAnimation without assigning it to nullptr. This assignment prevents associated
     // undefined behavior
+    UnpinStreamingAnimation();
     _streamingAnimation = _neutralFaceAnimation;
     CopyIntoProceduralAnimation(_context->GetDataLoader()->GetCannedAnimation(name));
     SetStreamingAnimation(_proceduralAnimation, tag, numLoops, startAtTime_ms, interruptRunning,
@@ -998,6 +1009,7 @@ namespace Anim {
 
       // Reset animation pointer
       _streamingAnimation = nullptr;
+      UnpinStreamingAnimation();
 
       // If we get to KeepFaceAlive with this flag set, we'll stream neutral face for safety.
       _wasAnimationInterruptedWithNothing = true;
@@ -1796,6 +1808,7 @@ namespace Anim {
           }
 
           _streamingAnimation = nullptr;
+          UnpinStreamingAnimation();
         }
 
       } // if (IsStreamingAnimFinished())
@@ -2035,6 +2048,15 @@ namespace Anim {
            !_streamingAnimation->HasFramesLeft();
   }
 
+  void AnimationStreamer::UnpinStreamingAnimation()
+  {
+    if (!_pinnedAnimationName.empty())
+    {
+      _context->GetDataLoader()->UnpinCannedAnimation(_pinnedAnimationName);
+      _pinnedAnimationName.clear();
+    }
+  }
+
   void AnimationStreamer::ResetKeepFaceAliveLastStreamTimeout()
   {
     _longEnoughSinceLastStreamTimeout_s = kDefaultLongEnoughSinceLastStreamTimeout_s;
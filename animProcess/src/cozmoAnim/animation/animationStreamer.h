@@ -211,6 +211,9 @@ namespace Anim {
     Animation*  _streamingAnimation = nullptr;
     Animation*  _neutralFaceAnimation = nullptr;
 
+    // Name of the canned animation pinned while it is streaming, so that lazy loading can't free it mid-stream
+    std::string _pinnedAnimationName;
+
      // for creating animations "live" or dynamically
     Animation*  _proceduralAnimation = nullptr;
 
@@ -391,6 +394,9 @@ namespace Anim {
     // Check whether the animation is done
     bool IsStreamingAnimFinished() const;
 
+    // Unpin the canned animation that was streaming, if any. Call whenever _streamingAnimation stops pointing at it
+    void UnpinStreamingAnimation();
+
     void StopTracks(const u8 whichTracks);
 
     // In case we are aborting an animation, stop any tracks that were in use
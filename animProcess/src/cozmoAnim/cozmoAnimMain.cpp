@@ -18,6 +18,7 @@
 
 #include "util/fileUtils/fileUtils.h"
 #include "util/logging/logging.h"
+#include "util/logging/binaryLogger.h"
 #include "util/logging/channelFilter.h"
 #include "util/logging/victorLogger.h"
 
@@ -146,6 +147,16 @@ int main(void)
     Anki::Util::gLoggerProvider->SetFilter(filterPtr);
   }
 
+  // Defer formatting of info/debug logs to a background thread, see util/logging/binaryLogger.h
+  std::unique_ptr<Util::BinaryLogger> binaryLogger;
+  if (getenv("VIC_BINARY_LOGGING") != nullptr)
+  {
+    const std::string& binaryLogPath = dataPlatform->GetCurrentGameLogPath(std::string(LOG_PROCNAME) + "-binary");
+    binaryLogger = std::make_unique<Util::BinaryLogger>(binaryLogPath, true);
+    Util::gBinaryLogger = binaryLogger.get();
+    LOG_INFO("CozmoAnimMain.main", "Binary logging to %s", binaryLogPath.c_str());
+  }
+
   // Set up the console vars to load from file, if it exists
   ANKI_CONSOLE_SYSTEM_INIT(dataPlatform->pathToResource(Anki::Util::Data::Scope::Cache, "consoleVarsAnim.ini").c_str());
 
@@ -156,6 +167,8 @@ int main(void)
   if (RESULT_OK != result) {
     LOG_ERROR("CozmoAnimMain.main.InitFailed", "Unable to initialize (exit %d)", result);
     delete animEngine;
+    Util::gBinaryLogger = nullptr;
+    binaryLogger.reset();
     Util::gLoggerProvider = nullptr;
     Util::gEventProvider = nullptr;
     UninstallCrashReporter();
@@ -247,6 +260,9 @@ int main(void)
 
   delete animEngine;
 
+  Util::gBinaryLogger = nullptr;
+  binaryLogger.reset();
+
   Util::gLoggerProvider = nullptr;
   Util::gEventProvider = nullptr;
 
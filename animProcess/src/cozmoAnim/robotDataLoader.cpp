@@ -41,6 +41,7 @@
 #include <json/json.h>
 #include <string>
 #include <sys/stat.h>
+#include <unistd.h>
 
 #define LOG_CHANNEL   "RobotDataLoader"
 
@@ -53,7 +54,25 @@ const char* kPathToExternalIndependentSprites = "assets/sprites/independentSprit
 const char* kPathToEngineIndependentSprites = "config/devOnlySprites/independentSprites/";
 const char* kPathToExternalSpriteSequences = "assets/sprites/spriteSequences/";
 const char* kPathToEngineSpriteSequences   = "config/devOnlySprites/spriteSequences/";
+const char* kPathToSpriteAtlas = "assets/sprites/spriteAtlas.bin";
 const char* kProceduralAnimName = "_PROCEDURAL_";
+
+// Canned animations in binary files are memory mapped and indexed at load time, and only decoded the first time
+// they are played, keeping at most kMaxDecodedCannedAnimations of them decoded. Only read when loading
+CONSOLE_VAR(bool, kLazyLoadCannedAnimations, "AnimationLoading", true);
+CONSOLE_VAR_RANGED(int, kMaxDecodedCannedAnimations, "AnimationLoading", 32, 4, 1024);
+
+// Resident set size of this process, or 0 where /proc isn't available
+size_t GetResidentMemory_kB()
+{
+  const std::string statm = Util::FileUtils::ReadFile("/proc/self/statm");
+  unsigned long totalPages = 0;
+  unsigned long residentPages = 0;
+  if (sscanf(statm.c_str(), "%lu %lu", &totalPages, &residentPages) != 2) {
+    return 0;
+  }
+  return (residentPages * sysconf(_SC_PAGESIZE)) / 1024;
+}
 }
 
 RobotDataLoader::RobotDataLoader(const AnimContext* context)
@@ -135,6 +154,7 @@ void RobotDataLoader::LoadNonConfigData()
   //  2) SpriteSequences use sprite map to load sequenceName -> all images in sequence directory
   //  3) Canned animations use SpriteSequences for their FaceAnimation keyframe
   LoadIndependentSpritePaths();
+  _spriteCache->LoadAtlas(_platform->GetResourcePath(kPathToSpriteAtlas), _platform->GetResourcePath(""));
   {
     std::vector<std::string> spriteSequenceDirs = {kPathToExternalSpriteSequences, kPathToEngineSpriteSequences};
     SpriteSequenceLoader seqLoader;
@@ -146,8 +166,14 @@ void RobotDataLoader::LoadNonConfigData()
   }
 
   {
+    const double startTime_ms = Util::Time::UniversalTime::GetCurrentTimeInMilliseconds();
+    const size_t startMem_kB = GetResidentMemory_kB();
+
     // Set up container
     _cannedAnimations = std::make_unique<CannedAnimationContainer>();
+    if (kLazyLoadCannedAnimations) {
+      _cannedAnimations->EnableLazyLoading(_spriteSequenceContainer.get(), kMaxDecodedCannedAnimations);
+    }
 
     // Gather the files to load into the animation container
     CannedAnimationLoader animLoader(_platform,
@@ -168,6 +194,12 @@ void RobotDataLoader::LoadNonConfigData()
     // Load the gathered files into the container
     const auto& fileInfo = animLoader.CollectAnimFiles(paths);
     animLoader.LoadAnimationsIntoContainer(fileInfo, _cannedAnimations.get());
+
+    const double loadTime_ms = Util::Time::UniversalTime::GetCurrentTimeInMilliseconds() - startTime_ms;
+    const size_t endMem_kB = GetResidentMemory_kB();
+    LOG_INFO("RobotDataLoader.LoadNonConfigData.CannedAnimations",
+             "Loaded %zu files in %.1f ms (lazy=%d), resident memory %zu kB -> %zu kB",
+             fileInfo.jsonFiles.size(), loadTime_ms, kLazyLoadCannedAnimations, startMem_kB, endMem_kB);
   }
 
   // Backpack light animations
@@ -237,6 +269,19 @@ Animation* RobotDataLoader::GetCannedAnimation(const std::string& name)
   return _cannedAnimations->GetAnimation(name);
 }
 
+Animation* RobotDataLoader::GetPinnedCannedAnimation(const std::string& name)
+{
+  DEV_ASSERT(_cannedAnimations != nullptr, "_cannedAnimations");
+  _cannedAnimations->PinAnimation(name);
+  return _cannedAnimations->GetAnimation(name);
+}
+
+void RobotDataLoader::UnpinCannedAnimation(const std::string& name)
+{
+  DEV_ASSERT(_cannedAnimations != nullptr, "_cannedAnimations");
+  _cannedAnimations->UnpinAnimation(name);
+}
+
 std::vector<std::string> RobotDataLoader::GetAnimationNames()
 {
   DEV_ASSERT(_cannedAnimations != nullptr, "_cannedAnimations");
@@ -73,7 +73,11 @@ public:
   const Json::Value & GetTextToSpeechConfig() const { return _tts_config; }
   const Json::Value & GetWebServerAnimConfig() const { return _ws_config; }
   const Json::Value & GetMicTriggerConfig() const { return _micTriggerConfig; }
+  // Lazily loaded animations may be freed again once enough others have been requested, so the returned pointer
+  // should only be used right away. Use GetPinnedCannedAnimation to hold on to one, and UnpinCannedAnimation once done
   Animation* GetCannedAnimation(const std::string& name);
+  Animation* GetPinnedCannedAnimation(const std::string& name);
+  void UnpinCannedAnimation(const std::string& name);
   std::vector<std::string> GetAnimationNames();
   
   const std::string& GetAlexaConfig() const { return _alexaConfig; }
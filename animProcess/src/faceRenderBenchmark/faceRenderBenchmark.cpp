@@ -0,0 +1,216 @@
+/**
+ * File: faceRenderBenchmark.cpp
+ *
+ * Description: Renders a recorded sequence of ProceduralFace parameters with ProceduralFaceDrawer, once
+ *              redrawing everything every frame and once with dirty region tracking, and prints how long
+ *              each frame took.
+ *
+ *              Usage: vic-faceRenderBenchmark [-n numLoops] [animation.json ...]
+ *
+ *              The sequence is built from the ProceduralFaceKeyFrames in the given canned animation files,
+ *              interpolated at the anim process tick rate. Without any files, a built-in sequence of
+ *              idling, blinking, looking around and squinting is used.
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "cannedAnimLib/proceduralFace/proceduralFace.h"
+#include "cannedAnimLib/proceduralFace/proceduralFaceDrawer.h"
+#include "coretech/vision/engine/image.h"
+#include "util/console/consoleInterface.h"
+#include "util/fileUtils/fileUtils.h"
+#include "util/random/randomGenerator.h"
+
+#include <json/json.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+  CONSOLE_VAR_EXTERN(bool, kProcFace_DirtyRegions);
+}
+}
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+namespace {
+
+  // Anim process tick
+  const TimeStamp_t kFramePeriod_ms = 33;
+
+  struct KeyFrame {
+    TimeStamp_t    triggerTime_ms;
+    TimeStamp_t    duration_ms;
+    ProceduralFace face;
+  };
+
+  void AppendKeyFrames(const std::vector<KeyFrame>& keyFrames, std::vector<ProceduralFace>& sequence)
+  {
+    // Same as the animation streamer: hold each keyframe for its duration, then interpolate to the next one
+    for(size_t i=0; i<keyFrames.size(); ++i) {
+      const KeyFrame& current = keyFrames[i];
+      const bool isLast = (i+1 == keyFrames.size());
+      const TimeStamp_t endTime_ms = isLast ? (current.triggerTime_ms + std::max(current.duration_ms, kFramePeriod_ms))
+                                            : keyFrames[i+1].triggerTime_ms;
+
+      for(TimeStamp_t t=current.triggerTime_ms; t<endTime_ms; t+=kFramePeriod_ms) {
+        if(isLast || (t < current.triggerTime_ms + current.duration_ms)) {
+          sequence.push_back(current.face);
+        } else {
+          const KeyFrame& next = keyFrames[i+1];
+          const TimeStamp_t holdEnd_ms = current.triggerTime_ms + current.duration_ms;
+          const f32 fraction = static_cast<f32>(t - holdEnd_ms) / static_cast<f32>(next.triggerTime_ms - holdEnd_ms);
+
+          ProceduralFace face;
+          face.Interpolate(current.face, next.face, fraction);
+          sequence.push_back(face);
+        }
+      }
+    }
+  }
+
+  bool LoadSequence(const std::string& filename, std::vector<ProceduralFace>& sequence)
+  {
+    Json::Reader reader;
+    Json::Value root;
+    if(!reader.parse(Util::FileUtils::ReadFile(filename), root) || !root.isObject()) {
+      fprintf(stderr, "Failed to read %s\n", filename.c_str());
+      return false;
+    }
+
+    const size_t origSize = sequence.size();
+    for(const auto& animName : root.getMemberNames()) {
+      std::vector<KeyFrame> keyFrames;
+      for(const auto& jsonKeyFrame : root[animName]) {
+        if(jsonKeyFrame["Name"].asString() == "ProceduralFaceKeyFrame") {
+          KeyFrame keyFrame;
+          keyFrame.triggerTime_ms = jsonKeyFrame["triggerTime_ms"].asUInt();
+          keyFrame.duration_ms = jsonKeyFrame["durationTime_ms"].asUInt();
+          keyFrame.face.SetFromJson(jsonKeyFrame);
+          keyFrames.push_back(keyFrame);
+        }
+      }
+
+      std::stable_sort(keyFrames.begin(), keyFrames.end(), [](const KeyFrame& a, const KeyFrame& b) {
+        return a.triggerTime_ms < b.triggerTime_ms;
+      });
+      AppendKeyFrames(keyFrames, sequence);
+    }
+
+    if(sequence.size() == origSize) {
+      fprintf(stderr, "No ProceduralFaceKeyFrames in %s\n", filename.c_str());
+      return false;
+    }
+    return true;
+  }
+
+  void CreateDefaultSequence(std::vector<ProceduralFace>& sequence)
+  {
+    ProceduralFace neutral;
+    neutral.SetFromValues({ 9.169665777907909, 0.0, 1.2143329245079946, 0.9052803986393223, 0.0, 0.5, 0.5, 0.5, 0.5, 0.5, 0.5, 0.5, 0.5, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 },
+                          { -10.206374337270427, 0.0, 1.2220369812777003, 0.9052803986393223, 0.0, 0.5, 0.5, 0.5, 0.5, 0.5, 0.5, 0.5, 0.5, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 },
+                          0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f);
+
+    // Idle
+    sequence.insert(sequence.end(), 60, neutral);
+
+    // Blink
+    ProceduralFace face = neutral;
+    BlinkState blinkState;
+    TimeStamp_t offset_ms;
+    while(ProceduralFaceDrawer::GetNextBlinkFrame(face, blinkState, offset_ms)) {
+      sequence.insert(sequence.end(), std::max<TimeStamp_t>(1, offset_ms / kFramePeriod_ms), face);
+    }
+    sequence.insert(sequence.end(), 30, face);
+
+    // Look around, holding at each end
+    for(f32 x : {-40.f, 40.f, 0.f}) {
+      std::vector<KeyFrame> keyFrames(2);
+      keyFrames[0] = {0, 0, sequence.back()};
+      keyFrames[1] = {10*kFramePeriod_ms, 20*kFramePeriod_ms, neutral};
+      keyFrames[1].face.LookAt(x, 0.f, 100.f, 100.f);
+      AppendKeyFrames(keyFrames, sequence);
+    }
+
+    // Squint with one eye
+    std::vector<KeyFrame> keyFrames(2);
+    keyFrames[0] = {0, 0, sequence.back()};
+    keyFrames[1] = {10*kFramePeriod_ms, 30*kFramePeriod_ms, sequence.back()};
+    keyFrames[1].face.SetParameter(ProceduralFace::Left, ProceduralFace::Parameter::UpperLidY, 0.4f);
+    keyFrames[1].face.SetParameter(ProceduralFace::Left, ProceduralFace::Parameter::LowerLidY, 0.3f);
+    AppendKeyFrames(keyFrames, sequence);
+  }
+
+  void RunBenchmark(const char* name, const std::vector<ProceduralFace>& sequence, int numLoops)
+  {
+    Util::RandomGenerator rng(1);
+    Vision::ImageRGB565 faceImg(FACE_DISPLAY_HEIGHT, FACE_DISPLAY_WIDTH);
+
+    std::vector<f64> frameTimes_us;
+    frameTimes_us.reserve(sequence.size() * numLoops);
+
+    for(int loop=0; loop<numLoops; ++loop) {
+      for(const auto& face : sequence) {
+        const auto start = std::chrono::steady_clock::now();
+        ProceduralFaceDrawer::DrawFace(face, rng, faceImg);
+        const auto end = std::chrono::steady_clock::now();
+        frameTimes_us.push_back(std::chrono::duration<f64, std::micro>(end - start).count());
+      }
+    }
+
+    if(frameTimes_us.empty()) {
+      return;
+    }
+
+    f64 total_us = 0.0;
+    for(const auto time_us : frameTimes_us) {
+      total_us += time_us;
+    }
+
+    std::sort(frameTimes_us.begin(), frameTimes_us.end());
+    const size_t p95 = std::min(frameTimes_us.size()-1, (frameTimes_us.size() * 95) / 100);
+
+    printf("%-14s frames: %6zu  mean: %8.1fus  p95: %8.1fus  max: %8.1fus\n", name, frameTimes_us.size(),
+           total_us / frameTimes_us.size(), frameTimes_us[p95], frameTimes_us.back());
+  }
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+  int numLoops = 10;
+  std::vector<ProceduralFace> sequence;
+
+  for(int i=1; i<argc; ++i) {
+    if(strcmp(argv[i], "-n") == 0 && (i+1 < argc)) {
+      numLoops = std::max(1, atoi(argv[++i]));
+    } else if(!LoadSequence(argv[i], sequence)) {
+      return 1;
+    }
+  }
+
+  if(sequence.empty()) {
+    CreateDefaultSequence(sequence);
+  }
+
+  ProceduralFace::EnableClippingWarning(false);
+
+  printf("Rendering %zu faces %d times (%.1fs of animation each)\n", sequence.size(), numLoops,
+         static_cast<f64>(sequence.size() * kFramePeriod_ms) / 1000.0);
+
+  kProcFace_DirtyRegions = false;
+  RunBenchmark("Full redraw", sequence, numLoops);
+
+  kProcFace_DirtyRegions = true;
+  RunBenchmark("Dirty regions", sequence, numLoops);
+
+  return 0;
+}
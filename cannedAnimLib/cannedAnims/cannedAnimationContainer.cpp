@@ -15,15 +15,26 @@
 #include "coretech/vision/shared/spriteSequence/spriteSequenceContainer.h"
 #include "cannedAnimLib/baseTypes/track.h"
 #include "cannedAnimLib/cannedAnims/cannedAnimationLoader.h"
+#include "cannedAnimLib/cannedAnims/mappedAnimationFile.h"
+#include "cannedAnimLib/proceduralFace/proceduralFace.h"
 
+#include "util/cpuProfiler/cpuProfiler.h"
 #include "util/helpers/boundedWhile.h"
 #include "util/logging/logging.h"
 
+#include <algorithm>
+
 #define LOG_CHANNEL "Animations"
 
 namespace Anki {
 namespace Vector {
 
+namespace {
+// Callers typically look an animation up right before they start streaming it, and may look up a couple of others
+// (e.g. a get-in) while it streams, so never keep fewer than this many decoded
+const size_t kMinDecodedLazyAnims = 4;
+}
+
 #if ANKI_DEV_CHEATS
 
 CannedAnimationContainer* s_cubeAnimContainer = nullptr;
@@ -65,7 +76,7 @@ CannedAnimationContainer::~CannedAnimationContainer()
 bool CannedAnimationContainer::HasAnimation(const std::string& name) const
 {
   auto retVal = _animations.find(name);
-  return retVal != _animations.end();
+  return (retVal != _animations.end()) || (_lazyAnimations.find(name) != _lazyAnimations.end());
 }
 
 
@@ -84,6 +95,10 @@ const Animation* CannedAnimationContainer::GetAnimation(const std::string& name)
   
   auto retVal = _animations.find(name);
   if(retVal == _animations.end()) {
+    auto lazyIter = _lazyAnimations.find(name);
+    if(lazyIter != _lazyAnimations.end()) {
+      return DecodeLazyAnimation(name, lazyIter->second);
+    }
     PRINT_NAMED_ERROR("CannedAnimationContainer.GetAnimation_Const.InvalidName",
                       "Animation requested for unknown animation '%s'.",
                       name.c_str());
@@ -108,6 +123,13 @@ void CannedAnimationContainer::AddAnimation(Animation&& animation, bool& outOver
     outOverwriting = true;
   }
 
+  auto lazyIter = _lazyAnimations.find(name);
+  if(lazyIter != _lazyAnimations.end()) {
+    FreeLazyAnimation(lazyIter->second);
+    _lazyAnimations.erase(lazyIter);
+    outOverwriting = true;
+  }
+
   _animations.emplace(name, std::move(animation));
 }
 
@@ -116,12 +138,154 @@ void CannedAnimationContainer::AddAnimation(Animation&& animation, bool& outOver
 std::vector<std::string> CannedAnimationContainer::GetAnimationNames()
 {
   std::vector<std::string> v;
-  v.reserve(_animations.size());
+  v.reserve(_animations.size() + _lazyAnimations.size());
   for (std::unordered_map<std::string, Animation>::iterator i=_animations.begin(); i != _animations.end(); ++i) {
     v.push_back(i->first);
   }
+  for (const auto& entry : _lazyAnimations) {
+    v.push_back(entry.first);
+  }
   return v;
 }
 
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CannedAnimationContainer::EnableLazyLoading(Vision::SpriteSequenceContainer* spriteSequenceContainer,
+                                                 size_t maxDecodedAnims)
+{
+  _spriteSequenceContainer = spriteSequenceContainer;
+  _maxDecodedLazyAnims = std::max(maxDecodedAnims, kMinDecodedLazyAnims);
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CannedAnimationContainer::AddLazyAnimation(const std::string& name,
+                                                const std::shared_ptr<const MappedAnimationFile>& file,
+                                                const CozmoAnim::AnimClip* animClip,
+                                                bool& outOverwriting)
+{
+  DEV_ASSERT(IsLazyLoadingEnabled(), "CannedAnimationContainer.AddLazyAnimation.LazyLoadingNotEnabled");
+
+  auto iter = _animations.find(name);
+  if(iter != _animations.end()) {
+    _animations.erase(iter);
+    outOverwriting = true;
+  }
+
+  LazyAnimation& lazyAnim = _lazyAnimations[name];
+  if(lazyAnim.file != nullptr) {
+    FreeLazyAnimation(lazyAnim);
+    outOverwriting = true;
+  }
+
+  lazyAnim.file = file;
+  lazyAnim.animClip = animClip;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CannedAnimationContainer::PinAnimation(const std::string& name)
+{
+  auto lazyIter = _lazyAnimations.find(name);
+  if(lazyIter == _lazyAnimations.end()) {
+    // fully loaded animations are never freed
+    return;
+  }
+
+  LazyAnimation& lazyAnim = lazyIter->second;
+  if((lazyAnim.pinCount == 0) && (lazyAnim.animation != nullptr)) {
+    _decodedLazyAnims.erase(lazyAnim.lruIter);
+  }
+  ++lazyAnim.pinCount;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CannedAnimationContainer::UnpinAnimation(const std::string& name)
+{
+  auto lazyIter = _lazyAnimations.find(name);
+  if(lazyIter == _lazyAnimations.end()) {
+    return;
+  }
+
+  LazyAnimation& lazyAnim = lazyIter->second;
+  if(!ANKI_VERIFY(lazyAnim.pinCount > 0,
+                  "CannedAnimationContainer.UnpinAnimation.NotPinned",
+                  "Animation '%s' is not pinned", name.c_str())) {
+    return;
+  }
+
+  --lazyAnim.pinCount;
+  if((lazyAnim.pinCount == 0) && (lazyAnim.animation != nullptr)) {
+    // it was just in use, so it counts as the most recently requested
+    _decodedLazyAnims.push_front(name);
+    lazyAnim.lruIter = _decodedLazyAnims.begin();
+    FreeLeastRecentlyUsedAnimations();
+  }
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const Animation* CannedAnimationContainer::DecodeLazyAnimation(const std::string& name, LazyAnimation& lazyAnim) const
+{
+  if(lazyAnim.animation != nullptr) {
+    if(lazyAnim.pinCount == 0) {
+      _decodedLazyAnims.splice(_decodedLazyAnims.begin(), _decodedLazyAnims, lazyAnim.lruIter);
+    }
+    return lazyAnim.animation.get();
+  }
+
+  ANKI_CPU_PROFILE("CannedAnimationContainer::DecodeLazyAnimation");
+
+  auto animation = std::make_unique<Animation>(name);
+
+  // Same as when loading everything up front
+  ProceduralFace::EnableClippingWarning(false);
+  const Result result = animation->DefineFromFlatBuf(name, lazyAnim.animClip, _spriteSequenceContainer);
+  ProceduralFace::EnableClippingWarning(true);
+
+  if(result != RESULT_OK) {
+    PRINT_NAMED_ERROR("CannedAnimationContainer.DecodeLazyAnimation.DefineFailed",
+                      "Failed to define animation '%s' from %s",
+                      name.c_str(),
+                      lazyAnim.file->GetPath().c_str());
+    return nullptr;
+  }
+
+  lazyAnim.animation = std::move(animation);
+  if(lazyAnim.pinCount == 0) {
+    _decodedLazyAnims.push_front(name);
+    lazyAnim.lruIter = _decodedLazyAnims.begin();
+    FreeLeastRecentlyUsedAnimations();
+  }
+
+  return lazyAnim.animation.get();
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CannedAnimationContainer::FreeLazyAnimation(LazyAnimation& lazyAnim) const
+{
+  if(lazyAnim.animation == nullptr) {
+    return;
+  }
+
+  if(lazyAnim.pinCount == 0) {
+    _decodedLazyAnims.erase(lazyAnim.lruIter);
+  }
+  lazyAnim.animation.reset();
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CannedAnimationContainer::FreeLeastRecentlyUsedAnimations() const
+{
+  while(_decodedLazyAnims.size() > _maxDecodedLazyAnims) {
+    auto lruIter = _lazyAnimations.find(_decodedLazyAnims.back());
+    DEV_ASSERT(lruIter != _lazyAnimations.end(), "CannedAnimationContainer.FreeLRUAnimations.MissingEntry");
+    FreeLazyAnimation(lruIter->second);
+  }
+}
+
 } // namespace Vector
 } // namespace Anki
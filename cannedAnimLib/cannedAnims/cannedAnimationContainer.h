@@ -16,13 +16,25 @@
 #define ANKI_COZMO_CANNED_ANIMATION_CONTAINER_H
 
 #include "cannedAnimLib/cannedAnims/animation.h"
+#include <list>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
+namespace CozmoAnim {
+struct AnimClip;
+}
+
 namespace Anki {
 
+namespace Vision {
+class SpriteSequenceContainer;
+}
+
 namespace Vector {
 
+class MappedAnimationFile;
+
 class CannedAnimationContainer
 {
 public:
@@ -37,10 +49,50 @@ public:
   void AddAnimation(Animation&& animation, bool& outOverwriting);
 
   std::vector<std::string> GetAnimationNames();
+
+  // Lazy loading: clips added with AddLazyAnimation are only indexed, and get decoded into an Animation the first
+  // time they are requested. At most maxDecodedAnims of them stay decoded, after which the least recently requested
+  // one is freed (so pointers to lazily loaded animations should not be held on to, unless pinned)
+  void EnableLazyLoading(Vision::SpriteSequenceContainer* spriteSequenceContainer, size_t maxDecodedAnims);
+  bool IsLazyLoadingEnabled() const { return (_maxDecodedLazyAnims > 0); }
+
+  // animClip must point into file. If adding the animation overwrites an existing one, outOverwriting will be set
+  void AddLazyAnimation(const std::string& name,
+                        const std::shared_ptr<const MappedAnimationFile>& file,
+                        const CozmoAnim::AnimClip* animClip,
+                        bool& outOverwriting);
+
+  // Keeps the given animation decoded until it is unpinned as many times as it was pinned, so it is safe to hold
+  // pointers to it in the meantime (e.g. while it is streaming)
+  void PinAnimation(const std::string& name);
+  void UnpinAnimation(const std::string& name);
+
+  size_t GetNumDecodedLazyAnimations() const { return _decodedLazyAnims.size(); }
   
 private:
+  struct LazyAnimation {
+    std::shared_ptr<const MappedAnimationFile> file;
+    const CozmoAnim::AnimClip* animClip = nullptr;
+    std::unique_ptr<Animation> animation;
+    u32 pinCount = 0;
+    // position in _decodedLazyAnims, if decoded and not pinned
+    std::list<std::string>::iterator lruIter;
+  };
+
+  const Animation* DecodeLazyAnimation(const std::string& name, LazyAnimation& lazyAnim) const;
+  void FreeLazyAnimation(LazyAnimation& lazyAnim) const;
+  // Frees the least recently requested unpinned animations until no more than _maxDecodedLazyAnims are decoded
+  void FreeLeastRecentlyUsedAnimations() const;
+
   using AnimMap = std::unordered_map<std::string, Animation>;
   std::unordered_map<std::string, Animation> _animations;
+
+  // Lazily loaded animations are decoded on demand from the const accessors as well, so they are mutable
+  Vision::SpriteSequenceContainer* _spriteSequenceContainer = nullptr;
+  size_t _maxDecodedLazyAnims = 0;
+  mutable std::unordered_map<std::string, LazyAnimation> _lazyAnimations;
+  // decoded, unpinned lazy animations, most recently requested first
+  mutable std::list<std::string> _decodedLazyAnims;
   
 }; // class CannedAnimationContainer
   
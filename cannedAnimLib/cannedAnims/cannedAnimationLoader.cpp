@@ -15,6 +15,7 @@
 #include "cannedAnimLib/cannedAnims/cannedAnimationLoader.h"
 
 #include "cannedAnimLib/cannedAnims/cannedAnimationContainer.h"
+#include "cannedAnimLib/cannedAnims/mappedAnimationFile.h"
 #include "cannedAnimLib/baseTypes/cozmo_anim_generated.h"
 #include "coretech/vision/shared/spriteSequence/spriteSequenceContainer.h"
 #include "cannedAnimLib/proceduralFace/proceduralFace.h"
@@ -46,7 +47,9 @@ void CannedAnimationLoader::LoadAnimationsIntoContainer(const AnimDirInfo& info,
 {
   {
     ANKI_CPU_PROFILE("CannedAnimationLoader::LoadAnimations");
+    _indexBinaryFiles = container->IsLazyLoadingEnabled();
     LoadAnimationsInternal(info, container);
+    _indexBinaryFiles = false;
     // The threaded animation loading workers each add to the loading ratio
   }
 
@@ -201,7 +204,9 @@ void CannedAnimationLoader::LoadAnimationFile(const std::string& path, CannedAni
 
   const bool binFile = Util::FileUtils::FilenameHasSuffix(path.c_str(), "bin");
 
-  if (binFile) {
+  if (binFile && _indexBinaryFiles) {
+    IndexAnimationFile(path, container);
+  } else if (binFile) {
 
     // Read the binary file
     auto binFileContents = Util::FileUtils::ReadFileAsBinary(path);
@@ -268,6 +273,42 @@ void CannedAnimationLoader::LoadAnimationFile(const std::string& path, CannedAni
 }
 
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CannedAnimationLoader::IndexAnimationFile(const std::string& path, CannedAnimationContainer* container)
+{
+  // Only the clip names are read here, so only the pages holding them get faulted in. The mapping is kept alive
+  // by the container for as long as it has clips from this file
+  auto file = MappedAnimationFile::Open(path);
+  if (nullptr == file) {
+    return;
+  }
+  auto animClips = file->GetAnimClips();
+  if (nullptr == animClips) {
+    LOG_ERROR("CannedAnimationLoader.IndexAnimationFile.AnimClipsNull", "Found no animations in %s", path.c_str());
+    return;
+  }
+  auto allClips = animClips->clips();
+  if ((nullptr == allClips) || (allClips->size() == 0)) {
+    LOG_ERROR("CannedAnimationLoader.IndexAnimationFile.AnimClipsEmpty", "Found no animations in %s", path.c_str());
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(_parallelLoadingMutex);
+  for (int clipIdx=0; clipIdx < allClips->size(); clipIdx++) {
+    auto animClip = allClips->Get(clipIdx);
+    const std::string animName = animClip->Name()->c_str();
+
+    bool outOverwriting = false;
+    container->AddLazyAnimation(animName, file, animClip, outOverwriting);
+    if (outOverwriting) {
+      PRINT_NAMED_WARNING("CannedAnimationLoader.IndexAnimationFile.OverwritingExistingAnimation",
+                          "Container already had an animation named %s, overwriting",
+                          animName.c_str());
+    }
+  }
+}
+
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result CannedAnimationLoader::DefineFromFlatBuf(const CozmoAnim::AnimClip* animClip, std::string& animName,
                                                 CannedAnimationContainer* container)
@@ -61,7 +61,11 @@ public:
   , _loadingCompleteRatio(loadingCompleteRatio)
   , _abortLoad(abortLoad){}
 
+  // If lazy loading is enabled on the container, binary files are memory mapped and only indexed here; their clips
+  // are decoded by the container when first requested
   void LoadAnimationsIntoContainer(const AnimDirInfo& info, CannedAnimationContainer* container);
+  // Always fully loads the file, since single files are loaded for animators to preview their work and may be
+  // overwritten in place at any time
   void LoadAnimationIntoContainer(const std::string& path, CannedAnimationContainer* container);
 
   AnimDirInfo CollectAnimFiles(const std::vector<std::string>& paths);
@@ -78,6 +82,9 @@ private:
   float _perAnimationLoadingRatio = 0.0f;
   std::mutex _parallelLoadingMutex;
 
+  // Set when loading a set of files into a container with lazy loading enabled
+  bool _indexBinaryFiles = false;
+
   static void WalkAnimationDir(const Util::Data::DataPlatform* platform,
                                const std::string& animationDir, AnimDirInfo::TimestampMap& timestamps,
                                const std::function<void(const std::string& filePath)>& walkFunc);
@@ -87,6 +94,7 @@ private:
   void AddToLoadingRatio(float delta);
 
   void LoadAnimationFile(const std::string& path, CannedAnimationContainer* container);
+  void IndexAnimationFile(const std::string& path, CannedAnimationContainer* container);
 
   Result DefineFromJson(const Json::Value& jsonRoot, std::string& loadedAnimName, CannedAnimationContainer* container);
   Result DefineFromFlatBuf(const CozmoAnim::AnimClip* animClip, std::string& animName, CannedAnimationContainer* container);  
@@ -0,0 +1,81 @@
+/**
+ * File: mappedAnimationFile.cpp
+ *
+ * Description:
+ *    Read-only memory mapping of a binary (flatbuffer) animation file, so that
+ *    clips can be indexed by name at load time and only decoded when played
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "cannedAnimLib/cannedAnims/mappedAnimationFile.h"
+
+#include "cannedAnimLib/baseTypes/cozmo_anim_generated.h"
+#include "util/logging/logging.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define LOG_CHANNEL "Animations"
+
+namespace Anki {
+namespace Vector {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::shared_ptr<const MappedAnimationFile> MappedAnimationFile::Open(const std::string& path)
+{
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    LOG_ERROR("MappedAnimationFile.Open.OpenFailed", "Could not open %s", path.c_str());
+    return nullptr;
+  }
+
+  struct stat attrib{0};
+  if (fstat(fd, &attrib) != 0 || attrib.st_size <= 0) {
+    LOG_ERROR("MappedAnimationFile.Open.BinaryDataEmpty", "Found no data in %s", path.c_str());
+    close(fd);
+    return nullptr;
+  }
+
+  const size_t size = static_cast<size_t>(attrib.st_size);
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  // The mapping keeps its own reference to the file
+  close(fd);
+
+  if (data == MAP_FAILED) {
+    LOG_ERROR("MappedAnimationFile.Open.MapFailed", "Could not map %s", path.c_str());
+    return nullptr;
+  }
+
+  return std::shared_ptr<const MappedAnimationFile>(new MappedAnimationFile(path, data, size));
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+MappedAnimationFile::MappedAnimationFile(const std::string& path, void* data, size_t size)
+: _path(path)
+, _data(data)
+, _size(size)
+{
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+MappedAnimationFile::~MappedAnimationFile()
+{
+  munmap(_data, _size);
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const CozmoAnim::AnimClips* MappedAnimationFile::GetAnimClips() const
+{
+  return CozmoAnim::GetAnimClips(_data);
+}
+
+} // namespace Vector
+} // namespace Anki
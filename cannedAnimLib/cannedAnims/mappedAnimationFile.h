@@ -0,0 +1,52 @@
+/**
+ * File: mappedAnimationFile.h
+ *
+ * Description:
+ *    Read-only memory mapping of a binary (flatbuffer) animation file, so that
+ *    clips can be indexed by name at load time and only decoded when played
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+
+#ifndef ANKI_COZMO_MAPPED_ANIMATION_FILE_H
+#define ANKI_COZMO_MAPPED_ANIMATION_FILE_H
+
+#include "util/helpers/noncopyable.h"
+#include <memory>
+#include <string>
+
+namespace CozmoAnim {
+struct AnimClips;
+}
+
+namespace Anki {
+namespace Vector {
+
+class MappedAnimationFile : private Util::noncopyable
+{
+public:
+  // Maps the given file. Returns nullptr if it can't be opened or mapped
+  static std::shared_ptr<const MappedAnimationFile> Open(const std::string& path);
+
+  ~MappedAnimationFile();
+
+  const std::string& GetPath() const { return _path; }
+  size_t GetSize() const { return _size; }
+
+  // Root of the flatbuffer. Pointers into it stay valid for the lifetime of this object
+  const CozmoAnim::AnimClips* GetAnimClips() const;
+
+private:
+  MappedAnimationFile(const std::string& path, void* data, size_t size);
+
+  const std::string _path;
+  void*             _data;
+  const size_t      _size;
+};
+
+} // namespace Vector
+} // namespace Anki
+
+#endif // ANKI_COZMO_MAPPED_ANIMATION_FILE_H
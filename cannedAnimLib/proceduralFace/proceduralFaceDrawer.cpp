@@ -14,6 +14,10 @@
 #include "util/math/numericCast.h"
 #include "util/random/randomGenerator.h"
 
+#if !defined(__ARM_NEON__) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 // switch std::round() to macro for easier change
 // switched from (x) to std::round(x) as it was noticed edges were jittering when
 // the roundness of corners was animated (VIC-3930). Keeping as a macro in-case
@@ -34,6 +38,7 @@ namespace Vector {
     GaussianFilter = 2,
   };
 
+  CONSOLE_VAR(bool,         kProcFace_DirtyRegions,               CONSOLE_GROUP, true); // Only render what changed since the last frame
   CONSOLE_VAR_ENUM(u8,      kProcFace_LineType,                   CONSOLE_GROUP, 1, "Line_4,Line_8,Line_AA"); // Only affects OpenCV drawing, not post-smoothing
   CONSOLE_VAR_ENUM(u8,      kProcFace_InterpolationType,          CONSOLE_GROUP, 1, "Nearest,Linear,Cubic,Area,Lanczos,LinearExact,Max,WarpFillOutliers");
   CONSOLE_VAR_RANGED(s32,   kProcFace_EllipseDelta,               CONSOLE_GROUP, IsXray() ? 15 : 10, 1, 90);
@@ -89,6 +94,41 @@ namespace Vector {
   s32 ProceduralFaceDrawer::_faceRowMin;
   s32 ProceduralFaceDrawer::_faceRowMax;
 
+  // Pixels covered by an eye bounding box, which DrawEye() treats as inclusive of its bottom right corner
+  static inline Rectangle<s32> GetPixelRect(const Rectangle<f32>& bbox)
+  {
+    const s32 colMin = Util::Clamp((s32)std::floor(bbox.GetX()), 0, ProceduralFace::WIDTH-1);
+    const s32 rowMin = Util::Clamp((s32)std::floor(bbox.GetY()), 0, ProceduralFace::HEIGHT-1);
+    const s32 colMax = Util::Clamp((s32)std::floor(bbox.GetXmax()), colMin, ProceduralFace::WIDTH-1);
+    const s32 rowMax = Util::Clamp((s32)std::floor(bbox.GetYmax()), rowMin, ProceduralFace::HEIGHT-1);
+    return Rectangle<s32>(colMin, rowMin, colMax-colMin+1, rowMax-rowMin+1);
+  }
+
+  // True if two pixel rects share at least one pixel
+  static inline bool PixelRectsOverlap(const Rectangle<s32>& a, const Rectangle<s32>& b)
+  {
+    return (a.GetX() < b.GetXmax() && b.GetX() < a.GetXmax() &&
+            a.GetY() < b.GetYmax() && b.GetY() < a.GetYmax());
+  }
+
+  // Hue and saturation to draw the face with
+  static inline void GetDrawHueAndSaturation(const ProceduralFace& faceData, u8& drawHue, u8& drawSat)
+  {
+    const f32 hueFactor = faceData.GetHue();
+    DEV_ASSERT(Util::InRange(hueFactor, 0.f, 1.f), "ProceduralFaceDrawer.DrawEye.InvalidHue");
+    drawHue = ROUND(255.f*hueFactor);
+
+    f32 satFactor = 1.0f;
+#if PROCEDURALFACE_ANIMATED_SATURATION
+    satFactor *= faceData.GetParameter(whichEye, Parameter::Saturation);
+#endif
+#if PROCEDURALFACE_PROCEDURAL_SATURATION
+    satFactor *= faceData.GetSaturation();
+#endif
+    DEV_ASSERT(Util::InRange(satFactor, -1.f, 1.f), "ProceduralFaceDrawer.DrawEye.InvalidSaturation");
+    drawSat = ROUND(255.f * satFactor);
+  }
+
   Matrix_3x3f ProceduralFaceDrawer::GetTransformationMatrix(f32 angleDeg, f32 scaleX, f32 scaleY,
                                                             f32 tX, f32 tY, f32 x0, f32 y0)
   {
@@ -166,10 +206,11 @@ namespace Vector {
     return noiseImg;
   }
 
-  const Array2d<u8>& ProceduralFaceDrawer::GetNoiseImage(const Util::RandomGenerator& rng)
+  const Array2d<u8>& ProceduralFaceDrawer::GetNoiseImage(const Util::RandomGenerator& rng, s32& index)
   {
     // NOTE: Since this is called separately for each eye, this looks better if we use an odd number of images
     static_assert(kNumNoiseImages % 2 == 1, "Use odd number of noise images");
+    static_assert(kNumNoiseImages <= FaceCache::kMaxNumFinalFaces, "Need a cached final face per noise image");
     static std::array<Array2d<u8>, kNumNoiseImages> kNoiseImages{{
       CreateNoiseImage(rng),
       CreateNoiseImage(rng),
@@ -195,16 +236,20 @@ namespace Vector {
 
       kProcFace_NoiseMinLightness_old = kProcFace_NoiseMinLightness;
       kProcFace_NoiseMaxLightness_old = kProcFace_NoiseMaxLightness;
+
+      // Faces cached with the old noise are no longer valid
+      InvalidateFinalFaces();
     }
 
     if(kProcFace_NoiseNumFrames == 0) {
-      return kNoiseImages[0];
+      index = 0;
     } else {
       // Cycle circularly through the set of noise images
-      static s32 index = 0;
-      index = (index + 1) % kProcFace_NoiseNumFrames;
-      return kNoiseImages[index];
+      static s32 lastIndex = 0;
+      lastIndex = (lastIndex + 1) % kProcFace_NoiseNumFrames;
+      index = lastIndex;
     }
+    return kNoiseImages[index];
   }
 #endif // PROCEDURALFACE_NOISE_FEATURE
 
@@ -660,7 +705,7 @@ namespace Vector {
   {
     ANKI_CPU_PROFILE("DrawFace");
 
-    bool dirty = false; // set to true to force all stages to render, previous pipeline
+    bool dirty = !kProcFace_DirtyRegions; // set to true to force all stages to render, previous pipeline
     dirty = DrawEyes(faceData, dirty);
     dirty = ApplyScanlines(_faceCache.img8[_faceCache.finalFace], faceData.GetScanlineOpacity(), dirty);
     dirty = DistortScanlines(faceData, dirty);
@@ -672,21 +717,47 @@ namespace Vector {
   {
     ANKI_CPU_PROFILE("DrawEyes");
 
+    // Eyes are always first, assign first element in face cache
+    _faceCache.finalFace = _faceCache.eyes = 0;
+    Vision::Image& eyesImg = _faceCache.img8[_faceCache.eyes];
+
+    // Nothing has been drawn yet
+    dirty |= eyesImg.IsEmpty();
+
+    bool drawLeftEye = dirty;
+    bool drawRightEye = dirty;
     if(!dirty) {
-      
-      if (_faceCache.faceData.GetParameters(WhichEye::Left) != faceData.GetParameters(WhichEye::Left) ||
-          _faceCache.faceData.GetParameters(WhichEye::Right) != faceData.GetParameters(WhichEye::Right) ||
-          _faceCache.faceData.GetFaceAngle() != faceData.GetFaceAngle() ||
-          _faceCache.faceData.GetFacePosition() != faceData.GetFacePosition() ||
-          _faceCache.faceData.GetFaceScale() != faceData.GetFaceScale() ||
-          !Util::IsFltNear(_faceCache.faceData.GetHue(), faceData.GetHue()) ||
-          !Util::IsFltNear(_faceCache.faceData.GetSaturation(), faceData.GetSaturation())) {
-        // Something changed, we must draw
+      const bool faceChanged = (_faceCache.faceData.GetFaceAngle() != faceData.GetFaceAngle() ||
+                                _faceCache.faceData.GetFacePosition() != faceData.GetFacePosition() ||
+                                _faceCache.faceData.GetFaceScale() != faceData.GetFaceScale());
+      drawLeftEye  = faceChanged || (_faceCache.faceData.GetParameters(WhichEye::Left) != faceData.GetParameters(WhichEye::Left));
+      drawRightEye = faceChanged || (_faceCache.faceData.GetParameters(WhichEye::Right) != faceData.GetParameters(WhichEye::Right));
+
+      u8 drawHue, drawSat;
+      GetDrawHueAndSaturation(faceData, drawHue, drawSat);
+      if (drawLeftEye || drawRightEye || !_faceCache.isV2RGB565Valid ||
+          (drawHue != _faceCache.v2rgb565Hue) ||
+          (drawSat != _faceCache.v2rgb565Sat)) {
+        // Something changed, later stages must draw (a color change alone doesn't need the eyes redrawn)
         dirty = true;
       }
     }
 
-    if(dirty) {
+    if(drawLeftEye || drawRightEye) {
+      // If only one eye changed, just that eye can be redrawn, as long as clearing the area it used to cover doesn't
+      // erase any of the other eye. Eyes are combined with max, so drawing one over the other gives the same result
+      // as drawing both. Scanline distortion adds noise outside the eyes, so needs a full redraw.
+      const bool hasEyeDistortion = (faceData.GetScanlineDistorter() != nullptr);
+      bool drawBothEyes = (drawLeftEye && drawRightEye) || hasEyeDistortion || _faceCache.hasEyeDistortion;
+#if PROCEDURALFACE_SCANLINE_FEATURE
+      // ApplyScanlines() darkens the eyes image in place, so the unchanged eye can't be kept
+      drawBothEyes |= kProcFace_Scanlines;
+#endif
+      const Rectangle<s32> oldRect = GetPixelRect(drawLeftEye ? _leftBBox : _rightBBox);
+      if(!drawBothEyes) {
+        drawBothEyes = PixelRectsOverlap(oldRect, GetPixelRect(drawLeftEye ? _rightBBox : _leftBBox));
+      }
+
       // Update parameters used to generate this cached image
       _faceCache.faceData.SetParameters(WhichEye::Left, faceData.GetParameters(WhichEye::Left));
       _faceCache.faceData.SetParameters(WhichEye::Right, faceData.GetParameters(WhichEye::Right));
@@ -696,11 +767,15 @@ namespace Vector {
       _faceCache.faceData.SetFaceScale(faceData.GetFaceScale());
       
       // Target image for this stage
-      // Eyes are always first, assign first element in face cache
-      _faceCache.finalFace = _faceCache.eyes = 0;
       DEV_ASSERT(_faceCache.finalFace < _faceCache.kSize, "ProceduralFaceDrawer.DistortScanlines.FaceCacheTooSmall");
-      _faceCache.img8[_faceCache.eyes].Allocate(ProceduralFace::HEIGHT, ProceduralFace::WIDTH); // Will do nothing if already the right size
-      _faceCache.img8[_faceCache.eyes].FillWith(0);
+      if(drawBothEyes) {
+        eyesImg.Allocate(ProceduralFace::HEIGHT, ProceduralFace::WIDTH); // Will do nothing if already the right size
+        eyesImg.FillWith(0);
+        _faceCache.hasEyeDistortion = hasEyeDistortion;
+      } else {
+        Rectangle<s32> clearRect(oldRect);
+        eyesImg.GetROI(clearRect).FillWith(0);
+      }
 
       // Create a full-face warp matrix if needed and provide it to the eye-rendering call
       const Matrix_3x3f* W_facePtr = nullptr;
@@ -720,8 +795,12 @@ namespace Vector {
         W_facePtr = &W_face;
       }
       
-      DrawEye(_faceCache.faceData, WhichEye::Left,  W_facePtr, _faceCache.img8[_faceCache.eyes], _leftBBox);
-      DrawEye(_faceCache.faceData, WhichEye::Right, W_facePtr, _faceCache.img8[_faceCache.eyes], _rightBBox);
+      if(drawBothEyes || drawLeftEye) {
+        DrawEye(_faceCache.faceData, WhichEye::Left,  W_facePtr, eyesImg, _leftBBox);
+      }
+      if(drawBothEyes || drawRightEye) {
+        DrawEye(_faceCache.faceData, WhichEye::Right, W_facePtr, eyesImg, _rightBBox);
+      }
       
       const std::array<Quad2f,2> leftRightQuads{{ Quad2f(_leftBBox), Quad2f(_rightBBox) }};
       
@@ -745,12 +824,31 @@ namespace Vector {
       _faceRowMin = Util::Clamp(_faceRowMin, 0, ProceduralFace::HEIGHT-1);
       _faceRowMax = Util::Clamp(_faceRowMax, 0, ProceduralFace::HEIGHT-1);
 
-      _faceCache.finalFace = _faceCache.eyes;
+      UpdateFaceRegions();
     }
     
     return dirty;
   } // DrawEyes()
 
+  void ProceduralFaceDrawer::UpdateFaceRegions()
+  {
+    // Process each eye separately, unless they overlap, in which case the hull around both is used
+    FaceRegions& regions = _faceCache.regions;
+    regions.rects[0] = GetPixelRect(_leftBBox);
+    regions.rects[1] = GetPixelRect(_rightBBox);
+    regions.numRects = 2;
+
+    if(PixelRectsOverlap(regions.rects[0], regions.rects[1])) {
+      regions.rects[0] = Rectangle<s32>(_faceColMin, _faceRowMin, _faceColMax-_faceColMin+1, _faceRowMax-_faceRowMin+1);
+      regions.numRects = 1;
+    }
+  } // UpdateFaceRegions()
+
+  void ProceduralFaceDrawer::InvalidateFinalFaces()
+  {
+    _faceCache.isFinalFaceValid.fill(false);
+  } // InvalidateFinalFaces()
+
   bool ProceduralFaceDrawer::DistortScanlines(const ProceduralFace& faceData, bool dirty)
   {
     ANKI_CPU_PROFILE("DistortScanlines");
@@ -803,8 +901,13 @@ namespace Vector {
         }
       }
 
-      _faceColMin = newColMin;
-      _faceColMax = newColMax;
+      _faceColMin = Util::Clamp(newColMin, 0, ProceduralFace::WIDTH-1);
+      _faceColMax = Util::Clamp(newColMax, 0, ProceduralFace::WIDTH-1);
+
+      // Rows are shifted sideways, so later stages need the whole area around both eyes
+      _faceCache.regions.rects[0] = Rectangle<s32>(_faceColMin, _faceRowMin,
+                                                   _faceColMax-_faceColMin+1, _faceRowMax-_faceRowMin+1);
+      _faceCache.regions.numRects = 1;
     } else {
       // No scanline distortion, pass forward the cached face transform as output
       _faceCache.finalFace = _faceCache.distortedFace = _faceCache.eyes;
@@ -815,73 +918,106 @@ namespace Vector {
 
   bool ProceduralFaceDrawer::ApplyNoise(const Util::RandomGenerator& rng, bool dirty)
   {
-    if(PROCEDURALFACE_NOISE_FEATURE && (kProcFace_NoiseNumFrames > 0)) {
+    if(dirty) {
+      // Everything before this stage changed, none of the cached final faces can be used
+      InvalidateFinalFaces();
+    }
+
+#if PROCEDURALFACE_NOISE_FEATURE
+    if(kProcFace_NoiseNumFrames > 0) {
       ANKI_CPU_PROFILE("ApplyNoise");
 
+      // Select the noise image first, since it can invalidate the cached final faces
+      const Array2d<u8>& noiseImg = GetNoiseImage(rng, _faceCache.finalFaceIndex);
+
+      // If the eyes haven't changed, the result for this noise image may already have been converted to RGB565
+      // on an earlier frame, in which case there's nothing to do here or in ConvertColorspace()
+      if(_faceCache.isFinalFaceValid[_faceCache.finalFaceIndex]) {
+        return false;
+      }
+
+      // Assign a new face cache for noise
       _faceCache.finalFace = _faceCache.distortedFace+1;
       DEV_ASSERT(_faceCache.finalFace < _faceCache.kSize, "ProceduralFaceDrawer, face cache too small.");
       _faceCache.img8[_faceCache.finalFace].Allocate(ProceduralFace::HEIGHT, ProceduralFace::WIDTH);
-      if(dirty) {
-        _faceCache.img8[_faceCache.finalFace].FillWith(0);
-      }
-
-      dirty = true;
-
-      // Assign a new face cache for noise, the reason for the changes.
-      // If the eyes haven't changed, the face hasn't changed and no-scanline distorter
-      // then there is no work to do until the noise stage
 
-      // TODO: https://ankiinc.atlassian.net/browse/VIC-3647 Apply noise to eyes individually rather than entire face
-      // ^ might not be desirable with the neon version. May incur cache penalty when pulling images from memory twice
-      // instead of just once...
-      
-      const Array2d<u8>& noiseImg = GetNoiseImage(rng);
+      // Only the face regions are read by later stages, so nothing outside of them needs clearing
+      for(s32 iRect=0; iRect<_faceCache.regions.numRects; ++iRect) {
+        const Rectangle<s32>& rect = _faceCache.regions.rects[iRect];
+        const s32 colMin = rect.GetX();
+        const s32 colMax = rect.GetXmax()-1;
 
-      for(s32 i=_faceRowMin; i<=_faceRowMax; ++i) {
+        for(s32 i=rect.GetY(); i<rect.GetYmax(); ++i) {
 
-        const u8* noiseImg_i = noiseImg.GetRow(i);
-        const u8* eyeShape_i = _faceCache.img8[_faceCache.distortedFace].GetRow(i);
-        u8* faceImg_i = _faceCache.img8[_faceCache.finalFace].GetRow(i);
+          const u8* noiseImg_i = noiseImg.GetRow(i);
+          const u8* eyeShape_i = _faceCache.img8[_faceCache.distortedFace].GetRow(i);
+          u8* faceImg_i = _faceCache.img8[_faceCache.finalFace].GetRow(i);
 
-        noiseImg_i += _faceColMin;
-        eyeShape_i += _faceColMin;
-        faceImg_i += _faceColMin;
+          noiseImg_i += colMin;
+          eyeShape_i += colMin;
+          faceImg_i += colMin;
 
-        s32 j = _faceColMin;
+          s32 j = colMin;
 #ifdef __ARM_NEON__
-        const s32 kNumElementsProcessed = 16;
-        for(; j <= _faceColMax-(kNumElementsProcessed-1); j += kNumElementsProcessed)
-        {
-          uint8x16_t eye = vld1q_u8(eyeShape_i);
-          eyeShape_i += kNumElementsProcessed;
-
-          uint8x16_t noise = vld1q_u8(noiseImg_i);
-          noiseImg_i += kNumElementsProcessed;
-
-          // Multiply eye values by noise and expand to u16
-          uint16x8_t value1 = vmull_u8(vget_low_u8(eye), vget_low_u8(noise));
-          uint16x8_t value2 = vmull_u8(vget_high_u8(eye), vget_high_u8(noise));
-          // Saturating narrowing right shift by 7 (divide by 128)
-          uint8x8_t output1 = vqshrn_n_u16(value1, 7);
-          uint8x8_t output2 = vqshrn_n_u16(value2, 7);
-          // Combine back into u8x16
-          uint8x16_t output = vcombine_u8(output1, output2);
-
-          vst1q_u8(faceImg_i, output);
-          faceImg_i += kNumElementsProcessed;
-        }
+          const s32 kNumElementsProcessed = 16;
+          for(; j <= colMax-(kNumElementsProcessed-1); j += kNumElementsProcessed)
+          {
+            uint8x16_t eye = vld1q_u8(eyeShape_i);
+            eyeShape_i += kNumElementsProcessed;
+
+            uint8x16_t noise = vld1q_u8(noiseImg_i);
+            noiseImg_i += kNumElementsProcessed;
+
+            // Multiply eye values by noise and expand to u16
+            uint16x8_t value1 = vmull_u8(vget_low_u8(eye), vget_low_u8(noise));
+            uint16x8_t value2 = vmull_u8(vget_high_u8(eye), vget_high_u8(noise));
+            // Saturating narrowing right shift by 7 (divide by 128)
+            uint8x8_t output1 = vqshrn_n_u16(value1, 7);
+            uint8x8_t output2 = vqshrn_n_u16(value2, 7);
+            // Combine back into u8x16
+            uint8x16_t output = vcombine_u8(output1, output2);
+
+            vst1q_u8(faceImg_i, output);
+            faceImg_i += kNumElementsProcessed;
+          }
+#elif defined(__SSE2__)
+          const s32 kNumElementsProcessed = 16;
+          const __m128i zero = _mm_setzero_si128();
+          for(; j <= colMax-(kNumElementsProcessed-1); j += kNumElementsProcessed)
+          {
+            const __m128i eye = _mm_loadu_si128(reinterpret_cast<const __m128i*>(eyeShape_i));
+            eyeShape_i += kNumElementsProcessed;
+
+            const __m128i noise = _mm_loadu_si128(reinterpret_cast<const __m128i*>(noiseImg_i));
+            noiseImg_i += kNumElementsProcessed;
+
+            // Expand to u16 and multiply eye values by noise (u8*u8 fits in u16)
+            const __m128i value1 = _mm_mullo_epi16(_mm_unpacklo_epi8(eye, zero), _mm_unpacklo_epi8(noise, zero));
+            const __m128i value2 = _mm_mullo_epi16(_mm_unpackhi_epi8(eye, zero), _mm_unpackhi_epi8(noise, zero));
+            // Right shift by 7 (divide by 128) and saturate back to u8
+            const __m128i output = _mm_packus_epi16(_mm_srli_epi16(value1, 7), _mm_srli_epi16(value2, 7));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(faceImg_i), output);
+            faceImg_i += kNumElementsProcessed;
+          }
 #endif
-     
-        for(; j<=_faceColMax; ++j) {
-          *faceImg_i = Util::numeric_cast_clamped<u8>((static_cast<u16>(*eyeShape_i) * static_cast<u16>(*noiseImg_i)) >> 7);
-          ++noiseImg_i;
-          ++eyeShape_i;
-          ++faceImg_i;
+
+          for(; j<=colMax; ++j) {
+            *faceImg_i = Util::numeric_cast_clamped<u8>((static_cast<u16>(*eyeShape_i) * static_cast<u16>(*noiseImg_i)) >> 7);
+            ++noiseImg_i;
+            ++eyeShape_i;
+            ++faceImg_i;
+          }
         }
       }
+
+      return true;
     }
+#endif // PROCEDURALFACE_NOISE_FEATURE
 
-    return dirty;
+    // Without noise there is a single final face
+    _faceCache.finalFaceIndex = 0;
+    return !_faceCache.isFinalFaceValid[_faceCache.finalFaceIndex];
   } // ApplyNoise()
 
   bool ProceduralFaceDrawer::ConvertColorspace(const ProceduralFace& faceData, Vision::ImageRGB565& output, bool dirty)
@@ -891,37 +1027,37 @@ namespace Vector {
     output.Allocate(FACE_DISPLAY_HEIGHT, FACE_DISPLAY_WIDTH);
     output.FillWith(Vision::PixelRGB(0,0,0));
 
-    if(!dirty) {
-      if (!Util::IsFltNear(_faceCache.faceData.GetHue(), faceData.GetHue()) ||
-          !Util::IsFltNear(_faceCache.faceData.GetSaturation(), faceData.GetSaturation())) {
-        // Something changed, we must draw
-        dirty = true;
-      }
-    }
+    // Note: hue and saturation changes are picked up by DrawEyes(), so that the cached final faces are
+    //       converted again with the new colors
+    auto& finalFaces565 = _faceCache.finalFaces565[_faceCache.finalFaceIndex];
 
     if (dirty) {
-      // Update parameters used to generate this cached image
-      _faceCache.faceData.SetHue(faceData.GetHue());
-      _faceCache.faceData.SetSaturation(faceData.GetSaturation());
-
-      const f32 hueFactor = faceData.GetHue();
-      DEV_ASSERT(Util::InRange(hueFactor, 0.f, 1.f), "ProceduralFaceDrawer.DrawEye.InvalidHue");
-      const u8 drawHue = ROUND(255.f*hueFactor);
-
-      f32 satFactor = 1.0f;
-#if PROCEDURALFACE_ANIMATED_SATURATION
-      satFactor *= faceData.GetParameter(whichEye, Parameter::Saturation);
-#endif
-#if PROCEDURALFACE_PROCEDURAL_SATURATION
-      satFactor *= faceData.GetSaturation();
-#endif
-      DEV_ASSERT(Util::InRange(satFactor, -1.f, 1.f), "ProceduralFaceDrawer.DrawEye.InvalidSaturation");
-      const u8 drawSat = ROUND(255.f * satFactor);
+      u8 drawHue, drawSat;
+      GetDrawHueAndSaturation(faceData, drawHue, drawSat);
+      if(!_faceCache.isV2RGB565Valid || (drawHue != _faceCache.v2rgb565Hue) || (drawSat != _faceCache.v2rgb565Sat)) {
+        // Update parameters used to generate this cached table
+        Vision::Image::GetV2RGB565LUT(drawHue, drawSat, _faceCache.v2rgb565);
+        _faceCache.v2rgb565Hue = drawHue;
+        _faceCache.v2rgb565Sat = drawSat;
+        _faceCache.isV2RGB565Valid = true;
+      }
 
-      // ... otherwise convert final image, limited by bounding box, to RGB565
-      Rectangle<s32> eyesROI(_faceColMin, _faceRowMin, _faceColMax-_faceColMin+1, _faceRowMax-_faceRowMin+1);
-      Vision::ImageRGB565 roi = output.GetROI(eyesROI);
-      _faceCache.img8[_faceCache.finalFace].GetROI(eyesROI).ConvertV2RGB565(drawHue, drawSat, roi);
+      // ... otherwise convert final image, limited to the face regions, to RGB565 and keep a copy for
+      // the next time this noise image comes around
+      for(s32 iRect=0; iRect<_faceCache.regions.numRects; ++iRect) {
+        Rectangle<s32> rect = _faceCache.regions.rects[iRect];
+        Vision::ImageRGB565 roi = output.GetROI(rect);
+        _faceCache.img8[_faceCache.finalFace].GetROI(rect).ConvertV2RGB565(_faceCache.v2rgb565, roi);
+        roi.CopyTo(finalFaces565[iRect]);
+      }
+      _faceCache.isFinalFaceValid[_faceCache.finalFaceIndex] = true;
+    } else {
+      // Nothing changed since this final face was converted
+      for(s32 iRect=0; iRect<_faceCache.regions.numRects; ++iRect) {
+        Rectangle<s32> rect = _faceCache.regions.rects[iRect];
+        Vision::ImageRGB565 roi = output.GetROI(rect);
+        finalFaces565[iRect].CopyTo(roi);
+      }
     }
 
     return dirty;
@@ -59,6 +59,12 @@ namespace Vector {
     //
     //  ApplyScanlines is a special case as it is part of the public API and used elsewhere,
     //  its functionality has been retained and does not affect the face cache.
+    //
+    //  Within a stage, only the regions around the eyes are processed (see FaceRegions), and
+    //  if only one eye changed only that eye is redrawn. The RGB565 output of the noise and
+    //  color conversion stages is cached per noise image, so a face which holds still only
+    //  costs a copy per frame. kProcFace_DirtyRegions can be turned off to render every
+    //  stage every frame, for comparison.
 
     // Closes eyes and switches interlacing. Call until it returns false, which
     // indicates there are no more blink frames and the face is back in its
@@ -96,6 +102,14 @@ namespace Vector {
 #endif
     static Vision::Image _eyeShape;
 
+    // Parts of the face image which can be non-zero: one rectangle per eye, or a single one around both eyes if
+    // those overlap or the scanlines are distorted (which shifts rows sideways). Later stages only process these
+    struct FaceRegions {
+      static const int kMaxNumRects = 2;
+      std::array<Rectangle<s32>, kMaxNumRects> rects;
+      int numRects = 0;
+    };
+
     static struct FaceCache {
     public:
       // Stored face data, the data here was used to generate the cache values and images below
@@ -106,10 +120,27 @@ namespace Vector {
       // pipeline
       static const int kSize = 4;
       Vision::Image img8[kSize];
-      Vision::ImageRGB565 img565;
       int eyes;
       int distortedFace;
       int finalFace;
+
+      FaceRegions regions;
+      bool hasEyeDistortion = false; // eyes image includes scanline distortion noise outside the eyes
+
+      // The final RGB565 face regions, one set per noise image (or just the first without noise). They stay valid
+      // until anything before the noise stage changes, so while the eyes hold still the noise just cycles through
+      // these instead of being reapplied and converted every frame
+      static const int kMaxNumFinalFaces = 7;
+      std::array<std::array<Vision::ImageRGB565, FaceRegions::kMaxNumRects>, kMaxNumFinalFaces> finalFaces565;
+      std::array<bool, kMaxNumFinalFaces> isFinalFaceValid{};
+      int finalFaceIndex = 0;
+
+      // V to RGB565 table and the hue and saturation it was built for (those are shared by all faces, so
+      // can't be compared through faceData)
+      Vision::Image::V2RGB565LUT v2rgb565;
+      u8 v2rgb565Hue = 0;
+      u8 v2rgb565Sat = 0;
+      bool isV2RGB565Valid = false;
     } _faceCache;
 
     // Bounding boxes, left eye, right eye, combined left/right eyes
@@ -125,12 +156,14 @@ namespace Vector {
 
     static void ApplyAntiAliasing(Vision::Image& shape, float minX, float minY, float maxX, float maxY);
     static bool DrawEyes(const ProceduralFace& faceData, bool dirty);
+    static void UpdateFaceRegions();
+    static void InvalidateFinalFaces();
     static bool DistortScanlines(const ProceduralFace& faceData, bool dirty);
     static bool ApplyNoise(const Util::RandomGenerator& rng, bool dirty);
     static bool ConvertColorspace(const ProceduralFace& faceData, Vision::ImageRGB565& output, bool dirty);
 
 #if PROCEDURALFACE_NOISE_FEATURE
-    static const Array2d<u8>& GetNoiseImage(const Util::RandomGenerator& rng);
+    static const Array2d<u8>& GetNoiseImage(const Util::RandomGenerator& rng, s32& index);
 #endif
 
 #if PROCEDURALFACE_SCANLINE_FEATURE
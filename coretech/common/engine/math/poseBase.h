@@ -119,6 +119,9 @@ namespace Anki {
     bool IsOwned() const;
     uint32_t GetNodeOwnerCount() const; // mostly useful for unit tests
     
+    // True if anything besides this pose refers to its node, e.g. a child pose using it as its parent
+    bool IsNodeShared() const;
+    
   protected:
     
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
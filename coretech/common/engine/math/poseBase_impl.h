@@ -524,6 +524,17 @@ namespace Anki {
     return _node->GetOwnerCount();
   }
   
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  template<class PoseNd, class TransformNd>
+  inline bool PoseBase<PoseNd,TransformNd>::IsNodeShared() const
+  {
+    if(IsNull())
+    {
+      return false;
+    }
+    return (_node.use_count() > 1);
+  }
+  
 } // namespace Anki
 
 #endif // _ANKICORETECH_MATH_POSEBASE_IMPL_H_
@@ -12,6 +12,7 @@
 
 
 #include "coretech/common/engine/utils/data/dataPlatform.h"
+#include "coretech/common/engine/utils/data/jsonSnapshot.h"
 #include "json/json.h"
 #include "util/logging/logging.h"
 #include "util/helpers/includeFstream.h"
@@ -25,6 +26,12 @@ namespace Anki {
 namespace Util {
 namespace Data {
 
+namespace {
+  // accessed with std::atomic_load / atomic_store, since readAsJson is called from several loading threads
+  std::shared_ptr<const JsonSnapshot> sJsonSnapshot;
+  std::shared_ptr<JsonSnapshotWriter> sJsonSnapshotWriter;
+}
+
 
 DataPlatform::DataPlatform(const std::string &persistentPath, const std::string &cachePath, const std::string &resourcesPath)
 : _persistentPath(persistentPath)
@@ -89,6 +96,11 @@ bool DataPlatform::readAsJson(const Scope& resourceScope, const std::string& res
 // reads resource as json file. returns true if successful.
 bool DataPlatform::readAsJson(const std::string& resourceName, Json::Value& data)
 {
+  const auto snapshot = std::atomic_load(&sJsonSnapshot);
+  if (snapshot && snapshot->Read(resourceName, data)) {
+    return true;
+  }
+
   try {
     std::ifstream jsonFile(resourceName);
     Json::Reader reader;
@@ -101,6 +113,12 @@ bool DataPlatform::readAsJson(const std::string& resourceName, Json::Value& data
       }
     }
     jsonFile.close();
+    if (success) {
+      const auto writer = std::atomic_load(&sJsonSnapshotWriter);
+      if (writer) {
+        writer->Add(resourceName, data);
+      }
+    }
     return success;
   } catch (const std::exception & ex) {
     LOG_ERROR("DataPlatform.readAsJson", "Failed to read [%s] (%s)", resourceName.c_str(), ex.what());
@@ -109,6 +127,14 @@ bool DataPlatform::readAsJson(const std::string& resourceName, Json::Value& data
 }
 
 // write data to json file. returns true if successful.
+void DataPlatform::SetJsonSnapshot(const std::shared_ptr<const JsonSnapshot>& snapshot,
+                                   const std::shared_ptr<JsonSnapshotWriter>& writer)
+{
+  std::atomic_store(&sJsonSnapshot, snapshot);
+  std::atomic_store(&sJsonSnapshotWriter, writer);
+}
+
+
 bool DataPlatform::writeAsJson(const Scope& resourceScope, const std::string& resourceName, const Json::Value& data) const
 {
   const std::string jsonFilename = pathToResource(resourceScope, resourceName);
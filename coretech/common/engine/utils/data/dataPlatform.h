@@ -15,12 +15,16 @@
 
 #include "coretech/common/engine/utils/data/dataScope.h"
 #include "json/json-forwards.h"
+#include <memory>
 #include <string>
 
 namespace Anki {
 namespace Util {
 namespace Data {
 
+class JsonSnapshot;
+class JsonSnapshotWriter;
+
 class DataPlatform {
 public:
 
@@ -53,6 +57,11 @@ public:
   // reads resource as json file. returns true if successful.
   static bool readAsJson(const std::string& resourceName, Json::Value& data);
 
+  // while set, readAsJson reads up to date files from snapshot instead of parsing them, and hands any it did parse to
+  // writer. either may be null; pass both null to stop.
+  static void SetJsonSnapshot(const std::shared_ptr<const JsonSnapshot>& snapshot,
+                              const std::shared_ptr<JsonSnapshotWriter>& writer);
+
   // write data to json file. returns true if successful.
   bool writeAsJson(const Scope& resourceScope, const std::string& resourceName, const Json::Value& data) const;
 
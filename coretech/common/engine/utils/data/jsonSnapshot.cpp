@@ -0,0 +1,526 @@
+/**
+* File: jsonSnapshot.cpp
+*
+* Description: Binary snapshot of parsed json resource files
+*
+* Copyright: Anki, inc. 2026
+*
+*/
+
+
+#include "coretech/common/engine/utils/data/jsonSnapshot.h"
+#include "json/json.h"
+#include "util/fileUtils/fileUtils.h"
+#include "util/logging/logging.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define LOG_CHANNEL "DataPlatform"
+
+namespace Anki {
+namespace Util {
+namespace Data {
+
+namespace {
+
+const char kMagic[4] = {'A', 'K', 'J', 'S'};
+constexpr size_t kHeaderSize = 16;
+
+// Nesting deeper than this is treated as a corrupt snapshot, rather than risking the stack
+constexpr int kMaxDepth = 256;
+
+enum ValueTag : uint8_t {
+  kNull   = 0,
+  kInt    = 1,
+  kUInt   = 2,
+  kReal   = 3,
+  kString = 4,
+  kFalse  = 5,
+  kTrue   = 6,
+  kArray  = 7,
+  kObject = 8,
+};
+
+template<typename T>
+void Put(std::string& out, const T& value)
+{
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void PutString(std::string& out, const char* str, size_t len)
+{
+  Put(out, static_cast<uint32_t>(len));
+  out.append(str, len);
+}
+
+template<typename T>
+bool Get(const uint8_t*& data, const uint8_t* end, T& value)
+{
+  if (static_cast<size_t>(end - data) < sizeof(value)) {
+    return false;
+  }
+  memcpy(&value, data, sizeof(value));
+  data += sizeof(value);
+  return true;
+}
+
+bool GetString(const uint8_t*& data, const uint8_t* end, const char*& str, const char*& strEnd)
+{
+  uint32_t len = 0;
+  if (!Get(data, end, len) || (static_cast<size_t>(end - data) < len)) {
+    return false;
+  }
+  str = reinterpret_cast<const char*>(data);
+  strEnd = str + len;
+  data += len;
+  return true;
+}
+
+bool GetFileStats(const std::string& path, uint64_t& fileSize, int64_t& fileMTime)
+{
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0) {
+    return false;
+  }
+  fileSize = static_cast<uint64_t>(st.st_size);
+  fileMTime = static_cast<int64_t>(st.st_mtime);
+  return true;
+}
+
+// Returns false if fullPath isn't inside resourcesPath
+bool GetRelativePath(const std::string& resourcesPath, const std::string& fullPath, std::string& relativePath)
+{
+  if (resourcesPath.empty() ||
+      (fullPath.size() <= resourcesPath.size() + 1) ||
+      (fullPath.compare(0, resourcesPath.size(), resourcesPath) != 0) ||
+      (fullPath[resourcesPath.size()] != '/')) {
+    return false;
+  }
+  relativePath = fullPath.substr(resourcesPath.size() + 1);
+  return true;
+}
+
+} // end anonymous namespace
+
+
+struct JsonSnapshot::Entry {
+  uint32_t pathOffset;
+  uint32_t pathLength;
+  uint64_t fileSize;
+  int64_t  fileMTime;
+  uint64_t dataOffset;
+  uint64_t dataLength;
+};
+
+
+JsonSnapshot::~JsonSnapshot()
+{
+  Close();
+}
+
+
+bool JsonSnapshot::Open(const std::string& snapshotPath, const std::string& resourcesPath)
+{
+  static_assert(sizeof(Entry) == 40, "Entry is read in place from the snapshot file");
+
+  Close();
+
+  const int fd = open(snapshotPath.c_str(), O_RDONLY);
+  if (fd < 0) {
+    LOG_INFO("JsonSnapshot.Open.NoSnapshot", "No json snapshot at %s", snapshotPath.c_str());
+    return false;
+  }
+
+  struct stat st;
+  void* data = MAP_FAILED;
+  const bool statOk = (fstat(fd, &st) == 0);
+  if (statOk && (st.st_size >= static_cast<off_t>(kHeaderSize))) {
+    data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  close(fd);
+
+  if (data == MAP_FAILED) {
+    if (statOk && (st.st_size < static_cast<off_t>(kHeaderSize))) {
+      LOG_WARNING("JsonSnapshot.Open.Truncated", "%s is truncated", snapshotPath.c_str());
+    } else {
+      LOG_WARNING("JsonSnapshot.Open.MapFailed", "Unable to map %s", snapshotPath.c_str());
+    }
+    return false;
+  }
+
+  _data = static_cast<const uint8_t*>(data);
+  _size = static_cast<size_t>(st.st_size);
+
+  uint32_t version = 0;
+  uint32_t numEntries = 0;
+  memcpy(&version, _data + 4, sizeof(version));
+  memcpy(&numEntries, _data + 8, sizeof(numEntries));
+
+  if ((memcmp(_data, kMagic, sizeof(kMagic)) != 0) || (version != kFormatVersion)) {
+    LOG_INFO("JsonSnapshot.Open.WrongVersion", "Ignoring %s (version %u, expected %u)",
+             snapshotPath.c_str(), version, kFormatVersion);
+    Close();
+    return false;
+  }
+
+  // Validate every entry once here, so lookups and reads don't have to
+  const size_t entriesEnd = kHeaderSize + static_cast<size_t>(numEntries) * sizeof(Entry);
+  if (entriesEnd > _size) {
+    LOG_WARNING("JsonSnapshot.Open.Truncated", "%s is truncated", snapshotPath.c_str());
+    Close();
+    return false;
+  }
+  _entries = reinterpret_cast<const Entry*>(_data + kHeaderSize);
+  _numEntries = numEntries;
+  for (size_t i = 0; i < _numEntries; ++i) {
+    const Entry& entry = _entries[i];
+    if ((entry.pathOffset > _size) || (entry.pathLength > _size - entry.pathOffset) ||
+        (entry.dataOffset > _size) || (entry.dataLength > _size - entry.dataOffset) ||
+        ((i > 0) && !IsEntryPathLess(_entries[i - 1], entry))) {
+      LOG_WARNING("JsonSnapshot.Open.Corrupt", "%s has an invalid entry %zu", snapshotPath.c_str(), i);
+      Close();
+      return false;
+    }
+  }
+
+  _resourcesPath = resourcesPath;
+
+  LOG_INFO("JsonSnapshot.Open", "Opened %s with %zu entries", snapshotPath.c_str(), _numEntries);
+  return true;
+}
+
+
+void JsonSnapshot::Close()
+{
+  if (_data != nullptr) {
+    munmap(const_cast<uint8_t*>(_data), _size);
+  }
+  _data = nullptr;
+  _size = 0;
+  _entries = nullptr;
+  _numEntries = 0;
+}
+
+
+bool JsonSnapshot::Read(const std::string& fullPath, Json::Value& data) const
+{
+  std::string relativePath;
+  if (!IsOpen() || !GetRelativePath(_resourcesPath, fullPath, relativePath)) {
+    return false;
+  }
+
+  const Entry* entry = FindEntry(relativePath);
+  if ((entry == nullptr) || !IsEntryUpToDate(*entry)) {
+    return false;
+  }
+
+  const uint8_t* encoded = _data + entry->dataOffset;
+  const uint8_t* encodedEnd = encoded + entry->dataLength;
+  Json::Value decoded;
+  if (!JsonSnapshotWriter::DecodeValue(encoded, encodedEnd, decoded) || (encoded != encodedEnd)) {
+    LOG_WARNING("JsonSnapshot.Read.DecodeFailed", "Unable to decode %s", relativePath.c_str());
+    return false;
+  }
+
+  data.swap(decoded);
+  return true;
+}
+
+
+const JsonSnapshot::Entry* JsonSnapshot::FindEntry(const std::string& relativePath) const
+{
+  const Entry* end = _entries + _numEntries;
+  const Entry* it = std::lower_bound(_entries, end, relativePath, [this](const Entry& entry, const std::string& path) {
+    return path.compare(0, std::string::npos,
+                        reinterpret_cast<const char*>(_data + entry.pathOffset), entry.pathLength) > 0;
+  });
+
+  if ((it != end) &&
+      (relativePath.compare(0, std::string::npos,
+                            reinterpret_cast<const char*>(_data + it->pathOffset), it->pathLength) == 0)) {
+    return it;
+  }
+  return nullptr;
+}
+
+
+std::string JsonSnapshot::GetEntryPath(const Entry& entry) const
+{
+  return std::string(reinterpret_cast<const char*>(_data + entry.pathOffset), entry.pathLength);
+}
+
+
+bool JsonSnapshot::IsEntryPathLess(const Entry& lhs, const Entry& rhs) const
+{
+  const int result = memcmp(_data + lhs.pathOffset, _data + rhs.pathOffset, std::min(lhs.pathLength, rhs.pathLength));
+  return (result < 0) || ((result == 0) && (lhs.pathLength < rhs.pathLength));
+}
+
+
+bool JsonSnapshot::IsEntryUpToDate(const Entry& entry) const
+{
+  uint64_t fileSize = 0;
+  int64_t fileMTime = 0;
+  const std::string fullPath = _resourcesPath + "/" + GetEntryPath(entry);
+  return GetFileStats(fullPath, fileSize, fileMTime) && (fileSize == entry.fileSize) && (fileMTime == entry.fileMTime);
+}
+
+
+JsonSnapshotWriter::JsonSnapshotWriter(const std::string& resourcesPath)
+: _resourcesPath(resourcesPath)
+{
+}
+
+
+void JsonSnapshotWriter::Add(const std::string& fullPath, const Json::Value& data)
+{
+  std::string relativePath;
+  PendingEntry entry;
+  if (!GetRelativePath(_resourcesPath, fullPath, relativePath) ||
+      !GetFileStats(fullPath, entry.fileSize, entry.fileMTime)) {
+    return;
+  }
+  EncodeValue(data, entry.encoded);
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  _entries[relativePath] = std::move(entry);
+}
+
+
+size_t JsonSnapshotWriter::GetNumEntries() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _entries.size();
+}
+
+
+bool JsonSnapshotWriter::Save(const std::string& snapshotPath, const JsonSnapshot* previous) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  // Gather everything to write, sorted by path. Entries carried over from previous point into its mapping.
+  struct OutEntry {
+    uint64_t       fileSize;
+    int64_t        fileMTime;
+    const uint8_t* data;
+    size_t         dataLength;
+  };
+  std::map<std::string, OutEntry> outEntries;
+  for (const auto& pending : _entries) {
+    const PendingEntry& entry = pending.second;
+    outEntries[pending.first] = {entry.fileSize, entry.fileMTime,
+                                 reinterpret_cast<const uint8_t*>(entry.encoded.data()), entry.encoded.size()};
+  }
+  if ((previous != nullptr) && previous->IsOpen()) {
+    for (size_t i = 0; i < previous->_numEntries; ++i) {
+      const JsonSnapshot::Entry& entry = previous->_entries[i];
+      const std::string path = previous->GetEntryPath(entry);
+      if ((outEntries.find(path) == outEntries.end()) && previous->IsEntryUpToDate(entry)) {
+        outEntries[path] = {entry.fileSize, entry.fileMTime, previous->_data + entry.dataOffset, entry.dataLength};
+      }
+    }
+  }
+
+  std::string paths;
+  for (const auto& outEntry : outEntries) {
+    paths += outEntry.first;
+  }
+  const size_t pathsOffset = kHeaderSize + outEntries.size() * sizeof(JsonSnapshot::Entry);
+  size_t dataOffset = pathsOffset + paths.size();
+
+  std::string out;
+  out.append(kMagic, sizeof(kMagic));
+  const uint32_t version = JsonSnapshot::kFormatVersion;
+  Put(out, version);
+  Put(out, static_cast<uint32_t>(outEntries.size()));
+  Put(out, static_cast<uint32_t>(0));
+
+  size_t pathOffset = pathsOffset;
+  for (const auto& outEntry : outEntries) {
+    JsonSnapshot::Entry entry;
+    entry.pathOffset = static_cast<uint32_t>(pathOffset);
+    entry.pathLength = static_cast<uint32_t>(outEntry.first.size());
+    entry.fileSize   = outEntry.second.fileSize;
+    entry.fileMTime  = outEntry.second.fileMTime;
+    entry.dataOffset = dataOffset;
+    entry.dataLength = outEntry.second.dataLength;
+    Put(out, entry);
+    pathOffset += outEntry.first.size();
+    dataOffset += outEntry.second.dataLength;
+  }
+  out += paths;
+  for (const auto& outEntry : outEntries) {
+    out.append(reinterpret_cast<const char*>(outEntry.second.data), outEntry.second.dataLength);
+  }
+
+  // previous may be a mapping of snapshotPath itself; renaming over it leaves the mapping valid
+  if (!FileUtils::WriteFileAtomic(snapshotPath, out)) {
+    LOG_WARNING("JsonSnapshotWriter.Save.Failed", "Unable to write %s", snapshotPath.c_str());
+    return false;
+  }
+
+  LOG_INFO("JsonSnapshotWriter.Save", "Wrote %zu entries (%zu bytes) to %s",
+           outEntries.size(), out.size(), snapshotPath.c_str());
+  return true;
+}
+
+
+void JsonSnapshotWriter::EncodeValue(const Json::Value& value, std::string& out)
+{
+  switch (value.type()) {
+    case Json::nullValue:
+      Put(out, kNull);
+      break;
+    case Json::intValue:
+      Put(out, kInt);
+      Put(out, static_cast<int64_t>(value.asLargestInt()));
+      break;
+    case Json::uintValue:
+      Put(out, kUInt);
+      Put(out, static_cast<uint64_t>(value.asLargestUInt()));
+      break;
+    case Json::realValue:
+      Put(out, kReal);
+      Put(out, value.asDouble());
+      break;
+    case Json::stringValue:
+    {
+      const char* str = nullptr;
+      const char* strEnd = nullptr;
+      value.getString(&str, &strEnd);
+      Put(out, kString);
+      PutString(out, str, static_cast<size_t>(strEnd - str));
+      break;
+    }
+    case Json::booleanValue:
+      Put(out, value.asBool() ? kTrue : kFalse);
+      break;
+    case Json::arrayValue:
+      Put(out, kArray);
+      Put(out, static_cast<uint32_t>(value.size()));
+      for (const auto& element : value) {
+        EncodeValue(element, out);
+      }
+      break;
+    case Json::objectValue:
+      Put(out, kObject);
+      Put(out, static_cast<uint32_t>(value.size()));
+      for (auto it = value.begin(); it != value.end(); ++it) {
+        const char* keyEnd = nullptr;
+        const char* key = it.memberName(&keyEnd);
+        PutString(out, key, static_cast<size_t>(keyEnd - key));
+        EncodeValue(*it, out);
+      }
+      break;
+  }
+}
+
+
+bool JsonSnapshotWriter::DecodeValue(const uint8_t*& data, const uint8_t* end, Json::Value& value, int depth)
+{
+  uint8_t tag = kNull;
+  if ((depth > kMaxDepth) || !Get(data, end, tag)) {
+    return false;
+  }
+
+  switch (tag) {
+    case kNull:
+      value = Json::Value();
+      return true;
+    case kInt:
+    {
+      int64_t i = 0;
+      if (!Get(data, end, i)) {
+        return false;
+      }
+      value = Json::Value(static_cast<Json::Int64>(i));
+      return true;
+    }
+    case kUInt:
+    {
+      uint64_t u = 0;
+      if (!Get(data, end, u)) {
+        return false;
+      }
+      value = Json::Value(static_cast<Json::UInt64>(u));
+      return true;
+    }
+    case kReal:
+    {
+      double d = 0.0;
+      if (!Get(data, end, d)) {
+        return false;
+      }
+      value = Json::Value(d);
+      return true;
+    }
+    case kString:
+    {
+      const char* str = nullptr;
+      const char* strEnd = nullptr;
+      if (!GetString(data, end, str, strEnd)) {
+        return false;
+      }
+      value = Json::Value(str, strEnd);
+      return true;
+    }
+    case kFalse:
+    case kTrue:
+      value = Json::Value(tag == kTrue);
+      return true;
+    case kArray:
+    {
+      uint32_t count = 0;
+      if (!Get(data, end, count)) {
+        return false;
+      }
+      value = Json::Value(Json::arrayValue);
+      if (count > 0) {
+        // Every element takes at least its tag byte
+        if (count > static_cast<size_t>(end - data)) {
+          return false;
+        }
+        value.resize(count);
+      }
+      for (uint32_t i = 0; i < count; ++i) {
+        if (!DecodeValue(data, end, value[i], depth + 1)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case kObject:
+    {
+      uint32_t count = 0;
+      if (!Get(data, end, count)) {
+        return false;
+      }
+      value = Json::Value(Json::objectValue);
+      // Reused for every key, jsoncpp only takes keys with a length as a string
+      std::string keyString;
+      for (uint32_t i = 0; i < count; ++i) {
+        const char* key = nullptr;
+        const char* keyEnd = nullptr;
+        if (!GetString(data, end, key, keyEnd)) {
+          return false;
+        }
+        keyString.assign(key, keyEnd);
+        if (!DecodeValue(data, end, value[keyString], depth + 1)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+} // end namespace Data
+} // end namespace Util
+} // end namespace Anki
@@ -0,0 +1,118 @@
+/**
+* File: jsonSnapshot
+*
+* Description: Binary snapshot of parsed json resource files, so that boot doesn't have to run the json parser over
+*              hundreds of config files. The snapshot file is memory mapped and looked up in place; only the entries
+*              that are actually read get decoded into a Json::Value.
+*
+*              Every entry records the size and modification time of the file it came from, and is only used while
+*              those still match, so an edited or updated resource falls back to parsing the json.
+*
+*              File layout (little endian, offsets from the start of the file):
+*                header:  magic "AKJS", u32 format version, u32 entry count, u32 reserved
+*                entries: sorted by path, each u32 path offset, u32 path length, u64 file size, s64 file mtime,
+*                         u64 data offset, u64 data length
+*                then the path strings and the encoded values
+*
+* Copyright: Anki, inc. 2026
+*
+*/
+
+#ifndef _Anki_Common_Basestation_Utils_Data_JsonSnapshot_H__
+#define _Anki_Common_Basestation_Utils_Data_JsonSnapshot_H__
+
+#include "json/json-forwards.h"
+#include "util/helpers/noncopyable.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Anki {
+namespace Util {
+namespace Data {
+
+class JsonSnapshot : noncopyable {
+public:
+
+  // Bump whenever the file layout or value encoding changes; snapshots of other versions are ignored
+  static constexpr uint32_t kFormatVersion = 1;
+
+  JsonSnapshot() = default;
+  ~JsonSnapshot();
+
+  // Maps snapshotPath. Entries are looked up by path relative to resourcesPath. Returns false (and leaves the snapshot
+  // empty) if the file doesn't exist or isn't a valid snapshot of this version.
+  bool Open(const std::string& snapshotPath, const std::string& resourcesPath);
+  void Close();
+
+  bool IsOpen() const { return _data != nullptr; }
+  size_t GetNumEntries() const { return _numEntries; }
+  const std::string& GetResourcesPath() const { return _resourcesPath; }
+
+  // If the snapshot has an up to date entry for fullPath, decodes it into data and returns true. Safe to call from
+  // several threads at once.
+  bool Read(const std::string& fullPath, Json::Value& data) const;
+
+private:
+
+  friend class JsonSnapshotWriter;
+
+  struct Entry;
+
+  const Entry* FindEntry(const std::string& relativePath) const;
+  std::string GetEntryPath(const Entry& entry) const;
+  // Same order as comparing the GetEntryPath strings, but compares the paths in place
+  bool IsEntryPathLess(const Entry& lhs, const Entry& rhs) const;
+  bool IsEntryUpToDate(const Entry& entry) const;
+
+  std::string    _resourcesPath;
+  const uint8_t* _data = nullptr;
+  size_t         _size = 0;
+  const Entry*   _entries = nullptr;
+  size_t         _numEntries = 0;
+};
+
+
+// Collects parsed json files and writes them out as a snapshot
+class JsonSnapshotWriter : noncopyable {
+public:
+
+  explicit JsonSnapshotWriter(const std::string& resourcesPath);
+
+  // Encodes data, parsed from the file at fullPath. Files outside of the resources path are ignored, as are files
+  // whose size or mtime can't be read. Thread safe.
+  void Add(const std::string& fullPath, const Json::Value& data);
+
+  size_t GetNumEntries() const;
+
+  // Writes every added entry, plus any up to date entries of previous that weren't added again, to snapshotPath. The
+  // file is written to a temporary path and then renamed, so a reader never sees a partial snapshot.
+  bool Save(const std::string& snapshotPath, const JsonSnapshot* previous = nullptr) const;
+
+  // Exposed for unit tests
+  static void EncodeValue(const Json::Value& value, std::string& out);
+  static bool DecodeValue(const uint8_t*& data, const uint8_t* end, Json::Value& value, int depth = 0);
+
+private:
+
+  struct PendingEntry {
+    uint64_t    fileSize;
+    int64_t     fileMTime;
+    std::string encoded;
+  };
+
+  const std::string _resourcesPath;
+
+  mutable std::mutex                    _mutex;
+  std::map<std::string, PendingEntry>   _entries; // by relative path, so they are written sorted
+};
+
+} // end namespace Data
+} // end namespace Util
+} // end namespace Anki
+
+#endif //_Anki_Common_Basestation_Utils_Data_JsonSnapshot_H__
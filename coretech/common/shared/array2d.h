@@ -100,6 +100,10 @@ namespace Anki
     s32 GetNumElements() const;
 
     bool IsEmpty() const;
+    
+    // True if another array (or cv::Mat) still references this one's memory, so writing into it in place
+    // would also change theirs
+    bool IsShared() const;
 
     // Don't let the public mess with my data, but they can see it:
     const T* GetDataPointer() const;
@@ -285,6 +285,17 @@ namespace Anki
 #endif
   }
   
+  template<typename T>
+  inline bool Array2d<T>::IsShared() const
+  {
+#if ANKICORETECH_USE_OPENCV
+    // Data we don't manage (e.g. wrapped with the T* constructor) has no reference count
+    return (nullptr != this->u) && (this->u->refcount > 1);
+#else
+    return false;
+#endif
+  }
+  
   template<typename T>
   bool operator==(const Array2d<T> &array1, const Array2d<T> &array2)
   {
@@ -0,0 +1,197 @@
+/**
+ * File: testJsonSnapshot.cpp
+ *
+ * Description: unit tests for the binary json snapshot used to skip parsing config files at boot
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "util/helpers/includeGTest.h"
+#include "coretech/common/engine/utils/data/dataPlatform.h"
+#include "coretech/common/engine/utils/data/jsonSnapshot.h"
+#include "json/json.h"
+#include "util/fileUtils/fileUtils.h"
+
+#include <memory>
+#include <unistd.h>
+
+using namespace Anki::Util;
+using namespace Anki::Util::Data;
+
+namespace {
+
+std::string MakeTestDir()
+{
+  const std::string dir = "/tmp/testJsonSnapshot_" + std::to_string(getpid());
+  FileUtils::RemoveDirectory(dir);
+  FileUtils::CreateDirectory(dir + "/resources/config");
+  return dir;
+}
+
+Json::Value MakeTestValue()
+{
+  Json::Value value;
+  value["null"] = Json::Value();
+  value["int"] = -42;
+  value["bigInt"] = Json::Int64(-5000000000LL);
+  value["uint"] = Json::UInt64(18000000000000000000ULL);
+  value["real"] = 3.25;
+  value["string"] = "hello";
+  value["embeddedNul"] = Json::Value(std::string("a\0b", 3));
+  value["true"] = true;
+  value["false"] = false;
+  value["emptyArray"] = Json::Value(Json::arrayValue);
+  value["emptyObject"] = Json::Value(Json::objectValue);
+  value["array"].append(1);
+  value["array"].append("two");
+  value["array"].append(Json::Value(Json::objectValue))["three"] = 3.0;
+  return value;
+}
+
+} // end anonymous namespace
+
+
+GTEST_TEST(JsonSnapshot, EncodeDecodeRoundTrip)
+{
+  const Json::Value value = MakeTestValue();
+
+  std::string encoded;
+  JsonSnapshotWriter::EncodeValue(value, encoded);
+
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(encoded.data());
+  const uint8_t* end = data + encoded.size();
+  Json::Value decoded;
+  ASSERT_TRUE(JsonSnapshotWriter::DecodeValue(data, end, decoded));
+  EXPECT_EQ(end, data);
+  EXPECT_EQ(value, decoded);
+  EXPECT_EQ(Json::intValue, decoded["int"].type());
+  EXPECT_EQ(Json::uintValue, decoded["uint"].type());
+  EXPECT_EQ(3u, decoded["embeddedNul"].asString().size());
+
+  // Every truncation of the encoding must fail cleanly
+  for (size_t len = 0; len < encoded.size(); ++len) {
+    const uint8_t* truncated = reinterpret_cast<const uint8_t*>(encoded.data());
+    Json::Value partial;
+    EXPECT_FALSE(JsonSnapshotWriter::DecodeValue(truncated, truncated + len, partial));
+  }
+}
+
+
+GTEST_TEST(JsonSnapshot, SaveOpenRead)
+{
+  const std::string dir = MakeTestDir();
+  const std::string resources = dir + "/resources";
+  const std::string fileA = resources + "/config/a.json";
+  const std::string fileB = resources + "/config/b.json";
+  const std::string snapshotPath = dir + "/snapshot.bin";
+
+  FileUtils::WriteFile(fileA, "{\"a\": 1}");
+  FileUtils::WriteFile(fileB, "{\"b\": [true, false]}");
+
+  // Parsing through DataPlatform while a writer is attached collects the files
+  {
+    auto writer = std::make_shared<JsonSnapshotWriter>(resources);
+    DataPlatform::SetJsonSnapshot(nullptr, writer);
+    Json::Value a, b, outside;
+    EXPECT_TRUE(DataPlatform::readAsJson(fileA, a));
+    EXPECT_TRUE(DataPlatform::readAsJson(fileB, b));
+    DataPlatform::SetJsonSnapshot(nullptr, nullptr);
+
+    writer->Add(dir + "/notInResources.json", a);
+    EXPECT_EQ(2u, writer->GetNumEntries());
+    EXPECT_TRUE(writer->Save(snapshotPath));
+  }
+
+  JsonSnapshot snapshot;
+  ASSERT_TRUE(snapshot.Open(snapshotPath, resources));
+  EXPECT_EQ(2u, snapshot.GetNumEntries());
+
+  Json::Value a;
+  EXPECT_TRUE(snapshot.Read(fileA, a));
+  EXPECT_EQ(1, a["a"].asInt());
+
+  Json::Value b;
+  EXPECT_TRUE(snapshot.Read(fileB, b));
+  EXPECT_TRUE(b["b"][0].asBool());
+
+  Json::Value missing;
+  EXPECT_FALSE(snapshot.Read(resources + "/config/c.json", missing));
+  EXPECT_FALSE(snapshot.Read(dir + "/a.json", missing));
+
+  // Once a file changes, its entry is ignored and the json is parsed instead
+  FileUtils::WriteFile(fileA, "{\"a\": 12}");
+  EXPECT_FALSE(snapshot.Read(fileA, a));
+
+  DataPlatform::SetJsonSnapshot(std::make_shared<JsonSnapshot>(), nullptr);
+  EXPECT_TRUE(DataPlatform::readAsJson(fileA, a));
+  EXPECT_EQ(12, a["a"].asInt());
+  DataPlatform::SetJsonSnapshot(nullptr, nullptr);
+
+  // Rewriting keeps up to date entries of the previous snapshot, and drops stale ones that weren't re-added
+  {
+    JsonSnapshotWriter writer(resources);
+    EXPECT_TRUE(writer.Save(snapshotPath, &snapshot));
+  }
+  snapshot.Close();
+  ASSERT_TRUE(snapshot.Open(snapshotPath, resources));
+  EXPECT_EQ(1u, snapshot.GetNumEntries());
+  EXPECT_TRUE(snapshot.Read(fileB, b));
+  EXPECT_FALSE(snapshot.Read(fileA, a));
+
+  snapshot.Close();
+  FileUtils::RemoveDirectory(dir);
+}
+
+
+GTEST_TEST(JsonSnapshot, RejectsInvalidFiles)
+{
+  const std::string dir = MakeTestDir();
+  const std::string snapshotPath = dir + "/snapshot.bin";
+
+  JsonSnapshot snapshot;
+  EXPECT_FALSE(snapshot.Open(snapshotPath, dir));
+
+  FileUtils::WriteFile(snapshotPath, "not a snapshot");
+  EXPECT_FALSE(snapshot.Open(snapshotPath, dir));
+
+  // Valid header claiming more entries than the file holds
+  std::string truncated("AKJS", 4);
+  const uint32_t header[3] = {JsonSnapshot::kFormatVersion, 1000, 0};
+  truncated.append(reinterpret_cast<const char*>(header), sizeof(header));
+  FileUtils::WriteFile(snapshotPath, truncated);
+  EXPECT_FALSE(snapshot.Open(snapshotPath, dir));
+  EXPECT_FALSE(snapshot.IsOpen());
+
+  // Two empty entries with the given paths, which have to be sorted and distinct for lookups to work
+  auto writeTwoEntries = [&snapshotPath](const std::string& path1, const std::string& path2) {
+    std::string out("AKJS", 4);
+    const uint32_t twoEntriesHeader[3] = {JsonSnapshot::kFormatVersion, 2, 0};
+    out.append(reinterpret_cast<const char*>(twoEntriesHeader), sizeof(twoEntriesHeader));
+    const uint32_t pathsOffset = 16 + 2 * 40;
+    const uint32_t paths[2][2] = {{pathsOffset, (uint32_t)path1.size()},
+                                  {pathsOffset + (uint32_t)path1.size(), (uint32_t)path2.size()}};
+    for (const auto& path : paths) {
+      const uint64_t rest[4] = {0, 0, 0, 0}; // file size, file mtime, data offset, data length
+      out.append(reinterpret_cast<const char*>(path), sizeof(path));
+      out.append(reinterpret_cast<const char*>(rest), sizeof(rest));
+    }
+    out += path1 + path2;
+    FileUtils::WriteFile(snapshotPath, out);
+  };
+
+  writeTwoEntries("config/a", "config/ab");
+  EXPECT_TRUE(snapshot.Open(snapshotPath, dir));
+  EXPECT_EQ(snapshot.GetNumEntries(), 2);
+
+  writeTwoEntries("config/ab", "config/a");
+  EXPECT_FALSE(snapshot.Open(snapshotPath, dir));
+
+  writeTwoEntries("config/b", "config/a");
+  EXPECT_FALSE(snapshot.Open(snapshotPath, dir));
+
+  writeTwoEntries("config/a", "config/a");
+  EXPECT_FALSE(snapshot.Open(snapshotPath, dir));
+
+  FileUtils::RemoveDirectory(dir);
+}
@@ -0,0 +1,170 @@
+/**
+ * File: LocalShmClient.cpp
+ *
+ * Description: Implementation of shared memory client class
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "coretech/messaging/shared/LocalShmClient.h"
+#include "coretech/messaging/shared/LocalUdpServer.h" // for kConnectionPacket
+#include "coretech/common/shared/logging.h"
+
+#include <assert.h>
+
+// Define this to enable logs
+#define LOG_CHANNEL                    "LocalShmClient"
+
+#ifdef  LOG_CHANNEL
+#define LOG_ERROR(name, format, ...)   CORETECH_LOG_ERROR(name, format, ##__VA_ARGS__)
+#define LOG_WARNING(name, format, ...) CORETECH_LOG_WARNING(name, format, ##__VA_ARGS__)
+#define LOG_INFO(name, format, ...)    CORETECH_LOG_INFO(LOG_CHANNEL, name, format, ##__VA_ARGS__)
+#define LOG_DEBUG(name, format, ...)   CORETECH_LOG_DEBUG(LOG_CHANNEL, name, format, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(name, format, ...)   {}
+#define LOG_WARNING(name, format, ...) {}
+#define LOG_INFO(name, format, ...)    {}
+#define LOG_DEBUG(name, format, ...)   {}
+#endif
+
+LocalShmClient::LocalShmClient()
+{
+}
+
+LocalShmClient::~LocalShmClient()
+{
+  Disconnect();
+  _segment.Close(false);
+}
+
+bool LocalShmClient::Connect(const std::string& sockname, const std::string & peername)
+{
+  if (_connected) {
+    LOG_ERROR("LocalShmClient.Connect", "Already connected");
+    return false;
+  }
+
+  // Segment of a previous connection
+  _segment.Close(false);
+
+  // Fails quietly if the server hasn't started yet, callers retry
+  if (!_segment.Open(peername)) {
+    LOG_DEBUG("LocalShmClient.Connect", "Unable to open segment for %s", peername.c_str());
+    return false;
+  }
+
+  _serverGeneration = _segment.GetServerGeneration();
+  if (_serverGeneration == 0) {
+    LOG_DEBUG("LocalShmClient.Connect", "Server at %s is stopped", peername.c_str());
+    _segment.Close(false);
+    return false;
+  }
+
+  _peername = peername;
+
+  // Anything queued is for a previous client
+  _segment.Skip(Direction::ToClient);
+
+  _clientGeneration = _segment.NewClientGeneration();
+  _segment.SetClientConnected(true);
+  _connected = true;
+
+  LOG_DEBUG("LocalShmClient.Connect", "Connect from %s to %s (client %u, server %u)",
+            sockname.c_str(), peername.c_str(), _clientGeneration, _serverGeneration);
+
+  // Send connection packet (i.e. something so that the server adds us as its client)
+  Send(LocalUdpServer::kConnectionPacket, sizeof(LocalUdpServer::kConnectionPacket));
+
+  return true;
+}
+
+bool LocalShmClient::Disconnect()
+{
+  if (_connected) {
+    // Unless another client has taken over already
+    if (_segment.GetClientGeneration() == _clientGeneration) {
+      _segment.SetClientConnected(false);
+    }
+    LOG_DEBUG("LocalShmClient.Disconnect", "Disconnected from %s", _peername.c_str());
+    _connected = false;
+  }
+  // The segment stays mapped until the next Connect, since other threads may still be using it
+  return true;
+}
+
+bool LocalShmClient::IsServerValid() const
+{
+  return (_segment.GetServerGeneration() == _serverGeneration);
+}
+
+ssize_t LocalShmClient::Send(const char* data, size_t size)
+{
+  if (!_connected) {
+    LOG_ERROR("LocalShmClient.Send", "Not connected, skipping send");
+    return 0;
+  }
+
+  if (!IsServerValid()) {
+    LOG_ERROR("LocalShmClient.Send.Fail", "Server at %s went away, disconnecting", _peername.c_str());
+    Disconnect();
+    return -1;
+  }
+
+  ssize_t bytes_sent = 0;
+  {
+    std::lock_guard<std::mutex> lock(_sendMutex);
+    bytes_sent = _segment.Write(Direction::ToServer, data, size);
+  }
+
+  if (bytes_sent != (ssize_t) size) {
+    LOG_ERROR("LocalShmClient.Send.Fail",
+              "Send error on %s (%zu bytes queued), disconnecting",
+              _peername.c_str(), _segment.GetQueuedSize(Direction::ToServer));
+    Disconnect();
+    return -1;
+  }
+
+  return bytes_sent;
+}
+
+ssize_t LocalShmClient::Recv(char* data, size_t maxSize)
+{
+  assert(data != NULL);
+
+  if (!_connected) {
+    LOG_ERROR("LocalShmClient.Recv", "Not connected, skipping recv");
+    return 0;
+  }
+
+  if (!IsServerValid()) {
+    LOG_ERROR("LocalShmClient.Recv.Fail", "Server at %s went away, dropping connection", _peername.c_str());
+    Disconnect();
+    return -1;
+  }
+
+  const ssize_t bytes_received = _segment.Read(Direction::ToClient, data, maxSize);
+  if (bytes_received < 0) {
+    LOG_ERROR("LocalShmClient.Recv.Fail", "Receive error on %s, dropping connection", _peername.c_str());
+    Disconnect();
+    return -1;
+  }
+
+  return bytes_received;
+}
+
+ssize_t LocalShmClient::GetIncomingSize() const
+{
+  if (_connected) {
+    return (ssize_t) _segment.GetQueuedSize(Direction::ToClient);
+  }
+  return -1;
+}
+
+ssize_t LocalShmClient::GetOutgoingSize() const
+{
+  if (_connected) {
+    return (ssize_t) _segment.GetQueuedSize(Direction::ToServer);
+  }
+  return -1;
+}
@@ -0,0 +1,58 @@
+/**
+ * File: LocalShmClient.h
+ *
+ * Description: Declaration of shared memory client class
+ *
+ * Drop-in replacement for LocalUdpClient, see LocalShmServer.h
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#ifndef ANKI_MESSAGING_LOCAL_SHM_CLIENT_H
+#define ANKI_MESSAGING_LOCAL_SHM_CLIENT_H
+
+#include "coretech/messaging/shared/LocalShmSegment.h"
+
+#include <mutex>
+#include <string>
+
+class LocalShmClient
+{
+public:
+
+  LocalShmClient();
+
+  ~LocalShmClient();
+
+  // sockname is unused, it is only there to match LocalUdpClient
+  bool Connect(const std::string& sockname, const std::string& peername);
+  bool IsConnected() const { return _connected; }
+  bool Disconnect();
+
+  ssize_t Send(const char* data, size_t size);
+  ssize_t Recv(char* data, size_t maxSize);
+
+  // Return count of bytes queued for read or -1 on error
+  ssize_t GetIncomingSize() const;
+
+  // Return count of bytes queued for write or -1 on error
+  ssize_t GetOutgoingSize() const;
+
+private:
+  using Direction = LocalShmSegment::Direction;
+
+  // Returns false if the server stopped or restarted since we connected
+  bool IsServerValid() const;
+
+  LocalShmSegment _segment;
+  std::string _peername;
+
+  bool _connected = false;
+  uint32_t _serverGeneration = 0;
+  uint32_t _clientGeneration = 0;
+
+  std::mutex _sendMutex;
+};
+
+#endif
@@ -0,0 +1,405 @@
+/**
+ * File: LocalShmSegment.cpp
+ *
+ * Description: Implementation of shared memory segment used by LocalShmServer and LocalShmClient
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "coretech/messaging/shared/LocalShmSegment.h"
+#include "coretech/common/shared/logging.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Define this to enable logs
+#define LOG_CHANNEL                    "LocalShmSegment"
+
+#ifdef  LOG_CHANNEL
+#define LOG_ERROR(name, format, ...)   CORETECH_LOG_ERROR(name, format, ##__VA_ARGS__)
+#define LOG_WARNING(name, format, ...) CORETECH_LOG_WARNING(name, format, ##__VA_ARGS__)
+#define LOG_INFO(name, format, ...)    CORETECH_LOG_INFO(LOG_CHANNEL, name, format, ##__VA_ARGS__)
+#define LOG_DEBUG(name, format, ...)   CORETECH_LOG_DEBUG(LOG_CHANNEL, name, format, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(name, format, ...)   {}
+#define LOG_WARNING(name, format, ...) {}
+#define LOG_INFO(name, format, ...)    {}
+#define LOG_DEBUG(name, format, ...)   {}
+#endif
+
+namespace {
+
+const uint32_t kMagic   = 0x414e4d53; // "ANMS"
+const uint32_t kVersion = 1;
+
+// Marks the rest of the ring as unused, the next message starts at the beginning
+const uint32_t kWrapMarker = 0xffffffff;
+
+// Each message is a 32-bit size followed by the data, padded so that every size is aligned
+const size_t kRecordAlignment = 8;
+const size_t kRecordHeaderSize = sizeof(uint32_t);
+
+// Counters written by different processes live on different cache lines
+const size_t kCacheLineSize = 64;
+
+inline size_t Align(size_t size, size_t alignment)
+{
+  return (size + alignment - 1) & ~(alignment - 1);
+}
+
+inline size_t GetRecordSize(size_t size)
+{
+  return Align(kRecordHeaderSize + size, kRecordAlignment);
+}
+
+// FNV-1a, so that all processes agree on names regardless of how their standard libraries hash strings
+uint64_t HashString(const std::string& str)
+{
+  uint64_t hash = 14695981039346656037ull;
+  for (const char c : str) {
+    hash ^= (uint8_t) c;
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && ATOMIC_INT_LOCK_FREE == 2,
+              "Counters in shared memory must be lock-free");
+
+} // anonymous namespace
+
+//
+// Layout of the segment: Header, then the ToServer ring data, then the ToClient ring data
+//
+struct LocalShmSegment::Ring
+{
+  // Total bytes ever written, only changed by the writer
+  alignas(kCacheLineSize) std::atomic<uint32_t> head;
+  // Total bytes ever read, only changed by the reader
+  alignas(kCacheLineSize) std::atomic<uint32_t> tail;
+};
+
+struct LocalShmSegment::Header
+{
+  uint32_t magic;
+  uint32_t version;
+  uint32_t ringCapacity;
+  uint32_t totalSize;
+
+  alignas(kCacheLineSize) std::atomic<uint32_t> serverGeneration;
+  std::atomic<uint32_t> clientGeneration;
+  std::atomic<uint32_t> clientConnected;
+
+  Ring rings[2];
+};
+
+LocalShmSegment::LocalShmSegment()
+{
+}
+
+LocalShmSegment::~LocalShmSegment()
+{
+  Close(false);
+}
+
+std::string LocalShmSegment::GetSegmentName(const std::string& sockname)
+{
+  // Keep it short: macOS limits shared memory names to 31 characters
+  char name[32];
+  snprintf(name, sizeof(name), "/ankimsg_%016llx", (unsigned long long) HashString(sockname));
+  return name;
+}
+
+bool LocalShmSegment::Create(const std::string& sockname, size_t ringCapacity)
+{
+  Close(false);
+
+  if (ringCapacity < kCacheLineSize || (ringCapacity & (ringCapacity - 1)) != 0 || ringCapacity > (1u << 30)) {
+    LOG_ERROR("LocalShmSegment.Create", "Invalid ring capacity %zu", ringCapacity);
+    return false;
+  }
+
+  const size_t totalSize = Align(sizeof(Header), kCacheLineSize) + 2 * ringCapacity;
+  if (!Map(sockname, true, totalSize)) {
+    Close(false);
+    return false;
+  }
+
+  // A server which crashed may have left the segment behind, possibly with a client still attached. Keep
+  // counting generations from where it left off so that client notices the restart.
+  const bool isReused = (_header->magic == kMagic && _header->version == kVersion &&
+                         _header->ringCapacity == ringCapacity);
+  if (!isReused) {
+    _header->magic = 0;
+    std::atomic_thread_fence(std::memory_order_release);
+    _header->version = kVersion;
+    _header->ringCapacity = (uint32_t) ringCapacity;
+    _header->totalSize = (uint32_t) totalSize;
+    _header->serverGeneration.store(0, std::memory_order_relaxed);
+    _header->clientGeneration.store(0, std::memory_order_relaxed);
+    _header->clientConnected.store(0, std::memory_order_relaxed);
+    for (auto& ring : _header->rings) {
+      ring.head.store(0, std::memory_order_relaxed);
+      ring.tail.store(0, std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    _header->magic = kMagic;
+  }
+
+  LOG_DEBUG("LocalShmSegment.Create", "Created %s for %s (ring capacity %zu, reused %d)",
+            _name.c_str(), sockname.c_str(), ringCapacity, isReused);
+
+  return true;
+}
+
+bool LocalShmSegment::Open(const std::string& sockname)
+{
+  Close(false);
+
+  // Size comes from the segment itself
+  if (!Map(sockname, false, 0)) {
+    Close(false);
+    return false;
+  }
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (_header->magic != kMagic || _header->version != kVersion || _header->totalSize != _mappedSize) {
+    LOG_DEBUG("LocalShmSegment.Open", "Segment %s for %s is not initialized", _name.c_str(), sockname.c_str());
+    Close(false);
+    return false;
+  }
+
+  return true;
+}
+
+bool LocalShmSegment::Map(const std::string& sockname, bool create, size_t size)
+{
+  const std::string& name = GetSegmentName(sockname);
+
+  const int flags = (create ? (O_RDWR | O_CREAT) : O_RDWR);
+  _fd = shm_open(name.c_str(), flags, 0666);
+  if (_fd < 0) {
+    if (create) {
+      LOG_ERROR("LocalShmSegment.Map", "Unable to open %s for %s (%s)", name.c_str(), sockname.c_str(), strerror(errno));
+    }
+    return false;
+  }
+
+  if (create) {
+    // Processes talking to each other may run as different users, don't let the umask get in the way
+    (void) fchmod(_fd, 0666);
+  }
+
+  struct stat info;
+  if (fstat(_fd, &info) != 0) {
+    LOG_ERROR("LocalShmSegment.Map", "Unable to stat %s (%s)", name.c_str(), strerror(errno));
+    return false;
+  }
+
+  if (create) {
+    if ((size_t) info.st_size != size && ftruncate(_fd, (off_t) size) != 0) {
+      LOG_ERROR("LocalShmSegment.Map", "Unable to resize %s to %zu (%s)", name.c_str(), size, strerror(errno));
+      return false;
+    }
+  } else {
+    size = (size_t) info.st_size;
+    if (size < sizeof(Header)) {
+      return false;
+    }
+  }
+
+  void* mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+  if (mem == MAP_FAILED) {
+    LOG_ERROR("LocalShmSegment.Map", "Unable to map %s (%s)", name.c_str(), strerror(errno));
+    return false;
+  }
+
+  _name = name;
+  _mappedSize = size;
+  _header = reinterpret_cast<Header*>(mem);
+
+  return true;
+}
+
+void LocalShmSegment::Close(bool unlink)
+{
+  if (_header != nullptr) {
+    munmap(_header, _mappedSize);
+    _header = nullptr;
+  }
+  _mappedSize = 0;
+
+  if (_fd >= 0) {
+    close(_fd);
+    _fd = -1;
+  }
+
+  if (unlink && !_name.empty()) {
+    shm_unlink(_name.c_str());
+  }
+  _name.clear();
+}
+
+LocalShmSegment::Ring* LocalShmSegment::GetRing(Direction dir) const
+{
+  return &_header->rings[(int) dir];
+}
+
+char* LocalShmSegment::GetRingData(Direction dir) const
+{
+  char* data = reinterpret_cast<char*>(_header) + Align(sizeof(Header), kCacheLineSize);
+  return data + (int) dir * _header->ringCapacity;
+}
+
+size_t LocalShmSegment::GetMaxMessageSize() const
+{
+  // Leave room for a wrap marker in front of the largest message
+  return (_header != nullptr ? (_header->ringCapacity / 2) - kRecordHeaderSize : 0);
+}
+
+ssize_t LocalShmSegment::Write(Direction dir, const char* data, size_t size)
+{
+  if (_header == nullptr || size > GetMaxMessageSize()) {
+    return -1;
+  }
+
+  Ring* ring = GetRing(dir);
+  char* ringData = GetRingData(dir);
+  const uint32_t capacity = _header->ringCapacity;
+
+  const uint32_t head = ring->head.load(std::memory_order_relaxed);
+  const uint32_t tail = ring->tail.load(std::memory_order_acquire);
+  const uint32_t used = head - tail;
+  if (used > capacity) {
+    // Indices got clobbered, e.g. by a peer from a previous run
+    return -1;
+  }
+
+  const uint32_t offset = head & (capacity - 1);
+  const uint32_t untilEnd = capacity - offset;
+  const uint32_t recordSize = (uint32_t) GetRecordSize(size);
+
+  // Messages are never split across the end of the ring
+  const uint32_t padding = (recordSize > untilEnd ? untilEnd : 0);
+  if (used + padding + recordSize > capacity) {
+    return -1;
+  }
+
+  uint32_t writeOffset = offset;
+  if (padding > 0) {
+    memcpy(ringData + offset, &kWrapMarker, kRecordHeaderSize);
+    writeOffset = 0;
+  }
+
+  const uint32_t size32 = (uint32_t) size;
+  memcpy(ringData + writeOffset, &size32, kRecordHeaderSize);
+  memcpy(ringData + writeOffset + kRecordHeaderSize, data, size);
+
+  // Publish the message
+  ring->head.store(head + padding + recordSize, std::memory_order_release);
+
+  return (ssize_t) size;
+}
+
+ssize_t LocalShmSegment::Read(Direction dir, char* data, size_t maxSize)
+{
+  if (_header == nullptr) {
+    return -1;
+  }
+
+  Ring* ring = GetRing(dir);
+  const char* ringData = GetRingData(dir);
+  const uint32_t capacity = _header->ringCapacity;
+
+  uint32_t tail = ring->tail.load(std::memory_order_relaxed);
+  const uint32_t head = ring->head.load(std::memory_order_acquire);
+  if (head - tail > capacity) {
+    // Indices got clobbered, e.g. by a peer from a previous run
+    return -1;
+  }
+
+  while (tail != head) {
+    const uint32_t offset = tail & (capacity - 1);
+
+    uint32_t size = 0;
+    memcpy(&size, ringData + offset, kRecordHeaderSize);
+    if (size == kWrapMarker) {
+      tail += capacity - offset;
+      continue;
+    }
+
+    if (GetRecordSize(size) > head - tail) {
+      // Can't happen with a well-behaved writer
+      return -1;
+    }
+
+    // Like a datagram, anything which doesn't fit is dropped
+    const size_t numBytes = (size < maxSize ? size : maxSize);
+    memcpy(data, ringData + offset + kRecordHeaderSize, numBytes);
+
+    ring->tail.store(tail + (uint32_t) GetRecordSize(size), std::memory_order_release);
+    return (ssize_t) numBytes;
+  }
+
+  // Only wrap markers, if anything
+  ring->tail.store(tail, std::memory_order_release);
+  return 0;
+}
+
+void LocalShmSegment::Skip(Direction dir)
+{
+  if (_header != nullptr) {
+    Ring* ring = GetRing(dir);
+    ring->tail.store(ring->head.load(std::memory_order_acquire), std::memory_order_release);
+  }
+}
+
+size_t LocalShmSegment::GetQueuedSize(Direction dir) const
+{
+  if (_header == nullptr) {
+    return 0;
+  }
+  const Ring* ring = GetRing(dir);
+  return ring->head.load(std::memory_order_acquire) - ring->tail.load(std::memory_order_acquire);
+}
+
+uint32_t LocalShmSegment::GetServerGeneration() const
+{
+  return (_header != nullptr ? _header->serverGeneration.load(std::memory_order_acquire) : 0);
+}
+
+void LocalShmSegment::SetServerGeneration(uint32_t generation)
+{
+  if (_header != nullptr) {
+    _header->serverGeneration.store(generation, std::memory_order_release);
+  }
+}
+
+uint32_t LocalShmSegment::GetClientGeneration() const
+{
+  return (_header != nullptr ? _header->clientGeneration.load(std::memory_order_acquire) : 0);
+}
+
+uint32_t LocalShmSegment::NewClientGeneration()
+{
+  return (_header != nullptr ? _header->clientGeneration.fetch_add(1, std::memory_order_acq_rel) + 1 : 0);
+}
+
+bool LocalShmSegment::IsClientConnected() const
+{
+  return (_header != nullptr && _header->clientConnected.load(std::memory_order_acquire) != 0);
+}
+
+void LocalShmSegment::SetClientConnected(bool connected)
+{
+  if (_header != nullptr) {
+    _header->clientConnected.store(connected ? 1 : 0, std::memory_order_release);
+  }
+}
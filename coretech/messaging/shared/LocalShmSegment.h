@@ -0,0 +1,97 @@
+/**
+ * File: LocalShmSegment.h
+ *
+ * Description: Shared memory segment used by LocalShmServer and LocalShmClient
+ *
+ * The segment holds a small header and two single-producer/single-consumer rings of
+ * length-prefixed messages, one for each direction. Writing or reading a message is a
+ * memcpy plus an atomic index update, so there are no syscalls or kernel copies per
+ * message. Readers poll, just like the non-blocking sockets they replace.
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#ifndef ANKI_MESSAGING_LOCAL_SHM_SEGMENT_H
+#define ANKI_MESSAGING_LOCAL_SHM_SEGMENT_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include <sys/types.h>
+
+class LocalShmSegment
+{
+public:
+
+  enum class Direction {
+    ToServer = 0,
+    ToClient = 1,
+  };
+
+  LocalShmSegment();
+  ~LocalShmSegment();
+
+  LocalShmSegment(const LocalShmSegment&) = delete;
+  LocalShmSegment& operator=(const LocalShmSegment&) = delete;
+
+  // Server side: creates the segment for the given socket path, or reuses one left behind by
+  // a previous server (so that its clients notice the restart). Each ring holds ringCapacity
+  // bytes, which must be a power of two.
+  bool Create(const std::string& sockname, size_t ringCapacity);
+
+  // Client side: maps the segment created by the server at the given socket path
+  bool Open(const std::string& sockname);
+
+  // Unmaps the segment, and removes it if unlink is true (server side)
+  void Close(bool unlink);
+
+  bool IsOpen() const { return _header != nullptr; }
+
+  // Appends one message to the ring. Returns size, or -1 if there isn't enough room.
+  ssize_t Write(Direction dir, const char* data, size_t size);
+
+  // Pops the next message from the ring. Returns its size (truncated to maxSize, like a
+  // datagram) or 0 if the ring is empty.
+  ssize_t Read(Direction dir, char* data, size_t maxSize);
+
+  // Drops everything currently queued in the ring (reader side)
+  void Skip(Direction dir);
+
+  // Count of bytes queued in the ring, including message framing
+  size_t GetQueuedSize(Direction dir) const;
+
+  // Largest message that can be written
+  size_t GetMaxMessageSize() const;
+
+  // Changes every time a server (re)starts on this segment, 0 if it has stopped
+  uint32_t GetServerGeneration() const;
+  void     SetServerGeneration(uint32_t generation);
+
+  // Changes every time a client connects, so the server can tell a new client from an old one
+  uint32_t GetClientGeneration() const;
+  uint32_t NewClientGeneration();
+  bool     IsClientConnected() const;
+  void     SetClientConnected(bool connected);
+
+  // Name of the shared memory object for a socket path (short enough for all platforms)
+  static std::string GetSegmentName(const std::string& sockname);
+
+private:
+
+  struct Header;
+  struct Ring;
+
+  bool Map(const std::string& sockname, bool create, size_t size);
+
+  Ring*  GetRing(Direction dir) const;
+  char*  GetRingData(Direction dir) const;
+
+  std::string _name;
+  int         _fd = -1;
+  size_t      _mappedSize = 0;
+  Header*     _header = nullptr;
+};
+
+#endif
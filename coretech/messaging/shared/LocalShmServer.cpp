@@ -0,0 +1,198 @@
+/**
+ * File: LocalShmServer.cpp
+ *
+ * Description: Implementation of shared memory server class
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "coretech/messaging/shared/LocalShmServer.h"
+#include "coretech/messaging/shared/LocalUdpServer.h" // for kConnectionPacket
+#include "coretech/common/shared/logging.h"
+
+#include <cstring>
+
+//
+// Ring buffer size, in each direction. Large enough for a full face image in one message.
+//
+#define SHM_SERVER_RINGSZ (512*1024)
+
+// Define this to enable logs
+#define LOG_CHANNEL                    "LocalShmServer"
+
+#ifdef  LOG_CHANNEL
+#define LOG_ERROR(name, format, ...)   CORETECH_LOG_ERROR(name, format, ##__VA_ARGS__)
+#define LOG_WARNING(name, format, ...) CORETECH_LOG_WARNING(name, format, ##__VA_ARGS__)
+#define LOG_INFO(name, format, ...)    CORETECH_LOG_INFO(LOG_CHANNEL, name, format, ##__VA_ARGS__)
+#define LOG_DEBUG(name, format, ...)   CORETECH_LOG_DEBUG(LOG_CHANNEL, name, format, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(name, format, ...)   {}
+#define LOG_WARNING(name, format, ...) {}
+#define LOG_INFO(name, format, ...)    {}
+#define LOG_DEBUG(name, format, ...)   {}
+#endif
+
+LocalShmServer::LocalShmServer(size_t ringCapacity)
+: _ringCapacity(ringCapacity)
+{
+}
+
+LocalShmServer::LocalShmServer() : LocalShmServer(SHM_SERVER_RINGSZ)
+{
+}
+
+LocalShmServer::~LocalShmServer()
+{
+  if (_segment.IsOpen()) {
+    StopListening();
+  }
+}
+
+bool LocalShmServer::StartListening(const std::string & sockname)
+{
+  if (_segment.IsOpen()) {
+    LOG_ERROR("LocalShmServer.StartListening", "Server is already listening");
+    return false;
+  }
+
+  _sockname = sockname;
+
+  LOG_DEBUG("LocalShmServer.StartListening", "Creating segment %s for %s",
+            LocalShmSegment::GetSegmentName(_sockname).c_str(), _sockname.c_str());
+
+  if (!_segment.Create(_sockname, _ringCapacity)) {
+    LOG_ERROR("LocalShmServer.StartListening", "Unable to create segment for %s", _sockname.c_str());
+    return false;
+  }
+
+  // Anything queued is for a previous server
+  _segment.Skip(Direction::ToServer);
+
+  // Tell clients of a previous server that they have to reconnect
+  uint32_t generation = _segment.GetServerGeneration() + 1;
+  if (generation == 0) {
+    ++generation;
+  }
+  _segment.SetServerGeneration(generation);
+
+  _hasClient = false;
+
+  LOG_DEBUG("LocalShmServer.StartListening", "Listening at %s (generation %u)", _sockname.c_str(), generation);
+
+  return true;
+}
+
+void LocalShmServer::StopListening()
+{
+  if (!_segment.IsOpen()) {
+    LOG_DEBUG("LocalShmServer.StopListening", "Server already stopped");
+    return;
+  }
+
+  LOG_DEBUG("LocalShmServer.StopListening", "Stopping server listening at %s", _sockname.c_str());
+
+  if (HasClient()) {
+    Disconnect();
+  }
+
+  std::lock_guard<std::mutex> lock(_sendMutex);
+  _segment.SetServerGeneration(0);
+  _segment.Close(true);
+}
+
+bool LocalShmServer::HasClient() const
+{
+  // A client which disconnects, or is replaced by a new one, doesn't need to tell us
+  return (_hasClient &&
+          _segment.IsClientConnected() &&
+          _segment.GetClientGeneration() == _clientGeneration);
+}
+
+void LocalShmServer::Disconnect()
+{
+  if (!_hasClient) {
+    return;
+  }
+
+  LOG_DEBUG("LocalShmServer.Disconnect", "Disconnect from client %u at %s", _clientGeneration, _sockname.c_str());
+
+  _hasClient = false;
+}
+
+ssize_t LocalShmServer::Send(const char* data, size_t size)
+{
+  if (size <= 0) {
+    return 0;
+  }
+
+  if (!HasClient()) {
+    LOG_DEBUG("LocalShmServer.Send", "No client");
+    return -1;
+  }
+
+  ssize_t bytes_sent = 0;
+  {
+    std::lock_guard<std::mutex> lock(_sendMutex);
+    bytes_sent = _segment.Write(Direction::ToClient, data, size);
+  }
+
+  if (bytes_sent != (ssize_t) size) {
+    // If send fails, log it and report it to caller.  It is caller's responsibility to retry at
+    // some appropriate interval.
+    LOG_WARNING("LocalShmServer.Send.Fail",
+                "Sent %zd bytes instead of %zu on %s (%zu bytes queued)",
+                bytes_sent, size, _sockname.c_str(), _segment.GetQueuedSize(Direction::ToClient));
+  }
+
+  return bytes_sent;
+}
+
+ssize_t LocalShmServer::Recv(char* data, size_t maxSize)
+{
+  if (!_segment.IsOpen()) {
+    LOG_ERROR("LocalShmServer.Recv.Fail", "Server is not listening");
+    return -1;
+  }
+
+  const ssize_t bytes_received = _segment.Read(Direction::ToServer, data, maxSize);
+  if (bytes_received <= 0) {
+    if (bytes_received < 0) {
+      LOG_ERROR("LocalShmServer.Recv.Fail", "Receive error on %s", _sockname.c_str());
+    }
+    return bytes_received;
+  }
+
+  // Connect to new client?
+  const uint32_t clientGeneration = _segment.GetClientGeneration();
+  if (!_hasClient || clientGeneration != _clientGeneration) {
+    LOG_DEBUG("LocalShmServer.Recv.NewClient", "Client %u at %s", clientGeneration, _sockname.c_str());
+    _hasClient = true;
+    _clientGeneration = clientGeneration;
+  }
+
+  // Check if this is a connection packet
+  if (bytes_received == sizeof(LocalUdpServer::kConnectionPacket) &&
+      strncmp(data, LocalUdpServer::kConnectionPacket, sizeof(LocalUdpServer::kConnectionPacket)) == 0)  {
+    LOG_DEBUG("LocalShmServer.Recv.ReceivedConnectionPacket", "");
+    return 0;
+  }
+
+  return bytes_received;
+}
+
+ssize_t LocalShmServer::GetIncomingSize() const
+{
+  if (_segment.IsOpen()) {
+    return (ssize_t) _segment.GetQueuedSize(Direction::ToServer);
+  }
+  return -1;
+}
+
+ssize_t LocalShmServer::GetOutgoingSize() const
+{
+  if (_segment.IsOpen()) {
+    return (ssize_t) _segment.GetQueuedSize(Direction::ToClient);
+  }
+  return -1;
+}
@@ -0,0 +1,65 @@
+/**
+ * File: LocalShmServer.h
+ *
+ * Description: Declaration of shared memory server class
+ *
+ * Drop-in replacement for LocalUdpServer. Messages are exchanged through a shared memory
+ * segment named after the socket path, so the client connects with the same paths it would
+ * use for LocalUdpClient. Like LocalUdpServer, it is limited to ONE CLIENT PER SERVER.
+ *
+ * Send may be called from any thread. Recv must only be called from one thread at a time.
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#ifndef ANKI_MESSAGING_LOCAL_SHM_SERVER_H
+#define ANKI_MESSAGING_LOCAL_SHM_SERVER_H
+
+#include "coretech/messaging/shared/LocalShmSegment.h"
+
+#include <mutex>
+#include <string>
+
+class LocalShmServer {
+public:
+  LocalShmServer(size_t ringCapacity);
+  LocalShmServer();
+
+  ~LocalShmServer();
+
+  // Segment lifetime
+  bool StartListening(const std::string & sockname);
+  void StopListening();
+
+  // Client management
+  bool HasClient() const;
+  void Disconnect();
+
+  // Client transport
+  ssize_t Send(const char* data, size_t size);
+  ssize_t Recv(char* data, size_t maxSize);
+
+  // Return count of bytes queued for read or -1 on error
+  ssize_t GetIncomingSize() const;
+
+  // Return count of bytes queued for write or -1 on error
+  ssize_t GetOutgoingSize() const;
+
+private:
+  using Direction = LocalShmSegment::Direction;
+
+  // Bytes in each direction
+  size_t _ringCapacity;
+
+  LocalShmSegment _segment;
+  std::string _sockname;
+
+  // Generation of the client we last heard from
+  bool _hasClient = false;
+  uint32_t _clientGeneration = 0;
+
+  std::mutex _sendMutex;
+};
+
+#endif
@@ -0,0 +1,189 @@
+/**
+ * File: LocalTransport.cpp
+ *
+ * Description: Implementation of local transport server and client classes
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "coretech/messaging/shared/LocalTransport.h"
+#include "coretech/messaging/shared/LocalShmClient.h"
+#include "coretech/messaging/shared/LocalShmServer.h"
+#include "coretech/messaging/shared/LocalUdpClient.h"
+#include "coretech/messaging/shared/LocalUdpServer.h"
+#include "coretech/common/shared/logging.h"
+
+#include <cstdlib>
+#include <cstring>
+
+// Define this to enable logs
+#define LOG_CHANNEL                    "LocalTransport"
+
+#ifdef  LOG_CHANNEL
+#define LOG_ERROR(name, format, ...)   CORETECH_LOG_ERROR(name, format, ##__VA_ARGS__)
+#define LOG_WARNING(name, format, ...) CORETECH_LOG_WARNING(name, format, ##__VA_ARGS__)
+#define LOG_INFO(name, format, ...)    CORETECH_LOG_INFO(LOG_CHANNEL, name, format, ##__VA_ARGS__)
+#define LOG_DEBUG(name, format, ...)   CORETECH_LOG_DEBUG(LOG_CHANNEL, name, format, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(name, format, ...)   {}
+#define LOG_WARNING(name, format, ...) {}
+#define LOG_INFO(name, format, ...)    {}
+#define LOG_DEBUG(name, format, ...)   {}
+#endif
+
+LocalTransportType GetLocalTransportType()
+{
+  static const LocalTransportType type = []() {
+    const char* env = getenv("VIC_LOCAL_TRANSPORT");
+    if (env == nullptr || env[0] == 0 || strcmp(env, "udp") == 0) {
+      return LocalTransportType::Udp;
+    }
+    if (strcmp(env, "shm") == 0) {
+      return LocalTransportType::SharedMemory;
+    }
+    LOG_WARNING("LocalTransport.GetLocalTransportType", "Unknown transport '%s', using udp", env);
+    return LocalTransportType::Udp;
+  }();
+  return type;
+}
+
+const char* GetLocalTransportName(LocalTransportType type)
+{
+  switch (type) {
+    case LocalTransportType::Udp:
+      return "udp";
+    case LocalTransportType::SharedMemory:
+      return "shm";
+  }
+  return "unknown";
+}
+
+//
+// LocalTransportServer
+//
+LocalTransportServer::LocalTransportServer(LocalTransportType type)
+: _type(type)
+{
+  if (_type == LocalTransportType::SharedMemory) {
+    _shmServer = std::make_unique<LocalShmServer>();
+  } else {
+    _udpServer = std::make_unique<LocalUdpServer>();
+  }
+}
+
+LocalTransportServer::LocalTransportServer() : LocalTransportServer(GetLocalTransportType())
+{
+}
+
+LocalTransportServer::~LocalTransportServer()
+{
+}
+
+bool LocalTransportServer::StartListening(const std::string & sockname)
+{
+  LOG_DEBUG("LocalTransportServer.StartListening", "Listening at %s using %s",
+            sockname.c_str(), GetLocalTransportName(_type));
+  return (_shmServer ? _shmServer->StartListening(sockname) : _udpServer->StartListening(sockname));
+}
+
+void LocalTransportServer::StopListening()
+{
+  if (_shmServer) {
+    _shmServer->StopListening();
+  } else {
+    _udpServer->StopListening();
+  }
+}
+
+bool LocalTransportServer::HasClient() const
+{
+  return (_shmServer ? _shmServer->HasClient() : _udpServer->HasClient());
+}
+
+void LocalTransportServer::Disconnect()
+{
+  if (_shmServer) {
+    _shmServer->Disconnect();
+  } else {
+    _udpServer->Disconnect();
+  }
+}
+
+ssize_t LocalTransportServer::Send(const char* data, size_t size)
+{
+  return (_shmServer ? _shmServer->Send(data, size) : _udpServer->Send(data, size));
+}
+
+ssize_t LocalTransportServer::Recv(char* data, size_t maxSize)
+{
+  return (_shmServer ? _shmServer->Recv(data, maxSize) : _udpServer->Recv(data, maxSize));
+}
+
+ssize_t LocalTransportServer::GetIncomingSize() const
+{
+  return (_shmServer ? _shmServer->GetIncomingSize() : _udpServer->GetIncomingSize());
+}
+
+ssize_t LocalTransportServer::GetOutgoingSize() const
+{
+  return (_shmServer ? _shmServer->GetOutgoingSize() : _udpServer->GetOutgoingSize());
+}
+
+//
+// LocalTransportClient
+//
+LocalTransportClient::LocalTransportClient(LocalTransportType type)
+: _type(type)
+{
+  if (_type == LocalTransportType::SharedMemory) {
+    _shmClient = std::make_unique<LocalShmClient>();
+  } else {
+    _udpClient = std::make_unique<LocalUdpClient>();
+  }
+}
+
+LocalTransportClient::LocalTransportClient() : LocalTransportClient(GetLocalTransportType())
+{
+}
+
+LocalTransportClient::~LocalTransportClient()
+{
+}
+
+bool LocalTransportClient::Connect(const std::string& sockname, const std::string& peername)
+{
+  LOG_DEBUG("LocalTransportClient.Connect", "Connect from %s to %s using %s",
+            sockname.c_str(), peername.c_str(), GetLocalTransportName(_type));
+  return (_shmClient ? _shmClient->Connect(sockname, peername) : _udpClient->Connect(sockname, peername));
+}
+
+bool LocalTransportClient::IsConnected() const
+{
+  return (_shmClient ? _shmClient->IsConnected() : _udpClient->IsConnected());
+}
+
+bool LocalTransportClient::Disconnect()
+{
+  return (_shmClient ? _shmClient->Disconnect() : _udpClient->Disconnect());
+}
+
+ssize_t LocalTransportClient::Send(const char* data, size_t size)
+{
+  return (_shmClient ? _shmClient->Send(data, size) : _udpClient->Send(data, size));
+}
+
+ssize_t LocalTransportClient::Recv(char* data, size_t maxSize)
+{
+  return (_shmClient ? _shmClient->Recv(data, maxSize) : _udpClient->Recv(data, maxSize));
+}
+
+ssize_t LocalTransportClient::GetIncomingSize() const
+{
+  return (_shmClient ? _shmClient->GetIncomingSize() : _udpClient->GetIncomingSize());
+}
+
+ssize_t LocalTransportClient::GetOutgoingSize() const
+{
+  return (_shmClient ? _shmClient->GetOutgoingSize() : _udpClient->GetOutgoingSize());
+}
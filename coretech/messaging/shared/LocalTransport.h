@@ -0,0 +1,101 @@
+/**
+ * File: LocalTransport.h
+ *
+ * Description: Server and client for messaging between processes on the robot, using either
+ * local-domain sockets (LocalUdpServer/LocalUdpClient) or shared memory (LocalShmServer/LocalShmClient).
+ *
+ * The transport is chosen once per process from the VIC_LOCAL_TRANSPORT environment variable
+ * ("udp" or "shm", default "udp"). Both ends of a connection must use the same transport.
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#ifndef ANKI_MESSAGING_LOCAL_TRANSPORT_H
+#define ANKI_MESSAGING_LOCAL_TRANSPORT_H
+
+#include <memory>
+#include <string>
+
+#include <sys/types.h>
+
+class LocalUdpServer;
+class LocalUdpClient;
+class LocalShmServer;
+class LocalShmClient;
+
+enum class LocalTransportType {
+  Udp,
+  SharedMemory,
+};
+
+// Transport selected for this process
+LocalTransportType GetLocalTransportType();
+const char* GetLocalTransportName(LocalTransportType type);
+
+class LocalTransportServer {
+public:
+  explicit LocalTransportServer(LocalTransportType type);
+  LocalTransportServer();
+
+  ~LocalTransportServer();
+
+  LocalTransportType GetType() const { return _type; }
+
+  // Lifetime
+  bool StartListening(const std::string & sockname);
+  void StopListening();
+
+  // Client management
+  bool HasClient() const;
+  void Disconnect();
+
+  // Client transport
+  ssize_t Send(const char* data, size_t size);
+  ssize_t Recv(char* data, size_t maxSize);
+
+  // Return count of bytes queued for read or -1 on error
+  ssize_t GetIncomingSize() const;
+
+  // Return count of bytes queued for write or -1 on error
+  ssize_t GetOutgoingSize() const;
+
+private:
+  const LocalTransportType _type;
+
+  // Exactly one of these is set
+  std::unique_ptr<LocalUdpServer> _udpServer;
+  std::unique_ptr<LocalShmServer> _shmServer;
+};
+
+class LocalTransportClient {
+public:
+  explicit LocalTransportClient(LocalTransportType type);
+  LocalTransportClient();
+
+  ~LocalTransportClient();
+
+  LocalTransportType GetType() const { return _type; }
+
+  bool Connect(const std::string& sockname, const std::string& peername);
+  bool IsConnected() const;
+  bool Disconnect();
+
+  ssize_t Send(const char* data, size_t size);
+  ssize_t Recv(char* data, size_t maxSize);
+
+  // Return count of bytes queued for read or -1 on error
+  ssize_t GetIncomingSize() const;
+
+  // Return count of bytes queued for write or -1 on error
+  ssize_t GetOutgoingSize() const;
+
+private:
+  const LocalTransportType _type;
+
+  // Exactly one of these is set
+  std::unique_ptr<LocalUdpClient> _udpClient;
+  std::unique_ptr<LocalShmClient> _shmClient;
+};
+
+#endif
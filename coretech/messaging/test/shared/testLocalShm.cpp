@@ -0,0 +1,416 @@
+/**
+ * File: testLocalShm.cpp
+ *
+ * Description: Unit tests for the shared memory transport (LocalShmSegment, LocalShmServer, LocalShmClient and
+ *              LocalTransport)
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ * --gtest_filter=LocalShm*
+ **/
+
+#include "util/helpers/includeGTest.h" // Used in place of gTest/gTest.h directly to suppress warnings in the header
+
+#include "coretech/messaging/shared/LocalShmClient.h"
+#include "coretech/messaging/shared/LocalShmSegment.h"
+#include "coretech/messaging/shared/LocalShmServer.h"
+#include "coretech/messaging/shared/LocalTransport.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+using Direction = LocalShmSegment::Direction;
+
+// Segments are named after the socket path, so every test uses its own to not see leftovers from another one
+std::string GetTestSockname(const std::string& name)
+{
+  return "/tmp/_testLocalShm_" + std::to_string(getpid()) + "_" + name;
+}
+
+// Message contents depend on seq, so that out of order or corrupted messages are caught
+std::vector<char> MakeMessage(size_t size, uint32_t seq)
+{
+  std::vector<char> msg(size);
+  for (size_t i = 0; i < size; ++i) {
+    msg[i] = (char) ((seq * 31 + i) & 0xff);
+  }
+  return msg;
+}
+
+void WriteMessage(LocalShmSegment& segment, size_t size, uint32_t seq)
+{
+  const std::vector<char> msg = MakeMessage(size, seq);
+  ASSERT_EQ((ssize_t) size, segment.Write(Direction::ToServer, msg.data(), msg.size()));
+}
+
+void ExpectMessage(LocalShmSegment& segment, size_t size, uint32_t seq)
+{
+  std::vector<char> buf(size + 16);
+  ASSERT_EQ((ssize_t) size, segment.Read(Direction::ToServer, buf.data(), buf.size()));
+  buf.resize(size);
+  EXPECT_TRUE(buf == MakeMessage(size, seq)) << "Message " << seq << " doesn't match";
+}
+
+// Server and client exchanging messages, for the tests which only care about the connection
+void ExpectRoundTrip(LocalShmServer& server, LocalShmClient& client, uint32_t seq)
+{
+  const std::vector<char> msg = MakeMessage(100, seq);
+  std::vector<char> buf(256);
+
+  ASSERT_EQ((ssize_t) msg.size(), client.Send(msg.data(), msg.size()));
+  ASSERT_EQ((ssize_t) msg.size(), server.Recv(buf.data(), buf.size()));
+  EXPECT_TRUE(std::equal(msg.begin(), msg.end(), buf.begin()));
+
+  ASSERT_EQ((ssize_t) msg.size(), server.Send(msg.data(), msg.size()));
+  ASSERT_EQ((ssize_t) msg.size(), client.Recv(buf.data(), buf.size()));
+  EXPECT_TRUE(std::equal(msg.begin(), msg.end(), buf.begin()));
+}
+
+// Connects the client and has the server pick up its connection packet
+void ConnectClient(LocalShmServer& server, LocalShmClient& client, const std::string& sockname)
+{
+  ASSERT_TRUE(client.Connect("", sockname));
+  char buf[64];
+  EXPECT_EQ(0, server.Recv(buf, sizeof(buf)));
+  EXPECT_TRUE(server.HasClient());
+}
+
+} // anonymous namespace
+
+
+// Messages of odd sizes, so that they land everywhere in the ring and often don't fit before its end
+GTEST_TEST(LocalShmSegment, RingWrapAround)
+{
+  const size_t kRingCapacity = 4096;
+  LocalShmSegment segment;
+  ASSERT_TRUE(segment.Create(GetTestSockname("RingWrapAround"), kRingCapacity));
+
+  uint32_t writeSeq = 0;
+  uint32_t readSeq = 0;
+  size_t numBytes = 0;
+  for (int i = 0; i < 2000; ++i) {
+    // Keep up to three messages queued, so the reader trails the writer across the end of the ring
+    const size_t size = 1 + (i * 397) % 1000;
+    WriteMessage(segment, size, writeSeq++);
+    numBytes += size;
+    if (writeSeq - readSeq == 3) {
+      ExpectMessage(segment, 1 + (readSeq * 397) % 1000, readSeq);
+      ++readSeq;
+    }
+  }
+  while (readSeq != writeSeq) {
+    ExpectMessage(segment, 1 + (readSeq * 397) % 1000, readSeq);
+    ++readSeq;
+  }
+  EXPECT_GT(numBytes, 100 * kRingCapacity);
+
+  char buf[16];
+  EXPECT_EQ(0, segment.Read(Direction::ToServer, buf, sizeof(buf)));
+  EXPECT_EQ(0, segment.GetQueuedSize(Direction::ToServer));
+
+  segment.Close(true);
+}
+
+// Head and tail count every byte ever written/read, so they overflow 32 bits after 4GB. Sizes are picked so that the
+// overflow happens with messages straddling it
+GTEST_TEST(LocalShmSegment, IndexWrapAround)
+{
+  const size_t kRingCapacity = 1 << 22;
+  LocalShmSegment segment;
+  ASSERT_TRUE(segment.Create(GetTestSockname("IndexWrapAround"), kRingCapacity));
+
+  const size_t kMaxMessageSize = segment.GetMaxMessageSize();
+  const std::vector<char> bigMsg(kMaxMessageSize, 'x');
+  std::vector<char> buf(kMaxMessageSize);
+
+  // Get close to the overflow with the largest messages. Records are padded to 8 bytes, and the ring data is written
+  // in place, so this also keeps wrapping around the ring
+  const uint64_t kBytesUntilOverflow = (1ull << 32) - 3 * kRingCapacity;
+  uint64_t numBytes = 0;
+  while (numBytes < kBytesUntilOverflow) {
+    ASSERT_EQ((ssize_t) kMaxMessageSize, segment.Write(Direction::ToServer, bigMsg.data(), bigMsg.size()));
+    ASSERT_EQ((ssize_t) kMaxMessageSize, segment.Read(Direction::ToServer, buf.data(), buf.size()));
+    numBytes += kMaxMessageSize;
+  }
+
+  // Then keep going with small messages of odd sizes across the overflow, checking every one of them
+  uint32_t writeSeq = 0;
+  uint32_t readSeq = 0;
+  while (numBytes < (1ull << 32) + 3 * kRingCapacity) {
+    const size_t size = 1 + (writeSeq * 7919) % 20000;
+    WriteMessage(segment, size, writeSeq++);
+    numBytes += size;
+    if (writeSeq - readSeq == 8) {
+      ExpectMessage(segment, 1 + (readSeq * 7919) % 20000, readSeq);
+      ++readSeq;
+    }
+    ASSERT_LE(segment.GetQueuedSize(Direction::ToServer), kRingCapacity);
+  }
+  while (readSeq != writeSeq) {
+    ExpectMessage(segment, 1 + (readSeq * 7919) % 20000, readSeq);
+    ++readSeq;
+  }
+  EXPECT_EQ(0, segment.GetQueuedSize(Direction::ToServer));
+
+  segment.Close(true);
+}
+
+// A full ring doesn't block or overwrite anything, writes fail until the reader catches up
+GTEST_TEST(LocalShmSegment, FullRing)
+{
+  const size_t kRingCapacity = 4096;
+  const size_t kMessageSize = 100;
+  LocalShmSegment segment;
+  ASSERT_TRUE(segment.Create(GetTestSockname("FullRing"), kRingCapacity));
+
+  uint32_t writeSeq = 0;
+  const std::vector<char> msg = MakeMessage(kMessageSize, 1000);
+  while (segment.Write(Direction::ToServer, msg.data(), msg.size()) == (ssize_t) kMessageSize) {
+    ++writeSeq;
+    ASSERT_LE(writeSeq * kMessageSize, kRingCapacity);
+  }
+  ASSERT_GT(writeSeq, 0);
+
+  // Nothing was written by the failed write, and the other direction is unaffected
+  const size_t queuedSize = segment.GetQueuedSize(Direction::ToServer);
+  EXPECT_LE(queuedSize, kRingCapacity);
+  EXPECT_EQ(-1, segment.Write(Direction::ToServer, msg.data(), msg.size()));
+  EXPECT_EQ(queuedSize, segment.GetQueuedSize(Direction::ToServer));
+  EXPECT_EQ((ssize_t) kMessageSize, segment.Write(Direction::ToClient, msg.data(), msg.size()));
+
+  // Reading one message makes room for one more
+  std::vector<char> buf(kMessageSize);
+  ASSERT_EQ((ssize_t) kMessageSize, segment.Read(Direction::ToServer, buf.data(), buf.size()));
+  EXPECT_TRUE(buf == msg);
+  EXPECT_EQ((ssize_t) kMessageSize, segment.Write(Direction::ToServer, msg.data(), msg.size()));
+  EXPECT_EQ(-1, segment.Write(Direction::ToServer, msg.data(), msg.size()));
+
+  // Everything that was accepted comes out intact
+  for (uint32_t i = 0; i < writeSeq; ++i) {
+    ASSERT_EQ((ssize_t) kMessageSize, segment.Read(Direction::ToServer, buf.data(), buf.size()));
+    EXPECT_TRUE(buf == msg);
+  }
+  EXPECT_EQ(0, segment.Read(Direction::ToServer, buf.data(), buf.size()));
+
+  segment.Close(true);
+}
+
+GTEST_TEST(LocalShmSegment, OversizedMessages)
+{
+  const size_t kRingCapacity = 4096;
+  LocalShmSegment segment;
+  ASSERT_TRUE(segment.Create(GetTestSockname("OversizedMessages"), kRingCapacity));
+
+  // Too large to write at all
+  const size_t kMaxMessageSize = segment.GetMaxMessageSize();
+  ASSERT_GT(kMaxMessageSize, 0);
+  ASSERT_LT(kMaxMessageSize, kRingCapacity);
+  const std::vector<char> tooBig(kMaxMessageSize + 1, 'x');
+  EXPECT_EQ(-1, segment.Write(Direction::ToServer, tooBig.data(), tooBig.size()));
+  EXPECT_EQ(0, segment.GetQueuedSize(Direction::ToServer));
+
+  // The largest message fits wherever the ring currently is
+  for (uint32_t seq = 0; seq < 10; ++seq) {
+    WriteMessage(segment, 1 + seq * 37, seq);
+    ExpectMessage(segment, 1 + seq * 37, seq);
+    WriteMessage(segment, kMaxMessageSize, seq);
+    ExpectMessage(segment, kMaxMessageSize, seq);
+  }
+
+  // Like a datagram, a message larger than the read buffer is truncated and the rest of it is dropped
+  WriteMessage(segment, 1000, 1);
+  WriteMessage(segment, 10, 2);
+  std::vector<char> buf(100);
+  ASSERT_EQ(100, segment.Read(Direction::ToServer, buf.data(), buf.size()));
+  const std::vector<char> expected = MakeMessage(1000, 1);
+  EXPECT_TRUE(std::equal(buf.begin(), buf.end(), expected.begin()));
+  ExpectMessage(segment, 10, 2);
+
+  segment.Close(true);
+}
+
+GTEST_TEST(LocalShmServer, ConnectAndExchange)
+{
+  const std::string sockname = GetTestSockname("ConnectAndExchange");
+  LocalShmServer server;
+  ASSERT_TRUE(server.StartListening(sockname));
+  EXPECT_FALSE(server.HasClient());
+
+  LocalShmClient client;
+  ConnectClient(server, client, sockname);
+  EXPECT_TRUE(client.IsConnected());
+
+  for (uint32_t seq = 0; seq < 10; ++seq) {
+    ExpectRoundTrip(server, client, seq);
+  }
+  EXPECT_EQ(0, server.GetIncomingSize());
+  EXPECT_EQ(0, client.GetIncomingSize());
+
+  client.Disconnect();
+  EXPECT_FALSE(server.HasClient());
+
+  server.StopListening();
+}
+
+// Server sends are dropped while the client isn't keeping up. A client which can't send disconnects, like
+// LocalUdpClient does on a send error
+GTEST_TEST(LocalShmServer, FullRing)
+{
+  const std::string sockname = GetTestSockname("ServerFullRing");
+  const size_t kRingCapacity = 4096;
+  LocalShmServer server(kRingCapacity);
+  ASSERT_TRUE(server.StartListening(sockname));
+
+  LocalShmClient client;
+  ConnectClient(server, client, sockname);
+
+  const std::vector<char> msg = MakeMessage(500, 1);
+  int numSent = 0;
+  while (server.Send(msg.data(), msg.size()) == (ssize_t) msg.size()) {
+    ++numSent;
+    ASSERT_LT(numSent, 100);
+  }
+  EXPECT_GT(numSent, 0);
+  EXPECT_TRUE(server.HasClient());
+
+  // Whatever was accepted is delivered, the dropped message isn't
+  std::vector<char> buf(1000);
+  for (int i = 0; i < numSent; ++i) {
+    ASSERT_EQ((ssize_t) msg.size(), client.Recv(buf.data(), buf.size()));
+  }
+  EXPECT_EQ(0, client.Recv(buf.data(), buf.size()));
+  EXPECT_TRUE(client.IsConnected());
+
+  // Nothing reads what the client sends
+  while (client.Send(msg.data(), msg.size()) == (ssize_t) msg.size()) {
+    ASSERT_TRUE(client.IsConnected());
+  }
+  EXPECT_FALSE(client.IsConnected());
+  EXPECT_FALSE(server.HasClient());
+
+  server.StopListening();
+}
+
+GTEST_TEST(LocalShmServer, OversizedMessages)
+{
+  const std::string sockname = GetTestSockname("ServerOversizedMessages");
+  const size_t kRingCapacity = 4096;
+  LocalShmServer server(kRingCapacity);
+  ASSERT_TRUE(server.StartListening(sockname));
+
+  LocalShmClient client;
+  ConnectClient(server, client, sockname);
+
+  const std::vector<char> tooBig(kRingCapacity, 'x');
+  EXPECT_EQ(-1, server.Send(tooBig.data(), tooBig.size()));
+  EXPECT_TRUE(server.HasClient());
+  EXPECT_EQ(0, client.GetIncomingSize());
+
+  ExpectRoundTrip(server, client, 1);
+
+  server.StopListening();
+}
+
+// A restarted server bumps the generation in the segment, clients of the previous one notice and reconnect
+GTEST_TEST(LocalShmClient, ReconnectAfterServerRestart)
+{
+  const std::string sockname = GetTestSockname("ReconnectAfterServerRestart");
+  LocalShmClient client;
+
+  {
+    // Server goes away cleanly
+    LocalShmServer server;
+    ASSERT_TRUE(server.StartListening(sockname));
+    ConnectClient(server, client, sockname);
+    ExpectRoundTrip(server, client, 1);
+    server.StopListening();
+  }
+
+  char buf[256];
+  EXPECT_EQ(-1, client.Recv(buf, sizeof(buf)));
+  EXPECT_FALSE(client.IsConnected());
+  EXPECT_FALSE(client.Connect("", sockname));
+
+  LocalShmServer server;
+  ASSERT_TRUE(server.StartListening(sockname));
+  ConnectClient(server, client, sockname);
+  ExpectRoundTrip(server, client, 2);
+
+  // Server crashes without cleaning up, and a new one reuses the segment it left behind. Nothing queued by either
+  // side is delivered to the new connection
+  const std::vector<char> msg = MakeMessage(100, 3);
+  ASSERT_EQ((ssize_t) msg.size(), client.Send(msg.data(), msg.size()));
+  ASSERT_EQ((ssize_t) msg.size(), server.Send(msg.data(), msg.size()));
+
+  LocalShmServer restartedServer;
+  ASSERT_TRUE(restartedServer.StartListening(sockname));
+  EXPECT_EQ(-1, client.Send(msg.data(), msg.size()));
+  EXPECT_FALSE(client.IsConnected());
+
+  ConnectClient(restartedServer, client, sockname);
+  EXPECT_EQ(0, restartedServer.GetIncomingSize());
+  EXPECT_EQ(0, client.GetIncomingSize());
+  ExpectRoundTrip(restartedServer, client, 4);
+
+  restartedServer.StopListening();
+}
+
+// A new client replaces the previous one, which the server notices without hearing from the previous one
+GTEST_TEST(LocalShmClient, NewClientReplacesPrevious)
+{
+  const std::string sockname = GetTestSockname("NewClientReplacesPrevious");
+  LocalShmServer server;
+  ASSERT_TRUE(server.StartListening(sockname));
+
+  LocalShmClient client;
+  ConnectClient(server, client, sockname);
+
+  LocalShmClient newClient;
+  ASSERT_TRUE(newClient.Connect("", sockname));
+  EXPECT_FALSE(server.HasClient());
+
+  char buf[64];
+  EXPECT_EQ(0, server.Recv(buf, sizeof(buf)));
+  EXPECT_TRUE(server.HasClient());
+  ExpectRoundTrip(server, newClient, 1);
+
+  // The previous client going away doesn't disconnect the new one
+  client.Disconnect();
+  EXPECT_TRUE(server.HasClient());
+
+  server.StopListening();
+}
+
+GTEST_TEST(LocalTransport, SharedMemory)
+{
+  const std::string sockname = GetTestSockname("LocalTransport");
+  LocalTransportServer server(LocalTransportType::SharedMemory);
+  LocalTransportClient client(LocalTransportType::SharedMemory);
+
+  EXPECT_FALSE(client.Connect(sockname + "_client", sockname));
+  ASSERT_TRUE(server.StartListening(sockname));
+  ASSERT_TRUE(client.Connect(sockname + "_client", sockname));
+
+  char buf[256];
+  EXPECT_EQ(0, server.Recv(buf, sizeof(buf)));
+  EXPECT_TRUE(server.HasClient());
+
+  const std::vector<char> msg = MakeMessage(100, 1);
+  ASSERT_EQ((ssize_t) msg.size(), client.Send(msg.data(), msg.size()));
+  EXPECT_GT(server.GetIncomingSize(), (ssize_t) msg.size());
+  ASSERT_EQ((ssize_t) msg.size(), server.Recv(buf, sizeof(buf)));
+  EXPECT_TRUE(std::equal(msg.begin(), msg.end(), buf));
+
+  ASSERT_EQ((ssize_t) msg.size(), server.Send(msg.data(), msg.size()));
+  ASSERT_EQ((ssize_t) msg.size(), client.Recv(buf, sizeof(buf)));
+  EXPECT_TRUE(std::equal(msg.begin(), msg.end(), buf));
+
+  client.Disconnect();
+  EXPECT_FALSE(server.HasClient());
+  server.StopListening();
+}
@@ -6,8 +6,9 @@
  *
  * Description: Interface class to create a standalone process to run forward inference using a neural network.
  *
- *              Currently uses the file system as a poor man's IPC to communicate with the "messenger"
- *              NeuralNetRunner::Model implementation in vic-engine's Vision System. See also VIC-2686.
+ *              Communicates with the OffboardModel used by NeuralNetRunner in vic-engine's Vision System through
+ *              a SharedMemoryChannel per model, once the engine has created it. Otherwise falls back on using the
+ *              file system as a poor man's IPC. See also VIC-2686.
  *
  * Copyright: Anki, Inc. 2018
  **/
@@ -31,6 +32,7 @@
 #include "coretech/neuralnets/neuralNetFilenames.h"
 #include "coretech/neuralnets/neuralNetJsonKeys.h"
 #include "coretech/neuralnets/neuralNetModel_offboard.h"
+#include "coretech/neuralnets/neuralNetSharedMemory.h"
 #include "coretech/vision/engine/image_impl.h"
 #include "json/json.h"
 #include "util/fileUtils/fileUtils.h"
@@ -233,11 +235,26 @@ Result INeuralNetMain::Run()
   bool anyFailures = false;
   while(!anyFailures && !ShouldShutdown())
   {
+    // Read the doorbell before looking for images, so that one published while we're busy below still wakes us up
+    const u32 doorbell = (_sharedMemoryChannels.empty() ? 0 : _sharedMemoryChannels.begin()->second->GetDoorbell());
+    bool allModelsUseSharedMemory = !imageFileProvided;
+    
     for(auto & model : _neuralNets)
     {
       const std::string& networkName = model.first;
       std::unique_ptr<NeuralNets::INeuralNetModel>& neuralNet = model.second;
       
+      if(!imageFileProvided)
+      {
+        SharedMemoryChannel* channel = GetSharedMemoryChannel(networkName);
+        if(nullptr != channel)
+        {
+          ProcessSharedMemoryImage(*channel, *neuralNet);
+          continue;
+        }
+        allModelsUseSharedMemory = false;
+      }
+      
       // Is there an image file available in the cache?
       const std::string fullImagePath = (imageFileProvided ?
                                          _imageFilename :
@@ -364,7 +381,16 @@ Result INeuralNetMain::Run()
       break;
     }
     
-    Step(_pollPeriod_ms);
+    if(allModelsUseSharedMemory && CanWaitForImages())
+    {
+      // Sleep until the engine publishes the next image for any model, still checking for shutdown every poll period
+      _sharedMemoryChannels.begin()->second->WaitForDoorbell(doorbell, _pollPeriod_ms);
+      Step(0);
+    }
+    else
+    {
+      Step(_pollPeriod_ms);
+    }
     
   } // WHILE should not shutdown
   
@@ -373,6 +399,72 @@ Result INeuralNetMain::Run()
   return result;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SharedMemoryChannel* INeuralNetMain::GetSharedMemoryChannel(const std::string& networkName)
+{
+  auto iter = _sharedMemoryChannels.find(networkName);
+  if(iter != _sharedMemoryChannels.end())
+  {
+    if(!iter->second->IsStale())
+    {
+      return iter->second.get();
+    }
+    
+    // The engine restarted or reconfigured the model: drop this one and try to find the new one below
+    LOG_INFO("INeuralNetMain.GetSharedMemoryChannel.Stale", "%s", networkName.c_str());
+    _sharedMemoryChannels.erase(iter);
+  }
+  
+  std::unique_ptr<SharedMemoryChannel> channel(new SharedMemoryChannel());
+  if(RESULT_OK != channel->Attach(_cachePath, networkName))
+  {
+    return nullptr;
+  }
+  
+  auto result = _sharedMemoryChannels.emplace(networkName, std::move(channel));
+  return result.first->second.get();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void INeuralNetMain::ProcessSharedMemoryImage(SharedMemoryChannel& channel, INeuralNetModel& neuralNet)
+{
+  // NOTE: img just wraps the data in shared memory, no copy
+  Vision::ImageRGB img;
+  u32 frameSeq = 0;
+  if(!channel.GetNextFrame(img, frameSeq))
+  {
+    return;
+  }
+  
+  if(neuralNet.IsVerbose())
+  {
+    LOG_INFO("INeuralNetMain.ProcessSharedMemoryImage.FoundImage", "%s: Frame:%u t:%u %dx%d",
+             neuralNet.GetName().c_str(), frameSeq, img.GetTimestamp(), img.GetNumCols(), img.GetNumRows());
+  }
+  
+  std::list<Vision::SalientPoint> salientPoints;
+  {
+    ScopedTicToc ticToc("Detect", LOG_CHANNEL);
+    const Result result = neuralNet.Detect(img, salientPoints);
+    if(RESULT_OK != result)
+    {
+      // Still send back the (empty) result so the engine doesn't sit waiting for it
+      LOG_ERROR("INeuralNetMain.ProcessSharedMemoryImage.DetectFailed", "");
+    }
+  }
+  
+  if(neuralNet.IsVerbose() && !salientPoints.empty())
+  {
+    LOG_INFO("INeuralNetMain.ProcessSharedMemoryImage.Detected", "%s: %zu objects",
+             neuralNet.GetName().c_str(), salientPoints.size());
+  }
+  
+  {
+    ScopedTicToc ticToc("WriteSharedResult", LOG_CHANNEL);
+    channel.PublishResult(frameSeq, salientPoints);
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void INeuralNetMain::GetImage(const std::string& imageFilename, const std::string& timestampFilename, Vision::ImageRGB& img)
 {
@@ -6,8 +6,9 @@
  *
  * Description: Interface class to create a standalone process to run forward inference using a neural network.
  *
- *              Currently uses the file system as a poor man's IPC to communicate with the "messenger"
- *              NeuralNetRunner::Model implementation in vic-engine's Vision System. See also VIC-2686.
+ *              Communicates with the OffboardModel used by NeuralNetRunner in vic-engine's Vision System through
+ *              a SharedMemoryChannel per model, once the engine has created it. Otherwise falls back on using the
+ *              file system as a poor man's IPC. See also VIC-2686.
  *
  * Copyright: Anki, Inc. 2018
  **/
@@ -20,6 +21,7 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <string>
 
 
@@ -41,13 +43,15 @@ namespace Vision {
 namespace NeuralNets {
   
 class INeuralNetModel;
+class SharedMemoryChannel;
  
 class INeuralNetMain
 {
 public:
   
   // One-time setup that must be called before calling Run()
-  // If imageFileToProcess is empty, the cachePath is polled for "neuralNetImage.png" to process.
+  // If imageFileToProcess is empty, images are taken from each model's shared memory channel, or (until that is
+  // available) the cachePath is polled for "neuralNetImage.png" to process.
   // Otherwise the given image is processed on Run(), and will complete immediately.
   Result Init(const std::string& configFilename,
               const std::string& modelPath,
@@ -88,8 +92,14 @@ protected:
   virtual int GetPollPeriod_ms(const Json::Value& config) const = 0;
   
   // Define what happens at the end of each loop of Run() (e.g. a wait, check for shutdown, etc)
+  // Once all models are getting images through shared memory, Run() itself blocks until the next image arrives
+  // (or the poll period passes) and then calls Step(0), unless CanWaitForImages() returns false.
   virtual void Step(int pollPeriod_ms) = 0;
   
+  // Override to return false if Step() must always be called with the full poll period (e.g. to advance a
+  // simulation clock) instead of blocking on shared memory
+  virtual bool CanWaitForImages() const { return true; }
+  
 private:
   
   void CleanupAndExit(Result result);
@@ -98,7 +108,15 @@ private:
                        const std::string& timestampFilename,
                        Vision::ImageRGB&  img);
   
+  // Returns the model's shared memory channel, attaching (or re-attaching) to it first if needed. Returns nullptr if
+  // the engine hasn't created it.
+  SharedMemoryChannel* GetSharedMemoryChannel(const std::string& networkName);
+  
+  // Runs the model on the newest image in the channel, if there is one, and sends back the result
+  void ProcessSharedMemoryImage(SharedMemoryChannel& channel, INeuralNetModel& neuralNet);
+  
   std::map<std::string, std::unique_ptr<INeuralNetModel>> _neuralNets;
+  std::map<std::string, std::unique_ptr<SharedMemoryChannel>> _sharedMemoryChannels;
   
   std::string _cachePath;
   std::string _imageFilename;
@@ -19,6 +19,7 @@ namespace JsonKeys {
   
   const char* const NeuralNets       = "NeuralNets";
   const char* const Models           = "Models";
+  const char* const NumWorkerThreads = "NumWorkerThreads";
   
   const char* const NetworkName      = "networkName";
   const char* const GraphFile        = "graphFile";
@@ -26,7 +27,10 @@ namespace JsonKeys {
   const char* const InputWidth       = "inputWidth";
   const char* const ModelType        = "modelType";
   const char* const PollingPeriod    = "pollPeriod_ms";
+  const char* const Priority         = "priority";
+  const char* const ProcessingPeriod = "processingPeriod_ms";
   const char* const TimeoutDuration  = "timeoutDuration_sec";
+  const char* const UseSharedMemory  = "useSharedMemory";
   const char* const VisualizationDir = "visualizationDirectory";
   
   const char* const OffboardModelType = "offboard";
@@ -20,6 +20,7 @@ namespace JsonKeys {
   
   extern const char* const NeuralNets;
   extern const char* const Models;
+  extern const char* const NumWorkerThreads;
   
   extern const char* const NetworkName;
   extern const char* const GraphFile;
@@ -27,7 +28,10 @@ namespace JsonKeys {
   extern const char* const InputWidth;
   extern const char* const ModelType;
   extern const char* const PollingPeriod;
+  extern const char* const Priority;
+  extern const char* const ProcessingPeriod;
   extern const char* const TimeoutDuration;
+  extern const char* const UseSharedMemory;
   extern const char* const VisualizationDir;
   
   // Model types:
@@ -16,6 +16,7 @@
 #include "coretech/neuralnets/neuralNetFilenames.h"
 #include "coretech/neuralnets/neuralNetJsonKeys.h"
 #include "coretech/neuralnets/neuralNetModel_offboard.h"
+#include "coretech/neuralnets/neuralNetSharedMemory.h"
 
 #include "util/fileUtils/fileUtils.h"
 
@@ -31,10 +32,15 @@ namespace NeuralNets {
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 OffboardModel::OffboardModel(const std::string& cachePath)
 : _cachePath(cachePath)
+, _profiler("OffboardModel")
 {
 
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Must be implemented here (in .cpp) due to use of unique_ptr with a forward declaration
+OffboardModel::~OffboardModel() = default;
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result OffboardModel::LoadModelInternal(const std::string& modelPath, const Json::Value& config)
 {
@@ -42,6 +48,7 @@ Result OffboardModel::LoadModelInternal(const std::string& modelPath, const Json
   //       with a standalone process which is loading and running the model. Here we'll just set any inititalization
   //       parameters for communicating with that process.
   
+  const std::string rootCachePath = _cachePath;
   _cachePath = Util::FileUtils::FullFilePath({_cachePath, GetName()});
 
   if (false == JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::PollingPeriod, _pollPeriod_ms))
@@ -65,6 +72,31 @@ Result OffboardModel::LoadModelInternal(const std::string& modelPath, const Json
              _timeoutDuration_sec);
   }
 
+  _profiler.SetPrintFrequency(config.get("ProfilingPrintFrequency_ms", 10000).asUInt());
+  _profiler.SetDasLogFrequency(config.get("ProfilingEventLogFrequency_ms", 10000).asUInt());
+
+  // Unless told otherwise, hand raw images to the neural net process through shared memory, which avoids
+  // encoding/writing/reading/decoding a PNG and a JSON file for every frame. Fall back on file I/O if that fails.
+  _sharedMemory.reset();
+  bool useSharedMemory = true;
+  JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::UseSharedMemory, useSharedMemory);
+  if(useSharedMemory)
+  {
+    s32 inputHeight = 0, inputWidth = 0;
+    const bool haveSize = (JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::InputHeight, inputHeight) &&
+                           JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::InputWidth, inputWidth));
+    
+    std::unique_ptr<SharedMemoryChannel> sharedMemory(new SharedMemoryChannel());
+    if(haveSize && (RESULT_OK == sharedMemory->Create(rootCachePath, GetName(), inputHeight, inputWidth)))
+    {
+      _sharedMemory = std::move(sharedMemory);
+    }
+    else
+    {
+      LOG_WARNING("OffboardModel.LoadModelInternal.SharedMemoryFailed", "Using file I/O for %s", GetName().c_str());
+    }
+  }
+
   return RESULT_OK;
 }
 
@@ -73,6 +105,53 @@ Result OffboardModel::Detect(Vision::ImageRGB& img, std::list<Vision::SalientPoi
 {
   salientPoints.clear();
 
+  // Time between consecutive frames (i.e. 1/throughput)
+  _profiler.Toc("FramePeriod");
+  _profiler.Tic("FramePeriod");
+
+  if(_sharedMemory)
+  {
+    return DetectWithSharedMemory(img, salientPoints);
+  }
+  else
+  {
+    return DetectWithFiles(img, salientPoints);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result OffboardModel::DetectWithSharedMemory(Vision::ImageRGB& img, std::list<Vision::SalientPoint>& salientPoints)
+{
+  u32 frameSeq = 0;
+  {
+    auto ticToc = _profiler.TicToc("SharedMemory.PublishFrame");
+    frameSeq = _sharedMemory->PublishFrame(img);
+  }
+  
+  if(0 == frameSeq)
+  {
+    LOG_ERROR("OffboardModel.DetectWithSharedMemory.PublishFrameFailed", "t:%u", img.GetTimestamp());
+    return RESULT_FAIL;
+  }
+  
+  // Latency: from handing off the frame until the result is back
+  _profiler.Tic("SharedMemory.Latency");
+  const int timeout_ms = (int)(_timeoutDuration_sec * 1000.f);
+  const bool resultAvailable = _sharedMemory->WaitForResult(frameSeq, timeout_ms, salientPoints);
+  _profiler.Toc("SharedMemory.Latency");
+  
+  if(!resultAvailable)
+  {
+    LOG_WARNING("OffboardModel.DetectWithSharedMemory.TimedOut", "Frame:%u t:%u Timeout:%.1fsec",
+                frameSeq, img.GetTimestamp(), _timeoutDuration_sec);
+  }
+  
+  return RESULT_OK;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result OffboardModel::DetectWithFiles(Vision::ImageRGB& img, std::list<Vision::SalientPoint>& salientPoints)
+{
   const std::string imageFilename = Util::FileUtils::FullFilePath({_cachePath, NeuralNets::Filenames::Image});
   {
     // Write image to a temporary file
@@ -7,6 +7,8 @@
  * Description: Implementation of INeuralNetModel interface class does not actually run forward inference through
  *              a neural network model but instead communicates with an "offboard" process via file I/O.
  *              This eventually could be a local laptop, the cloud, or simply another process on the same device.
+ *              For another process on the same device, images and results are exchanged through shared memory
+ *              instead (see SharedMemoryChannel) unless "useSharedMemory" is false in the config.
  *
  * Copyright: Anki, Inc. 2018
  **/
@@ -15,17 +17,22 @@
 #define __Anki_NeuralNets_OffboardModel_H__
 
 #include "coretech/neuralnets/neuralNetModel_interface.h"
+#include "coretech/vision/engine/profiler.h"
+
+#include <memory>
 
 namespace Anki {
 namespace NeuralNets {
 
+class SharedMemoryChannel;
+
 class OffboardModel : public INeuralNetModel
 {
 public:
   
   explicit OffboardModel(const std::string& cachePath);
   
-  virtual ~OffboardModel() = default;
+  virtual ~OffboardModel();
   
   virtual Result Detect(Vision::ImageRGB& img, std::list<Vision::SalientPoint>& salientPoints) override;
   
@@ -37,11 +44,19 @@ protected:
   
 private:
   
+  Result DetectWithFiles(Vision::ImageRGB& img, std::list<Vision::SalientPoint>& salientPoints);
+  Result DetectWithSharedMemory(Vision::ImageRGB& img, std::list<Vision::SalientPoint>& salientPoints);
+  
   std::string _cachePath;
   int         _pollPeriod_ms;
   bool        _isVerbose = false;
   float       _timeoutDuration_sec = 10.f;
   
+  // Null if using file I/O
+  std::unique_ptr<SharedMemoryChannel> _sharedMemory;
+  
+  Vision::Profiler _profiler;
+  
 }; // class Model
 
 } // namespace NeuralNets
@@ -0,0 +1,642 @@
+/**
+ * File: neuralNetSharedMemory.cpp
+ *
+ * Description: See header file.
+ *
+ * Copyright: Anki, Inc. 2026
+ **/
+
+#include "coretech/neuralnets/neuralNetSharedMemory.h"
+#include "coretech/vision/engine/image.h"
+
+#include "clad/types/salientPointTypes.h"
+#include "util/logging/logging.h"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#  include <linux/futex.h>
+#  include <sys/syscall.h>
+#endif
+
+#define LOG_CHANNEL "NeuralNets"
+
+namespace Anki {
+namespace NeuralNets {
+
+namespace {
+
+  const u32 kMagic   = 0x4e4e534d; // "NNSM"
+  const u32 kVersion = 1;
+
+  // The engine only has one frame in flight per model, so a few slots are plenty. More than one lets the engine
+  // publish a new frame (e.g. after a timeout) without touching the one the neural net process may still be reading.
+  const u32 kNumFrameSlots = 3;
+
+  // Room for the packed SalientPoints of one frame
+  const u32 kResultCapacity = 64 * 1024;
+
+  // Everything in the segment is aligned to cache lines so the two processes don't false-share counters
+  const size_t kAlignment = 64;
+
+  // Without futexes we fall back on waking up this often to re-check the counters
+  const int kFallbackPollPeriod_ms = 1;
+
+  inline size_t Align(size_t size)
+  {
+    return (size + kAlignment - 1) & ~(kAlignment - 1);
+  }
+
+  static_assert(sizeof(std::atomic<u32>) == sizeof(u32) && ATOMIC_INT_LOCK_FREE == 2,
+                "Counters in shared memory must be plain lock-free 32-bit words so they can be futexes");
+
+  // Blocks while *word == expectedValue, for at most timeout_ms (may also wake up spuriously)
+  void FutexWait(const std::atomic<u32>* word, u32 expectedValue, int timeout_ms)
+  {
+    if(timeout_ms <= 0)
+    {
+      return;
+    }
+
+#   if defined(__linux__)
+    struct timespec timeout;
+    timeout.tv_sec  = timeout_ms / 1000;
+    timeout.tv_nsec = (timeout_ms % 1000) * 1000000;
+    // NOTE: not FUTEX_PRIVATE_FLAG, since the word is shared between processes
+    syscall(SYS_futex, reinterpret_cast<const u32*>(word), FUTEX_WAIT, expectedValue, &timeout, nullptr, 0);
+#   else
+    if(word->load(std::memory_order_acquire) == expectedValue)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(std::min(timeout_ms, kFallbackPollPeriod_ms)));
+    }
+#   endif
+  }
+
+  void FutexWakeAll(std::atomic<u32>* word)
+  {
+#   if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<u32*>(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#   endif
+  }
+
+  // FNV-1a, so that both processes agree on names regardless of how their standard libraries hash strings
+  u64 HashString(const std::string& str)
+  {
+    u64 hash = 14695981039346656037ull;
+    for(const char c : str)
+    {
+      hash ^= (u8)c;
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  }
+
+  std::string GetSharedMemoryName(const std::string& key)
+  {
+    // Keep it short: macOS limits shared memory names to 31 characters
+    char name[32];
+    snprintf(name, sizeof(name), "/ankinn_%016llx", (unsigned long long)HashString(key));
+    return name;
+  }
+
+  std::string NormalizePath(const std::string& path)
+  {
+    std::string normalized(path);
+    while(normalized.size() > 1 && normalized.back() == '/')
+    {
+      normalized.pop_back();
+    }
+    return normalized;
+  }
+
+} // anonymous namespace
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Layout of a channel: ChannelHeader, then kNumFrameSlots frame slots (FrameSlot followed by the pixel data), then the
+// result area
+struct SharedMemoryChannel::ChannelHeader
+{
+  u32 magic;
+  u32 version;
+  u32 totalSize;
+  u32 maxRows;
+  u32 maxCols;
+  u32 frameSlotSize;
+
+  // Sequence number of the most recently published frame (0 if none yet). Written by the engine, futex for the
+  // neural net process
+  alignas(kAlignment) std::atomic<u32> frameSeq;
+
+  // Sequence number of the frame whose result is in the result area. Written by the neural net process, futex for
+  // the engine
+  alignas(kAlignment) std::atomic<u32> resultSeq;
+  u32 resultNumBytes;
+};
+
+struct SharedMemoryChannel::FrameSlot
+{
+  // Sequence number of the frame in this slot, or 0 while it is being written
+  std::atomic<u32> seq;
+  TimeStamp_t      timestamp;
+  s32              numRows;
+  s32              numCols;
+
+  static constexpr size_t kDataOffset = kAlignment;
+
+  u8* GetData() { return reinterpret_cast<u8*>(this) + kDataOffset; }
+};
+
+struct SharedMemoryChannel::Doorbell
+{
+  std::atomic<u32> count;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SharedMemoryChannel::SharedMemoryChannel() = default;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SharedMemoryChannel::~SharedMemoryChannel()
+{
+  Unmap();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::string SharedMemoryChannel::GetChannelName(const std::string& cachePath, const std::string& modelName)
+{
+  return GetSharedMemoryName(NormalizePath(cachePath) + "/" + modelName);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result SharedMemoryChannel::Create(const std::string& cachePath, const std::string& modelName, s32 maxRows, s32 maxCols)
+{
+  static_assert(sizeof(FrameSlot) <= FrameSlot::kDataOffset, "FrameSlot header overlaps the pixel data");
+
+  Unmap();
+
+  if(maxRows <= 0 || maxCols <= 0)
+  {
+    LOG_ERROR("SharedMemoryChannel.Create.InvalidSize", "%dx%d", maxCols, maxRows);
+    return RESULT_FAIL;
+  }
+
+  const size_t frameSlotSize = Align(FrameSlot::kDataOffset + (size_t)maxRows * (size_t)maxCols * 3);
+  const size_t totalSize = Align(sizeof(ChannelHeader)) + kNumFrameSlots * frameSlotSize + kResultCapacity;
+
+  Result result = Map(GetChannelName(cachePath, modelName), true, totalSize);
+  if(RESULT_OK == result)
+  {
+    result = MapDoorbell(cachePath);
+  }
+  if(RESULT_OK != result)
+  {
+    Unmap();
+    return result;
+  }
+
+  // Keep counting from where a previous run left off, if there was one, so a neural net process which is still
+  // attached sees our frames as new
+  const bool isReused = (_header->magic == kMagic && _header->version == kVersion);
+  if(!isReused)
+  {
+    _header->frameSeq.store(0, std::memory_order_relaxed);
+    _header->resultSeq.store(0, std::memory_order_relaxed);
+  }
+
+  _header->totalSize      = (u32)totalSize;
+  _header->maxRows        = (u32)maxRows;
+  _header->maxCols        = (u32)maxCols;
+  _header->frameSlotSize  = (u32)frameSlotSize;
+  _header->resultNumBytes = 0;
+  for(u32 iSlot = 0; iSlot < kNumFrameSlots; ++iSlot)
+  {
+    GetFrameSlot(iSlot)->seq.store(0, std::memory_order_relaxed);
+  }
+  _header->version = kVersion;
+  std::atomic_thread_fence(std::memory_order_release);
+  _header->magic = kMagic;
+
+  _isOwner = true;
+
+  LOG_INFO("SharedMemoryChannel.Create.Success", "Model:%s Name:%s MaxSize:%dx%d TotalSize:%zu Reused:%d",
+           modelName.c_str(), _name.c_str(), maxCols, maxRows, totalSize, isReused);
+
+  return RESULT_OK;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result SharedMemoryChannel::Attach(const std::string& cachePath, const std::string& modelName)
+{
+  Unmap();
+
+  // Size comes from the segment itself
+  Result result = Map(GetChannelName(cachePath, modelName), false, 0);
+  if(RESULT_OK != result)
+  {
+    Unmap();
+    return result;
+  }
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if(_header->magic != kMagic || _header->version != kVersion || _header->totalSize != _mappedSize)
+  {
+    // Not (fully) initialized by the engine yet
+    Unmap();
+    return RESULT_FAIL;
+  }
+
+  result = MapDoorbell(cachePath);
+  if(RESULT_OK != result)
+  {
+    Unmap();
+    return result;
+  }
+
+  // Only pick up frames published from now on
+  _lastFrameSeq = _header->frameSeq.load(std::memory_order_acquire);
+
+  LOG_INFO("SharedMemoryChannel.Attach.Success", "Model:%s Name:%s MaxSize:%ux%u",
+           modelName.c_str(), _name.c_str(), _header->maxCols, _header->maxRows);
+
+  return RESULT_OK;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result SharedMemoryChannel::Map(const std::string& name, bool create, size_t size)
+{
+  const int flags = (create ? (O_RDWR | O_CREAT) : O_RDWR);
+  _fd = shm_open(name.c_str(), flags, 0666);
+  if(_fd < 0)
+  {
+    if(create)
+    {
+      LOG_ERROR("SharedMemoryChannel.Map.OpenFailed", "%s: %s", name.c_str(), strerror(errno));
+    }
+    return RESULT_FAIL;
+  }
+
+  struct stat info;
+  if(fstat(_fd, &info) != 0)
+  {
+    LOG_ERROR("SharedMemoryChannel.Map.StatFailed", "%s: %s", name.c_str(), strerror(errno));
+    return RESULT_FAIL;
+  }
+
+  if(create)
+  {
+    if((size_t)info.st_size != size && ftruncate(_fd, (off_t)size) != 0)
+    {
+      LOG_ERROR("SharedMemoryChannel.Map.ResizeFailed", "%s to %zu: %s", name.c_str(), size, strerror(errno));
+      return RESULT_FAIL;
+    }
+  }
+  else
+  {
+    size = (size_t)info.st_size;
+    if(size < sizeof(ChannelHeader))
+    {
+      return RESULT_FAIL;
+    }
+  }
+
+  void* mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+  if(MAP_FAILED == mem)
+  {
+    LOG_ERROR("SharedMemoryChannel.Map.MmapFailed", "%s: %s", name.c_str(), strerror(errno));
+    return RESULT_FAIL;
+  }
+
+  _name = name;
+  _mappedSize = size;
+  _header = reinterpret_cast<ChannelHeader*>(mem);
+
+  return RESULT_OK;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result SharedMemoryChannel::MapDoorbell(const std::string& cachePath)
+{
+  // Either side may get here first, so both create it. It is tiny and never removed.
+  const std::string name = GetSharedMemoryName(NormalizePath(cachePath));
+  const int fd = shm_open(name.c_str(), O_RDWR | O_CREAT, 0666);
+  if(fd < 0)
+  {
+    LOG_ERROR("SharedMemoryChannel.MapDoorbell.OpenFailed", "%s: %s", name.c_str(), strerror(errno));
+    return RESULT_FAIL;
+  }
+
+  struct stat info;
+  const bool success = ((fstat(fd, &info) == 0) &&
+                        ((size_t)info.st_size >= kAlignment || ftruncate(fd, kAlignment) == 0));
+  void* mem = (success ? mmap(nullptr, kAlignment, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED);
+  close(fd);
+
+  if(MAP_FAILED == mem)
+  {
+    LOG_ERROR("SharedMemoryChannel.MapDoorbell.MapFailed", "%s: %s", name.c_str(), strerror(errno));
+    return RESULT_FAIL;
+  }
+
+  _doorbell = reinterpret_cast<Doorbell*>(mem);
+  return RESULT_OK;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SharedMemoryChannel::Unmap()
+{
+  if(nullptr != _doorbell)
+  {
+    munmap(_doorbell, kAlignment);
+    _doorbell = nullptr;
+  }
+
+  if(nullptr != _header)
+  {
+    munmap(_header, _mappedSize);
+    _header = nullptr;
+  }
+
+  if(_fd >= 0)
+  {
+    close(_fd);
+    _fd = -1;
+  }
+
+  if(_isOwner)
+  {
+    // Attached processes keep their mapping, and notice it went stale via IsStale()
+    shm_unlink(_name.c_str());
+    _isOwner = false;
+  }
+
+  _mappedSize = 0;
+  _lastFrameSeq = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SharedMemoryChannel::IsStale() const
+{
+  if(!IsValid())
+  {
+    return true;
+  }
+
+  struct stat info;
+  if(fstat(_fd, &info) != 0 || info.st_nlink == 0)
+  {
+    return true;
+  }
+
+  return (_header->totalSize != _mappedSize);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SharedMemoryChannel::FrameSlot* SharedMemoryChannel::GetFrameSlot(u32 frameSeq) const
+{
+  u8* slots = reinterpret_cast<u8*>(_header) + Align(sizeof(ChannelHeader));
+  return reinterpret_cast<FrameSlot*>(slots + (size_t)(frameSeq % kNumFrameSlots) * _header->frameSlotSize);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+u8* SharedMemoryChannel::GetResultData() const
+{
+  return reinterpret_cast<u8*>(_header) + _mappedSize - kResultCapacity;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+u32 SharedMemoryChannel::PublishFrame(const Vision::ImageRGB& img)
+{
+  if(!IsValid())
+  {
+    return 0;
+  }
+
+  const s32 numRows = img.GetNumRows();
+  const s32 numCols = img.GetNumCols();
+  if(numRows > (s32)_header->maxRows || numCols > (s32)_header->maxCols)
+  {
+    LOG_ERROR("SharedMemoryChannel.PublishFrame.ImageTooLarge", "%dx%d > %ux%u",
+              numCols, numRows, _header->maxCols, _header->maxRows);
+    return 0;
+  }
+
+  // We are the only writer of frameSeq. Skip 0 when wrapping, since it means "no frame".
+  u32 frameSeq = _header->frameSeq.load(std::memory_order_relaxed) + 1;
+  if(0 == frameSeq)
+  {
+    frameSeq = 1;
+  }
+
+  FrameSlot* slot = GetFrameSlot(frameSeq);
+  slot->seq.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot->timestamp = img.GetTimestamp();
+  slot->numRows   = numRows;
+  slot->numCols   = numCols;
+
+  const size_t rowBytes = (size_t)numCols * 3;
+  u8* data = slot->GetData();
+  if(img.IsContinuous())
+  {
+    std::memcpy(data, img.GetDataPointer(), rowBytes * (size_t)numRows);
+  }
+  else
+  {
+    for(s32 i = 0; i < numRows; ++i)
+    {
+      std::memcpy(data + (size_t)i * rowBytes, img.GetRow(i), rowBytes);
+    }
+  }
+
+  slot->seq.store(frameSeq, std::memory_order_release);
+  _header->frameSeq.store(frameSeq, std::memory_order_release);
+  FutexWakeAll(&_header->frameSeq);
+
+  _doorbell->count.fetch_add(1, std::memory_order_release);
+  FutexWakeAll(&_doorbell->count);
+
+  return frameSeq;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SharedMemoryChannel::WaitForResult(u32 frameSeq, int timeout_ms, std::list<Vision::SalientPoint>& salientPoints)
+{
+  if(!IsValid() || 0 == frameSeq)
+  {
+    return false;
+  }
+
+  using Clock = std::chrono::steady_clock;
+  const auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+
+  while(true)
+  {
+    const u32 resultSeq = _header->resultSeq.load(std::memory_order_acquire);
+    if(resultSeq == frameSeq)
+    {
+      break;
+    }
+
+    const int remaining_ms = (int)std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+    if(remaining_ms <= 0)
+    {
+      return false;
+    }
+
+    FutexWait(&_header->resultSeq, resultSeq, remaining_ms);
+  }
+
+  // Result area: u32 count, followed by that many [u32 numBytes, packed SalientPoint]
+  const u8* data = GetResultData();
+  const u32 numBytes = std::min(_header->resultNumBytes, kResultCapacity);
+  size_t offset = 0;
+
+  u32 numSalientPoints = 0;
+  if(numBytes >= sizeof(u32))
+  {
+    std::memcpy(&numSalientPoints, data, sizeof(u32));
+    offset += sizeof(u32);
+  }
+
+  for(u32 i = 0; i < numSalientPoints; ++i)
+  {
+    u32 packedSize = 0;
+    if(offset + sizeof(u32) > numBytes)
+    {
+      break;
+    }
+    std::memcpy(&packedSize, data + offset, sizeof(u32));
+    offset += sizeof(u32);
+
+    if(offset + packedSize > numBytes)
+    {
+      LOG_ERROR("SharedMemoryChannel.WaitForResult.TruncatedResult", "SalientPoint %u of %u", i, numSalientPoints);
+      break;
+    }
+
+    Vision::SalientPoint salientPoint;
+    salientPoint.Unpack(data + offset, packedSize);
+    salientPoints.emplace_back(std::move(salientPoint));
+    offset += packedSize;
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SharedMemoryChannel::GetNextFrame(Vision::ImageRGB& img, u32& frameSeq)
+{
+  if(!IsValid())
+  {
+    return false;
+  }
+
+  const u32 latestSeq = _header->frameSeq.load(std::memory_order_acquire);
+  if(0 == latestSeq || latestSeq == _lastFrameSeq)
+  {
+    return false;
+  }
+
+  FrameSlot* slot = GetFrameSlot(latestSeq);
+  if(slot->seq.load(std::memory_order_acquire) != latestSeq)
+  {
+    // Already being overwritten by a newer frame, which we'll get next time
+    return false;
+  }
+
+  _lastFrameSeq = latestSeq;
+  frameSeq = latestSeq;
+
+  img = Vision::ImageRGB(slot->numRows, slot->numCols, slot->GetData());
+  img.SetTimestamp(slot->timestamp);
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result SharedMemoryChannel::PublishResult(u32 frameSeq, const std::list<Vision::SalientPoint>& salientPoints)
+{
+  if(!IsValid())
+  {
+    return RESULT_FAIL;
+  }
+
+  if(GetFrameSlot(frameSeq)->seq.load(std::memory_order_acquire) != frameSeq)
+  {
+    // The engine gave up on this frame and has reused its slot, so whatever we computed is for a mangled image
+    LOG_WARNING("SharedMemoryChannel.PublishResult.FrameOverwritten", "Frame:%u", frameSeq);
+    return RESULT_FAIL;
+  }
+
+  u8* data = GetResultData();
+  size_t offset = sizeof(u32);
+  u32 numSalientPoints = 0;
+  for(const auto& salientPoint : salientPoints)
+  {
+    const u32 packedSize = (u32)salientPoint.Size();
+    if(offset + sizeof(u32) + packedSize > kResultCapacity)
+    {
+      LOG_WARNING("SharedMemoryChannel.PublishResult.ResultTooLarge", "Dropping %zu of %zu SalientPoints",
+                  salientPoints.size() - numSalientPoints, salientPoints.size());
+      break;
+    }
+
+    std::memcpy(data + offset, &packedSize, sizeof(u32));
+    offset += sizeof(u32);
+    salientPoint.Pack(data + offset, packedSize);
+    offset += packedSize;
+    ++numSalientPoints;
+  }
+  std::memcpy(data, &numSalientPoints, sizeof(u32));
+
+  _header->resultNumBytes = (u32)offset;
+  _header->resultSeq.store(frameSeq, std::memory_order_release);
+  FutexWakeAll(&_header->resultSeq);
+
+  return RESULT_OK;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+u32 SharedMemoryChannel::GetDoorbell() const
+{
+  if(nullptr == _doorbell)
+  {
+    return 0;
+  }
+  return _doorbell->count.load(std::memory_order_acquire);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SharedMemoryChannel::WaitForDoorbell(u32 lastDoorbell, int timeout_ms) const
+{
+  if(nullptr == _doorbell)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms));
+    return;
+  }
+
+  using Clock = std::chrono::steady_clock;
+  const auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+  while(_doorbell->count.load(std::memory_order_acquire) == lastDoorbell)
+  {
+    const int remaining_ms = (int)std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+    if(remaining_ms <= 0)
+    {
+      break;
+    }
+    FutexWait(&_doorbell->count, lastDoorbell, remaining_ms);
+  }
+}
+
+} // namespace NeuralNets
+} // namespace Anki
@@ -0,0 +1,119 @@
+/**
+ * File: neuralNetSharedMemory.h
+ *
+ * Description: Shared memory channel for handing raw images from the engine's OffboardModel to the standalone
+ *              neural net process (INeuralNetMain) and getting the resulting SalientPoints back, without going
+ *              through the file system.
+ *
+ *              Each model gets its own channel: a small ring of raw RGB frame slots plus a binary result area.
+ *              Each direction is signalled by a sequence counter in the shared memory, which the other side waits
+ *              on with a futex (on Linux; other platforms fall back to a short sleep loop). All channels under one
+ *              cache path also share a "doorbell" counter, rung whenever any of them publishes a frame, so the
+ *              neural net process can block waiting for work on all of its models at once.
+ *
+ * Copyright: Anki, Inc. 2026
+ **/
+
+#ifndef __Anki_NeuralNets_SharedMemory_H__
+#define __Anki_NeuralNets_SharedMemory_H__
+
+#include "coretech/common/shared/types.h"
+
+#include <list>
+#include <string>
+
+namespace Anki {
+
+namespace Vision {
+  class ImageRGB;
+  struct SalientPoint;
+}
+
+namespace NeuralNets {
+
+class SharedMemoryChannel
+{
+public:
+
+  SharedMemoryChannel();
+  ~SharedMemoryChannel();
+
+  SharedMemoryChannel(const SharedMemoryChannel&) = delete;
+  SharedMemoryChannel& operator=(const SharedMemoryChannel&) = delete;
+
+  // Engine side: creates the channel for the given model, with room for images up to maxRows x maxCols. If a channel
+  // with the same name already exists (e.g. left behind by a previous run), it is reused so that a neural net process
+  // which is still attached to it keeps working. The channel is removed when this object is destroyed.
+  Result Create(const std::string& cachePath, const std::string& modelName, s32 maxRows, s32 maxCols);
+
+  // Neural net process side: maps an existing channel. Fails if the engine has not created it yet, so this is
+  // expected to be retried periodically.
+  Result Attach(const std::string& cachePath, const std::string& modelName);
+
+  bool IsValid() const { return (_header != nullptr); }
+
+  // Neural net process side: returns true if the engine has removed (or resized) the channel since it was attached,
+  // in which case it should be re-attached
+  bool IsStale() const;
+
+  //
+  // Engine side
+  //
+
+  // Copies img into the next free frame slot and wakes up the neural net process. Returns the sequence number to
+  // pass to WaitForResult(), or 0 on failure (e.g. the image is larger than the channel was created for).
+  u32 PublishFrame(const Vision::ImageRGB& img);
+
+  // Waits up to timeout_ms for the result of the given frame. Returns false if it did not arrive in time.
+  bool WaitForResult(u32 frameSeq, int timeout_ms, std::list<Vision::SalientPoint>& salientPoints);
+
+  //
+  // Neural net process side
+  //
+
+  // If the engine has published a frame newer than the last one returned, wraps img around the frame's data in
+  // shared memory (no copy) and returns true. The data is only guaranteed to stay put until PublishResult().
+  bool GetNextFrame(Vision::ImageRGB& img, u32& frameSeq);
+
+  // Packs the SalientPoints for the given frame into the result area and wakes up the engine
+  Result PublishResult(u32 frameSeq, const std::list<Vision::SalientPoint>& salientPoints);
+
+  // Returns the current value of the doorbell shared by all channels under this channel's cache path. Read it
+  // *before* checking channels for frames, then pass it to WaitForDoorbell() to sleep until the next frame.
+  u32 GetDoorbell() const;
+
+  // Blocks until the doorbell no longer equals lastDoorbell, or timeout_ms passes
+  void WaitForDoorbell(u32 lastDoorbell, int timeout_ms) const;
+
+  // Name of the shared memory object used for the given model's channel (short enough for all platforms)
+  static std::string GetChannelName(const std::string& cachePath, const std::string& modelName);
+
+private:
+
+  struct ChannelHeader;
+  struct FrameSlot;
+  struct Doorbell;
+
+  Result Map(const std::string& name, bool create, size_t size);
+  Result MapDoorbell(const std::string& cachePath);
+  void   Unmap();
+
+  FrameSlot* GetFrameSlot(u32 frameSeq) const;
+  u8*        GetResultData() const;
+
+  std::string     _name;
+  bool            _isOwner = false;
+  int             _fd = -1;
+  size_t          _mappedSize = 0;
+  ChannelHeader*  _header = nullptr;
+  Doorbell*       _doorbell = nullptr;
+
+  // Neural net process side: sequence number of the last frame returned by GetNextFrame
+  u32             _lastFrameSeq = 0;
+
+}; // class SharedMemoryChannel
+
+} // namespace NeuralNets
+} // namespace Anki
+
+#endif /* __Anki_NeuralNets_SharedMemory_H__ */
@@ -15,6 +15,7 @@
 #include "coretech/neuralnets/iNeuralNetMain.h"
 #include "coretech/neuralnets/neuralNetFilenames.h"
 #include "coretech/neuralnets/neuralNetJsonKeys.h"
+#include "coretech/neuralnets/neuralNetSharedMemory.h"
 #include "coretech/vision/engine/image_impl.h"
 
 #include "util/fileUtils/fileUtils.h"
@@ -26,6 +27,7 @@
 #include "json/json.h"
 
 #include <fstream>
+#include <thread>
 
 namespace TestPaths
 {
@@ -503,6 +505,93 @@ GTEST_TEST(NeuralNets, ClassificationConsensus)
 }
 
 
+// Round trip an image and result through a SharedMemoryChannel, with a thread standing in for the neural net process
+GTEST_TEST(NeuralNets, SharedMemoryChannel)
+{
+  using namespace Anki;
+  
+  const std::string modelName = "sharedMemoryTest";
+  const s32 numRows = 32;
+  const s32 numCols = 48;
+  
+  std::unique_ptr<NeuralNets::SharedMemoryChannel> engineSide(new NeuralNets::SharedMemoryChannel());
+  ASSERT_EQ(RESULT_OK, engineSide->Create(TestPaths::CachePath, modelName, numRows, numCols));
+  
+  NeuralNets::SharedMemoryChannel processSide;
+  ASSERT_EQ(RESULT_OK, processSide.Attach(TestPaths::CachePath, modelName));
+  ASSERT_FALSE(processSide.IsStale());
+  
+  Vision::ImageRGB img(numRows, numCols);
+  for(s32 i=0; i<numRows; ++i)
+  {
+    Vision::PixelRGB* img_i = img.GetRow(i);
+    for(s32 j=0; j<numCols; ++j)
+    {
+      img_i[j] = Vision::PixelRGB(i, j, i+j);
+    }
+  }
+  img.SetTimestamp(1234);
+  
+  // Larger than the channel was created for
+  Vision::ImageRGB largeImg(numRows+1, numCols);
+  EXPECT_EQ(0, engineSide->PublishFrame(largeImg));
+  
+  Vision::SalientPoint salientPoint;
+  salientPoint.timestamp = img.GetTimestamp();
+  salientPoint.x_img = 0.25f;
+  salientPoint.y_img = 0.75f;
+  salientPoint.score = 0.9f;
+  salientPoint.salientType = Vision::SalientPointType::Person;
+  salientPoint.description = "person";
+  salientPoint.shape.emplace_back(0.f, 0.f);
+  salientPoint.shape.emplace_back(1.f, 0.5f);
+  
+  const u32 doorbell = processSide.GetDoorbell();
+  std::thread processThread([&]()
+  {
+    processSide.WaitForDoorbell(doorbell, 5000);
+    
+    Vision::ImageRGB receivedImg;
+    u32 receivedFrameSeq = 0;
+    ASSERT_TRUE(processSide.GetNextFrame(receivedImg, receivedFrameSeq));
+    EXPECT_EQ(img.GetTimestamp(), receivedImg.GetTimestamp());
+    ASSERT_EQ(numRows, receivedImg.GetNumRows());
+    ASSERT_EQ(numCols, receivedImg.GetNumCols());
+    EXPECT_EQ(0, memcmp(img.GetDataPointer(), receivedImg.GetDataPointer(), numRows*numCols*3));
+    
+    // Nothing new until the engine publishes again
+    EXPECT_FALSE(processSide.GetNextFrame(receivedImg, receivedFrameSeq));
+    
+    EXPECT_EQ(RESULT_OK, processSide.PublishResult(receivedFrameSeq, {salientPoint}));
+  });
+  
+  const u32 frameSeq = engineSide->PublishFrame(img);
+  EXPECT_NE(0, frameSeq);
+  
+  std::list<Vision::SalientPoint> salientPoints;
+  const bool gotResult = engineSide->WaitForResult(frameSeq, 5000, salientPoints);
+  processThread.join();
+  
+  ASSERT_TRUE(gotResult);
+  ASSERT_EQ(1, salientPoints.size());
+  EXPECT_EQ(salientPoint, salientPoints.front());
+  
+  // No one answers this one
+  const u32 secondFrameSeq = engineSide->PublishFrame(img);
+  EXPECT_NE(frameSeq, secondFrameSeq);
+  salientPoints.clear();
+  EXPECT_FALSE(engineSide->WaitForResult(secondFrameSeq, 10, salientPoints));
+  EXPECT_TRUE(salientPoints.empty());
+  
+  // Engine going away should be noticed by the process side
+  engineSide.reset();
+  EXPECT_TRUE(processSide.IsStale());
+  
+  NeuralNets::SharedMemoryChannel reattached;
+  EXPECT_NE(RESULT_OK, reattached.Attach(TestPaths::CachePath, modelName));
+}
+
+
 int main(int argc, char ** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,172 @@
+/**
+ * File: collisionBitmap.cpp
+ *
+ * Description: per-angle rasterized obstacle occupancy, used to quickly rule out collision checks
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "collisionBitmap.h"
+#include "util/logging/logging.h"
+#include <algorithm>
+#include <cfloat>
+
+namespace Anki
+{
+namespace Planning
+{
+
+namespace {
+
+// cells are grown by this much when rasterizing, so that points which land on a cell border (or are off by a
+// bit of floating point error from the exact lattice position) still find the obstacle in either cell
+const float kCellMargin_mm = 0.5f;
+
+// if the obstacles cover more than this many cells (per angle), don't use the bitmap. This is 256KB per angle
+const size_t kMaxCellsPerAngle = 1 << 21;
+
+}
+
+CollisionBitmap::CollisionBitmap()
+  : valid_(false)
+  , minCellX_(0)
+  , minCellY_(0)
+  , numCols_(0)
+  , numRows_(0)
+{
+}
+
+void CollisionBitmap::Clear()
+{
+  valid_ = false;
+  numCols_ = 0;
+  numRows_ = 0;
+  bits_.clear();
+}
+
+bool CollisionBitmap::Build(const ObstaclesPerAngle& obstaclesPerAngle)
+{
+  Clear();
+
+  float minX = FLT_MAX;
+  float maxX = -FLT_MAX;
+  float minY = FLT_MAX;
+  float maxY = -FLT_MAX;
+
+  for( const auto& obstacles : obstaclesPerAngle ) {
+    for( const auto& obs : obstacles ) {
+      minX = std::min(minX, obs.first.GetMinX());
+      maxX = std::max(maxX, obs.first.GetMaxX());
+      minY = std::min(minY, obs.first.GetMinY());
+      maxY = std::max(maxY, obs.first.GetMaxY());
+    }
+  }
+
+  if( minX > maxX ) {
+    // no obstacles, so everything is clear
+    valid_ = true;
+    return true;
+  }
+
+  minCellX_ = GetCell(minX - kCellMargin_mm);
+  minCellY_ = GetCell(minY - kCellMargin_mm);
+  numCols_ = GetCell(maxX + kCellMargin_mm) - minCellX_ + 1;
+  numRows_ = GetCell(maxY + kCellMargin_mm) - minCellY_ + 1;
+
+  const size_t cellsPerAngle = (size_t)numCols_ * (size_t)numRows_;
+  if( cellsPerAngle > kMaxCellsPerAngle ) {
+    PRINT_NAMED_INFO("CollisionBitmap.Build.TooLarge",
+                     "obstacles span %dx%d cells, using exact collision checks only",
+                     numCols_,
+                     numRows_);
+    Clear();
+    return false;
+  }
+
+  bits_.assign( (cellsPerAngle * GraphState::numAngles_ + 63) / 64, 0 );
+
+  for( size_t angle = 0; angle < obstaclesPerAngle.size() && angle < GraphState::numAngles_; ++angle ) {
+    for( const auto& obs : obstaclesPerAngle[angle] ) {
+      Rasterize(obs.first, (GraphTheta)angle);
+    }
+  }
+
+  valid_ = true;
+  return true;
+}
+
+void CollisionBitmap::Rasterize(const FastPolygon& poly, GraphTheta theta)
+{
+  const size_t numPts = poly.size();
+  if( numPts == 0 ) {
+    return;
+  }
+
+  const float res = GraphState::resolution_mm_;
+
+  const int firstRow = GetCell(poly.GetMinY() - kCellMargin_mm);
+  const int lastRow = GetCell(poly.GetMaxY() + kCellMargin_mm);
+
+  for( int cellY = firstRow; cellY <= lastRow; ++cellY ) {
+    // find the x extent of the polygon within this row (grown by the margin). The extreme points of the
+    // intersection are always on the polygon boundary, so it's enough to clip each edge to the row
+    const float rowMinY = cellY * res - kCellMargin_mm;
+    const float rowMaxY = (cellY + 1) * res + kCellMargin_mm;
+
+    float rowMinX = FLT_MAX;
+    float rowMaxX = -FLT_MAX;
+
+    for( size_t i = 0; i < numPts; ++i ) {
+      const Point2f& p = poly[i];
+      const Point2f& q = poly[(i + 1) % numPts];
+
+      if( std::max(p.y(), q.y()) < rowMinY || std::min(p.y(), q.y()) > rowMaxY ) {
+        continue;
+      }
+
+      float tMin = 0.0f;
+      float tMax = 1.0f;
+      const float dy = q.y() - p.y();
+      if( dy != 0.0f ) {
+        const float tA = (rowMinY - p.y()) / dy;
+        const float tB = (rowMaxY - p.y()) / dy;
+        tMin = std::max(tMin, std::min(tA, tB));
+        tMax = std::min(tMax, std::max(tA, tB));
+      }
+
+      const float xA = p.x() + (q.x() - p.x()) * tMin;
+      const float xB = p.x() + (q.x() - p.x()) * tMax;
+      rowMinX = std::min(rowMinX, std::min(xA, xB));
+      rowMaxX = std::max(rowMaxX, std::max(xA, xB));
+    }
+
+    if( rowMinX > rowMaxX ) {
+      continue;
+    }
+
+    const int firstCol = GetCell(rowMinX - kCellMargin_mm);
+    const int lastCol = GetCell(rowMaxX + kCellMargin_mm);
+    for( int cellX = firstCol; cellX <= lastCol; ++cellX ) {
+      SetOccupied(theta, cellX, cellY);
+    }
+  }
+}
+
+bool CollisionBitmap::AnyOccupied(const MotionPrimitive& prim, int startCellX, int startCellY) const
+{
+  if( bits_.empty() ) {
+    return false;
+  }
+
+  for( const auto& cell : prim.sweptCells ) {
+    if( IsOccupied(cell.theta, startCellX + cell.dx, startCellY + cell.dy) ) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+}
+}
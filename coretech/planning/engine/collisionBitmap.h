@@ -0,0 +1,95 @@
+/**
+ * File: collisionBitmap.h
+ *
+ * Description: per-angle rasterized obstacle occupancy, used to quickly rule out collision checks
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#ifndef _ANKICORETECH_PLANNING_COLLISION_BITMAP_H_
+#define _ANKICORETECH_PLANNING_COLLISION_BITMAP_H_
+
+#include "coretech/common/engine/math/fastPolygon2d.h"
+#include "coretech/planning/engine/xythetaActions.h"
+#include <cmath>
+#include <vector>
+
+namespace Anki
+{
+namespace Planning
+{
+
+// One bit per lattice cell (GraphState::resolution_mm_ on a side) and angle, set if any obstacle (fatal or
+// soft) at that angle touches the cell. Cells are indexed the same way as GraphState x/y, so a motion
+// primitive's MotionPrimitive::sweptCells can be looked up directly relative to its starting state.
+//
+// This is conservative: a clear cell means none of the polygons can contain any point in it, but a set cell
+// only means the exact polygon checks need to run
+class CollisionBitmap
+{
+public:
+
+  using ObstaclesPerAngle = std::vector< std::vector< std::pair<FastPolygon, Cost> > >;
+
+  CollisionBitmap();
+
+  // Rasterizes all obstacles. Returns false and leaves the bitmap invalid if the obstacles are spread over too
+  // large an area, in which case the exact checks should be used for everything
+  bool Build(const ObstaclesPerAngle& obstaclesPerAngle);
+
+  // Invalidates the bitmap (e.g. because obstacles changed since it was built)
+  void Clear();
+
+  bool IsValid() const { return valid_; }
+
+  // Returns true if any obstacle at the given angle may touch the given cell. Must be valid
+  inline bool IsOccupied(GraphTheta theta, int cellX, int cellY) const;
+
+  // Returns true if any of the cells swept by prim, starting from the given cell, may touch an obstacle at the
+  // corresponding angle. Must be valid
+  bool AnyOccupied(const MotionPrimitive& prim, int startCellX, int startCellY) const;
+
+  // returns the cell index containing the given (continuous) coordinate
+  static inline int GetCell(float mm) { return (int)std::floor(mm * GraphState::oneOverResolution_); }
+
+private:
+
+  void Rasterize(const FastPolygon& poly, GraphTheta theta);
+
+  inline void SetOccupied(GraphTheta theta, int cellX, int cellY) {
+    const size_t bitIdx = GetBitIndex(theta, cellX - minCellX_, cellY - minCellY_);
+    bits_[bitIdx >> 6] |= ((u64)1 << (bitIdx & 63));
+  }
+
+  inline size_t GetBitIndex(GraphTheta theta, int col, int row) const {
+    return ( (size_t)theta * numRows_ + (size_t)row ) * numCols_ + (size_t)col;
+  }
+
+  bool valid_;
+
+  // area covered by the bitmap, in cells. Anything outside is clear
+  int minCellX_;
+  int minCellY_;
+  int numCols_;
+  int numRows_;
+
+  std::vector<u64> bits_;
+};
+
+inline bool CollisionBitmap::IsOccupied(GraphTheta theta, int cellX, int cellY) const
+{
+  const int col = cellX - minCellX_;
+  const int row = cellY - minCellY_;
+  if( col < 0 || row < 0 || col >= numCols_ || row >= numRows_ ) {
+    return false;
+  }
+
+  const size_t bitIdx = GetBitIndex(theta, col, row);
+  return ( bits_[bitIdx >> 6] >> (bitIdx & 63) ) & 1;
+}
+
+}
+}
+
+#endif
@@ -4,76 +4,182 @@
  * Author: Brad Neuman
  * Created: 2014-04-30
  *
- * Description: open list based on std::map
+ * Description: open list based on an indexed 4-ary min heap
  *
  * Copyright: Anki, Inc. 2014
  *
  **/
 
 #include "openList.h"
+#include <assert.h>
 
 namespace Anki {
 namespace Planning {
 
 using namespace std;
 
-multimap<float, StateID> OpenList::emptyMap_;
-OpenList::iterator OpenList::nullIterator_ = OpenList::emptyMap_.end();
+constexpr size_t OpenList::kArity;
+constexpr OpenList::iterator OpenList::nullIterator_;
 
 OpenList::OpenList()
 {}
 
 void OpenList::clear()
 {
-  fMap_.clear();
+  heap_.clear();
+  heapPos_.clear();
+  freeHandles_.clear();
 }
 
 StateID OpenList::top() const
 {
-  return (*fMap_.begin()).second;
+  return heap_.front().id;
 }
 
 float OpenList::topF() const
 {
-  return (*fMap_.begin()).first;
+  return heap_.front().f;
 }
 
 StateID OpenList::pop()
 {
-  iterator it = fMap_.begin();
-  StateID ret = (*it).second;
+  StateID ret = heap_.front().id;
 
-  fMap_.erase(it);
+  removeAt(0);
 
   return ret;
 }
 
-bool OpenList::empty()
+bool OpenList::empty() const
 {
-  return fMap_.empty();
+  return heap_.empty();
 }
 
-unsigned int OpenList::size()
+unsigned int OpenList::size() const
 {
-  return (unsigned int)fMap_.size();
+  return (unsigned int)heap_.size();
 }
 
 OpenList::iterator OpenList::insert(StateID id, const float f)
 {
-  return fMap_.insert(pair<float,StateID>(f, id));
+  iterator handle;
+  if( freeHandles_.empty() ) {
+    handle = (iterator)heapPos_.size();
+    heapPos_.push_back(0);
+  }
+  else {
+    handle = freeHandles_.back();
+    freeHandles_.pop_back();
+  }
+
+  heap_.push_back({f, id, handle});
+  heapPos_[handle] = (u32)(heap_.size() - 1);
+  siftUp(heap_.size() - 1);
+
+  return handle;
+}
+
+void OpenList::decreaseKey(OpenList::iterator it, const float f)
+{
+  assert( it != nullIterator_ );
+  const size_t pos = heapPos_[it];
+  assert( f <= heap_[pos].f );
+
+  heap_[pos].f = f;
+  siftUp(pos);
+}
+
+void OpenList::updateKey(OpenList::iterator it, const float f)
+{
+  assert( it != nullIterator_ );
+  const size_t pos = heapPos_[it];
+  const float oldF = heap_[pos].f;
+
+  heap_[pos].f = f;
+  if( f < oldF ) {
+    siftUp(pos);
+  }
+  else {
+    siftDown(pos);
+  }
 }
 
 void OpenList::remove(OpenList::iterator it)
 {
-  fMap_.erase(it);
+  assert( it != nullIterator_ );
+  removeAt(heapPos_[it]);
 }
 
+void OpenList::removeAt(size_t pos)
+{
+  freeHandles_.push_back(heap_[pos].handle);
+
+  const HeapNode last = heap_.back();
+  heap_.pop_back();
+
+  if( pos < heap_.size() ) {
+    // move the last node into the hole and restore the heap in whichever direction it needs to go
+    const float removedF = heap_[pos].f;
+    place(pos, last);
+    if( last.f < removedF ) {
+      siftUp(pos);
+    }
+    else {
+      siftDown(pos);
+    }
+  }
+}
+
+void OpenList::siftUp(size_t pos)
+{
+  const HeapNode node = heap_[pos];
+
+  while( pos > 0 ) {
+    const size_t parent = (pos - 1) / kArity;
+    if( !(node.f < heap_[parent].f) ) {
+      break;
+    }
+    place(pos, heap_[parent]);
+    pos = parent;
+  }
+
+  place(pos, node);
+}
+
+void OpenList::siftDown(size_t pos)
+{
+  const HeapNode node = heap_[pos];
+  const size_t heapSize = heap_.size();
+
+  while( true ) {
+    const size_t firstChild = pos * kArity + 1;
+    if( firstChild >= heapSize ) {
+      break;
+    }
+
+    // find the smallest child
+    const size_t lastChild = std::min(firstChild + kArity, heapSize);
+    size_t best = firstChild;
+    for( size_t child = firstChild + 1; child < lastChild; ++child ) {
+      if( heap_[child].f < heap_[best].f ) {
+        best = child;
+      }
+    }
+
+    if( !(heap_[best].f < node.f) ) {
+      break;
+    }
+    place(pos, heap_[best]);
+    pos = best;
+  }
+
+  place(pos, node);
+}
 
 bool OpenList::contains(StateID id) const
 {
-  multimap<float, StateID>::const_iterator it;
-  for(it=fMap_.begin(); it!=fMap_.end(); ++it) {
-    if (it->second == id) {
+  for(const auto& node : heap_) {
+    if (node.id == id) {
       return true;
     }
   }
@@ -82,10 +188,9 @@ bool OpenList::contains(StateID id) const
 
 float OpenList::fVal(StateID id) const
 {
-  multimap<float, StateID>::const_iterator it;
-  for(it=fMap_.begin(); it!=fMap_.end(); ++it) {
-    if (it->second == id) {
-      return it->first;
+  for(const auto& node : heap_) {
+    if (node.id == id) {
+      return node.f;
     }
   }
   return FLT_MAX;
@@ -1,10 +1,10 @@
 /**
- * File: openList.cpp
+ * File: openList.h
  *
  * Author: Brad Neuman
  * Created: 2014-04-30
  *
- * Description: open list based on std::multimap
+ * Description: open list based on an indexed 4-ary min heap
  *
  * Copyright: Anki, Inc. 2014
  *
@@ -14,7 +14,8 @@
 #define _ANKICORETECH_PLANNING_OPENLIST_H_
 
 #include "coretech/planning/engine/xythetaEnvironment.h"
-#include <map>
+#include <limits>
+#include <vector>
 
 namespace Anki {
 namespace Planning {
@@ -24,11 +25,13 @@ class OpenList
 
 public:
 
-  typedef std::multimap<float, StateID>::iterator iterator;
+  // Handle to an entry in the open list. Handles stay valid while the entry is in the list, regardless of how
+  // the heap is reordered, so they can be stored (e.g. in the StateTable) and used for in-place updates
+  typedef u32 iterator;
 
   OpenList();
 
-  // Clears the open list
+  // Clears the open list. Keeps the allocated memory around so that the next search doesn't need to allocate
   void clear();
 
   // Return the first element
@@ -40,27 +43,26 @@ public:
   // Remove and return the first element
   StateID pop();
 
-  bool empty();
+  bool empty() const;
 
-  unsigned int size();
+  unsigned int size() const;
 
   // Inserts a new entry into the open list. Do not call this if there
   // is already an entry associated with the state
   iterator insert(StateID stateID, const float f);
 
-  // Returns a "null iterator" that will always be consistent
-  static iterator nullIterator() {return nullIterator_;}
+  // Lowers the f value of an existing entry in place (no removal or re-insertion). f must not be greater than
+  // the entry's current f value
+  void decreaseKey(iterator it, const float f);
 
-  // removes an iterator.
-  void remove(iterator it);
+  // Changes the f value of an existing entry in place, in either direction
+  void updateKey(iterator it, const float f);
 
-  // allows iteration through the internal map
-  std::multimap<float, StateID>::iterator begin() { return fMap_.begin(); };
-  std::multimap<float, StateID>::iterator end() { return fMap_.end(); };
+  // Returns a "null iterator" that will never refer to a valid entry
+  static iterator nullIterator() {return nullIterator_;}
 
-  // const versions
-  std::multimap<float, StateID>::const_iterator begin() const { return fMap_.begin(); };
-  std::multimap<float, StateID>::const_iterator end() const { return fMap_.end(); };
+  // removes an entry.
+  void remove(iterator it);
 
   // Returns true if the state is contained in the open list. warning:
   // these are both linear time!! don't call these
@@ -69,19 +71,41 @@ public:
   // returns very high number if id is not in this list, otherwise
   // returns the f value. Linear time function!
   float fVal(StateID id) const;
-  
+
 private:
 
-  // Multimap is internally stored as a min heap
-  // This multimap maps from a given f value to a state ID
-  std::multimap<float, StateID> fMap_;
+  // heap arity. 4 keeps the heap shallow and all children of a node within one cache line
+  static constexpr size_t kArity = 4;
+
+  struct HeapNode
+  {
+    float f;
+    StateID id;
+    iterator handle;
+  };
+
+  void siftUp(size_t pos);
+  void siftDown(size_t pos);
+
+  // removes the node at the given heap position and returns its handle to the free list
+  void removeAt(size_t pos);
+
+  // places the node in the heap at the given position, updating its handle
+  inline void place(size_t pos, const HeapNode& node) {
+    heap_[pos] = node;
+    heapPos_[node.handle] = (u32)pos;
+  }
+
+  // implicit min heap on f
+  std::vector<HeapNode> heap_;
+
+  // position in heap_ of each handle (only meaningful for handles currently in use)
+  std::vector<u32> heapPos_;
 
-  // empty map that is used to obtain a valid "null iterator" to
-  // signify an empty slot
-  static std::multimap<float, StateID> emptyMap_;
+  // handles that have been released and can be reused
+  std::vector<iterator> freeHandles_;
 
-  // the null iterator itself
-  static iterator nullIterator_;
+  static constexpr iterator nullIterator_ = std::numeric_limits<iterator>::max();
 };
 
 }
@@ -12,57 +12,101 @@
 
 
 #include "stateTable.h"
+#include <assert.h>
 
 namespace Anki
 {
 namespace Planning
 {
 
+constexpr size_t StateTable::kMaxLoadFactorInv;
+constexpr size_t StateTable::kInitialNumSlotsLog2;
+
 StateTable::StateTable()
+  : size_(0)
+  , generation_(1)
+  , shift_(0)
 {
+  Rehash(kInitialNumSlotsLog2);
 }
 
 void StateTable::Clear()
 {
-  table_.clear();
+  size_ = 0;
+  ++generation_;
+
+  if( generation_ == 0 ) {
+    // wrapped around, so old slots could look occupied again. Reset them all once
+    for( auto& slot : slots_ ) {
+      slot.generation = 0;
+    }
+    generation_ = 1;
+  }
 }
 
-StateEntry& StateTable::operator[](const StateID& sid)
+StateEntry* StateTable::find(StateID sid)
 {
-  return table_[sid];
+  Slot& slot = slots_[Probe(sid)];
+  return ( slot.generation == generation_ ) ? &slot.entry : nullptr;
 }
 
-StateTable::iterator StateTable::find(StateID sid)
+const StateEntry* StateTable::find(StateID sid) const
 {
-  return table_.find(sid);
+  const Slot& slot = slots_[Probe(sid)];
+  return ( slot.generation == generation_ ) ? &slot.entry : nullptr;
 }
 
-StateTable::const_iterator StateTable::begin() const
+StateEntry& StateTable::operator[](const StateID& sid)
 {
-  return table_.begin();
+  StateEntry* entry = find(sid);
+  if( entry != nullptr ) {
+    return *entry;
+  }
+
+  return emplace(sid, OpenList::nullIterator(), StateID(), 0, 0.0, -1.0);
 }
 
-StateTable::const_iterator StateTable::end() const
+StateEntry& StateTable::emplace(StateID sid,
+                                OpenList::iterator openIt,
+                                StateID backpointer,
+                                ActionID backpointerAction,
+                                Cost penalty,
+                                Cost g)
 {
-  return table_.end();
+  if( (size_ + 1) * kMaxLoadFactorInv > slots_.size() ) {
+    Rehash(32 - shift_ + 1);
+  }
+
+  Slot& slot = slots_[Probe(sid)];
+  assert( slot.generation != generation_ );
+
+  slot.key = sid;
+  slot.generation = generation_;
+  slot.entry = StateEntry(openIt, backpointer, backpointerAction, penalty, g);
+  ++size_;
+
+  return slot.entry;
 }
 
-void StateTable::emplace(StateID sid,
-                         OpenList::iterator openIt,
-                         StateID backpointer,
-                         ActionID backpointerAction,
-                         Cost penalty,
-                         Cost g)
+void StateTable::Rehash(size_t numSlotsLog2)
 {
-  // this version of implace uses the argument constructor for
-  // StateEntry, so only one state entry is ever created, no copying
-  table_.emplace(std::piecewise_construct,
-                 std::forward_as_tuple(sid),
-                 std::forward_as_tuple(openIt,
-                                       backpointer,
-                                       backpointerAction,
-                                       penalty,
-                                       g));
+  std::vector<Slot> oldSlots((size_t)1 << numSlotsLog2);
+  oldSlots.swap(slots_);
+  shift_ = (u32)(32 - numSlotsLog2);
+
+  // new slots are value initialized, so they are all empty for generation 1
+  const u32 oldGeneration = generation_;
+  generation_ = 1;
+
+  // re-insert everything from the current search
+  for( const auto& oldSlot : oldSlots ) {
+    if( oldSlot.generation == oldGeneration ) {
+      Slot& slot = slots_[Probe(oldSlot.key)];
+      slot.key = oldSlot.key;
+      slot.generation = generation_;
+      slot.entry = oldSlot.entry;
+    }
+  }
 }
 
 }
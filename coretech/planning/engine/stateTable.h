@@ -16,7 +16,8 @@
 // TODO:(bn) pull out basic defined from environment, so we don't need the whole thing
 #include "coretech/planning/engine/xythetaEnvironment.h"
 #include "openList.h"
-#include <unordered_map>
+#include <limits>
+#include <vector>
 
 namespace Anki
 {
@@ -35,39 +36,19 @@ struct StateEntry
     backpointer_(backpointer),
     backpointerAction_(backpointerAction),
     penaltyIntoState_(penalty),
-    g_(g)
+    g_(g),
+    rhs_(std::numeric_limits<Cost>::infinity())
     {
-      // printf("running argument constructor\n");
     }
 
-  StateEntry(const StateEntry& lval) :
-    openIt_(lval.openIt_),
-    closedIter_(lval.closedIter_),
-    backpointer_(lval.backpointer_),
-    backpointerAction_(lval.backpointerAction_),
-    penaltyIntoState_(lval.penaltyIntoState_),
-    g_(lval.g_)
-    {
-      // printf("running lval copy constructor\n");
-    }
-
-  StateEntry(StateEntry&& rval) :
-    openIt_(rval.openIt_),
-    closedIter_(rval.closedIter_),
-    backpointer_(rval.backpointer_),
-    backpointerAction_(rval.backpointerAction_),
-    penaltyIntoState_(rval.penaltyIntoState_),
-    g_(rval.g_)
-    {
-      // printf("running rval copy constructor\n");
-    }    
-
   StateEntry() :
+    openIt_(OpenList::nullIterator()),
     closedIter_(-1),
+    backpointerAction_(0),
     penaltyIntoState_(0.0),
-    g_(-1.0)
+    g_(-1.0),
+    rhs_(std::numeric_limits<Cost>::infinity())
     {
-      printf("WARNING: default StateEntry constructor called. This is a performance bug\n");
     }
 
   // Check if we are closed on the given search iteration
@@ -85,35 +66,77 @@ struct StateEntry
 
   // TODO:(bn) think hard about if I actually need this or not
   Cost g_;
+
+  // one step lookahead of g, only used by the incremental search (where g is the cost to reach a goal)
+  Cost rhs_;
 };
 
+// Flat open-addressing hash table from StateID to StateEntry. StateIDs are far too sparse to index directly, so
+// they are hashed into a power of two array of slots with linear probing. Clear() only bumps a generation
+// counter, so the slots allocated during one search are reused by the next one without touching the heap.
+// NOTE: inserting may grow the table, which invalidates any pointers or references to existing entries
 class StateTable
 {
 public:
-  typedef std::unordered_map<u32, StateEntry>::iterator iterator;
-  typedef std::unordered_map<u32, StateEntry>::const_iterator const_iterator;
 
   StateTable();
 
+  // Removes all entries in constant time. Memory is kept for the next search
   void Clear();
 
-  iterator find(StateID sid);
-  const_iterator begin() const;
-  const_iterator end() const;
+  // returns nullptr if there is no entry for the given state
+  StateEntry* find(StateID sid);
+  const StateEntry* find(StateID sid) const;
 
+  // returns the entry for the state, default constructing it if needed
   StateEntry& operator[](const StateID& sid);
 
-  // First argument must be a StateID, followed by all arguments for
-  // the StateEntry constructor
-  void emplace(StateID sid,
-               OpenList::iterator openIt,
-               StateID backpointer,
-               ActionID backpointerAction,
-               Cost penalty,
-               Cost g);
+  // Adds a new entry (there must not already be one for sid) and returns it. First argument must be a StateID,
+  // followed by all arguments for the StateEntry constructor
+  StateEntry& emplace(StateID sid,
+                      OpenList::iterator openIt,
+                      StateID backpointer,
+                      ActionID backpointerAction,
+                      Cost penalty,
+                      Cost g);
+
+  size_t size() const { return size_; }
 
 private:
-  std::unordered_map<u32, StateEntry> table_;
+
+  struct Slot
+  {
+    u32 key;
+    // slot is occupied iff this matches the current generation of the table
+    u32 generation;
+    StateEntry entry;
+  };
+
+  // keep the table at most half full so probe sequences stay short
+  static constexpr size_t kMaxLoadFactorInv = 2;
+  static constexpr size_t kInitialNumSlotsLog2 = 12;
+
+  inline size_t GetHomeSlot(u32 key) const {
+    // fibonacci hashing, so that neighboring states (which differ only in the low bits) spread across the table
+    return (size_t)((key * 2654435761u) >> shift_);
+  }
+
+  // returns the slot holding key, or the empty slot where it should go
+  inline size_t Probe(u32 key) const {
+    const size_t mask = slots_.size() - 1;
+    size_t idx = GetHomeSlot(key);
+    while( slots_[idx].generation == generation_ && slots_[idx].key != key ) {
+      idx = (idx + 1) & mask;
+    }
+    return idx;
+  }
+
+  void Rehash(size_t numSlotsLog2);
+
+  std::vector<Slot> slots_;
+  size_t size_;
+  u32 generation_;
+  u32 shift_;
 };
 
 
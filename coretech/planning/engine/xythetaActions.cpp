@@ -11,6 +11,7 @@
  **/
 
 #include "xythetaActions.h"
+#include "collisionBitmap.h"
 #include "xythetaEnvironment.h"
 
 #include "util/console/consoleInterface.h"
@@ -179,6 +180,7 @@ bool MotionPrimitive::Import(const Json::Value& config)
   }
 
   CacheBoundingBox();
+  CacheSweptCells();
 
   return true;
 }
@@ -207,6 +209,31 @@ void MotionPrimitive::CacheBoundingBox()
   }
 }
 
+void MotionPrimitive::CacheSweptCells()
+{
+  sweptCells.clear();
+
+  auto addCell = [this](int dx, int dy, GraphTheta theta) {
+    for( const auto& cell : sweptCells ) {
+      if( cell.dx == dx && cell.dy == dy && cell.theta == theta ) {
+        return;
+      }
+    }
+    sweptCells.push_back({(int16_t)dx, (int16_t)dy, theta});
+  };
+
+  const bool isStraight = ( endStateOffset.theta == startTheta );
+
+  for( const auto& pt : intermediatePositions ) {
+    const int dx = CollisionBitmap::GetCell(pt.position.x_mm);
+    const int dy = CollisionBitmap::GetCell(pt.position.y_mm);
+    addCell(dx, dy, pt.nearestTheta);
+    if( isStraight ) {
+      addCell(dx, dy, startTheta);
+    }
+  }
+}
+
 void MotionPrimitive::Dump(Util::JsonWriter& writer) const
 {
   writer.AddEntry("action_index", id);
@@ -482,6 +509,7 @@ bool MotionPrimitive::Create(const Json::Value& config, GraphTheta startingAngle
   }
 
   CacheBoundingBox();
+  CacheSweptCells();
 
   return true;
 }
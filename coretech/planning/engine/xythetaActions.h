@@ -143,11 +143,29 @@ public:
   float minY;
   float maxY;
 
+  // a lattice cell (relative to the cell of the starting state) that an intermediate position falls in, along
+  // with the angle of the obstacles it gets checked against
+  struct SweptCell
+  {
+    int16_t dx;
+    int16_t dy;
+    GraphTheta theta;
+  };
+
+  // unique cells covered by intermediatePositions, for lookups in the CollisionBitmap. Straight primitives
+  // include both the starting angle and each position's nearest angle (if different), since callers check
+  // against either one. Reverse copies keep these cells, which holds because predecessors are checked exactly
+  // like the forward primitive from the predecessor
+  std::vector<SweptCell> sweptCells;
+
 private:
 
   // compute min/max x/y
   void CacheBoundingBox(); 
 
+  // compute sweptCells
+  void CacheSweptCells();
+
   Path pathSegments_;
 };
 
@@ -93,7 +93,13 @@ void SuccessorIterator::Next(const xythetaEnvironment& env)
     float minPrimY = prim->minY + primtiveOffset.y_mm;
     float maxPrimY = prim->maxY + primtiveOffset.y_mm;
 
-    if( env.obstacleBounds_.empty() && ! env.obstaclesPerAngle_[0].empty() ) {
+    if( env.collisionBitmap_.IsValid() ) {
+      // only do the exact checks if the primitive passes through a cell that some obstacle touches. The
+      // swept cells are relative to where the primitive starts, which is the result state when going backwards
+      const GraphState& primStart = reverse_ ? result : start_;
+      possibleObstacle = env.collisionBitmap_.AnyOccupied(*prim, primStart.x, primStart.y);
+    }
+    else if( env.obstacleBounds_.empty() && ! env.obstaclesPerAngle_[0].empty() ) {
       // unit tests might do this
       PRINT_NAMED_WARNING("xythetaEnvironment.Successor.NoBounds",
                           "missing obstacle bounding boxes! Did you call env.PrepareForPlanning()???");
@@ -120,9 +126,12 @@ void SuccessorIterator::Next(const xythetaEnvironment& env)
       // two collision check cases. If the angle is changing, then we'll need to potentially switch which
       // obstacle angle we check while checking, so that is the more complciated case
 
-      // First, handle the simpler case, for straight lines. In this case, we can do a quick bounding box check first
+      // First, handle the simpler case, for straight lines. In this case, we can do a quick bounding box check first.
+      // Reverse primitives end where the forward one started, so whether they turn is given by the angle we are
+      // iterating from. Either way, the checks are the same as for the forward primitive leading to start_
 
-      if( prim->endStateOffset.theta == prim->startTheta ) {
+      const GraphTheta primEndTheta = reverse_ ? start_.theta : prim->endStateOffset.theta;
+      if( primEndTheta == prim->startTheta ) {
         for( const auto& obs : env.obstaclesPerAngle_[prim->startTheta] ) {
 
           if( maxPrimX < obs.first.GetMinX() ||
@@ -220,6 +229,17 @@ Cost xythetaEnvironment::CheckAndApplyAction(const ActionID& action, StateID& st
 
   const MotionPrimitive* prim = & allActions_.GetForwardMotion(curr.theta, action);
 
+  GraphState result(curr);
+  result.x += prim->endStateOffset.x;
+  result.y += prim->endStateOffset.y;
+  result.theta = prim->endStateOffset.theta;
+
+  if( collisionBitmap_.IsValid() && ! collisionBitmap_.AnyOccupied(*prim, curr.x, curr.y) ) {
+    // nothing anywhere near the action
+    stateID = result.GetStateID();
+    return 0.0;
+  }
+
   Cost penalty = 0.0;
 
 
@@ -242,11 +262,6 @@ Cost xythetaEnvironment::CheckAndApplyAction(const ActionID& action, StateID& st
     }
   }
 
-  GraphState result(curr);
-  result.x += prim->endStateOffset.x;
-  result.y += prim->endStateOffset.y;
-  result.theta = prim->endStateOffset.theta;
-
   stateID = result.GetStateID();
   return penalty;
 }
@@ -501,6 +516,8 @@ void xythetaEnvironment::PrepareForPlanning()
       }
     }
   }
+
+  collisionBitmap_.Build(obstaclesPerAngle_);
 }
 
 bool xythetaEnvironment::IsInCollision(GraphState s) const
@@ -511,6 +528,11 @@ bool xythetaEnvironment::IsInCollision(GraphState s) const
 bool xythetaEnvironment::IsInCollision(State_c c) const
 {  
   GraphTheta angle = c.GetGraphTheta();
+  if( collisionBitmap_.IsValid() &&
+      ! collisionBitmap_.IsOccupied(angle, CollisionBitmap::GetCell(c.x_mm), CollisionBitmap::GetCell(c.y_mm)) ) {
+    return false;
+  }
+
   size_t endObs = obstaclesPerAngle_[angle].size();
 
   for(size_t obsIdx=0; obsIdx<endObs; ++obsIdx) {
@@ -524,6 +546,10 @@ bool xythetaEnvironment::IsInCollision(State_c c) const
 bool xythetaEnvironment::IsInSoftCollision(GraphState s) const
 {
   GraphTheta angle = s.theta;
+  if( collisionBitmap_.IsValid() && ! collisionBitmap_.IsOccupied(angle, s.x, s.y) ) {
+    return false;
+  }
+
   size_t endObs = obstaclesPerAngle_[angle].size();
 
   for(size_t obsIdx=0; obsIdx<endObs; ++obsIdx) {
@@ -536,6 +562,10 @@ bool xythetaEnvironment::IsInSoftCollision(GraphState s) const
 Cost xythetaEnvironment::GetCollisionPenalty(GraphState s) const
 {
   GraphTheta angle = s.theta;
+  if( collisionBitmap_.IsValid() && ! collisionBitmap_.IsOccupied(angle, s.x, s.y) ) {
+    return 0.0;
+  }
+
   size_t endObs = obstaclesPerAngle_[angle].size();
 
   for(size_t obsIdx=0; obsIdx<endObs; ++obsIdx) {
@@ -565,6 +595,64 @@ size_t xythetaEnvironment::GetNumObstacles() const
   return obstaclesPerAngle_[0].size();
 }
 
+void xythetaEnvironment::GetChangedObstacleBounds(const ObstaclesPerAngle& previous,
+                                                  std::vector<Bounds>& changedBounds) const
+{
+  auto sameObstacle = [](const std::pair<FastPolygon, Cost>& a, const std::pair<FastPolygon, Cost>& b) {
+    if( a.second != b.second || a.first.size() != b.first.size() ) {
+      return false;
+    }
+    for( size_t i=0; i<a.first.size(); ++i ) {
+      if( !(a.first[i] == b.first[i]) ) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  auto addBounds = [&changedBounds](const FastPolygon& poly) {
+    Bounds bounds;
+    bounds.minX = poly.GetMinX();
+    bounds.maxX = poly.GetMaxX();
+    bounds.minY = poly.GetMinY();
+    bounds.maxY = poly.GetMaxY();
+    changedBounds.push_back(bounds);
+  };
+
+  std::vector<bool> matched;
+
+  for(size_t angle = 0; angle < obstaclesPerAngle_.size(); ++angle) {
+    static const std::vector< std::pair<FastPolygon, Cost> > kNoObstacles;
+    const auto& prevObstacles = (angle < previous.size()) ? previous[angle] : kNoObstacles;
+
+    // obstacles are usually re-added in the same order, so start each search right after the last match,
+    // which makes this close to linear in practice
+    matched.assign(prevObstacles.size(), false);
+    size_t searchStart = 0;
+    for( const auto& obs : obstaclesPerAngle_[angle] ) {
+      bool found = false;
+      for( size_t i = 0; i < prevObstacles.size(); ++i ) {
+        const size_t prevIdx = (searchStart + i) % prevObstacles.size();
+        if( !matched[prevIdx] && sameObstacle(obs, prevObstacles[prevIdx]) ) {
+          matched[prevIdx] = true;
+          searchStart = prevIdx + 1;
+          found = true;
+          break;
+        }
+      }
+      if( !found ) {
+        addBounds(obs.first);
+      }
+    }
+
+    for( size_t prevIdx = 0; prevIdx < prevObstacles.size(); ++prevIdx ) {
+      if( !matched[prevIdx] ) {
+        addBounds(prevObstacles[prevIdx].first);
+      }
+    }
+  }
+}
+
 bool xythetaEnvironment::Init(const char* mprimFilename)
 {
   if(ReadMotionPrimitives(mprimFilename)) {
@@ -645,6 +733,8 @@ bool xythetaEnvironment::ReadMotionPrimitives(const char* mprimFilename)
 
 bool xythetaEnvironment::ParseObstacles(const Json::Value& config)
 {
+  collisionBitmap_.Clear();
+
   try {
     if( GraphState::numAngles_ == 0 || config["angles"].isNull() ) {
       PRINT_NAMED_ERROR("xythetaEnvironment.ParseObstacles.InvalidObjectAngles",
@@ -738,6 +828,8 @@ void xythetaEnvironment::AddObstacleAllThetas(const Quad2f& quad, Cost cost)
   for(size_t i=0; i<GraphState::numAngles_; ++i) {
     obstaclesPerAngle_[i].push_back( std::make_pair( fastPoly, cost ) );
   }
+
+  collisionBitmap_.Clear();
 }
   
 void xythetaEnvironment::AddObstacleAllThetas(const RotatedRectangle& rect, Cost cost)
@@ -748,6 +840,8 @@ void xythetaEnvironment::AddObstacleAllThetas(const RotatedRectangle& rect, Cost
   for(size_t i=0; i<GraphState::numAngles_; ++i) {
     obstaclesPerAngle_[i].push_back( std::make_pair( fastPoly, cost ) );
   }
+
+  collisionBitmap_.Clear();
 }
 
 void xythetaEnvironment::ClearObstacles()
@@ -755,6 +849,8 @@ void xythetaEnvironment::ClearObstacles()
   for(size_t i=0; i<GraphState::numAngles_; ++i) {
     obstaclesPerAngle_[i].clear();
   }
+
+  collisionBitmap_.Clear();
 }
 
 FastPolygon xythetaEnvironment::ExpandCSpace(const ConvexPolygon& obstacle,
@@ -880,6 +976,7 @@ const FastPolygon& xythetaEnvironment::AddObstacleWithExpansion(const ConvexPoly
   }
 
   obstaclesPerAngle_[theta].emplace_back(std::make_pair(ExpandCSpace(obstacle, robot), cost));
+  collisionBitmap_.Clear();
 
   return obstaclesPerAngle_[theta].back().first;
 }
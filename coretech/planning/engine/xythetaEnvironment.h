@@ -6,6 +6,7 @@
 #include "coretech/planning/engine/robotActionParams.h"
 #include "coretech/planning/shared/path.h"
 #include "json/json-forwards.h"
+#include "collisionBitmap.h"
 #include "xythetaActions.h"
 #include "util/math/math.h"
 #include <assert.h>
@@ -129,6 +130,30 @@ public:
 
   size_t GetNumObstacles() const;
 
+  // Obstacles per theta. First index is theta, second of pair is cost
+  using ObstaclesPerAngle = std::vector< std::vector< std::pair<FastPolygon, Cost> > >;
+  const ObstaclesPerAngle& GetObstacles() const { return obstaclesPerAngle_; }
+
+  struct Bounds {
+    Bounds()
+      : minX(FLT_MAX)
+      , maxX(FLT_MIN)
+      , minY(FLT_MAX)
+      , maxY(FLT_MIN)
+      {
+      }
+
+    float minX;
+    float maxX;
+    float minY;
+    float maxY;
+  };
+
+  // Compares the current obstacles against a previous copy of them (e.g. from the last time the planner ran),
+  // and appends the bounding box of every obstacle that was added or removed since then to changedBounds.
+  // Obstacles only match if they have the same polygon, cost, and angle
+  void GetChangedObstacleBounds(const ObstaclesPerAngle& previous, std::vector<Bounds>& changedBounds) const;
+
   // Returns an iterator to the successors from state "start". Use this one if you want to check each
   // action. If reverse is true, then get predecessors (reverse successors) instead
   SuccessorIterator GetSuccessors(StateID startID, Cost currG, bool reverse = false) const;
@@ -193,7 +218,10 @@ public:
 
   // If we are going to be doing a full planner cycle, this function
   // will be called to prepare the environment, including
-  // precomputing things, etc.
+  // precomputing things, etc. This also rasterizes the obstacles so
+  // collision checks can skip anything that is clearly free. Adding or
+  // removing obstacles drops the rasterized obstacles until this is
+  // called again
   void PrepareForPlanning();
 
   // Returns true if there is a fatal collision at the given state
@@ -232,28 +260,16 @@ private:
   ActionSpace allActions_;
 
   // Obstacles per theta. First index is theta, second of pair is cost
-  std::vector< std::vector< std::pair<FastPolygon, Cost> > > obstaclesPerAngle_;
-
-  struct Bounds {
-    Bounds()
-      : minX(FLT_MAX)
-      , maxX(FLT_MIN)
-      , minY(FLT_MAX)
-      , maxY(FLT_MIN)
-      {
-      }
-
-    float minX;
-    float maxX;
-    float minY;
-    float maxY;
-  };
+  ObstaclesPerAngle obstaclesPerAngle_;
 
   // one per obstacle, this is the bounding box that will bound that obstacle at every angle. If you are clear
   // of all of these, then you can skip the check. Order is the same as the obstacle order within the angles
   // in obstaclesPerAngle_
   // NOTE: (mrw) FastPolygon already has the AABB for us...
   std::vector< Bounds > obstacleBounds_;
+
+  // rasterized obstacles, built by PrepareForPlanning. When valid, this replaces the obstacleBounds_ check
+  CollisionBitmap collisionBitmap_;
 };
 
 
@@ -18,7 +18,9 @@
 #include "util/logging/logging.h"
 #include "xythetaPlanner_internal.h"
 #include <assert.h>
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <unordered_set>
 
 
@@ -36,6 +38,10 @@ namespace Planning {
 // penalty zone
 #define COLLISION_GOAL_HEURISTIC_NUM_ESCAPES 1
   
+// When repairing the incremental search after obstacle changes, fall back to searching from scratch if the changed
+// area contains more than this many states (or more than the search had visited, if that is larger)
+#define MAX_INCREMENTAL_REPAIR_STATES 200000
+
 // temporary toggle to compare A* implementations - remove soon
 #define USE_NEW_SEARCH 1
 
@@ -82,8 +88,14 @@ bool xythetaPlanner::Replan(unsigned int maxExpansions, volatile bool* runPlan)
   using namespace std::chrono;
 
   high_resolution_clock::time_point start = high_resolution_clock::now();
-  bool ret = (USE_NEW_SEARCH) ? _impl->AStar(maxExpansions, runPlan)
-                              : _impl->ComputePath(maxExpansions, runPlan);
+  bool ret = false;
+  if( _impl->_context.useIncrementalSearch ) {
+    ret = _impl->DStarLite(maxExpansions, runPlan);
+  }
+  else {
+    ret = (USE_NEW_SEARCH) ? _impl->AStar(maxExpansions, runPlan)
+                           : _impl->ComputePath(maxExpansions, runPlan);
+  }
   high_resolution_clock::time_point end = high_resolution_clock::now();
 
   duration<double> time_d = duration_cast<duration<double>>(end - start);
@@ -135,6 +147,11 @@ int xythetaPlanner::GetLastNumConsiderations() const
   return _impl->_considerations;
 }
 
+int xythetaPlanner::GetLastNumReusedStates() const
+{
+  return _impl->_reusedStates;
+}
+
 void xythetaPlanner::GetTestPlan(xythetaPlan& plan)
 {
   _impl->GetTestPlan(plan);
@@ -154,6 +171,9 @@ xythetaPlannerImpl::xythetaPlannerImpl(const xythetaPlannerContext& context)
   , _searchNum(0)
   , _runPlan(nullptr)
   , _lastPlanTime(-1.0)
+  , _incrementalSearchValid(false)
+  , _km(0.0f)
+  , _reusedStates(0)
 {
   _startID = _start.GetStateID();
   Reset();
@@ -314,6 +334,9 @@ void xythetaPlannerImpl::Reset()
   _goalsChanged = false;
 
   _finalCost = 0.0f;
+
+  _incrementalSearchValid = false;
+  _reusedStates = 0;
 }
 
 bool xythetaPlannerImpl::NeedsReplan() const
@@ -651,14 +674,15 @@ bool xythetaPlannerImpl::ComputePath(unsigned int maxExpansions, volatile bool*
 
 void xythetaPlannerImpl::ExpandState(StateID currID)
 {
-  // hold iterator to current table entry
-  auto& currTableEntry = _table[currID];
+  // NOTE: inserting successors may grow the table, so don't hold on to this entry past the check
+  StateEntry& currTableEntry = _table[currID];
 
   if( currTableEntry.closedIter_ == _searchNum ) {
     PRINT_NAMED_ERROR("xythetaPlanner.ExpandingClosedState", "This is a planner bug! Tell Brad immediately!");
     return;
   }
 
+  currTableEntry.closedIter_ = _searchNum;
   Cost currG = currTableEntry.g_;
   
   SuccessorIterator it = _context.env.GetSuccessors(currID, currG);
@@ -681,10 +705,9 @@ void xythetaPlannerImpl::ExpandState(StateID currID)
       }
     }
 
-    // hold iterator to next state entry
-    auto oldEntry = _table.find(nextID);
+    StateEntry* oldEntry = _table.find(nextID);
 
-    if(oldEntry == _table.end()) {
+    if(oldEntry == nullptr) {
       // no existing entry, so add a new one
       Cost h = heur(nextID);
       Cost f = newG + h;
@@ -697,29 +720,27 @@ void xythetaPlannerImpl::ExpandState(StateID currID)
     }
     // TODO:(bn) opt: delay computing the cost. If the node is closed, don't need to compute it. As I'm
     // computing it, pass in the oldEntry g value, because as soon as we hit that, we could bail out early
-    else if(!oldEntry->second.IsClosed(_searchNum)) {
+    else if(!oldEntry->IsClosed(_searchNum)) {
       // only update if g value is lower
-      if(newG < oldEntry->second.g_) {
+      if(newG < oldEntry->g_) {
         Cost h = heur(nextID);
         Cost f = newG + h;
 
         // if the states are in the table, then they were in the open list at some point. Since they aren't
-        // closed now, they must still be in Open, so remove the old entry to insert the new one
-        assert( oldEntry->second.openIt_ != _open.nullIterator() );
-        _open.remove(oldEntry->second.openIt_);
-        oldEntry->second.openIt_ = _open.insert(nextID, f);
-
-        oldEntry->second.closedIter_ = -1;
-        oldEntry->second.backpointer_ = currID;
-        oldEntry->second.backpointerAction_ = it.Front().actionID;
-        oldEntry->second.g_ = newG;
+        // closed now, they must still be in Open, so lower the key of the existing entry in place
+        assert( oldEntry->openIt_ != _open.nullIterator() );
+        _open.decreaseKey(oldEntry->openIt_, f);
+
+        oldEntry->closedIter_ = -1;
+        oldEntry->backpointer_ = currID;
+        oldEntry->backpointerAction_ = it.Front().actionID;
+        oldEntry->penaltyIntoState_ = it.Front().penalty;
+        oldEntry->g_ = newG;
       }
     }
 
     it.Next( _context.env );
   }
-
-  currTableEntry.closedIter_ = _searchNum;
 }
 
 Cost xythetaPlannerImpl::heur(StateID sid)
@@ -759,11 +780,11 @@ void xythetaPlannerImpl::BuildPlan()
 
   StateID curr = _chosenGoalStateID;
   BOUNDED_WHILE(1000, !(curr == _startID)) {
-    auto it = _table.find(curr);
-    assert(it != _table.end());
+    const StateEntry* entry = _table.find(curr);
+    assert(entry != nullptr);
 
-    _plan.Push(it->second.backpointerAction_, it->second.penaltyIntoState_);
-    curr = it->second.backpointer_;
+    _plan.Push(entry->backpointerAction_, entry->penaltyIntoState_);
+    curr = entry->backpointer_;
   }  
 
   _plan.Reverse();
@@ -825,35 +846,47 @@ bool xythetaPlannerImpl::AStar(unsigned int maxExpansions, volatile bool* runPla
     return true;
   }
 
+  if(PLANNER_DEBUG_PLOT_STATES_CONSIDERED) {
+    _debugExpPlotFile = fopen("expanded.txt", "w");
+  }
+
   // push starting state
-  _open2.emplace(_start.GetStateID());
+  _table.emplace(_startID, _open.insert(_startID, 0.0), _startID, 0, 0.0, 0.0);
 
   bool foundGoal = false;
-  ClosedState testState;
+  StateID currID;
   u32 remainingExpansions = maxExpansions;
 
-  // search loop
-  while( !foundGoal && !_open2.empty() && !(_runPlan && !*_runPlan) && remainingExpansions )  {
-    testState = _open2.pop();
-    foundGoal = IsGoalState(testState);
+  // search loop. Each state is in the open list at most once, improved paths to a state lower its key in place
+  while( !foundGoal && !_open.empty() && !(_runPlan && !*_runPlan) && remainingExpansions )  {
+    currID = _open.pop();
+    foundGoal = IsGoalState(currID);
+
+    StateEntry& currEntry = _table[currID];
+    currEntry.openIt_ = _open.nullIterator();
+    currEntry.closedIter_ = _searchNum;
+
+    // the goal counts as an expansion, but there is no need to generate its successors
+    if( !foundGoal ) {
+      ExpandState_New( currID, currEntry.g_ );
+    }
+    --remainingExpansions;
 
-    // if the insert was successful, expand
-    const auto& it = _closed.emplace( std::move(testState) );
-    if ( it.second ) {
-      ExpandState_New( *(it.first) );
-      --remainingExpansions;
-    } 
+    if(PLANNER_DEBUG_PLOT_STATES_CONSIDERED) {
+      State_c c = _context.env.State2State_c(GraphState(currID));
+      fprintf(_debugExpPlotFile, "%f %f %f %d\n", c.x_mm, c.y_mm, c.theta, currID.s.theta);
+    }
   }
   _expansions = maxExpansions - remainingExpansions;
 
   // A* finished, so build the plan if a goal was found
   if(foundGoal) {
-    BuildPlan_New(testState);
+    BuildPlan_New(currID);
 
     PRINT_NAMED_INFO("xythetaPlanner.ExpandGoal", "expanded goal %d at state %u! cost = %f", 
                      (int)_chosenGoalID, (u32)_chosenGoalStateID, _finalCost);
-    PRINT_NAMED_INFO("xythetaPlanner.CompleteA*", "finished after %d expansions. foundGoal = %d, open size = %zu",
-                     _expansions, foundGoal, _open2.size());
+    PRINT_NAMED_INFO("xythetaPlanner.CompleteA*", "finished after %d expansions. foundGoal = %d, open size = %u",
+                     _expansions, foundGoal, _open.size());
   } else {    
     if(_expansions > maxExpansions) {
       PRINT_NAMED_WARNING("xythetaPlanner.ExceededMaxExpansions", "exceeded max expansions of %u, stopping", maxExpansions);
@@ -862,15 +895,7 @@ bool xythetaPlannerImpl::AStar(unsigned int maxExpansions, volatile bool* runPla
     }
   }
 
-  // accumulate expanded states if we need to for debug
   if(PLANNER_DEBUG_PLOT_STATES_CONSIDERED) {
-    _debugExpPlotFile = fopen("expanded.txt", "w");
-
-    for (const auto& state : _closed) {
-      State_c c = _context.env.State2State_c(GraphState(state.curr));
-      fprintf(_debugExpPlotFile, "%f %f %f %d\n", c.x_mm, c.y_mm, c.theta, testState.curr.s.theta);
-    }
-
     fclose(_debugExpPlotFile);
   }
 
@@ -896,9 +921,9 @@ inline Cost xythetaPlannerImpl::heur_octile(GraphState s) {
   return minCost;
 }
 
-inline void xythetaPlannerImpl::ExpandState_New(const PlannerState& currState)
+inline void xythetaPlannerImpl::ExpandState_New(StateID currID, Cost currG)
 { 
-  SuccessorIterator it = SuccessorIterator(&_context.env, currState.curr, currState.g, false);
+  SuccessorIterator it = SuccessorIterator(&_context.env, currID, currG, false);
   it.Next( _context.env );
 
   // for all possible actions
@@ -907,8 +932,11 @@ inline void xythetaPlannerImpl::ExpandState_New(const PlannerState& currState)
       ++_considerations;
     #endif
 
-    // if successor has been expanded, don't insert. This saves us some extra heap inserts and memory.
-    if ( IsClosedState(it.Front().stateID) ) {
+    const StateID nextID = it.Front().stateID;
+    StateEntry* oldEntry = _table.find(nextID);
+
+    // if successor has been expanded, don't touch it
+    if ( oldEntry != nullptr && oldEntry->IsClosed(_searchNum) ) {
       it.Next( _context.env );
       continue;
     }
@@ -920,8 +948,8 @@ inline void xythetaPlannerImpl::ExpandState_New(const PlannerState& currState)
     //       exclude  theta, rather than check all the goals here. We just need to add a point turn at the end of searching
     if(_context.allowFreeTurnInPlaceAtGoal) {
       for(const auto& goalPair : _goalStateIDs) {
-        if ((currState.curr.s.x == goalPair.second.s.x) && (currState.curr.s.y == goalPair.second.s.y)) {
-          newG = currState.g;
+        if ((currID.s.x == goalPair.second.s.x) && (currID.s.y == goalPair.second.s.y)) {
+          newG = currG;
           break;
         }
       }
@@ -933,52 +961,54 @@ inline void xythetaPlannerImpl::ExpandState_New(const PlannerState& currState)
     // intuitively obvious. We could even provide a helper method to convert planner cost to traversal time to help
     // with debugging/human reading
 
-    // convert heuristic which is a distance to a time-to-traverse cost
-    _open2.emplace( 
-      it.Front().stateID,
-      currState.curr,
-      it.Front().actionID,
-      it.Front().penalty,
-      newG,
-      heur_octile(it.Front().stateID)
-    ); 
+    if( oldEntry == nullptr ) {
+      // first time we see this state. convert heuristic which is a distance to a time-to-traverse cost
+      const Cost f = newG + heur_octile(nextID);
+      _table.emplace(nextID, _open.insert(nextID, f), currID, it.Front().actionID, it.Front().penalty, newG);
+    }
+    else if( newG < oldEntry->g_ ) {
+      // found a cheaper way into a state that is still open, so update it in place
+      const Cost f = newG + heur_octile(nextID);
+      _open.decreaseKey(oldEntry->openIt_, f);
+
+      oldEntry->backpointer_ = currID;
+      oldEntry->backpointerAction_ = it.Front().actionID;
+      oldEntry->penaltyIntoState_ = it.Front().penalty;
+      oldEntry->g_ = newG;
+    }
+
     it.Next( _context.env );
   }
 
   #if PRINT_DEBUG_PLANNER_STATS
     if( ((_expansions>>13) & 1) == 1 ) { // every 8k iterations
-      PRINT_NAMED_INFO("xythetaPlanner.PLANDEBUG", "%8d expansions, cost top: %8.5f", _expansions, _open2.top().g);
+      PRINT_NAMED_INFO("xythetaPlanner.PLANDEBUG", "%8d expansions, cost top: %8.5f", _expansions, _open.topF());
     }
   #endif
 }
 
-inline bool xythetaPlannerImpl::IsGoalState(const PlannerState& candidate)
+inline bool xythetaPlannerImpl::IsGoalState(StateID candidate) const
 {
-  return ( _goalState2GoalID.find(candidate.curr) != _goalState2GoalID.end() );
+  return ( _goalState2GoalID.find(candidate) != _goalState2GoalID.end() );
 }
 
-inline bool xythetaPlannerImpl::IsClosedState(StateID state)
-{
-  return ( _closed.find(ClosedState(state)) != _closed.end() );
-}
-
-void xythetaPlannerImpl::BuildPlan_New(const PlannerState& goal)
+void xythetaPlannerImpl::BuildPlan_New(StateID goalID)
 {  
-  auto it = _goalState2GoalID.find(goal.curr);
+  auto it = _goalState2GoalID.find(goalID);
   assert( it != _goalState2GoalID.end() );  // this should only have been called if goal was found.
 
   _chosenGoalID = it->second;
-  _chosenGoalStateID = goal.curr;
-  _finalCost = goal.g;
+  _chosenGoalStateID = goalID;
+  _finalCost = _table[goalID].g_;
 
   // build plan backwards
-  StateID curr = goal.curr;
+  StateID curr = goalID;
   BOUNDED_WHILE(1000, !(curr == _startID)) {
-    auto it = _closed.find(ClosedState(curr));
-    assert(it != _closed.end());
+    const StateEntry* entry = _table.find(curr);
+    assert(entry != nullptr);
 
-    _plan.Push(it->action, it->penalty);
-    curr = it->prev;
+    _plan.Push(entry->backpointerAction_, entry->penaltyIntoState_);
+    curr = entry->backpointer_;
   }  
   _plan.Reverse();
   _plan.start_ = _start;
@@ -991,9 +1021,9 @@ void xythetaPlannerImpl::Reset_New()
 {
   _plan.Clear();
 
-  // TODO:(bn) shouln't need to clear these if I use searchNum_ properly
-  _closed.clear();
-  _open2.clear();
+  // clearing these is constant time and keeps their memory around for the next search
+  _table.Clear();
+  _open.clear();
 
   _expansions = 0;
   _considerations = 0;
@@ -1002,6 +1032,412 @@ void xythetaPlannerImpl::Reset_New()
   _goalsChanged = false;
 
   _finalCost = 0.0f;
+
+  _incrementalSearchValid = false;
+  _reusedStates = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// incremental search (D* Lite)
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+  const Cost kInfiniteCost = std::numeric_limits<Cost>::infinity();
+}
+
+bool xythetaPlannerImpl::DStarLite(unsigned int maxExpansions, volatile bool* runPlan)
+{
+  _runPlan = runPlan;
+
+  bool fromScratch = _context.forceReplanFromScratch || !_incrementalSearchValid;
+
+  // handle context
+  GoalStateIDPairs newGoalIDs;
+  if( ! CheckContextGoals( newGoalIDs, _goals_c ) ) {
+    // all goals invalid
+    return false;
+  }
+
+  if( newGoalIDs != _goalStateIDs ) {
+    _goalStateIDs = newGoalIDs;
+
+    // invert the map for seeing if a state is a goal
+    _goalState2GoalID.clear();
+    _goalState2GoalID.reserve(newGoalIDs.size());
+    for(const auto& goalPair : newGoalIDs) {
+      _goalState2GoalID[goalPair.second] = goalPair.first;
+    }
+
+    // the search is rooted at the goals, so nothing can be reused
+    fromScratch = true;
+  }
+  assert(!_goalStateIDs.empty());
+
+  GraphState newStart;
+  if( ! CheckContextStart( newStart ) ) {
+    // invalid start
+    return false;
+  }
+
+  std::vector<xythetaEnvironment::Bounds> changedBounds;
+  if( !fromScratch ) {
+    _context.env.GetChangedObstacleBounds(_incrementalObstacles, changedBounds);
+
+    // the old keys were computed relative to the old start. Rather than re-keying the open list, bump all new
+    // keys by the amount the heuristic could have dropped (see D* Lite paper)
+    _km += heur_fromStart( newStart.GetStateID() );
+  }
+
+  _start = newStart;
+  _startID = newStart.GetStateID();
+
+  if( !fromScratch ) {
+    _plan.Clear();
+    _expansions = 0;
+    _considerations = 0;
+    _collisionChecks = 0;
+    _finalCost = 0.0f;
+    _reusedStates = (unsigned int)_table.size();
+
+    if( ! RepairChangedObstacles_Incremental(changedBounds) ) {
+      PRINT_NAMED_INFO("xythetaPlanner.DStarLite.RepairTooLarge",
+                       "%zu obstacle changes touch too many states, planning from scratch",
+                       changedBounds.size());
+      fromScratch = true;
+    }
+  }
+
+  if( fromScratch ) {
+    Reset_Incremental();
+  }
+
+  // polygons aren't assignable, so copy construct the snapshot and move it in
+  _incrementalObstacles = xythetaEnvironment::ObstaclesPerAngle( _context.env.GetObstacles() );
+
+  const bool searchComplete = ComputeShortestPath_Incremental(maxExpansions);
+
+  // the tree is consistent (or still has its inconsistent states in the open list), so the next call can
+  // continue from here even if this one ran out of expansions
+  _incrementalSearchValid = true;
+
+  bool foundPlan = false;
+  if( searchComplete ) {
+    foundPlan = BuildPlan_Incremental();
+  }
+
+  if( foundPlan ) {
+    PRINT_NAMED_INFO("xythetaPlanner.DStarLite.Complete",
+                     "reached goal %d at state %u, cost = %f after %d expansions (%u reused states, fromScratch = %d)",
+                     (int)_chosenGoalID,
+                     (u32)_chosenGoalStateID,
+                     _finalCost,
+                     _expansions,
+                     _reusedStates,
+                     fromScratch);
+  }
+  else if( searchComplete ) {
+    PRINT_NAMED_INFO("xythetaPlanner.NoPlanFound", "");
+  }
+
+  return foundPlan;
+}
+
+void xythetaPlannerImpl::Reset_Incremental()
+{
+  Reset_New();
+
+  _km = 0.0f;
+
+  for(const auto& goalPair : _goalStateIDs) {
+    const StateID goalID = goalPair.second;
+    StateEntry& entry = _table.emplace(goalID, _open.nullIterator(), goalID, 0, 0.0f, kInfiniteCost);
+    entry.rhs_ = 0.0f;
+    UpdateState_Incremental(goalID, entry);
+  }
+}
+
+bool xythetaPlannerImpl::ComputeShortestPath_Incremental(unsigned int maxExpansions)
+{
+  while( !_open.empty() ) {
+
+    if( _runPlan && !*_runPlan ) {
+      return false;
+    }
+
+    // stop once the start is consistent and nothing left in the open list could still lower its value. Ties
+    // are processed as well, since the open list only orders by the first D* Lite key
+    const StateEntry* startEntry = _table.find(_startID);
+    if( startEntry != nullptr &&
+        startEntry->g_ == startEntry->rhs_ &&
+        _open.topF() > GetKey_Incremental(_startID, *startEntry) ) {
+      break;
+    }
+
+    if( _expansions >= maxExpansions ) {
+      PRINT_NAMED_WARNING("xythetaPlanner.ExceededMaxExpansions", "exceeded max expansions of %u, stopping", maxExpansions);
+      return false;
+    }
+
+    const StateID currID = _open.top();
+    const Cost oldKey = _open.topF();
+
+    // NOTE: inserting predecessors may grow the table, so entries are looked up again after each insertion
+    StateEntry* currEntry = _table.find(currID);
+    assert(currEntry != nullptr);
+
+    const Cost newKey = GetKey_Incremental(currID, *currEntry);
+    if( oldKey < newKey ) {
+      // key is out of date because the start moved since it was inserted
+      _open.updateKey(currEntry->openIt_, newKey);
+      continue;
+    }
+
+    _expansions++;
+
+    if( currEntry->g_ > currEntry->rhs_ ) {
+      // overconsistent, so the state's value is final. Propagate it to all predecessors
+      const Cost currG = currEntry->rhs_;
+      currEntry->g_ = currG;
+      _open.pop();
+      currEntry->openIt_ = _open.nullIterator();
+
+      // start the iterator at 0 so it returns exactly the same action costs as the forward iterator does
+      SuccessorIterator it(&_context.env, currID, 0.0f, true);
+      it.Next( _context.env );
+      while( !it.Done( _context.env ) ) {
+        #if PRINT_DEBUG_PLANNER_STATS
+          ++_considerations;
+        #endif
+
+        const StateID predID = it.Front().stateID;
+        if( !IsGoalState(predID) ) {
+          const Cost newRhs = GetActionCost_Incremental(predID, it.Front()) + currG;
+
+          StateEntry* predEntry = _table.find(predID);
+          if( predEntry == nullptr ) {
+            predEntry = &_table.emplace(predID, _open.nullIterator(), predID, 0, 0.0f, kInfiniteCost);
+          }
+          if( newRhs < predEntry->rhs_ ) {
+            predEntry->rhs_ = newRhs;
+            UpdateState_Incremental(predID, *predEntry);
+          }
+        }
+
+        it.Next( _context.env );
+      }
+    }
+    else {
+      // underconsistent, so the state (and anything that relied on it) needs to be recomputed
+      currEntry->g_ = kInfiniteCost;
+      if( !IsGoalState(currID) ) {
+        currEntry->rhs_ = ComputeRhs_Incremental(currID);
+      }
+      UpdateState_Incremental(currID, *currEntry);
+
+      SuccessorIterator it(&_context.env, currID, 0.0f, true);
+      it.Next( _context.env );
+      while( !it.Done( _context.env ) ) {
+        const StateID predID = it.Front().stateID;
+        StateEntry* predEntry = _table.find(predID);
+        if( predEntry != nullptr && !IsGoalState(predID) ) {
+          predEntry->rhs_ = ComputeRhs_Incremental(predID);
+          UpdateState_Incremental(predID, *predEntry);
+        }
+
+        it.Next( _context.env );
+      }
+    }
+  }
+
+  return true;
+}
+
+Cost xythetaPlannerImpl::ComputeRhs_Incremental(StateID sid) const
+{
+  Cost rhs = kInfiniteCost;
+
+  SuccessorIterator it(&_context.env, sid, 0.0f, false);
+  it.Next( _context.env );
+  while( !it.Done( _context.env ) ) {
+    const StateEntry* succEntry = _table.find(it.Front().stateID);
+    if( succEntry != nullptr ) {
+      const Cost c = GetActionCost_Incremental(sid, it.Front()) + succEntry->g_;
+      if( c < rhs ) {
+        rhs = c;
+      }
+    }
+    it.Next( _context.env );
+  }
+
+  return rhs;
+}
+
+void xythetaPlannerImpl::UpdateState_Incremental(StateID sid, StateEntry& entry)
+{
+  const bool isOpen = entry.openIt_ != _open.nullIterator();
+
+  if( entry.g_ != entry.rhs_ ) {
+    const Cost key = GetKey_Incremental(sid, entry);
+    if( isOpen ) {
+      _open.updateKey(entry.openIt_, key);
+    }
+    else {
+      entry.openIt_ = _open.insert(sid, key);
+    }
+  }
+  else if( isOpen ) {
+    _open.remove(entry.openIt_);
+    entry.openIt_ = _open.nullIterator();
+  }
+}
+
+bool xythetaPlannerImpl::RepairChangedObstacles_Incremental(const std::vector<xythetaEnvironment::Bounds>& changedBounds)
+{
+  if( changedBounds.empty() ) {
+    return true;
+  }
+
+  // an action starting at a state can be affected by an obstacle anywhere within the primitive's extent, so
+  // grow each changed area by that much to find all states with changed outgoing costs
+  float primMinX = 0.0f, primMaxX = 0.0f, primMinY = 0.0f, primMaxY = 0.0f;
+  for( const auto& primsForAngle : _context.env.GetActionSpace().GetForwardPrimTable() ) {
+    for( const auto& prim : primsForAngle ) {
+      primMinX = std::min(primMinX, prim.minX);
+      primMaxX = std::max(primMaxX, prim.maxX);
+      primMinY = std::min(primMinY, prim.minY);
+      primMaxY = std::max(primMaxY, prim.maxY);
+    }
+  }
+
+  const float res = GraphState::resolution_mm_;
+
+  struct CellRange { int minX, maxX, minY, maxY; };
+  std::vector<CellRange> ranges;
+  ranges.reserve(changedBounds.size());
+
+  size_t numStates = 0;
+  for( const auto& bounds : changedBounds ) {
+    CellRange range;
+    range.minX = (int)std::ceil( (bounds.minX - primMaxX) / res );
+    range.maxX = (int)std::floor( (bounds.maxX - primMinX) / res );
+    range.minY = (int)std::ceil( (bounds.minY - primMaxY) / res );
+    range.maxY = (int)std::floor( (bounds.maxY - primMinY) / res );
+
+    // every theta is visited for each cell, so the same obstacle showing up at multiple angles (which is
+    // typical) only needs to be handled once
+    const bool alreadyCovered = std::any_of(ranges.begin(), ranges.end(), [&range](const CellRange& other) {
+        return other.minX <= range.minX && other.maxX >= range.maxX &&
+               other.minY <= range.minY && other.maxY >= range.maxY;
+      });
+    if( !alreadyCovered ) {
+      numStates += (size_t)(range.maxX - range.minX + 1) * (range.maxY - range.minY + 1) * GraphState::numAngles_;
+      ranges.push_back(range);
+    }
+  }
+
+  if( numStates > std::max(_table.size(), (size_t)MAX_INCREMENTAL_REPAIR_STATES) ) {
+    return false;
+  }
+
+  for( const auto& range : ranges ) {
+    for( int x = range.minX; x <= range.maxX; ++x ) {
+      for( int y = range.minY; y <= range.maxY; ++y ) {
+        for( int theta = 0; theta < GraphState::numAngles_; ++theta ) {
+          const StateID sid = GraphState(x, y, theta).GetStateID();
+
+          // states that aren't in the table have no successors with a known cost, so their rhs is still infinite
+          StateEntry* entry = _table.find(sid);
+          if( entry != nullptr && !IsGoalState(sid) ) {
+            entry->rhs_ = ComputeRhs_Incremental(sid);
+            UpdateState_Incremental(sid, *entry);
+          }
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+bool xythetaPlannerImpl::BuildPlan_Incremental()
+{
+  const StateEntry* startEntry = _table.find(_startID);
+  if( startEntry == nullptr || startEntry->g_ == kInfiniteCost ) {
+    return false;
+  }
+
+  _finalCost = startEntry->g_;
+
+  // follow the cheapest action from each state. Every state on the way is consistent, so this gives the same
+  // path a forward search would have found
+  StateID curr = _startID;
+  BOUNDED_WHILE(1000, !IsGoalState(curr)) {
+    Cost bestCost = kInfiniteCost;
+    SuccessorIterator::Successor best{};
+
+    SuccessorIterator it(&_context.env, curr, 0.0f, false);
+    it.Next( _context.env );
+    while( !it.Done( _context.env ) ) {
+      const StateEntry* succEntry = _table.find(it.Front().stateID);
+      if( succEntry != nullptr ) {
+        const Cost c = GetActionCost_Incremental(curr, it.Front()) + succEntry->g_;
+        // prefer goals on ties so free turns at the goal can't send us in circles
+        if( c < bestCost || ( c == bestCost && IsGoalState(it.Front().stateID) ) ) {
+          bestCost = c;
+          best = it.Front();
+        }
+      }
+      it.Next( _context.env );
+    }
+
+    if( bestCost == kInfiniteCost ) {
+      PRINT_NAMED_ERROR("xythetaPlanner.BuildPlan_Incremental.DeadEnd", "no successor of state %u leads to a goal", (u32)curr);
+      _plan.Clear();
+      return false;
+    }
+
+    _plan.Push(best.actionID, best.penalty);
+    curr = best.stateID;
+  }
+
+  if( !IsGoalState(curr) ) {
+    PRINT_NAMED_ERROR("xythetaPlanner.BuildPlan_Incremental.TooLong", "plan did not reach a goal");
+    _plan.Clear();
+    return false;
+  }
+
+  _chosenGoalID = _goalState2GoalID.find(curr)->second;
+  _chosenGoalStateID = curr;
+  _plan.start_ = _start;
+
+  PRINT_NAMED_INFO("xythetaPlanner.BuildPlan", "Created plan of length %zu", _plan.Size());
+
+  return true;
+}
+
+inline Cost xythetaPlannerImpl::GetActionCost_Incremental(StateID sid, const SuccessorIterator::Successor& succ) const
+{
+  // mirror the forward search: actions taken from the goal position are free if we allow turning there
+  if(_context.allowFreeTurnInPlaceAtGoal) {
+    for(const auto& goalPair : _goalStateIDs) {
+      if ((sid.s.x == goalPair.second.s.x) && (sid.s.y == goalPair.second.s.y)) {
+        return 0.0f;
+      }
+    }
+  }
+
+  return succ.g;
+}
+
+inline Cost xythetaPlannerImpl::heur_fromStart(StateID sid) const
+{
+  const Point2f d = GraphState(sid).GetPointXY_mm() - _start.GetPointXY_mm();
+  return d.Length() * _context.env.GetActionSpace().GetOneOverMaxVelocity();
+}
+
+inline Cost xythetaPlannerImpl::GetKey_Incremental(StateID sid, const StateEntry& entry) const
+{
+  return std::min(entry.g_, entry.rhs_) + heur_fromStart(sid) + _km;
 }
 
 void xythetaPlannerImpl::GetTestPlan(xythetaPlan& plan)
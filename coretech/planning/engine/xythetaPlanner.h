@@ -73,6 +73,10 @@ public:
   int GetLastNumExpansions() const;
   int GetLastNumConsiderations() const;
 
+  // number of states whose search values were carried over from the previous plan by the incremental search
+  // (always 0 when planning from scratch)
+  int GetLastNumReusedStates() const;
+
 private:
   xythetaPlannerImpl* _impl;
 
@@ -33,6 +33,7 @@ void xythetaPlannerContext::Reset()
   start = State_c{ 0.0f, 0.0f, 0.0f };
   allowFreeTurnInPlaceAtGoal = false;
   forceReplanFromScratch = false;
+  useIncrementalSearch = false;
   env.ClearObstacles();
 }
 
@@ -58,6 +59,7 @@ bool xythetaPlannerContext::Import(const Json::Value& config)
 
     allowFreeTurnInPlaceAtGoal = config["free_turn_at_goal"].asBool();
     forceReplanFromScratch = config["force_replan"].asBool();
+    useIncrementalSearch = config["incremental"].asBool();
   }
   catch( const std::exception&  e ) {
     PRINT_NAMED_ERROR("xythetaPlannerContext.Import.Exception",
@@ -89,6 +91,7 @@ void xythetaPlannerContext::Dump(Util::JsonWriter& writer) const
 
   writer.AddEntry("free_turn_at_goal", (int)allowFreeTurnInPlaceAtGoal);
   writer.AddEntry("force_replan", (int)forceReplanFromScratch);
+  writer.AddEntry("incremental", (int)useIncrementalSearch);
 }
 
 }
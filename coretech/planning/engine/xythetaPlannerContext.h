@@ -54,6 +54,10 @@ struct xythetaPlannerContext : private Util::noncopyable
 
   // If true, then the next time we plan, we should do it from scratch instead of allowing replanning
   bool forceReplanFromScratch;
+
+  // If true, the planner keeps its search tree between replans and only repairs the part of it affected by
+  // obstacle and start changes (D* Lite). Goal changes still cause a search from scratch
+  bool useIncrementalSearch;
 };
 
 }
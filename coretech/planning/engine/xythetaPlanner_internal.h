@@ -15,7 +15,6 @@
 
 #include "openList.h"
 #include "stateTable.h"
-#include "plannerStates.h"
 #include <unordered_map>
 
 namespace Anki
@@ -36,12 +35,16 @@ struct xythetaPlannerImpl
   bool ComputePath(unsigned int maxExpansions, volatile bool* runPlan);
   bool AStar(unsigned int maxExpansions, volatile bool* runPlan);
 
+  // Incremental search (D* Lite). Searches backwards from the goals, so the search tree stays valid when the
+  // start moves, and only repairs the states affected by obstacle changes since the last call
+  bool DStarLite(unsigned int maxExpansions, volatile bool* runPlan);
+
   // helper functions
   void Reset();
   void Reset_New();
 
   void ExpandState(StateID sid);
-  void ExpandState_New(const PlannerState& currState);
+  void ExpandState_New(StateID currID, Cost currG);
 
   // this one takes the map an penalties into account
   Cost heur(StateID sid);
@@ -57,7 +60,39 @@ struct xythetaPlannerImpl
   bool InitializeHeuristic();
 
   void BuildPlan();
-  void BuildPlan_New(const PlannerState& goal);
+  void BuildPlan_New(StateID goalID);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  // incremental search helpers. In these, g_ is the cost from the state to the closest goal
+  ////////////////////////////////////////////////////////////////////////////////
+
+  // seeds the search from all goals
+  void Reset_Incremental();
+
+  // processes inconsistent states until the start is consistent. Returns false if the search was stopped early
+  bool ComputeShortestPath_Incremental(unsigned int maxExpansions);
+
+  // one step lookahead over the successors of sid, using their current g values
+  Cost ComputeRhs_Incremental(StateID sid) const;
+
+  // puts the state in the open list with the correct key if it is inconsistent, or takes it out if not
+  void UpdateState_Incremental(StateID sid, StateEntry& entry);
+
+  // recomputes rhs for every known state whose outgoing actions may pass through one of the bounds. Returns
+  // false if the area is so large that searching from scratch would be cheaper
+  bool RepairChangedObstacles_Incremental(const std::vector<xythetaEnvironment::Bounds>& changedBounds);
+
+  // follows the cheapest successors from the start to a goal. Returns false if there is no path
+  bool BuildPlan_Incremental();
+
+  // cost of the action from sid which resulted in succ (which must come from a forward SuccessorIterator
+  // started with g = 0), taking free turns at the goal into account
+  Cost GetActionCost_Incremental(StateID sid, const SuccessorIterator::Successor& succ) const;
+
+  // euclidean heuristic from the start to sid, used (with _km) for the incremental open list keys
+  Cost heur_fromStart(StateID sid) const;
+
+  Cost GetKey_Incremental(StateID sid, const StateEntry& entry) const;
 
   // checks if we need to replan from scratch
   bool NeedsReplan() const;
@@ -85,10 +120,7 @@ struct xythetaPlannerImpl
   bool CheckGoal(const GoalState_cPair& goal, StateID& goalStateID, State_c& roundedGoal_c) const;
   
   // check if the candidate state is a goal state when expanding graph
-  bool IsGoalState(const PlannerState& candidate);
-  
-  // check if the state has already been added to the closed list
-  bool IsClosedState(StateID state);
+  bool IsGoalState(StateID candidate) const;
   
   // Checks all goals, returns true if any goals are valid. Adds a map element to the arguments if the goal is valid.
   // If false is returned, may have set or not set any of the return arguments. 
@@ -116,9 +148,6 @@ struct xythetaPlannerImpl
   OpenList _open;
   StateTable _table;
   
-  OpenList2 _open2;
-  ClosedList _closed;
-  
   bool _goalsChanged; // any goal changed
   
   xythetaPlan _plan;
@@ -137,6 +166,13 @@ struct xythetaPlannerImpl
 
   double _lastPlanTime;
 
+  // incremental search state which is kept between replans. _km accumulates the heuristic change due to start
+  // moves so that keys already in the open list stay valid lower bounds
+  bool _incrementalSearchValid;
+  Cost _km;
+  xythetaEnvironment::ObstaclesPerAngle _incrementalObstacles;
+  unsigned int _reusedStates;
+
   // assuming that goal is in soft collision, this function will do a breadth-first expansion until we
   // "escape" from the soft penalty. It will add these penalties to a heuristic map, so the heuristic can take
   // these soft penalties into account. It works backwards, for the case when goalStateID is the goal
@@ -1,11 +1,13 @@
 #include "util/helpers/includeGTest.h" // Used in place of gTest/gTest.h directly to suppress warnings in the header
 #include "util/logging/logging.h"
+#include <fstream>
 #include <set>
 #include <vector>
 
 #define private public
 #define protected public
 
+#include "coretech/common/engine/math/convexPolygon2d.h"
 #include "coretech/common/engine/math/rotatedRect.h"
 #include "coretech/planning/engine/xythetaEnvironment.h"
 #include "coretech/planning/engine/xythetaPlanner.h"
@@ -1093,3 +1095,482 @@ GTEST_TEST(TestPlanner, ZeroSizePathFilterBug)
   EXPECT_GT(path.GetNumSegments(), 0) << "path should not be empty";
 }
 
+GTEST_TEST(TestPlanner, OpenListDecreaseKey)
+{
+  OpenList open;
+
+  const u32 numStates = 200;
+  std::vector<OpenList::iterator> handles;
+  for(u32 i=0; i<numStates; ++i) {
+    // insert in a scrambled order
+    const float f = (float)((i * 37) % numStates) + 1000.0f;
+    handles.push_back( open.insert(StateID((u32)i), f) );
+  }
+
+  ASSERT_EQ(open.size(), numStates);
+
+  // lower every third key below all others, and remove a few others
+  for(u32 i=0; i<numStates; i+=3) {
+    open.decreaseKey(handles[i], (float)i);
+  }
+  open.remove(handles[1]);
+  open.remove(handles[numStates-1]);
+
+  EXPECT_FLOAT_EQ(open.fVal(StateID(3u)), 3.0f);
+  EXPECT_FALSE(open.contains(StateID(1u)));
+
+  float lastF = -1.0f;
+  unsigned int numPopped = 0;
+  while(!open.empty()) {
+    const float f = open.topF();
+    EXPECT_LE(lastF, f) << "open list popped out of order";
+    const StateID sid = open.pop();
+    if( f < 1000.0f ) {
+      EXPECT_EQ(sid.v, (u32)f) << "decreased key popped with wrong state";
+    }
+    lastF = f;
+    ++numPopped;
+  }
+
+  EXPECT_EQ(numPopped, numStates - 2u);
+
+  // handles are recycled after clearing
+  open.clear();
+  EXPECT_TRUE(open.empty());
+  EXPECT_EQ(open.insert(StateID(7u), 1.0f), 0u);
+}
+
+GTEST_TEST(TestPlanner, StateTableClearAndGrow)
+{
+  StateTable table;
+
+  // enough states to force the table to grow at least once
+  const u32 numStates = 20000;
+  for(int search=0; search<3; ++search) {
+    table.Clear();
+    EXPECT_EQ(table.size(), 0u);
+    for(u32 i=0; i<numStates; ++i) {
+      EXPECT_EQ(table.find(StateID(i * 16)), nullptr) << "state left over from previous search";
+      table.emplace(StateID(i * 16), OpenList::nullIterator(), StateID(i), 0, 0.0f, (Cost)(search + i));
+    }
+    EXPECT_EQ(table.size(), numStates);
+    for(u32 i=0; i<numStates; ++i) {
+      const StateEntry* entry = table.find(StateID(i * 16));
+      ASSERT_NE(entry, nullptr);
+      EXPECT_EQ(entry->backpointer_.v, i);
+      EXPECT_FLOAT_EQ(entry->g_, (Cost)(search + i));
+    }
+  }
+}
+
+// plans from scratch with a second planner using the same context, and returns the cost
+Cost PlanFromScratch(xythetaPlannerContext& context, bool incremental, int* numExpansions = nullptr)
+{
+  xythetaPlanner planner(context);
+  const bool oldIncremental = context.useIncrementalSearch;
+  context.useIncrementalSearch = incremental;
+  const bool ret = planner.Replan();
+  context.useIncrementalSearch = oldIncremental;
+  if( numExpansions != nullptr ) {
+    *numExpansions = planner.GetLastNumExpansions();
+  }
+  return ret ? planner.GetFinalCost() : -1.0f;
+}
+
+GTEST_TEST(TestPlanner, IncrementalReplanObstacleChanges)
+{
+  xythetaPlannerContext context;
+
+  EXPECT_TRUE(context.env.ReadMotionPrimitives((std::string(QUOTE(TEST_DATA_PATH)) + std::string(TEST_PRIM_FILE)).c_str()));
+  context.env.AddObstacleAllThetas(Anki::RotatedRectangle(500.0, -100.0, 530.0, -100.0, 200.0));
+
+  xythetaPlanner planner(context);
+
+  context.start = State_c(0, 0, 0);
+  context.goals_c = GoalState_cPairs{{0,{800, 0, 0}}};
+  context.useIncrementalSearch = true;
+
+  context.env.PrepareForPlanning();
+
+  ASSERT_TRUE(planner.Replan());
+  EXPECT_TRUE(context.env.PlanIsSafe(planner.GetPlan(), 0));
+  EXPECT_EQ(planner.GetLastNumReusedStates(), 0);
+  const Cost firstCost = planner.GetFinalCost();
+  EXPECT_NEAR(firstCost, PlanFromScratch(context, true), 1e-3);
+  EXPECT_LE(firstCost, PlanFromScratch(context, false) + 1e-3) << "A* shouldn't beat the incremental search";
+
+  // the search runs backwards from the goal, so changes close to the robot (which is where they are usually
+  // observed) are the cheapest to repair
+  context.env.AddObstacleAllThetas(Anki::RotatedRectangle(150.0, -150.0, 170.0, -150.0, 300.0));
+  context.env.PrepareForPlanning();
+
+  ASSERT_TRUE(planner.Replan());
+  EXPECT_TRUE(context.env.PlanIsSafe(planner.GetPlan(), 0));
+  EXPECT_TRUE(CheckPlanAsPathIsSafe(context, planner.GetPlan()));
+  EXPECT_GT(planner.GetLastNumReusedStates(), 0);
+  EXPECT_GT(planner.GetFinalCost(), firstCost);
+
+  int fromScratchExps = 0;
+  EXPECT_NEAR(planner.GetFinalCost(), PlanFromScratch(context, true, &fromScratchExps), 1e-3);
+  EXPECT_LE(planner.GetFinalCost(), PlanFromScratch(context, false) + 1e-3);
+  EXPECT_LT(planner.GetLastNumExpansions(), fromScratchExps) << "repair should be cheaper than a new search";
+
+  // remove it again, which should bring back the original plan
+  context.env.ClearObstacles();
+  context.env.AddObstacleAllThetas(Anki::RotatedRectangle(500.0, -100.0, 530.0, -100.0, 200.0));
+  context.env.PrepareForPlanning();
+
+  ASSERT_TRUE(planner.Replan());
+  EXPECT_TRUE(context.env.PlanIsSafe(planner.GetPlan(), 0));
+  EXPECT_GT(planner.GetLastNumReusedStates(), 0);
+  EXPECT_NEAR(planner.GetFinalCost(), firstCost, 1e-3);
+}
+
+GTEST_TEST(TestPlanner, IncrementalReplanStartMoves)
+{
+  xythetaPlannerContext context;
+
+  EXPECT_TRUE(context.env.ReadMotionPrimitives((std::string(QUOTE(TEST_DATA_PATH)) + std::string(TEST_PRIM_FILE)).c_str()));
+  context.env.AddObstacleAllThetas(Anki::RotatedRectangle(200.0, -10.0, 230.0, -10.0, 20.0));
+
+  xythetaPlanner planner(context);
+
+  context.start = State_c(0, 0, 0);
+  context.goals_c = GoalState_cPairs{{0,{500, 0, 0}}};
+  context.useIncrementalSearch = true;
+
+  context.env.PrepareForPlanning();
+
+  ASSERT_TRUE(planner.Replan());
+  const int fromScratchExps = planner.GetLastNumExpansions();
+
+  // drive along the plan, replanning after each action like the robot would
+  for(int i=0; i<3 && planner.GetPlan().Size() > 1; ++i) {
+    State_c start = context.env.State2State_c(planner.GetPlan().start_);
+    context.env.GetActionSpace().ApplyAction(planner.GetPlan().GetAction(0), start);
+    context.start = start;
+
+    ASSERT_TRUE(planner.Replan());
+    EXPECT_TRUE(context.env.PlanIsSafe(planner.GetPlan(), 0));
+    EXPECT_GT(planner.GetLastNumReusedStates(), 0);
+    EXPECT_LT(planner.GetLastNumExpansions(), fromScratchExps);
+    EXPECT_NEAR(planner.GetFinalCost(), PlanFromScratch(context, true), 1e-3);
+  }
+
+  // new goals can't reuse anything
+  context.goals_c = GoalState_cPairs{{0,{500, 100, 0}}};
+  ASSERT_TRUE(planner.Replan());
+  EXPECT_EQ(planner.GetLastNumReusedStates(), 0);
+}
+
+// Reads a context saved by xythetaPlannerContext::Dump (see planning/tools). Its obstacles were expanded for the
+// robot's footprint at each angle, so they differ per angle
+void ImportSavedContext(xythetaPlannerContext& context, const std::string& mprimFile, const std::string& contextFile)
+{
+  ASSERT_TRUE(context.env.ReadMotionPrimitives((std::string(QUOTE(TEST_DATA_PATH)) + mprimFile).c_str()));
+
+  Json::Reader jsonReader;
+  Json::Value contextJson;
+  std::ifstream contextStream(std::string(QUOTE(TEST_DATA_PATH)) + contextFile);
+  ASSERT_TRUE(jsonReader.parse(contextStream, contextJson)) << "could not read context " << contextFile;
+  ASSERT_TRUE(context.Import(contextJson));
+}
+
+const char* const kEnvMprimFile = "/planning/tools/env/mprim.json";
+
+GTEST_TEST(TestPlanner, IncrementalReplanPerAngleObstacles)
+{
+  // repairs push costs backwards from the goal, so they must match the costs of the same actions searching
+  // forwards. With different obstacles at each angle, that means checking each point of a turn against its own
+  // angle in both directions
+  xythetaPlannerContext context;
+  ASSERT_NO_FATAL_FAILURE(ImportSavedContext(context, kEnvMprimFile,
+                                             "/planning/tools/env/context/drive_around_multiblock.json"));
+  context.forceReplanFromScratch = false;
+  context.useIncrementalSearch = true;
+  context.env.PrepareForPlanning();
+
+  xythetaPlanner planner(context);
+
+  ASSERT_TRUE(planner.Replan());
+  EXPECT_TRUE(context.env.PlanIsSafe(planner.GetPlan(), 0));
+  EXPECT_NEAR(planner.GetFinalCost(), PlanFromScratch(context, true), 1e-3);
+  EXPECT_LE(planner.GetFinalCost(), PlanFromScratch(context, false) + 1e-3) << "A* shouldn't beat the incremental search";
+
+  // block the plan with a box where it is farthest from both the start and the goal, expanded for the robot at
+  // each angle
+  const ActionSpace& actions = context.env.GetActionSpace();
+  const Anki::Point2f startPt(context.start.x_mm, context.start.y_mm);
+  const Anki::Point2f goalPt(context.goals_c[0].second.x_mm, context.goals_c[0].second.y_mm);
+  GraphState curr = planner.GetPlan().start_;
+  Anki::Point2f middle = startPt;
+  float middleDist = 0.0f;
+  for(size_t i=0; i<planner.GetPlan().Size(); ++i) {
+    actions.ApplyAction(planner.GetPlan().GetAction(i), curr);
+    const Anki::Point2f pt = curr.GetPointXY_mm();
+    const float dist = std::min((pt - startPt).Length(), (pt - goalPt).Length());
+    if( dist > middleDist ) {
+      middle = pt;
+      middleDist = dist;
+    }
+  }
+  const Anki::ConvexPolygon box(Anki::Poly2f(Anki::RotatedRectangle(middle.x() - 10.0f, middle.y() - 10.0f,
+                                                                    middle.x() + 10.0f, middle.y() - 10.0f,
+                                                                    20.0f)));
+  for(GraphTheta theta = 0; theta < GraphState::numAngles_; ++theta) {
+    const float c = cosf(actions.LookupTheta(theta));
+    const float s = sinf(actions.LookupTheta(theta));
+    auto footprint = [c, s](float x, float y) { return Anki::Point2f(x*c - y*s, x*s + y*c); };
+    const Anki::ConvexPolygon robot(Anki::Poly2f{footprint(-30.0f, -25.0f), footprint(-30.0f, 25.0f),
+                                                 footprint(60.0f, 25.0f), footprint(60.0f, -25.0f)});
+    context.env.AddObstacleWithExpansion(box, robot, theta);
+  }
+  context.env.PrepareForPlanning();
+
+  ASSERT_TRUE(planner.Replan());
+  EXPECT_TRUE(context.env.PlanIsSafe(planner.GetPlan(), 0));
+  EXPECT_GT(planner.GetLastNumReusedStates(), 0);
+  EXPECT_NEAR(planner.GetFinalCost(), PlanFromScratch(context, true), 1e-3);
+  EXPECT_LE(planner.GetFinalCost(), PlanFromScratch(context, false) + 1e-3) << "A* shouldn't beat the incremental search";
+
+  // drive along the new plan, replanning after each action
+  for(int i=0; i<3 && planner.GetPlan().Size() > 1; ++i) {
+    State_c start = context.env.State2State_c(planner.GetPlan().start_);
+    actions.ApplyAction(planner.GetPlan().GetAction(0), start);
+    context.start = start;
+
+    ASSERT_TRUE(planner.Replan());
+    EXPECT_TRUE(context.env.PlanIsSafe(planner.GetPlan(), 0));
+    EXPECT_GT(planner.GetLastNumReusedStates(), 0);
+    EXPECT_NEAR(planner.GetFinalCost(), PlanFromScratch(context, true), 1e-3);
+  EXPECT_LE(planner.GetFinalCost(), PlanFromScratch(context, false) + 1e-3) << "A* shouldn't beat the incremental search";
+  }
+}
+
+GTEST_TEST(TestPlanner, CollisionBitmapIsConservative)
+{
+  xythetaPlannerContext context;
+
+  ASSERT_TRUE(context.env.ReadMotionPrimitives((std::string(QUOTE(TEST_DATA_PATH)) + "/planning/tools/env/mprim.json").c_str()));
+
+  Json::Reader jsonReader;
+  Json::Value contextJson;
+  std::ifstream contextStream(std::string(QUOTE(TEST_DATA_PATH)) + "/planning/tools/env/context/drive_around_multiblock.json");
+  ASSERT_TRUE(jsonReader.parse(contextStream, contextJson));
+  ASSERT_TRUE(context.Import(contextJson));
+
+  // soft obstacles need to be in the bitmap too
+  context.env.AddObstacleAllThetas(Anki::RotatedRectangle(-100.0, -50.0, -20.0, -37.0, 45.0), 5.0f);
+
+  EXPECT_FALSE(context.env.collisionBitmap_.IsValid());
+  context.env.PrepareForPlanning();
+  ASSERT_TRUE(context.env.collisionBitmap_.IsValid());
+
+  const auto& obstacles = context.env.GetObstacles();
+  auto exactCheck = [&obstacles](GraphTheta theta, float x, float y) {
+    for( const auto& obs : obstacles[theta] ) {
+      if( obs.first.Contains(x, y) ) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  // any point inside an obstacle must be in an occupied cell
+  srand(1234);
+  int numInside = 0;
+  for(int i=0; i<100000; ++i) {
+    const float x = -300.0f + 1200.0f * (rand() / (float)RAND_MAX);
+    const float y = -600.0f + 1200.0f * (rand() / (float)RAND_MAX);
+    const GraphTheta theta = rand() % GraphState::numAngles_;
+    if( exactCheck(theta, x, y) ) {
+      ++numInside;
+      EXPECT_TRUE(context.env.collisionBitmap_.IsOccupied(theta, CollisionBitmap::GetCell(x), CollisionBitmap::GetCell(y)))
+        << "missed obstacle at (" << x << ", " << y << ") theta " << (int)theta;
+    }
+  }
+  EXPECT_GT(numInside, 0) << "test didn't sample any obstacles";
+
+  // and any action which touches an obstacle must be caught by the swept cells
+  const ActionSpace& actions = context.env.GetActionSpace();
+  int numActionsTouching = 0;
+  for(int x = -30; x < 90; x += 3) {
+    for(int y = -60; y < 60; y += 3) {
+      for(GraphTheta theta = 0; theta < GraphState::numAngles_; ++theta) {
+        const GraphState start(x, y, theta);
+        const State_c start_c = context.env.State2State_c(start);
+        for(ActionID action = 0; action < actions.GetNumActions(); ++action) {
+          const MotionPrimitive& prim = actions.GetForwardMotion(theta, action);
+          // straight actions may be checked against the starting angle, others only use the nearest angle
+          const bool isStraight = ( prim.endStateOffset.theta == prim.startTheta );
+          bool touches = false;
+          for( const auto& pt : prim.intermediatePositions ) {
+            const float ptX = start_c.x_mm + pt.position.x_mm;
+            const float ptY = start_c.y_mm + pt.position.y_mm;
+            touches = touches || exactCheck(pt.nearestTheta, ptX, ptY) || ( isStraight && exactCheck(prim.startTheta, ptX, ptY) );
+          }
+          if( touches ) {
+            ++numActionsTouching;
+            EXPECT_TRUE(context.env.collisionBitmap_.AnyOccupied(prim, x, y));
+          }
+        }
+      }
+    }
+  }
+  EXPECT_GT(numActionsTouching, 0) << "test didn't sample any actions near obstacles";
+
+  // successors and predecessors skip the exact checks when the bitmap says they can, so they must come out the
+  // same without it. Going backwards, that only holds if each predecessor is checked like its forward action
+  auto getSuccessors = [&context](const GraphState& state, bool reverse) {
+    std::vector<SuccessorIterator::Successor> succs;
+    SuccessorIterator it(&context.env, state.GetStateID(), 0.0f, reverse);
+    it.Next(context.env);
+    while( !it.Done(context.env) ) {
+      succs.push_back(it.Front());
+      it.Next(context.env);
+    }
+    return succs;
+  };
+
+  std::vector<std::vector<SuccessorIterator::Successor>> succsWithBitmap;
+  for(int x = -30; x < 90; x += 3) {
+    for(int y = -60; y < 60; y += 3) {
+      for(GraphTheta theta = 0; theta < GraphState::numAngles_; ++theta) {
+        succsWithBitmap.push_back(getSuccessors(GraphState(x, y, theta), false));
+        succsWithBitmap.push_back(getSuccessors(GraphState(x, y, theta), true));
+      }
+    }
+  }
+
+  context.env.collisionBitmap_.Clear();
+  size_t succsIdx = 0;
+  int numReverseTouching = 0;
+  for(int x = -30; x < 90; x += 3) {
+    for(int y = -60; y < 60; y += 3) {
+      for(GraphTheta theta = 0; theta < GraphState::numAngles_; ++theta) {
+        for(bool reverse : {false, true}) {
+          const auto& withBitmap = succsWithBitmap[succsIdx++];
+          const auto exact = getSuccessors(GraphState(x, y, theta), reverse);
+          ASSERT_EQ(exact.size(), withBitmap.size())
+            << "(" << x << ", " << y << ", " << (int)theta << ")" << (reverse ? " reverse" : "");
+          for(size_t i=0; i<exact.size(); ++i) {
+            EXPECT_EQ(exact[i].stateID.v, withBitmap[i].stateID.v);
+            EXPECT_EQ(exact[i].actionID, withBitmap[i].actionID);
+            EXPECT_FLOAT_EQ(exact[i].g, withBitmap[i].g);
+            if( reverse && exact[i].penalty > 0.0f ) {
+              ++numReverseTouching;
+            }
+          }
+        }
+      }
+    }
+  }
+  EXPECT_GT(numReverseTouching, 0) << "test didn't sample any predecessors near obstacles";
+
+  // changing obstacles invalidates the bitmap until the next PrepareForPlanning
+  context.env.AddObstacleAllThetas(Anki::RotatedRectangle(500.0, -10.0, 530.0, -10.0, 20.0));
+  EXPECT_FALSE(context.env.collisionBitmap_.IsValid());
+}
+
+GTEST_TEST(TestPlanner, CollisionBitmapSamePlan)
+{
+  xythetaPlannerContext context;
+
+  ASSERT_TRUE(context.env.ReadMotionPrimitives((std::string(QUOTE(TEST_DATA_PATH)) + "/planning/tools/env/mprim.json").c_str()));
+
+  Json::Reader jsonReader;
+  Json::Value contextJson;
+  std::ifstream contextStream(std::string(QUOTE(TEST_DATA_PATH)) + "/planning/tools/env/context/escape_3block.json");
+  ASSERT_TRUE(jsonReader.parse(contextStream, contextJson));
+  ASSERT_TRUE(context.Import(contextJson));
+
+  context.env.PrepareForPlanning();
+
+  xythetaPlanner planner(context);
+  context.forceReplanFromScratch = true;
+  ASSERT_TRUE(planner.Replan());
+  const Cost costWithBitmap = planner.GetFinalCost();
+  const int expsWithBitmap = planner.GetLastNumExpansions();
+  const xythetaPlan planWithBitmap = planner.GetPlan();
+  EXPECT_TRUE(context.env.PlanIsSafe(planWithBitmap, 0));
+
+  // fall back to the exact checks for everything
+  context.env.collisionBitmap_.Clear();
+  ASSERT_TRUE(planner.Replan());
+  EXPECT_FLOAT_EQ(planner.GetFinalCost(), costWithBitmap);
+  EXPECT_EQ(planner.GetLastNumExpansions(), expsWithBitmap);
+  ASSERT_EQ(planner.GetPlan().Size(), planWithBitmap.Size());
+  for(size_t i=0; i<planWithBitmap.Size(); ++i) {
+    EXPECT_EQ(planner.GetPlan().GetAction(i), planWithBitmap.GetAction(i));
+    EXPECT_FLOAT_EQ(planner.GetPlan().GetPenalty(i), planWithBitmap.GetPenalty(i));
+  }
+}
+
+// Plans from scratch in a saved context a few times. Every run must find the same safe plan, since nothing left
+// over from the last search may change the next one. If reportRate is set, prints the expansion rate
+void RunSavedContext(const std::string& mprimFile, const std::string& contextFile, int numRuns, bool reportRate)
+{
+  xythetaPlannerContext context;
+  ASSERT_NO_FATAL_FAILURE(ImportSavedContext(context, mprimFile, contextFile));
+
+  context.env.PrepareForPlanning();
+
+  xythetaPlanner planner(context);
+
+  ASSERT_TRUE(planner.GoalsAreValid());
+  ASSERT_TRUE(planner.StartIsValid());
+
+  unsigned int totalExps = 0;
+  double totalTime = 0.0;
+  for(int run=0; run<numRuns; ++run) {
+    context.forceReplanFromScratch = true;
+    ASSERT_TRUE(planner.Replan()) << contextFile << " run " << run;
+    EXPECT_TRUE(context.env.PlanIsSafe(planner.GetPlan(), 0));
+
+    if( run > 0 ) {
+      EXPECT_EQ(planner.GetLastNumExpansions(), totalExps / run) << contextFile << " run " << run;
+    }
+
+    totalExps += planner.GetLastNumExpansions();
+    totalTime += planner.GetLastPlanTime();
+  }
+
+  if( reportRate ) {
+    printf("%-60s %8u exps in %8.5f sec = %10.0f exps/sec (cost %f)\n",
+           contextFile.c_str(),
+           totalExps / numRuns,
+           totalTime / numRuns,
+           totalExps / totalTime,
+           planner.GetFinalCost());
+  }
+}
+
+const char* const kEnvContextFiles[] = {
+  "/planning/tools/env/context/simple_empty.json",
+  "/planning/tools/env/context/long_empty.json",
+  "/planning/tools/env/context/simple_1block.json",
+  "/planning/tools/env/context/escape_3block.json",
+  "/planning/tools/env/context/drive_around_multiblock.json",
+  "/planning/tools/env/context/goal_in_block.json",
+};
+
+GTEST_TEST(TestPlanner, SavedContextsReplanFromScratch)
+{
+  for(const char* contextFile : kEnvContextFiles) {
+    RunSavedContext(kEnvMprimFile, contextFile, 2, false);
+  }
+}
+
+// These aren't really unit tests, they report how fast the planner expands states. Run them with
+// --gtest_also_run_disabled_tests --gtest_filter=TestPlanner.DISABLED_BenchmarkExpansionsPerSecond*
+GTEST_TEST(TestPlanner, DISABLED_BenchmarkExpansionsPerSecond_env)
+{
+  for(const char* contextFile : kEnvContextFiles) {
+    RunSavedContext(kEnvMprimFile, contextFile, 3, true);
+  }
+}
+
+GTEST_TEST(TestPlanner, DISABLED_BenchmarkExpansionsPerSecond_maze)
+{
+  RunSavedContext("/planning/tools/maze_env/mprim.json", "/planning/tools/maze_env/context_1.json", 3, true);
+}
@@ -10,6 +10,8 @@
 #include "debayer/neon/raw10.h"
 #endif
 
+#include "debayer/x86/raw10.h"
+
 namespace Anki {
 namespace Vision {
 
@@ -77,6 +79,27 @@ Debayer::Debayer()
     SetOp(Layout::RAW10, Pattern::RGGB, Method::PERCEPTION, Scale::QUARTER, OutputFormat::Y8,    op);
     SetOp(Layout::RAW10, Pattern::RGGB, Method::PERCEPTION, Scale::EIGHTH,  OutputFormat::Y8,    op);
   }
+#if ANKI_X86_SIMD
+  // Perception Quality on x86 (Webots, replay servers) uses the same 7 bit gamma table as the Neon ops,
+  // so output matches the robot. Photo quality stays on the CPU ops above, same as on the robot.
+  if (X86::HasSSE41())
+  {
+    {
+      auto op = std::make_shared<X86::RAW10toRGB24>();
+      SetOp(Layout::RAW10, Pattern::RGGB, Method::PERCEPTION, Scale::FULL,    OutputFormat::RGB24, op);
+      SetOp(Layout::RAW10, Pattern::RGGB, Method::PERCEPTION, Scale::HALF,    OutputFormat::RGB24, op);
+      SetOp(Layout::RAW10, Pattern::RGGB, Method::PERCEPTION, Scale::QUARTER, OutputFormat::RGB24, op);
+      SetOp(Layout::RAW10, Pattern::RGGB, Method::PERCEPTION, Scale::EIGHTH,  OutputFormat::RGB24, op);
+    }
+    {
+      auto op = std::make_shared<X86::RAW10toY8>();
+      SetOp(Layout::RAW10, Pattern::RGGB, Method::PERCEPTION, Scale::FULL,    OutputFormat::Y8,    op);
+      SetOp(Layout::RAW10, Pattern::RGGB, Method::PERCEPTION, Scale::HALF,    OutputFormat::Y8,    op);
+      SetOp(Layout::RAW10, Pattern::RGGB, Method::PERCEPTION, Scale::QUARTER, OutputFormat::Y8,    op);
+      SetOp(Layout::RAW10, Pattern::RGGB, Method::PERCEPTION, Scale::EIGHTH,  OutputFormat::Y8,    op);
+    }
+  }
+#endif
 #endif
 }
 
@@ -0,0 +1,417 @@
+/**
+ * File: x86/raw10.cpp
+ *
+ * Description: Debayering for RAW10 on x86 using SSE4.1, or AVX2 when the CPU has it. Walks the input and output
+ *              the same way as the Neon ops and uses the same gamma table, so output matches them byte for byte.
+ *
+ * Copyright: Anki, Inc. 2026
+ **/
+
+#include "coretech/vision/engine/debayer/x86/raw10.h"
+
+#if ANKI_X86_SIMD
+
+#include "util/logging/logging.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace Anki {
+namespace Vision {
+namespace X86 {
+
+namespace {
+
+// Each step converts 2 rows of 4 RAW10 blocks (16 pixels per row) into 2 rows of 16 output pixels, the same as one
+// step of the Neon ops. After the gamma lookup, rg holds R G R G ... from the first row of 2x2 blocks and gb holds
+// G B G B ... from the second row, and the masks below shuffle those into the output. 0x80 zeroes a byte, so each
+// output register is the OR of a shuffle of rg and a shuffle of gb.
+constexpr u8 Z = 0x80;
+
+// [output row][output register]
+alignas(16) const u8 kRGB24FromRG[2][3][16] = {
+  {
+    { 0,  1,  Z,  0,  1,  Z,  2,  3,  Z,  2,  3,  Z,  4,  5,  Z,  4},
+    { 5,  Z,  6,  7,  Z,  6,  7,  Z,  8,  9,  Z,  8,  9,  Z, 10, 11},
+    { Z, 10, 11,  Z, 12, 13,  Z, 12, 13,  Z, 14, 15,  Z, 14, 15,  Z},
+  },
+  {
+    { 0,  Z,  Z,  0,  Z,  Z,  2,  Z,  Z,  2,  Z,  Z,  4,  Z,  Z,  4},
+    { Z,  Z,  6,  Z,  Z,  6,  Z,  Z,  8,  Z,  Z,  8,  Z,  Z, 10,  Z},
+    { Z, 10,  Z,  Z, 12,  Z,  Z, 12,  Z,  Z, 14,  Z,  Z, 14,  Z,  Z},
+  },
+};
+
+alignas(16) const u8 kRGB24FromGB[2][3][16] = {
+  {
+    { Z,  Z,  1,  Z,  Z,  1,  Z,  Z,  3,  Z,  Z,  3,  Z,  Z,  5,  Z},
+    { Z,  5,  Z,  Z,  7,  Z,  Z,  7,  Z,  Z,  9,  Z,  Z,  9,  Z,  Z},
+    {11,  Z,  Z, 11,  Z,  Z, 13,  Z,  Z, 13,  Z,  Z, 15,  Z,  Z, 15},
+  },
+  {
+    { Z,  0,  1,  Z,  0,  1,  Z,  2,  3,  Z,  2,  3,  Z,  4,  5,  Z},
+    { 4,  5,  Z,  6,  7,  Z,  6,  7,  Z,  8,  9,  Z,  8,  9,  Z, 10},
+    {11,  Z, 10, 11,  Z, 12, 13,  Z, 12, 13,  Z, 14, 15,  Z, 14, 15},
+  },
+};
+
+// Y8 is the green from rg for the first output row and the green from gb for the second
+alignas(16) const u8 kY8FromRG[16] = { 1,  1,  3,  3,  5,  5,  7,  7,  9,  9, 11, 11, 13, 13, 15, 15};
+alignas(16) const u8 kY8FromGB[16] = { 0,  0,  2,  2,  4,  4,  6,  6,  8,  8, 10, 10, 12, 12, 14, 14};
+
+inline s32 Load32(const u8* ptr)
+{
+  s32 value;
+  memcpy(&value, ptr, sizeof(value));
+  return value;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// SSE4.1
+
+struct LUT128
+{
+  __m128i table[8];
+};
+
+ANKI_X86_TARGET_SSE41
+inline LUT128 LoadLUT128(const std::array<u8, 128>& gammaLUT)
+{
+  LUT128 lut;
+  for (int i = 0; i < 8; ++i){
+    lut.table[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(gammaLUT.data() + 16*i));
+  }
+  return lut;
+}
+
+// The 8 most significant bits of 4 pixels from each of 4 blocks, colSkip bytes apart
+ANKI_X86_TARGET_SSE41
+inline __m128i LoadBlocks(const u8* ptr, u32 colSkip)
+{
+  return _mm_setr_epi32(Load32(ptr), Load32(ptr + colSkip), Load32(ptr + 2*colSkip), Load32(ptr + 3*colSkip));
+}
+
+// Look up the 7 most significant bits of each byte in the 128 entry gamma table, 16 entries at a time. Adding 0x70
+// (saturated) keeps indices in the current 16 entries below 0x80 with their low 4 bits intact, and pushes everything
+// else to 0x80 or above, which the shuffle turns into 0.
+ANKI_X86_TARGET_SSE41
+inline __m128i ApplyGamma(__m128i values, const LUT128& lut)
+{
+  values = _mm_and_si128(_mm_srli_epi16(values, 1), _mm_set1_epi8(0x7F));
+
+  const __m128i kOffset = _mm_set1_epi8(0x70);
+  const __m128i kStep = _mm_set1_epi8(16);
+  __m128i output = _mm_setzero_si128();
+  for (int i = 0; i < 8; ++i)
+  {
+    output = _mm_or_si128(output, _mm_shuffle_epi8(lut.table[i], _mm_adds_epu8(values, kOffset)));
+    values = _mm_sub_epi8(values, kStep);
+  }
+  return output;
+}
+
+ANKI_X86_TARGET_SSE41
+inline __m128i Shuffle2(__m128i rg, const u8* rgMask, __m128i gb, const u8* gbMask)
+{
+  return _mm_or_si128(_mm_shuffle_epi8(rg, _mm_load_si128(reinterpret_cast<const __m128i*>(rgMask))),
+                      _mm_shuffle_epi8(gb, _mm_load_si128(reinterpret_cast<const __m128i*>(gbMask))));
+}
+
+ANKI_X86_TARGET_SSE41
+inline void StoreRGB24(__m128i rg, __m128i gb, u8* outBufferPtr1, u8* outBufferPtr2)
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(outBufferPtr1 + 16*i),
+                     Shuffle2(rg, kRGB24FromRG[0][i], gb, kRGB24FromGB[0][i]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(outBufferPtr2 + 16*i),
+                     Shuffle2(rg, kRGB24FromRG[1][i], gb, kRGB24FromGB[1][i]));
+  }
+}
+
+ANKI_X86_TARGET_SSE41
+inline void StoreY8(__m128i rg, __m128i gb, u8* outBufferPtr1, u8* outBufferPtr2)
+{
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(outBufferPtr1),
+                   _mm_shuffle_epi8(rg, _mm_load_si128(reinterpret_cast<const __m128i*>(kY8FromRG))));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(outBufferPtr2),
+                   _mm_shuffle_epi8(gb, _mm_load_si128(reinterpret_cast<const __m128i*>(kY8FromGB))));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// AVX2, two steps at a time with one in each 128 bit lane
+
+struct LUT256
+{
+  __m256i table[8];
+};
+
+ANKI_X86_TARGET_AVX2
+inline LUT256 LoadLUT256(const std::array<u8, 128>& gammaLUT)
+{
+  LUT256 lut;
+  for (int i = 0; i < 8; ++i){
+    lut.table[i] = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(gammaLUT.data() + 16*i)));
+  }
+  return lut;
+}
+
+ANKI_X86_TARGET_AVX2
+inline __m256i LoadBlocks256(const u8* ptr, u32 colSkip)
+{
+  return _mm256_setr_epi32(Load32(ptr),             Load32(ptr + colSkip),
+                           Load32(ptr + 2*colSkip), Load32(ptr + 3*colSkip),
+                           Load32(ptr + 4*colSkip), Load32(ptr + 5*colSkip),
+                           Load32(ptr + 6*colSkip), Load32(ptr + 7*colSkip));
+}
+
+ANKI_X86_TARGET_AVX2
+inline __m256i ApplyGamma256(__m256i values, const LUT256& lut)
+{
+  values = _mm256_and_si256(_mm256_srli_epi16(values, 1), _mm256_set1_epi8(0x7F));
+
+  const __m256i kOffset = _mm256_set1_epi8(0x70);
+  const __m256i kStep = _mm256_set1_epi8(16);
+  __m256i output = _mm256_setzero_si256();
+  for (int i = 0; i < 8; ++i)
+  {
+    output = _mm256_or_si256(output, _mm256_shuffle_epi8(lut.table[i], _mm256_adds_epu8(values, kOffset)));
+    values = _mm256_sub_epi8(values, kStep);
+  }
+  return output;
+}
+
+ANKI_X86_TARGET_AVX2
+inline __m256i Shuffle2_256(__m256i rg, const u8* rgMask, __m256i gb, const u8* gbMask)
+{
+  const __m256i rgShuffle = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(rgMask)));
+  const __m256i gbShuffle = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(gbMask)));
+  return _mm256_or_si256(_mm256_shuffle_epi8(rg, rgShuffle), _mm256_shuffle_epi8(gb, gbShuffle));
+}
+
+// Each lane produced 48 bytes of output split across three registers, put them back in order
+ANKI_X86_TARGET_AVX2
+inline void StoreLanesRGB24(__m256i out0, __m256i out1, __m256i out2, u8* outBufferPtr)
+{
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(outBufferPtr),      _mm256_permute2x128_si256(out0, out1, 0x20));
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(outBufferPtr + 32), _mm256_permute2x128_si256(out2, out0, 0x30));
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(outBufferPtr + 64), _mm256_permute2x128_si256(out1, out2, 0x31));
+}
+
+ANKI_X86_TARGET_AVX2
+inline void StoreRGB24_256(__m256i rg, __m256i gb, u8* outBufferPtr1, u8* outBufferPtr2)
+{
+  for (int row = 0; row < 2; ++row)
+  {
+    StoreLanesRGB24(Shuffle2_256(rg, kRGB24FromRG[row][0], gb, kRGB24FromGB[row][0]),
+                    Shuffle2_256(rg, kRGB24FromRG[row][1], gb, kRGB24FromGB[row][1]),
+                    Shuffle2_256(rg, kRGB24FromRG[row][2], gb, kRGB24FromGB[row][2]),
+                    (row == 0 ? outBufferPtr1 : outBufferPtr2));
+  }
+}
+
+ANKI_X86_TARGET_AVX2
+inline void StoreY8_256(__m256i rg, __m256i gb, u8* outBufferPtr1, u8* outBufferPtr2)
+{
+  const __m256i rgShuffle = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(kY8FromRG)));
+  const __m256i gbShuffle = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(kY8FromGB)));
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(outBufferPtr1), _mm256_shuffle_epi8(rg, rgShuffle));
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(outBufferPtr2), _mm256_shuffle_epi8(gb, gbShuffle));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// Same walk over the input and output as the Neon ops
+struct Layout
+{
+  u32 outChannels;
+  u32 inColSkip;
+  u32 inRowSkip;
+  u32 outRowSkip;
+};
+
+bool GetLayout(const Debayer::InArgs& inArgs, const Debayer::OutArgs& outArgs, u32 outChannels, Layout& layout)
+{
+  u8 sampleRate = 1;
+  if (!Debayer::SampleRateFromScale(outArgs.scale, sampleRate))
+  {
+    return false;
+  }
+
+  // One step covers 16 columns and 2 rows of output
+  if ((outArgs.width % 16) != 0 || (outArgs.height % 2) != 0)
+  {
+    LOG_ERROR("Debayer.X86.RAW10.UnsupportedSize", "Output size %dx%d is not a multiple of 16x2",
+              outArgs.width, outArgs.height);
+    return false;
+  }
+
+  layout.outChannels = outChannels;
+  layout.inColSkip = 5 * sampleRate;
+  // Skip the rest of the bytes in a row and move down an extra rows;
+  layout.inRowSkip = (2*sampleRate-1)*((inArgs.width * 5)/4);
+  layout.outRowSkip = outChannels * outArgs.width;
+  return true;
+}
+
+template<bool kRGB24>
+ANKI_X86_TARGET_SSE41
+void DebayerSSE41(const Debayer::InArgs& inArgs, Debayer::OutArgs& outArgs, const Layout& layout,
+                  const std::array<u8, 128>& gammaLUT)
+{
+  const LUT128 lut = LoadLUT128(gammaLUT);
+
+  const u8* inBufferPtr1 = inArgs.data;
+  const u8* inBufferPtr2 = inBufferPtr1 + layout.inRowSkip;
+
+  u8* outBufferPtr1 = outArgs.data;
+  u8* outBufferPtr2 = outBufferPtr1 + layout.outRowSkip;
+
+  const u32 inStepSkip = 4 * layout.inColSkip;
+  const u32 outStepSkip = 16 * layout.outChannels;
+
+  for (s32 row = 0; row < outArgs.height; row += 2)
+  {
+    for (s32 col = 0; col < outArgs.width; col += 16)
+    {
+      const __m128i rg = ApplyGamma(LoadBlocks(inBufferPtr1, layout.inColSkip), lut);
+      const __m128i gb = ApplyGamma(LoadBlocks(inBufferPtr2, layout.inColSkip), lut);
+      if (kRGB24) {
+        StoreRGB24(rg, gb, outBufferPtr1, outBufferPtr2);
+      } else {
+        StoreY8(rg, gb, outBufferPtr1, outBufferPtr2);
+      }
+
+      inBufferPtr1 += inStepSkip;
+      inBufferPtr2 += inStepSkip;
+      outBufferPtr1 += outStepSkip;
+      outBufferPtr2 += outStepSkip;
+    }
+
+    inBufferPtr1 += layout.inRowSkip;
+    inBufferPtr2 += layout.inRowSkip;
+    outBufferPtr1 += layout.outRowSkip;
+    outBufferPtr2 += layout.outRowSkip;
+  }
+}
+
+template<bool kRGB24>
+ANKI_X86_TARGET_AVX2
+void DebayerAVX2(const Debayer::InArgs& inArgs, Debayer::OutArgs& outArgs, const Layout& layout,
+                 const std::array<u8, 128>& gammaLUT)
+{
+  const LUT256 lut256 = LoadLUT256(gammaLUT);
+  const LUT128 lut = LoadLUT128(gammaLUT);
+
+  const u8* inBufferPtr1 = inArgs.data;
+  const u8* inBufferPtr2 = inBufferPtr1 + layout.inRowSkip;
+
+  u8* outBufferPtr1 = outArgs.data;
+  u8* outBufferPtr2 = outBufferPtr1 + layout.outRowSkip;
+
+  const u32 inStepSkip = 4 * layout.inColSkip;
+  const u32 outStepSkip = 16 * layout.outChannels;
+
+  for (s32 row = 0; row < outArgs.height; row += 2)
+  {
+    s32 col = 0;
+    for (; col + 32 <= outArgs.width; col += 32)
+    {
+      const __m256i rg = ApplyGamma256(LoadBlocks256(inBufferPtr1, layout.inColSkip), lut256);
+      const __m256i gb = ApplyGamma256(LoadBlocks256(inBufferPtr2, layout.inColSkip), lut256);
+      if (kRGB24) {
+        StoreRGB24_256(rg, gb, outBufferPtr1, outBufferPtr2);
+      } else {
+        StoreY8_256(rg, gb, outBufferPtr1, outBufferPtr2);
+      }
+
+      inBufferPtr1 += 2*inStepSkip;
+      inBufferPtr2 += 2*inStepSkip;
+      outBufferPtr1 += 2*outStepSkip;
+      outBufferPtr2 += 2*outStepSkip;
+    }
+
+    // Width is only guaranteed to be a multiple of 16
+    for (; col < outArgs.width; col += 16)
+    {
+      const __m128i rg = ApplyGamma(LoadBlocks(inBufferPtr1, layout.inColSkip), lut);
+      const __m128i gb = ApplyGamma(LoadBlocks(inBufferPtr2, layout.inColSkip), lut);
+      if (kRGB24) {
+        StoreRGB24(rg, gb, outBufferPtr1, outBufferPtr2);
+      } else {
+        StoreY8(rg, gb, outBufferPtr1, outBufferPtr2);
+      }
+
+      inBufferPtr1 += inStepSkip;
+      inBufferPtr2 += inStepSkip;
+      outBufferPtr1 += outStepSkip;
+      outBufferPtr2 += outStepSkip;
+    }
+
+    inBufferPtr1 += layout.inRowSkip;
+    inBufferPtr2 += layout.inRowSkip;
+    outBufferPtr1 += layout.outRowSkip;
+    outBufferPtr2 += layout.outRowSkip;
+  }
+}
+
+} /* anonymous namespace */
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+RAW10toRGB24::RAW10toRGB24() : Op()
+{
+  // Setup a gamma table for 128 (2^7) possible input values, same as the Neon op
+  for (size_t i = 0; i < _gammaLUT.size(); ++i){
+    _gammaLUT[i] = 255 * powf((f32)i/127.0f, Debayer::GAMMA);
+  }
+}
+
+Result RAW10toRGB24::operator()(const Debayer::InArgs& inArgs, Debayer::OutArgs& outArgs) const
+{
+  Layout layout;
+  if (!GetLayout(inArgs, outArgs, 3, layout))
+  {
+    return RESULT_FAIL;
+  }
+
+  if (HasAVX2()) {
+    DebayerAVX2<true>(inArgs, outArgs, layout, _gammaLUT);
+  } else {
+    DebayerSSE41<true>(inArgs, outArgs, layout, _gammaLUT);
+  }
+  return RESULT_OK; // SUCCESS
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+RAW10toY8::RAW10toY8() : Op()
+{
+  // Setup a gamma table for 128 (2^7) possible input values, same as the Neon op
+  for (size_t i = 0; i < _gammaLUT.size(); ++i){
+    _gammaLUT[i] = 255 * powf((f32)i/127.0f, Debayer::GAMMA);
+  }
+}
+
+Result RAW10toY8::operator()(const Debayer::InArgs& inArgs, Debayer::OutArgs& outArgs) const
+{
+  Layout layout;
+  if (!GetLayout(inArgs, outArgs, 1, layout))
+  {
+    return RESULT_FAIL;
+  }
+
+  if (HasAVX2()) {
+    DebayerAVX2<false>(inArgs, outArgs, layout, _gammaLUT);
+  } else {
+    DebayerSSE41<false>(inArgs, outArgs, layout, _gammaLUT);
+  }
+  return RESULT_OK; // SUCCESS
+}
+
+} /* namespace X86 */
+} /* namespace Vision */
+} /* namespace Anki */
+
+#endif /* ANKI_X86_SIMD */
@@ -0,0 +1,51 @@
+/**
+ * File: x86/raw10.h
+ *
+ * Description: Debayering for RAW10 on x86 (Webots, replay servers). This contains Debayer::Op instances that run on
+ *              CPU using SSE4.1, or AVX2 when the CPU has it. Output matches the Neon ops byte for byte.
+ *
+ * Copyright: Anki, Inc. 2026
+ */
+
+#include "coretech/vision/engine/x86Simd.h"
+
+#if ANKI_X86_SIMD
+#ifndef __Anki_Coretech_Vision_Debayer_X86_Raw10_H__
+#define __Anki_Coretech_Vision_Debayer_X86_Raw10_H__
+
+#include "coretech/vision/engine/debayer.h"
+
+#include <array>
+
+namespace Anki {
+namespace Vision {
+namespace X86 {
+
+class RAW10toRGB24: public Debayer::Op
+{
+public:
+  RAW10toRGB24();
+  virtual ~RAW10toRGB24() = default;
+  Result operator()(const Debayer::InArgs& inArgs, Debayer::OutArgs& outArgs) const override;
+
+private:
+  std::array<u8, 128> _gammaLUT;
+};
+
+class RAW10toY8: public Debayer::Op
+{
+public:
+  RAW10toY8();
+  virtual ~RAW10toY8() = default;
+  Result operator()(const Debayer::InArgs& inArgs, Debayer::OutArgs& outArgs) const override;
+
+private:
+  std::array<u8, 128> _gammaLUT;
+};
+
+} /* namespace X86 */
+} /* namespace Vision */
+} /* namespace Anki */
+
+#endif /* __Anki_Coretech_Vision_Debayer_X86_Raw10_H__ */
+#endif /* ANKI_X86_SIMD */
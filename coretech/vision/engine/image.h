@@ -23,6 +23,7 @@
 
 #include "coretech/vision/engine/colorPixelTypes.h"
 
+#include <array>
 #include <string>
 #include <vector>
 
@@ -88,6 +89,11 @@ namespace Vision {
     // Resize into the new image (which is already the desired size)
     void Resize(ImageBase<T>& resizedImage, ResizeMethod method = ResizeMethod::Linear) const;
 
+    // Downsample by exactly 2x into halvedImage (reallocated only if its size changes) by averaging each 2x2 block.
+    // With even dimensions this hits OpenCV's vectorized integer-factor area resize, so it is much cheaper than a
+    // general Resize and, for a 2x reduction, equivalent to ResizeMethod::Linear or AverageArea.
+    void Halve(ImageBase<T>& halvedImage) const;
+
     // Resize in place to a specific size, keeps the aspect ratio
     // If onlyReduceSize=true, does not resize if new size is larger than requested size
     void ResizeKeepAspectRatio(s32 desiredRows, s32 desiredCols,
@@ -284,8 +290,14 @@ namespace Vision {
 
     void BoxFilter(ImageBase<u8>& filtered, u32 size) const override;
 
+    // Treats this image as the V channel of an HSV image with the given constant hue and saturation
     void ConvertV2RGB565(u8 hue, u8 sat, ImageRGB565& output);
 
+    // Same as above, using a table from GetV2RGB565LUT, which can be reused as long as hue and saturation don't change
+    using V2RGB565LUT = std::array<u16, 256>;
+    static void GetV2RGB565LUT(u8 hue, u8 sat, V2RGB565LUT& lut);
+    void ConvertV2RGB565(const V2RGB565LUT& lut, ImageRGB565& output) const;
+
   protected:
     virtual cv::Scalar GetCvColor(const ColorRGBA& color) const override;
 
@@ -14,16 +14,83 @@
 
 #include "coretech/vision/engine/image_impl.h"
 #include "coretech/vision/engine/neonMacros.h"
+#include "coretech/vision/engine/x86Simd.h"
 
 #include "opencv2/core.hpp"
 #include "opencv2/imgproc.hpp"
 
+#include <cstring>
 #include <unistd.h>
 
 namespace Anki {
 namespace Vision {
 namespace ImageConversions {
 
+namespace {
+// Fixed point BT.601 coefficients, copied from OpenCV
+// https://github.com/opencv/opencv/blob/7dc88f26f24fa3fd564a282b2438c3ac0263cd2f/modules/imgproc/src/color_yuv.cpp
+constexpr int ITUR_BT_601_CY    = 1220542;
+constexpr int ITUR_BT_601_CUB   = 2116026;
+constexpr int ITUR_BT_601_CUG   = -409993;
+constexpr int ITUR_BT_601_CVG   = -852492;
+constexpr int ITUR_BT_601_CVR   = 1673527;
+constexpr int ITUR_BT_601_SHIFT = 20;
+
+#if ANKI_X86_SIMD
+// Converts 8 pixels from each of 2 rows of Y sharing 4 UV pairs, with the same
+// fixed point math (and so the same output) as the one-by-one conversion below
+ANKI_X86_TARGET_SSE41
+inline void ConvertYUV420spToRGBx8(const u8* yPtr, const u8* y2Ptr, const u8* uvPtr,
+                                   u8* outputPtr1, u8* outputPtr2)
+{
+  const __m128i kHalf = _mm_set1_epi32(1 << (ITUR_BT_601_SHIFT - 1));
+  const __m128i k128  = _mm_set1_epi32(128);
+
+  // UV pairs as u16 U | V<<16
+  const __m128i uv = _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(uvPtr)));
+  const __m128i u = _mm_sub_epi32(_mm_and_si128(uv, _mm_set1_epi32(0xFFFF)), k128);
+  const __m128i v = _mm_sub_epi32(_mm_srli_epi32(uv, 16), k128);
+
+  const __m128i ruv = _mm_add_epi32(kHalf, _mm_mullo_epi32(v, _mm_set1_epi32(ITUR_BT_601_CVR)));
+  const __m128i guv = _mm_add_epi32(kHalf, _mm_add_epi32(_mm_mullo_epi32(v, _mm_set1_epi32(ITUR_BT_601_CVG)),
+                                                         _mm_mullo_epi32(u, _mm_set1_epi32(ITUR_BT_601_CUG))));
+  const __m128i buv = _mm_add_epi32(kHalf, _mm_mullo_epi32(u, _mm_set1_epi32(ITUR_BT_601_CUB)));
+
+  // Each UV is shared by 2 consecutive Ys, so 1 1 2 2 and 3 3 4 4
+  const __m128i ruv1 = _mm_unpacklo_epi32(ruv, ruv), ruv2 = _mm_unpackhi_epi32(ruv, ruv);
+  const __m128i guv1 = _mm_unpacklo_epi32(guv, guv), guv2 = _mm_unpackhi_epi32(guv, guv);
+  const __m128i buv1 = _mm_unpacklo_epi32(buv, buv), buv2 = _mm_unpackhi_epi32(buv, buv);
+
+  const __m128i k16 = _mm_set1_epi32(16);
+  const __m128i kCY = _mm_set1_epi32(ITUR_BT_601_CY);
+  const __m128i kZero = _mm_setzero_si128();
+
+  for(int row = 0; row < 2; ++row)
+  {
+    const u8* ySrc = (row == 0 ? yPtr : y2Ptr);
+    u8* output = (row == 0 ? outputPtr1 : outputPtr2);
+
+    s32 y4[2];
+    memcpy(y4, ySrc, sizeof(y4));
+    __m128i y1 = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(y4[0]));
+    __m128i y2 = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(y4[1]));
+    y1 = _mm_mullo_epi32(_mm_max_epi32(kZero, _mm_sub_epi32(y1, k16)), kCY);
+    y2 = _mm_mullo_epi32(_mm_max_epi32(kZero, _mm_sub_epi32(y2, k16)), kCY);
+
+    const __m128i r = _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(y1, ruv1), ITUR_BT_601_SHIFT),
+                                      _mm_srai_epi32(_mm_add_epi32(y2, ruv2), ITUR_BT_601_SHIFT));
+    const __m128i g = _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(y1, guv1), ITUR_BT_601_SHIFT),
+                                      _mm_srai_epi32(_mm_add_epi32(y2, guv2), ITUR_BT_601_SHIFT));
+    const __m128i b = _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(y1, buv1), ITUR_BT_601_SHIFT),
+                                      _mm_srai_epi32(_mm_add_epi32(y2, buv2), ITUR_BT_601_SHIFT));
+
+    // Saturating packs are the saturate_cast<uchar>
+    X86::StoreRGB24x8(output, _mm_packus_epi16(r, g), _mm_packus_epi16(b, b));
+  }
+}
+#endif
+}
+
 void ConvertYUV420spToRGB(const u8* yuv, s32 rows, s32 cols,
                           ImageRGB& rgb)
 {
@@ -279,18 +346,24 @@ void ConvertYUV420spToRGB(const u8* yuv, s32 rows, s32 cols,
       outputPtr2 += 24;
     }
 
+#elif ANKI_X86_SIMD
+    if(X86::HasSSE41())
+    {
+      for(; c < cols - (8-1); c += 8)
+      {
+        ConvertYUV420spToRGBx8(yPtr, y2Ptr, uvPtr, outputPtr1, outputPtr2);
+        yPtr  += 8;
+        y2Ptr += 8;
+        uvPtr += 8;
+        outputPtr1 += 24;
+        outputPtr2 += 24;
+      }
+    }
 #endif
 
     // Process any extra elements one by one
     // Copied from OpenCV
     // https://github.com/opencv/opencv/blob/7dc88f26f24fa3fd564a282b2438c3ac0263cd2f/modules/imgproc/src/color_yuv.cpp
-    constexpr int ITUR_BT_601_CY    = 1220542;
-    constexpr int ITUR_BT_601_CUB   = 2116026;
-    constexpr int ITUR_BT_601_CUG   = -409993;
-    constexpr int ITUR_BT_601_CVG   = -852492;
-    constexpr int ITUR_BT_601_CVR   = 1673527;
-    constexpr int ITUR_BT_601_SHIFT = 20;
-
     for(; c < cols; c += 2)
     {
       int u = (int)(uvPtr[0]) - 128;
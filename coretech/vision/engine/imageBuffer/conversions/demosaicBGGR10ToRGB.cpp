@@ -14,6 +14,7 @@
 
 #include "coretech/vision/engine/image_impl.h"
 #include "coretech/vision/engine/neonMacros.h"
+#include "coretech/vision/engine/x86Simd.h"
 
 #include "opencv2/core.hpp"
 #include "opencv2/imgproc.hpp"
@@ -24,6 +25,30 @@ namespace Anki {
 namespace Vision {
 namespace ImageConversions {
 
+#if ANKI_X86_SIMD
+namespace {
+// Strips the fifth byte from 4 blocks (20 bytes) and does a saturating shift on the rest,
+// writing 16 pixels
+ANKI_X86_TARGET_SSE41
+inline void StripRAW10x16(const u8* bufferPtr, u8* bayerPtr)
+{
+  // Bytes 0-15 and 4-19, so as not to read past the 4 blocks
+  const __m128i data1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bufferPtr));
+  const __m128i data2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bufferPtr + 4));
+
+  const char Z = (char)0x80;
+  __m128i data = _mm_or_si128(_mm_shuffle_epi8(data1, _mm_setr_epi8(0, 1, 2, 3, 5, 6, 7, 8, 10, 11, 12, 13,
+                                                                    Z, Z, Z, Z)),
+                              _mm_shuffle_epi8(data2, _mm_setr_epi8(Z, Z, Z, Z, Z, Z, Z, Z, Z, Z, Z, Z,
+                                                                    11, 12, 13, 14)));
+  // Saturating left shift by 2
+  data = _mm_adds_epu8(data, data);
+  data = _mm_adds_epu8(data, data);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(bayerPtr), data);
+}
+}
+#endif
+
 void DemosaicBGGR10ToRGB(const u8* bayer_in, s32 rows, s32 cols, ImageRGB& rgb)
 {
 #ifdef __ARM_NEON__
@@ -73,7 +98,19 @@ void DemosaicBGGR10ToRGB(const u8* bayer_in, s32 rows, s32 cols, ImageRGB& rgb)
   // This loop strips the fifth byte and does a saturating shift on
   // the other 4 bytes as if the fifth byte was all 0
   u8* bayerPtr = static_cast<u8*>(bayer.ptr());
-  for(int i = 0; i < (cols*rows); i+=4)
+  int i = 0;
+#if ANKI_X86_SIMD
+  if(X86::HasSSE41())
+  {
+    for(; i < (cols*rows) - (16-1); i+=16)
+    {
+      StripRAW10x16(bufferPtr, bayerPtr);
+      bufferPtr += 20;
+      bayerPtr += 16;
+    }
+  }
+#endif
+  for(; i < (cols*rows); i+=4)
   {
     u8 a = cv::saturate_cast<u8>(((u16)bufferPtr[0]) << 2);
     u8 b = cv::saturate_cast<u8>(((u16)bufferPtr[1]) << 2);
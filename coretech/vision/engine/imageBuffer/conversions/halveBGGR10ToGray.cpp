@@ -181,7 +181,7 @@ void HalveBGGR10ToGray(const u8* bayer, s32 rows, s32 cols,
   }
 #else // No neon support
   // Halve to RGB and then convert to gray
-  // HalveBGGR10ToRGB has a non-neon implementation
+  // HalveBGGR10ToRGB has a non-neon implementation (SSE4.1 on x86)
   ImageRGB rgb;
   HalveBGGR10ToRGB(bayer, rows, cols, rgb);
   rgb.FillGray(gray);
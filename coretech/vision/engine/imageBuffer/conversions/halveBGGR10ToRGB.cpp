@@ -15,6 +15,7 @@
 #include "coretech/vision/engine/imageBuffer/conversions/debayer.h"
 #include "coretech/vision/engine/image_impl.h"
 #include "coretech/vision/engine/neonMacros.h"
+#include "coretech/vision/engine/x86Simd.h"
 
 #include "opencv2/core.hpp"
 #include "opencv2/imgproc.hpp"
@@ -25,6 +26,89 @@ namespace Anki {
 namespace Vision {
 namespace ImageConversions {
 
+#if ANKI_X86_SIMD
+namespace {
+
+// Unpacks 2 blocks (10 bytes) of RAW10 into 8 10 bit pixels, with the same packed LSB order as
+// bayer_mipi_bggr10_downsample (first pixel in the top 2 bits of the 5th byte)
+ANKI_X86_TARGET_SSE41
+inline __m128i UnpackRAW10x8(const u8* bayer)
+{
+  // Bytes 0-7 followed by bytes 2-9 so as not to read past the 2 blocks
+  const __m128i data = _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(bayer)),
+                                          _mm_loadl_epi64(reinterpret_cast<const __m128i*>(bayer + 2)));
+
+  const char Z = (char)0x80;
+  const __m128i msb = _mm_shuffle_epi8(data, _mm_setr_epi8(0, Z, 1, Z, 2, Z, 3, Z,  5, Z,  6, Z,  7, Z, 14, Z));
+  const __m128i lsb = _mm_shuffle_epi8(data, _mm_setr_epi8(4, Z, 4, Z, 4, Z, 4, Z, 15, Z, 15, Z, 15, Z, 15, Z));
+
+  // Move each pixel's 2 bits to the top of the low byte and then down to the bottom
+  const __m128i bits = _mm_and_si128(_mm_srli_epi16(_mm_mullo_epi16(lsb, _mm_setr_epi16(1, 4, 16, 64, 1, 4, 16, 64)), 6),
+                                     _mm_set1_epi16(0x03));
+  return _mm_or_si128(_mm_slli_epi16(msb, 2), bits);
+}
+
+// Same output as bayer_mipi_bggr10_downsample on non-Neon platforms, 4 blocks (8 output pixels) at a time
+ANKI_X86_TARGET_SSE41
+void HalveBGGR10ToRGB_SSE41(const u8* bayer, u8* rgb, s32 bayer_sx, s32 bayer_sy)
+{
+  const __m128i kLowMask = _mm_set1_epi32(0x0000FFFF);
+
+  for(s32 i = 0; i < bayer_sy - 1; i += 2)
+  {
+    const u8* bayer1 = bayer + (i*bayer_sx);
+    const u8* bayer2 = bayer1 + bayer_sx;
+
+    const s32 kNumBytesProcessed = 20;
+    s32 j = 0;
+    for(; j <= bayer_sx - kNumBytesProcessed; j += kNumBytesProcessed)
+    {
+      // B G B G ... and G R G R ..., 16 pixels each
+      const __m128i row1_1 = UnpackRAW10x8(bayer1 + j);
+      const __m128i row1_2 = UnpackRAW10x8(bayer1 + j + 10);
+      const __m128i row2_1 = UnpackRAW10x8(bayer2 + j);
+      const __m128i row2_2 = UnpackRAW10x8(bayer2 + j + 10);
+
+      const __m128i b  = _mm_packus_epi32(_mm_and_si128(row1_1, kLowMask), _mm_and_si128(row1_2, kLowMask));
+      const __m128i g1 = _mm_packus_epi32(_mm_srli_epi32(row1_1, 16),     _mm_srli_epi32(row1_2, 16));
+      const __m128i g2 = _mm_packus_epi32(_mm_and_si128(row2_1, kLowMask), _mm_and_si128(row2_2, kLowMask));
+      const __m128i r  = _mm_packus_epi32(_mm_srli_epi32(row2_1, 16),     _mm_srli_epi32(row2_2, 16));
+
+      const __m128i g = _mm_srli_epi16(_mm_add_epi16(g1, g2), 1);
+
+      // Saturating pack is the clip to [0,255]
+      X86::StoreRGB24x8(rgb, _mm_packus_epi16(r, g), _mm_packus_epi16(b, b));
+      rgb += 8*3;
+    }
+
+    // Process left over data
+    for(; j < bayer_sx; j += 5)
+    {
+      const u8* p1 = bayer1 + j;
+      const u8* p2 = bayer2 + j;
+      const u16 px_A  = (p1[0] << 2) | ((p1[4] & 0xc0) >> 6);
+      const u16 px_B  = (p1[1] << 2) | ((p1[4] & 0x30) >> 4);
+      const u16 px_A_ = (p1[2] << 2) | ((p1[4] & 0x0c) >> 2);
+      const u16 px_B_ = (p1[3] << 2) | (p1[4] & 0x03);
+      const u16 px_C  = (p2[0] << 2) | ((p2[4] & 0xc0) >> 6);
+      const u16 px_D  = (p2[1] << 2) | ((p2[4] & 0x30) >> 4);
+      const u16 px_C_ = (p2[2] << 2) | ((p2[4] & 0x0c) >> 2);
+      const u16 px_D_ = (p2[3] << 2) | (p2[4] & 0x03);
+
+      rgb[0] = cv::saturate_cast<u8>(px_D);
+      rgb[1] = cv::saturate_cast<u8>((px_C + px_B) >> 1);
+      rgb[2] = cv::saturate_cast<u8>(px_A);
+      rgb[3] = cv::saturate_cast<u8>(px_D_);
+      rgb[4] = cv::saturate_cast<u8>((px_C_ + px_B_) >> 1);
+      rgb[5] = cv::saturate_cast<u8>(px_A_);
+      rgb += 6;
+    }
+  }
+}
+
+}
+#endif
+
 void HalveBGGR10ToRGB(const u8* bayer_in, s32 rows, s32 cols, ImageRGB& rgb)
 {
   // Output image is half the resolution of the bayer image
@@ -34,6 +118,13 @@ void HalveBGGR10ToRGB(const u8* bayer_in, s32 rows, s32 cols, ImageRGB& rgb)
   // but this functions expects the width and height in bytes
   const s32 bayer_sx = (cols*10)/8;
   const s32 bayer_sy = rows;
+#if ANKI_X86_SIMD
+  if(X86::HasSSE41())
+  {
+    HalveBGGR10ToRGB_SSE41(bayer_in, reinterpret_cast<u8*>(rgb.GetRow(0)), bayer_sx, bayer_sy);
+    return;
+  }
+#endif
   bayer_mipi_bggr10_downsample(bayer_in, reinterpret_cast<u8*>(rgb.GetRow(0)),
                                bayer_sx, bayer_sy, 10);
 }
@@ -26,7 +26,7 @@ namespace ImageConversions {
 
   // Converts YUV420sp formatted data of an image of size rows x cols
   // to RGB
-  // NEON optimized
+  // NEON optimized, SSE4.1 on x86
   void ConvertYUV420spToRGB(const u8* yuv, s32 rows, s32 cols,
                             ImageRGB& rgb);
 
@@ -134,7 +134,7 @@ void QuarterBGGR10ToRGB(const u8* bayer, s32 rows, s32 cols,
   }
 #else
   // No neon available so halve to RGB and then resize to get quarter sized output
-  // HalveBGGR10ToRGB has a non-neon implementation
+  // HalveBGGR10ToRGB has a non-neon implementation (SSE4.1 on x86)
   HalveBGGR10ToRGB(bayer, rows, cols, rgb);
   rgb.Resize(0.5f);
 #endif
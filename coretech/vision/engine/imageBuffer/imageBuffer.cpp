@@ -184,6 +184,30 @@ bool ImageBuffer::GetGray(Image& gray, ImageCacheSize size) const
   return res;
 }
 
+bool ImageBuffer::ConvertsDirectlyToRGB(ImageCacheSize size) const
+{
+  switch(_format)
+  {
+    case ImageEncoding::BAYER:
+      return (ImageCacheSize::Eighth != size);
+
+    default:
+      return (ImageCacheSize::Full == size);
+  }
+}
+
+bool ImageBuffer::ConvertsDirectlyToGray(ImageCacheSize size) const
+{
+  switch(_format)
+  {
+    case ImageEncoding::BAYER:
+      return (ImageCacheSize::Half == size);
+
+    default:
+      return (ImageCacheSize::Full == size);
+  }
+}
+
 bool ImageBuffer::GetRGBFromBAYER(ImageRGB& rgb, ImageCacheSize size) const
 {
   switch(size)
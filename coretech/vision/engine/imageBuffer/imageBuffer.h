@@ -77,6 +77,11 @@ public:
   // Returns true if conversion was successful
   bool GetGray(Image& gray, ImageCacheSize size) const;
 
+  // Returns whether GetRGB/GetGray at size converts straight from the raw data, as opposed to
+  // converting at some other size and then resizing the result
+  bool ConvertsDirectlyToRGB(ImageCacheSize size) const;
+  bool ConvertsDirectlyToGray(ImageCacheSize size) const;
+
 private:
 
   // Calculates number of rows and cols a converted RGB image will have
@@ -56,6 +56,24 @@ namespace Vision {
 //                                  RESIZED ENTRY
 // =====================================================================================================================
   
+void ImageCache::ResizedEntry::Invalidate()
+{
+  _hasValidGray = false;
+  _hasValidRGB = false;
+  _buffer.Invalidate();
+  
+  if(_gray.IsShared())
+  {
+    _gray = Image();
+  }
+  
+  if(_rgb.IsShared())
+  {
+    _rgb = ImageRGB();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 template<>
 inline Image& ImageCache::ResizedEntry::Get<Image>()
 {
@@ -194,6 +212,24 @@ void ImageCache::ResizedEntry::Update(const ImageBuffer& origImg, ImageCacheSize
   _size = size;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<>
+Image& ImageCache::ResizedEntry::SetFromLarger(const Image& largerImg)
+{
+  largerImg.Halve(_gray);
+  _hasValidGray = true;
+  return _gray;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<>
+ImageRGB& ImageCache::ResizedEntry::SetFromLarger(const ImageRGB& largerImg)
+{
+  largerImg.Halve(_rgb);
+  _hasValidRGB = true;
+  return _rgb;
+}
+
 
 // =====================================================================================================================
 //                                  IMAGE CACHE
@@ -207,6 +243,7 @@ ImageCache::ImageCache()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ImageCache::ReleaseMemory()
 {
+  std::lock_guard<std::mutex> lock(_mutex);
   _resizedVersions.clear();
   _sensorNumRows = 0;
   _sensorNumCols = 0;
@@ -311,6 +348,8 @@ void ImageCache::ResetHelper(const ImageType& img)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ImageCache::Reset(const Image& imgGray, ResizeMethod method)
 {
+  std::lock_guard<std::mutex> lock(_mutex);
+  
   // This is kind of gross but this function should only ever be called from unit tests.
   // The tests were written when ImageCache was Reset with a Full image instead of a Sensor image.
   // Calling ResetHelper with an Image would have caused the image to be resized incorrectly
@@ -339,6 +378,8 @@ void ImageCache::Reset(const Image& imgGray, ResizeMethod method)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ImageCache::Reset(const ImageRGB& imgColor, ResizeMethod method)
 {
+  std::lock_guard<std::mutex> lock(_mutex);
+  
   // This is kind of gross but this function should only ever be called from unit tests.
   // The tests were written when ImageCache was Reset with a Full image instead of a Sensor image.
   // Calling ResetHelper with an ImageRGB would have caused the image to be resized incorrectly
@@ -367,6 +408,8 @@ void ImageCache::Reset(const ImageRGB& imgColor, ResizeMethod method)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ImageCache::Reset(const ImageBuffer& buffer)
 {
+  std::lock_guard<std::mutex> lock(_mutex);
+  
   // Note: This is a copy but is totally fine as ImageBuffer is just a wrapper around image data
   // so no images are actually copied
   _buffer = buffer;
@@ -376,6 +419,7 @@ void ImageCache::Reset(const ImageBuffer& buffer)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const Image& ImageCache::GetGray(ImageCacheSize size, GetType* getType)
 {
+  std::lock_guard<std::mutex> lock(_mutex);
   GetType dummy;
   const Image& imgGray = GetImageHelper<Image>(size, (getType == nullptr ? dummy : *getType));
   DEV_ASSERT(!imgGray.IsEmpty(), "ImageCache.GetGray.EmptyImage");
@@ -385,6 +429,7 @@ const Image& ImageCache::GetGray(ImageCacheSize size, GetType* getType)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const ImageRGB& ImageCache::GetRGB(ImageCacheSize size, GetType* getType)
 {
+  std::lock_guard<std::mutex> lock(_mutex);
   GetType dummy;
   const ImageRGB& imgRGB = GetImageHelper<ImageRGB>(size, (getType == nullptr ? dummy : *getType));
   DEV_ASSERT(!imgRGB.IsEmpty(), "ImageCache.GetRGB.EmptyImage");
@@ -402,6 +447,67 @@ inline bool IsRequestingColor<ImageRGB>() {
   return true;
 }
   
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class ImageType>
+static inline bool ConvertsDirectly(const ImageBuffer& buffer, ImageCacheSize size);
+
+template<>
+inline bool ConvertsDirectly<Image>(const ImageBuffer& buffer, ImageCacheSize size) {
+  return buffer.ConvertsDirectlyToGray(size);
+}
+
+template<>
+inline bool ConvertsDirectly<ImageRGB>(const ImageBuffer& buffer, ImageCacheSize size) {
+  return buffer.ConvertsDirectlyToRGB(size);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static inline ImageCacheSize GetLargerSize(ImageCacheSize size)
+{
+  DEV_ASSERT(ImageCacheSize::Full != size, "ImageCache.GetLargerSize.NothingLargerThanFull");
+  return static_cast<ImageCacheSize>(static_cast<u8>(size) - 1);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class ImageType>
+bool ImageCache::ShouldHalveFromLarger(ImageCacheSize size) const
+{
+  if(ImageCacheSize::Full == size || !_buffer.HasValidData())
+  {
+    return false;
+  }
+  
+  // Halving only stands in for the resize the buffer would do if that is a linear or area resize
+  const ResizeMethod method = _buffer.GetResizeMethod();
+  if(ResizeMethod::Linear != method && ResizeMethod::AverageArea != method)
+  {
+    return false;
+  }
+  
+  const ImageCacheSize largerSize = GetLargerSize(size);
+  if(GetNumRows(largerSize) != 2*GetNumRows(size) || GetNumCols(largerSize) != 2*GetNumCols(size))
+  {
+    return false;
+  }
+  
+  // Direct conversions from the raw data (e.g. halving Bayer data) are cheap and are what callers expect at
+  // those sizes, so only fill in the other sizes from the pyramid
+  return !ConvertsDirectly<ImageType>(_buffer, size);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class ImageType>
+ImageType& ImageCache::GetFromEntry(ResizedEntry& entry, ImageCacheSize size)
+{
+  if(!entry.IsValid<ImageType>() && ShouldHalveFromLarger<ImageType>(size))
+  {
+    GetType dummy;
+    const ImageType& largerImg = GetImageHelper<ImageType>(GetLargerSize(size), dummy);
+    return entry.SetFromLarger(largerImg);
+  }
+  return entry.Get<ImageType>();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 template<class ImageType>
 const ImageType& ImageCache::GetImageHelper(ImageCacheSize size, GetType& getType)
@@ -413,12 +519,15 @@ const ImageType& ImageCache::GetImageHelper(ImageCacheSize size, GetType& getTyp
   // We should compute a new entry (either "completely new" or reusing an invalidated entry at the same size) if:
   //  - there is no entry at the requested size, OR
   //  - the entry at the requested size is not valid for either ImageType, OR
-  //  - there is a valid entry at the requested (non-sensor) size, but color data is being requested and the cache
-  //     was originally reset with color data from which we could resize (instead of computing from gray)
+  //  - there is a valid entry at the requested (non-sensor) size without color data, but color data is being
+  //     requested and the cache was originally reset with color data from which we could resize (instead of
+  //     computing from gray)
+  // Once an entry has valid color data it is not recomputed, so images already handed out are never modified.
   const bool shouldComputeNewValidEntry = (iter == _resizedVersions.end() ||
                                            !iter->second.IsValid<void>() ||
                                            ((ImageCacheSize::Full != size) &&
-                                            HasColor() && IsRequestingColor<ImageType>()));
+                                            HasColor() && IsRequestingColor<ImageType>() &&
+                                            !iter->second.IsValid<ImageType>()));
   if(shouldComputeNewValidEntry)
   {
     if(iter == _resizedVersions.end())
@@ -430,7 +539,7 @@ const ImageType& ImageCache::GetImageHelper(ImageCacheSize size, GetType& getTyp
 
         DEV_ASSERT(insertion.second, "ImageCache.GetImageHelper.NewEntryNotInserted");
         
-        const ImageType& img = insertion.first->second.Get<ImageType>();
+        const ImageType& img = GetFromEntry<ImageType>(insertion.first->second, size);
         getType = GetType::NewEntry;
         
         return img;
@@ -464,7 +573,7 @@ const ImageType& ImageCache::GetImageHelper(ImageCacheSize size, GetType& getTyp
         entry.Update(origImg, size);
       }
       getType = GetType::ResizeIntoExisting;
-      return entry.Get<ImageType>();
+      return GetFromEntry<ImageType>(entry, size);
     }
   }
   else
@@ -476,7 +585,7 @@ const ImageType& ImageCache::GetImageHelper(ImageCacheSize size, GetType& getTyp
     // we will be computing it from the existing entry
     getType = (entry.IsValid<ImageType>() ? GetType::FullyCached : GetType::ComputeFromExisting);
     
-    ImageType& img = entry.Get<ImageType>();
+    ImageType& img = GetFromEntry<ImageType>(entry, size);
 
     VERBOSE_DEBUG_PRINT("ImageCache", "ImageCache.GetImageHelper.UsingCached",
                         "%s %s image from existing entry at t=%ums and scaleFactor=%.2f",
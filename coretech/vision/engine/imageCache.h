@@ -20,6 +20,7 @@
 #include "clad/types/imageFormats.h"
 
 #include <map>
+#include <mutex>
 
 namespace Anki {
 namespace Vision {
@@ -84,6 +85,10 @@ public:
   // Notes:
   //  * The result of HasColor is not changed by calling GetRGB.
   //  * These are non-const because they could compute a resized version on demand.
+  //  * These are safe to call from several threads at once (e.g. vision modes running in parallel). The returned
+  //    references stay valid, and their data unchanged, until the next Reset or ReleaseMemory.
+  //  * Assigning the result to another image shares its data instead of copying it. The cache does not write
+  //    into shared data on the next Reset, so the copy keeps this image for as long as it is held.
   static constexpr ImageCacheSize GetDefaultImageCacheSize() { return ImageCacheSize::Half; }
   const Image&    GetGray(ImageCacheSize size = GetDefaultImageCacheSize(), GetType* getType = nullptr);
   const ImageRGB& GetRGB(ImageCacheSize size  = GetDefaultImageCacheSize(), GetType* getType = nullptr);
@@ -123,7 +128,9 @@ private:
       Update(origImg, size);
     }
     
-    void Invalidate() { _hasValidGray = false; _hasValidRGB = false; _buffer.Invalidate(); }
+    // Memory is reused by the next Update/Get, unless someone still shares it (e.g. a result holding on to
+    // the last image), in which case it is let go so they keep seeing the old data (copy-on-write)
+    void Invalidate();
     
     template<class ImageType>
     ImageType& Get();
@@ -133,11 +140,18 @@ private:
 
     template<class ImageType>
     void Update(const ImageType& origImg, ImageCacheSize size);
+    
+    // Fill in ImageType by halving the same type from the entry at the next larger size
+    template<class ImageType>
+    ImageType& SetFromLarger(const ImageType& largerImg);
   };
 
   using ResizeVersionsMap = std::map<ImageCacheSize, ResizedEntry>;
   ResizeVersionsMap _resizedVersions;
   
+  // Guards _resizedVersions against concurrent Get calls computing new entries
+  std::mutex _mutex;
+  
   ResizeMethod GetMethod(ImageCacheSize size) const;
   
   template<class ImageType>
@@ -146,6 +160,15 @@ private:
   template<class ImageType>
   const ImageType& GetImageHelper(ImageCacheSize size, GetType& getType);
   
+  // Sizes form a pyramid: a size the buffer can't convert to directly is computed by halving the next larger
+  // size (computing that first if needed), rather than converting and resizing from the buffer every time.
+  // This reuses the levels other callers already asked for and keeps each level's memory across Resets.
+  template<class ImageType>
+  bool ShouldHalveFromLarger(ImageCacheSize size) const;
+  
+  template<class ImageType>
+  ImageType& GetFromEntry(ResizedEntry& entry, ImageCacheSize size);
+  
 }; // class ImageCache
   
 } // namespace Vision
@@ -27,9 +27,13 @@
 #include "util/helpers/quoteMacro.h"
 #include "util/threading/threadPriority.h"
 
+#include <condition_variable>
 #include <cstdio>
 #include <list>
 #include <fstream>
+#include <functional>
+#include <queue>
+#include <thread>
 
 // TODO: put this back if/when we start supporting other NeuralNetRunnerModels
 //#if USE_TENSORFLOW
@@ -72,8 +76,127 @@ namespace {
 }
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-NeuralNetRunner::NeuralNetRunner()
+struct NeuralNetRunner::Model
+{
+  std::unique_ptr<NeuralNets::INeuralNetModel> neuralNet;
+  
+  s32         processingWidth  = 0;
+  s32         processingHeight = 0;
+  s32         priority = 0;
+  TimeStamp_t processingPeriod_ms = 0;
+  
+  // Only used by whichever worker is currently running this model
+  Profiler    profiler;
+  
+  // Only used by the thread calling StartProcessingIfIdle: the next image is preprocessed into this one, which is
+  // then swapped with stagedImg
+  ImageRGB    scratchImg;
+  
+  //
+  // Everything below is guarded by NeuralNetRunner::_mutex
+  //
+  
+  // Preprocessed image waiting for inference, replaced by newer images until the model is free to take it
+  ImageRGB    stagedImg;
+  ImageRGB    stagedSourceImg;
+  bool        hasStagedImg = false;
+  
+  // Image currently being (or last) processed by a worker
+  ImageRGB    imgBeingProcessed;
+  ImageRGB    sourceImgBeingProcessed;
+  bool        isRunning = false;
+  bool        hasStarted = false;
+  TimeStamp_t lastStartTime_ms = 0;
+  
+  // Detections from images finished since the last GetDetections(), and the last of those images
+  std::list<SalientPoint> detections;
+  bool        hasDetections = false;
+  TimeStamp_t lastProcessedTime_ms = 0;
+  ImageRGB    lastProcessedSourceImg;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Fixed set of threads running queued jobs, highest priority first (FIFO within the same priority)
+class NeuralNetRunner::WorkerPool
+{
+public:
+  
+  explicit WorkerPool(s32 numThreads)
+  {
+    for(s32 i=0; i<numThreads; ++i)
+    {
+      _threads.emplace_back([this]() { Run(); });
+    }
+  }
+  
+  // Waits for jobs which are already running, but drops any still in the queue
+  ~WorkerPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _shouldStop = true;
+    }
+    _condition.notify_all();
+    for(auto& thread : _threads)
+    {
+      thread.join();
+    }
+  }
+  
+  void Push(s32 priority, std::function<void()>&& func)
+  {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _jobs.push(Job{priority, _numJobsPushed++, std::move(func)});
+    }
+    _condition.notify_one();
+  }
+  
+private:
+  
+  struct Job
+  {
+    s32 priority;
+    u64 order;
+    std::function<void()> func;
+    
+    // std::priority_queue pops the "largest" job
+    bool operator<(const Job& other) const {
+      return (priority == other.priority ? order > other.order : priority < other.priority);
+    }
+  };
+  
+  void Run()
+  {
+    while(true)
+    {
+      std::function<void()> func;
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _condition.wait(lock, [this]() { return _shouldStop || !_jobs.empty(); });
+        if(_shouldStop)
+        {
+          return;
+        }
+        func = std::move(const_cast<Job&>(_jobs.top()).func);
+        _jobs.pop();
+      }
+      func();
+    }
+  }
+  
+  std::vector<std::thread>  _threads;
+  std::priority_queue<Job>  _jobs;
+  u64                       _numJobsPushed = 0;
+  bool                      _shouldStop = false;
+  std::mutex                _mutex;
+  std::condition_variable   _condition;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+NeuralNetRunner::NeuralNetRunner(s32 numWorkerThreads)
 : _profiler("NeuralNetRunner")
+, _workerPool(new WorkerPool(std::max(numWorkerThreads, 1)))
 {
   
 }
@@ -81,7 +204,8 @@ NeuralNetRunner::NeuralNetRunner()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 NeuralNetRunner::~NeuralNetRunner()
 {
-  
+  // Stop the workers before the models they may be using go away
+  _workerPool.reset();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -89,19 +213,20 @@ Result NeuralNetRunner::Init(const std::string& modelPath, const std::string& ca
 {
   Result result = RESULT_OK;
 
-  _isInitialized = false;
   _cachePath = cachePath;
   
+  std::unique_ptr<Model> model(new Model());
+  
   std::string modelTypeString;
   if(JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::ModelType, modelTypeString))
   {
     if(NeuralNets::JsonKeys::TFLiteModelType == modelTypeString)
     {
-      _model.reset(new NeuralNets::TFLiteModel());
+      model->neuralNet.reset(new NeuralNets::TFLiteModel());
     }
     else if(NeuralNets::JsonKeys::OffboardModelType == modelTypeString)
     {
-      _model.reset(new NeuralNets::OffboardModel(_cachePath));
+      model->neuralNet.reset(new NeuralNets::OffboardModel(_cachePath));
     }
     else
     {
@@ -116,7 +241,7 @@ Result NeuralNetRunner::Init(const std::string& modelPath, const std::string& ca
   }
     
   _profiler.Tic("LoadModel");
-  result = _model->LoadModel(modelPath, config);
+  result = model->neuralNet->LoadModel(modelPath, config);
   _profiler.Toc("LoadModel");
   
   if(RESULT_OK != result)
@@ -125,39 +250,56 @@ Result NeuralNetRunner::Init(const std::string& modelPath, const std::string& ca
     return result;
   }
   
+  const std::string& name = model->neuralNet->GetName();
+  if(_models.find(name) != _models.end())
+  {
+    LOG_ERROR("NeuralNetRunner.Init.DuplicateModelName", "%s", name.c_str());
+    return RESULT_FAIL;
+  }
+  
   // Get the input height/width so we can do the resize and only need to share/copy/write as
   // small an image as possible for the standalone CNN process to pick up
-  if(false == JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::InputHeight, _processingHeight))
+  if(false == JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::InputHeight, model->processingHeight))
   {
     LOG_ERROR("NeuralNetRunner.Init.MissingConfig", "%s", NeuralNets::JsonKeys::InputHeight);
     return RESULT_FAIL;
   }
   
-  if(false == JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::InputWidth, _processingWidth))
+  if(false == JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::InputWidth, model->processingWidth))
   {
     LOG_ERROR("NeuralNetRunner.Init.MissingConfig", "%s", NeuralNets::JsonKeys::InputWidth);
     return RESULT_FAIL;
   }
+  
+  JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::Priority, model->priority);
+  JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::ProcessingPeriod, model->processingPeriod_ms);
 
   PRINT_NAMED_INFO("NeuralNetRunner.Init.LoadModelTime", "Loading model from '%s' took %.1fsec",
                    modelPath.c_str(), Util::MilliSecToSec(_profiler.AverageToc("LoadModel")));
 
   _profiler.SetPrintFrequency(config.get("ProfilingPrintFrequency_ms", 10000).asUInt());
   _profiler.SetDasLogFrequency(config.get("ProfilingEventLogFrequency_ms", 10000).asUInt());
+  
+  model->profiler.SetProfileGroupName(("NeuralNetRunner." + name).c_str());
+  model->profiler.SetPrintFrequency(config.get("ProfilingPrintFrequency_ms", 10000).asUInt());
+  model->profiler.SetDasLogFrequency(config.get("ProfilingEventLogFrequency_ms", 10000).asUInt());
 
-  // Clear the cache of any stale images/results:
-  Util::FileUtils::RemoveDirectory(_cachePath);
-  Util::FileUtils::CreateDirectory(_cachePath);
+  if(_models.empty())
+  {
+    // Clear the cache of any stale images/results:
+    Util::FileUtils::RemoveDirectory(_cachePath);
+    Util::FileUtils::CreateDirectory(_cachePath);
+  }
 
-  // Note: right now we should assume that we only will be running
-  // one model. This is definitely going to change but unitl
-  // we know how we want to handle a bit more let's not worry about it.
-  if(JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::VisualizationDir, _visualizationDirectory))
+  std::string visualizationDirectory;
+  if(JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::VisualizationDir, visualizationDirectory))
   {
-    Util::FileUtils::CreateDirectory(Util::FileUtils::FullFilePath({_cachePath, _visualizationDirectory}));
+    Util::FileUtils::CreateDirectory(Util::FileUtils::FullFilePath({_cachePath, visualizationDirectory}));
   }
 
-  _isInitialized = true;
+  _networkNames.push_back(name);
+  _models.emplace(name, std::move(model));
+  
   return result;
 }
 
@@ -202,131 +344,207 @@ void NeuralNetRunner::ApplyGamma(ImageRGB& img)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool NeuralNetRunner::StartProcessingIfIdle(ImageCache& imageCache)
+bool NeuralNetRunner::StartProcessingIfIdle(const std::set<std::string>& networkNames, ImageCache& imageCache,
+                                            const ImageRGB* sourceImg)
 {
-  if(!_isInitialized)
-  {
-    // This will spam the log, but only in the NeuralNets channel, plus it helps make it more obvious to a
-    // developer that something is wrong since it's easy to miss a model load failure (and associated error
-    // in the log) at startup.
-    //
-    // If you do see this error, it is likely one of two things:
-    //  1. Your model configuration in vision_config.json is wrong (look for other errors on load)
-    //  2. Git LFS has failed you. See: https://ankiinc.atlassian.net/browse/VIC-13455
-    LOG_INFO("NeuralNetRunner.StartProcessingIfIdle.NotInitialized", "t:%ums", imageCache.GetTimeStamp());
-    return false;
-  }
+  bool anyStarted = false;
+  bool haveCheckedColor = false;
   
-  // If we're not already processing an image with a "future", create one to process this image asynchronously.
-  if(!_future.valid())
+  for(const auto& networkName : networkNames)
   {
-    // Require color data
-    if(!imageCache.HasColor())
+    auto modelIter = _models.find(networkName);
+    if(modelIter == _models.end())
     {
-      LOG_PERIODIC_DEBUG(30, "NeuralNetRunner.StartProcessingIfIdle.NeedColorData", "");
-      return false;
+      // This will spam the log, but only in the NeuralNets channel, plus it helps make it more obvious to a
+      // developer that something is wrong since it's easy to miss a model load failure (and associated error
+      // in the log) at startup.
+      //
+      // If you do see this error, it is likely one of two things:
+      //  1. Your model configuration in vision_config.json is wrong (look for other errors on load)
+      //  2. Git LFS has failed you. See: https://ankiinc.atlassian.net/browse/VIC-13455
+      LOG_INFO("NeuralNetRunner.StartProcessingIfIdle.NotInitialized", "%s t:%ums",
+               networkName.c_str(), imageCache.GetTimeStamp());
+      continue;
     }
-  
-    if(kNeuralNetRunner_SaveImages == 2)
-    {
-      const Vision::ImageRGB& img = imageCache.GetRGB(ImageCacheSize::Half);
-      const std::string saveFilename = Util::FileUtils::FullFilePath({_cachePath, "half",
-        std::to_string(img.GetTimestamp()) + ".png"});
-      img.Save(saveFilename);
-    }
-
-    // Resize to processing size
-    _imgBeingProcessed.Allocate(_processingHeight, _processingWidth);
-    const ImageCacheSize kImageSize = ImageCacheSize::Half;
-    const Vision::ResizeMethod kResizeMethod = Vision::ResizeMethod::Linear;
-    const Vision::ImageRGB& imgOrig = imageCache.GetRGB(kImageSize);
-    imgOrig.Resize(_imgBeingProcessed, kResizeMethod);
     
-    // Apply gamma (no-op if gamma is set to 1.0)
-    ApplyGamma(_imgBeingProcessed);
+    Model& model = *modelIter->second;
     
-    if(kNeuralNetRunner_SaveImages == 1)
+    // A model which is due for a new image takes this one. A model which is still busy but already has a (now
+    // older) image staged takes this one instead, so that it starts on the freshest image once it is done.
     {
-      const std::string saveFilename = Util::FileUtils::FullFilePath({_cachePath, "resized",
-        std::to_string(_imgBeingProcessed.GetTimestamp()) + ".png"});
-      _imgBeingProcessed.Save(saveFilename);
+      std::lock_guard<std::mutex> lock(_mutex);
+      const bool isDue = (!model.hasStarted ||
+                          imageCache.GetTimeStamp() >= model.lastStartTime_ms + model.processingPeriod_ms);
+      if(!isDue && !model.hasStagedImg)
+      {
+        continue;
+      }
     }
-
-    // Store its size relative to original size so we can rescale object detections later
-    _heightScale = (f32)imgOrig.GetNumRows();
-    _widthScale  = (f32)imgOrig.GetNumCols();
     
-    if(_model->IsVerbose())
+    if(!haveCheckedColor)
     {
-      LOG_INFO("NeuralNetRunner.StartProcessingIfIdle.ProcessingImage",
-               "Detecting salient points in %dx%d image t=%u",
-               _imgBeingProcessed.GetNumCols(), _imgBeingProcessed.GetNumRows(), _imgBeingProcessed.GetTimestamp());
+      // Require color data
+      if(!imageCache.HasColor())
+      {
+        LOG_PERIODIC_DEBUG(30, "NeuralNetRunner.StartProcessingIfIdle.NeedColorData", "");
+        return false;
+      }
+      haveCheckedColor = true;
     }
     
-    _future = std::async(std::launch::async, [this]() { return RunModel(); });
+    // Preprocess outside the lock, while the model may still be running on the previous image
+    Preprocess(model, imageCache);
     
-    // We did start processing the given image
-    return true;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      std::swap(model.scratchImg, model.stagedImg);
+      model.stagedSourceImg = (nullptr != sourceImg ? *sourceImg : ImageRGB());
+      model.hasStagedImg = true;
+      if(!model.isRunning)
+      {
+        StartInference(model);
+        anyStarted = true;
+      }
+    }
+  }
+  
+  return anyStarted;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void NeuralNetRunner::Preprocess(Model& model, ImageCache& imageCache)
+{
+  auto ticToc = _profiler.TicToc("Preprocess");
+  
+  if(kNeuralNetRunner_SaveImages == 2)
+  {
+    const Vision::ImageRGB& img = imageCache.GetRGB(ImageCacheSize::Half);
+    const std::string saveFilename = Util::FileUtils::FullFilePath({_cachePath, "half",
+      std::to_string(img.GetTimestamp()) + ".png"});
+    img.Save(saveFilename);
   }
+
+  // Resize to processing size
+  model.scratchImg.Allocate(model.processingHeight, model.processingWidth);
+  const ImageCacheSize kImageSize = ImageCacheSize::Half;
+  const Vision::ResizeMethod kResizeMethod = Vision::ResizeMethod::Linear;
+  const Vision::ImageRGB& imgOrig = imageCache.GetRGB(kImageSize);
+  imgOrig.Resize(model.scratchImg, kResizeMethod);
+  
+  // Apply gamma (no-op if gamma is set to 1.0)
+  ApplyGamma(model.scratchImg);
+  
+  if(kNeuralNetRunner_SaveImages == 1)
+  {
+    const std::string saveFilename = Util::FileUtils::FullFilePath({_cachePath, "resized",
+      std::to_string(model.scratchImg.GetTimestamp()) + ".png"});
+    model.scratchImg.Save(saveFilename);
+  }
+  
+  if(model.neuralNet->IsVerbose())
+  {
+    LOG_INFO("NeuralNetRunner.Preprocess.ProcessingImage",
+             "%s: Detecting salient points in %dx%d image t=%u", model.neuralNet->GetName().c_str(),
+             model.scratchImg.GetNumCols(), model.scratchImg.GetNumRows(), model.scratchImg.GetTimestamp());
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void NeuralNetRunner::StartInference(Model& model)
+{
+  DEV_ASSERT(model.hasStagedImg && !model.isRunning, "NeuralNetRunner.StartInference.ModelNotReady");
   
-  // We were not idle, so did not start processing the new image
-  return false;
+  std::swap(model.stagedImg, model.imgBeingProcessed);
+  std::swap(model.stagedSourceImg, model.sourceImgBeingProcessed);
+  model.stagedSourceImg = ImageRGB();
+  model.hasStagedImg = false;
+  model.isRunning = true;
+  model.hasStarted = true;
+  model.lastStartTime_ms = model.imgBeingProcessed.GetTimestamp();
+  
+  _workerPool->Push(model.priority, [this, &model]() { RunModel(model); });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-std::list<SalientPoint> NeuralNetRunner::RunModel()
+void NeuralNetRunner::RunModel(Model& model)
 {
-  Util::SetThreadName(pthread_self(), _model->GetName());
+  Util::SetThreadName(pthread_self(), model.neuralNet->GetName());
   
   std::list<SalientPoint> salientPoints;
   
-  _profiler.Tic("Model.Detect");
-  Result result = _model->Detect(_imgBeingProcessed, salientPoints);
-  _profiler.Toc("Model.Detect");
+  model.profiler.Tic("Model.Detect");
+  Result result = model.neuralNet->Detect(model.imgBeingProcessed, salientPoints);
+  model.profiler.Toc("Model.Detect");
   if(RESULT_OK != result)
   {
-    LOG_WARNING("NeuralNetRunner.RunModel.ModelDetectFailed", "");
+    LOG_WARNING("NeuralNetRunner.RunModel.ModelDetectFailed", "%s", model.neuralNet->GetName().c_str());
   }
   
-  return salientPoints;
+  std::lock_guard<std::mutex> lock(_mutex);
+  model.detections.splice(model.detections.end(), salientPoints);
+  model.hasDetections = true;
+  model.lastProcessedTime_ms = model.imgBeingProcessed.GetTimestamp();
+  std::swap(model.lastProcessedSourceImg, model.sourceImgBeingProcessed);
+  model.sourceImgBeingProcessed = ImageRGB();
+  model.isRunning = false;
+  
+  // If the next image is already waiting, start on it right away rather than on the next StartProcessingIfIdle
+  if(model.hasStagedImg)
+  {
+    StartInference(model);
+  }
 }
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool NeuralNetRunner::GetDetections(std::list<SalientPoint>& salientPoints)
+bool NeuralNetRunner::GetDetections(const std::string& networkName, std::list<SalientPoint>& salientPoints,
+                                    TimeStamp_t& imageTimestamp, ImageRGB* sourceImg)
 {
-  if(_future.valid())
+  auto modelIter = _models.find(networkName);
+  if(modelIter == _models.end())
   {
-    // Check the future's status and keep waiting until it's ready.
-    // Once it's ready, return the result.
-    const auto kWaitForTime = std::chrono::microseconds(500);
-    const std::future_status futureStatus = _future.wait_for(kWaitForTime);
-    if(std::future_status::ready == futureStatus)
+    return false;
+  }
+  
+  Model& model = *modelIter->second;
+  
+  std::list<SalientPoint> newSalientPoints;
+  TimeStamp_t processedTime_ms = 0;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if(!model.hasDetections)
     {
-      auto newSalientPoints = _future.get();
-      std::copy(newSalientPoints.begin(), newSalientPoints.end(), std::back_inserter(salientPoints));
-
-      DEV_ASSERT(!_future.valid(), "NeuralNetRunner.GetDetections.FutureStillValid");
-      
-      if(ANKI_DEV_CHEATS && _model->IsVerbose())
-      {
-        if(salientPoints.empty())
-        {
-          LOG_INFO("NeuralNetRunner.GetDetections.NoSalientPoints",
-                   "t=%ums", _imgBeingProcessed.GetTimestamp());
-        }
-        for(auto const& salientPoint : salientPoints)
-        {
-          LOG_INFO("NeuralNetRunner.GetDetections.FoundSalientPoint",
-                   "t=%ums Name:%s Score:%.3f",
-                   _imgBeingProcessed.GetTimestamp(), salientPoint.description.c_str(), salientPoint.score);
-        }
-      }
-      
-      return true;
+      return false;
     }
+    newSalientPoints.swap(model.detections);
+    model.hasDetections = false;
+    processedTime_ms = model.lastProcessedTime_ms;
+    if(nullptr != sourceImg)
+    {
+      std::swap(*sourceImg, model.lastProcessedSourceImg);
+    }
+    model.lastProcessedSourceImg = ImageRGB();
   }
   
-  return false;
+  imageTimestamp = processedTime_ms;
+  
+  if(ANKI_DEV_CHEATS && model.neuralNet->IsVerbose())
+  {
+    if(newSalientPoints.empty())
+    {
+      LOG_INFO("NeuralNetRunner.GetDetections.NoSalientPoints",
+               "%s: t=%ums", networkName.c_str(), processedTime_ms);
+    }
+    for(auto const& salientPoint : newSalientPoints)
+    {
+      LOG_INFO("NeuralNetRunner.GetDetections.FoundSalientPoint",
+               "%s: t=%ums Name:%s Score:%.3f",
+               networkName.c_str(), processedTime_ms, salientPoint.description.c_str(), salientPoint.score);
+    }
+  }
+  
+  salientPoints.splice(salientPoints.end(), newSalientPoints);
+  
+  return true;
 }
   
 } // namespace Vision
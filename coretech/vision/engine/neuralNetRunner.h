@@ -11,6 +11,11 @@
  *              Abstracts away the private implementation around what kind of inference engine is used
  *              and runs asynchronously since forward inference through deep networks is generally "slow".
  *
+ *              Can host several models, each with its own processing period and priority, which share a small
+ *              pool of worker threads for inference. Each model is pipelined: the next image is resized (and
+ *              gamma corrected) while the model is still busy with the current one, so inference on it can start
+ *              as soon as the worker is done, instead of on the next call to StartProcessingIfIdle.
+ *
  * Copyright: Anki, Inc. 2017
  **/
 
@@ -25,8 +30,13 @@
 
 #include "clad/types/salientPointTypes.h"
 
-#include <future>
+#include <array>
 #include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
 
 // Forward declaration:
 namespace Json {
@@ -47,51 +57,71 @@ class NeuralNetRunner
 {
 public:
   
-  NeuralNetRunner();
+  // All models added to this runner share numWorkerThreads threads for running inference
+  explicit NeuralNetRunner(s32 numWorkerThreads = 1);
   ~NeuralNetRunner();
   
-  // Load a DNN model described by Json config
+  // Load a DNN model described by Json config. Can be called once per model to run several models with this runner.
+  // Optional config entries: "processingPeriod_ms" (minimum time between images started for this model) and
+  // "priority" (when more models are ready to run than there are workers, higher priority ones run first).
   Result Init(const std::string& modelPath, const std::string& cachePath, const Json::Value& config);
   
-  // Returns true if image was used, false if otherwise occupied or image wasn't suitable (e.g., not color)
-  bool StartProcessingIfIdle(ImageCache& imageCache);
+  // Offers the image to each of the given models which is due or already holding an older image. Models which are
+  // idle start on it right away, busy ones keep it staged and start on it as soon as they are done, unless a newer
+  // image replaces it first. Returns true only if inference started on this image for at least one model.
+  // Unknown model names are ignored.
+  // If given, sourceImg is handed back by GetDetections along with the detections from this image (e.g. to save it).
+  bool StartProcessingIfIdle(const std::set<std::string>& networkNames, ImageCache& imageCache,
+                             const ImageRGB* sourceImg = nullptr);
+  
+  // Returns true if the given model has finished processing any images since the last call and populates
+  // salientPoints with their detections. imageTimestamp is set to the timestamp of the (latest) image they came from
+  // and, if that image was offered with a sourceImg, sourceImg is set to it (otherwise it is cleared).
+  bool GetDetections(const std::string& networkName, std::list<SalientPoint>& salientPoints,
+                     TimeStamp_t& imageTimestamp, ImageRGB* sourceImg = nullptr);
   
-  // Returns true if processing of the last image provided using StartProcessingIfIdle is complete
-  // and populates salientPoints with any detections.
-  bool GetDetections(std::list<SalientPoint>& salientPoints);
+  // Names of all models successfully added with Init()
+  const std::vector<std::string>& GetNetworkNames() const { return _networkNames; }
   
   // Example usage:
   //
-  //  if(GetDetections(salientPoints)) {
-  //    <do stuff with salientPoints>
+  //  for(const auto& networkName : GetNetworkNames()) {
+  //    if(GetDetections(networkName, salientPoints, imageTimestamp)) {
+  //      <do stuff with salientPoints>
+  //    }
   //  }
   //
-  //  StartProcessingIfIdle(imageCache);
+  //  StartProcessingIfIdle(networkNames, imageCache);
   //
   
 private:
   
+  struct Model;
+  class WorkerPool;
+  
   Profiler _profiler;
   
-  std::unique_ptr<NeuralNets::INeuralNetModel> _model;
-  std::future<std::list<SalientPoint>> _future; // for processing aysnchronously
-
-  // We process asynchronsously, so need a copy of the image data (at processing resolution)
-  ImageRGB              _imgBeingProcessed;
+  std::map<std::string, std::unique_ptr<Model>> _models;
+  std::vector<std::string>                      _networkNames;
+  
+  // Guards the state shared between each Model and the worker threads (see Model)
+  std::mutex                  _mutex;
+  std::unique_ptr<WorkerPool> _workerPool;
   
   std::string           _cachePath;
-  std::string           _visualizationDirectory;
-  bool                  _isInitialized = false;
-  s32                   _processingWidth;
-  s32                   _processingHeight;
-  f32                   _widthScale = 1.f;
-  f32                   _heightScale = 1.f;
-  f32                   _currentGamma;
+  f32                   _currentGamma = 0.f;
   std::array<u8,256>    _gammaLUT{};
   
   void ApplyGamma(ImageRGB& img);
   
-  std::list<SalientPoint> RunModel();
+  // Resize (and gamma correct) the image for the given model into its staged image
+  void Preprocess(Model& model, ImageCache& imageCache);
+  
+  // Hands the model's staged image to the workers. Must hold _mutex, and the model must be idle.
+  void StartInference(Model& model);
+  
+  // Runs on a worker thread
+  void RunModel(Model& model);
   
 }; // class NeuralNetworkRunner
   
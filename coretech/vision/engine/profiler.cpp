@@ -11,8 +11,11 @@
  **/
 
 #include "coretech/vision/engine/profiler.h"
+#include "util/cpuProfiler/cpuTraceRecorder.h"
 #include "util/logging/logging.h"
 
+#include <type_traits>
+
 namespace Anki {
 namespace Vision {
 
@@ -32,18 +35,35 @@ namespace Vision {
 
   void Profiler::SetProfileGroupName(const char* name) {}
 
-  void Profiler::Tic(const char*) { }
+  void Profiler::Tic(const char* timerName)
+  {
+  #if ANKI_CPU_PROFILER_ENABLED
+    // Timers are only kept while a trace is being captured
+    if(Util::CpuTraceRecorder::GetInstance().IsCapturing())
+    {
+      _timers[timerName].startTime = ClockType::now();
+    }
+  #endif
+  }
 
-  double Profiler::Toc(const char*) { return 0.; }
+  double Profiler::Toc(const char* timerName)
+  {
+  #if ANKI_CPU_PROFILER_ENABLED
+    auto timerIter = _timers.find(timerName);
+    if(timerIter != _timers.end())
+    {
+      AddTraceSpan(timerName, timerIter->second);
+      // Reset, so a Toc without a Tic during a later capture doesn't record a stale span
+      timerIter->second.startTime = std::chrono::time_point<ClockType>();
+    }
+  #endif
+    return 0.;
+  }
 
   double Profiler::AverageToc(const char* timerName) { return 0.; }
 
   void Profiler::PrintAverageTiming() { }
 
-  Profiler::TicTocObject::TicTocObject(Profiler& profiler, const char* timerName) { }
-
-  Profiler::TicTocObject::~TicTocObject() = default;
-
 # else
 
   void Profiler::Tic(const char* timerName)
@@ -88,6 +108,10 @@ namespace Vision {
       timer.Update();
       const auto currentTime = ClockType::now();
 
+    #if ANKI_CPU_PROFILER_ENABLED
+      AddTraceSpan(timerName, timer);
+    #endif
+
       // Print to log if it's time
       if(IsTimeToPrintOrLog(currentTime, _timeBetweenPrints_ms, timer.lastPrintTime))
       {
@@ -195,6 +219,26 @@ namespace Vision {
     timer.countAtLastDasLog = timer.count;
   }
 
+# endif // ANKI_VISION_PROFILER
+
+#if ANKI_CPU_PROFILER_ENABLED
+
+  void Profiler::AddTraceSpan(const char* timerName, Timer& timer)
+  {
+    static_assert(std::is_same<ClockType, Util::CpuProfileClock>::value,
+                  "Timer times are passed to CpuTraceRecorder as they are");
+
+    Util::CpuTraceRecorder& traceRecorder = Util::CpuTraceRecorder::GetInstance();
+    if(traceRecorder.IsCapturing() && (timer.startTime != std::chrono::time_point<ClockType>()))
+    {
+      traceRecorder.AddSpan("vision", timerName, timer.startTime, ClockType::now());
+    }
+  }
+
+#endif // ANKI_CPU_PROFILER_ENABLED
+
+#if ANKI_VISION_PROFILER || ANKI_CPU_PROFILER_ENABLED
+
   Profiler::TicTocObject::TicTocObject(Profiler& profiler, const char* timerName)
   : _profiler(profiler)
   , _timerName(timerName)
@@ -207,7 +251,13 @@ namespace Vision {
     _profiler.Toc(_timerName);
   }
 
-# endif // ANKI_VISION_PROFILER
+#else
+
+  Profiler::TicTocObject::TicTocObject(Profiler& profiler, const char* timerName) { }
+
+  Profiler::TicTocObject::~TicTocObject() = default;
+
+#endif
 
 } // namespace Vision
 } // namespace Anki
@@ -22,6 +22,8 @@
 #endif
 #endif // ANKI_VISION_PROFILER
 
+#include "util/cpuProfiler/cpuProfilerSettings.h"
+
 #include <chrono>
 #include <unordered_map>
 #include <string>
@@ -82,7 +84,7 @@ namespace Vision {
       TicTocObject(Profiler& profiler, const char* timerName);
       ~TicTocObject();
     private:
-      #if ANKI_VISION_PROFILER
+      #if ANKI_VISION_PROFILER || ANKI_CPU_PROFILER_ENABLED
       Profiler&   _profiler;
       const char* _timerName = nullptr;
       #endif
@@ -129,6 +131,11 @@ namespace Vision {
     void PrintTimerData(const char* name, Timer& timer);
     void LogTimerDataToDAS(const char* name, Timer& timer);
 
+    #if ANKI_CPU_PROFILER_ENABLED
+    // Timers also show up as spans in CpuProfiler trace captures, even with ANKI_VISION_PROFILER off
+    void AddTraceSpan(const char* timerName, Timer& timer);
+    #endif
+
   }; // class Profiler
 
   inline Profiler::TicTocObject Profiler::TicToc(const char* timerName) {
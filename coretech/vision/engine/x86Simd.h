@@ -0,0 +1,84 @@
+/**
+ * File: x86Simd.h
+ *
+ * Description: Helpers for the SSE4.1 / AVX2 versions of image conversions that run on x86 (Webots, replay servers).
+ *              x86 builds don't enable either instruction set globally, so functions using them are compiled with
+ *              ANKI_X86_TARGET_SSE41 / ANKI_X86_TARGET_AVX2 and only called once the CPU checks below pass.
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#ifndef __Anki_Coretech_Vision_Engine_X86Simd_H__
+#define __Anki_Coretech_Vision_Engine_X86Simd_H__
+
+#if !defined(__ARM_NEON__) && (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#  define ANKI_X86_SIMD 1
+#else
+#  define ANKI_X86_SIMD 0
+#endif
+
+#if ANKI_X86_SIMD
+
+#include "coretech/common/shared/types.h"
+
+#include <immintrin.h>
+
+#define ANKI_X86_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define ANKI_X86_TARGET_AVX2  __attribute__((target("avx2")))
+
+namespace Anki {
+namespace Vision {
+namespace X86 {
+
+// Instruction sets the functions here can use, in increasing order
+enum class InstructionSet
+{
+  None,
+  SSE41,
+  AVX2,
+};
+
+// Highest instruction set the SIMD paths may use, on top of what the CPU supports. Only meant for tests and
+// benchmarks, to run each path (including the plain fallbacks) on the same machine and compare them.
+inline InstructionSet& MaxInstructionSet()
+{
+  static InstructionSet maxInstructionSet = InstructionSet::AVX2;
+  return maxInstructionSet;
+}
+
+inline bool HasSSE41()
+{
+  static const bool hasSSE41 = __builtin_cpu_supports("sse4.1");
+  return hasSSE41 && (MaxInstructionSet() >= InstructionSet::SSE41);
+}
+
+inline bool HasAVX2()
+{
+  static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+  return hasAVX2 && (MaxInstructionSet() >= InstructionSet::AVX2);
+}
+
+// Interleave 8 pixels from rg = [R0..R7 G0..G7] and b = [B0..B7 ...] into 24 bytes of RGB at dst
+ANKI_X86_TARGET_SSE41
+inline void StoreRGB24x8(u8* dst, __m128i rg, __m128i b)
+{
+  const char Z = (char)0x80;
+  const __m128i rgMask1 = _mm_setr_epi8(0, 8, Z, 1, 9, Z, 2, 10, Z, 3, 11, Z, 4, 12, Z, 5);
+  const __m128i bMask1  = _mm_setr_epi8(Z, Z, 0, Z, Z, 1, Z, Z,  2, Z, Z,  3, Z, Z,  4, Z);
+  const __m128i rgMask2 = _mm_setr_epi8(13, Z, 6, 14, Z, 7, 15, Z, Z, Z, Z, Z, Z, Z, Z, Z);
+  const __m128i bMask2  = _mm_setr_epi8(Z,  5, Z, Z,  6, Z, Z,  7, Z, Z, Z, Z, Z, Z, Z, Z);
+
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                   _mm_or_si128(_mm_shuffle_epi8(rg, rgMask1), _mm_shuffle_epi8(b, bMask1)));
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 16),
+                   _mm_or_si128(_mm_shuffle_epi8(rg, rgMask2), _mm_shuffle_epi8(b, bMask2)));
+}
+
+} // namespace X86
+} // namespace Vision
+} // namespace Anki
+
+#endif // ANKI_X86_SIMD
+
+#endif // __Anki_Coretech_Vision_Engine_X86Simd_H__
@@ -307,8 +307,7 @@ void CompositeImage::OverlayImageWithFrame(ImageRGBA& baseImage,
         }
         case SpriteRenderMethod::CustomHue:
         {
-          Vision::HueSatWrapper::ImageSize imageSize(static_cast<uint32_t>(height),
-                                                     static_cast<uint32_t>(width));
+          // Sprites are tinted with a per-value lookup, so no hue/saturation images are allocated here
           std::shared_ptr<Vision::HueSatWrapper> hsImageHandle;
           
           const bool shouldRenderInEyeHue = (spriteBox.renderConfig.hue == 0) &&
@@ -326,13 +325,10 @@ void CompositeImage::OverlayImageWithFrame(ImageRGBA& baseImage,
             // do something better
             auto hue = _faceHSImageHandle->GetHue();
             auto sat = _faceHSImageHandle->GetSaturation();
-            hsImageHandle = std::make_shared<Vision::HueSatWrapper>(hue,
-                                                                     sat,
-                                                                     imageSize);
+            hsImageHandle = std::make_shared<Vision::HueSatWrapper>(hue, sat);
           }else{
             hsImageHandle = std::make_shared<Vision::HueSatWrapper>(spriteBox.renderConfig.hue,
-                                                                     spriteBox.renderConfig.saturation,
-                                                                     imageSize);
+                                                                     spriteBox.renderConfig.saturation);
           }
           
           // Render the sprite - use the cached RGBA image if possible
@@ -0,0 +1,223 @@
+/**
+* File: spriteAtlas.cpp
+*
+* Description: Read only view of a memory mapped file of pre-decoded sprites, so that
+* sprites can be used without decoding their PNGs
+*
+* Copyright: Anki, Inc. 2026
+*
+**/
+
+
+#include "coretech/vision/shared/spriteCache/spriteAtlas.h"
+
+#include "coretech/vision/engine/image.h"
+#include "util/logging/logging.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define LOG_CHANNEL "SpriteAtlas"
+
+namespace Anki {
+namespace Vision {
+
+namespace{
+const char kMagic[4] = {'A', 'K', 'S', 'A'};
+constexpr size_t kHeaderSize = 16;
+constexpr size_t kPixelDataAlignment = 16;
+
+enum PixelFormat : uint32_t {
+  Gray8    = 0,
+  RGBA8888 = 1,
+};
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+struct SpriteAtlas::Entry {
+  uint32_t pathOffset;
+  uint32_t pathLength;
+  uint64_t fileSize;
+  uint64_t dataOffset;
+  int32_t  numRows;
+  int32_t  numCols;
+  uint32_t format;
+  uint32_t reserved;
+};
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SpriteAtlas::~SpriteAtlas()
+{
+  Close();
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SpriteAtlas::Open(const std::string& atlasPath, const std::string& resourcesPath)
+{
+  static_assert(sizeof(Entry) == 40, "Entry is read in place from the atlas file");
+
+  Close();
+
+  const int fd = open(atlasPath.c_str(), O_RDONLY);
+  if(fd < 0){
+    LOG_INFO("SpriteAtlas.Open.NoAtlas", "No sprite atlas at %s, sprites will be decoded from PNG", atlasPath.c_str());
+    return false;
+  }
+
+  // Mapped read only. Sprites are copied out of it, so nothing can write to the shared pixels
+  struct stat st;
+  void* data = MAP_FAILED;
+  if((fstat(fd, &st) == 0) && (st.st_size >= static_cast<off_t>(kHeaderSize))){
+    data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  close(fd);
+
+  if(data == MAP_FAILED){
+    LOG_WARNING("SpriteAtlas.Open.MapFailed", "Unable to map %s", atlasPath.c_str());
+    return false;
+  }
+
+  _data = static_cast<uint8_t*>(data);
+  _size = static_cast<size_t>(st.st_size);
+
+  uint32_t version = 0;
+  uint32_t numEntries = 0;
+  memcpy(&version, _data + 4, sizeof(version));
+  memcpy(&numEntries, _data + 8, sizeof(numEntries));
+  if((memcmp(_data, kMagic, sizeof(kMagic)) != 0) || (version != kFormatVersion)){
+    LOG_WARNING("SpriteAtlas.Open.WrongVersion", "Ignoring %s (version %u, expected %u)",
+                atlasPath.c_str(), version, kFormatVersion);
+    Close();
+    return false;
+  }
+
+  // Validate every entry once here, so that lookups don't have to
+  if((kHeaderSize + static_cast<size_t>(numEntries) * sizeof(Entry)) > _size){
+    LOG_WARNING("SpriteAtlas.Open.Truncated", "%s is truncated", atlasPath.c_str());
+    Close();
+    return false;
+  }
+  _entries = reinterpret_cast<const Entry*>(_data + kHeaderSize);
+  _numEntries = numEntries;
+  for(size_t i = 0; i < _numEntries; ++i){
+    const Entry& entry = _entries[i];
+    const size_t bytesPerPixel = (entry.format == RGBA8888) ? 4 : 1;
+    const uint64_t dataLength = static_cast<uint64_t>(entry.numRows) * static_cast<uint64_t>(entry.numCols) * bytesPerPixel;
+    const bool isValid = (entry.pathOffset <= _size) && (entry.pathLength <= _size - entry.pathOffset) &&
+                         ((entry.format == Gray8) || (entry.format == RGBA8888)) &&
+                         (entry.numRows > 0) && (entry.numCols > 0) &&
+                         ((entry.dataOffset % kPixelDataAlignment) == 0) &&
+                         (entry.dataOffset <= _size) && (dataLength <= _size - entry.dataOffset);
+    if(!isValid){
+      LOG_WARNING("SpriteAtlas.Open.Corrupt", "%s has an invalid entry %zu", atlasPath.c_str(), i);
+      Close();
+      return false;
+    }
+  }
+
+  _resourcesPath = resourcesPath;
+
+  LOG_INFO("SpriteAtlas.Open", "Mapped %zu sprites (%zu bytes) from %s", _numEntries, _size, atlasPath.c_str());
+  return true;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SpriteAtlas::Close()
+{
+  if(_data != nullptr){
+    munmap(const_cast<uint8_t*>(_data), _size);
+  }
+  _data = nullptr;
+  _size = 0;
+  _entries = nullptr;
+  _numEntries = 0;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const SpriteAtlas::Entry* SpriteAtlas::FindEntry(const std::string& fullSpritePath) const
+{
+  if(!IsOpen() ||
+     (fullSpritePath.size() <= _resourcesPath.size() + 1) ||
+     (fullSpritePath.compare(0, _resourcesPath.size(), _resourcesPath) != 0) ||
+     (fullSpritePath[_resourcesPath.size()] != '/')){
+    return nullptr;
+  }
+
+  const char* relativePath = fullSpritePath.c_str() + _resourcesPath.size() + 1;
+  const size_t relativePathLength = fullSpritePath.size() - _resourcesPath.size() - 1;
+  auto comparePath = [this, relativePath, relativePathLength](const Entry& entry){
+    const int cmp = memcmp(_data + entry.pathOffset, relativePath, std::min<size_t>(entry.pathLength, relativePathLength));
+    if(cmp != 0){
+      return cmp;
+    }
+    return (entry.pathLength < relativePathLength) ? -1 : ((entry.pathLength > relativePathLength) ? 1 : 0);
+  };
+
+  const Entry* end = _entries + _numEntries;
+  const Entry* iter = std::lower_bound(_entries, end, 0, [&comparePath](const Entry& entry, int){
+    return comparePath(entry) < 0;
+  });
+  if((iter == end) || (comparePath(*iter) != 0)){
+    return nullptr;
+  }
+
+  // Fall back to the PNG if it has been replaced since the atlas was built (e.g. while iterating on assets)
+  struct stat st;
+  if((stat(fullSpritePath.c_str(), &st) != 0) || (static_cast<uint64_t>(st.st_size) != iter->fileSize)){
+    LOG_INFO("SpriteAtlas.FindEntry.Stale", "%s has changed since the atlas was built", relativePath);
+    return nullptr;
+  }
+
+  return iter;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SpriteAtlas::GetSprite(const std::string& fullSpritePath, Image& outImage) const
+{
+  const Entry* entry = FindEntry(fullSpritePath);
+  if(entry == nullptr){
+    return false;
+  }
+
+  // The wrapped pixels are only read from
+  uint8_t* pixels = const_cast<uint8_t*>(_data + entry->dataOffset);
+  if(entry->format == Gray8){
+    Image(entry->numRows, entry->numCols, pixels).CopyTo(outImage);
+  }else{
+    outImage = ImageRGBA(entry->numRows, entry->numCols, reinterpret_cast<u32*>(pixels)).ToGray();
+  }
+  return true;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SpriteAtlas::GetSprite(const std::string& fullSpritePath, ImageRGBA& outImage) const
+{
+  const Entry* entry = FindEntry(fullSpritePath);
+  if(entry == nullptr){
+    return false;
+  }
+
+  // The wrapped pixels are only read from
+  uint8_t* pixels = const_cast<uint8_t*>(_data + entry->dataOffset);
+  if(entry->format == RGBA8888){
+    ImageRGBA(entry->numRows, entry->numCols, reinterpret_cast<u32*>(pixels)).CopyTo(outImage);
+  }else{
+    outImage.SetFromGray(Image(entry->numRows, entry->numCols, pixels));
+  }
+  return true;
+}
+
+
+} // namespace Vision
+} // namespace Anki
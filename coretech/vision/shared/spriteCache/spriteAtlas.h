@@ -0,0 +1,74 @@
+/**
+* File: spriteAtlas.h
+*
+* Description: Read only view of a memory mapped file of pre-decoded sprites, so that
+* sprites can be used without decoding their PNGs. The file is generated from the deployed
+* sprites by tools/animationScripts/buildSpriteAtlas.py, which resources/CMakeLists.txt runs when
+* Pillow is available
+*
+* File layout (little endian, offsets from the start of the file):
+*   header:  magic "AKSA", u32 format version, u32 entry count, u32 reserved
+*   entries: sorted by path relative to the resources dir, each u32 path offset, u32 path length,
+*            u64 PNG file size, u64 pixel data offset (16 byte aligned), s32 rows, s32 cols,
+*            u32 pixel format (0 = gray8, 1 = RGBA8888), u32 reserved
+*   then the path strings and the pixel data
+*
+* Copyright: Anki, Inc. 2026
+*
+**/
+
+#ifndef __Vision_Shared_SpriteAtlas_H__
+#define __Vision_Shared_SpriteAtlas_H__
+
+#include "util/helpers/noncopyable.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Anki {
+namespace Vision {
+
+// forward declaration
+class ImageRGBA;
+class Image;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+class SpriteAtlas : private Util::noncopyable {
+public:
+  // Must match buildSpriteAtlas.py
+  static constexpr uint32_t kFormatVersion = 1;
+
+  SpriteAtlas() = default;
+  ~SpriteAtlas();
+
+  // Maps atlasPath. Sprites are looked up by their path relative to resourcesPath
+  bool Open(const std::string& atlasPath, const std::string& resourcesPath);
+  void Close();
+
+  bool IsOpen() const { return _data != nullptr; }
+  size_t GetNumSprites() const { return _numEntries; }
+
+  // If the atlas has the sprite at fullSpritePath, and the PNG hasn't changed since the atlas
+  // was built, sets outImage to it and returns true. outImage has its own copy of the pixels
+  // (converted if the atlas holds the sprite in the other format), which is still far cheaper
+  // than decoding the PNG.
+  bool GetSprite(const std::string& fullSpritePath, Image& outImage) const;
+  bool GetSprite(const std::string& fullSpritePath, ImageRGBA& outImage) const;
+
+private:
+  struct Entry;
+
+  const Entry* FindEntry(const std::string& fullSpritePath) const;
+
+  std::string    _resourcesPath;
+  const uint8_t* _data = nullptr;
+  size_t         _size = 0;
+  const Entry*   _entries = nullptr;
+  size_t         _numEntries = 0;
+};
+
+}; // namespace Vision
+}; // namespace Anki
+
+#endif // __Vision_Shared_SpriteAtlas_H__
@@ -39,6 +39,15 @@ SpriteCache::~SpriteCache()
 }
 
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SpriteCache::LoadAtlas(const std::string& atlasPath, const std::string& resourcesPath)
+{
+  std::lock_guard<std::mutex> guard(_hueSaturationMapMutex);
+  DEV_ASSERT(_hueSaturationMap.empty(), "SpriteCache.LoadAtlas.HandlesAlreadyCreated");
+  return _atlas.Open(atlasPath, resourcesPath);
+}
+
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 SpriteHandle SpriteCache::GetSpriteHandleForNamedSprite(const std::string& spriteName, 
                                                         const HSImageHandle& hueAndSaturation)
@@ -82,7 +91,7 @@ SpriteCache::InternalHandle SpriteCache::GetSpriteHandleInternal(const std::stri
     }
   }
 
-  InternalHandle handle = std::make_shared<SpriteWrapper>(fullSpritePath);
+  InternalHandle handle = std::make_shared<SpriteWrapper>(fullSpritePath, &_atlas);
   filePathMap.emplace(fullSpritePath, handle);
 
   return handle;
@@ -16,6 +16,7 @@
 #define __Vision_Shared_SpriteCache_H__
 
 #include "coretech/vision/shared/spriteCache/iSpriteWrapper.h"
+#include "coretech/vision/shared/spriteCache/spriteAtlas.h"
 #include "coretech/vision/shared/spriteCache/spriteWrapper.h"
 #include "coretech/vision/shared/spritePathMap.h"
 #include "coretech/common/shared/types.h"
@@ -40,6 +41,11 @@ public:
 
   const Vision::SpritePathMap* GetSpritePathMap(){ return _spritePathMap;}  
 
+  // Maps a pre-decoded sprite atlas, which sprites are then read from instead of their PNGs.
+  // Should be called before any handles are requested. Returns false (and sprites continue to be
+  // decoded from PNG) if there is no valid atlas at atlasPath
+  bool LoadAtlas(const std::string& atlasPath, const std::string& resourcesPath);
+
   // Returns a SpriteHandle for an independent sprite given the filename
   SpriteHandle GetSpriteHandleForNamedSprite(const std::string& spriteName, 
                                              const HSImageHandle& hueAndSaturation = {});
@@ -64,6 +70,7 @@ private:
   using InternalHandle = std::shared_ptr<SpriteWrapper>;
 
   const Vision::SpritePathMap* _spritePathMap;
+  SpriteAtlas _atlas;
   std::mutex _hueSaturationMapMutex;
 
   BaseStationTime_t _lastUpdateTime_nanosec;
@@ -13,6 +13,7 @@
 
 
 #include "coretech/vision/shared/spriteCache/spriteWrapper.h"
+#include "coretech/vision/shared/spriteCache/spriteAtlas.h"
 
 #include "coretech/vision/engine/image_impl.h"
 #include "coretech/vision/engine/image.h"
@@ -25,8 +26,9 @@ namespace Vision {
 
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-SpriteWrapper::SpriteWrapper(const std::string& fullSpritePath)
+SpriteWrapper::SpriteWrapper(const std::string& fullSpritePath, const SpriteAtlas* atlas)
 : _fullSpritePath(fullSpritePath)
+, _atlas(atlas)
 {
 }
 
@@ -186,12 +188,13 @@ void SpriteWrapper::CacheSprite(const ImgTypeCacheSpec& typesToCache, const HSIm
   // Cache RGBA sprite if appropritae
   if(typesToCache.rgba &&
      !isRGBACached){
+    _spriteRGBA = std::unique_ptr<ImageRGBA>(new ImageRGBA());
     if((_spriteGrayscale != nullptr) &&
        (hsImage != nullptr) &&
-       (hsImage->GetHSID() == 0)){
+       (hsImage->GetHSID() != 0)){
+      // Tinting is cheap, so reuse the cached grayscale rather than loading the sprite again
       ApplyHS(*_spriteGrayscale, hsImage, _spriteRGBA.get());
     }else{
-      _spriteRGBA = std::unique_ptr<ImageRGBA>(new ImageRGBA());
       LoadSprite(_spriteRGBA.get(), hsImage);
     }
   } 
@@ -235,11 +238,13 @@ void SpriteWrapper::LoadSprite(Image* outImage) const
     return;
   }
   
-  auto res = outImage->Load(_fullSpritePath.c_str());
-  ANKI_VERIFY(RESULT_OK == res,
-              "CompositeImage.SpriteBoxImpl.Constructor.GrayLoadFailed",
-              "Failed to load sprite %s",
-              _fullSpritePath.c_str());
+  if((_atlas == nullptr) || !_atlas->GetSprite(_fullSpritePath, *outImage)){
+    auto res = outImage->Load(_fullSpritePath.c_str());
+    ANKI_VERIFY(RESULT_OK == res,
+                "CompositeImage.SpriteBoxImpl.Constructor.GrayLoadFailed",
+                "Failed to load sprite %s",
+                _fullSpritePath.c_str());
+  }
   if(Vector::IsXray()) {
     outImage->Resize(Vector::FACE_DISPLAY_HEIGHT, Vector::FACE_DISPLAY_WIDTH);
   }
@@ -260,12 +265,13 @@ void SpriteWrapper::LoadSprite(ImageRGBA* outImage, const HSImageHandle& hsImage
   
   if((hsImage != nullptr) &&
      hsImage->GetHSID() != 0){
-    // Load the image as a grayscale image and merge it with a hue image
+    // Load the image as a grayscale image and tint it with the hue/saturation
     Image grayImg;
-    grayImg.Load(_fullSpritePath.c_str());
-    outImage->Allocate(grayImg.GetNumRows(), grayImg.GetNumCols());
+    if((_atlas == nullptr) || !_atlas->GetSprite(_fullSpritePath, grayImg)){
+      grayImg.Load(_fullSpritePath.c_str());
+    }
     ApplyHS(grayImg, hsImage, outImage);
-  }else{
+  }else if((_atlas == nullptr) || !_atlas->GetSprite(_fullSpritePath, *outImage)){
     // Load the image in as an RGB directly 
     auto res = outImage->Load(_fullSpritePath.c_str());
     ANKI_VERIFY(RESULT_OK == res,
@@ -288,52 +294,34 @@ void SpriteWrapper::ApplyHS(const Image& grayImg, const HSImageHandle& hsImage,
     return;
   }
   
-  const bool dimensionsMatch = (outImg->GetNumRows() == grayImg.GetNumRows()) &&
-                               (outImg->GetNumCols() == grayImg.GetNumCols());
-  if(!dimensionsMatch){
-    PRINT_NAMED_WARNING("SpriteWrapper.ApplyHS.SizeMismatch",
-                        "Existing dimensions (%d,%d) did not match grayscale dimensions (%d,%d)",
-                        outImg->GetNumCols(), outImg->GetNumRows(),
-                        grayImg.GetNumCols(),  grayImg.GetNumRows());
-    return; 
-  }
-  
-  Vision::HueSatWrapper::ImageSize imageSize(static_cast<uint32_t>(grayImg.GetNumRows()),
-                                             static_cast<uint32_t>(grayImg.GetNumCols()));
-  Vision::Image* hueImage = nullptr;
-  Vision::Image* saturationImage = nullptr;
-  bool memoryAllocated = false;
-
-
   if(hsImage == nullptr){
     PRINT_NAMED_ERROR("SpriteWrapper.ApplyHS.HSImageNull",
                       "Cannot apply null HS image to grayImg");
     outImg->SetFromGray(grayImg);
     return;
-  }else if(hsImage->AreImagesCached(imageSize)){
-    hsImage->GetCachedImages(hueImage, saturationImage, imageSize);
-  }else{
-    hsImage->AllocateImages(hueImage, saturationImage, imageSize);
-    memoryAllocated = true;
   }
 
-  // Create an HSV image from the gray image, replacing the 'hue' channel 
-  // with the specified value
-  const std::vector<cv::Mat> channels {
-    hueImage->get_CvMat_(),
-    saturationImage->get_CvMat_(),
-    grayImg.get_CvMat_()
-  };
-  ImageRGB imageHSV;
-  cv::merge(channels, imageHSV.get_CvMat_());
-  ImageRGB565 im565;
-  imageHSV.ConvertHSV2RGB565(im565);
-
-  outImg->SetFromRGB565(im565);
-
-  if(memoryAllocated){
-    Util::SafeDelete(hueImage);
-    Util::SafeDelete(saturationImage);
+  // Hue and saturation are the same for every pixel, so the tinted color only depends on the gray
+  // value (which becomes the HSV value). Convert each of the 256 possible values once, the same way
+  // a full HSV image would be, and then tint the sprite with a lookup per pixel.
+  ImageRGB lutHSV(1, 256);
+  PixelRGB* hsvRow = lutHSV.GetRow(0);
+  for(s32 value = 0; value < 256; ++value){
+    hsvRow[value] = PixelRGB(hsImage->GetHue(), hsImage->GetSaturation(), static_cast<u8>(value));
+  }
+  ImageRGB565 lut565;
+  lutHSV.ConvertHSV2RGB565(lut565);
+  ImageRGBA lutRGBA;
+  lutRGBA.SetFromRGB565(lut565);
+  const PixelRGBA* lut = lutRGBA.GetRow(0);
+
+  outImg->Allocate(grayImg.GetNumRows(), grayImg.GetNumCols());
+  for(s32 row = 0; row < grayImg.GetNumRows(); ++row){
+    const u8* grayRow = grayImg.GetRow(row);
+    PixelRGBA* outRow = outImg->GetRow(row);
+    for(s32 col = 0; col < grayImg.GetNumCols(); ++col){
+      outRow[col] = lut[grayRow[col]];
+    }
   }
 }
 
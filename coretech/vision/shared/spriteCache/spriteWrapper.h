@@ -24,11 +24,13 @@ namespace Vision {
 // forward declaration
 class ImageRGBA;
 class Image;
+class SpriteAtlas;
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 class SpriteWrapper : public ISpriteWrapper {
 public:
-  SpriteWrapper(const std::string& fullSpritePath);
+  // If atlas is set and holds the sprite, it is read from there rather than decoded from the PNG
+  SpriteWrapper(const std::string& fullSpritePath, const SpriteAtlas* atlas = nullptr);
   
   // Transfers ownership of the ptr to the SpriteWrapper
   SpriteWrapper(ImageRGBA* sprite);
@@ -58,6 +60,7 @@ private:
   void ApplyHS(const Image& grayImg, const HSImageHandle& hsImage, ImageRGBA* outImg) const;
 
   const std::string _fullSpritePath;
+  const SpriteAtlas* const _atlas = nullptr;
   // Keep track of what hue/saturation have been applied to the image if appropriate
   uint16_t _hsID = 0;
 
@@ -15,6 +15,9 @@
 #include "coretech/vision/engine/observableObject.h"
 #include "coretech/vision/engine/perspectivePoseEstimation.h"
 #include "coretech/vision/engine/profiler.h"
+#include "coretech/vision/shared/spriteCache/spriteAtlas.h"
+
+#include <unistd.h>
 
 using namespace Anki;
 
@@ -617,3 +620,69 @@ GTEST_TEST(CompressedImage, Decompress)
   EXPECT_TRUE(res);
   EXPECT_EQ(rgb, outGray);
 }
+
+GTEST_TEST(SpriteAtlas, ReadsPreDecodedSprites)
+{
+  using namespace Vision;
+
+  // Build a tiny atlas the same way buildSpriteAtlas.py does: one 2x3 gray sprite
+  const std::string dir = "/tmp/testSpriteAtlas_" + std::to_string(getpid());
+  const std::string spritePath = dir + "/sprites/gray.png";
+  const std::string atlasPath = dir + "/spriteAtlas.bin";
+  Util::FileUtils::CreateDirectory(spritePath, true, true);
+  Util::FileUtils::WriteFile(spritePath, "not really a png");
+
+  const std::string relPath = "sprites/gray.png";
+  const u32 pathOffset = 16 + 40;
+  const u64 dataOffset = 128;
+  std::vector<u8> atlas(dataOffset + 6, 0);
+  const u32 header[4] = {0, SpriteAtlas::kFormatVersion, 1, 0};
+  memcpy(atlas.data(), header, sizeof(header));
+  memcpy(atlas.data(), "AKSA", 4);
+  const u32 entryPath[2] = {pathOffset, static_cast<u32>(relPath.size())};
+  const u64 entrySizes[2] = {static_cast<u64>(Util::FileUtils::GetFileSize(spritePath)), dataOffset};
+  const s32 entryDims[2] = {2, 3};
+  const u32 entryFormat[2] = {0, 0};
+  memcpy(atlas.data() + 16, entryPath, sizeof(entryPath));
+  memcpy(atlas.data() + 24, entrySizes, sizeof(entrySizes));
+  memcpy(atlas.data() + 40, entryDims, sizeof(entryDims));
+  memcpy(atlas.data() + 48, entryFormat, sizeof(entryFormat));
+  memcpy(atlas.data() + pathOffset, relPath.data(), relPath.size());
+  for(u8 i = 0; i < 6; ++i){
+    atlas[dataOffset + i] = i * 10;
+  }
+  Util::FileUtils::WriteFile(atlasPath, atlas);
+
+  SpriteAtlas spriteAtlas;
+  ASSERT_TRUE(spriteAtlas.Open(atlasPath, dir));
+  EXPECT_EQ(1, spriteAtlas.GetNumSprites());
+
+  Image gray;
+  ASSERT_TRUE(spriteAtlas.GetSprite(spritePath, gray));
+  EXPECT_EQ(2, gray.GetNumRows());
+  EXPECT_EQ(3, gray.GetNumCols());
+  EXPECT_EQ(50, gray(1, 2));
+
+  // Writing to the image must not change the atlas, or any other image of the same sprite
+  gray(0, 0) = 255;
+  Image grayAgain;
+  ASSERT_TRUE(spriteAtlas.GetSprite(spritePath, grayAgain));
+  EXPECT_EQ(0, grayAgain(0, 0));
+  EXPECT_NE(gray.GetDataPointer(), grayAgain.GetDataPointer());
+  SpriteAtlas reopened;
+  ASSERT_TRUE(reopened.Open(atlasPath, dir));
+  ASSERT_TRUE(reopened.GetSprite(spritePath, grayAgain));
+  EXPECT_EQ(0, grayAgain(0, 0));
+
+  ImageRGBA rgba;
+  ASSERT_TRUE(reopened.GetSprite(spritePath, rgba));
+  EXPECT_EQ(PixelRGBA(50, 50, 50, 255), rgba(1, 2));
+
+  EXPECT_FALSE(reopened.GetSprite(dir + "/sprites/other.png", gray));
+
+  // Sprites whose PNG changed since the atlas was built are decoded instead
+  Util::FileUtils::WriteFile(spritePath, "a different png");
+  EXPECT_FALSE(reopened.GetSprite(spritePath, gray));
+
+  Util::FileUtils::RemoveDirectory(dir);
+}
@@ -261,3 +261,115 @@ GTEST_TEST(ImageCache, ResizeMethod)
   ASSERT_EQ(method, ResizeMethod::Cubic);
   ASSERT_EQ(buffer.GetResizeMethod(), ResizeMethod::Cubic);
 }
+
+GTEST_TEST(ImageCache, Pyramid)
+{
+  using namespace Anki::Vision;
+
+  ImageCache cache;
+
+  const s32 nrows = 16;
+  const s32 ncols = 32;
+  Image imgGray(nrows, ncols);
+  for(s32 i=0; i<nrows; ++i)
+  {
+    for(s32 j=0; j<ncols; ++j)
+    {
+      imgGray(i,j) = 8*i + j;
+    }
+  }
+  cache.Reset(imgGray);
+
+  // Asking for Eighth size first should fill in the larger sizes it is derived from
+  ImageCache::GetType getType;
+  const Image& eighth = cache.GetGray(ImageCacheSize::Eighth, &getType);
+  ASSERT_EQ(ImageCache::GetType::NewEntry, getType);
+  ASSERT_EQ(nrows/8, eighth.GetNumRows());
+  ASSERT_EQ(ncols/8, eighth.GetNumCols());
+
+  const Image& quarter = cache.GetGray(ImageCacheSize::Quarter, &getType);
+  ASSERT_EQ(ImageCache::GetType::FullyCached, getType);
+
+  const Image& half = cache.GetGray(ImageCacheSize::Half, &getType);
+  ASSERT_EQ(ImageCache::GetType::FullyCached, getType);
+
+  // Each size should be the average of 2x2 blocks of the size above it
+  for(s32 i=0; i<quarter.GetNumRows(); ++i)
+  {
+    for(s32 j=0; j<quarter.GetNumCols(); ++j)
+    {
+      const s32 sum = half(2*i,2*j) + half(2*i,2*j+1) + half(2*i+1,2*j) + half(2*i+1,2*j+1);
+      ASSERT_NEAR(sum/4, quarter(i,j), 1);
+    }
+  }
+  for(s32 i=0; i<eighth.GetNumRows(); ++i)
+  {
+    for(s32 j=0; j<eighth.GetNumCols(); ++j)
+    {
+      const s32 sum = quarter(2*i,2*j) + quarter(2*i,2*j+1) + quarter(2*i+1,2*j) + quarter(2*i+1,2*j+1);
+      ASSERT_NEAR(sum/4, eighth(i,j), 1);
+    }
+  }
+
+  // The next frame should reuse every level's memory
+  const u8* halfData = half.GetDataPointer();
+  const u8* quarterData = quarter.GetDataPointer();
+  const u8* eighthData = eighth.GetDataPointer();
+  Image newImg(nrows, ncols);
+  newImg.FillWith(7);
+  cache.Reset(newImg);
+
+  const Image& newEighth = cache.GetGray(ImageCacheSize::Eighth, &getType);
+  ASSERT_EQ(ImageCache::GetType::ResizeIntoExisting, getType);
+  ASSERT_EQ(eighthData, newEighth.GetDataPointer());
+  ASSERT_EQ(7, newEighth(0,0));
+  ASSERT_EQ(quarterData, cache.GetGray(ImageCacheSize::Quarter, &getType).GetDataPointer());
+  ASSERT_EQ(ImageCache::GetType::FullyCached, getType);
+  ASSERT_EQ(halfData, cache.GetGray(ImageCacheSize::Half, &getType).GetDataPointer());
+  ASSERT_EQ(ImageCache::GetType::FullyCached, getType);
+
+  // Resize methods other than linear/area resize straight from the full size image, without the larger sizes
+  ImageCache lanczosCache;
+  lanczosCache.Reset(imgGray, ResizeMethod::Lanczos);
+  lanczosCache.GetGray(ImageCacheSize::Quarter, &getType);
+  ASSERT_EQ(ImageCache::GetType::NewEntry, getType);
+  lanczosCache.GetGray(ImageCacheSize::Half, &getType);
+  ASSERT_EQ(ImageCache::GetType::NewEntry, getType);
+}
+
+GTEST_TEST(ImageCache, SharedImagesAreNotOverwritten)
+{
+  using namespace Anki::Vision;
+
+  const s32 nrows = 16;
+  const s32 ncols = 32;
+  ImageRGB img1(nrows, ncols);
+  img1.FillWith(PixelRGB(10, 20, 30));
+
+  ImageCache cache;
+  cache.Reset(img1);
+
+  // Holding on to a cached image shares its data
+  ImageRGB shared = cache.GetRGB(ImageCacheSize::Half);
+  const PixelRGB* sharedData = shared.GetDataPointer();
+  ASSERT_EQ(sharedData, cache.GetRGB(ImageCacheSize::Half).GetDataPointer());
+
+  // The next frame must not be written into the shared data
+  ImageRGB img2(nrows, ncols);
+  img2.FillWith(PixelRGB(40, 50, 60));
+  cache.Reset(img2);
+
+  ImageCache::GetType getType;
+  const ImageRGB& half = cache.GetRGB(ImageCacheSize::Half, &getType);
+  ASSERT_EQ(ImageCache::GetType::ResizeIntoExisting, getType);
+  ASSERT_NE(sharedData, half.GetDataPointer());
+  ASSERT_EQ(sharedData, shared.GetDataPointer());
+  ASSERT_EQ(10, shared(0,0).r());
+  ASSERT_EQ(40, half(0,0).r());
+
+  // Once nothing else holds it, the entry's memory is reused again
+  const PixelRGB* halfData = half.GetDataPointer();
+  cache.Reset(img1);
+  ASSERT_EQ(halfData, cache.GetRGB(ImageCacheSize::Half).GetDataPointer());
+  ASSERT_EQ(10, cache.GetRGB(ImageCacheSize::Half)(0,0).r());
+}
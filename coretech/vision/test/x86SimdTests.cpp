@@ -0,0 +1,263 @@
+/**
+ * File: x86SimdTests.cpp
+ *
+ * Description: Checks that the SSE4.1 / AVX2 debayering and ImageBuffer conversions produce exactly the same output
+ *              as the plain versions, including sizes that leave columns over after the SIMD steps
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ * --gtest_filter=X86Simd*
+ **/
+
+#include "util/helpers/includeGTest.h" // Used in place of gTest/gTest.h directly to suppress warnings in the header
+
+#include "coretech/vision/engine/x86Simd.h"
+
+#if ANKI_X86_SIMD
+
+#include "coretech/common/shared/types.h"
+#include "coretech/vision/engine/debayer.h"
+#include "coretech/vision/engine/debayer/x86/raw10.h"
+#include "coretech/vision/engine/image_impl.h"
+#include "coretech/vision/engine/imageBuffer/conversions/imageConversions.h"
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Anki;
+
+namespace {
+
+using Vision::X86::InstructionSet;
+
+// Caps the instruction set the SIMD paths use while in scope
+class ScopedMaxInstructionSet
+{
+public:
+  explicit ScopedMaxInstructionSet(InstructionSet maxInstructionSet)
+  : _prevMaxInstructionSet(Vision::X86::MaxInstructionSet())
+  {
+    Vision::X86::MaxInstructionSet() = maxInstructionSet;
+  }
+
+  ~ScopedMaxInstructionSet()
+  {
+    Vision::X86::MaxInstructionSet() = _prevMaxInstructionSet;
+  }
+
+private:
+  const InstructionSet _prevMaxInstructionSet;
+};
+
+// Exactly numBytes long, so that reading past the end shows up under the address sanitizer
+std::vector<u8> RandomBytes(size_t numBytes, u32 seed)
+{
+  std::mt19937 rng(seed);
+  std::vector<u8> bytes(numBytes);
+  for(auto& byte : bytes) {
+    byte = static_cast<u8>(rng() & 0xFF);
+  }
+
+  // Keep the first half dark so that not everything saturates
+  for(size_t i = 0; i < numBytes/2; ++i) {
+    bytes[i] &= 0x3F;
+  }
+  return bytes;
+}
+
+// Index of the first byte that differs, or -1 if the images are the same
+s32 FindFirstDifference(const Vision::ImageRGB& expected, const Vision::ImageRGB& actual)
+{
+  if(expected.GetNumRows() != actual.GetNumRows() || expected.GetNumCols() != actual.GetNumCols()) {
+    return 0;
+  }
+
+  const s32 rowBytes = 3 * expected.GetNumCols();
+  for(s32 row = 0; row < expected.GetNumRows(); ++row)
+  {
+    const u8* expectedRow = reinterpret_cast<const u8*>(expected.GetRow(row));
+    const u8* actualRow   = reinterpret_cast<const u8*>(actual.GetRow(row));
+    for(s32 i = 0; i < rowBytes; ++i)
+    {
+      if(expectedRow[i] != actualRow[i]) {
+        return row*rowBytes + i;
+      }
+    }
+  }
+  return -1;
+}
+
+// Runs an ImageBuffer conversion with and without SSE4.1 and expects the same output
+template<class ConversionFunc>
+void ExpectSameAsFallback(const std::vector<u8>& input, s32 rows, s32 cols, ConversionFunc conversion)
+{
+  Vision::ImageRGB fallback;
+  {
+    ScopedMaxInstructionSet noSimd(InstructionSet::None);
+    conversion(input.data(), rows, cols, fallback);
+  }
+
+  Vision::ImageRGB simd;
+  conversion(input.data(), rows, cols, simd);
+
+  EXPECT_EQ(-1, FindFirstDifference(fallback, simd)) << rows << "x" << cols;
+}
+
+// What the Neon ops compute (and the x86 ops have to match), one output 2x2 block at a time: red and the first green
+// come from the first bayer row, blue and the second green from the second
+void DebayerRAW10Reference(const std::vector<u8>& raw, s32 inWidth, s32 outHeight, s32 outWidth, u8 sampleRate,
+                           bool isRGB24, std::vector<u8>& out)
+{
+  std::array<u8,128> gammaLUT;
+  for(size_t i = 0; i < gammaLUT.size(); ++i) {
+    gammaLUT[i] = 255 * powf((f32)i/127.0f, Vision::Debayer::GAMMA);
+  }
+
+  const s32 inRowBytes = (inWidth * 5) / 4;
+  const s32 outChannels = (isRGB24 ? 3 : 1);
+  out.assign(outHeight * outWidth * outChannels, 0);
+
+  for(s32 row = 0; row < outHeight; row += 2)
+  {
+    const u8* in1 = raw.data() + (row * sampleRate) * inRowBytes;
+    const u8* in2 = in1 + (2*sampleRate - 1) * inRowBytes;
+    u8* out1 = out.data() + row * outWidth * outChannels;
+    u8* out2 = out1 + outWidth * outChannels;
+
+    for(s32 col = 0; col < outWidth; col += 2)
+    {
+      // Every sampleRate'th RAW10 block (5 bytes, 4 pixels) makes 4 output columns
+      const s32 offset = (col / 4) * 5 * sampleRate + (col % 4);
+      const u8 r  = gammaLUT[in1[offset]   >> 1];
+      const u8 g1 = gammaLUT[in1[offset+1] >> 1];
+      const u8 g2 = gammaLUT[in2[offset]   >> 1];
+      const u8 b  = gammaLUT[in2[offset+1] >> 1];
+
+      for(s32 i = 0; i < 2; ++i)
+      {
+        u8* pixel1 = out1 + (col + i) * outChannels;
+        u8* pixel2 = out2 + (col + i) * outChannels;
+        if(isRGB24) {
+          pixel1[0] = r; pixel1[1] = g1; pixel1[2] = b;
+          pixel2[0] = r; pixel2[1] = g2; pixel2[2] = b;
+        } else {
+          pixel1[0] = g1;
+          pixel2[0] = g2;
+        }
+      }
+    }
+  }
+}
+
+void ExpectDebayerRAW10MatchesReference(const Vision::Debayer::Op& op, bool isRGB24)
+{
+  using Vision::Debayer;
+
+  // Output widths that are a multiple of 16 but not of 32 leave a step over for the AVX2 path, and none of the
+  // input row strides are a multiple of 16 bytes
+  const std::vector<std::pair<s32,s32>> kOutSizes = {{2, 16}, {2, 48}, {4, 80}, {6, 32}, {90, 160}};
+  const std::vector<std::pair<Debayer::Scale,u8>> kScales = {
+    {Debayer::Scale::FULL, 1}, {Debayer::Scale::HALF, 2}, {Debayer::Scale::QUARTER, 4}, {Debayer::Scale::EIGHTH, 8},
+  };
+
+  const s32 outChannels = (isRGB24 ? 3 : 1);
+  const Debayer::OutputFormat format = (isRGB24 ? Debayer::OutputFormat::RGB24 : Debayer::OutputFormat::Y8);
+
+  for(const auto& outSize : kOutSizes)
+  {
+    for(const auto& scale : kScales)
+    {
+      const s32 outHeight = outSize.first;
+      const s32 outWidth  = outSize.second;
+      const s32 inHeight  = outHeight * scale.second;
+      const s32 inWidth   = outWidth * scale.second;
+
+      std::vector<u8> raw = RandomBytes((inHeight * inWidth * 5) / 4, inHeight * inWidth);
+      const Debayer::InArgs inArgs(raw.data(), inHeight, inWidth, Debayer::Layout::RAW10, Debayer::Pattern::RGGB);
+
+      std::vector<u8> expected;
+      DebayerRAW10Reference(raw, inWidth, outHeight, outWidth, scale.second, isRGB24, expected);
+
+      std::vector<u8> out(outHeight * outWidth * outChannels);
+      Debayer::OutArgs outArgs(out.data(), outHeight, outWidth, scale.first, format);
+      ASSERT_EQ(RESULT_OK, op(inArgs, outArgs));
+      EXPECT_TRUE(expected == out) << outHeight << "x" << outWidth << " at 1/" << (int)scale.second;
+    }
+  }
+
+  // Widths the steps don't divide are rejected rather than written past
+  std::vector<u8> raw = RandomBytes((4 * 24 * 5) / 4, 0);
+  std::vector<u8> out(4 * 24 * outChannels);
+  const Debayer::InArgs inArgs(raw.data(), 4, 24, Debayer::Layout::RAW10, Debayer::Pattern::RGGB);
+  Debayer::OutArgs outArgs(out.data(), 4, 24, Debayer::Scale::FULL, format);
+  EXPECT_EQ(RESULT_FAIL, op(inArgs, outArgs));
+}
+
+// Even rows and columns a multiple of 8 (as the plain halving needs), with and without pixels left over after the
+// SIMD steps
+const std::vector<std::pair<s32,s32>> kHalveSizes = {{2, 8}, {2, 16}, {4, 24}, {6, 40}, {10, 1240}, {720, 1280}};
+
+// Whole RAW10 blocks, with and without pixels left over after the SIMD steps
+const std::vector<std::pair<s32,s32>> kDemosaicSizes = {{4, 16}, {6, 12}, {6, 20}, {10, 1244}, {720, 1280}};
+
+// Even rows and columns, with and without pixels left over after the SIMD steps
+const std::vector<std::pair<s32,s32>> kYUVSizes = {{2, 2}, {2, 8}, {2, 14}, {4, 30}, {10, 1262}, {720, 1280}};
+
+}
+
+GTEST_TEST(X86Simd, DebayerRAW10toRGB24)
+{
+  if(!Vision::X86::HasSSE41()) {
+    return;
+  }
+
+  const Vision::X86::RAW10toRGB24 op;
+  ExpectDebayerRAW10MatchesReference(op, true);
+
+  ScopedMaxInstructionSet noAVX2(InstructionSet::SSE41);
+  ExpectDebayerRAW10MatchesReference(op, true);
+}
+
+GTEST_TEST(X86Simd, DebayerRAW10toY8)
+{
+  if(!Vision::X86::HasSSE41()) {
+    return;
+  }
+
+  const Vision::X86::RAW10toY8 op;
+  ExpectDebayerRAW10MatchesReference(op, false);
+
+  ScopedMaxInstructionSet noAVX2(InstructionSet::SSE41);
+  ExpectDebayerRAW10MatchesReference(op, false);
+}
+
+GTEST_TEST(X86Simd, HalveBGGR10ToRGB)
+{
+  for(const auto& size : kHalveSizes)
+  {
+    const std::vector<u8> bayer = RandomBytes((size.first * size.second * 5) / 4, size.second);
+    ExpectSameAsFallback(bayer, size.first, size.second, Vision::ImageConversions::HalveBGGR10ToRGB);
+  }
+}
+
+GTEST_TEST(X86Simd, DemosaicBGGR10ToRGB)
+{
+  for(const auto& size : kDemosaicSizes)
+  {
+    const std::vector<u8> bayer = RandomBytes((size.first * size.second * 5) / 4, size.second);
+    ExpectSameAsFallback(bayer, size.first, size.second, Vision::ImageConversions::DemosaicBGGR10ToRGB);
+  }
+}
+
+GTEST_TEST(X86Simd, ConvertYUV420spToRGB)
+{
+  for(const auto& size : kYUVSizes)
+  {
+    const std::vector<u8> yuv = RandomBytes((size.first * size.second * 3) / 2, size.second);
+    ExpectSameAsFallback(yuv, size.first, size.second, Vision::ImageConversions::ConvertYUV420spToRGB);
+  }
+}
+
+#endif // ANKI_X86_SIMD
@@ -0,0 +1,190 @@
+/**
+ * File: main.cpp
+ *
+ * Description: Program to time debayering and ImageBuffer conversions of a RAW10 image for every combination of
+ *              method, scale and output format, next to the unaccelerated CPU ops, to see what the platform's
+ *              registered ops (Neon on the robot, SSE4.1/AVX2 on x86) are worth.
+ *
+ * Copyright: Anki, Inc. 2026
+ **/
+
+#include "coretech/vision/engine/debayer.h"
+#include "coretech/vision/engine/debayer/raw10.h"
+#include "coretech/vision/engine/image_impl.h"
+#include "coretech/vision/engine/imageBuffer/conversions/imageConversions.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using Anki::Vision::Debayer;
+using namespace Anki::Vision;
+
+namespace {
+
+const char* MethodToString(Debayer::Method method)
+{
+  switch (method)
+  {
+    case Debayer::Method::PHOTO:      return "PHOTO";
+    case Debayer::Method::PERCEPTION: return "PERCEPTION";
+  }
+  return "UNKNOWN";
+}
+
+const char* ScaleToString(Debayer::Scale scale)
+{
+  switch (scale)
+  {
+    case Debayer::Scale::FULL:    return "FULL";
+    case Debayer::Scale::HALF:    return "HALF";
+    case Debayer::Scale::QUARTER: return "QUARTER";
+    case Debayer::Scale::EIGHTH:  return "EIGHTH";
+  }
+  return "UNKNOWN";
+}
+
+const char* OutputFormatToString(Debayer::OutputFormat format)
+{
+  switch (format)
+  {
+    case Debayer::OutputFormat::RGB24: return "RGB24";
+    case Debayer::OutputFormat::Y8:    return "Y8";
+  }
+  return "UNKNOWN";
+}
+
+struct Timing
+{
+  double mean_ms;
+  double min_ms;
+};
+
+// Run func once to warm up, then time it over the given number of iterations
+Timing Time(const std::function<void()>& func, int iterations)
+{
+  func();
+
+  Timing timing{0.0, 1e9};
+  for (int ii = 0; ii < iterations; ++ii)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    const auto end = std::chrono::steady_clock::now();
+    const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    timing.mean_ms += ms;
+    timing.min_ms = std::min(timing.min_ms, ms);
+  }
+  timing.mean_ms /= iterations;
+  return timing;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  if (argc < 2 || argc > 5){
+    std::printf("Usage: cti_vision_debayer_benchmark <raw10 image> [width height [iterations]]\n");
+    return -1;
+  }
+
+  const s32 width  = (argc > 3 ? std::stoi(argv[2]) : 1280);
+  const s32 height = (argc > 3 ? std::stoi(argv[3]) : 720);
+  const int iterations = (argc > 4 ? std::stoi(argv[4]) : 100);
+
+  std::ifstream ifs(argv[1], std::ios::in | std::ios::binary);
+  std::vector<u8> inBytes(std::istreambuf_iterator<char>(ifs),{});
+  if (inBytes.size() < (size_t)(width * height * 5) / 4)
+  {
+    std::printf("Error: %s is %zu bytes, expected %d for a %dx%d RAW10 image\n",
+                argv[1], inBytes.size(), (width * height * 5) / 4, width, height);
+    return -1;
+  }
+
+  Debayer debayer;
+  const RAW10toRGB24 cpuRGB24;
+  const RAW10toY8 cpuY8;
+
+  Debayer::InArgs inArgs(inBytes.data(), height, width, Debayer::Layout::RAW10, Debayer::Pattern::RGGB);
+
+  std::printf("%dx%d RAW10, %d iterations, times in ms\n\n", width, height, iterations);
+  std::printf("%-12s %-8s %-6s %10s %10s %10s %10s %8s\n",
+              "Method", "Scale", "Format", "mean", "min", "cpu mean", "cpu min", "speedup");
+
+  const Debayer::Method methods[] = { Debayer::Method::PHOTO, Debayer::Method::PERCEPTION };
+  const Debayer::Scale scales[] = { Debayer::Scale::FULL, Debayer::Scale::HALF,
+                                    Debayer::Scale::QUARTER, Debayer::Scale::EIGHTH };
+  const Debayer::OutputFormat formats[] = { Debayer::OutputFormat::RGB24, Debayer::OutputFormat::Y8 };
+
+  for (const auto method : methods)
+  {
+    for (const auto scale : scales)
+    {
+      for (const auto format : formats)
+      {
+        u8 sampleRate = 1;
+        Debayer::SampleRateFromScale(scale, sampleRate);
+        const s32 outWidth = width / sampleRate;
+        const s32 outHeight = height / sampleRate;
+        const s32 channels = (format == Debayer::OutputFormat::RGB24 ? 3 : 1);
+        std::vector<u8> outBytes(outWidth * outHeight * channels);
+
+        Debayer::OutArgs outArgs(outBytes.data(), outHeight, outWidth, scale, format);
+
+        Anki::Result result = Anki::RESULT_OK;
+        const Timing timing = Time([&]() { result = debayer.Invoke(method, inArgs, outArgs); }, iterations);
+        if (result != Anki::RESULT_OK)
+        {
+          std::printf("%-12s %-8s %-6s failed\n",
+                      MethodToString(method), ScaleToString(scale), OutputFormatToString(format));
+          continue;
+        }
+
+        const Debayer::Op& cpuOp = (format == Debayer::OutputFormat::RGB24 ?
+                                    static_cast<const Debayer::Op&>(cpuRGB24) :
+                                    static_cast<const Debayer::Op&>(cpuY8));
+        const Timing cpuTiming = Time([&]() { cpuOp(inArgs, outArgs); }, iterations);
+
+        std::printf("%-12s %-8s %-6s %10.3f %10.3f %10.3f %10.3f %7.2fx\n",
+                    MethodToString(method), ScaleToString(scale), OutputFormatToString(format),
+                    timing.mean_ms, timing.min_ms, cpuTiming.mean_ms, cpuTiming.min_ms,
+                    cpuTiming.mean_ms / timing.mean_ms);
+      }
+    }
+  }
+
+  // The conversions ImageBuffer uses for BAYER images. These use the raw buffer as BGGR regardless of pattern.
+  std::printf("\n%-32s %10s %10s\n", "ImageConversions", "mean", "min");
+
+  ImageRGB rgb;
+  Image gray;
+  const std::vector<std::pair<const char*, std::function<void()>>> conversions = {
+    {"DemosaicBGGR10ToRGB", [&]() { ImageConversions::DemosaicBGGR10ToRGB(inBytes.data(), height, width, rgb); }},
+    {"HalveBGGR10ToRGB",    [&]() { ImageConversions::HalveBGGR10ToRGB(inBytes.data(), height, width, rgb); }},
+    {"HalveBGGR10ToGray",   [&]() { ImageConversions::HalveBGGR10ToGray(inBytes.data(), height, width, gray); }},
+    {"QuarterBGGR10ToRGB",  [&]() { ImageConversions::QuarterBGGR10ToRGB(inBytes.data(), height, width, rgb); }},
+  };
+
+  for (const auto& conversion : conversions)
+  {
+    const Timing timing = Time(conversion.second, iterations);
+    std::printf("%-32s %10.3f %10.3f\n", conversion.first, timing.mean_ms, timing.min_ms);
+  }
+
+  // YUV420sp input of the same size (e.g. from the robot's camera in that mode), content doesn't matter for timing
+  std::vector<u8> yuvBytes((width * height * 3) / 2);
+  for (size_t ii = 0; ii < yuvBytes.size(); ++ii)
+  {
+    yuvBytes[ii] = inBytes[ii % inBytes.size()];
+  }
+  const Timing timing = Time([&]() { ImageConversions::ConvertYUV420spToRGB(yuvBytes.data(), height, width, rgb); },
+                             iterations);
+  std::printf("%-32s %10.3f %10.3f\n", "ConvertYUV420spToRGB", timing.mean_ms, timing.min_ms);
+
+  return 0;
+}
@@ -138,9 +138,9 @@ ITrackAction::UpdateResult TrackGroundPointAction::UpdateTrackingHelper(Radians&
                                                                         f32&     distance_mm_out)
 {
   // Find pose of robot at time point was observed
-  HistRobotState* histStatePtr = nullptr;
+  HistRobotState histState;
   RobotTimeStamp_t junkTime;
-  if(RESULT_OK != GetRobot().GetStateHistory()->ComputeAndInsertStateAt(_pointObservation.timestamp, junkTime, &histStatePtr))
+  if(RESULT_OK != GetRobot().GetStateHistory()->ComputeAndInsertStateAt(_pointObservation.timestamp, junkTime, histState))
   {
     PRINT_NAMED_ERROR("TrackGroundPointAction.UpdateTrackingHelper.PoseHistoryError",
                       "Could not get historical pose for point observed at t=%d (lastRobotMsgTime = %d)",
@@ -150,9 +150,7 @@ ITrackAction::UpdateResult TrackGroundPointAction::UpdateTrackingHelper(Radians&
     return UpdateResult::NoNewInfo;
   }
   
-  DEV_ASSERT(nullptr != histStatePtr, "TrackGroundPointAction.UpdateTrackingHelper.NullHistStatePtr");
- 
-  const Pose3d& histPose = histStatePtr->GetPose();
+  const Pose3d& histPose = histState.GetPose();
   
   const Point2f& groundPoint = ComputeGroundPointWrtCurrentRobot(histPose,
                                                                  GetRobot().GetPose(),
@@ -189,9 +187,9 @@ ITrackAction::UpdateResult TrackGroundPointAction::PredictTrackingHelper(Radians
              "TrackGroundPointAction.PredictTrackingHelper.PredictionNotEnabled");
   
   // Convert observations to absolute coordinates so we can compare them relative to a common origin
-  HistRobotState* histStatePtr1 = nullptr;
+  HistRobotState histState1;
   RobotTimeStamp_t t1;
-  if(RESULT_OK != GetRobot().GetStateHistory()->ComputeAndInsertStateAt(_prevPointObservation.timestamp, t1, &histStatePtr1))
+  if(RESULT_OK != GetRobot().GetStateHistory()->ComputeAndInsertStateAt(_prevPointObservation.timestamp, t1, histState1))
   {
     PRINT_NAMED_ERROR("TrackGroundPointAction.PredictTrackingHelper.PoseHistoryError",
                       "Could not get historical pose for point observed at t=%d (lastRobotMsgTime = %d)",
@@ -202,7 +200,7 @@ ITrackAction::UpdateResult TrackGroundPointAction::PredictTrackingHelper(Radians
   }
   
   // Previous observation's ground point w.r.t. current robot position
-  const Point2f& groundPoint1 = ComputeGroundPointWrtCurrentRobot(histStatePtr1->GetPose(),
+  const Point2f& groundPoint1 = ComputeGroundPointWrtCurrentRobot(histState1.GetPose(),
                                                                   GetRobot().GetPose(),
                                                                   _prevPointObservation.groundPoint);
   
@@ -214,9 +212,9 @@ ITrackAction::UpdateResult TrackGroundPointAction::PredictTrackingHelper(Radians
               groundPoint1.ToString().c_str());
   }
   
-  HistRobotState* histStatePtr2 = nullptr;
+  HistRobotState histState2;
   RobotTimeStamp_t t2;
-  if(RESULT_OK != GetRobot().GetStateHistory()->ComputeAndInsertStateAt(_pointObservation.timestamp, t2, &histStatePtr2))
+  if(RESULT_OK != GetRobot().GetStateHistory()->ComputeAndInsertStateAt(_pointObservation.timestamp, t2, histState2))
   {
     PRINT_NAMED_ERROR("TrackGroundPointAction.PredictTrackingHelper.PoseHistoryError",
                       "Could not get historical pose for point observed at t=%d (lastRobotMsgTime = %d)",
@@ -227,7 +225,7 @@ ITrackAction::UpdateResult TrackGroundPointAction::PredictTrackingHelper(Radians
   }
   
   // Last observation's ground point w.r.t. current robot position
-  const Point2f& groundPoint2 = ComputeGroundPointWrtCurrentRobot(histStatePtr2->GetPose(),
+  const Point2f& groundPoint2 = ComputeGroundPointWrtCurrentRobot(histState2.GetPose(),
                                                                   GetRobot().GetPose(),
                                                                   _pointObservation.groundPoint);
   
@@ -261,7 +259,7 @@ ITrackAction::UpdateResult TrackGroundPointAction::PredictTrackingHelper(Radians
   
   // Get angles using faked ground point
   // Note: not predicting head tilt!
-  ComputeAbsAngles(GetRobot(), histStatePtr2->GetPose(), predictedGroundPoint, absPanAngle_out, absTiltAngle_out);
+  ComputeAbsAngles(GetRobot(), histState2.GetPose(), predictedGroundPoint, absPanAngle_out, absTiltAngle_out);
   
   // Compute the distance for tracking from the predicted ground point
   distance_mm_out = 0.f; // If too close: distance will remain 0.f
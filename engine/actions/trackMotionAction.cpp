@@ -68,9 +68,9 @@ ITrackAction::UpdateResult TrackMotionAction::UpdateTracking(Radians& absPanAngl
     GetRobot().GetVisionComponent().GetCamera().ComputePanAndTiltAngles(motionCentroid, absPanAngle, absTiltAngle);
     
     // Find pose of robot at time motion was observed
-    HistRobotState* histStatePtr = nullptr;
+    HistRobotState histState;
     RobotTimeStamp_t junkTime;
-    if(RESULT_OK != GetRobot().GetStateHistory()->ComputeAndInsertStateAt(_motionObservation.timestamp, junkTime, &histStatePtr)) {
+    if(RESULT_OK != GetRobot().GetStateHistory()->ComputeAndInsertStateAt(_motionObservation.timestamp, junkTime, histState)) {
       PRINT_NAMED_ERROR("TrackMotionAction.UpdateTracking.PoseHistoryError",
                         "Could not get historical pose for motion observed at t=%d (lastRobotMsgTime = %d)",
                         _motionObservation.timestamp,
@@ -78,11 +78,9 @@ ITrackAction::UpdateResult TrackMotionAction::UpdateTracking(Radians& absPanAngl
       return UpdateResult::NoNewInfo;
     }
     
-    DEV_ASSERT(nullptr != histStatePtr, "TrackMotionAction.UpdateTracking.NullHistStatePtr");
-    
     // Make absolute
-    absTiltAngle += histStatePtr->GetHeadAngle_rad();
-    absPanAngle  += histStatePtr->GetPose().GetRotation().GetAngleAroundZaxis();
+    absTiltAngle += histState.GetHeadAngle_rad();
+    absPanAngle  += histState.GetPose().GetRotation().GetAngleAroundZaxis();
     
     if(DEBUG_TRACKING_ACTIONS)
     {
@@ -101,6 +101,7 @@ void AIComponent::InitDependent(Vector::Robot* robot, const RobotCompMap& depend
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AIComponent::UpdateDependent(const RobotCompMap& dependentComps)
 {
+  _aiComponents->SetUpdateSettings(_robot->GetComponentUpdateSettings());
   _aiComponents->UpdateComponents();
   CheckForSuddenObstacle(*_robot);
 }
@@ -137,8 +138,8 @@ void AIComponent::CheckForSuddenObstacle(Robot& robot)
   const RobotTimeStamp_t endTime = robot.GetLastMsgTimestamp() - kObsSampleWindow_ms;
 
   int n = 0;
-  for(auto st = states.rbegin(); st != states.rend() && st->first > endTime; ++st) {
-    const auto& state = st->second;
+  for(size_t i = states.size(); i > 0 && states[i-1].t > endTime; --i) {
+    const auto& state = states[i-1].state;
     angleVec.push_back(state.GetPose().GetRotationAngle<'Z'>());
     const auto& proxData = state.GetProxSensorData();
 
@@ -95,6 +95,11 @@ public:
   template<typename T>
   T* GetComponentPtr() const {assert(_aiComponents); return _aiComponents->GetComponentPtr<T>();}
 
+  // How long each AI component's recent updates took, while the robot is timing component updates
+  const std::vector<DependencyManagedEntity<AIComponentID>::ComponentUpdateTime>& GetComponentUpdateTimes() const {
+    assert(_aiComponents); return _aiComponents->GetUpdateTimes();
+  }
+
   #if ANKI_DEV_CHEATS
   // For test only
   BehaviorContainer& GetBehaviorContainer();
@@ -246,6 +246,7 @@ void BehaviorComponent::SetComponents(ComponentPtr&& components)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void BehaviorComponent::InitDependent(Robot* robot, const AICompMap& dependentComps)
 {
+  _robot = robot;
   if(_comps == nullptr){
     _comps = std::make_unique<EntityType>();
     _comps->AddDependentComponent(BCComponentID::AIComponent, robot->GetComponentPtr<AIComponent>(), false);
@@ -258,6 +259,7 @@ void BehaviorComponent::InitDependent(Robot* robot, const AICompMap& dependentCo
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void BehaviorComponent::UpdateDependent(const AICompMap& dependentComps)
 {
+  _comps->SetUpdateSettings(_robot->GetComponentUpdateSettings());
   _comps->UpdateComponents();
 }
 
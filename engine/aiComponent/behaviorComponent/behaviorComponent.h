@@ -92,6 +92,9 @@ public:
   template<typename T>
   T& GetComponent() const {return _comps->GetComponent<T>();}
 
+  // How long each behavior component's recent updates took, while the robot is timing component updates
+  const std::vector<EntityType::ComponentUpdateTime>& GetComponentUpdateTimes() const { return _comps->GetUpdateTimes(); }
+
   virtual void SubscribeToTags(IBehavior* subscriber, std::set<ExternalInterface::MessageGameToEngineTag>&& tags) const override;
   virtual void SubscribeToTags(IBehavior* subscriber, std::set<ExternalInterface::MessageEngineToGameTag>&& tags) const override;
   virtual void SubscribeToTags(IBehavior* subscriber, std::set<RobotInterface::RobotToEngineTag>&& tags) const override;
@@ -108,6 +111,7 @@ protected:
   BehaviorContainer& GetBehaviorContainer();
 
 private:
+  Robot* _robot = nullptr;
   ComponentPtr _comps;
 };
 
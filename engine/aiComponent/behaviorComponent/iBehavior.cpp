@@ -19,6 +19,7 @@
 #include "engine/aiComponent/behaviorComponent/iBehavior.h"
 
 #include "util/console/consoleInterface.h"
+#include "util/cpuProfiler/cpuProfiler.h"
 #include "util/logging/logging.h"
 
 namespace Anki {
@@ -95,6 +96,7 @@ void IBehavior::Update()
                 _lastTickOfUpdate);
   _lastTickOfUpdate = tickCount;
 
+  ANKI_CPU_TRACE_SPAN("behavior", _debugLabel);
   UpdateInternal();
 }
 
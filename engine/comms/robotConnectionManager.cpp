@@ -64,7 +64,7 @@ Result RobotConnectionManager::Update()
   }
 
   // If we lose connection to robot, report connection closed
-  if (!_udpClient.IsConnected()) {
+  if (!_client.IsConnected()) {
     return RESULT_FAIL_IO_CONNECTION_CLOSED;
   }
 
@@ -90,7 +90,7 @@ void RobotConnectionManager::SendAndResetQueueStats()
 
 bool RobotConnectionManager::IsConnected(RobotID_t robotID) const
 {
-  if (_robotID == robotID && _udpClient.IsConnected()) {
+  if (_robotID == robotID && _client.IsConnected()) {
     return true;
   }
   return false;
@@ -102,14 +102,14 @@ Result RobotConnectionManager::Connect(RobotID_t robotID)
 
   _currentConnectionData->Clear();
 
-  if (_udpClient.IsConnected()) {
-    _udpClient.Disconnect();
+  if (_client.IsConnected()) {
+    _client.Disconnect();
   }
 
   const std::string & client_path = ENGINE_ANIM_CLIENT_PATH + std::to_string(robotID);
   const std::string & server_path = ENGINE_ANIM_SERVER_PATH + std::to_string(robotID);
 
-  const bool ok = _udpClient.Connect(client_path, server_path);
+  const bool ok = _client.Connect(client_path, server_path);
   if (!ok) {
     LOG_WARNING("RobotConnectionManager.Connect", "Unable to connect from %s to %s",
                 client_path.c_str(), server_path.c_str());
@@ -126,8 +126,8 @@ Result RobotConnectionManager::Connect(RobotID_t robotID)
 void RobotConnectionManager::DisconnectCurrent()
 {
   LOG_DEBUG("RobotConnectionManager.DisconnectCurrent", "Disconnect");
-  if (_udpClient.IsConnected()) {
-    _udpClient.Disconnect();
+  if (_client.IsConnected()) {
+    _client.Disconnect();
     _robotID = -1;
   }
 
@@ -148,7 +148,7 @@ bool RobotConnectionManager::SendData(const uint8_t* buffer, unsigned int size)
     return false;
   }
 
-  const ssize_t sent = _udpClient.Send((const char *) buffer, size);
+  const ssize_t sent = _client.Send((const char *) buffer, size);
   if (sent != size) {
     LOG_ERROR("RobotConnectionManager.SendData.Error", "Sent %zd/%d bytes to robot", sent, size);
     DisconnectCurrent();
@@ -161,9 +161,9 @@ bool RobotConnectionManager::SendData(const uint8_t* buffer, unsigned int size)
 void RobotConnectionManager::ProcessArrivedMessages()
 {
   static const Util::TransportAddress addr;
-  while (_udpClient.IsConnected()) {
+  while (_client.IsConnected()) {
     char buf[MAX_PACKET_BUFFER_SIZE];
-    const ssize_t n = _udpClient.Recv(buf, sizeof(buf));
+    const ssize_t n = _client.Recv(buf, sizeof(buf));
     if (n < 0) {
       LOG_ERROR("RobotConnectionManager.ProcessArrivedMessages", "Read error from robot");
       break;
@@ -331,12 +331,12 @@ void RobotConnectionManager::UpdateSocketBufferStats()
   DEV_ASSERT(_incomingStats, "RobotConnectionManager.UpdateSocketBufferStats.InvalidIncomingStats");
   DEV_ASSERT(_outgoingStats, "RobotConnectionManager.UpdateSocketBufferStats.InvalidOutgoingStats");
 
-  if (_udpClient.IsConnected()) {
-    const auto incoming = _udpClient.GetIncomingSize();
+  if (_client.IsConnected()) {
+    const auto incoming = _client.GetIncomingSize();
     if (incoming >= 0) {
       _incomingStats->Record(incoming);
     }
-    const auto outgoing = _udpClient.GetOutgoingSize();
+    const auto outgoing = _client.GetOutgoingSize();
     if (outgoing >= 0) {
       _outgoingStats->Record(outgoing);
     }
@@ -14,7 +14,7 @@
 
 #include "engine/comms/robotConnectionMessageData.h"
 #include "coretech/common/shared/types.h"
-#include "coretech/messaging/shared/LocalUdpClient.h"
+#include "coretech/messaging/shared/LocalTransport.h"
 #include "util/stats/recentStatsAccumulator.h"
 #include "util/signals/signalHolder.h"
 
@@ -102,7 +102,7 @@ private:
   Util::Stats::StatsAccumulator _queueSizeAccumulator;
 
   RobotID_t      _robotID = -1;
-  LocalUdpClient _udpClient;
+  LocalTransportClient _client;
 
 #if ANKI_PROFILE_ENGINE_SOCKET_BUFFER_STATS
   using Histogram = Anki::Util::Histogram;
@@ -0,0 +1,310 @@
+/**
+ * File: componentTickBudgets.cpp
+ *
+ * Description: Checks how long each robot, AI and behavior component's update took against a configurable
+ *              per-component budget and reports components that overrun it to DAS. In dev builds it also sends
+ *              the tick's component updates to webviz as a flame view when one does
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "engine/componentTickBudgets.h"
+
+#include "coretech/common/engine/jsonTools.h"
+#include "coretech/common/engine/utils/timer.h"
+#include "engine/aiComponent/aiComponent.h"
+#include "engine/aiComponent/behaviorComponent/behaviorComponent.h"
+#include "engine/robot.h"
+#include "util/logging/DAS.h"
+#include "util/global/globalDefinitions.h"
+#include "util/logging/logging.h"
+#include "webServerProcess/src/webService.h"
+
+#include <algorithm>
+
+#define LOG_CHANNEL "ComponentTickBudgets"
+
+namespace Anki {
+namespace Vector {
+
+namespace {
+  const char* kDefaultBudgetKey            = "DefaultBudget_ms";
+  const char* kBudgetsKey                  = "Budgets_ms";
+  const char* kMinDasSendIntervalKey       = "MinDasSendInterval_s";
+  const char* kMinWebVizOverrunIntervalKey = "MinWebVizOverrunInterval_s";
+
+  // used for anything missing from the config
+  const float kDefaultBudget_ms           = 10.f;
+  const float kMinDasSendInterval_s       = 60.f;
+  const float kMinWebVizOverrunInterval_s = 1.f;
+
+  const float kWebVizPercentilesPeriod_s  = 1.f;
+
+  const std::string kWebVizModuleName = "componentticks";
+}
+
+
+ComponentTickBudgets::ComponentTickBudgets()
+: _defaultBudget_ms(kDefaultBudget_ms)
+, _minDasSendInterval_s(kMinDasSendInterval_s)
+, _minWebVizOverrunInterval_s(kMinWebVizOverrunInterval_s)
+{
+}
+
+
+ComponentTickBudgets::~ComponentTickBudgets()
+{
+}
+
+
+void ComponentTickBudgets::Init(const Json::Value& config, const WebService::WebService* webService)
+{
+  _webService = webService;
+
+  JsonTools::GetValueOptional(config, kDefaultBudgetKey, _defaultBudget_ms);
+  JsonTools::GetValueOptional(config, kMinDasSendIntervalKey, _minDasSendInterval_s);
+  JsonTools::GetValueOptional(config, kMinWebVizOverrunIntervalKey, _minWebVizOverrunInterval_s);
+
+  _budgets_ms.clear();
+  const auto& budgets = config[kBudgetsKey];
+  if (budgets.isObject()) {
+    for (const auto& name : budgets.getMemberNames()) {
+      if (ANKI_VERIFY(budgets[name].isNumeric(), "ComponentTickBudgets.Init.InvalidBudget",
+                      "Budget for %s is not a number", name.c_str())) {
+        _budgets_ms[name] = budgets[name].asFloat();
+      }
+    }
+  }
+}
+
+
+void ComponentTickBudgets::Update(const Robot& robot)
+{
+  const auto& robotUpdateTimes = robot.GetComponentUpdateTimes();
+  if (robotUpdateTimes.empty()) {
+    return;
+  }
+
+  const float currentTime_s = BaseStationTimer::getInstance()->GetCurrentTimeInSeconds();
+
+  // spans are relative to the first robot component's update, which nests everything else. Every robot component
+  // updates every tick, so this is this tick's start
+  Clock::time_point tickStart = robotUpdateTimes.front().lastStart;
+  for (const auto& updateTime : robotUpdateTimes) {
+    tickStart = std::min(tickStart, updateTime.lastStart);
+  }
+
+  _spans.clear();
+  bool overBudget = CheckEntity<RobotComponentID>(robotUpdateTimes, 0, tickStart, currentTime_s, _robotComponentBudgets);
+
+  const AIComponent* aiComponent = robot.GetComponentPtr<AIComponent>();
+  if (aiComponent != nullptr) {
+    overBudget |= CheckEntity<AIComponentID>(aiComponent->GetComponentUpdateTimes(), 1, tickStart, currentTime_s,
+                                             _aiComponentBudgets);
+    const BehaviorComponent* behaviorComponent = aiComponent->GetComponentPtr<BehaviorComponent>();
+    if (behaviorComponent != nullptr) {
+      overBudget |= CheckEntity<BCComponentID>(behaviorComponent->GetComponentUpdateTimes(), 2, tickStart, currentTime_s,
+                                               _behaviorComponentBudgets);
+    }
+  }
+
+#if ANKI_DEV_CHEATS
+  if ((_webService != nullptr) && _webService->IsWebVizClientSubscribed(kWebVizModuleName)) {
+    if (overBudget && (currentTime_s - _lastWebVizOverrunTime_s >= _minWebVizOverrunInterval_s)) {
+      SendOverrunToWebViz(currentTime_s);
+      _lastWebVizOverrunTime_s = currentTime_s;
+    }
+    if (currentTime_s - _lastWebVizPercentilesTime_s >= kWebVizPercentilesPeriod_s) {
+      SendRecentUpdateTimesToWebViz(robot);
+      _lastWebVizPercentilesTime_s = currentTime_s;
+    }
+  }
+#endif
+}
+
+
+template<typename EnumType>
+void ComponentTickBudgets::InitEntityBudgets(const std::vector<typename DependencyManagedEntity<EnumType>::ComponentUpdateTime>& updateTimes,
+                                             EntityBudgets& entityBudgets) const
+{
+  const std::string entityName = GetEntityNameForEnumType<EnumType>();
+
+  entityBudgets.names.clear();
+  entityBudgets.budgets_ms.clear();
+  for (const auto& updateTime : updateTimes) {
+    std::string name = entityName + "." + GetComponentStringForID<EnumType>(updateTime.id);
+    const auto it = _budgets_ms.find(name);
+    entityBudgets.budgets_ms.push_back((it != _budgets_ms.end()) ? it->second : _defaultBudget_ms);
+    entityBudgets.names.push_back(std::move(name));
+  }
+  entityBudgets.lastDasSendTime_s.assign(updateTimes.size(), -_minDasSendInterval_s);
+}
+
+
+template<typename EnumType>
+bool ComponentTickBudgets::CheckEntity(const std::vector<typename DependencyManagedEntity<EnumType>::ComponentUpdateTime>& updateTimes,
+                                       const int depth,
+                                       const Clock::time_point& tickStart,
+                                       const float currentTime_s,
+                                       EntityBudgets& entityBudgets)
+{
+  // update order is fixed once the entity has updated, so this only happens once
+  if (entityBudgets.names.size() != updateTimes.size()) {
+    InitEntityBudgets<EnumType>(updateTimes, entityBudgets);
+  }
+
+  bool overBudget = false;
+  for (size_t i = 0; i < updateTimes.size(); ++i) {
+    const auto& updateTime = updateTimes[i];
+    // components that didn't update this tick still hold their last update's time, which was already checked
+    if (updateTime.lastStart < tickStart) {
+      continue;
+    }
+    const float budget_ms = entityBudgets.budgets_ms[i];
+
+    ComponentSpan span;
+    span.name        = &entityBudgets.names[i];
+    span.depth       = depth;
+    span.start_ms    = std::chrono::duration<float, std::milli>(updateTime.lastStart - tickStart).count();
+    span.duration_ms = updateTime.lastDuration_ms;
+    span.budget_ms   = budget_ms;
+#if ANKI_DEV_CHEATS
+    _spans.push_back(span);
+#endif
+
+    if (updateTime.lastDuration_ms <= budget_ms) {
+      continue;
+    }
+    overBudget = true;
+
+    if (currentTime_s - entityBudgets.lastDasSendTime_s[i] >= _minDasSendInterval_s) {
+      entityBudgets.lastDasSendTime_s[i] = currentTime_s;
+
+      LOG_WARNING("ComponentTickBudgets.OverBudget", "%s took %.2fms (budget %.2fms, median %.2fms)",
+                  span.name->c_str(), updateTime.lastDuration_ms, budget_ms, updateTime.recent_ms.GetMedian());
+
+      DASMSG(robot_component_over_budget, "robot.component_over_budget",
+             "A component's update took longer than its tick budget (rate limited per component)");
+      DASMSG_SET(s1, *span.name, "Component (entity.component)");
+      DASMSG_SET(i1, (int64_t)(updateTime.lastDuration_ms * 1000.f), "Update duration (us)");
+      DASMSG_SET(i2, (int64_t)(budget_ms * 1000.f), "Budget (us)");
+      DASMSG_SET(i3, (int64_t)(updateTime.recent_ms.GetPercentile(0.9f) * 1000.f), "90th percentile of recent update durations (us)");
+      DASMSG_SEND();
+    }
+  }
+  return overBudget;
+}
+
+
+void ComponentTickBudgets::SendOverrunToWebViz(const float currentTime_s) const
+{
+  Json::Value data;
+  data["type"] = "overrun";
+  data["time_s"] = currentTime_s;
+
+  Json::Value& spans = data["spans"];
+  spans = Json::arrayValue;
+  for (const auto& span : _spans) {
+    Json::Value entry;
+    entry["name"]        = *span.name;
+    entry["depth"]       = span.depth;
+    entry["start_ms"]    = span.start_ms;
+    entry["duration_ms"] = span.duration_ms;
+    entry["budget_ms"]   = span.budget_ms;
+    spans.append(std::move(entry));
+  }
+
+  _webService->SendToWebViz(kWebVizModuleName, std::move(data));
+}
+
+
+void ComponentTickBudgets::SendRecentUpdateTimesToWebViz(const Robot& robot) const
+{
+  Json::Value data;
+  data["type"] = "percentiles";
+
+  Json::Value& components = data["components"];
+  components = Json::arrayValue;
+  AppendEntityUpdateTimes<RobotComponentID>(robot.GetComponentUpdateTimes(), _robotComponentBudgets, components);
+
+  const AIComponent* aiComponent = robot.GetComponentPtr<AIComponent>();
+  if (aiComponent != nullptr) {
+    AppendEntityUpdateTimes<AIComponentID>(aiComponent->GetComponentUpdateTimes(), _aiComponentBudgets, components);
+    const BehaviorComponent* behaviorComponent = aiComponent->GetComponentPtr<BehaviorComponent>();
+    if (behaviorComponent != nullptr) {
+      AppendEntityUpdateTimes<BCComponentID>(behaviorComponent->GetComponentUpdateTimes(), _behaviorComponentBudgets,
+                                             components);
+    }
+  }
+
+  _webService->SendToWebViz(kWebVizModuleName, std::move(data));
+}
+
+
+template<typename EnumType>
+void ComponentTickBudgets::AppendEntityUpdateTimes(const std::vector<typename DependencyManagedEntity<EnumType>::ComponentUpdateTime>& updateTimes,
+                                                   const EntityBudgets& entityBudgets,
+                                                   Json::Value& components) const
+{
+  if (entityBudgets.names.size() != updateTimes.size()) {
+    return;
+  }
+  for (size_t i = 0; i < updateTimes.size(); ++i) {
+    const auto& recent_ms = updateTimes[i].recent_ms;
+    Json::Value entry;
+    entry["name"]      = entityBudgets.names[i];
+    entry["budget_ms"] = entityBudgets.budgets_ms[i];
+    entry["p50_ms"]    = recent_ms.GetPercentile(0.5f);
+    entry["p90_ms"]    = recent_ms.GetPercentile(0.9f);
+    entry["p99_ms"]    = recent_ms.GetPercentile(0.99f);
+    entry["max_ms"]    = recent_ms.GetMax();
+    components.append(std::move(entry));
+  }
+}
+
+
+void ComponentTickBudgets::AppendRecentUpdateTimes(const Robot& robot, std::string& str) const
+{
+  str += "Component,Budget_ms,P50_ms,P90_ms,P99_ms,Max_ms,NumSamples\n";
+  AppendEntityUpdateTimes<RobotComponentID>(robot.GetComponentUpdateTimes(), _robotComponentBudgets, str);
+
+  const AIComponent* aiComponent = robot.GetComponentPtr<AIComponent>();
+  if (aiComponent != nullptr) {
+    AppendEntityUpdateTimes<AIComponentID>(aiComponent->GetComponentUpdateTimes(), _aiComponentBudgets, str);
+    const BehaviorComponent* behaviorComponent = aiComponent->GetComponentPtr<BehaviorComponent>();
+    if (behaviorComponent != nullptr) {
+      AppendEntityUpdateTimes<BCComponentID>(behaviorComponent->GetComponentUpdateTimes(), _behaviorComponentBudgets,
+                                             str);
+    }
+  }
+}
+
+
+template<typename EnumType>
+void ComponentTickBudgets::AppendEntityUpdateTimes(const std::vector<typename DependencyManagedEntity<EnumType>::ComponentUpdateTime>& updateTimes,
+                                                   const EntityBudgets& entityBudgets,
+                                                   std::string& str) const
+{
+  // budgets (and names) are only known once the entity's times have been checked by Update
+  if (entityBudgets.names.size() != updateTimes.size()) {
+    return;
+  }
+  char line[256];
+  for (size_t i = 0; i < updateTimes.size(); ++i) {
+    const auto& recent_ms = updateTimes[i].recent_ms;
+    snprintf(line, sizeof(line), "%s,%.3f,%.3f,%.3f,%.3f,%.3f,%u\n",
+             entityBudgets.names[i].c_str(),
+             entityBudgets.budgets_ms[i],
+             recent_ms.GetPercentile(0.5f),
+             recent_ms.GetPercentile(0.9f),
+             recent_ms.GetPercentile(0.99f),
+             recent_ms.GetMax(),
+             recent_ms.GetNum());
+    str += line;
+  }
+}
+
+
+} // Vector namespace
+} // Anki namespace
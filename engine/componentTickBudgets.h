@@ -0,0 +1,116 @@
+/**
+ * File: componentTickBudgets.h
+ *
+ * Description: Checks how long each robot, AI and behavior component's update took against a configurable
+ *              per-component budget and reports components that overrun it to DAS. In dev builds it also sends
+ *              the tick's component updates to webviz as a flame view when one does
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#ifndef __Engine_ComponentTickBudgets_H__
+#define __Engine_ComponentTickBudgets_H__
+
+#include "util/entityComponent/dependencyManagedEntity.h"
+#include "util/helpers/noncopyable.h"
+
+#include "json/json.h"
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+
+class Robot;
+
+namespace WebService {
+  class WebService;
+}
+
+class ComponentTickBudgets : private Util::noncopyable
+{
+public:
+  ComponentTickBudgets();
+  ~ComponentTickBudgets();
+
+  void Init(const Json::Value& config, const WebService::WebService* webService);
+
+  // Check the update times from this tick against their budgets. Call right after the robot's components
+  // have been updated with update timing on
+  void Update(const Robot& robot);
+
+  // One line per component with the percentiles of its recent update times
+  void AppendRecentUpdateTimes(const Robot& robot, std::string& str) const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  // One component's update within the tick, for the flame view
+  struct ComponentSpan {
+    const std::string* name;
+    int   depth;
+    float start_ms;
+    float duration_ms;
+    float budget_ms;
+  };
+
+  // Budget and DAS rate limiting for the components of one entity, in update order
+  struct EntityBudgets {
+    std::vector<std::string> names;
+    std::vector<float>       budgets_ms;
+    std::vector<float>       lastDasSendTime_s;
+  };
+
+  // Fill in budgets the first time the entity's update times are seen
+  template<typename EnumType>
+  void InitEntityBudgets(const std::vector<typename DependencyManagedEntity<EnumType>::ComponentUpdateTime>& updateTimes,
+                         EntityBudgets& entityBudgets) const;
+
+  // Add the entity's spans to _spans, and report the components that went over budget.
+  // Returns true if any did
+  template<typename EnumType>
+  bool CheckEntity(const std::vector<typename DependencyManagedEntity<EnumType>::ComponentUpdateTime>& updateTimes,
+                   const int depth,
+                   const Clock::time_point& tickStart,
+                   const float currentTime_s,
+                   EntityBudgets& entityBudgets);
+
+  template<typename EnumType>
+  void AppendEntityUpdateTimes(const std::vector<typename DependencyManagedEntity<EnumType>::ComponentUpdateTime>& updateTimes,
+                               const EntityBudgets& entityBudgets,
+                               std::string& str) const;
+
+  template<typename EnumType>
+  void AppendEntityUpdateTimes(const std::vector<typename DependencyManagedEntity<EnumType>::ComponentUpdateTime>& updateTimes,
+                               const EntityBudgets& entityBudgets,
+                               Json::Value& components) const;
+
+  void SendOverrunToWebViz(const float currentTime_s) const;
+  void SendRecentUpdateTimesToWebViz(const Robot& robot) const;
+
+  const WebService::WebService* _webService = nullptr;
+
+  float _defaultBudget_ms;
+  std::map<std::string, float> _budgets_ms;
+  float _minDasSendInterval_s;
+  float _minWebVizOverrunInterval_s;
+
+  EntityBudgets _robotComponentBudgets;
+  EntityBudgets _aiComponentBudgets;
+  EntityBudgets _behaviorComponentBudgets;
+
+  // this tick's component updates, for the flame view (dev builds only)
+  std::vector<ComponentSpan> _spans;
+
+  float _lastWebVizOverrunTime_s = 0.f;
+  float _lastWebVizPercentilesTime_s = 0.f;
+};
+
+} // Vector namespace
+} // Anki namespace
+
+#endif // __Engine_ComponentTickBudgets_H__
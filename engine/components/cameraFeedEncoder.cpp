@@ -0,0 +1,306 @@
+/**
+ * File: cameraFeedEncoder.cpp
+ *
+ * Description: Jpg compresses the camera feed for viz and the SDK on its own thread and splits it into the
+ *              ImageChunks they are sent as. Only the latest image is kept, so a slow encoder or a slow consumer
+ *              skips frames instead of falling behind, and quality/resolution are lowered while frames are
+ *              being skipped
+ *
+ * Copyright: Anki, Inc. 2026
+ **/
+
+#include "engine/components/cameraFeedEncoder.h"
+
+#include "proto/external_interface/shared.pb.h"
+
+#include "util/logging/logging.h"
+#include "util/threading/threadPriority.h"
+
+#include <bitset>
+#include <chrono>
+
+#define LOG_CHANNEL "VisionComponent"
+
+namespace Anki {
+namespace Vector {
+
+namespace {
+  // Shared by every image sent as chunks so that receivers can tell images apart
+  std::atomic<u32> sImageId{0};
+}
+
+EncodedCameraImage::EncodedCameraImage() = default;
+EncodedCameraImage::~EncodedCameraImage() = default;
+
+void EncodedCameraImage::BuildChunks(const Vision::CompressedImage& img, u8 displayIndex,
+                                     bool buildClad, bool buildProto)
+{
+  const std::vector<u8>& compressedBuffer = img.GetCompressedBuffer();
+
+  const u32 kMaxChunkSize = static_cast<u32>(ImageConstants::IMAGE_CHUNK_SIZE);
+  const u32 numBytes = static_cast<u32>(compressedBuffer.size());
+  const u8 imageChunkCount = (numBytes + kMaxChunkSize - 1) / kMaxChunkSize;
+  const u32 imageId = ++sImageId;
+  const bool isGray = (img.GetNumChannels() == 1);
+
+  numCladChunks  = (buildClad  ? imageChunkCount : 0);
+  numProtoChunks = (buildProto ? imageChunkCount : 0);
+
+  if(cladChunks.size() < numCladChunks)
+  {
+    cladChunks.resize(numCladChunks);
+  }
+
+  while(protoChunks.size() < numProtoChunks)
+  {
+    protoChunks.emplace_back(new external_interface::ImageChunk());
+  }
+
+  for(u8 chunkId = 0; chunkId < imageChunkCount; ++chunkId)
+  {
+    const u32 offset = chunkId * kMaxChunkSize;
+    const u32 chunkSize = std::min(numBytes - offset, kMaxChunkSize);
+    const u8* chunkData = compressedBuffer.data() + offset;
+
+    if(buildClad)
+    {
+      ImageChunk& m = cladChunks[chunkId];
+      m.height = img.GetNumRows();
+      m.width  = img.GetNumCols();
+      m.displayIndex = displayIndex;
+      m.imageId = imageId;
+      m.frameTimeStamp = img.GetTimestamp();
+      m.imageChunkCount = imageChunkCount;
+      m.imageEncoding = (isGray ? Vision::ImageEncoding::JPEGGray : Vision::ImageEncoding::JPEGColor);
+      m.chunkId = chunkId;
+      m.data.assign(chunkData, chunkData + chunkSize);
+    }
+
+    if(buildProto)
+    {
+      external_interface::ImageChunk* imageChunk = protoChunks[chunkId].get();
+      imageChunk->set_height((u32)img.GetNumRows());
+      imageChunk->set_width((u32)img.GetNumCols());
+      imageChunk->set_display_index((u32)displayIndex);
+      imageChunk->set_image_id(imageId);
+      imageChunk->set_frame_time_stamp(img.GetTimestamp());
+      imageChunk->set_image_chunk_count((u32)imageChunkCount);
+      imageChunk->set_image_encoding(isGray ?
+                                     external_interface::ImageChunk_ImageEncoding_JPEG_GRAY :
+                                     external_interface::ImageChunk_ImageEncoding_JPEG_COLOR);
+      imageChunk->set_chunk_id((u32)chunkId);
+      // Assigning into the existing string keeps its capacity from the last image
+      imageChunk->set_data(chunkData, chunkSize);
+    }
+  }
+}
+
+
+const std::array<CameraFeedQualityController::Level, CameraFeedQualityController::kNumLevels>
+CameraFeedQualityController::kLevels{{
+  {50, false},
+  {40, false},
+  {30, false},
+  {40, true},
+  {30, true},
+  {20, true},
+}};
+
+constexpr u32 CameraFeedQualityController::kWindowSize;
+constexpr u32 CameraFeedQualityController::kBackloggedFramesToStepDown;
+constexpr u32 CameraFeedQualityController::kGoodFramesToStepUp;
+
+CameraFeedQualityController::CameraFeedQualityController()
+{
+  static_assert(kWindowSize <= 32, "CameraFeedQualityController.WindowDoesNotFitInMask");
+}
+
+bool CameraFeedQualityController::AddFrame(bool wasBacklogged)
+{
+  const u32 windowMask = (kWindowSize == 32 ? 0xFFFFFFFF : ((1u << kWindowSize) - 1));
+  _window = ((_window << 1) | (wasBacklogged ? 1 : 0)) & windowMask;
+
+  if(wasBacklogged)
+  {
+    _numGoodFramesInARow = 0;
+
+    const size_t numBacklogged = std::bitset<32>(_window).count();
+    if(numBacklogged >= kBackloggedFramesToStepDown && _levelIndex + 1 < kNumLevels)
+    {
+      ++_levelIndex;
+      ClearHistory();
+      return true;
+    }
+  }
+  else
+  {
+    ++_numGoodFramesInARow;
+
+    if(_numGoodFramesInARow >= kGoodFramesToStepUp && _levelIndex > 0)
+    {
+      --_levelIndex;
+      ClearHistory();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void CameraFeedQualityController::ClearHistory()
+{
+  _window = 0;
+  _numGoodFramesInARow = 0;
+}
+
+
+CameraFeedEncoder::CameraFeedEncoder() = default;
+
+CameraFeedEncoder::~CameraFeedEncoder()
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _running = false;
+  }
+  _imageReadyCondition.notify_one();
+
+  if(_thread.joinable())
+  {
+    _thread.join();
+  }
+}
+
+void CameraFeedEncoder::SubmitImage(const Vision::ImageRGB& image, u8 displayIndex, bool buildClad, bool buildProto)
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if(!_running)
+    {
+      // Only start the thread once something actually wants the camera feed
+      _running = true;
+      _thread = std::thread(&CameraFeedEncoder::EncoderThread, this);
+    }
+
+    if(_hasNextImage)
+    {
+      // Encoder hasn't gotten to the previous image yet, drop it in favor of this one
+      _wasNextImageSkipped = true;
+      ++_numSkippedImages;
+    }
+
+    const TimeStamp_t timestamp = image.GetTimestamp();
+    if(_lastSubmittedTimestamp > 0 && timestamp > _lastSubmittedTimestamp)
+    {
+      _timeBetweenImages_ms = timestamp - _lastSubmittedTimestamp;
+    }
+    _lastSubmittedTimestamp = timestamp;
+
+    // Shares image's data instead of copying it
+    _nextImage = image;
+    _hasNextImage = true;
+    _nextDisplayIndex = displayIndex;
+    _nextBuildClad = buildClad;
+    _nextBuildProto = buildProto;
+  }
+  _imageReadyCondition.notify_one();
+}
+
+const EncodedCameraImage* CameraFeedEncoder::TakeEncodedImage()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  // Whatever was taken last time is done being sent and can be reused
+  _takenIndex = _readyIndex;
+  _readyIndex = kNoEncodedImage;
+
+  return (_takenIndex == kNoEncodedImage ? nullptr : &_encodedImages[_takenIndex]);
+}
+
+s32 CameraFeedEncoder::GetFreeEncodedImageIndex() const
+{
+  for(s32 i = 0; i < (s32)_encodedImages.size(); ++i)
+  {
+    if(i != _readyIndex && i != _takenIndex)
+    {
+      return i;
+    }
+  }
+
+  DEV_ASSERT(false, "CameraFeedEncoder.GetFreeEncodedImageIndex.NoFreeImage");
+  return kNoEncodedImage;
+}
+
+void CameraFeedEncoder::EncoderThread()
+{
+  Anki::Util::SetThreadName(pthread_self(), "CameraFeedEnc");
+
+  std::unique_lock<std::mutex> lock(_mutex);
+
+  while(true)
+  {
+    _imageReadyCondition.wait(lock, [this]() { return !_running || _hasNextImage; });
+    if(!_running)
+    {
+      break;
+    }
+
+    Vision::ImageRGB image = _nextImage;
+    _nextImage = Vision::ImageRGB();
+    _hasNextImage = false;
+
+    const u8 displayIndex = _nextDisplayIndex;
+    const bool buildClad = _nextBuildClad;
+    const bool buildProto = _nextBuildProto;
+    bool wasBacklogged = _wasNextImageSkipped;
+    _wasNextImageSkipped = false;
+    const TimeStamp_t timeBetweenImages_ms = _timeBetweenImages_ms;
+
+    // Neither the image waiting to be taken nor the one taken last can change to this index while it is being
+    // encoded, only this thread picks the index for a new image
+    const s32 index = GetFreeEncodedImageIndex();
+
+    lock.unlock();
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    const CameraFeedQualityController::Level& level = _qualityController.GetLevel();
+    EncodedCameraImage& encoded = _encodedImages[index];
+    if(level.halfResolution)
+    {
+      image.Halve(_halfImage);
+      encoded.image.Compress(_halfImage, level.quality);
+    }
+    else
+    {
+      encoded.image.Compress(image, level.quality);
+    }
+    encoded.BuildChunks(encoded.image, displayIndex, buildClad, buildProto);
+
+    const auto encodeTime_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                 std::chrono::steady_clock::now() - startTime).count();
+
+    lock.lock();
+
+    if(_readyIndex != kNoEncodedImage)
+    {
+      // The last encoded image was never sent, whoever sends them isn't keeping up
+      wasBacklogged = true;
+      ++_numSkippedImages;
+    }
+    _readyIndex = index;
+
+    const bool tooSlowToEncode = (timeBetweenImages_ms > 0 && encodeTime_ms > timeBetweenImages_ms);
+    if(_qualityController.AddFrame(wasBacklogged || tooSlowToEncode))
+    {
+      const CameraFeedQualityController::Level& newLevel = _qualityController.GetLevel();
+      LOG_INFO("CameraFeedEncoder.EncoderThread.QualityChanged",
+               "Quality:%d HalfResolution:%d EncodeTime:%lldms TimeBetweenImages:%ums NumSkipped:%u",
+               newLevel.quality, newLevel.halfResolution, (long long)encodeTime_ms,
+               timeBetweenImages_ms, _numSkippedImages.load());
+    }
+  }
+}
+
+} // namespace Vector
+} // namespace Anki
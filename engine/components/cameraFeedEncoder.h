@@ -0,0 +1,156 @@
+/**
+ * File: cameraFeedEncoder.h
+ *
+ * Description: Jpg compresses the camera feed for viz and the SDK on its own thread and splits it into the
+ *              ImageChunks they are sent as. Only the latest image is kept, so a slow encoder or a slow consumer
+ *              skips frames instead of falling behind, and quality/resolution are lowered while frames are
+ *              being skipped
+ *
+ * Copyright: Anki, Inc. 2026
+ **/
+
+#ifndef __Anki_Vector_Engine_Components_CameraFeedEncoder_H__
+#define __Anki_Vector_Engine_Components_CameraFeedEncoder_H__
+
+#include "clad/types/imageTypes.h"
+#include "coretech/common/shared/types.h"
+#include "coretech/vision/engine/compressedImage.h"
+#include "coretech/vision/engine/image.h"
+#include "util/helpers/noncopyable.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Anki {
+
+namespace Vector {
+
+namespace external_interface {
+  class ImageChunk;
+}
+
+// A compressed image split into the chunks each consumer is sent. Chunks are reused from image to image so that
+// their data buffers keep their capacity
+struct EncodedCameraImage
+{
+  EncodedCameraImage();
+  ~EncodedCameraImage();
+
+  // Split image into chunks for the consumers asked for (clad for viz/game, proto for the SDK)
+  void BuildChunks(const Vision::CompressedImage& image, u8 displayIndex, bool buildClad, bool buildProto);
+
+  Vision::CompressedImage image;
+
+  std::vector<ImageChunk> cladChunks;
+  u32 numCladChunks = 0;
+
+  std::vector<std::unique_ptr<external_interface::ImageChunk>> protoChunks;
+  u32 numProtoChunks = 0;
+};
+
+
+// Picks the jpg quality and resolution to encode at from how many recent frames were skipped because the encoder,
+// or whoever sends the encoded images, couldn't keep up
+class CameraFeedQualityController
+{
+public:
+
+  struct Level
+  {
+    s32  quality;
+    bool halfResolution;
+  };
+
+  CameraFeedQualityController();
+
+  // Record whether a frame was skipped (or took longer to encode than the time between frames).
+  // Returns true if the level changed
+  bool AddFrame(bool wasBacklogged);
+
+  const Level& GetLevel() const { return kLevels[_levelIndex]; }
+  size_t GetLevelIndex() const { return _levelIndex; }
+
+  static constexpr size_t kNumLevels = 6;
+  static const std::array<Level, kNumLevels> kLevels;
+
+  // Step down a level when this many of the last kWindowSize frames were backlogged
+  static constexpr u32 kWindowSize = 8;
+  static constexpr u32 kBackloggedFramesToStepDown = 2;
+
+  // Step back up after this many frames in a row without a backlog
+  static constexpr u32 kGoodFramesToStepUp = 30;
+
+private:
+
+  void ClearHistory();
+
+  size_t _levelIndex = 0;
+  u32    _window     = 0; // bit i set if the i'th most recent frame was backlogged
+  u32    _numGoodFramesInARow = 0;
+};
+
+
+class CameraFeedEncoder : private Util::noncopyable
+{
+public:
+
+  CameraFeedEncoder();
+  ~CameraFeedEncoder();
+
+  // Hand the encoder thread an image to compress. The image's data must not be modified afterwards (e.g. pass a
+  // copy). Replaces any image still waiting to be encoded.
+  // buildClad/buildProto say which consumers to build chunks for
+  void SubmitImage(const Vision::ImageRGB& image, u8 displayIndex, bool buildClad, bool buildProto);
+
+  // Returns the most recently encoded image that hasn't been taken yet, or nullptr. It stays valid until the next
+  // call. An encoded image that isn't taken before the next one is ready is skipped
+  const EncodedCameraImage* TakeEncodedImage();
+
+  // Number of images skipped, waiting to be encoded or waiting to be taken, since the encoder was created
+  u32 GetNumSkippedImages() const { return _numSkippedImages; }
+
+private:
+
+  static constexpr s32 kNoEncodedImage = -1;
+
+  void EncoderThread();
+
+  // Index of an encoded image slot that is neither waiting to be taken nor taken
+  s32 GetFreeEncodedImageIndex() const;
+
+  std::thread             _thread;
+  std::mutex              _mutex;
+  std::condition_variable _imageReadyCondition;
+  bool                    _running = false;
+
+  // Latest image waiting to be encoded
+  Vision::ImageRGB _nextImage;
+  bool             _hasNextImage = false;
+  u8               _nextDisplayIndex = 0;
+  bool             _nextBuildClad = false;
+  bool             _nextBuildProto = false;
+  bool             _wasNextImageSkipped = false;
+  TimeStamp_t      _lastSubmittedTimestamp = 0;
+  TimeStamp_t      _timeBetweenImages_ms = 0;
+
+  // One being encoded, one waiting to be taken and one taken (and being sent)
+  std::array<EncodedCameraImage, 3> _encodedImages;
+  s32 _readyIndex = kNoEncodedImage;
+  s32 _takenIndex = kNoEncodedImage;
+
+  // Only touched by the encoder thread
+  Vision::ImageRGB            _halfImage;
+  CameraFeedQualityController _qualityController;
+
+  std::atomic<u32> _numSkippedImages{0};
+};
+
+} // namespace Vector
+} // namespace Anki
+
+#endif // __Anki_Vector_Engine_Components_CameraFeedEncoder_H__
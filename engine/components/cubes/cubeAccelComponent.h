@@ -61,6 +61,9 @@ public:
     dependencies.insert(RobotComponentID::CubeComms);
   };
   virtual void UpdateDependent(const RobotCompMap& dependentComps) override;
+  // UpdateDependent only prunes unused listeners from _listenerMap, which is otherwise only touched by accel
+  // messages and by AddListener - neither comes from another thread safe component's update
+  virtual bool IsUpdateThreadSafe() const override { return true; }
   //////
   // end IDependencyManagedComponent functions
   //////
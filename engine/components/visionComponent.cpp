@@ -19,6 +19,7 @@
 #include "engine/blockWorld/blockWorld.h"
 #include "engine/blockWorld/blockWorldFilter.h"
 #include "engine/components/animationComponent.h"
+#include "engine/components/cameraFeedEncoder.h"
 #include "engine/components/dockingComponent.h"
 #include "engine/components/nvStorageComponent.h"
 #include "engine/components/photographyManager.h"
@@ -165,6 +166,8 @@ namespace Vector {
     _vizManager = _context->GetVizManager();
     _camera = std::make_unique<Vision::Camera>(_robot->GetID());
     _visionSystem = new VisionSystem(_context);
+    _cameraFeedEncoder = std::make_unique<CameraFeedEncoder>();
+    _debugEncodedImage = std::make_unique<EncodedCameraImage>();
 
     // Set up event handlers
     if(nullptr != _context && nullptr != _context->GetExternalInterface())
@@ -455,6 +458,8 @@ namespace Vector {
     // Check and update any results from VisionSystem
     UpdateAllResults();
 
+    SendEncodedCameraFeed();
+
     UpdateCaptureFormatChange();
 
     // If we don't yet have an image to process, we need to capture one
@@ -985,10 +990,10 @@ namespace Vector {
       // Get historical robot pose at this processing result's timestamp to get
       // head angle and to attach as parent of the camera pose.
       RobotTimeStamp_t t;
-      HistRobotState* histStatePtr = nullptr;
+      HistRobotState histState;
       HistStateKey histStateKey;
 
-      lastResult = _robot->GetStateHistory()->ComputeAndInsertStateAt(procResult.timestamp, t, &histStatePtr, &histStateKey, true);
+      lastResult = _robot->GetStateHistory()->ComputeAndInsertStateAt(procResult.timestamp, t, histState, &histStateKey, true);
 
       if(RESULT_FAIL_ORIGIN_MISMATCH == lastResult)
       {
@@ -1007,10 +1012,10 @@ namespace Vector {
         return RESULT_OK;
       }
 
-      if(!_robot->IsPoseInWorldOrigin(histStatePtr->GetPose())) {
+      if(!_robot->IsPoseInWorldOrigin(histState.GetPose())) {
         LOG_INFO("VisionComponent.UpdateVisionMarkers.OldOrigin",
                  "Ignoring observed marker from origin %s (robot origin is %s)",
-                 histStatePtr->GetPose().FindRoot().GetName().c_str(),
+                 histState.GetPose().FindRoot().GetName().c_str(),
                  _robot->GetWorldOrigin().GetName().c_str());
         return RESULT_OK;
       }
@@ -1019,7 +1024,11 @@ namespace Vector {
       // and this should be true
       assert(procResult.timestamp == t);
 
-      Vision::Camera histCamera = _robot->GetHistoricalCamera(*histStatePtr, procResult.timestamp);
+      // The camera's pose is parented to the state stored in history (not the copy), so that updates to that
+      // state (e.g. when localizing to an object seen in this image) carry over to these markers
+      const HistRobotState* storedHistState = _robot->GetStateHistory()->GetComputedState(histStateKey);
+      DEV_ASSERT(nullptr != storedHistState, "VisionComponent.UpdateVisionMarkers.NoStoredHistState");
+      Vision::Camera histCamera = _robot->GetHistoricalCamera(*storedHistState, procResult.timestamp);
 
       // Note: we deliberately make a copy of the vision markers in observedMarkers
       // as we loop over them here, because procResult is const but we want to modify
@@ -1547,122 +1556,69 @@ namespace Vector {
       return RESULT_FAIL;
     }
 
-    ImageChunk m;
     const bool vizConnected = _robot->GetContext()->GetVizManager()->IsConnected();
     if(!vizConnected && !_sendProtoImageChunks)
     {
       return RESULT_OK;
     }
 
-    const std::vector<u8>& compressedBuffer = img.GetCompressedBuffer();
-
-    std::string data;
-    external_interface::ImageChunk* imageChunk = nullptr;
-    external_interface::GatewayWrapper wrapper;
-
-    const u32 kMaxChunkSize = static_cast<u32>(ImageConstants::IMAGE_CHUNK_SIZE);
-    u32 bytesRemainingToSend = static_cast<u32>(compressedBuffer.size());
+    _debugEncodedImage->BuildChunks(img, GetVizDisplayIndex(identifier), vizConnected, _sendProtoImageChunks);
+    SendEncodedImage(*_debugEncodedImage);
 
-    static u32 imgID = 0;
-    u8 chunkId = 0;
-    u8 imageChunkCount = ceilf((f32)bytesRemainingToSend / kMaxChunkSize);
-    u8 displayIndex;
-    ++imgID;
+    return RESULT_OK;
+  }
 
+  u8 VisionComponent::GetVizDisplayIndex(const std::string& identifier)
+  {
     auto displayIndexIter = _vizDisplayIndexMap.find(identifier);
     if(displayIndexIter == _vizDisplayIndexMap.end())
     {
       // New identifier
-      displayIndex = Util::numeric_cast<s32>(_vizDisplayIndexMap.size());
+      const s32 displayIndex = Util::numeric_cast<s32>(_vizDisplayIndexMap.size());
       _vizDisplayIndexMap.emplace(identifier, displayIndex); // NOTE: this will increase size() for next time
+      return displayIndex;
     }
-    else
-    {
-      displayIndex = displayIndexIter->second;
-    }
-
-    // Construct a clad ImageChunk
-    if(vizConnected)
-    {
-      m.height = img.GetNumRows();
-      m.width  = img.GetNumCols();
 
-      // Use the identifier value as the display index
-      m.displayIndex = displayIndex;
-
-      m.imageId = imgID;
+    return displayIndexIter->second;
+  }
 
-      m.frameTimeStamp = img.GetTimestamp();
-      m.imageChunkCount = imageChunkCount;
-      if(img.GetNumChannels() == 1)
-      {
-        m.imageEncoding = Vision::ImageEncoding::JPEGGray;
-      }
-      else
-      {
-        m.imageEncoding = Vision::ImageEncoding::JPEGColor;
-      }
+  void VisionComponent::SendEncodedCameraFeed()
+  {
+    if(!_robot->HasExternalInterface())
+    {
+      return;
     }
 
-    // Construct a proto ImageChunk
-    if(_sendProtoImageChunks)
+    // Compressing and chunking happened on the encoder's thread, only the broadcasts happen here
+    const EncodedCameraImage* encodedImage = _cameraFeedEncoder->TakeEncodedImage();
+    if(nullptr != encodedImage)
     {
-      imageChunk = new external_interface::ImageChunk();
-      imageChunk->set_height((u32)img.GetNumRows());
-      imageChunk->set_width((u32)img.GetNumCols());
-
-      imageChunk->set_display_index((u32)displayIndex);
-
-      imageChunk->set_image_id(imgID);
-      imageChunk->set_frame_time_stamp(img.GetTimestamp());
-      imageChunk->set_image_chunk_count((u32)imageChunkCount);
-      if(img.GetNumChannels() == 1)
-      {
-        imageChunk->set_image_encoding(external_interface::ImageChunk_ImageEncoding_JPEG_GRAY);
-      }
-      else
-      {
-        imageChunk->set_image_encoding(external_interface::ImageChunk_ImageEncoding_JPEG_COLOR);
-      }
+      SendEncodedImage(*encodedImage);
     }
+  }
 
-    while (bytesRemainingToSend > 0)
+  void VisionComponent::SendEncodedImage(const EncodedCameraImage& encodedImage)
+  {
+    if(encodedImage.numProtoChunks > 0)
     {
-      u32 chunkSize = std::min(bytesRemainingToSend, kMaxChunkSize);
-
-      auto startIt = compressedBuffer.begin() + (compressedBuffer.size() - bytesRemainingToSend);
-      auto endIt = startIt + chunkSize;
-
-      if(_sendProtoImageChunks)
+      external_interface::GatewayWrapper wrapper;
+      for(u32 i = 0; i < encodedImage.numProtoChunks; ++i)
       {
-        imageChunk->set_chunk_id((u32)chunkId);
-        data.assign(startIt, endIt);
-        imageChunk->set_data(std::move(data));
-
-        wrapper.set_allocated_image_chunk(imageChunk);
+        // Lend the chunk to the wrapper instead of copying it
+        wrapper.set_allocated_image_chunk(encodedImage.protoChunks[i].get());
         _robot->GetGatewayInterface()->Broadcast(wrapper);
-        imageChunk = wrapper.release_image_chunk();
-      }
-
-      if(vizConnected)
-      {
-        m.chunkId = chunkId;
-        m.data = std::vector<u8>(startIt, endIt);
-
-        _robot->Broadcast(ExternalInterface::MessageEngineToGame(ImageChunk(m)));
-        // Forward the image chunks to Viz as well (Note that this does nothing if
-        // sending images is disabled in VizManager)
-        _robot->GetContext()->GetVizManager()->SendImageChunk(m);
+        wrapper.release_image_chunk();
       }
-
-      bytesRemainingToSend -= chunkSize;
-      ++chunkId;
     }
 
-    Util::SafeDelete(imageChunk);
-
-    return RESULT_OK;
-
+    for(u32 i = 0; i < encodedImage.numCladChunks; ++i)
+    {
+      const ImageChunk& m = encodedImage.cladChunks[i];
+      _robot->Broadcast(ExternalInterface::MessageEngineToGame(ImageChunk(m)));
+      // Forward the image chunks to Viz as well (Note that this does nothing if
+      // sending images is disabled in VizManager)
+      _robot->GetContext()->GetVizManager()->SendImageChunk(m);
+    }
   }
 
   Result VisionComponent::ClearCalibrationImages()
@@ -2728,7 +2684,13 @@ namespace Vector {
 
     if(result.modesProcessed.Contains(VisionMode::Viz))
     {
-      SendCompressedImage(result.compressedDisplayImg, "camera");
+      const bool vizConnected = _robot->GetContext()->GetVizManager()->IsConnected();
+      if(vizConnected || _sendProtoImageChunks)
+      {
+        // Result's displayImg is not touched again once the result is handed over, so the encoder can share it
+        _cameraFeedEncoder->SubmitImage(result.displayImg, GetVizDisplayIndex("camera"),
+                                        vizConnected, _sendProtoImageChunks);
+      }
     }
   }
 
@@ -56,7 +56,9 @@ namespace Vector {
 
 // Forward declaration
 class Robot;
+class CameraFeedEncoder;
 class CozmoContext;
+struct EncodedCameraImage;
 struct ImageSaverParams;
 struct VisionProcessingResult;
 class VisionSystem;
@@ -344,6 +346,8 @@ struct DockingErrorSignal;
     VisionSystem* _visionSystem = nullptr;
     VizManager*   _vizManager = nullptr;
     std::map<std::string, s32> _vizDisplayIndexMap;
+    std::unique_ptr<CameraFeedEncoder> _cameraFeedEncoder;
+    std::unique_ptr<EncodedCameraImage> _debugEncodedImage; // Reused chunks for sending debug images
     std::list<std::pair<EngineTimeStamp_t, Vision::SalientPoint>> _salientPointsToDraw;
     std::string _mirrorModeDisplayString;
     ColorRGBA _mirrorModeStringColor;
@@ -474,9 +478,17 @@ struct DockingErrorSignal;
     // such as saving images or running dot test
     void UpdateForCalibration();
 
-    // Send images from result's displayImg and debug image lists to Viz/SDK
+    // Send images from result's debug image list to Viz/SDK and hand its displayImg to the camera feed encoder
     void SendImages(VisionProcessingResult& result);
 
+    // Send the latest image from the camera feed encoder, if there is a new one
+    void SendEncodedCameraFeed();
+
+    // Broadcast the chunks of an encoded image to Viz/SDK
+    void SendEncodedImage(const EncodedCameraImage& encodedImage);
+
+    u8 GetVizDisplayIndex(const std::string& identifier);
+
     void SetLiftCrossBar();
 
     Vision::ImageEncoding GetCurrentImageFormat() const;
@@ -138,8 +138,8 @@ void ProtoMessageHandler::Broadcast(const external_interface::GatewayWrapper& me
              "UiMessageHandler.GameToEngineRef.BroadcastOffEngineThread");
 
   DeliverToExternal(message);
-  _eventMgr.Broadcast(AnkiEvent<external_interface::GatewayWrapper>(
-    BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(), static_cast<u32>(message.GetTag()), message));
+  _eventMgr.Broadcast(BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(),
+                      static_cast<u32>(message.GetTag()), message);
 }
 
 
@@ -151,8 +151,8 @@ void ProtoMessageHandler::Broadcast(external_interface::GatewayWrapper&& message
              "UiMessageHandler.GameToEngineRef.BroadcastOffEngineThread");
 
   DeliverToExternal(message);
-  _eventMgr.Broadcast(AnkiEvent<external_interface::GatewayWrapper>(
-    BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(), static_cast<u32>(message.GetTag()), std::move(message)));
+  _eventMgr.Broadcast(BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(),
+                      static_cast<u32>(message.GetTag()), message);
 } // Broadcast(MessageGameToEngine &&)
 
 
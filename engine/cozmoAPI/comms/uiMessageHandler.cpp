@@ -398,26 +398,27 @@ namespace Anki {
     // Broadcasting MessageGameToEngine messages are only internal
     void UiMessageHandler::Broadcast(const ExternalInterface::MessageGameToEngine& message)
     {
-      ANKI_CPU_PROFILE("UiMH::Broadcast_GToE"); // Some expensive and untracked - TODO: Capture message type for profile
+      ANKI_CPU_PROFILE("UiMH::Broadcast_GToE"); // Some expensive and untracked - the trace span below has the type
+      ANKI_CPU_TRACE_SPAN("message", ExternalInterface::MessageGameToEngineTagToString(message.GetTag()));
 
       DEV_ASSERT(nullptr == _context || _context->IsEngineThread(),
                  "UiMessageHandler.GameToEngineRef.BroadcastOffEngineThread");
 
-      _eventMgrToEngine.Broadcast(AnkiEvent<ExternalInterface::MessageGameToEngine>(
-        BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(), static_cast<u32>(message.GetTag()), message));
+      _eventMgrToEngine.Broadcast(BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(),
+                                  static_cast<u32>(message.GetTag()), message);
     } // Broadcast(MessageGameToEngine)
 
 
     void UiMessageHandler::Broadcast(ExternalInterface::MessageGameToEngine&& message)
     {
       ANKI_CPU_PROFILE("UiMH::BroadcastMove_GToE");
+      ANKI_CPU_TRACE_SPAN("message", ExternalInterface::MessageGameToEngineTagToString(message.GetTag()));
 
       DEV_ASSERT(nullptr == _context || _context->IsEngineThread(),
                  "UiMessageHandler.GameToEngineRval.BroadcastOffEngineThread");
 
       u32 type = static_cast<u32>(message.GetTag());
-      _eventMgrToEngine.Broadcast(AnkiEvent<ExternalInterface::MessageGameToEngine>(
-        BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(), type, std::move(message)));
+      _eventMgrToEngine.Broadcast(BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(), type, message);
     } // Broadcast(MessageGameToEngine &&)
 
 
@@ -444,27 +445,28 @@ namespace Anki {
     void UiMessageHandler::Broadcast(const ExternalInterface::MessageEngineToGame& message)
     {
       ANKI_CPU_PROFILE("UiMH::Broadcast_EToG");
+      ANKI_CPU_TRACE_SPAN("message", ExternalInterface::MessageEngineToGameTagToString(message.GetTag()));
 
       DEV_ASSERT(nullptr == _context || _context->IsEngineThread(),
                  "UiMessageHandler.EngineToGameRef.BroadcastOffEngineThread");
 
       DeliverToGame(message);
-      _eventMgrToGame.Broadcast(AnkiEvent<ExternalInterface::MessageEngineToGame>(
-        BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(), static_cast<u32>(message.GetTag()), message));
+      _eventMgrToGame.Broadcast(BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(),
+                                static_cast<u32>(message.GetTag()), message);
     } // Broadcast(MessageEngineToGame)
 
 
     void UiMessageHandler::Broadcast(ExternalInterface::MessageEngineToGame&& message)
     {
       ANKI_CPU_PROFILE("UiMH::BroadcastMove_EToG");
+      ANKI_CPU_TRACE_SPAN("message", ExternalInterface::MessageEngineToGameTagToString(message.GetTag()));
 
       DEV_ASSERT(nullptr == _context || _context->IsEngineThread(),
                  "UiMessageHandler.EngineToGameRval.BroadcastOffEngineThread");
 
       DeliverToGame(message);
       u32 type = static_cast<u32>(message.GetTag());
-      _eventMgrToGame.Broadcast(AnkiEvent<ExternalInterface::MessageEngineToGame>(
-        BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(), type, std::move(message)));
+      _eventMgrToGame.Broadcast(BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(), type, message);
     } // Broadcast(MessageEngineToGame &&)
 
 
@@ -86,7 +86,7 @@ bool CozmoAPI::Update(const BaseStationTime_t currentTime_nanosec)
   }
 
   // Replace Util::CpuThreadProfiler::kLogFrequencyNever with a small value to output logging,
-  // can be used with Chrome Tracing format
+  // trace captures (see CpuTraceRecorder) record every tick regardless
   ANKI_CPU_TICK("CozmoEngine", kMaxDesiredEngineDuration, Util::CpuProfiler::CpuProfilerLoggingTime(kCozmoEngine_Logging));
 
   return _engineRunner->Update(currentTime_nanosec);
@@ -194,10 +194,11 @@ CozmoEngine::CozmoEngine(Util::Data::DataPlatform* dataPlatform)
   , _animationTransferHandler(new AnimationTransfer(_uiMsgHandler.get(), dataPlatform))
 {
 #if ANKI_CPU_PROFILER_ENABLED
-  // Initialize CPU profiler early and put tracing file at known location with no dependencies on other systems
+  // Initialize CPU profiler early and put trace captures at known location with no dependencies on other systems.
+  // Every process captures to the same directory, so their traces can be loaded side by side.
   Anki::Util::CpuProfiler::GetInstance();
-  Anki::Util::CpuThreadProfiler::SetChromeTracingFile(
-      dataPlatform->pathToResource(Util::Data::Scope::Cache, "vic-engine-tracing.json").c_str());
+  Anki::Util::CpuTraceRecorder::GetInstance().Init(
+      dataPlatform->pathToResource(Util::Data::Scope::Cache, "tracing"), "vic-engine");
   Anki::Util::CpuThreadProfiler::SendToWebVizCallback([&](const Json::Value& json) { _context->GetWebService()->SendToWebViz("cpuprofile", json); });
 #endif
 
@@ -236,6 +237,11 @@ CozmoEngine::~CozmoEngine()
   _engineState = EngineState::ShuttingDown;
   _context->GetWebService()->Stop();
 
+#if ANKI_CPU_PROFILER_ENABLED
+  // Close off any capture still running, so the trace isn't left unfinished
+  Anki::Util::CpuTraceRecorder::GetInstance().StopCapture();
+#endif
+
   if (Anki::Util::gTickTimeProvider == BaseStationTimer::getInstance()) {
     Anki::Util::gTickTimeProvider = nullptr;
   }
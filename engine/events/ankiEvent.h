@@ -22,6 +22,9 @@
 namespace Anki {
 namespace Vector {
 
+// Tag for constructing an AnkiEvent that borrows its payload instead of copying it
+struct BorrowEventData {};
+
 template <typename DataType>
 class AnkiEvent
 {
@@ -34,6 +37,7 @@ public:
   : _currentTime(time)
   , _myType(type)
   , _data( std::make_shared<DataType>(std::forward<FwdType>(newData)) )
+  , _dataPtr( _data.get() )
   { }
 
   template <typename FwdType>
@@ -41,17 +45,55 @@ public:
   : _currentTime(0.0)
   , _myType(type)
   , _data( std::make_shared<DataType>(std::forward<FwdType>(newData)) )
+  , _dataPtr( _data.get() )
+  { }
+
+  // Refers to newData without copying it, so the event must not outlive it. Meant for broadcasting, since handlers
+  // are called synchronously. Handlers that keep a copy of the event get their own copy of the data, so copies are
+  // always safe to hold on to
+  AnkiEvent(BorrowEventData, double time, uint32_t type, const DataType& newData)
+  : _currentTime(time)
+  , _myType(type)
+  , _dataPtr( &newData )
   { }
 
+  AnkiEvent(const AnkiEvent& other)
+  : _currentTime(other._currentTime)
+  , _myType(other._myType)
+  , _data( other._data ? other._data : std::make_shared<DataType>(*other._dataPtr) )
+  , _dataPtr( _data.get() )
+  { }
+
+  // moving out of a borrowed event still has to copy, since the data belongs to someone else
+  AnkiEvent(AnkiEvent&& other)
+  : _currentTime(other._currentTime)
+  , _myType(other._myType)
+  , _data( other._data ? std::move(other._data) : std::make_shared<DataType>(*other._dataPtr) )
+  , _dataPtr( _data.get() )
+  { }
+
+  AnkiEvent& operator=(AnkiEvent other)
+  {
+    std::swap(_currentTime, other._currentTime);
+    std::swap(_myType, other._myType);
+    std::swap(_data, other._data);
+    std::swap(_dataPtr, other._dataPtr);
+    return *this;
+  }
+
   double GetCurrentTime() const { return _currentTime; }
   uint32_t GetType() const { return _myType; }
-  const DataType& GetData() const { return *_data; }
+  const DataType& GetData() const { return *_dataPtr; }
+
+  // true if the event owns (a shared reference to) its data, false if it's borrowing it
+  bool OwnsData() const { return _data != nullptr; }
   
 protected:
 
   double _currentTime;
   uint32_t _myType;
   std::shared_ptr<DataType> _data;
+  const DataType* _dataPtr;
   
 }; // class Event
 
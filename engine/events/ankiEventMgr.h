@@ -23,11 +23,67 @@
 #include <stdint.h>
 #include <unordered_map>
 #include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
 
 namespace Anki {
 namespace Vector {
 
 
+// Number of event types that get a slot in a flat handler table. CLAD unions have a one byte Tag enum, so all of
+// their tags fit in a table of 256 handlers. Other data types only use the hash map
+template<typename DataType, typename = void>
+struct NumDenseEventTypes : std::integral_constant<size_t, 0> { };
+
+template<typename DataType>
+struct NumDenseEventTypes<DataType, typename std::enable_if<std::is_enum<typename DataType::Tag>::value &&
+                                                           (sizeof(typename DataType::Tag) == 1)>::type>
+  : std::integral_constant<size_t, 256> { };
+
+// Handlers for each event type. Types below NumDenseTypes are found with a single index into a table, the rest in
+// a hash map. Handlers never move once created, since subscription handles point to them
+template<typename SignalStruct, size_t NumDenseTypes>
+class EventHandlerTable
+{
+public:
+  EventHandlerTable() : _dense(NumDenseTypes) { }
+
+  // returns the handlers for the given type, or nullptr if nobody ever subscribed to it
+  SignalStruct* Find(const uint32_t type)
+  {
+    if (type < NumDenseTypes) {
+      return _dense[type].get();
+    }
+    auto iter = _sparse.find(type);
+    return (iter != _sparse.end()) ? &iter->second : nullptr;
+  }
+
+  // returns the handlers for the given type, creating them if needed
+  SignalStruct& Get(const uint32_t type)
+  {
+    if (type < NumDenseTypes) {
+      if (!_dense[type]) {
+        _dense[type].reset(new SignalStruct());
+      }
+      return *_dense[type];
+    }
+    return _sparse[type];
+  }
+
+  void Clear()
+  {
+    for (auto& handlers : _dense) {
+      handlers.reset();
+    }
+    _sparse.clear();
+  }
+
+private:
+  std::vector<std::unique_ptr<SignalStruct>> _dense;
+  std::unordered_map<uint32_t, SignalStruct> _sparse;
+};
+
 // Base class for the AnkiEventMgr specialized variations
 template<typename DataType, typename SignalStruct>
 class AnkiEventMgrBase : private Util::noncopyable
@@ -37,11 +93,11 @@ public:
   
   virtual void UnsubscribeAll()
   {
-    _eventHandlerMap.clear();
+    _eventHandlers.Clear();
   }
   
 protected:
-  std::unordered_map<uint32_t, SignalStruct>  _eventHandlerMap;
+  EventHandlerTable<SignalStruct, NumDenseEventTypes<DataType>::value> _eventHandlers;
 };
 
 // Shorthand for the Signal type that we use to store our handler references
@@ -63,22 +119,32 @@ public:
   // Broadcasts a given event to everyone that has subscribed to that event type
   void Broadcast(const EventDataType& event)
   {
-    auto iter = this->_eventHandlerMap.find(event.GetType());
-    if (iter != this->_eventHandlerMap.end())
+    SignalStruct* handlers = this->_eventHandlers.Find(event.GetType());
+    if (handlers != nullptr)
+    {
+      handlers->emit(event);
+    }
+  }
+
+  // Broadcasts data without copying it into the event. Handlers that keep the event get their own copy
+  void Broadcast(double time, const uint32_t type, const DataType& data)
+  {
+    SignalStruct* handlers = this->_eventHandlers.Find(type);
+    if (handlers != nullptr)
     {
-      iter->second.emit(event);
+      handlers->emit(EventDataType(BorrowEventData(), time, type, data));
     }
   }
 
   // Allows subscribing to events by type with the passed in function
   Signal::SmartHandle Subscribe(const uint32_t type, SubscriberFunction<DataType> function)
   {
-    return this->_eventHandlerMap[type].ScopedSubscribe(function);
+    return this->_eventHandlers.Get(type).ScopedSubscribe(function);
   }
   
   void SubscribeForever(const uint32_t type, SubscriberFunction<DataType> function)
   {
-    this->_eventHandlerMap[type].SubscribeForever(function);
+    this->_eventHandlers.Get(type).SubscribeForever(function);
   }
 }; // class AnkiEventMgr
 
@@ -106,25 +172,24 @@ public:
   // Broadcasts a given event to everyone that has subscribed to that event type
   void Broadcast(const uint32_t mailbox, const EventDataType& event)
   {
-    auto iter = this->_eventHandlerMap.find(event.GetType());
-    if (iter != this->_eventHandlerMap.end())
+    MailboxSignalMap<DataType>* mailboxes = this->_eventHandlers.Find(event.GetType());
+    if (mailboxes != nullptr)
     {
       if (mailbox == AnyMailboxId)
       {
         // deliver to all mailboxes
-        for (auto& mapPair : iter->second) {
+        for (auto& mapPair : *mailboxes) {
           mapPair.second.emit(event);
         }
       } else {
-        // iter->second is a map: std::map<uint32_t, EventHandlerSignal >
-        // search the inner map for correct mailbox
-        auto innerIter = iter->second.find(mailbox);
-        if (innerIter != iter->second.end()) {
+        // search the map of mailboxes for the correct one
+        auto innerIter = mailboxes->find(mailbox);
+        if (innerIter != mailboxes->end()) {
           innerIter->second.emit(event);
         }
         // also search for AnyMailbox
-        innerIter = iter->second.find(AnyMailboxId);
-        if (innerIter != iter->second.end()) {
+        innerIter = mailboxes->find(AnyMailboxId);
+        if (innerIter != mailboxes->end()) {
           innerIter->second.emit(event);
         }
       }
@@ -134,12 +199,12 @@ public:
   // Allows subscribing to events by type with the passed in function
   Signal::SmartHandle Subscribe(const uint32_t mailbox, const uint32_t type, SubscriberFunction<DataType> function)
   {
-    return this->_eventHandlerMap[type][mailbox].ScopedSubscribe(function);
+    return this->_eventHandlers.Get(type)[mailbox].ScopedSubscribe(function);
   }
   
   void SubscribeForever(const uint32_t mailbox, const uint32_t type, SubscriberFunction<DataType> function)
   {
-    this->_eventHandlerMap[type][mailbox].SubscribeForever(function);
+    this->_eventHandlers.Get(type)[mailbox].SubscribeForever(function);
   }
 }; // class AnkiEventMgr (Mailbox specialization)
 
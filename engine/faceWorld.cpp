@@ -253,19 +253,19 @@ namespace Vector {
     // time the face was seen
     DEV_ASSERT(!face.GetHeadPose().HasParent(), "FaceWorld.AddOrUpdateFace.HeadPoseHasParent");
     RobotTimeStamp_t t=0;
-    HistRobotState* histStatePtr = nullptr;
+    HistRobotState histState;
     HistStateKey histStateKey;
     const Result histStateResult = _robot->GetStateHistory()->ComputeAndInsertStateAt(face.GetTimeStamp(), t,
-                                                                                     &histStatePtr, &histStateKey,
+                                                                                     histState, &histStateKey,
                                                                                      true);
 
-    if(RESULT_OK != histStateResult || histStatePtr == nullptr)
+    if(RESULT_OK != histStateResult)
     {
       PRINT_NAMED_WARNING("FaceWorld.AddOrUpdateFace.GetComputedStateAtFailed", "face timestamp=%u", face.GetTimeStamp());
       return histStateResult;
     }
 
-    const auto& origin = _robot->GetPoseOriginList().GetOriginByID(histStatePtr->GetPose().GetRootID());
+    const auto& origin = _robot->GetPoseOriginList().GetOriginByID(histState.GetPose().GetRootID());
     Pose3d headPoseWrtWorldOrigin(face.GetHeadPose());
     headPoseWrtWorldOrigin.SetParent(origin);
 
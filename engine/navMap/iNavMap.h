@@ -60,6 +60,10 @@ public:
   
   // multi-ray variant of the `AnyOf` method implementation may optimize for this case
   virtual std::vector<bool> AnyOf( const Point2f& start, const std::vector<Point2f>& ends, const NodePredicate& pred) const = 0;
+
+  // multi-ray variant of `AnyOf` that matches any of the given content types. Since it doesn't need to evaluate a
+  // predicate for each node, implementations can answer it from a cached raster of the map
+  virtual std::vector<bool> AnyOf( const Point2f& start, const std::vector<Point2f>& ends, MemoryMapTypes::EContentTypePackedType types) const = 0;
   
   // Pack map data to broadcast
   virtual void GetBroadcastInfo(MemoryMapTypes::MapBroadcastData& info) const = 0;
@@ -759,13 +759,17 @@ void MapComponent::BroadcastMapToWeb(const MapBroadcastData& mapData) const
     return;
   }
 
+  // The whole map is sent as one snapshot, so that a client that is still receiving an older map skips it
+  std::vector<Json::Value> snapshot;
+  snapshot.reserve(2 + (mapData.quadInfo.size() + kQuadsPerMessage - 1) / kQuadsPerMessage);
+
   // Send the begin message
   {
     Json::Value toWeb;
     toWeb["type"] = "MemoryMapMessageVizBegin";
     toWeb["originId"] = _currentMapOriginID;
     toWeb["mapInfo"] = mapData.mapInfo.GetJSON();
-    webService->SendToWebViz(kWebVizModuleName, toWeb);
+    snapshot.push_back(std::move(toWeb));
   }
 
   // chunk the quad messages
@@ -782,7 +786,7 @@ void MapComponent::BroadcastMapToWeb(const MapBroadcastData& mapData) const
     for( auto it = mapData.quadInfo.begin() + start; it != mapData.quadInfo.begin() + end; ++it ) {
       quadInfo.append( it->GetJSON() );
     }
-    webService->SendToWebViz(kWebVizModuleName, toWeb);
+    snapshot.push_back(std::move(toWeb));
   }
 
   // Send the end message
@@ -798,8 +802,10 @@ void MapComponent::BroadcastMapToWeb(const MapBroadcastData& mapData) const
     robotJson["qX"] = _robot->GetPose().GetRotation().GetQuaternion().x();
     robotJson["qY"] = _robot->GetPose().GetRotation().GetQuaternion().y();
     robotJson["qZ"] = _robot->GetPose().GetRotation().GetQuaternion().z();
-    webService->SendToWebViz(kWebVizModuleName, toWeb);
+    snapshot.push_back(std::move(toWeb));
   }
+
+  webService->SendSnapshotToWebViz(kWebVizModuleName, std::move(snapshot));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1516,9 +1522,9 @@ Result MapComponent::AddVisionOverheadEdges(const OverheadEdgeFrame& frameInfo)
   */
 
 
-  NodePredicate isCollisionType = [] (const auto& data) { return (data->type == EContentType::ObstacleProx) ||
-                                                                 (data->type == EContentType::ObstacleObservable) ||
-                                                                 (data->type == EContentType::ObstacleUnrecognized); };
+  const EContentTypePackedType collisionTypes = EContentTypeToFlag(EContentType::ObstacleProx) |
+                                                EContentTypeToFlag(EContentType::ObstacleObservable) |
+                                                EContentTypeToFlag(EContentType::ObstacleUnrecognized);
 
   std::vector<Point2f> validPoints;
   std::vector<Point2f> imagePoints;
@@ -1539,7 +1545,7 @@ Result MapComponent::AddVisionOverheadEdges(const OverheadEdgeFrame& frameInfo)
       imagePoints.push_back(std::move(imagePtOnGround));
     }
   }
-  std::vector<bool> collisionCheckResults = currentMap->AnyOf(robotPose.GetTranslation(), imagePoints, isCollisionType);
+  std::vector<bool> collisionCheckResults = currentMap->AnyOf(robotPose.GetTranslation(), imagePoints, collisionTypes);
 
   validPoints.reserve(imagePoints.size());
   for(int i=0; i<imagePoints.size(); ++i) {
@@ -153,6 +153,7 @@ MemoryMap::MemoryMap()
 )
 {
   _processor.SetRoot( &_quadTree );
+  _processor.UpdateRaster();
 }
 
 MemoryMap::~MemoryMap()
@@ -167,7 +168,9 @@ bool MemoryMap::Merge(const INavMap& other, const Pose3d& transform)
   DEV_ASSERT(dynamic_cast<const MemoryMap*>(&other), "MemoryMap.Merge.UnsupportedClass");
   const MemoryMap& otherMap = static_cast<const MemoryMap&>(other);
   std::unique_lock<std::shared_timed_mutex> lock(_writeAccess);
-  return MONITOR_PERFORMANCE( _quadTree.Merge( otherMap._quadTree, transform ) );
+  const bool changed = MONITOR_PERFORMANCE( _quadTree.Merge( otherMap._quadTree, transform ) );
+  _processor.UpdateRaster();
+  return changed;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -175,14 +178,18 @@ bool MemoryMap::FillBorder(const NodePredicate& innerPred, const NodePredicate&
 {
   // ask the processor to do it
   std::unique_lock<std::shared_timed_mutex> lock(_writeAccess);
-  return MONITOR_PERFORMANCE( _processor.FillBorder(innerPred, outerPred, newData) );
+  const bool changed = MONITOR_PERFORMANCE( _processor.FillBorder(innerPred, outerPred, newData) );
+  _processor.UpdateRaster();
+  return changed;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool MemoryMap::TransformContent(NodeTransformFunction transform, const MemoryMapRegion& region)
 {
   std::unique_lock<std::shared_timed_mutex> lock(_writeAccess);
-  return MONITOR_PERFORMANCE( _quadTree.Transform(region, transform) );
+  const bool changed = MONITOR_PERFORMANCE( _quadTree.Transform(region, transform) );
+  _processor.UpdateRaster();
+  return changed;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -210,6 +217,13 @@ std::vector<bool> MemoryMap::AnyOf( const Point2f& start, const std::vector<Poin
   return _processor.AnyOfRays(start, ends, pred);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::vector<bool> MemoryMap::AnyOf( const Point2f& start, const std::vector<Point2f>& ends, MemoryMapTypes::EContentTypePackedType types) const
+{
+  std::shared_lock<std::shared_timed_mutex> lock(_writeAccess);
+  return MONITOR_PERFORMANCE( _processor.AnyOfRays(start, ends, types) );
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 float MemoryMap::GetArea(const NodePredicate& pred, const MemoryMapRegion& region) const
 {
@@ -233,7 +247,9 @@ bool MemoryMap::Insert(const MemoryMapRegion& r, const MemoryMapData& data)
     currentData->SetLastObservedTime(dataPtr->GetLastObservedTime());
     return currentData->CanOverrideSelfWithContent(dataPtr) ? dataPtr : currentData; 
   };
-  return MONITOR_PERFORMANCE( _quadTree.Insert(r, trfm) );
+  const bool changed = MONITOR_PERFORMANCE( _quadTree.Insert(r, trfm) );
+  _processor.UpdateRaster();
+  return changed;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -241,7 +257,9 @@ bool MemoryMap::Insert(const MemoryMapRegion& r, NodeTransformFunction transform
 {
   // clone data to make into a shared pointer.
   std::unique_lock<std::shared_timed_mutex> lock(_writeAccess);
-  return MONITOR_PERFORMANCE( _quadTree.Insert(r, transform) );
+  const bool changed = MONITOR_PERFORMANCE( _quadTree.Insert(r, transform) );
+  _processor.UpdateRaster();
+  return changed;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -73,6 +73,9 @@ public:
   // implementation may optimize for this case
   virtual std::vector<bool> AnyOf( const Point2f& start, const std::vector<Point2f>& ends, const NodePredicate& pred) const override;
 
+  // multi-ray variant that matches any of the given content types, answered from the processor's raster
+  virtual std::vector<bool> AnyOf( const Point2f& start, const std::vector<Point2f>& ends, MemoryMapTypes::EContentTypePackedType types) const override;
+
   // returns the accumulated area of cells that satisfy the predicate (and region, if supplied)
   virtual float GetArea(const NodePredicate& f, const MemoryMapRegion& r) const override;
 
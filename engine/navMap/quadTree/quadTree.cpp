@@ -39,15 +39,14 @@ QuadTree::QuadTree(
   std::function<void (const QuadTreeNode*)> destructorCallback,
   std::function<void (const QuadTreeNode*, const NodeContent&)> modifiedCallback
 )
+: QuadTreeNodePool(destructorCallback, modifiedCallback)
+, QuadTreeNode(this)
 {
   _sideLen            = kQuadTreeInitialRootSideLength;
   _maxHeight          = kQuadTreeInitialMaxDepth;
   _quadrant           = EQuadrant::Root;
   _address            = {};
   _boundingBox        = AxisAlignedQuad(_center - Point2f(_sideLen*.5f), _center + Point2f(_sideLen*.5));
-
-  _destructorCallback = destructorCallback;
-  _modifiedCallback   = modifiedCallback;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -288,9 +287,10 @@ bool QuadTree::ShiftRoot(const AxisAlignedQuad& region)
   
     if ( xShift )
     {
-      std::vector< std::unique_ptr<QuadTreeNode> > oldChildren;
-      std::swap(oldChildren, _childrenPtr);
+      const NodeBlockIndex oldChildrenBlock = _childBlock;
+      _childBlock = kInvalidNodeBlock;
       Subdivide();
+      QuadTreeNode* oldChildren = GetBlockNodes(oldChildrenBlock);
 
       // make two pairs, (a1->a2) and (b1->b2) that will be swapped depending on the direction of the shift.
       const size_t a1 = (Q2N) ( xPlusAxisReq ? EQuadrant::MinusXPlusY  : EQuadrant::PlusXPlusY);
@@ -298,15 +298,19 @@ bool QuadTree::ShiftRoot(const AxisAlignedQuad& region)
       const size_t b1 = (Q2N) ( xPlusAxisReq ? EQuadrant::MinusXMinusY : EQuadrant::PlusXMinusY);
       const size_t b2 = (Q2N) (!xPlusAxisReq ? EQuadrant::MinusXMinusY : EQuadrant::PlusXMinusY);
 
-      _childrenPtr[a1]->SwapChildrenAndContent(oldChildren[a2].get() );
-      _childrenPtr[b1]->SwapChildrenAndContent(oldChildren[b2].get() );
+      GetChildren()[a1].SwapChildrenAndContent( &oldChildren[a2] );
+      GetChildren()[b1].SwapChildrenAndContent( &oldChildren[b2] );
+
+      // delete everything in oldChildren since we put the nodes we are keeping back into their new position
+      ReleaseBlock(oldChildrenBlock);
     }
 
     if ( yShift )
     {
-      std::vector< std::unique_ptr<QuadTreeNode> > oldChildren;
-      std::swap(oldChildren, _childrenPtr);
+      const NodeBlockIndex oldChildrenBlock = _childBlock;
+      _childBlock = kInvalidNodeBlock;
       Subdivide();
+      QuadTreeNode* oldChildren = GetBlockNodes(oldChildrenBlock);
       
       // make two pairs, (a1->a2) and (b1->b2) that will be swapped depending on the direction of the shift.
       const size_t a1 = (Q2N) ( yPlusAxisReq ? EQuadrant::PlusXMinusY  : EQuadrant::PlusXPlusY);
@@ -314,9 +318,11 @@ bool QuadTree::ShiftRoot(const AxisAlignedQuad& region)
       const size_t b1 = (Q2N) ( yPlusAxisReq ? EQuadrant::MinusXMinusY : EQuadrant::MinusXPlusY);
       const size_t b2 = (Q2N) (!yPlusAxisReq ? EQuadrant::MinusXMinusY : EQuadrant::MinusXPlusY);
 
+      GetChildren()[a1].SwapChildrenAndContent( &oldChildren[a2] );
+      GetChildren()[b1].SwapChildrenAndContent( &oldChildren[b2] );
+
       // delete everything in oldChildren since we put the nodes we are keeping back into their new position
-      _childrenPtr[a1]->SwapChildrenAndContent(oldChildren[a2].get() );
-      _childrenPtr[b1]->SwapChildrenAndContent(oldChildren[b2].get() );
+      ReleaseBlock(oldChildrenBlock);
     }
   }
 
@@ -361,20 +367,16 @@ bool QuadTree::UpgradeRootLevel(const Point2f& direction, uint8_t maxRootLevel)
   ++_maxHeight;
   
   // temporary take its children, then subdivide this node again
-  std::vector< std::unique_ptr<QuadTreeNode> > oldChildren;
-  std::swap(oldChildren, _childrenPtr);
+  const NodeBlockIndex oldChildrenBlock = _childBlock;
+  _childBlock = kInvalidNodeBlock;
   Subdivide();
 
   // calculate the child that takes my place by using the opposite direction to expansion
   QuadTreeNode* childTakingMyPlace = GetChild( Vec2Quadrant(-direction) );
   
-  // set the new parent in my old children
-  for ( auto& childPtr : oldChildren ) {
-    childPtr->ChangeParent( childTakingMyPlace );
-  }
-  
-  // swap children with the temp
-  std::swap(childTakingMyPlace->_childrenPtr, oldChildren);
+  // hand my old children to the child that takes my place (it was just created, so it has none of its own). This
+  // sets the new parent in my old children
+  childTakingMyPlace->SetChildBlock( oldChildrenBlock );
 
   // set the content type I had in the child that takes my place, then reset my content
   childTakingMyPlace->ForceSetContent( NodeContent(_content) );
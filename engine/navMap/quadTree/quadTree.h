@@ -13,6 +13,7 @@
 #define ANKI_COZMO_QUAD_TREE_H
 
 #include "quadTreeNode.h"
+#include "quadTreeNodePool.h"
 
 namespace Anki {
 
@@ -21,7 +22,9 @@ class Pose3d;
 namespace Vector {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-class QuadTree : public QuadTreeNode
+// NOTE: the pool must be the first base so that it is constructed before and destroyed after the root node, since the
+// root releases all other nodes back to the pool when it is destroyed
+class QuadTree : private QuadTreeNodePool, public QuadTreeNode
 {
 public:
 
@@ -42,6 +45,10 @@ public:
   // returns the precision of content data in the memory map. For example, if you add a point, and later query for it,
   // the region that the point generated to store the point could have an error of up to this length.
   float GetContentPrecisionMM() const;
+  
+  // number of non-root nodes currently in the tree, and number of nodes the tree has memory reserved for
+  size_t GetNumNodes()         const { return GetNumUsedBlocks() * kNumChildrenPerNode; }
+  size_t GetNumReservedNodes() const { return GetNumReservedBlocks() * kNumChildrenPerNode; }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // Operations
@@ -70,10 +77,6 @@ private:
   // shiftAllowedCount: number of shifts we can do if the root reaches the max size upon expanding (or already is at max.)
   bool ExpandToFit(const AxisAlignedQuad& region);  
 
-  // quadTrees are always the highest level node, so we cannot change it's parent. If needed, a Merge can insert
-  // a quadtree into an existing tree
-  void ChangeParent(const QuadTreeNode* newParent) = delete;
-
   // moves this node's center towards the required points, so that they can be included in this node
   // returns true if the root shifts, false if it can't shift to accomodate all points or the points are already contained
   bool ShiftRoot(const AxisAlignedQuad& region);
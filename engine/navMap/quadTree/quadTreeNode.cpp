@@ -12,6 +12,7 @@
  * Copyright: Anki, Inc. 2015
 **/
 #include "quadTreeNode.h"
+#include "quadTreeNodePool.h"
 #include "engine/navMap/memoryMap/data/memoryMapData.h"
 
 #include "util/math/math.h"
@@ -30,21 +31,29 @@ namespace {
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-QuadTreeNode::QuadTreeNode(const QuadTreeNode* parent, EQuadrant quadrant)
-: _boundingBox({0,0}, {0,0})
-, _parent(parent)
+QuadTreeNode::QuadTreeNode(QuadTreeNodePool* pool)
+: _pool(pool)
+, _boundingBox({0,0}, {0,0})
+, _childBlock(kInvalidNodeBlock)
+, _siblingBlock(kInvalidNodeBlock)
+, _quadrant(EQuadrant::Root)
+{
+  ResetAddress();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+QuadTreeNode::QuadTreeNode(QuadTreeNodePool* pool, NodeBlockIndex siblingBlock, const QuadTreeNode* parent, EQuadrant quadrant)
+: _pool(pool)
+, _boundingBox({0,0}, {0,0})
+, _childBlock(kInvalidNodeBlock)
+, _siblingBlock(siblingBlock)
 , _quadrant(quadrant)
 {
-  if (_parent) { 
-    float halfLen = _parent->GetSideLen() * .25f;
-    _sideLen      = _parent->GetSideLen() * .5f;
-    _center       = _parent->GetCenter() + Quadrant2Vec(_quadrant) * halfLen;
-    _maxHeight    = _parent->GetMaxHeight() - 1;
-    _boundingBox  = AxisAlignedQuad(_center - Point2f(halfLen), _center + Point2f(halfLen));
-
-    _destructorCallback = _parent->_destructorCallback;
-    _modifiedCallback   = _parent->_modifiedCallback;
-  }
+  float halfLen = parent->GetSideLen() * .25f;
+  _sideLen      = parent->GetSideLen() * .5f;
+  _center       = parent->GetCenter() + Quadrant2Vec(_quadrant) * halfLen;
+  _maxHeight    = parent->GetMaxHeight() - 1;
+  _boundingBox  = AxisAlignedQuad(_center - Point2f(halfLen), _center + Point2f(halfLen));
   
   ResetAddress();
 }
@@ -52,15 +61,17 @@ QuadTreeNode::QuadTreeNode(const QuadTreeNode* parent, EQuadrant quadrant)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 QuadTreeNode::~QuadTreeNode()
 {
-  _destructorCallback(this);
+  _pool->NotifyNodeDestroyed(this);
+  ReleaseChildren();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void QuadTreeNode::ResetAddress()
 {
   _address.clear();
-  if(_parent) { 
-    _address = NodeAddress(_parent->GetAddress()); 
+  const QuadTreeNode* parent = GetParent();
+  if(parent) { 
+    _address = NodeAddress(parent->GetAddress()); 
     _address.push_back(_quadrant);
   }
 }
@@ -70,14 +81,12 @@ bool QuadTreeNode::Subdivide()
 {
   if ( (_maxHeight == 0) || IsSubdivided() ) { return false; }
   
-  // create new children, push our data to them, then clear our own data
-  _childrenPtr.emplace_back( new QuadTreeNode(this, EQuadrant::PlusXPlusY) );   // up L
-  _childrenPtr.emplace_back( new QuadTreeNode(this, EQuadrant::PlusXMinusY) );  // up R
-  _childrenPtr.emplace_back( new QuadTreeNode(this, EQuadrant::MinusXPlusY) );  // lo L
-  _childrenPtr.emplace_back( new QuadTreeNode(this, EQuadrant::MinusXMinusY) ); // lo R
-
-  for ( auto& childPtr : _childrenPtr ) {
-    childPtr->ForceSetContent( NodeContent(_content) );
+  // create new children in a pool block, push our data to them, then clear our own data
+  _childBlock = _pool->AllocateBlock(this);
+
+  QuadTreeNode* children = GetChildren();
+  for ( size_t i = 0; i < kNumChildrenPerNode; ++i ) {
+    children[i].ForceSetContent( NodeContent(_content) );
   }
 
   ForceSetContent(NodeContent());
@@ -92,9 +101,11 @@ void QuadTreeNode::TryAutoMerge()
     return;
   }
 
+  const QuadTreeNode* children = GetChildren();
+
   // can't merge if any children are subdivided
-  for (const auto& child : _childrenPtr) {
-    if ( child->IsSubdivided() ) {
+  for ( size_t i = 0; i < kNumChildrenPerNode; ++i ) {
+    if ( children[i].IsSubdivided() ) {
       return;
     }
   }
@@ -102,19 +113,30 @@ void QuadTreeNode::TryAutoMerge()
   bool allChildrenEqual = true;
   
   // check if all children classified the same content (assumes node content equality is transitive)
-  for(size_t i=0; i<_childrenPtr.size()-1; ++i)
+  for(size_t i=0; i<kNumChildrenPerNode-1; ++i)
   {
-    allChildrenEqual &= (_childrenPtr[i]->GetData() == _childrenPtr[i+1]->GetData());
+    allChildrenEqual &= (children[i].GetData() == children[i+1].GetData());
   }
   
   // we can merge and set that type on this parent
   if ( allChildrenEqual )
   {
     // do a copy since merging will destroy children
-    auto content = _childrenPtr[0]->GetData();
+    auto content = children[0].GetData();
     ForceSetContent(std::move(content));
 
-    _childrenPtr.clear();    
+    ReleaseChildren();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void QuadTreeNode::ReleaseChildren()
+{
+  if ( IsSubdivided() ) {
+    // clear our link first so that we are seen as a leaf while the children notify their destruction
+    const NodeBlockIndex childBlock = _childBlock;
+    _childBlock = kInvalidNodeBlock;
+    _pool->ReleaseBlock(childBlock);
   }
 }
 
@@ -122,32 +144,32 @@ void QuadTreeNode::TryAutoMerge()
 void QuadTreeNode::ForceSetContent(NodeContent&& newContent)
 {
   std::swap(_content, newContent);
-  _modifiedCallback(this, newContent);
+  _pool->NotifyNodeModified(this, newContent);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void QuadTreeNode::ChangeParent(const QuadTreeNode* newParent) 
+void QuadTreeNode::SetChildBlock(NodeBlockIndex childBlock) 
 { 
-  _parent = newParent; 
-  FoldFunctor reset = [] (QuadTreeNode& node) { node.ResetAddress(); };
-  Fold(reset);
+  _childBlock = childBlock;
+  if ( IsSubdivided() ) {
+    // the whole block changes parent at once, then the addresses of all descendants have to be recomputed
+    _pool->SetBlockParent(_childBlock, this);
+
+    FoldFunctor reset = [] (QuadTreeNode& node) { node.ResetAddress(); };
+    QuadTreeNode* children = GetChildren();
+    for ( size_t i = 0; i < kNumChildrenPerNode; ++i ) {
+      children[i].Fold(reset);
+    }
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void QuadTreeNode::SwapChildrenAndContent(QuadTreeNode* otherNode)
 {
-  // swap children
-  std::swap(_childrenPtr, otherNode->_childrenPtr);
-
-  // notify the children of the parent change
-  for ( auto& childPtr : _childrenPtr ) {
-    childPtr->ChangeParent( this );
-  }
-
-  // notify the children of the parent change
-  for ( auto& childPtr : otherNode->_childrenPtr ) {
-    childPtr->ChangeParent( otherNode );
-  }
+  // swap children, which notifies them of the parent change
+  const NodeBlockIndex myPrevChildren = _childBlock;
+  SetChildBlock( otherNode->_childBlock );
+  otherNode->SetChildBlock( myPrevChildren );
 
   // swap contents by use of copy, since changes have to be notified to the processor
   auto myPrevContent = _content;
@@ -155,23 +177,55 @@ void QuadTreeNode::SwapChildrenAndContent(QuadTreeNode* otherNode)
   otherNode->ForceSetContent(std::move(myPrevContent));
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const QuadTreeNode* QuadTreeNode::GetParent() const
+{
+  const QuadTreeNode* ret =
+    ( IsRootNode() ) ?
+    ( nullptr ) :
+    ( _pool->GetBlockParent(_siblingBlock) );
+  return ret;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const QuadTreeNode* QuadTreeNode::GetChildren() const
+{
+  const QuadTreeNode* ret =
+    ( !IsSubdivided() ) ?
+    ( nullptr ) :
+    ( _pool->GetBlockNodes(_childBlock) );
+  return ret;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+QuadTreeNode* QuadTreeNode::GetChildren()
+{
+  QuadTreeNode* ret =
+    ( !IsSubdivided() ) ?
+    ( nullptr ) :
+    ( _pool->GetBlockNodes(_childBlock) );
+  return ret;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const QuadTreeNode* QuadTreeNode::GetChild(EQuadrant quadrant) const
 {
+  const QuadTreeNode* children = GetChildren();
   const QuadTreeNode* ret =
-    ( _childrenPtr.empty() ) ?
+    ( children == nullptr ) ?
     ( nullptr ) :
-    ( _childrenPtr[(std::underlying_type<EQuadrant>::type)quadrant].get() );
+    ( &children[(std::underlying_type<EQuadrant>::type)quadrant] );
   return ret;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 QuadTreeNode* QuadTreeNode::GetChild(EQuadrant quadrant)
 {
+  QuadTreeNode* children = GetChildren();
   QuadTreeNode* ret =
-    ( _childrenPtr.empty() ) ?
+    ( children == nullptr ) ?
     ( nullptr ) :
-    ( _childrenPtr[(std::underlying_type<EQuadrant>::type)quadrant].get() );
+    ( &children[(std::underlying_type<EQuadrant>::type)quadrant] );
   return ret;
 }
 
@@ -181,9 +235,10 @@ void QuadTreeNode::AddSmallestDescendants(EDirection direction, std::vector<cons
   if ( !IsSubdivided() ) {
     descendants.emplace_back( this );
   } else {
-    for (const auto& child : _childrenPtr) {
-      if(!IsSibling(child->_quadrant, direction)) { 
-        child->AddSmallestDescendants(direction, descendants); 
+    const QuadTreeNode* children = GetChildren();
+    for ( size_t i = 0; i < kNumChildrenPerNode; ++i ) {
+      if(!IsSibling(children[i]._quadrant, direction)) { 
+        children[i].AddSmallestDescendants(direction, descendants); 
       };
     }
   }
@@ -196,12 +251,12 @@ const QuadTreeNode* QuadTreeNode::FindSingleNeighbor(EDirection direction) const
   
   EQuadrant destination = GetQuadrantInDirection(_quadrant, direction);
 
-  // if stepping in the current direction keeps us under the same parent node
+  // if stepping in the current direction keeps us under the same parent node, the neighbor is in our own block
   if ( IsSibling(_quadrant, direction) ) {
-    return _parent->GetChild( destination );
+    return &_pool->GetBlockNodes(_siblingBlock)[(std::underlying_type<EQuadrant>::type)destination];
   } 
 
-  const QuadTreeNode* parentNeighbor = _parent->FindSingleNeighbor( direction );
+  const QuadTreeNode* parentNeighbor = GetParent()->FindSingleNeighbor( direction );
   if (parentNeighbor) {
     const QuadTreeNode* directNeighbor = parentNeighbor->GetChild( destination );
     
@@ -304,15 +359,18 @@ void QuadTreeNode::Fold(FoldFunctor& accumulator, const FoldableRegion& region,
   
   if (FoldDirection::BreadthFirst == dir) { accumulator(*this); } 
 
-  if ( region.ContainsQuad(_boundingBox) ) { 
-    for ( const auto& cPtr : _childrenPtr ) {
-      cPtr->Fold(accumulator, kNodeRegion, dir); 
-    }
-  } else {
-    u8 childFilter = IsSubdivided() ? GetChildFilterMask(_center, region.GetBoundingBox()) : 0;        
-    for ( const auto& cPtr : _childrenPtr ) { 
-      if (childFilter & 0x1) { cPtr->Fold(accumulator, region, dir); }
-      if ((childFilter >>= 1) == 0) { break; };
+  if ( IsSubdivided() ) {
+    QuadTreeNode* children = GetChildren();
+    if ( region.ContainsQuad(_boundingBox) ) { 
+      for ( size_t i = 0; i < kNumChildrenPerNode; ++i ) {
+        children[i].Fold(accumulator, kNodeRegion, dir); 
+      }
+    } else {
+      u8 childFilter = GetChildFilterMask(_center, region.GetBoundingBox());        
+      for ( size_t i = 0; i < kNumChildrenPerNode; ++i ) { 
+        if (childFilter & 0x1) { children[i].Fold(accumulator, region, dir); }
+        if ((childFilter >>= 1) == 0) { break; };
+      }
     }
   }
 
@@ -326,15 +384,18 @@ void QuadTreeNode::Fold(const FoldFunctorConst& accumulator, const FoldableRegio
   
   if (FoldDirection::BreadthFirst == dir) { accumulator(*this); } 
 
-  if ( region.ContainsQuad(_boundingBox) ) { 
-    for ( const auto& cPtr : _childrenPtr ) {
-      cPtr->Fold(accumulator, kNodeRegion, dir); 
-    }
-  } else {
-    u8 childFilter = IsSubdivided() ? GetChildFilterMask(_center, region.GetBoundingBox()) : 0;        
-    for ( const auto& cPtr : _childrenPtr ) { 
-      if (childFilter & 0x1) { cPtr->Fold(accumulator, region, dir); }
-      if ((childFilter >>= 1) == 0) { break; };
+  if ( IsSubdivided() ) {
+    const QuadTreeNode* children = GetChildren();
+    if ( region.ContainsQuad(_boundingBox) ) { 
+      for ( size_t i = 0; i < kNumChildrenPerNode; ++i ) {
+        children[i].Fold(accumulator, kNodeRegion, dir); 
+      }
+    } else {
+      u8 childFilter = GetChildFilterMask(_center, region.GetBoundingBox());        
+      for ( size_t i = 0; i < kNumChildrenPerNode; ++i ) { 
+        if (childFilter & 0x1) { children[i].Fold(accumulator, region, dir); }
+        if ((childFilter >>= 1) == 0) { break; };
+      }
     }
   }
 
@@ -22,20 +22,23 @@
 namespace Anki {
 namespace Vector {
 
+class QuadTreeNodePool;
+
 using namespace QuadTreeTypes;
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 class QuadTreeNode : private Util::noncopyable
 {
   friend class QuadTree;
+  friend class QuadTreeNodePool;
 public:
   ~QuadTreeNode();
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // Accessors
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-  bool                   IsRootNode()     const { return _parent == nullptr; }
-  bool                   IsSubdivided()   const { return !_childrenPtr.empty(); }
+  bool                   IsRootNode()     const { return _siblingBlock == kInvalidNodeBlock; }
+  bool                   IsSubdivided()   const { return _childBlock != kInvalidNodeBlock; }
   uint8_t                GetMaxHeight()   const { return _maxHeight; }
   float                  GetSideLen()     const { return _sideLen; }
   const Point2f&         GetCenter()      const { return _center; }
@@ -57,9 +60,12 @@ protected:
   // Initialization
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   
-  // Leave the constructor as a protected member so only the root node or other Quad tree nodes can create new nodes
+  // Leave the constructors as protected members so only the root node or the pool can create new nodes
   // it will allow subdivision as long as level is greater than 0
-  QuadTreeNode(const QuadTreeNode* parent = nullptr, EQuadrant quadrant = EQuadrant::Root);
+  explicit QuadTreeNode(QuadTreeNodePool* pool);
+  
+  // constructs a child node in place inside the pool block 'siblingBlock'
+  QuadTreeNode(QuadTreeNodePool* pool, NodeBlockIndex siblingBlock, const QuadTreeNode* parent, EQuadrant quadrant);
     
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // Modification
@@ -77,10 +83,14 @@ protected:
   // force sets the type and updates shared container
   void ForceSetContent(NodeContent&& newContent);
   
-  // sets a new parent to this node. Used on expansions
-  void ChangeParent(const QuadTreeNode* newParent);
+  // takes ownership of the given block of children (or none), updating the block's parent and the children's address.
+  // Used on expansions
+  void SetChildBlock(NodeBlockIndex childBlock);
   
-  // swaps children and content with 'otherNode', updating the children's parent pointer
+  // destroys all children, returning their block to the pool
+  void ReleaseChildren();
+  
+  // swaps children and content with 'otherNode', updating the children's parent link
   void SwapChildrenAndContent(QuadTreeNode* otherNode);
   
   // run the provided accumulator function recursively over the tree for all nodes intersecting with region (if provided).
@@ -92,9 +102,16 @@ protected:
   // Exploration
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   
+  // get the parent of this node, or null if this is the root
+  const QuadTreeNode* GetParent() const;
+  
   // get the child in the given quadrant, or null if this node is not subdivided
   const QuadTreeNode* GetChild(EQuadrant quadrant) const;
   QuadTreeNode* GetChild(EQuadrant quadrant);
+  
+  // get the first of the kNumChildrenPerNode contiguous children, or null if this node is not subdivided
+  const QuadTreeNode* GetChildren() const;
+  QuadTreeNode* GetChildren();
 
   // iterate until we reach the nodes that have a border in the given direction, and add them to the vector
   // NOTE: this method is expected to NOT clear the vector before adding descendants
@@ -110,8 +127,8 @@ protected:
   
   // NOTE: try to minimize padding in these attributes
 
-  // children when subdivided. Can be empty or have 4 nodes
-  std::vector< std::unique_ptr<QuadTreeNode> > _childrenPtr;
+  // pool that owns the memory for all the non-root nodes of the tree, and holds the notification callbacks
+  QuadTreeNodePool* _pool;
 
   // coordinates of this quad
   Point2f _center;
@@ -119,8 +136,11 @@ protected:
 
   AxisAlignedQuad _boundingBox;
 
-  // parent node
-  const QuadTreeNode* _parent;
+  // block in the pool holding our 4 children when subdivided, kInvalidNodeBlock otherwise
+  NodeBlockIndex _childBlock;
+  
+  // block in the pool this node lives in (its parent is the owner of that block), kInvalidNodeBlock for the root
+  NodeBlockIndex _siblingBlock;
 
   // our level
   uint8_t _maxHeight;
@@ -131,10 +151,6 @@ protected:
   
   // information about what's in this quad
   NodeContent _content;
-
-  // callbacks to notify external system if an element has changed or been destroyed
-  std::function<void (const QuadTreeNode*)> _destructorCallback;
-  std::function<void (const QuadTreeNode*, const NodeContent&)> _modifiedCallback;
     
 }; // class
   
@@ -0,0 +1,82 @@
+/**
+ * File: quadTreeNodePool.cpp
+ *
+ * Description: Arena that owns the memory for all non-root nodes of a QuadTree. See header for details.
+ *
+ * Copyright: Anki, Inc. 2026
+ **/
+#include "quadTreeNodePool.h"
+
+#include "util/logging/logging.h"
+
+#include <new>
+
+namespace Anki {
+namespace Vector {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+QuadTreeNodePool::QuadTreeNodePool(DestructorCallback destructorCallback, ModifiedCallback modifiedCallback)
+: _numUsedBlocks(0)
+, _destructorCallback(destructorCallback)
+, _modifiedCallback(modifiedCallback)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+QuadTreeNodePool::~QuadTreeNodePool()
+{
+  // every block should have been released by its parent node before the pool goes away. QuadTree guarantees this
+  // by inheriting from the pool before QuadTreeNode, so the root node is destroyed first
+  DEV_ASSERT_MSG(_numUsedBlocks == 0, "QuadTreeNodePool.Destructor.LeakedBlocks", "%zu blocks still in use", _numUsedBlocks);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+NodeBlockIndex QuadTreeNodePool::AllocateBlock(const QuadTreeNode* parent)
+{
+  // grow by a whole chunk if there is nothing to recycle
+  if ( _freeBlocks.empty() )
+  {
+    const NodeBlockIndex firstNewBlock = (NodeBlockIndex) (_chunks.size() * kBlocksPerChunk);
+    _chunks.emplace_back( new NodeBlock[kBlocksPerChunk] );
+
+    // push in reverse order so that blocks are handed out in address order
+    _freeBlocks.reserve( _freeBlocks.size() + kBlocksPerChunk );
+    for ( NodeBlockIndex i = kBlocksPerChunk; i > 0; --i ) {
+      _freeBlocks.push_back( firstNewBlock + i - 1 );
+    }
+  }
+
+  const NodeBlockIndex blockIdx = _freeBlocks.back();
+  _freeBlocks.pop_back();
+  ++_numUsedBlocks;
+
+  // set parent before constructing the nodes, since they compute their address from it
+  SetBlockParent(blockIdx, parent);
+
+  QuadTreeNode* nodes = GetBlockNodes(blockIdx);
+  new (&nodes[0]) QuadTreeNode(this, blockIdx, parent, EQuadrant::PlusXPlusY);   // up L
+  new (&nodes[1]) QuadTreeNode(this, blockIdx, parent, EQuadrant::PlusXMinusY);  // up R
+  new (&nodes[2]) QuadTreeNode(this, blockIdx, parent, EQuadrant::MinusXPlusY);  // lo L
+  new (&nodes[3]) QuadTreeNode(this, blockIdx, parent, EQuadrant::MinusXMinusY); // lo R
+
+  return blockIdx;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void QuadTreeNodePool::ReleaseBlock(NodeBlockIndex blockIdx)
+{
+  DEV_ASSERT(blockIdx != kInvalidNodeBlock, "QuadTreeNodePool.ReleaseBlock.InvalidBlock");
+
+  // each node notifies its destruction and releases its own children
+  QuadTreeNode* nodes = GetBlockNodes(blockIdx);
+  for ( size_t i = 0; i < kNumChildrenPerNode; ++i ) {
+    nodes[i].~QuadTreeNode();
+  }
+
+  SetBlockParent(blockIdx, nullptr);
+  _freeBlocks.push_back( blockIdx );
+  --_numUsedBlocks;
+}
+
+} // namespace Vector
+} // namespace Anki
@@ -0,0 +1,148 @@
+/**
+ * File: quadTreeNodePool.h
+ *
+ * Description: Arena that owns the memory for all non-root nodes of a QuadTree. Nodes are always created in blocks of
+ * four siblings that live contiguously in memory, and blocks are addressed by index so that nodes don't need to hold
+ * pointers to their children. Blocks are carved out of fixed size chunks that are never moved or freed while the pool
+ * is alive, which means node addresses are stable (the processor caches them) and released blocks are recycled
+ * instead of going back to the heap.
+ * The pool also holds the callbacks used to notify external systems of node changes, once for the whole tree.
+ *
+ * Copyright: Anki, Inc. 2026
+ **/
+
+#ifndef ANKI_COZMO_QUAD_TREE_NODE_POOL_H
+#define ANKI_COZMO_QUAD_TREE_NODE_POOL_H
+
+#include "quadTreeNode.h"
+
+#include "util/helpers/noncopyable.h"
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+class QuadTreeNodePool : private Util::noncopyable
+{
+public:
+
+  using DestructorCallback = std::function<void (const QuadTreeNode*)>;
+  using ModifiedCallback   = std::function<void (const QuadTreeNode*, const NodeContent&)>;
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // Initialization
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  QuadTreeNodePool(DestructorCallback destructorCallback, ModifiedCallback modifiedCallback);
+  ~QuadTreeNodePool();
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // Blocks
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  // constructs the four children of 'parent' in a free block (growing the pool if needed) and returns its index
+  NodeBlockIndex AllocateBlock(const QuadTreeNode* parent);
+
+  // destroys the four nodes in the given block (and recursively their children) and recycles the block
+  void ReleaseBlock(NodeBlockIndex blockIdx);
+
+  // returns the first of the kNumChildrenPerNode contiguous nodes in the block
+  inline QuadTreeNode*       GetBlockNodes(NodeBlockIndex blockIdx);
+  inline const QuadTreeNode* GetBlockNodes(NodeBlockIndex blockIdx) const;
+
+  // node that owns the given block
+  inline const QuadTreeNode* GetBlockParent(NodeBlockIndex blockIdx) const;
+  inline void                SetBlockParent(NodeBlockIndex blockIdx, const QuadTreeNode* parent);
+
+  // number of blocks currently holding nodes, and total blocks reserved by the pool
+  size_t GetNumUsedBlocks()     const { return _numUsedBlocks; }
+  size_t GetNumReservedBlocks() const { return _chunks.size() * kBlocksPerChunk; }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // Notifications
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  void NotifyNodeDestroyed(const QuadTreeNode* node) const { _destructorCallback(node); }
+  void NotifyNodeModified(const QuadTreeNode* node, const NodeContent& oldContent) const { _modifiedCallback(node, oldContent); }
+
+private:
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // Types
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  // raw storage for four sibling nodes, constructed in place on allocation
+  struct NodeBlock {
+    using Storage = std::aligned_storage<sizeof(QuadTreeNode) * kNumChildrenPerNode, alignof(QuadTreeNode)>::type;
+    Storage             nodes;
+    const QuadTreeNode* parent;
+  };
+
+  // blocks are allocated in chunks so that growing the pool never moves existing nodes (power of 2 for cheap lookup)
+  static constexpr NodeBlockIndex kBlocksPerChunkLog2 = 6;
+  static constexpr NodeBlockIndex kBlocksPerChunk     = (1 << kBlocksPerChunkLog2);
+
+  inline NodeBlock&       GetBlock(NodeBlockIndex blockIdx);
+  inline const NodeBlock& GetBlock(NodeBlockIndex blockIdx) const;
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // Attributes
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  std::vector< std::unique_ptr<NodeBlock[]> > _chunks;
+
+  // blocks that have been released and can be reused. Most recently released are reused first, since they are
+  // more likely to be in cache
+  std::vector<NodeBlockIndex> _freeBlocks;
+
+  size_t _numUsedBlocks;
+
+  // callbacks to notify external system if an element has changed or been destroyed
+  DestructorCallback _destructorCallback;
+  ModifiedCallback   _modifiedCallback;
+
+}; // class
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Inline implementation
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+QuadTreeNodePool::NodeBlock& QuadTreeNodePool::GetBlock(NodeBlockIndex blockIdx)
+{
+  return _chunks[blockIdx >> kBlocksPerChunkLog2][blockIdx & (kBlocksPerChunk - 1)];
+}
+
+const QuadTreeNodePool::NodeBlock& QuadTreeNodePool::GetBlock(NodeBlockIndex blockIdx) const
+{
+  return _chunks[blockIdx >> kBlocksPerChunkLog2][blockIdx & (kBlocksPerChunk - 1)];
+}
+
+QuadTreeNode* QuadTreeNodePool::GetBlockNodes(NodeBlockIndex blockIdx)
+{
+  return reinterpret_cast<QuadTreeNode*>( &GetBlock(blockIdx).nodes );
+}
+
+const QuadTreeNode* QuadTreeNodePool::GetBlockNodes(NodeBlockIndex blockIdx) const
+{
+  return reinterpret_cast<const QuadTreeNode*>( &GetBlock(blockIdx).nodes );
+}
+
+const QuadTreeNode* QuadTreeNodePool::GetBlockParent(NodeBlockIndex blockIdx) const
+{
+  return GetBlock(blockIdx).parent;
+}
+
+void QuadTreeNodePool::SetBlockParent(NodeBlockIndex blockIdx, const QuadTreeNode* parent)
+{
+  GetBlock(blockIdx).parent = parent;
+}
+
+} // namespace
+} // namespace
+
+#endif //
@@ -29,6 +29,7 @@ CONSOLE_VAR(bool , kRenderBordersToQuad, "QuadTreeProcessor", false); // renders
 CONSOLE_VAR(bool , kRenderBorder3DLines, "QuadTreeProcessor", false); // renders borders returned as 3D lines (instead of quads)
 CONSOLE_VAR(float, kRenderZOffset      , "QuadTreeProcessor", 20.0f); // adds Z offset to all quads
 CONSOLE_VAR(bool , kDebugFindBorders   , "QuadTreeProcessor", false); // prints debug information in console
+CONSOLE_VAR(bool , kUseRasterForRays   , "QuadTreeProcessor", true);  // keeps a raster of the tree for ray queries
 
 #define DEBUG_FIND_BORDER(format, ...)                                                                          \
 if ( kDebugFindBorders ) {                                                                                      \
@@ -112,6 +113,13 @@ void QuadTreeProcessor::OnNodeContentChanged(const QuadTreeNode* node, const Nod
                "QuadTreeProcessor.OnNodeContentTypeChanged.InvalidInsert");
     _nodeSets[newType].insert(node);
   }
+
+  // only leaves are painted, since a node's content is pushed down to its children when it's subdivided and it's
+  // already in them when they are merged back. If the root has changed, UpdateRaster will rebuild it instead
+  if ( _raster && !node->IsSubdivided() && _raster->IsValidFor(*_quadTree) )
+  {
+    _raster->PaintNode(*node, newType);
+  }
 }
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void QuadTreeProcessor::OnNodeDestroyed(const QuadTreeNode* node)
@@ -194,6 +202,36 @@ QuadTreeProcessor::AnyOfRays( const Point2f& start,
   return results;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::vector<bool>
+QuadTreeProcessor::AnyOfRays( const Point2f& start,
+                              const std::vector<Point2f>& ends,
+                              EContentTypePackedType types) const
+{
+  if ( _raster && _raster->IsValidFor(*_quadTree) ) {
+    return _raster->AnyOfRays(start, ends, types);
+  }
+
+  return AnyOfRays(start, ends, [types] (const auto& data) { return IsInEContentTypePackedType(data->type, types); });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void QuadTreeProcessor::UpdateRaster()
+{
+  if ( !kUseRasterForRays || (_quadTree == nullptr) ) {
+    _raster.reset();
+    return;
+  }
+
+  if ( !_raster ) {
+    _raster.reset( new QuadTreeRaster() );
+  }
+
+  if ( !_raster->IsValidFor(*_quadTree) ) {
+    _raster->Rebuild(*_quadTree);
+  }
+}
+
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 QuadTreeProcessor::NodeSet QuadTreeProcessor::GetNodesToFill(const NodePredicate& innerPred, const NodePredicate& outerPred)
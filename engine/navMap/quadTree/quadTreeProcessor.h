@@ -16,6 +16,7 @@
 #define ANKI_COZMO_QUAD_TREE_PROCESSOR_H
 
 #include "engine/navMap/quadTree/quadTreeTypes.h"
+#include "engine/navMap/quadTree/quadTreeRaster.h"
 #include "engine/navMap/memoryMap/memoryMapTypes.h"
 #include "engine/navMap/memoryMap/data/memoryMapData.h"
 
@@ -25,6 +26,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <map>
+#include <memory>
 
 namespace Anki {
 namespace Vector {
@@ -77,6 +79,14 @@ public:
 
   // multi-ray based collision checking optimization with memoization of result point info
   std::vector<bool> AnyOfRays(const Point2f& start, const std::vector<Point2f>& ends, const NodePredicate& pred) const;
+
+  // multi-ray collision checking against a set of content types. Uses the raster if it's up to date, otherwise falls
+  // back to searching the tree
+  std::vector<bool> AnyOfRays(const Point2f& start, const std::vector<Point2f>& ends, EContentTypePackedType types) const;
+
+  // creates or rebuilds the raster if it's enabled and the root has changed since it was built, or releases it if it
+  // has been disabled. Should be called after every modification of the tree
+  void UpdateRaster();
  
 private:
 
@@ -113,6 +123,9 @@ private:
   
   // area of all quads that are currently interesting edges
   double _totalInterestingEdgeArea_m2;
+
+  // optional raster of the tree for ray queries, painted as leaves change content
+  std::unique_ptr<QuadTreeRaster> _raster;
 }; // class
   
 } // namespace
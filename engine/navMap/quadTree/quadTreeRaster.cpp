@@ -0,0 +1,187 @@
+/**
+ * File: quadTreeRaster.cpp
+ *
+ * Description: Raster view of a QuadTree at content precision. See header for details.
+ *
+ * Copyright: Anki, Inc. 2026
+ **/
+#include "quadTreeRaster.h"
+#include "quadTree.h"
+
+#include "engine/navMap/memoryMap/data/memoryMapData.h"
+
+#include "util/logging/logging.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace Anki {
+namespace Vector {
+
+namespace {
+
+// sets or clears bits [first, first+count) of a row of words
+template<typename Word, int BitsPerWord>
+void SetBits(Word* row, int32_t first, int32_t count, bool value)
+{
+  while ( count > 0 )
+  {
+    const int32_t wordIdx = first / BitsPerWord;
+    const int32_t bitIdx  = first % BitsPerWord;
+    const int32_t numBits = std::min(count, BitsPerWord - bitIdx);
+    const Word    mask    = (numBits == BitsPerWord) ? ~Word(0) : (((Word(1) << numBits) - 1) << bitIdx);
+    if ( value ) {
+      row[wordIdx] |= mask;
+    } else {
+      row[wordIdx] &= ~mask;
+    }
+    first += numBits;
+    count -= numBits;
+  }
+}
+
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+QuadTreeRaster::QuadTreeRaster()
+: _center(0.f, 0.f)
+, _height(0)
+, _precision(0.f)
+, _numCells(0)
+, _wordsPerRow(0)
+, _wordsPerPlane(0)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void QuadTreeRaster::Rebuild(const QuadTree& tree)
+{
+  _center    = tree.GetCenter();
+  _height    = tree.GetMaxHeight();
+  _precision = tree.GetContentPrecisionMM();
+
+  _numCells      = (1 << _height);
+  _wordsPerRow   = (_numCells + kBitsPerWord - 1) / kBitsPerWord;
+  _wordsPerPlane = (size_t) _wordsPerRow * _numCells;
+  _bits.assign(_wordsPerPlane * kNumPlanes, 0);
+
+  tree.Fold( [this] (const QuadTreeNode& node) {
+    if ( !node.IsSubdivided() ) {
+      PaintNode(node, static_cast<const MemoryMapDataPtr&>(node.GetData())->type);
+    }
+  });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool QuadTreeRaster::IsValidFor(const QuadTree& tree) const
+{
+  const bool isValid = (_numCells > 0) &&
+                       (tree.GetMaxHeight() == _height) &&
+                       (tree.GetCenter().x() == _center.x()) &&
+                       (tree.GetCenter().y() == _center.y());
+  return isValid;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void QuadTreeRaster::PaintNode(const QuadTreeNode& node, EContentType type)
+{
+  DEV_ASSERT(!node.IsSubdivided(), "QuadTreeRaster.PaintNode.NotALeaf");
+
+  // the center of the node's MinusXMinusY-most cell gives us its first row and column
+  const float halfCell = _precision * 0.5f;
+  const Point2f& minVertex = node.GetBoundingBox().GetMinVertex();
+  const Point2i first = GetCell( Point2f(minVertex.x() + halfCell, minVertex.y() + halfCell) );
+  const int32_t size  = (1 << node.GetMaxHeight());
+
+  // nodes always lie inside the root, but clamp anyway so that a bad node can't write out of bounds
+  const int32_t x0 = std::max(first.x(), 0);
+  const int32_t y0 = std::max(first.y(), 0);
+  const int32_t x1 = std::min(first.x() + size, _numCells);
+  const int32_t y1 = std::min(first.y() + size, _numCells);
+  if ( (x0 >= x1) || (y0 >= y1) ) {
+    PRINT_NAMED_WARNING("QuadTreeRaster.PaintNode.OutOfBounds", "Node at (%d, %d) is outside of the raster", first.x(), first.y());
+    return;
+  }
+
+  const size_t typePlane = (size_t) type;
+  for ( size_t plane = 0; plane < kNumPlanes; ++plane )
+  {
+    Word* planeBits = GetPlane(plane);
+    for ( int32_t y = y0; y < y1; ++y ) {
+      SetBits<Word, kBitsPerWord>(planeBits + (size_t) y * _wordsPerRow, x0, x1 - x0, plane == typePlane);
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::vector<bool> QuadTreeRaster::AnyOfRays(const Point2f& start,
+                                            const std::vector<Point2f>& ends,
+                                            EContentTypePackedType types) const
+{
+  std::vector<bool> results(ends.size(), false);
+
+  // merge the planes of all the requested types first, so that each step along a ray is a single bit test
+  std::vector<Word> matches(_wordsPerPlane, 0);
+  bool anyMatch = false;
+  for ( size_t plane = 0; plane < kNumPlanes; ++plane )
+  {
+    if ( MemoryMapTypes::IsInEContentTypePackedType((EContentType) plane, types) ) {
+      const Word* planeBits = GetPlane(plane);
+      for ( size_t i = 0; i < _wordsPerPlane; ++i ) {
+        matches[i] |= planeBits[i];
+      }
+      anyMatch = true;
+    }
+  }
+  anyMatch = anyMatch && std::any_of(matches.begin(), matches.end(), [] (Word w) { return w != 0; });
+  if ( !anyMatch ) {
+    return results;
+  }
+
+  const Point2i startCell = GetCell(start);
+  for ( size_t rayIdx = 0; rayIdx < ends.size(); ++rayIdx )
+  {
+    // same stepping as BresenhamLinePixelIterator, inlined so that the walk doesn't need to build any points
+    const Point2i endCell = GetCell(ends[rayIdx]);
+    const int32_t dx   = std::abs(endCell.x() - startCell.x());
+    const int32_t dy   = std::abs(endCell.y() - startCell.y());
+    const int32_t xInc = (startCell.x() > endCell.x()) ? -1 : 1;
+    const int32_t yInc = (startCell.y() > endCell.y()) ? -1 : 1;
+
+    int32_t x = startCell.x();
+    int32_t y = startCell.y();
+    int32_t error = 0;
+    for ( int32_t counter = dx + dy; counter >= 0; --counter )
+    {
+      // the unsigned compare also rejects negative coordinates
+      if ( ((uint32_t) x < (uint32_t) _numCells) && ((uint32_t) y < (uint32_t) _numCells) ) {
+        const Word word = matches[(size_t) y * _wordsPerRow + (x / kBitsPerWord)];
+        if ( (word >> (x % kBitsPerWord)) & 1 ) {
+          results[rayIdx] = true;
+          break; // skip the rest of the ray
+        }
+      }
+
+      const int32_t errorX = error + dy;
+      const int32_t errorY = error - dx;
+      if ( std::abs(errorX) < std::abs(errorY) ) {
+        x += xInc;
+        error = errorX;
+      } else {
+        y += yInc;
+        error = errorY;
+      }
+    }
+  }
+
+  return results;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Point2i QuadTreeRaster::GetCell(const Point2f& point) const
+{
+  return QuadTreeTypes::GetIntegralCoordinateOfNode(point, _center, _precision, _height);
+}
+
+} // namespace Vector
+} // namespace Anki
@@ -0,0 +1,106 @@
+/**
+ * File: quadTreeRaster.h
+ *
+ * Description: Raster view of a QuadTree at content precision, with one bitmap per content type. It's kept up to date
+ * by the QuadTreeProcessor as leaf nodes change content, and rebuilt from scratch when the root expands or shifts.
+ * Ray queries walk the bitmaps directly, instead of searching the tree for every cell along every ray.
+ *
+ * Copyright: Anki, Inc. 2026
+ **/
+
+#ifndef ANKI_COZMO_QUAD_TREE_RASTER_H
+#define ANKI_COZMO_QUAD_TREE_RASTER_H
+
+#include "engine/navMap/quadTree/quadTreeTypes.h"
+#include "engine/navMap/memoryMap/memoryMapTypes.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+
+class QuadTree;
+class QuadTreeNode;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+class QuadTreeRaster
+{
+public:
+
+  using EContentType           = MemoryMapTypes::EContentType;
+  using EContentTypePackedType = MemoryMapTypes::EContentTypePackedType;
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // Initialization
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  // constructor. The raster is not valid for any tree until it's rebuilt
+  QuadTreeRaster();
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // Modification
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  // resizes the raster to the current root of the tree and paints all of its leaves
+  void Rebuild(const QuadTree& tree);
+
+  // returns true if the raster was built for the current center and size of the tree's root. If the root has expanded
+  // or shifted since, the raster needs to be rebuilt before it can be painted or queried again
+  bool IsValidFor(const QuadTree& tree) const;
+
+  // sets all the cells covered by the given leaf node to the given content type
+  void PaintNode(const QuadTreeNode& node, EContentType type);
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // Query
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  // for each ray [start, ends[i]], returns true if any cell along it has one of the given content types. Cells are
+  // visited in the same order as BresenhamLinePixelIterator, and cells outside of the root are never a match
+  std::vector<bool> AnyOfRays(const Point2f& start, const std::vector<Point2f>& ends, EContentTypePackedType types) const;
+
+private:
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // Types
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  using Word = uint64_t;
+  static constexpr int32_t kBitsPerWord = 64;
+  static constexpr size_t  kNumPlanes   = (size_t) EContentType::_Count;
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // Helpers
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  // integral coordinates of the cell that contains the given point, with (0,0) being the MinusXMinusY-most cell
+  Point2i GetCell(const Point2f& point) const;
+
+  // first word of the given plane
+  Word*       GetPlane(size_t plane)       { return &_bits[plane * _wordsPerPlane]; }
+  const Word* GetPlane(size_t plane) const { return &_bits[plane * _wordsPerPlane]; }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // Attributes
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  // root this raster was built for
+  Point2f _center;
+  uint8_t _height;
+  float   _precision;
+
+  // number of cells in each row/column, and words used to store them
+  int32_t _numCells;
+  int32_t _wordsPerRow;
+  size_t  _wordsPerPlane;
+
+  // one bit per cell for each content type, row-major, plane after plane
+  std::vector<Word> _bits;
+
+}; // class
+
+} // namespace
+} // namespace
+
+#endif //
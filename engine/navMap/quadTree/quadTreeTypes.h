@@ -16,6 +16,7 @@
 #include "coretech/common/engine/math/pointSetUnion.h"
 
 #include <cstdint>
+#include <limits>
 #include <type_traits>
 
 namespace Anki {
@@ -137,6 +138,11 @@ using NodeAddress           = std::vector<EQuadrant>;
 using FoldFunctor           = std::function<void (QuadTreeNode& node)>;
 using FoldFunctorConst      = std::function<void (const QuadTreeNode& node)>;
 
+// index of a block of four sibling nodes inside a QuadTreeNodePool
+using NodeBlockIndex        = uint32_t;
+constexpr NodeBlockIndex kInvalidNodeBlock = std::numeric_limits<NodeBlockIndex>::max();
+constexpr size_t         kNumChildrenPerNode = 4;
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // Helper functions
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
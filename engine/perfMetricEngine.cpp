@@ -15,6 +15,7 @@
 #include "engine/aiComponent/behaviorComponent/activeFeatureComponent.h"
 #include "engine/aiComponent/behaviorComponent/behaviorComponent.h"
 #include "engine/aiComponent/behaviorComponent/behaviorSystemManager.h"
+#include "engine/componentTickBudgets.h"
 #include "engine/cozmoContext.h"
 #include "engine/components/battery/batteryComponent.h"
 #include "engine/externalInterface/gatewayInterface.h"
@@ -254,5 +255,29 @@ int PerfMetricEngine::AppendSummaryData(const DumpType dumpType,
 }
 
 
+void PerfMetricEngine::DumpTickBreakdown(std::string* resultStr)
+{
+#if ANKI_PERF_METRIC_ENABLED
+  const Robot* robot = _context->GetRobotManager()->GetRobot();
+  if (robot == nullptr)
+  {
+    LOG_INFO("PerfMetricEngine.DumpTickBreakdown", "No robot to dump component update times for");
+    return;
+  }
+
+  std::string breakdown;
+  robot->GetComponentTickBudgets().AppendRecentUpdateTimes(*robot, breakdown);
+  if (resultStr != nullptr)
+  {
+    *resultStr += breakdown;
+  }
+  else
+  {
+    LOG_INFO("PerfMetricEngine.DumpTickBreakdown", "Component update times:\n%s", breakdown.c_str());
+  }
+#endif
+}
+
+
 } // namespace Vector
 } // namespace Anki
@@ -50,6 +50,9 @@ private:
                                 const int dumpBufferOffset,
                                 const int lineIndex) override final;
 
+  // Recent update time percentiles of every robot, AI and behavior component
+  virtual void DumpTickBreakdown(std::string* resultStr) override final;
+
   // Frame size:  Base struct is 16 bytes; here is 10 words * 4 (40 bytes), plus 32 bytes = 88 bytes
   // x 4000 frames is ~344 KB
   struct FrameMetricEngine : public FrameMetric
@@ -20,6 +20,7 @@
 #include "engine/blockWorld/blockWorld.h"
 #include "engine/blockWorld/blockWorldFilter.h"
 #include "engine/charger.h"
+#include "engine/componentTickBudgets.h"
 #include "engine/components/accountSettingsManager.h"
 #include "engine/components/animationComponent.h"
 #include "engine/components/battery/batteryComponent.h"
@@ -103,6 +104,20 @@ CONSOLE_VAR(bool, kUseVisionOnlyWhileOnTreads,    "Robot", false);
 // Enable to enable example code of face image drawing
 CONSOLE_VAR(bool, kEnableTestFaceImageRGBDrawing,  "Robot", false);
 
+// Update consecutive components that flag themselves as update thread safe, and don't access each other, at the
+// same time instead of one at a time
+CONSOLE_VAR(bool, kParallelComponentUpdates,       "Robot.ComponentUpdates", false);
+
+// Warn whenever a component accesses another one during its update without declaring it
+CONSOLE_VAR(bool, kCheckUndeclaredComponentAccess, "Robot.ComponentUpdates", false);
+
+// Time every component's update and check it against its budget in component_tick_budgets.json. Overruns go to
+// DAS in every build, the webviz views are dev only
+CONSOLE_VAR(bool, kTimeComponentUpdates,           "Robot.ComponentUpdates", true);
+
+// Threads that parallel component updates use besides the engine thread
+static const size_t kNumComponentUpdateThreads = 2;
+
 #if REMOTE_CONSOLE_ENABLED
 
 // Robot singleton
@@ -360,6 +375,13 @@ Robot::Robot(const RobotID_t robotID, CozmoContext* context)
     _components->InitComponents(this);
   }
 
+  {
+    _componentTickBudgets = std::make_unique<ComponentTickBudgets>();
+    const auto* dataLoader = _context->GetDataLoader();
+    _componentTickBudgets->Init((dataLoader != nullptr) ? dataLoader->GetComponentTickBudgetsConfig() : Json::Value(),
+                                _context->GetWebService());
+  }
+
   GetComponent<FullRobotPose>().GetPose().SetName("Robot_" + std::to_string(_ID));
   _driveCenterPose.SetName("RobotDriveCenter_" + std::to_string(_ID));
 
@@ -1309,8 +1331,20 @@ Result Robot::Update()
   return RESULT_OK;
 #endif
 
+  if (kParallelComponentUpdates && (_componentUpdatePool == nullptr)) {
+    _componentUpdatePool = std::make_unique<Util::WorkStealingPool>(kNumComponentUpdateThreads, "CompUpdate");
+  }
+  _componentUpdateSettings.pool = kParallelComponentUpdates ? _componentUpdatePool.get() : nullptr;
+  _componentUpdateSettings.checkUndeclaredAccess = kCheckUndeclaredComponentAccess;
+  _componentUpdateSettings.timeUpdates = kTimeComponentUpdates;
+  _components->SetUpdateSettings(_componentUpdateSettings);
+
   _components->UpdateComponents();
 
+  if (kTimeComponentUpdates) {
+    _componentTickBudgets->Update(*this);
+  }
+
   // If anything in updating block world caused a localization update, notify
   // the physical robot now:
   if (_needToSendLocalizationUpdate) {
@@ -1626,8 +1660,8 @@ Result Robot::LocalizeToObject(const ObservableObject* seenObject,
               existingObject->GetID().GetValue());
   }
 
-  HistStateKey histStateKey;
-  HistRobotState* histStatePtr = nullptr;
+  HistStateKey histStateKey = 0;
+  HistRobotState histState;
   Pose3d robotPoseWrtObject;
   float  headAngle;
   float  liftAngle;
@@ -1643,7 +1677,7 @@ Result Robot::LocalizeToObject(const ObservableObject* seenObject,
     headAngle = GetComponent<FullRobotPose>().GetHeadAngle();
   } else {
     // Get computed HistRobotState at the time the object was observed.
-    if ((lastResult = GetStateHistory()->GetComputedStateAt(seenObject->GetLastObservedTime(), &histStatePtr, &histStateKey)) != RESULT_OK) {
+    if ((lastResult = GetStateHistory()->GetComputedStateAt(seenObject->GetLastObservedTime(), histState, &histStateKey)) != RESULT_OK) {
       LOG_ERROR("Robot.LocalizeToObject.CouldNotFindHistoricalPose", "Time %d", seenObject->GetLastObservedTime());
       return lastResult;
     }
@@ -1651,7 +1685,7 @@ Result Robot::LocalizeToObject(const ObservableObject* seenObject,
     // The computed historical pose is always stored w.r.t. the robot's world
     // origin and parent chains are lost. Re-connect here so that GetWithRespectTo
     // will work correctly
-    Pose3d robotPoseAtObsTime = histStatePtr->GetPose();
+    Pose3d robotPoseAtObsTime = histState.GetPose();
     robotPoseAtObsTime.SetParent(GetWorldOrigin());
 
     // Get the pose of the robot with respect to the observed object
@@ -1661,8 +1695,8 @@ Result Robot::LocalizeToObject(const ObservableObject* seenObject,
       return RESULT_FAIL;
     }
 
-    liftAngle = histStatePtr->GetLiftAngle_rad();
-    headAngle = histStatePtr->GetHeadAngle_rad();
+    liftAngle = histState.GetLiftAngle_rad();
+    headAngle = histState.GetHeadAngle_rad();
   }
 
   // Make the computed robot pose use the existing object as its parent
@@ -1735,11 +1769,11 @@ Result Robot::LocalizeToObject(const ObservableObject* seenObject,
   }
 
 
-  if (nullptr != histStatePtr)
+  if (0 != histStateKey)
   {
     // Update the computed historical pose as well so that subsequent block
     // pose updates use obsMarkers whose camera's parent pose is correct.
-    histStatePtr->SetPose(GetPoseFrameID(), robotPoseWrtOrigin, headAngle, liftAngle);
+    GetStateHistory()->UpdateComputedStatePose(histStateKey, GetPoseFrameID(), robotPoseWrtOrigin, headAngle, liftAngle);
   }
 
 
@@ -1756,7 +1790,7 @@ Result Robot::LocalizeToObject(const ObservableObject* seenObject,
     return RESULT_FAIL;
   }
 
-  if (histStatePtr->WasPickedUp() || (_offTreadsState != OffTreadsState::OnTreads)) {
+  if (histState.WasPickedUp() || (_offTreadsState != OffTreadsState::OnTreads)) {
     LOG_INFO("Robot.LocalizeToObject.OffTreads", "Not localizing to object since we are not on treads");
     return RESULT_OK;
   }
@@ -2118,14 +2152,13 @@ Result Robot::AddVisionOnlyStateToHistory(const RobotTimeStamp_t t,
 
 Result Robot::GetComputedStateAt(const RobotTimeStamp_t t_request, Pose3d& pose) const
 {
-  HistStateKey histStateKey;
-  const HistRobotState* histStatePtr = nullptr;
-  Result lastResult = GetStateHistory()->GetComputedStateAt(t_request, &histStatePtr, &histStateKey);
+  HistRobotState histState;
+  Result lastResult = GetStateHistory()->GetComputedStateAt(t_request, histState);
   if (lastResult == RESULT_OK) {
     // Grab the pose stored in the pose stamp we just found, and hook up
     // its parent to the robot's current world origin (since pose history
     // doesn't keep track of pose parent chains)
-    pose = histStatePtr->GetPose();
+    pose = histState.GetPose();
     pose.SetParent(GetWorldOrigin());
   }
   return lastResult;
@@ -86,6 +86,7 @@ class HistRobotState;
 class IExternalInterface;
 struct RobotState;
 class CubeLightComponent;
+class ComponentTickBudgets;
 class BackpackLightComponent;
 class RobotToEngineImplMessaging;
 class PublicStateBroadcaster;
@@ -197,6 +198,17 @@ public:
   template<typename T>
   T* GetComponentPtr() {return _components->GetComponentPtr<T>();}
 
+  // How components are scheduled each tick - entities nested in components should use the same settings
+  const DependencyManagedUpdateSettings& GetComponentUpdateSettings() const { return _componentUpdateSettings; }
+
+  // How long each robot component's recent updates took, while component updates are being timed
+  const std::vector<DependencyManagedEntity<RobotComponentID>::ComponentUpdateTime>& GetComponentUpdateTimes() const {
+    return _components->GetUpdateTimes();
+  }
+
+  // Checks component update times against their budgets
+  const ComponentTickBudgets& GetComponentTickBudgets() const { return *_componentTickBudgets; }
+
   //
   // Most components declare both const and non-const accessors.
   // If your component does not fit this pattern, add custom code below.
@@ -577,6 +589,11 @@ protected:
 
   ComponentPtr _components;
 
+  // Set from the console. The pool is only created once parallel component updates are first enabled
+  DependencyManagedUpdateSettings         _componentUpdateSettings;
+  std::unique_ptr<Util::WorkStealingPool> _componentUpdatePool;
+  std::unique_ptr<ComponentTickBudgets>   _componentTickBudgets;
+
   // The robot's identifier
   RobotID_t _ID;
   u32       _serialNumberHead = 0;
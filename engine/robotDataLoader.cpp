@@ -16,6 +16,7 @@
 #include "cannedAnimLib/cannedAnims/cannedAnimationLoader.h"
 #include "cannedAnimLib/spriteSequences/spriteSequenceLoader.h"
 #include "coretech/common/engine/utils/data/dataPlatform.h"
+#include "coretech/common/engine/utils/data/jsonSnapshot.h"
 #include "coretech/common/engine/utils/timer.h"
 #include "coretech/vision/shared/compositeImage/compositeImage.h"
 #include "coretech/vision/shared/spriteCache/spriteCache.h"
@@ -53,6 +54,9 @@ namespace {
 
 CONSOLE_VAR(bool, kStressTestThreadedPrintsDuringLoad, "RobotDataLoader", false);
 
+// Read boot configs from a binary snapshot of the json (regenerated whenever files were missing or out of date)
+CONSOLE_VAR(bool, kUseJsonSnapshot, "RobotDataLoader", true);
+
 #if REMOTE_CONSOLE_ENABLED
 static Anki::Vector::ThreadedPrintStressTester stressTester;
 #endif // REMOTE_CONSOLE_ENABLED
@@ -61,6 +65,9 @@ const char* kPathToExternalIndependentSprites = "assets/sprites/independentSprit
 const char* kPathToEngineIndependentSprites = "config/devOnlySprites/independentSprites/";
 const char* kPathToExternalSpriteSequences = "assets/sprites/spriteSequences/";
 const char* kPathToEngineSpriteSequences   = "config/devOnlySprites/spriteSequences/";
+const char* kPathToSpriteAtlas = "assets/sprites/spriteAtlas.bin";
+
+const char* kJsonSnapshotFile = "configSnapshot.bin"; // in the cache
 
 const std::vector<std::string> kPathsToEngineAccessibleAnimations = {
   // Dance to the beat:
@@ -119,6 +126,10 @@ RobotDataLoader::~RobotDataLoader()
     _abortLoad = true;
     _dataLoadingThread.join();
   }
+
+  if (_jsonSnapshot || _jsonSnapshotWriter) {
+    Util::Data::DataPlatform::SetJsonSnapshot(nullptr, nullptr);
+  }
 }
 
 void RobotDataLoader::LoadNonConfigData()
@@ -179,6 +190,7 @@ void RobotDataLoader::LoadNonConfigData()
     ANKI_CPU_PROFILE("RobotDataLoader::LoadSpritePaths");
     LoadSpritePaths();
     _spriteCache = std::make_unique<Vision::SpriteCache>(_spritePaths.get());
+    _spriteCache->LoadAtlas(_platform->GetResourcePath(kPathToSpriteAtlas), _platform->GetResourcePath(""));
   }
 
   {
@@ -252,6 +264,8 @@ void RobotDataLoader::LoadNonConfigData()
   // this map doesn't need to be persistent
   _jsonFiles.clear();
 
+  SaveJsonSnapshot();
+
   if( kStressTestThreadedPrintsDuringLoad ) {
     REMOTE_CONSOLE_ENABLED_ONLY( stressTester.Stop() );
   }
@@ -260,6 +274,43 @@ void RobotDataLoader::LoadNonConfigData()
   _loadingCompleteRatio.store(1.0f);
 }
 
+void RobotDataLoader::OpenJsonSnapshot()
+{
+  if (!kUseJsonSnapshot) {
+    return;
+  }
+
+  const std::string resourcesPath = _platform->GetResourcePath("");
+  _jsonSnapshot = std::make_shared<Util::Data::JsonSnapshot>();
+  _jsonSnapshot->Open(_platform->GetCachePath(kJsonSnapshotFile), resourcesPath);
+  _jsonSnapshotWriter = std::make_shared<Util::Data::JsonSnapshotWriter>(resourcesPath);
+  Util::Data::DataPlatform::SetJsonSnapshot(_jsonSnapshot, _jsonSnapshotWriter);
+}
+
+void RobotDataLoader::SaveJsonSnapshot()
+{
+  if (!_jsonSnapshotWriter) {
+    return;
+  }
+
+  Util::Data::DataPlatform::SetJsonSnapshot(nullptr, nullptr);
+
+  // Anything the writer collected was parsed because the snapshot was missing it or it was out of date, so only
+  // rewrite the snapshot when that happened
+  const size_t numParsed = _jsonSnapshotWriter->GetNumEntries();
+  LOG_INFO("RobotDataLoader.SaveJsonSnapshot",
+           "%zu json files parsed (snapshot had %zu entries)",
+           numParsed, _jsonSnapshot->GetNumEntries());
+  if (numParsed > 0) {
+    const std::string snapshotPath = _platform->GetCachePath(kJsonSnapshotFile);
+    Util::FileUtils::CreateDirectory(snapshotPath, true, true);
+    _jsonSnapshotWriter->Save(snapshotPath, _jsonSnapshot.get());
+  }
+
+  _jsonSnapshot.reset();
+  _jsonSnapshotWriter.reset();
+}
+
 void RobotDataLoader::AddToLoadingRatio(float delta)
 {
   // Allows for a thread to repeatedly try to update the loading ratio until it gets access
@@ -947,6 +998,9 @@ void RobotDataLoader::LoadRobotConfigs()
   }
 
   ANKI_CPU_TICK_ONE_TIME("RobotDataLoader::LoadRobotConfigs");
+
+  OpenJsonSnapshot();
+
   // mood config
   {
     static const std::string jsonFilename = "config/engine/mood_config.json";
@@ -1117,6 +1171,18 @@ void RobotDataLoader::LoadRobotConfigs()
                 jsonFilename.c_str());
     }
   }
+
+  // Component tick budgets config
+  {
+    static const std::string jsonFilename = "config/engine/component_tick_budgets.json";
+    const bool success = _platform->readAsJson(Util::Data::Scope::Resources, jsonFilename, _componentTickBudgetsConfig);
+    if (!success)
+    {
+      LOG_ERROR("RobotDataLoader.ComponentTickBudgetsConfigNotFound",
+                "Component Tick Budgets Config file %s not found or failed to parse",
+                jsonFilename.c_str());
+    }
+  }
 }
 
 bool RobotDataLoader::DoNonConfigDataLoading(float& loadingCompleteRatio_out)
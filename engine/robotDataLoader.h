@@ -44,6 +44,8 @@ namespace Util {
 
 namespace Data {
 class DataPlatform;
+class JsonSnapshot;
+class JsonSnapshotWriter;
 }
 }
 
@@ -126,6 +128,7 @@ public:
   const Json::Value& GetJdocsConfig() const                  { return _jdocsConfig; }
   const Json::Value& GetAccountSettingsConfig() const        { return _accountSettingsConfig; }
   const Json::Value& GetUserEntitlementsConfig() const       { return _userEntitlementsConfig; }
+  const Json::Value& GetComponentTickBudgetsConfig() const   { return _componentTickBudgetsConfig; }
 
   // Cube Spinner game configuration
   const Json::Value& GetCubeSpinnerConfig() const             { return _cubeSpinnerConfig; }
@@ -206,6 +209,10 @@ private:
 
   void LoadAnimationWhitelist();
 
+  // While boot loading runs, json resources are read from (and parsed ones added to) a binary snapshot in the cache
+  void OpenJsonSnapshot();
+  void SaveJsonSnapshot();
+
   // Outputs a map of file name (no path or extensions) to the full file path
   // Useful for clad mappings/lookups
   std::map<std::string, std::string> CreateFileNameToFullPathMap(const std::vector<const char*> & srcDirs, const std::string& fileExtensions) const;
@@ -223,6 +230,9 @@ private:
   };
   std::unordered_map<int, std::vector<std::string>> _jsonFiles;
 
+  std::shared_ptr<Util::Data::JsonSnapshot>       _jsonSnapshot;
+  std::shared_ptr<Util::Data::JsonSnapshotWriter> _jsonSnapshotWriter;
+
   // animation data
   std::unique_ptr<CannedAnimationContainer>    _cannedAnimations;
   std::unique_ptr<AnimationGroupContainer>     _animationGroups;
@@ -252,6 +262,7 @@ private:
   Json::Value _jdocsConfig;
   Json::Value _accountSettingsConfig;
   Json::Value _userEntitlementsConfig;
+  Json::Value _componentTickBudgetsConfig;
 
   Json::Value _cubeSpinnerConfig;
 
@@ -176,17 +176,19 @@ Result MessageHandler::SendMessage(const RobotInterface::EngineToRobot& msg, boo
 void MessageHandler::Broadcast(const RobotInterface::RobotToEngine& message)
 {
   ANKI_CPU_PROFILE("Broadcast_R2E");
+  ANKI_CPU_TRACE_SPAN("message", RobotToEngineTagToString(message.GetTag()));
 
   u32 type = static_cast<u32>(message.GetTag());
-  _eventMgr.Broadcast(AnkiEvent<RobotInterface::RobotToEngine>(BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(), type, message));
+  _eventMgr.Broadcast(BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(), type, message);
 }
 
 void MessageHandler::Broadcast(RobotInterface::RobotToEngine&& message)
 {
   ANKI_CPU_PROFILE("Broadcast_R2E");
+  ANKI_CPU_TRACE_SPAN("message", RobotToEngineTagToString(message.GetTag()));
 
   u32 type = static_cast<u32>(message.GetTag());
-  _eventMgr.Broadcast(AnkiEvent<RobotInterface::RobotToEngine>(BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(), type, std::move(message)));
+  _eventMgr.Broadcast(BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(), type, message);
 }
 
 bool MessageHandler::IsConnected(RobotID_t robotID)
@@ -168,13 +168,198 @@ namespace Anki {
       return interpHistState;
     }
     
+    /////////////////////// HistStateBuffer /////////////////////////////
+    
+    HistStateBuffer::HistStateBuffer(size_t capacity)
+    {
+      Reserve(capacity);
+    }
+    
+    void HistStateBuffer::Reserve(size_t capacity)
+    {
+      const size_t oldCapacity = _slots.size();
+      if (capacity <= oldCapacity) {
+        return;
+      }
+      
+      // Entries stay in their slots, only the ring of slot numbers is rebuilt (starting at 0)
+      std::vector<u32> newOrder(capacity);
+      for (size_t i=0; i<_count; ++i) {
+        newOrder[i] = GetSlot(i);
+      }
+      _order = std::move(newOrder);
+      _head = 0;
+      
+      _slots.reserve(capacity);
+      _freeSlots.reserve(capacity);
+      for (size_t slot=oldCapacity; slot<capacity; ++slot) {
+        _slots.emplace_back(new Entry());
+        _freeSlots.push_back(static_cast<u32>(slot));
+      }
+    }
+    
+    void HistStateBuffer::clear()
+    {
+      while (!empty()) {
+        PopFront();
+      }
+      _head = 0;
+    }
+    
+    void HistStateBuffer::PopFront()
+    {
+      ReleaseSlot(GetSlot(0));
+      _head = (_head + 1) % _order.size();
+      --_count;
+    }
+    
+    void HistStateBuffer::ReleaseSlot(u32 slot)
+    {
+      std::unique_ptr<Entry>& entry = _slots[slot];
+      entry->key = 0;
+      
+      if (entry->state.GetPose().IsNodeShared()) {
+        // Something (e.g. a historical camera pose) still has this pose as its parent. Keep the pose around
+        // for it instead of reusing it underneath it for some other state, and replace the slot's entry with
+        // a retired one that nothing refers to anymore (dropping any others).
+        std::unique_ptr<Entry> replacement;
+        for (auto it = _retiredEntries.begin(); it != _retiredEntries.end(); ) {
+          if ((*it)->state.GetPose().IsNodeShared()) {
+            ++it;
+            continue;
+          }
+          if (!replacement) {
+            replacement = std::move(*it);
+          }
+          it = _retiredEntries.erase(it);
+        }
+        
+        _retiredEntries.push_back(std::move(entry));
+        entry = (replacement ? std::move(replacement) : std::unique_ptr<Entry>(new Entry()));
+      }
+      
+      // The slot is reused rather than destroyed, so don't let it keep the parent (i.e. origin) alive
+      entry->state.ClearPoseParent();
+      
+      _freeSlots.push_back(slot);
+    }
+    
+    size_t HistStateBuffer::LowerBound(const RobotTimeStamp_t t) const
+    {
+      size_t first = 0;
+      size_t count = _count;
+      while (count > 0) {
+        const size_t step = count / 2;
+        const size_t index = first + step;
+        if ((*this)[index].t < t) {
+          first = index + 1;
+          count -= step + 1;
+        } else {
+          count = step;
+        }
+      }
+      return first;
+    }
+    
+    size_t HistStateBuffer::Find(const RobotTimeStamp_t t) const
+    {
+      const size_t index = LowerBound(t);
+      if (index < _count && (*this)[index].t == t) {
+        return index;
+      }
+      return _count;
+    }
+    
+    size_t HistStateBuffer::Insert(const RobotTimeStamp_t t, const HistRobotState& state)
+    {
+      // Usual case: newer than everything else
+      size_t index = _count;
+      if (!empty() && t <= back().t) {
+        index = LowerBound(t);
+        if ((*this)[index].t == t) {
+          return _count;
+        }
+      }
+      
+      if (_count == capacity()) {
+        if (index == 0) {
+          // Older than everything we are able to keep
+          return _count;
+        }
+        LOG_DEBUG("HistStateBuffer.Insert.Full", "Dropping state at t=%u to make room for t=%u",
+                  (TimeStamp_t)front().t, (TimeStamp_t)t);
+        PopFront();
+        --index;
+      }
+      
+      const u32 slot = _freeSlots.back();
+      _freeSlots.pop_back();
+      
+      // Make room in the ring for the new slot number by shifting whichever side of index is shorter.
+      // Only slot numbers move, the entries themselves stay where they are.
+      const size_t ringSize = _order.size();
+      if (index < _count / 2) {
+        _head = (_head + ringSize - 1) % ringSize;
+        for (size_t i=0; i<index; ++i) {
+          _order[(_head + i) % ringSize] = _order[(_head + i + 1) % ringSize];
+        }
+      } else {
+        for (size_t i=_count; i>index; --i) {
+          _order[(_head + i) % ringSize] = _order[(_head + i - 1) % ringSize];
+        }
+      }
+      _order[(_head + index) % ringSize] = slot;
+      ++_count;
+      
+      Entry& entry = *_slots[slot];
+      entry.t = t;
+      entry.state = state;
+      entry.key = 0;
+      
+      return index;
+    }
+    
+    void HistStateBuffer::EraseBefore(const RobotTimeStamp_t t)
+    {
+      while (!empty() && front().t < t) {
+        PopFront();
+      }
+    }
+    
     /////////////////////// RobotStateHistory /////////////////////////////
     
-    HistStateKey RobotStateHistory::currHistStateKey_ = 0;
+    namespace {
+      // Shortest expected time between states. The robot sends state messages every
+      // STATE_MESSAGE_FREQUENCY ticks, leave room for twice that rate.
+      const u32 kMinStatePeriod_ms = (ROBOT_TIME_STEP_MS * STATE_MESSAGE_FREQUENCY) / 2;
+      
+      const u32 kDefaultWindowSize_ms = 3000;
+      
+      size_t GetCapacityForTimeWindow(const u32 windowSize_ms)
+      {
+        return (windowSize_ms / kMinStatePeriod_ms) + 1;
+      }
+      
+      // Computed state keys are the slot the state is stored in (low bits) and a serial number
+      // that tells apart the states stored in that slot over time (high bits)
+      const u32          kKeySlotBits       = 12;
+      const HistStateKey kKeySlotMask       = (1u << kKeySlotBits) - 1;
+      const HistStateKey kMaxKeySerial      = (1u << (32 - kKeySlotBits)) - 1;
+      const size_t       kMaxComputedStates = (1u << kKeySlotBits);
+      
+      size_t GetComputedCapacityForTimeWindow(const u32 windowSize_ms)
+      {
+        return std::min(GetCapacityForTimeWindow(windowSize_ms), kMaxComputedStates);
+      }
+    }
     
     RobotStateHistory::RobotStateHistory()
     : IDependencyManagedComponent(this, RobotComponentID::StateHistory)
-    , _windowSize_ms(3000)
+    , _windowSize_ms(kDefaultWindowSize_ms)
+    , _states(GetCapacityForTimeWindow(kDefaultWindowSize_ms))
+    , _visStates(GetCapacityForTimeWindow(kDefaultWindowSize_ms))
+    , _computedStates(GetComputedCapacityForTimeWindow(kDefaultWindowSize_ms))
+    , _computedStateSerial(0)
     {
 
     }
@@ -186,24 +371,29 @@ namespace Anki {
       _states.clear();
       _visStates.clear();
       _computedStates.clear();
-      
-      _tsByKeyMap.clear();
-      _keyByTsMap.clear();
     }
     
-    void RobotStateHistory::SetTimeWindow(const u32 _windowSize_msms)
+    void RobotStateHistory::SetTimeWindow(const u32 windowSize_ms)
     {
-      _windowSize_ms = _windowSize_msms;
+      _windowSize_ms = windowSize_ms;
+      ReserveForTimeWindow();
       CullToWindowSize();
     }
     
+    void RobotStateHistory::ReserveForTimeWindow()
+    {
+      const size_t capacity = GetCapacityForTimeWindow(_windowSize_ms);
+      _states.Reserve(capacity);
+      _visStates.Reserve(capacity);
+      _computedStates.Reserve(GetComputedCapacityForTimeWindow(_windowSize_ms));
+    }
     
     Result RobotStateHistory::AddRawOdomState(const RobotTimeStamp_t t,
                                               const HistRobotState& state)
     {
       if (!_states.empty())
       {
-        RobotTimeStamp_t newestTime = _states.rbegin()->first;
+        RobotTimeStamp_t newestTime = _states.back().t;
         if (newestTime > _windowSize_ms && t < newestTime - _windowSize_ms) {
           LOG_WARNING("RobotStateHistory.AddRawOdomState.TimeTooOld", "newestTime %u, oldestAllowedTime %u, t %u",
                       (TimeStamp_t)newestTime, (TimeStamp_t)(newestTime - _windowSize_ms), (TimeStamp_t)t);
@@ -218,10 +408,8 @@ namespace Anki {
         return RESULT_FAIL;
       }
       
-      std::pair<StateMapIter_t, bool> res;
-      res = _states.emplace(t, state);
-
-      if (!res.second) {
+      const size_t index = _states.Insert(t, state);
+      if (index == _states.size()) {
         LOG_WARNING("RobotStateHistory.AddRawOdomState.AddFailed", "Time: %u", (TimeStamp_t)t);
         return RESULT_FAIL;
       }
@@ -243,7 +431,7 @@ namespace Anki {
 
       // Check if the pose's timestamp is too old.
       if (!_states.empty()) {
-        RobotTimeStamp_t newestTime = _states.rbegin()->first;
+        RobotTimeStamp_t newestTime = _states.back().t;
         if (newestTime > _windowSize_ms && t < newestTime - _windowSize_ms) {
           LOG_ERROR("RobotStateHistory.AddVisionOnlyState.TooOld",
                     "Pose at t=%d too old to add. Newest time=%d, windowSize=%d",
@@ -253,11 +441,11 @@ namespace Anki {
       }
       
       // If visPose entry exist at t, then overwrite it
-      StateMapIter_t it = _visStates.find(t);
-      if (it != _visStates.end()) {
-        const u32 oldFrameId = it->second.GetFrameId();
+      const size_t index = _visStates.Find(t);
+      if (index != _visStates.size()) {
+        const u32 oldFrameId = _visStates[index].state.GetFrameId();
         
-        it->second = state;
+        _visStates[index].state = state;
         
         if (ANKI_DEV_CHEATS)
         {
@@ -269,25 +457,21 @@ namespace Anki {
           ss << "Old id:" << oldFrameId;
           ss << " t:" << t;
           ss << " New id:" << curId;
-          ss << " t:" << it->first;
+          ss << " t:" << _visStates[index].t;
           
-          if (it != _visStates.begin())
+          if (index > 0)
           {
-            --it;
-            prevId = it->second.GetFrameId();
+            prevId = _visStates[index-1].state.GetFrameId();
             ss << " Previous entry id:" << prevId;
-            ss << " t:" << it->first;
-            ++it;
+            ss << " t:" << _visStates[index-1].t;
           }
           
-          ++it;
-          if (it != _visStates.end())
+          if (index+1 < _visStates.size())
           {
-            nextId = it->second.GetFrameId();
+            nextId = _visStates[index+1].state.GetFrameId();
             ss << " Next entry id:" << nextId;
-            ss << " t:" << it->first;
+            ss << " t:" << _visStates[index+1].t;
           }
-          --it;
           
           LOG_INFO("RobotStateHistory.AddVisionOnlyState.Overwriting", "%s", ss.str().c_str());
           
@@ -296,12 +480,9 @@ namespace Anki {
         }
       } else {
       
-        std::pair<StateMapIter_t, bool> res;
-        res = _visStates.emplace(t, state);
-      
-        if (!res.second) {
-          LOG_ERROR("RobotStateHistory.AddVisionOnlyState.EmplaceFailed",
-                    "Emplace of pose with t=%d, frameID=%d failed",
+        if (_visStates.Insert(t, state) == _visStates.size()) {
+          LOG_ERROR("RobotStateHistory.AddVisionOnlyState.InsertFailed",
+                    "Insert of pose with t=%d, frameID=%d failed",
                     (TimeStamp_t)t, state.GetFrameId());
           return RESULT_FAIL;
         }
@@ -319,30 +500,24 @@ namespace Anki {
                                                         RobotTimeStamp_t&    t_after,
                                                         HistRobotState& state_after)
     {
-      // Get the iterator for time t
-      const_StateMapIter_t it = _states.lower_bound(t);
+      // Get the index for time t
+      const size_t index = _states.LowerBound(t);
       
-      if (it == _states.begin() || it == _states.end() || t < _states.begin()->first) {
+      if (index == 0 || index == _states.size()) {
         return RESULT_FAIL;
       }
 
-      // Get iterator to pose just before t
-      const_StateMapIter_t prev_it = it;
-      --prev_it;
-      
-      t_before = prev_it->first;
-      state_before = prev_it->second;
-      
-      // Get iterator to pose just after t
-      const_StateMapIter_t next_it = it;
-      ++next_it;
+      // State just before t
+      t_before = _states[index-1].t;
+      state_before = _states[index-1].state;
       
-      if (next_it == _states.end()) {
+      // State just after t
+      if (index+1 == _states.size()) {
         return RESULT_FAIL;
       }
       
-      t_after = next_it->first;
-      state_after = next_it->second;
+      t_after = _states[index+1].t;
+      state_after = _states[index+1].state;
       
       return RESULT_OK;
     }
@@ -356,32 +531,32 @@ namespace Anki {
                                             bool withInterpolation) const
     {
       // This pose occurs at or immediately after t_request
-      const_StateMapIter_t it = _states.lower_bound(t_request);
+      const size_t index = _states.LowerBound(t_request);
       
       // Check if in range
-      if (it == _states.end() || t_request < _states.begin()->first) {
+      if (index == _states.size() || t_request < _states.front().t) {
         return RESULT_FAIL;
       }
       
-      if (t_request == it->first) {
+      const HistStateBuffer::Entry& next = _states[index];
+      if (t_request == next.t) {
         // If the exact timestamp was found, return the corresponding pose.
-        t = it->first;
-        state = it->second;
+        t = next.t;
+        state = next.state;
       } else {
 
-        // Get iterator to the pose just before t_request
-        const_StateMapIter_t prev_it = it;
-        --prev_it;
+        // The pose just before t_request
+        const HistStateBuffer::Entry& prev = _states[index-1];
 
         // Check for same frameId
         // (Shouldn't interpolate between poses from different frameIDs)
-        if (it->second.GetFrameId() != prev_it->second.GetFrameId())
+        if (next.state.GetFrameId() != prev.state.GetFrameId())
         {
           LOG_INFO("RobotStateHistory.GetRawStateAt.MisMatchedFrameIds",
                    "Cannot interpolate at t=%u as requested because the two frame IDs don't match: prev=%d vs next=%d",
                     (TimeStamp_t)t_request,
-                    prev_it->second.GetFrameId(),
-                   it->second.GetFrameId());
+                    prev.state.GetFrameId(),
+                   next.state.GetFrameId());
           
           // they asked us for a t_request that is between two frame IDs, which for all intents and purposes is just
           // as bad as trying to choose between two poses with mismatched origins (like above).
@@ -395,31 +570,31 @@ namespace Anki {
           // We don't need to check return value (bool) here because we've effectively
           // checked it already in the call to HasSameRootAs above
           Pose3d pTransform;
-          inSameOrigin = it->second.GetPose().GetWithRespectTo(prev_it->second.GetPose(), pTransform);
+          inSameOrigin = next.state.GetPose().GetWithRespectTo(prev.state.GetPose(), pTransform);
 
           if (inSameOrigin)
           {
             // Compute scale factor between time to previous pose and time between previous pose and next pose.
-            const f32 timeScale = (f32)(t_request - prev_it->first) / TimeStamp_t(it->first - prev_it->first);
+            const f32 timeScale = (f32)(t_request - prev.t) / TimeStamp_t(next.t - prev.t);
 
-            state = HistRobotState::Interpolate(prev_it->second, it->second, pTransform, timeScale);
+            state = HistRobotState::Interpolate(prev.state, next.state, pTransform, timeScale);
 
             t = t_request;
           }
         }
         else
         {
-          inSameOrigin = it->second.GetPose().HasSameRootAs(prev_it->second.GetPose());
+          inSameOrigin = next.state.GetPose().HasSameRootAs(prev.state.GetPose());
           
           if (inSameOrigin)
           {
             // Return the pose closest to the requested time
-            if (it->first - t_request < t_request - prev_it->first) {
-              t = it->first;
-              state = it->second;
+            if (next.t - t_request < t_request - prev.t) {
+              t = next.t;
+              state = next.state;
             } else {
-              t = prev_it->first;
-              state = prev_it->second;
+              t = prev.t;
+              state = prev.state;
             }
           }
         }
@@ -429,8 +604,8 @@ namespace Anki {
           LOG_INFO("RobotStateHistory.GetRawStateAt.MisMatchedOrigins",
                    "Cannot interpolate at t=%u as requested because the two poses don't share the same origin: prev=%s vs next=%s",
                    (TimeStamp_t)t_request,
-                   prev_it->second.GetPose().FindRoot().GetName().c_str(),
-                   it->second.GetPose().FindRoot().GetName().c_str());
+                   prev.state.GetPose().FindRoot().GetName().c_str(),
+                   next.state.GetPose().FindRoot().GetName().c_str());
 
           // they asked us for a t_request that is between two origins. We can't interpolate or decide which origin is
           // "right" for you, so, we are going to fail
@@ -443,22 +618,22 @@ namespace Anki {
 
     Result RobotStateHistory::UpdateProxSensorData(const RobotTimeStamp_t t, const ProxSensorData& data)
     {
-      StateMapIter_t it = _states.find(t); 
-      if (it == _states.end()) {
+      const size_t index = _states.Find(t);
+      if (index == _states.size()) {
         return RESULT_FAIL;
       }
       
-      HistRobotState& state = it->second;
+      HistRobotState& state = _states[index].state;
       state.SetProxSensorData(data);
 
       return RESULT_OK;
     }
 
-    Result RobotStateHistory::GetVisionOnlyStateAt(const RobotTimeStamp_t t_request, HistRobotState** state)
+    Result RobotStateHistory::GetVisionOnlyStateAt(const RobotTimeStamp_t t_request, HistRobotState& state) const
     {
-      StateMapIter_t it = _visStates.find(t_request);
-      if (it != _visStates.end()) {
-        *state = &(it->second);
+      const size_t index = _visStates.Find(t_request);
+      if (index != _visStates.size()) {
+        state = _visStates[index].state;
         return RESULT_OK;
       }
       return RESULT_FAIL;
@@ -470,10 +645,10 @@ namespace Anki {
                                              bool withInterpolation) const
     {
       // If the vision-based version of the pose exists, return it.
-      const_StateMapIter_t it = _visStates.find(t_request);
-      if (it != _visStates.end()) {
+      const size_t visIndex = _visStates.Find(t_request);
+      if (visIndex != _visStates.size()) {
         t = t_request;
-        state = it->second;
+        state = _visStates[visIndex].state;
         return RESULT_OK;
       }
       
@@ -485,34 +660,36 @@ namespace Anki {
       }
       
       // Now get the previous vision-based pose
-      const_StateMapIter_t git = _visStates.lower_bound(t);
+      size_t gIndex = _visStates.LowerBound(t);
       
       // If there are no vision-based poses then return the raw pose that we just got
-      if (git == _visStates.end()) {
+      if (gIndex == _visStates.size()) {
         if (_visStates.empty()) {
           state = state1;
           return RESULT_OK;
         } else {
-          --git;
+          --gIndex;
         }
-      } else if (git->first != t) {
+      } else if (_visStates[gIndex].t != t) {
         // If this is the first vision-based pose then return the raw pose that we got
-        if (git == _visStates.begin()) {
+        if (gIndex == 0) {
           state = state1;
           return RESULT_OK;
         } else {
           // As long as the vision-based pose is not from time t,
-          // decrement the pointer to get the previous vision-based
-          --git;
+          // decrement the index to get the previous vision-based
+          --gIndex;
         }
       }
       
+      const HistStateBuffer::Entry& git = _visStates[gIndex];
+      
       // Check frame ID
       // If the vision pose frame id <= requested frame id
       // then just return the raw pose of the requested frame id since it
       // is already based on the vision-based pose.
-      if (git->second.GetFrameId() <= state1.GetFrameId()) {
-        //printf("FRAME %d <= %d\n", git->second.GetFrameId(), p1.GetFrameId());
+      if (git.state.GetFrameId() <= state1.GetFrameId()) {
+        //printf("FRAME %d <= %d\n", git.state.GetFrameId(), p1.GetFrameId());
         state = state1;
         return RESULT_OK;
       }
@@ -520,22 +697,23 @@ namespace Anki {
       #if (DEBUG_ROBOT_POSE_HISTORY)
       static bool printDbg = false;
       if(printDbg) {
-        printf("gt: %d\n", git->first);
-        git->second.GetPose().Print();
+        printf("gt: %d\n", (TimeStamp_t)git.t);
+        git.state.GetPose().Print();
       }
       #endif
       
-      // git now points to the latest vision-based pose that exists before time t.
+      // git now is the latest vision-based pose that exists before time t.
       // Now get the pose in _states that immediately follows the vision-based pose's time.
-      const_StateMapIter_t p0_it = _states.lower_bound(git->first);
+      const size_t p0Index = _states.LowerBound(git.t);
+      const HistStateBuffer::Entry& p0 = _states[p0Index];
 
       #if (DEBUG_ROBOT_POSE_HISTORY)
       if (printDbg) {
-        printf("p0_it: t: %d  frame: %d\n", p0_it->first, p0_it->second.GetFrameId());
-        p0_it->second.GetPose().Print();
+        printf("p0: t: %d  frame: %d\n", (TimeStamp_t)p0.t, p0.state.GetFrameId());
+        p0.state.GetPose().Print();
       
-        printf("p1: t: %d  frame: %d\n", t, p1.GetFrameId());
-        p1.GetPose().Print();
+        printf("p1: t: %d  frame: %d\n", (TimeStamp_t)t, state1.GetFrameId());
+        state1.GetPose().Print();
       }
       #endif
      
@@ -543,57 +721,55 @@ namespace Anki {
       // corresponding to p0, forward to p1. We will be applying this transformation
       // to whatever is stored in the vision-only pose below.
       Pose3d pTransform;
-      if (p0_it->second.GetFrameId() == state1.GetFrameId())
+      if (p0.state.GetFrameId() == state1.GetFrameId())
       {
         // Special case: no intermediate frames to chain through. The total transformation
         // is just going from p0 to p1.
-        Pose3d p1_wrt_p0_parent;
-        const bool inSameOrigin = state1.GetPose().GetWithRespectTo(p0_it->second.GetPose().GetParent(), pTransform);
+        const bool inSameOrigin = state1.GetPose().GetWithRespectTo(p0.state.GetPose().GetParent(), pTransform);
         DEV_ASSERT(inSameOrigin, "RobotStateHistory.ComputeStateAt.FailedGetWRT1");
-        pTransform *= p0_it->second.GetPose().GetInverse();
+        pTransform *= p0.state.GetPose().GetInverse();
       }
       else
       {
-        const_StateMapIter_t pMid0 = p0_it;
-        const_StateMapIter_t pMid1 = p0_it;
-        for (pMid1 = p0_it; pMid1 != _states.end(); ++pMid1)
+        size_t pMid0 = p0Index;
+        for (size_t pMid1 = p0Index; pMid1 < _states.size(); ++pMid1)
         {
           // Bump pMid1 forward until it hits the next frame ID
-          if (pMid1->second.GetFrameId() > pMid0->second.GetFrameId())
+          if (_states[pMid1].state.GetFrameId() > _states[pMid0].state.GetFrameId())
           {
-            // pMid1 is now pointing to the first pose in the next frame after pMid0.
-            // Point pMid1 to the last pose of the same frame as pMid0. Compute
-            // the transform for this frame (from pMid0 to pMid1) and
+            // pMid1 is now the first pose in the next frame after pMid0.
+            // The pose before it is the last pose of the same frame as pMid0. Compute
+            // the transform for this frame (from pMid0 to that pose) and
             // fold it into the running total stored in pTransform.
+            const HistRobotState& mid0 = _states[pMid0].state;
+            const HistRobotState& mid1 = _states[pMid1-1].state;
             
             // We expect the beginning (pMid0) and end (pMid1) of this part of history
             // to have the same frame ID and origin.
-            --pMid1; // (temporarily) move back to last pose in same frame as pMid0
-            DEV_ASSERT(pMid0->second.GetFrameId() == pMid1->second.GetFrameId(),
+            DEV_ASSERT(mid0.GetFrameId() == mid1.GetFrameId(),
                        "RobotStateHistory.ComputeStateAt.MismatchedIntermediateFrameIDs");
-            DEV_ASSERT(pMid0->second.GetPose().HasSameRootAs(pMid1->second.GetPose()),
+            DEV_ASSERT(mid0.GetPose().HasSameRootAs(mid1.GetPose()),
                        "RobotStateHistory.ComputeStateAt.MismatchedIntermediateOrigins");
 
             // Get pMid0 and pMid1 w.r.t. the same parent and store in the intermediate
             // transformation pMidTransform, which is going to hold the transformation
             // from pMid0 to pMid1
             Pose3d pMidTransform;
-            const bool inSameOrigin = pMid1->second.GetPose().GetWithRespectTo(pMid0->second.GetPose().GetParent(), pMidTransform);
+            const bool inSameOrigin = mid1.GetPose().GetWithRespectTo(mid0.GetPose().GetParent(), pMidTransform);
             DEV_ASSERT(inSameOrigin, "RobotStateHistory.ComputeStateAt.FailedGetWRT2");
             
             // pMidTransform = pMid1 * pMid0^(-1)
-            pMidTransform *= pMid0->second.GetPose().GetInverse();
+            pMidTransform *= mid0.GetPose().GetInverse();
             
             // Fold the transformation from pMid0 to pMid1 into the total transformation thus far
             //  pTranform = pMidTransform * pTransform
             pTransform.PreComposeWith(pMidTransform);
             
-            // Move both pointers to start of next pose frame to begin process again
-            ++pMid1;
+            // Start of next pose frame to begin process again
             pMid0 = pMid1;
           }
        
-          if (pMid1->second.GetFrameId() == state1.GetFrameId())
+          if (_states[pMid1].state.GetFrameId() == state1.GetFrameId())
           {
             // Reached p1, so we're done
             break;
@@ -603,88 +779,66 @@ namespace Anki {
 
       #if (DEBUG_ROBOT_POSE_HISTORY)
       if (printDbg) {
-        printf("pTrans: %d\n", t);
+        printf("pTrans: %d\n", (TimeStamp_t)t);
         pTransform.Print();
       }
       #endif
       
       // NOTE: We are about to return p, which is a transformed version of the vision-only
       // pose in "git", so it should still be relative to whatever "git" was relative to.
-      pTransform *= git->second.GetPose(); // Apply pTransform to git and store in pTransform
-      pTransform.SetParent(git->second.GetPose().GetParent()); // Keep git's parent
+      pTransform *= git.state.GetPose(); // Apply pTransform to git and store in pTransform
+      pTransform.SetParent(git.state.GetPose().GetParent()); // Keep git's parent
       state.SetPose(state1.GetFrameId(), pTransform, state1.GetHeadAngle_rad(), state1.GetLiftAngle_rad());
       
       return RESULT_OK;
     }
     
     Result RobotStateHistory::ComputeAndInsertStateAt(const RobotTimeStamp_t t_request,
-                                                      RobotTimeStamp_t& t, HistRobotState** state,
+                                                      RobotTimeStamp_t& t, HistRobotState& state,
                                                       HistStateKey* key,
                                                       bool withInterpolation)
     {
-      HistRobotState state_computed;
-      //printf("COMPUTE+INSERT\n");
-      const Result computeResult = ComputeStateAt(t_request, t, state_computed, withInterpolation);
+      const Result computeResult = ComputeStateAt(t_request, t, state, withInterpolation);
       if (RESULT_OK != computeResult) {
-        *state = nullptr;
         return computeResult;
       }
       
       // If computedPose entry exist at t, then overwrite it
-      StateMapIter_t it = _computedStates.find(t);
-      if (it != _computedStates.end()) {
-        it->second = state_computed;
-        *state = &(it->second);
-        
-        if (key) {
-          *key = _keyByTsMap[t];
-        }
+      size_t index = _computedStates.Find(t);
+      if (index != _computedStates.size()) {
+        _computedStates[index].state = state;
       } else {
         
-        std::pair<StateMapIter_t, bool> res;
-        res = _computedStates.emplace(t, state_computed);
-        
-        if (!res.second) {
+        index = _computedStates.Insert(t, state);
+        if (index == _computedStates.size()) {
           return RESULT_FAIL;
         }
         
-        *state = &(res.first->second);
-        
-        
-        // Create key associated with computed pose
-        ++currHistStateKey_;
-        _tsByKeyMap.emplace(std::piecewise_construct,
-                            std::forward_as_tuple(currHistStateKey_),
-                            std::forward_as_tuple(t));
-        _keyByTsMap.emplace(std::piecewise_construct,
-                                  std::forward_as_tuple(t),
-                                  std::forward_as_tuple(currHistStateKey_));
-        
-        if (key) {
-          *key = currHistStateKey_;
+        // Create key associated with computed pose. Keys are never 0.
+        if (++_computedStateSerial > kMaxKeySerial) {
+          _computedStateSerial = 1;
         }
-
+        _computedStates[index].key = (_computedStateSerial << kKeySlotBits) | _computedStates.GetSlot(index);
+      }
+      
+      if (key) {
+        *key = _computedStates[index].key;
       }
       
       return RESULT_OK;
     }
 
     Result RobotStateHistory::GetComputedStateAt(const RobotTimeStamp_t t_request,
-                                                 const HistRobotState ** state,
+                                                 HistRobotState& state,
                                                  HistStateKey* key) const
     {
-      const_StateMapIter_t it = _computedStates.find(t_request);
-      if (it != _computedStates.end()) {
-        *state = &(it->second);
+      const size_t index = _computedStates.Find(t_request);
+      if (index != _computedStates.size()) {
+        state = _computedStates[index].state;
         
         // Get key for the computed pose
         if (key){
-          const_KeyByTimestampMapIter_t kIt = _keyByTsMap.find(it->first);
-          if (kIt == _keyByTsMap.end()) {
-            LOG_WARNING("RobotStateHistory.GetComputedStateAt.KeyNotFound","");
-            return RESULT_FAIL;
-          }
-          *key = kIt->second;
+          *key = _computedStates[index].key;
         }
         
         return RESULT_OK;
@@ -695,21 +849,31 @@ namespace Anki {
       
       return RESULT_FAIL;
     }
-
-
-    // TODO:(bn) is there a way to avoid this duplicated code here? Not eager to use templates...
-    Result RobotStateHistory::GetComputedStateAt(const RobotTimeStamp_t t_request,
-                                                 HistRobotState ** state,
-                                                 HistStateKey* key)
+    
+    const HistRobotState* RobotStateHistory::GetComputedState(const HistStateKey key) const
     {
-      return GetComputedStateAt(t_request, const_cast<const HistRobotState **>(state), key);
+      if (!IsValidKey(key)) {
+        return nullptr;
+      }
+      return &_computedStates.GetSlotEntry(key & kKeySlotMask).state;
+    }
+    
+    Result RobotStateHistory::UpdateComputedStatePose(const HistStateKey key, const PoseFrameID_t frameID,
+                                                      const Pose3d& pose, const f32 headAngle_rad,
+                                                      const f32 liftAngle_rad)
+    {
+      if (!IsValidKey(key)) {
+        return RESULT_FAIL;
+      }
+      _computedStates.GetSlotEntry(key & kKeySlotMask).state.SetPose(frameID, pose, headAngle_rad, liftAngle_rad);
+      return RESULT_OK;
     }
     
     Result RobotStateHistory::GetLatestVisionOnlyState(RobotTimeStamp_t& t, HistRobotState& state) const
     {
       if (!_visStates.empty()) {
-        t = _visStates.rbegin()->first;
-        state = _visStates.rbegin()->second;
+        t = _visStates.back().t;
+        state = _visStates.back().state;
         return RESULT_OK;
       }
       
@@ -728,55 +892,33 @@ namespace Anki {
       
       // First look through "raw" poses for the frame ID. We don't need to look
       // any further once the frameID drops below the one we are looking for,
-      // because they are ordered
-      bool found = false;
-      auto poseIter = _states.rend();
-      for (poseIter = _states.rbegin();
-          poseIter != _states.rend() && poseIter->second.GetFrameId() >= frameID; ++poseIter )
+      // because they are ordered. If we don't find it there, look through vision poses.
+      for (const HistStateBuffer* buffer : {&_states, &_visStates})
       {
-        if (poseIter->second.GetFrameId() == frameID) {
-          found = true; // break out of the loop without incrementing poseIter
-          break;
-        }
-      }
-      
-      // NOTE: this second loop over vision poses will only occur if found is still false,
-      // meaning we didn't find a pose already in the first loop.
-      if (!found) {
-        for (poseIter = _visStates.rbegin();
-            poseIter != _visStates.rend() && poseIter->second.GetFrameId() >= frameID; ++poseIter)
+        for (size_t i = buffer->size(); i > 0 && (*buffer)[i-1].state.GetFrameId() >= frameID; --i)
         {
-          if (poseIter->second.GetFrameId() == frameID) {
-            found = true;
-            break;
+          if ((*buffer)[i-1].state.GetFrameId() == frameID) {
+            // Success!
+            state = (*buffer)[i-1].state;
+            return RESULT_OK;
           }
         }
       }
       
-      if (found) {
-        // Success!
-        DEV_ASSERT(poseIter != _states.rend(),
-                   "RobotStateHistory.GetLastStateWithFrameID.InvalidIter");
-        state = poseIter->second;
-        return RESULT_OK;
-        
-      } else {
-        LOG_INFO("RobotStateHistory.GetLastStateWithFrameID.FrameIdNotFound",
-                 "Could not find frame ID=%d in pose history. "
-                 "(First frameID in pose history is %d (t:%u), last is %d (t:%u). "
-                 "First frameID in vis pose history is %d (t:%u), last is %d (t:%u).)",
-                 frameID,
-                 _states.begin()->second.GetFrameId(),
-                 (TimeStamp_t)_states.begin()->first,
-                 _states.rbegin()->second.GetFrameId(),
-                 (TimeStamp_t)_states.rbegin()->first,
-                 (_visStates.empty() ? -1 : _visStates.begin()->second.GetFrameId()),
-                 (TimeStamp_t)(_visStates.empty() ? 0 : _visStates.begin()->first),
-                 (_visStates.empty() ? -1 : _visStates.rbegin()->second.GetFrameId()),
-                 (TimeStamp_t)(_visStates.empty() ? 0 : _visStates.rbegin()->first));
-        return RESULT_FAIL;
-
-      }
+      LOG_INFO("RobotStateHistory.GetLastStateWithFrameID.FrameIdNotFound",
+               "Could not find frame ID=%d in pose history. "
+               "(First frameID in pose history is %d (t:%u), last is %d (t:%u). "
+               "First frameID in vis pose history is %d (t:%u), last is %d (t:%u).)",
+               frameID,
+               _states.front().state.GetFrameId(),
+               (TimeStamp_t)_states.front().t,
+               _states.back().state.GetFrameId(),
+               (TimeStamp_t)_states.back().t,
+               (_visStates.empty() ? -1 : _visStates.front().state.GetFrameId()),
+               (TimeStamp_t)(_visStates.empty() ? 0 : _visStates.front().t),
+               (_visStates.empty() ? -1 : _visStates.back().state.GetFrameId()),
+               (TimeStamp_t)(_visStates.empty() ? 0 : _visStates.back().t));
+      return RESULT_FAIL;
       
     } // GetLastStateWithFrameID()
 
@@ -787,9 +929,9 @@ namespace Anki {
       // any further once the frameID drops below the one we are looking for,
       // because they are ordered
       u32 cnt = 0;
-      for (auto poseIter = _states.rbegin(); poseIter != _states.rend(); ++poseIter )
+      for (size_t i = _states.size(); i > 0; --i)
       {
-        auto currFrameId = poseIter->second.GetFrameId();
+        auto currFrameId = _states[i-1].state.GetFrameId();
         if (currFrameId == frameID) {
           ++cnt;
         } else if (currFrameId < frameID) {
@@ -804,34 +946,26 @@ namespace Anki {
       if (_states.size() > 1) {
         
         // Get the most recent timestamp
-        RobotTimeStamp_t mostRecentTime = _states.rbegin()->first;
+        RobotTimeStamp_t mostRecentTime = _states.back().t;
         
         // If most recent time is less than window size, we're done.
         if (mostRecentTime < _windowSize_ms) {
           return;
         }
         
-        // Get pointer to the oldest timestamp that may remain in the map
+        // Delete everything before the oldest allowed timestamp
         RobotTimeStamp_t oldestAllowedTime = mostRecentTime - _windowSize_ms;
-        const auto it = _states.lower_bound(oldestAllowedTime);
-        const auto git = _visStates.lower_bound(oldestAllowedTime);
-        const auto cit = _computedStates.lower_bound(oldestAllowedTime);
-        const auto keyByTs_it = _keyByTsMap.lower_bound(oldestAllowedTime);
         
-        // Delete everything before the oldest allowed timestamp
-        if (!_states.empty() && it != _states.begin()) {
-          _states.erase(_states.begin(), it);
-          
-          if (_states.empty())
-          {
-            LOG_DEBUG("RobotStateHistory.CullToWindowSize.StatesEmpty",
-                      "_states is empty after culling to window size %u",
-                      _windowSize_ms);
-          }
+        _states.EraseBefore(oldestAllowedTime);
+        if (_states.empty())
+        {
+          LOG_DEBUG("RobotStateHistory.CullToWindowSize.StatesEmpty",
+                    "_states is empty after culling to window size %u",
+                    _windowSize_ms);
         }
-        if (!_visStates.empty() &&  git != _visStates.begin()) {
-          _visStates.erase(_visStates.begin(), git);
-          
+        
+        if (!_visStates.empty()) {
+          _visStates.EraseBefore(oldestAllowedTime);
           if (_visStates.empty())
           {
             LOG_DEBUG("RobotStateHistory.CullToWindowSize.VisStatesEmpty",
@@ -839,83 +973,69 @@ namespace Anki {
                       _windowSize_ms);
           }
         }
-        if (!_computedStates.empty() && cit != _computedStates.begin()) {
-          _computedStates.erase(_computedStates.begin(), cit);
-        }
-
-        if (!_keyByTsMap.empty() && keyByTs_it != _keyByTsMap.begin()) {
-          if (keyByTs_it != _keyByTsMap.end()) {
-            const auto tsByKey_it = _tsByKeyMap.find(keyByTs_it->second);
-            if (tsByKey_it != _tsByKeyMap.end()) {
-              _tsByKeyMap.erase(_tsByKeyMap.begin(), tsByKey_it);
-            } else {
-              LOG_ERROR("RobotStateHistory.CullToWindowSize.MapsOutOfSync",
-                        "keyByTsMap size: %zu, tsByKeyMap size: %zu",
-                        _keyByTsMap.size(), _tsByKeyMap.size());
-            }
-          }
-          _keyByTsMap.erase(_keyByTsMap.begin(), keyByTs_it);
-        }
-
+        
+        _computedStates.EraseBefore(oldestAllowedTime);
       }
     }
     
     bool RobotStateHistory::IsValidKey(const HistStateKey key) const
     {
-      return (_tsByKeyMap.find(key) != _tsByKeyMap.end());
+      // Slots that aren't in use have key 0
+      const u32 slot = (key & kKeySlotMask);
+      return (key != 0 &&
+              slot < _computedStates.capacity() &&
+              _computedStates.GetSlotEntry(slot).key == key);
     }
     
     RobotTimeStamp_t RobotStateHistory::GetOldestTimeStamp() const
     {
-      return (_states.empty() ? 0 : _states.begin()->first);
+      return (_states.empty() ? 0 : _states.front().t);
     }
     
     RobotTimeStamp_t RobotStateHistory::GetNewestTimeStamp() const
     {
-      return (_states.empty() ? 0 : _states.rbegin()->first);
+      return (_states.empty() ? 0 : _states.back().t);
     }
 
     RobotTimeStamp_t RobotStateHistory::GetOldestVisionOnlyTimeStamp() const
     {
-      return (_visStates.empty() ? 0 : _visStates.begin()->first);
+      return (_visStates.empty() ? 0 : _visStates.front().t);
     }
 
     RobotTimeStamp_t RobotStateHistory::GetNewestVisionOnlyTimeStamp() const
     {
-      return (_visStates.empty() ? 0 : _visStates.rbegin()->first);
+      return (_visStates.empty() ? 0 : _visStates.back().t);
     }
 
     void RobotStateHistory::Print() const
     {
       // Create merged map of all poses
-      std::multimap<TimeStamp_t, std::pair<std::string, const_StateMapIter_t> > mergedPoses;
-      std::multimap<TimeStamp_t, std::pair<std::string, const_StateMapIter_t> >::iterator mergedIt;
-      const_StateMapIter_t pit;
+      std::multimap<TimeStamp_t, std::pair<std::string, const HistRobotState*> > mergedPoses;
       
-      for (pit = _states.begin(); pit != _states.end(); ++pit) {
+      for (size_t i=0; i<_states.size(); ++i) {
         mergedPoses.emplace(std::piecewise_construct,
-                            std::forward_as_tuple(pit->first),
-                            std::forward_as_tuple("  ", pit));
+                            std::forward_as_tuple(_states[i].t),
+                            std::forward_as_tuple("  ", &_states[i].state));
       }
 
-      for (pit = _visStates.begin(); pit != _visStates.end(); ++pit) {
+      for (size_t i=0; i<_visStates.size(); ++i) {
         mergedPoses.emplace(std::piecewise_construct,
-                            std::forward_as_tuple(pit->first),
-                            std::forward_as_tuple("v ", pit));
+                            std::forward_as_tuple(_visStates[i].t),
+                            std::forward_as_tuple("v ", &_visStates[i].state));
       }
 
-      for (pit = _computedStates.begin(); pit != _computedStates.end(); ++pit) {
+      for (size_t i=0; i<_computedStates.size(); ++i) {
         mergedPoses.emplace(std::piecewise_construct,
-                            std::forward_as_tuple(pit->first),
-                            std::forward_as_tuple("c ", pit));
+                            std::forward_as_tuple(_computedStates[i].t),
+                            std::forward_as_tuple("c ", &_computedStates[i].state));
       }
       
       
       printf("\nRobotStateHistory\n");
       printf("================\n");
-      for (mergedIt = mergedPoses.begin(); mergedIt != mergedPoses.end(); ++mergedIt) {
-        printf("%s%d: ", mergedIt->second.first.c_str(), mergedIt->first);
-        mergedIt->second.second->second.Print();
+      for (const auto& merged : mergedPoses) {
+        printf("%s%d: ", merged.second.first.c_str(), merged.first);
+        merged.second.second->Print();
       }
     }
     
@@ -21,6 +21,9 @@
 #include "engine/robotComponents_fwd.h"
 #include "util/helpers/templateHelpers.h"
 
+#include <memory>
+#include <vector>
+
 namespace Anki {
   namespace Vector {
     
@@ -100,6 +103,83 @@ namespace Anki {
     // to be used to check its validity at a later time.
     using HistStateKey = uint32_t;
     
+    /*
+     * HistStateBuffer
+     *
+     * Fixed-capacity ring of timestamped HistRobotStates, kept sorted by timestamp.
+     * Each state is stored in its own slot. Slots are allocated up front and reused, so adding and culling
+     * states doesn't allocate, and a state never moves while it is in the buffer: the ring (addressed by
+     * head and count) only holds slot numbers. States almost always arrive in order, which makes insertion
+     * an append; lookups are binary searches.
+     *
+     */
+    class HistStateBuffer
+    {
+    public:
+      
+      struct Entry {
+        RobotTimeStamp_t t = 0;
+        HistRobotState   state;
+        HistStateKey     key = 0; // only used for computed states
+      };
+      
+      explicit HistStateBuffer(size_t capacity);
+      
+      // Grows capacity (if needed), keeping all entries in their slots
+      void Reserve(size_t capacity);
+      
+      size_t size()     const { return _count;        }
+      size_t capacity() const { return _slots.size(); }
+      bool   empty()    const { return _count == 0;   }
+      void   clear();
+      
+      // Entries by index, oldest first
+      const Entry& operator[](size_t index) const { return *_slots[GetSlot(index)]; }
+      Entry&       operator[](size_t index)       { return *_slots[GetSlot(index)]; }
+      
+      const Entry& front() const { return (*this)[0];        }
+      const Entry& back()  const { return (*this)[_count-1]; }
+      
+      // Index of the first entry at or after t, or size() if there is none
+      size_t LowerBound(const RobotTimeStamp_t t) const;
+      
+      // Index of the entry at exactly t, or size() if there is none
+      size_t Find(const RobotTimeStamp_t t) const;
+      
+      // Inserts a state at t, keeping entries ordered, and returns its index. Returns size() without
+      // inserting if there already is an entry at t. If the buffer is full, the oldest entry is dropped.
+      size_t Insert(const RobotTimeStamp_t t, const HistRobotState& state);
+      
+      // Removes all entries older than t
+      void EraseBefore(const RobotTimeStamp_t t);
+      
+      // Slot that the entry at index is stored in. It keeps that slot until it is removed.
+      u32 GetSlot(size_t index) const { return _order[(_head + index) % _order.size()]; }
+      
+      // Entry stored in the given slot (< capacity()), which may not be in use
+      const Entry& GetSlotEntry(u32 slot) const { return *_slots[slot]; }
+      Entry&       GetSlotEntry(u32 slot)       { return *_slots[slot]; }
+      
+    private:
+      
+      // Drops the oldest entry
+      void PopFront();
+      
+      // Returns a slot to the free list, releasing its pose's parent
+      void ReleaseSlot(u32 slot);
+      
+      std::vector<std::unique_ptr<Entry>> _slots;
+      std::vector<u32>                    _freeSlots;
+      
+      // Entries removed while their pose was still the parent of some other pose, kept until it no longer is
+      std::vector<std::unique_ptr<Entry>> _retiredEntries;
+      
+      // Slots in use, oldest first starting at _head
+      std::vector<u32> _order;
+      size_t           _head  = 0;
+      size_t           _count = 0;
+    };
+    
     /*
      * RobotStateHistory
      *
@@ -176,10 +256,8 @@ namespace Anki {
       //            raw unprocessed states (i.e. RobotState) only.
       Result UpdateProxSensorData(const RobotTimeStamp_t t, const ProxSensorData& data);
       
-      // Returns OK and points statePtr to a vision-based state at the specified time if such a state exists.
-      // Note: The state that statePtr points to may be invalidated by subsequent calls to
-      //       the history like Clear() or Add...(). Use carefully!
-      Result GetVisionOnlyStateAt(const RobotTimeStamp_t t_request, HistRobotState** statePtr);
+      // Returns OK and sets state to the vision-based state at the specified time if such a state exists.
+      Result GetVisionOnlyStateAt(const RobotTimeStamp_t t_request, HistRobotState& state) const;
       
       // Same as above except that it uses the last vision-based
       // state that exists at or before t_request to compute a
@@ -189,21 +267,27 @@ namespace Anki {
                             bool withInterpolation = false) const;
 
       // Same as above except that it also inserts the resulting state
-      // as a vision-based state back into history.
+      // as a computed state back into history. Its key can be used to look
+      // the stored state up later with GetComputedState().
       Result ComputeAndInsertStateAt(const RobotTimeStamp_t t_request,
-                                     RobotTimeStamp_t& t, HistRobotState** statePtr,
+                                     RobotTimeStamp_t& t, HistRobotState& state,
                                      HistStateKey* key = nullptr,
                                      bool withInterpolation = false);
 
-      // Points *statePtr to a computed state in the history that was insert via ComputeAndInsertStateAt
-      Result GetComputedStateAt(const RobotTimeStamp_t t_request,
-                                HistRobotState ** statePtr,
-                                HistStateKey* key = nullptr);
-
-      // NOTE: p is not const, but *statePtr is. So you can assign to *statePtr, or statePtr, but not **statePtr
+      // Sets state to the computed state in the history that was inserted via ComputeAndInsertStateAt
       Result GetComputedStateAt(const RobotTimeStamp_t t_request,
-                                const HistRobotState ** statePtr,
+                                HistRobotState& state,
                                 HistStateKey* key = nullptr) const;
+      
+      // Returns the computed state with the given key as stored in history, or nullptr if it is no longer
+      // there. A stored state doesn't move or change until it is culled, so its pose can be used as a parent
+      // (e.g. of a historical camera pose).
+      const HistRobotState* GetComputedState(const HistStateKey key) const;
+      
+      // Updates the pose of the computed state with the given key in place, so that poses parented to it
+      // see the change. Returns RESULT_FAIL if the state is no longer in history.
+      Result UpdateComputedStatePose(const HistStateKey key, const PoseFrameID_t frameID, const Pose3d& pose,
+                                     const f32 headAngle_rad, const f32 liftAngle_rad);
 
       // If at least one vision only state exists, the most recent one is returned in p
       // and the time it occured at in t.
@@ -228,40 +312,29 @@ namespace Anki {
       // Prints the entire history
       void Print() const;
       
-      typedef std::map<RobotTimeStamp_t, HistRobotState> StateMap_t;
-      
-      const StateMap_t& GetRawPoses() const { return _states; }
+      const HistStateBuffer& GetRawPoses() const { return _states; }
       
     private:
       
       void CullToWindowSize();
       
+      // Makes sure each buffer can hold a full time window of states
+      void ReserveForTimeWindow();
+      
+      // Size of history time window (ms)
+      u32 _windowSize_ms;
+      
       // Pose history as reported by robot
-      using StateMapIter_t = StateMap_t::iterator;
-      using const_StateMapIter_t = StateMap_t::const_iterator;
-      StateMap_t _states;
+      HistStateBuffer _states;
 
-      // Map of timestamps of vision-based poses as computed from mat markers
-      StateMap_t _visStates;
+      // Timestamps of vision-based poses as computed from mat markers
+      HistStateBuffer _visStates;
 
-      // Map of poses that were computed with ComputeAt
-      StateMap_t _computedStates;
+      // Poses that were computed with ComputeAt, along with their keys
+      HistStateBuffer _computedStates;
 
-      // The last pose key assigned to a computed pose
-      static HistStateKey currHistStateKey_;
-      
-      // Map of HistStateKeys to timestamps and vice versa
-      using TimestampByKeyMap_t           = std::map<HistStateKey, RobotTimeStamp_t> ;
-      using TimestampByKeyMapIter_t       = TimestampByKeyMap_t::iterator;
-      using KeyByTimestampMap_t           = std::map<RobotTimeStamp_t, HistStateKey>;
-      using KeyByTimestampMapIter_t       = KeyByTimestampMap_t::iterator;
-      using const_KeyByTimestampMapIter_t = KeyByTimestampMap_t::const_iterator;
-      
-      TimestampByKeyMap_t _tsByKeyMap;
-      KeyByTimestampMap_t _keyByTsMap;
-      
-      // Size of history time window (ms)
-      u32 _windowSize_ms;
+      // Serial number of the last key assigned to a computed state
+      HistStateKey _computedStateSerial;
       
     }; // class RobotStateHistory
 
@@ -24,6 +24,7 @@
 #include "util/fileUtils/fileUtils.h"
 #include "util/helpers/templateHelpers.h"
 
+#include "util/logging/binaryLogger.h"
 #include "util/logging/channelFilter.h"
 #include "util/logging/iEventProvider.h"
 #include "util/logging/iFormattedLoggerProvider.h"
@@ -81,6 +82,9 @@ namespace {
   std::unique_ptr<Anki::Util::MultiLoggerProvider> gMultiLogger;
   #endif
 
+  // Private singleton, only created if VIC_BINARY_LOGGING is set
+  std::unique_ptr<Anki::Util::BinaryLogger> gBinaryLoggerInstance;
+
 }
 
 static void sigterm(int signum)
@@ -202,6 +206,16 @@ static bool cozmo_start(const Json::Value& configuration)
   }
 #endif
 
+  // Defer formatting of info/debug logs to a background thread, writing them to binary files that vic-log-decode
+  // can read back. Messages are still forwarded to the regular log once formatted.
+  if (getenv("VIC_BINARY_LOGGING") != nullptr)
+  {
+    const std::string& binaryLogPath = gDataPlatform->GetCurrentGameLogPath(std::string(LOG_PROCNAME) + "-binary");
+    gBinaryLoggerInstance = std::make_unique<Anki::Util::BinaryLogger>(binaryLogPath, true);
+    Anki::Util::gBinaryLogger = gBinaryLoggerInstance.get();
+    LOG_INFO("cozmo_start", "Binary logging to %s", binaryLogPath.c_str());
+  }
+
   LOG_INFO("cozmo_start",
             "Creating engine; Initialized data platform with persistentPath = %s, cachePath = %s, resourcesPath = %s",
             persistentPath.c_str(), cachePath.c_str(), resourcesPath.c_str());
@@ -229,6 +243,10 @@ static void cozmo_stop()
   Anki::Util::SafeDelete(gEngineAPI);
   Anki::Util::SafeDelete(gDataPlatform);
 
+  // Drains anything still buffered to the providers, so it has to go before them
+  Anki::Util::gBinaryLogger = nullptr;
+  gBinaryLoggerInstance.reset();
+
   Anki::Util::gEventProvider = nullptr;
   Anki::Util::gLoggerProvider = nullptr;
 
@@ -11,7 +11,7 @@
  **/
 
 #include "engine/vision/motionDetector.h"
-#include "engine/vision/motionDetector_neon.h"
+#include "engine/vision/motionDetectorKernels.h"
 
 #include "coretech/common/engine/math/linearAlgebra_impl.h"
 #include "coretech/common/engine/math/quad_impl.h"
@@ -24,6 +24,7 @@
 
 #include <opencv2/highgui/highgui.hpp>
 #include <iomanip>
+#include <utility>
 
 
 namespace Anki {
@@ -41,11 +42,11 @@ namespace {
   
   // Affects sensitivity (darker pixels are inherently noisier and should be ignored for
   // change detection). Range is [0,255]
-  WRAP_EXTERN_CONSOLE_VAR(u8,   kMotionDetection_MinBrightness,       CONSOLE_GROUP_NAME);
+  CONSOLE_VAR(u8,   kMotionDetection_MinBrightness,       CONSOLE_GROUP_NAME, 10);
   
   // This is the main sensitivity parameter: higher means more image difference is required
   // to register a change and thus report motion.
-  WRAP_EXTERN_CONSOLE_VAR(f32,  kMotionDetection_RatioThreshold,      CONSOLE_GROUP_NAME);
+  CONSOLE_VAR(f32,  kMotionDetection_RatioThreshold,      CONSOLE_GROUP_NAME, 1.25f);
   CONSOLE_VAR(f32,  kMotionDetection_MinAreaFraction,     CONSOLE_GROUP_NAME, 1.f/225.f); // 1/15 of each image dimension
   
   // For computing robust "centroid" of motion
@@ -402,81 +403,81 @@ void MotionDetector::SetPrevImage(const Vision::ImageRGB &image, bool wasBlurred
   _prevImageGray = Vision::Image();
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-s32 MotionDetector::RatioTest(const Vision::ImageRGB& image, Vision::Image& ratioImg)
+void MotionDetector::SwapInBlurredPrevImage(Vision::Image &blurredImage)
 {
-  DEV_ASSERT(ratioImg.GetNumRows() == image.GetNumRows() && ratioImg.GetNumCols() == image.GetNumCols(),
-             "MotionDetector.RatioTestColor.MismatchedSize");
-  
-  u32 numAboveThresh = 0;
-  
-#ifdef __ARM_NEON__
+  std::swap(_prevImageGray, blurredImage);
+  _wasPrevImageGrayBlurred = true;
+  _wasPrevImageRGBBlurred = false;
+  _prevImageRGB = Vision::ImageRGB();
+}
 
-  return RatioTestNeon(image, ratioImg);
+void MotionDetector::SwapInBlurredPrevImage(Vision::ImageRGB &blurredImage)
+{
+  std::swap(_prevImageRGB, blurredImage);
+  _wasPrevImageRGBBlurred = true;
+  _wasPrevImageGrayBlurred = false;
+  _prevImageGray = Vision::Image();
+}
 
-#else
+template<>
+Vision::Image& MotionDetector::GetBlurredImage<Vision::Image>()
+{
+  return _blurredImageGray;
+}
 
-  // somehow auto doens't work here... the right type cannot be deduced. Bug in clang?
-  std::function<u8(const Vision::PixelRGB& thisElem, const Vision::PixelRGB& otherElem)> ratioTest =
-      [&numAboveThresh](const Vision::PixelRGB& p1, const Vision::PixelRGB& p2)
-  {
-    u8 retVal = 0;
-    if(p1.IsBrighterThan(kMotionDetection_MinBrightness) &&
-       p2.IsBrighterThan(kMotionDetection_MinBrightness))
-    {
-      const f32 ratioR = RatioTestHelper(p1.r(), p2.r());
-      const f32 ratioG = RatioTestHelper(p1.g(), p2.g());
-      const f32 ratioB = RatioTestHelper(p1.b(), p2.b());
-      if(ratioR > kMotionDetection_RatioThreshold || ratioG > kMotionDetection_RatioThreshold || ratioB > kMotionDetection_RatioThreshold) {
-        ++numAboveThresh;
-        retVal = 255; // use 255 because it will actually display
-      }
-    } // if both pixels are bright enough
+template<>
+Vision::ImageRGB& MotionDetector::GetBlurredImage<Vision::ImageRGB>()
+{
+  return _blurredImageRGB;
+}
 
-    return retVal;
-  };
-  
-  image.ApplyScalarFunction(ratioTest, _prevImageRGB, ratioImg);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+namespace {
 
-#endif
-  
+// Calls ratioTestRow on each row of the images, or once on the whole images if they are all continuous
+template<class ImageType, class RatioTestRowFunc>
+s32 RatioTestRows(const ImageType& image, const ImageType& prevImage, Vision::Image& ratioImg,
+                  const RatioTestRowFunc& ratioTestRow)
+{
+  s32 numRows = image.GetNumRows();
+  s32 numPixelsPerRow = image.GetNumCols();
+  if(image.IsContinuous() && prevImage.IsContinuous() && ratioImg.IsContinuous())
+  {
+    numPixelsPerRow *= numRows;
+    numRows = 1;
+  }
+
+  s32 numAboveThresh = 0;
+  for(s32 i = 0; i < numRows; ++i)
+  {
+    numAboveThresh += ratioTestRow(reinterpret_cast<const u8*>(image.GetRow(i)),
+                                   reinterpret_cast<const u8*>(prevImage.GetRow(i)),
+                                   numPixelsPerRow, kMotionDetection_MinBrightness,
+                                   kMotionDetection_RatioThreshold, ratioImg.GetRow(i));
+  }
   return numAboveThresh;
 }
 
-s32 MotionDetector::RatioTest(const Vision::Image& image, Vision::Image& ratioImg)
+} // anonymous namespace
+
+s32 MotionDetector::RatioTest(const Vision::ImageRGB& image, Vision::Image& ratioImg)
 {
   DEV_ASSERT(ratioImg.GetNumRows() == image.GetNumRows() && ratioImg.GetNumCols() == image.GetNumCols(),
-             "MotionDetector.RatioTestGray.MismatchedSize");
-  
-  s32 numAboveThresh = 0;
-
-#ifdef __ARM_NEON__
+             "MotionDetector.RatioTestColor.MismatchedSize");
 
-  return RatioTestNeon(image, ratioImg);
+  return RatioTestRows(image, _prevImageRGB, ratioImg, (_useReferenceKernels ?
+                                                         MotionDetectorKernels::RatioTestRGBReference :
+                                                         MotionDetectorKernels::RatioTestRGB));
+}
 
-#else
-  
-  std::function<u8(const u8& thisElem, const u8& otherElem)> ratioTest = [&numAboveThresh](const u8& p1, const u8& p2)
-  {
-    u8 retVal = 0;
-    if((p1 > kMotionDetection_MinBrightness) && (p2 > kMotionDetection_MinBrightness))
-    {
-      const f32 ratio = RatioTestHelper(p1, p2);
-      if(ratio > kMotionDetection_RatioThreshold)
-      {
-        ++numAboveThresh;
-        retVal = 255; // use 255 because it will actually display
-      }
-    } // if both pixels are bright enough
-    
-    return retVal;
-  };
-  
-  image.ApplyScalarFunction(ratioTest, _prevImageGray, ratioImg);
+s32 MotionDetector::RatioTest(const Vision::Image& image, Vision::Image& ratioImg)
+{
+  DEV_ASSERT(ratioImg.GetNumRows() == image.GetNumRows() && ratioImg.GetNumCols() == image.GetNumCols(),
+             "MotionDetector.RatioTestGray.MismatchedSize");
 
-#endif
-  
-  return numAboveThresh;
+  return RatioTestRows(image, _prevImageGray, ratioImg, (_useReferenceKernels ?
+                                                          MotionDetectorKernels::RatioTestGrayReference :
+                                                          MotionDetectorKernels::RatioTestGray));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -575,11 +576,13 @@ Result MotionDetector::DetectHelper(const ImageType &image,
     msg.timestamp = image.GetTimestamp();
 
     // Remove noise here before motion detection
-    ImageType blurredImage(image.GetNumRows(), image.GetNumCols());
+    ImageType& blurredImage = GetBlurredImage<ImageType>();
+    blurredImage.Allocate(image.GetNumRows(), image.GetNumCols());
     FilterImageAndPrevImages<ImageType>(image, blurredImage);
 
     // Create the ratio test image
-    Vision::Image foregroundMotion(blurredImage.GetNumRows(), blurredImage.GetNumCols());
+    Vision::Image& foregroundMotion = _foregroundMotion;
+    foregroundMotion.Allocate(blurredImage.GetNumRows(), blurredImage.GetNumCols());
     s32 numAboveThresh = RatioTest(blurredImage, foregroundMotion);
 
     // Run the peripheral motion detection
@@ -600,9 +603,8 @@ Result MotionDetector::DetectHelper(const ImageType &image,
       observedMotions.emplace_back(std::move(msg));
     }
     
-    // Store a blurred copy of the current image for next time (at correct resolution!)
-    const bool kBlurHappened = true;
-    SetPrevImage(blurredImage, kBlurHappened);
+    // Keep the blurred current image for next time (at correct resolution!)
+    SwapInBlurredPrevImage(blurredImage);
     
   } // if(headSame && poseSame)
   else
@@ -743,10 +745,9 @@ void MotionDetector::ExtractGroundPlaneMotion(s32 origNumRows, s32 origNumCols,
   imgQuad *= 1.f / scaleMultiplier;
 
   Rectangle<s32> boundingRect(imgQuad);
-  Vision::Image groundPlaneForegroundMotion;
-  foregroundMotion.GetROI(boundingRect).CopyTo(groundPlaneForegroundMotion);
+  const Vision::Image groundPlaneForegroundMotion = foregroundMotion.GetROI(boundingRect);
 
-  // Zero out everything in the ratio image that's not inside the ground plane quad
+  // Only count motion inside the ground plane quad
   imgQuad -= boundingRect.GetTopLeft().CastTo<float>();
 
   Vision::Image mask(groundPlaneForegroundMotion.GetNumRows(),
@@ -759,16 +760,6 @@ void MotionDetector::ExtractGroundPlaneMotion(s32 origNumRows, s32 origNumCols,
         imgQuad[Quad::BottomLeft].get_CvPoint_(),
       }, 255);
 
-  for(s32 i=0; i<mask.GetNumRows(); ++i) {
-    const u8* maskData_i = mask.GetRow(i);
-    u8* fgMotionData_i = groundPlaneForegroundMotion.GetRow(i);
-    for(s32 j=0; j<mask.GetNumCols(); ++j) {
-      if(maskData_i[j] == 0) {
-        fgMotionData_i[j] = 0;
-      }
-    }
-  }
-
   // Find centroid of motion inside the ground plane
   // NOTE!! We swap X and Y for the percentiles because the ground centroid
   //        gets mapped to the ground plane in robot coordinates later, but
@@ -777,7 +768,8 @@ void MotionDetector::ExtractGroundPlaneMotion(s32 origNumRows, s32 origNumCols,
   groundRegionArea = GetCentroid(groundPlaneForegroundMotion,
                                      groundPlaneCentroid,
                                      kMotionDetection_GroundCentroidPercentileY,
-                                     (1.f - kMotionDetection_GroundCentroidPercentileX));
+                                     (1.f - kMotionDetection_GroundCentroidPercentileX),
+                                     &mask);
 
   // Move back to image coordinates from ROI coordinates
   groundPlaneCentroid += boundingRect.GetTopLeft().CastTo<float>(); // casting is explicit
@@ -1116,37 +1108,80 @@ template Result MotionDetector::DetectHelper(const Vision::ImageRGB&, s32, s32,
                                              Vision::DebugImageList<Vision::CompressedImage>&);
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-// Computes "centroid" at specified percentiles in X and Y
-size_t MotionDetector::GetCentroid(const Vision::Image& motionImg, Point2f& centroid, f32 xPercentile, f32 yPercentile)
+namespace {
+
+// The original centroid computation, which sorts the coordinates of every motion pixel. The counts GetCentroid uses
+// instead give exactly the same centroid, so this is only used by detectors set to use the reference kernels
+size_t GetCentroidReference(const Vision::Image& motionImg, Point2f& centroid, f32 xPercentile, f32 yPercentile,
+                            const Vision::Image* mask)
 {
   std::vector<s32> xValues, yValues;
   
   for(s32 y=0; y<motionImg.GetNumRows(); ++y)
   {
     const u8* motionData_y = motionImg.GetRow(y);
+    const u8* maskData_y = (mask != nullptr ? mask->GetRow(y) : nullptr);
     for(s32 x=0; x<motionImg.GetNumCols(); ++x) {
-      if(motionData_y[x] != 0) {
+      if(motionData_y[x] != 0 && (maskData_y == nullptr || maskData_y[x] != 0)) {
         xValues.push_back(x);
         yValues.push_back(y);
       }
     }
   }
   
-  DEV_ASSERT(xValues.size() == yValues.size(), "MotionDetector.GetCentroid.xyValuesSizeMismatch");
-  
-  if(xValues.empty()) {
-    centroid = 0.f;
-    return 0;
-  } else {
-    DEV_ASSERT(xPercentile >= 0.f && xPercentile <= 1.f, "MotionDetector.GetCentroid.xPercentileOOR");
-    DEV_ASSERT(yPercentile >= 0.f && yPercentile <= 1.f, "MotionDetector.GetCentroid.yPercentileOOR");
-    const size_t area = xValues.size(); // NOTE: area > 0 if we get here
+  const size_t area = xValues.size();
+  if(area > 0) {
     auto xcen = xValues.begin() + std::round(xPercentile * (f32)(area-1));
     auto ycen = yValues.begin() + std::round(yPercentile * (f32)(area-1));
     std::nth_element(xValues.begin(), xcen, xValues.end());
     std::nth_element(yValues.begin(), ycen, yValues.end());
     centroid.x() = *xcen;
     centroid.y() = *ycen;
+  }
+  return area;
+}
+
+} // anonymous namespace
+
+// Computes "centroid" at specified percentiles in X and Y
+size_t MotionDetector::GetCentroid(const Vision::Image& motionImg, Point2f& centroid, f32 xPercentile, f32 yPercentile,
+                                   const Vision::Image* mask) const
+{
+  DEV_ASSERT(mask == nullptr || (mask->GetNumRows() == motionImg.GetNumRows() &&
+                                 mask->GetNumCols() == motionImg.GetNumCols()),
+             "MotionDetector.GetCentroid.MaskSizeMismatch");
+  DEV_ASSERT(xPercentile >= 0.f && xPercentile <= 1.f, "MotionDetector.GetCentroid.xPercentileOOR");
+  DEV_ASSERT(yPercentile >= 0.f && yPercentile <= 1.f, "MotionDetector.GetCentroid.yPercentileOOR");
+
+  size_t area = 0;
+  if(_useReferenceKernels)
+  {
+    area = GetCentroidReference(motionImg, centroid, xPercentile, yPercentile, mask);
+  }
+  else
+  {
+    // The number of motion pixels in each column and row gives the same percentiles as sorting all of their
+    // coordinates would, without having to store them
+    std::vector<s32> xCounts(motionImg.GetNumCols(), 0);
+    std::vector<s32> yCounts(motionImg.GetNumRows(), 0);
+    for(s32 y=0; y<motionImg.GetNumRows(); ++y)
+    {
+      const u8* maskData_y = (mask != nullptr ? mask->GetRow(y) : nullptr);
+      yCounts[y] = MotionDetectorKernels::CountMotionInRow(motionImg.GetRow(y), maskData_y, motionImg.GetNumCols(),
+                                                           xCounts.data());
+      area += yCounts[y];
+    }
+    
+    if(area > 0) {
+      centroid.x() = MotionDetectorKernels::GetPercentileBin(xCounts.data(), motionImg.GetNumCols(), area, xPercentile);
+      centroid.y() = MotionDetectorKernels::GetPercentileBin(yCounts.data(), motionImg.GetNumRows(), area, yPercentile);
+    }
+  }
+  
+  if(area == 0) {
+    centroid = 0.f;
+    return 0;
+  } else {
     DEV_ASSERT_MSG(centroid.x() >= 0.f && centroid.x() < motionImg.GetNumCols(),
                    "MotionDetector.GetCentroid.xCenOOR",
                    "xcen=%f, not in [0,%d)", centroid.x(), motionImg.GetNumCols());
@@ -37,27 +37,10 @@ namespace Vector {
 
 // Forward declaration:
 struct VisionPoseData;
+class UnitTestKey;
 
 class VizManager;
 
-namespace {
-  // Declared static here and wrapped as an extern console
-  // inorder to allow motionDetector_neon.h to have access
-  static u8  kMotionDetection_MinBrightness  = 10;
-  static f32 kMotionDetection_RatioThreshold = 1.25f;
-
-  static inline f32 RatioTestHelper(u8 value1, u8 value2)
-  {
-    // NOTE: not checking for divide-by-zero here because kMotionDetection_MinBrightness (DEV_ASSERTed to be > 0 in
-    //  the constructor) prevents values of zero from getting to this helper
-    if(value1 > value2) {
-      return static_cast<f32>(value1) / std::max(1.f, static_cast<f32>(value2));
-    } else {
-      return static_cast<f32>(value2) / std::max(1.f, static_cast<f32>(value1));
-    }
-  }
-}
-
 // Class for detecting motion in various areas of the image.
 // There's two main components: one that detects motion on the ground plane, and one that detects motion in the
 // peripheral areas (top, left and right).
@@ -76,6 +59,12 @@ public:
 
   ~MotionDetector();
 
+  // Makes this detector use the plain reference kernels and the original sort-based centroid, which the optimized
+  // versions have to give exactly the same detections as
+  void SetUseReferenceKernels(bool useReferenceKernels, const UnitTestKey& key) {
+    _useReferenceKernels = useReferenceKernels;
+  }
+
 private:
 
   template<class ImageType>
@@ -111,9 +100,6 @@ private:
                                 Point2f &groundPlaneCentroid,
                                 f32 &groundRegionArea) const;
 
-  template<class ImageType>
-  s32 RatioTestNeon(const ImageType& image, Vision::Image& ratioImg);
-
   // Returns the number of times the ratio between the pixels in image and the pixels
   // in the previous image is above a threshold. The corresponding pixels in ratio12
   // will be set to 255
@@ -123,6 +109,14 @@ private:
   void SetPrevImage(const Vision::Image &image, bool wasBlurred);
   void SetPrevImage(const Vision::ImageRGB &image, bool wasBlurred);
   
+  // Makes the blurred image the previous image by swapping their memory instead of copying, so the old previous
+  // image's memory gets reused for blurring the next frame
+  void SwapInBlurredPrevImage(Vision::Image &blurredImage);
+  void SwapInBlurredPrevImage(Vision::ImageRGB &blurredImage);
+  
+  template<class ImageType>
+  ImageType& GetBlurredImage();
+  
   template<class ImageType>
   bool HavePrevImage() const;
   
@@ -132,16 +126,12 @@ private:
   template<class ImageType>
   bool WasPrevImageBlurred() const;
   
-  // Computes "centroid" at specified percentiles in X and Y
-  static size_t GetCentroid(const Vision::Image& motionImg,
-                            Anki::Point2f& centroid,
-                            f32 xPercentile, f32 yPercentile);
-
-  template<class ImageType>
-  inline s32 RatioTestNeonHelper(const u8*& imagePtr,
-                                 const u8*& prevImagePtr,
-                                 u8*& ratioImgPtr,
-                                 u32 numElementsToProcess);
+  // Computes "centroid" at specified percentiles in X and Y, only counting motion where mask is nonzero if
+  // one is given
+  size_t GetCentroid(const Vision::Image& motionImg,
+                     Anki::Point2f& centroid,
+                     f32 xPercentile, f32 yPercentile,
+                     const Vision::Image* mask = nullptr) const;
 
   // The joy of pimpl :)
   class ImageRegionSelector;
@@ -154,11 +144,18 @@ private:
   bool _wasPrevImageRGBBlurred = false;
   bool _wasPrevImageGrayBlurred = false;
   
+  // Kept across frames so that detecting motion doesn't allocate new images every time
+  Vision::ImageRGB _blurredImageRGB;
+  Vision::Image    _blurredImageGray;
+  Vision::Image    _foregroundMotion;
+  
   RobotTimeStamp_t   _lastMotionTime = 0;
   
   VizManager*   _vizManager = nullptr;
 
   const Json::Value& _config;
+
+  bool _useReferenceKernels = false;
 };
 
 } // namespace Vector
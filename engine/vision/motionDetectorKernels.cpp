@@ -0,0 +1,649 @@
+/**
+ * File: motionDetectorKernels.cpp
+ *
+ * Description: Per-row image kernels used by the MotionDetector, vectorized with SSE4.1 / AVX2 on x86 and with
+ *              Neon on the robot. The exact Neon versions are disabled until they have been tested there.
+ *
+ * Copyright: Anki, Inc. 2026
+ **/
+
+#include "engine/vision/motionDetectorKernels.h"
+
+#include "coretech/vision/engine/x86Simd.h"
+
+#include <algorithm>
+#include <cmath>
+
+// The exact Neon versions haven't been built and tested on the robot yet, so until they have it keeps using the
+// original Neon ratio test, which compares a reciprocal estimate against the threshold. Set this to 1 to try them
+// (MotionDetector.ReplayFramePairs and MotionDetector.SameDetectionsAsReference check them against the reference)
+#define ENABLE_MOTION_DETECTOR_NEON 0
+
+#if defined(__ARM_NEON__)
+#  include <arm_neon.h>
+#  define ANKI_MOTION_DETECTOR_NEON           ENABLE_MOTION_DETECTOR_NEON
+#  define ANKI_MOTION_DETECTOR_NEON_ORIGINAL  (!ENABLE_MOTION_DETECTOR_NEON)
+#else
+#  define ANKI_MOTION_DETECTOR_NEON           0
+#  define ANKI_MOTION_DETECTOR_NEON_ORIGINAL  0
+#endif
+
+namespace Anki {
+namespace Vector {
+namespace MotionDetectorKernels {
+
+namespace {
+
+inline bool IsAboveRatioThreshold(u8 value1, u8 value2, f32 ratioThreshold)
+{
+  // Must stay exactly this single precision division, which the vectorized versions reproduce
+  const f32 ratio = static_cast<f32>(std::max(value1, value2)) / std::max(1.f, static_cast<f32>(std::min(value1, value2)));
+  return ratio > ratioThreshold;
+}
+
+} // anonymous namespace
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+s32 RatioTestGrayReference(const u8* image, const u8* prevImage, s32 numPixels, u8 minBrightness,
+                           f32 ratioThreshold, u8* ratio)
+{
+  s32 numAboveThresh = 0;
+  for(s32 i = 0; i < numPixels; ++i)
+  {
+    const u8 p1 = image[i];
+    const u8 p2 = prevImage[i];
+    u8 retVal = 0;
+    if((p1 > minBrightness) && (p2 > minBrightness) && IsAboveRatioThreshold(p1, p2, ratioThreshold))
+    {
+      ++numAboveThresh;
+      retVal = 255; // use 255 because it will actually display
+    }
+    ratio[i] = retVal;
+  }
+  return numAboveThresh;
+}
+
+s32 RatioTestRGBReference(const u8* image, const u8* prevImage, s32 numPixels, u8 minBrightness,
+                          f32 ratioThreshold, u8* ratio)
+{
+  s32 numAboveThresh = 0;
+  for(s32 i = 0; i < numPixels; ++i)
+  {
+    const u8* p1 = image + 3*i;
+    const u8* p2 = prevImage + 3*i;
+    const bool bothBright = ((p1[0] > minBrightness) && (p1[1] > minBrightness) && (p1[2] > minBrightness) &&
+                             (p2[0] > minBrightness) && (p2[1] > minBrightness) && (p2[2] > minBrightness));
+    u8 retVal = 0;
+    if(bothBright &&
+       (IsAboveRatioThreshold(p1[0], p2[0], ratioThreshold) ||
+        IsAboveRatioThreshold(p1[1], p2[1], ratioThreshold) ||
+        IsAboveRatioThreshold(p1[2], p2[2], ratioThreshold)))
+    {
+      ++numAboveThresh;
+      retVal = 255; // use 255 because it will actually display
+    }
+    ratio[i] = retVal;
+  }
+  return numAboveThresh;
+}
+
+
+#if ANKI_MOTION_DETECTOR_NEON
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+namespace {
+
+// Neon has no vector division, so ratios are computed with a reciprocal estimate. Pixels whose ratio is within this
+// (relative) distance of the threshold could land on the other side of it than with an exact division, so they are
+// redone with the reference
+constexpr f32 kNeonRatioTolerance = 1e-4f;
+
+inline void IsAboveRatioThresholdx4(uint16x4_t hi, uint16x4_t lo, float32x4_t threshold, float32x4_t tolerance,
+                                    uint32x4_t& above, uint32x4_t& near)
+{
+  const float32x4_t hiF = vcvtq_f32_u32(vmovl_u16(hi));
+  const float32x4_t loF = vcvtq_f32_u32(vmovl_u16(lo));
+
+  // Two Newton-Raphson iterations take the reciprocal estimate to nearly full precision
+  float32x4_t recip = vrecpeq_f32(loF);
+  recip = vmulq_f32(recip, vrecpsq_f32(loF, recip));
+  recip = vmulq_f32(recip, vrecpsq_f32(loF, recip));
+
+  const float32x4_t ratio = vmulq_f32(hiF, recip);
+  above = vcgtq_f32(ratio, threshold);
+  near  = vcleq_f32(vabdq_f32(ratio, threshold), tolerance);
+}
+
+// Lanes of above are 0xFF where max(a,b) / max(min(a,b),1) > threshold, lanes of near where that can't be told
+inline void IsAboveRatioThresholdx8(uint8x8_t a, uint8x8_t b, float32x4_t threshold, float32x4_t tolerance,
+                                    uint8x8_t& above, uint8x8_t& near)
+{
+  const uint16x8_t hi = vmovl_u8(vmax_u8(a, b));
+  const uint16x8_t lo = vmovl_u8(vmax_u8(vmin_u8(a, b), vdup_n_u8(1)));
+
+  uint32x4_t above1, near1, above2, near2;
+  IsAboveRatioThresholdx4(vget_low_u16(hi),  vget_low_u16(lo),  threshold, tolerance, above1, near1);
+  IsAboveRatioThresholdx4(vget_high_u16(hi), vget_high_u16(lo), threshold, tolerance, above2, near2);
+
+  above = vmovn_u16(vcombine_u16(vmovn_u32(above1), vmovn_u32(above2)));
+  near  = vmovn_u16(vcombine_u16(vmovn_u32(near1),  vmovn_u32(near2)));
+}
+
+inline bool AnySet(uint8x8_t v)
+{
+  return vget_lane_u64(vreinterpret_u64_u8(v), 0) != 0;
+}
+
+// Number of 0xFF lanes in a vector of 0x00 / 0xFF lanes
+inline s32 CountSet(uint8x8_t v)
+{
+  // Shift each element right 7 bits so 255 -> 1, then repeatedly pairwise add
+  v = vshr_n_u8(v, 7);
+  v = vpadd_u8(v, v);
+  v = vpadd_u8(v, v);
+  v = vpadd_u8(v, v);
+  return vget_lane_u8(v, 0);
+}
+
+// numPixels must be a multiple of 8
+s32 RatioTestGrayNeon(const u8* image, const u8* prevImage, s32 numPixels, u8 minBrightness, f32 ratioThreshold,
+                      u8* ratio)
+{
+  const uint8x8_t   kMinBrightness = vdup_n_u8(minBrightness);
+  const float32x4_t kThreshold     = vdupq_n_f32(ratioThreshold);
+  const float32x4_t kTolerance     = vdupq_n_f32(ratioThreshold * kNeonRatioTolerance);
+
+  s32 numAboveThresh = 0;
+  for(s32 i = 0; i < numPixels; i += 8)
+  {
+    const uint8x8_t p1 = vld1_u8(image + i);
+    const uint8x8_t p2 = vld1_u8(prevImage + i);
+
+    // The corresponding pixels in both previous and current image need to be greater than min brightness
+    const uint8x8_t bothBright = vand_u8(vcgt_u8(p1, kMinBrightness), vcgt_u8(p2, kMinBrightness));
+
+    uint8x8_t above, near;
+    IsAboveRatioThresholdx8(p1, p2, kThreshold, kTolerance, above, near);
+
+    if(AnySet(vand_u8(near, bothBright))) {
+      numAboveThresh += RatioTestGrayReference(image + i, prevImage + i, 8, minBrightness, ratioThreshold, ratio + i);
+      continue;
+    }
+
+    const uint8x8_t pixelVal = vand_u8(above, bothBright);
+    vst1_u8(ratio + i, pixelVal);
+    numAboveThresh += CountSet(pixelVal);
+  }
+  return numAboveThresh;
+}
+
+// numPixels must be a multiple of 8
+s32 RatioTestRGBNeon(const u8* image, const u8* prevImage, s32 numPixels, u8 minBrightness, f32 ratioThreshold,
+                     u8* ratio)
+{
+  const uint8x8_t   kMinBrightness = vdup_n_u8(minBrightness);
+  const float32x4_t kThreshold     = vdupq_n_f32(ratioThreshold);
+  const float32x4_t kTolerance     = vdupq_n_f32(ratioThreshold * kNeonRatioTolerance);
+
+  s32 numAboveThresh = 0;
+  for(s32 i = 0; i < numPixels; i += 8)
+  {
+    // Load deinterleaved RGB data from the current and previous image
+    const uint8x8x3_t p1 = vld3_u8(image + 3*i);
+    const uint8x8x3_t p2 = vld3_u8(prevImage + 3*i);
+
+    // Every channel of both pixels needs to be greater than min brightness
+    uint8x8_t bothBright = vand_u8(vcgt_u8(p1.val[0], kMinBrightness), vcgt_u8(p2.val[0], kMinBrightness));
+    uint8x8_t above = vdup_n_u8(0);
+    uint8x8_t near  = vdup_n_u8(0);
+    for(int c = 0; c < 3; ++c)
+    {
+      if(c > 0) {
+        bothBright = vand_u8(bothBright, vand_u8(vcgt_u8(p1.val[c], kMinBrightness), vcgt_u8(p2.val[c], kMinBrightness)));
+      }
+      uint8x8_t channelAbove, channelNear;
+      IsAboveRatioThresholdx8(p1.val[c], p2.val[c], kThreshold, kTolerance, channelAbove, channelNear);
+      above = vorr_u8(above, channelAbove);
+      near  = vorr_u8(near,  channelNear);
+    }
+
+    if(AnySet(vand_u8(near, bothBright))) {
+      numAboveThresh += RatioTestRGBReference(image + 3*i, prevImage + 3*i, 8, minBrightness, ratioThreshold, ratio + i);
+      continue;
+    }
+
+    const uint8x8_t pixelVal = vand_u8(above, bothBright);
+    vst1_u8(ratio + i, pixelVal);
+    numAboveThresh += CountSet(pixelVal);
+  }
+  return numAboveThresh;
+}
+
+} // anonymous namespace
+
+#elif ANKI_MOTION_DETECTOR_NEON_ORIGINAL
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// The Neon ratio test from the old motionDetector_neon.h. It multiplies by a reciprocal estimate instead of dividing,
+// so pixels whose ratio is right at the threshold can come out differently than with the reference. Each row now
+// reads its own previous image (the gray test used to read the previous RGB one), and leftover pixels are always
+// written by the reference (they used to be skipped when they were too dark).
+namespace {
+
+// Lanes of whichAboveThresh1/2 (low and high 4 pixels) get all 1s where channel1 * (1 / channel2) > motionThresh
+inline void PerChannelRatio(uint8x8_t channel1, uint8x8_t channel2, float32x4_t motionThresh,
+                            uint32x4_t& whichAboveThresh1, uint32x4_t& whichAboveThresh2)
+{
+  const uint32x4_t kOnes = vdupq_n_u32(1);
+
+  // Expand channel2 from a uint8x8 to 2 uint32x4 vectors, replacing any 0s with 1s to prevent dividing by 0
+  const uint16x8_t value16_2 = vmovl_u8(channel2);
+  const uint32x4_t value32_2_1 = vmaxq_u32(vmovl_u16(vget_low_u16(value16_2)), kOnes);
+  const uint32x4_t value32_2_2 = vmaxq_u32(vmovl_u16(vget_high_u16(value16_2)), kOnes);
+
+  // Reciprocal estimate of the denominator
+  const float32x4_t recip_1 = vrecpeq_f32(vcvtq_f32_u32(value32_2_1));
+  const float32x4_t recip_2 = vrecpeq_f32(vcvtq_f32_u32(value32_2_2));
+
+  // Expand channel1 the same way and multiply it by the reciprocal
+  const uint16x8_t value16_1 = vmovl_u8(channel1);
+  const float32x4_t ratio_1 = vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(value16_1))),  recip_1);
+  const float32x4_t ratio_2 = vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(value16_1))), recip_2);
+
+  // Figure out which ratios are greater than the threshold and OR them into the WhichAboveThresh vectors
+  whichAboveThresh1 = vorrq_u32(whichAboveThresh1, vcgtq_f32(ratio_1, motionThresh));
+  whichAboveThresh2 = vorrq_u32(whichAboveThresh2, vcgtq_f32(ratio_2, motionThresh));
+}
+
+// Narrows the WhichAboveThresh vectors to 0 / 255 pixels, writes them to ratio and returns how many are 255
+inline s32 StoreRatio(uint32x4_t whichAboveThresh1, uint32x4_t whichAboveThresh2, u8* ratio)
+{
+  uint8x8_t pixelVal = vmovn_u16(vcombine_u16(vmovn_u32(whichAboveThresh1), vmovn_u32(whichAboveThresh2)));
+  vst1_u8(ratio, pixelVal);
+
+  // Shift each element right 7 bits so 255 -> 1, then repeatedly pairwise add to count them
+  pixelVal = vshr_n_u8(pixelVal, 7);
+  pixelVal = vpadd_u8(pixelVal, pixelVal);
+  pixelVal = vpadd_u8(pixelVal, pixelVal);
+  pixelVal = vpadd_u8(pixelVal, pixelVal);
+  return vget_lane_u8(pixelVal, 0);
+}
+
+// numPixels must be a multiple of 8
+s32 RatioTestGrayNeon(const u8* image, const u8* prevImage, s32 numPixels, u8 minBrightness, f32 ratioThreshold,
+                      u8* ratio)
+{
+  const uint8x8_t   kMinBrightness = vdup_n_u8(minBrightness);
+  const uint8x8_t   kZeros         = vdup_n_u8(0);
+  const float32x4_t kMotionThresh  = vdupq_n_f32(ratioThreshold);
+
+  s32 numAboveThresh = 0;
+  for(s32 i = 0; i < numPixels; i += 8)
+  {
+    uint8x8_t p1 = vld1_u8(image + i);
+    uint8x8_t p2 = vld1_u8(prevImage + i);
+
+    // The corresponding pixels in both previous and current image need to be greater than min brightness.
+    // Zero out the others, so that their ratio is 0
+    const uint8x8_t bothGtMin = vand_u8(vcgt_u8(p1, kMinBrightness), vcgt_u8(p2, kMinBrightness));
+    p1 = vbsl_u8(bothGtMin, p1, kZeros);
+    p2 = vbsl_u8(bothGtMin, p2, kZeros);
+
+    // Brighter over darker, so that the ratio is always >= 1
+    uint32x4_t whichAboveThresh1 = vdupq_n_u32(0);
+    uint32x4_t whichAboveThresh2 = vdupq_n_u32(0);
+    PerChannelRatio(vmax_u8(p1, p2), vmin_u8(p1, p2), kMotionThresh, whichAboveThresh1, whichAboveThresh2);
+
+    numAboveThresh += StoreRatio(whichAboveThresh1, whichAboveThresh2, ratio + i);
+  }
+  return numAboveThresh;
+}
+
+// numPixels must be a multiple of 8
+s32 RatioTestRGBNeon(const u8* image, const u8* prevImage, s32 numPixels, u8 minBrightness, f32 ratioThreshold,
+                     u8* ratio)
+{
+  const uint8x8_t   kMinBrightness = vdup_n_u8(minBrightness);
+  const uint8x8_t   kZeros         = vdup_n_u8(0);
+  const float32x4_t kMotionThresh  = vdupq_n_f32(ratioThreshold);
+
+  s32 numAboveThresh = 0;
+  for(s32 i = 0; i < numPixels; i += 8)
+  {
+    // Load deinterleaved RGB data from the current and previous image
+    uint8x8x3_t p1 = vld3_u8(image + 3*i);
+    uint8x8x3_t p2 = vld3_u8(prevImage + 3*i);
+
+    // Every channel of both pixels needs to be greater than min brightness
+    uint8x8_t bothGtMin = vand_u8(vcgt_u8(p1.val[0], kMinBrightness), vcgt_u8(p2.val[0], kMinBrightness));
+    for(int c = 1; c < 3; ++c) {
+      bothGtMin = vand_u8(bothGtMin, vand_u8(vcgt_u8(p1.val[c], kMinBrightness), vcgt_u8(p2.val[c], kMinBrightness)));
+    }
+
+    // A ratio above the threshold in any channel counts
+    uint32x4_t whichAboveThresh1 = vdupq_n_u32(0);
+    uint32x4_t whichAboveThresh2 = vdupq_n_u32(0);
+    for(int c = 0; c < 3; ++c)
+    {
+      p1.val[c] = vbsl_u8(bothGtMin, p1.val[c], kZeros);
+      p2.val[c] = vbsl_u8(bothGtMin, p2.val[c], kZeros);
+      PerChannelRatio(vmax_u8(p1.val[c], p2.val[c]), vmin_u8(p1.val[c], p2.val[c]), kMotionThresh,
+                      whichAboveThresh1, whichAboveThresh2);
+    }
+
+    numAboveThresh += StoreRatio(whichAboveThresh1, whichAboveThresh2, ratio + i);
+  }
+  return numAboveThresh;
+}
+
+} // anonymous namespace
+
+#elif ANKI_X86_SIMD
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+namespace {
+
+// 0xFF where v <= minBrightness
+ANKI_X86_TARGET_SSE41
+inline __m128i IsDarkx16(__m128i v, __m128i minBrightness)
+{
+  return _mm_cmpeq_epi8(_mm_max_epu8(v, minBrightness), minBrightness);
+}
+
+// Splits 16 interleaved RGB pixels into one vector per channel
+ANKI_X86_TARGET_SSE41
+inline void LoadRGBx16(const u8* src, __m128i& r, __m128i& g, __m128i& b)
+{
+  const char Z = (char)0x80;
+  const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+  const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+  const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32));
+
+  r = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, _mm_setr_epi8(0, 3, 6, 9, 12, 15, Z, Z, Z, Z, Z, Z, Z, Z, Z, Z)),
+                                _mm_shuffle_epi8(v1, _mm_setr_epi8(Z, Z, Z, Z, Z, Z, 2, 5, 8, 11, 14, Z, Z, Z, Z, Z))),
+                   _mm_shuffle_epi8(v2, _mm_setr_epi8(Z, Z, Z, Z, Z, Z, Z, Z, Z, Z, Z, 1, 4, 7, 10, 13)));
+  g = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, _mm_setr_epi8(1, 4, 7, 10, 13, Z, Z, Z, Z, Z, Z, Z, Z, Z, Z, Z)),
+                                _mm_shuffle_epi8(v1, _mm_setr_epi8(Z, Z, Z, Z, Z, 0, 3, 6, 9, 12, 15, Z, Z, Z, Z, Z))),
+                   _mm_shuffle_epi8(v2, _mm_setr_epi8(Z, Z, Z, Z, Z, Z, Z, Z, Z, Z, Z, 2, 5, 8, 11, 14)));
+  b = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, _mm_setr_epi8(2, 5, 8, 11, 14, Z, Z, Z, Z, Z, Z, Z, Z, Z, Z, Z)),
+                                _mm_shuffle_epi8(v1, _mm_setr_epi8(Z, Z, Z, Z, Z, 1, 4, 7, 10, 13, Z, Z, Z, Z, Z, Z))),
+                   _mm_shuffle_epi8(v2, _mm_setr_epi8(Z, Z, Z, Z, Z, Z, Z, Z, Z, Z, 0, 3, 6, 9, 12, 15)));
+}
+
+// 0xFFFFFFFF where hi / lo > threshold for the low 4 bytes of hi and lo. Uses the same single precision division
+// as the reference, so that results are identical
+ANKI_X86_TARGET_SSE41
+inline __m128i IsAboveRatioThresholdx4(__m128i hi, __m128i lo, __m128 threshold)
+{
+  const __m128 ratio = _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(hi)), _mm_cvtepi32_ps(_mm_cvtepu8_epi32(lo)));
+  return _mm_castps_si128(_mm_cmpgt_ps(ratio, threshold));
+}
+
+// 0xFF where max(a,b) / max(min(a,b),1) > threshold
+ANKI_X86_TARGET_SSE41
+inline __m128i IsAboveRatioThresholdx16(__m128i a, __m128i b, __m128 threshold)
+{
+  const __m128i hi = _mm_max_epu8(a, b);
+  const __m128i lo = _mm_max_epu8(_mm_min_epu8(a, b), _mm_set1_epi8(1));
+  const __m128i above0 = IsAboveRatioThresholdx4(hi, lo, threshold);
+  const __m128i above1 = IsAboveRatioThresholdx4(_mm_srli_si128(hi, 4),  _mm_srli_si128(lo, 4),  threshold);
+  const __m128i above2 = IsAboveRatioThresholdx4(_mm_srli_si128(hi, 8),  _mm_srli_si128(lo, 8),  threshold);
+  const __m128i above3 = IsAboveRatioThresholdx4(_mm_srli_si128(hi, 12), _mm_srli_si128(lo, 12), threshold);
+  return _mm_packs_epi16(_mm_packs_epi32(above0, above1), _mm_packs_epi32(above2, above3));
+}
+
+// Same as above, with 8 divisions at a time
+ANKI_X86_TARGET_AVX2
+inline __m256i IsAboveRatioThresholdx8(__m128i hi, __m128i lo, __m256 threshold)
+{
+  const __m256 ratio = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(hi)),
+                                     _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(lo)));
+  return _mm256_castps_si256(_mm256_cmp_ps(ratio, threshold, _CMP_GT_OQ));
+}
+
+ANKI_X86_TARGET_AVX2
+inline __m128i IsAboveRatioThresholdx16(__m128i a, __m128i b, __m256 threshold)
+{
+  const __m128i hi = _mm_max_epu8(a, b);
+  const __m128i lo = _mm_max_epu8(_mm_min_epu8(a, b), _mm_set1_epi8(1));
+  const __m256i above0 = IsAboveRatioThresholdx8(hi, lo, threshold);
+  const __m256i above1 = IsAboveRatioThresholdx8(_mm_srli_si128(hi, 8), _mm_srli_si128(lo, 8), threshold);
+
+  // packs works within 128 bit lanes, so put the four 64 bit blocks back in order before the final pack
+  const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(above0, above1), 0xD8);
+  return _mm_packs_epi16(_mm256_castsi256_si128(packed), _mm256_extracti128_si256(packed, 1));
+}
+
+// 0xFF where both pixels are bright enough and above the ratio threshold. There's one version for each of the
+// divisions above, which are otherwise identical.
+ANKI_X86_TARGET_SSE41
+inline __m128i RatioTestGrayx16(const u8* image, const u8* prevImage, __m128i minBrightness, __m128 threshold)
+{
+  const __m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(image));
+  const __m128i p2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prevImage));
+  const __m128i dark = _mm_or_si128(IsDarkx16(p1, minBrightness), IsDarkx16(p2, minBrightness));
+  return _mm_andnot_si128(dark, IsAboveRatioThresholdx16(p1, p2, threshold));
+}
+
+ANKI_X86_TARGET_AVX2
+inline __m128i RatioTestGrayx16(const u8* image, const u8* prevImage, __m128i minBrightness, __m256 threshold)
+{
+  const __m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(image));
+  const __m128i p2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prevImage));
+  const __m128i dark = _mm_or_si128(IsDarkx16(p1, minBrightness), IsDarkx16(p2, minBrightness));
+  return _mm_andnot_si128(dark, IsAboveRatioThresholdx16(p1, p2, threshold));
+}
+
+// 0xFF where any channel of both pixels isn't bright enough
+ANKI_X86_TARGET_SSE41
+inline __m128i IsAnyDarkRGBx16(__m128i r1, __m128i g1, __m128i b1, __m128i r2, __m128i g2, __m128i b2,
+                               __m128i minBrightness)
+{
+  const __m128i dark1 = _mm_or_si128(_mm_or_si128(IsDarkx16(r1, minBrightness), IsDarkx16(g1, minBrightness)),
+                                     IsDarkx16(b1, minBrightness));
+  const __m128i dark2 = _mm_or_si128(_mm_or_si128(IsDarkx16(r2, minBrightness), IsDarkx16(g2, minBrightness)),
+                                     IsDarkx16(b2, minBrightness));
+  return _mm_or_si128(dark1, dark2);
+}
+
+ANKI_X86_TARGET_SSE41
+inline __m128i RatioTestRGBx16(const u8* image, const u8* prevImage, __m128i minBrightness, __m128 threshold)
+{
+  __m128i r1, g1, b1, r2, g2, b2;
+  LoadRGBx16(image, r1, g1, b1);
+  LoadRGBx16(prevImage, r2, g2, b2);
+  const __m128i above = _mm_or_si128(_mm_or_si128(IsAboveRatioThresholdx16(r1, r2, threshold),
+                                                  IsAboveRatioThresholdx16(g1, g2, threshold)),
+                                     IsAboveRatioThresholdx16(b1, b2, threshold));
+  return _mm_andnot_si128(IsAnyDarkRGBx16(r1, g1, b1, r2, g2, b2, minBrightness), above);
+}
+
+ANKI_X86_TARGET_AVX2
+inline __m128i RatioTestRGBx16(const u8* image, const u8* prevImage, __m128i minBrightness, __m256 threshold)
+{
+  __m128i r1, g1, b1, r2, g2, b2;
+  LoadRGBx16(image, r1, g1, b1);
+  LoadRGBx16(prevImage, r2, g2, b2);
+  const __m128i above = _mm_or_si128(_mm_or_si128(IsAboveRatioThresholdx16(r1, r2, threshold),
+                                                  IsAboveRatioThresholdx16(g1, g2, threshold)),
+                                     IsAboveRatioThresholdx16(b1, b2, threshold));
+  return _mm_andnot_si128(IsAnyDarkRGBx16(r1, g1, b1, r2, g2, b2, minBrightness), above);
+}
+
+inline s32 CountSet(__m128i v)
+{
+  return __builtin_popcount(static_cast<u32>(_mm_movemask_epi8(v)));
+}
+
+// numPixels must be a multiple of 16 for all of these
+ANKI_X86_TARGET_SSE41
+s32 RatioTestGraySSE41(const u8* image, const u8* prevImage, s32 numPixels, u8 minBrightness, f32 ratioThreshold,
+                       u8* ratio)
+{
+  const __m128i kMinBrightness = _mm_set1_epi8(static_cast<char>(minBrightness));
+  const __m128  kThreshold     = _mm_set1_ps(ratioThreshold);
+  s32 numAboveThresh = 0;
+  for(s32 i = 0; i < numPixels; i += 16)
+  {
+    const __m128i pixelVal = RatioTestGrayx16(image + i, prevImage + i, kMinBrightness, kThreshold);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(ratio + i), pixelVal);
+    numAboveThresh += CountSet(pixelVal);
+  }
+  return numAboveThresh;
+}
+
+ANKI_X86_TARGET_AVX2
+s32 RatioTestGrayAVX2(const u8* image, const u8* prevImage, s32 numPixels, u8 minBrightness, f32 ratioThreshold,
+                      u8* ratio)
+{
+  const __m128i kMinBrightness = _mm_set1_epi8(static_cast<char>(minBrightness));
+  const __m256  kThreshold     = _mm256_set1_ps(ratioThreshold);
+  s32 numAboveThresh = 0;
+  for(s32 i = 0; i < numPixels; i += 16)
+  {
+    const __m128i pixelVal = RatioTestGrayx16(image + i, prevImage + i, kMinBrightness, kThreshold);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(ratio + i), pixelVal);
+    numAboveThresh += CountSet(pixelVal);
+  }
+  return numAboveThresh;
+}
+
+ANKI_X86_TARGET_SSE41
+s32 RatioTestRGBSSE41(const u8* image, const u8* prevImage, s32 numPixels, u8 minBrightness, f32 ratioThreshold,
+                      u8* ratio)
+{
+  const __m128i kMinBrightness = _mm_set1_epi8(static_cast<char>(minBrightness));
+  const __m128  kThreshold     = _mm_set1_ps(ratioThreshold);
+  s32 numAboveThresh = 0;
+  for(s32 i = 0; i < numPixels; i += 16)
+  {
+    const __m128i pixelVal = RatioTestRGBx16(image + 3*i, prevImage + 3*i, kMinBrightness, kThreshold);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(ratio + i), pixelVal);
+    numAboveThresh += CountSet(pixelVal);
+  }
+  return numAboveThresh;
+}
+
+ANKI_X86_TARGET_AVX2
+s32 RatioTestRGBAVX2(const u8* image, const u8* prevImage, s32 numPixels, u8 minBrightness, f32 ratioThreshold,
+                     u8* ratio)
+{
+  const __m128i kMinBrightness = _mm_set1_epi8(static_cast<char>(minBrightness));
+  const __m256  kThreshold     = _mm256_set1_ps(ratioThreshold);
+  s32 numAboveThresh = 0;
+  for(s32 i = 0; i < numPixels; i += 16)
+  {
+    const __m128i pixelVal = RatioTestRGBx16(image + 3*i, prevImage + 3*i, kMinBrightness, kThreshold);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(ratio + i), pixelVal);
+    numAboveThresh += CountSet(pixelVal);
+  }
+  return numAboveThresh;
+}
+
+} // anonymous namespace
+
+#endif // ANKI_X86_SIMD
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+s32 RatioTestGray(const u8* image, const u8* prevImage, s32 numPixels, u8 minBrightness, f32 ratioThreshold,
+                  u8* ratio)
+{
+  s32 numVectorized = 0;
+  s32 numAboveThresh = 0;
+
+#if ANKI_MOTION_DETECTOR_NEON || ANKI_MOTION_DETECTOR_NEON_ORIGINAL
+  numVectorized = numPixels - (numPixels % 8);
+  numAboveThresh = RatioTestGrayNeon(image, prevImage, numVectorized, minBrightness, ratioThreshold, ratio);
+#elif ANKI_X86_SIMD
+  if(Vision::X86::HasAVX2()) {
+    numVectorized = numPixels - (numPixels % 16);
+    numAboveThresh = RatioTestGrayAVX2(image, prevImage, numVectorized, minBrightness, ratioThreshold, ratio);
+  } else if(Vision::X86::HasSSE41()) {
+    numVectorized = numPixels - (numPixels % 16);
+    numAboveThresh = RatioTestGraySSE41(image, prevImage, numVectorized, minBrightness, ratioThreshold, ratio);
+  }
+#endif
+
+  // Process any extra elements one by one
+  numAboveThresh += RatioTestGrayReference(image + numVectorized, prevImage + numVectorized,
+                                           numPixels - numVectorized, minBrightness, ratioThreshold,
+                                           ratio + numVectorized);
+  return numAboveThresh;
+}
+
+s32 RatioTestRGB(const u8* image, const u8* prevImage, s32 numPixels, u8 minBrightness, f32 ratioThreshold,
+                 u8* ratio)
+{
+  s32 numVectorized = 0;
+  s32 numAboveThresh = 0;
+
+#if ANKI_MOTION_DETECTOR_NEON || ANKI_MOTION_DETECTOR_NEON_ORIGINAL
+  numVectorized = numPixels - (numPixels % 8);
+  numAboveThresh = RatioTestRGBNeon(image, prevImage, numVectorized, minBrightness, ratioThreshold, ratio);
+#elif ANKI_X86_SIMD
+  if(Vision::X86::HasAVX2()) {
+    numVectorized = numPixels - (numPixels % 16);
+    numAboveThresh = RatioTestRGBAVX2(image, prevImage, numVectorized, minBrightness, ratioThreshold, ratio);
+  } else if(Vision::X86::HasSSE41()) {
+    numVectorized = numPixels - (numPixels % 16);
+    numAboveThresh = RatioTestRGBSSE41(image, prevImage, numVectorized, minBrightness, ratioThreshold, ratio);
+  }
+#endif
+
+  // Process any extra elements one by one
+  numAboveThresh += RatioTestRGBReference(image + 3*numVectorized, prevImage + 3*numVectorized,
+                                          numPixels - numVectorized, minBrightness, ratioThreshold,
+                                          ratio + numVectorized);
+  return numAboveThresh;
+}
+
+
+bool RatioTestMatchesReference()
+{
+  return !ANKI_MOTION_DETECTOR_NEON_ORIGINAL;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+s32 CountMotionInRow(const u8* motion, const u8* mask, s32 numCols, s32* colCounts)
+{
+  // Kept branch free so that the compiler vectorizes these
+  s32 count = 0;
+  if(mask == nullptr)
+  {
+    for(s32 j = 0; j < numCols; ++j) {
+      const s32 isMotion = (motion[j] != 0);
+      colCounts[j] += isMotion;
+      count += isMotion;
+    }
+  }
+  else
+  {
+    for(s32 j = 0; j < numCols; ++j) {
+      const s32 isMotion = (motion[j] != 0) & (mask[j] != 0);
+      colCounts[j] += isMotion;
+      count += isMotion;
+    }
+  }
+  return count;
+}
+
+s32 GetPercentileBin(const s32* counts, s32 numBins, size_t total, f32 percentile)
+{
+  const size_t index = std::round(percentile * (f32)(total-1));
+  size_t numSoFar = 0;
+  for(s32 bin = 0; bin < numBins; ++bin)
+  {
+    numSoFar += counts[bin];
+    if(numSoFar > index) {
+      return bin;
+    }
+  }
+  return numBins - 1;
+}
+
+} // namespace MotionDetectorKernels
+} // namespace Vector
+} // namespace Anki
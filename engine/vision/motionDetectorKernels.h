@@ -0,0 +1,53 @@
+/**
+ * File: motionDetectorKernels.h
+ *
+ * Description: Per-row image kernels used by the MotionDetector, vectorized with SSE4.1 / AVX2 on x86 and
+ *              Neon on the robot. The vectorized versions give exactly the same results as the plain *Reference
+ *              versions, which are kept for the unit tests and for leftover pixels, except for the robot's
+ *              original Neon ratio test (see RatioTestMatchesReference).
+ *
+ * Copyright: Anki, Inc. 2026
+ **/
+
+#ifndef __Anki_Cozmo_Basestation_MotionDetectorKernels_H__
+#define __Anki_Cozmo_Basestation_MotionDetectorKernels_H__
+
+#include "coretech/common/shared/types.h"
+
+#include <cstddef>
+
+namespace Anki {
+namespace Vector {
+namespace MotionDetectorKernels {
+
+// Compares numPixels pixels of image with prevImage and sets the corresponding ratio pixels to 255 where both
+// are brighter than minBrightness (in every channel) and the ratio between the brighter and the darker one is
+// above ratioThreshold (in any channel), and to 0 everywhere else. Returns the number of pixels set to 255.
+// RGB pixels are 3 interleaved bytes.
+s32 RatioTestGray(const u8* image, const u8* prevImage, s32 numPixels, u8 minBrightness, f32 ratioThreshold,
+                  u8* ratio);
+s32 RatioTestRGB(const u8* image, const u8* prevImage, s32 numPixels, u8 minBrightness, f32 ratioThreshold,
+                 u8* ratio);
+
+s32 RatioTestGrayReference(const u8* image, const u8* prevImage, s32 numPixels, u8 minBrightness,
+                           f32 ratioThreshold, u8* ratio);
+s32 RatioTestRGBReference(const u8* image, const u8* prevImage, s32 numPixels, u8 minBrightness,
+                          f32 ratioThreshold, u8* ratio);
+
+// False while the robot still uses the original Neon ratio test, whose results can differ from the reference for
+// pixels with a ratio right at the threshold
+bool RatioTestMatchesReference();
+
+// Adds one to colCounts[i] for each nonzero motion[i] (where mask[i] is also nonzero, if mask isn't null).
+// Returns the number of pixels counted, i.e. the count for this row.
+s32 CountMotionInRow(const u8* motion, const u8* mask, s32 numCols, s32* colCounts);
+
+// Given how many values fell in each bin, returns the bin of the value at the given percentile: the same one
+// as sorting all total values and picking the one at round(percentile * (total-1))
+s32 GetPercentileBin(const s32* counts, s32 numBins, size_t total, f32 percentile);
+
+} // namespace MotionDetectorKernels
+} // namespace Vector
+} // namespace Anki
+
+#endif // __Anki_Cozmo_Basestation_MotionDetectorKernels_H__
@@ -32,6 +32,7 @@
 #include "engine/vision/overheadEdgesDetector.h"
 #include "engine/vision/overheadMap.h"
 #include "engine/vision/visionModesHelpers.h"
+#include "engine/vision/visionTaskGraph.h"
 #include "engine/utils/cozmoFeatureGate.h"
 
 #include "coretech/neuralnets/iNeuralNetMain.h"
@@ -113,6 +114,9 @@ CONSOLE_VAR_RANGED(s32, kImageMeanSampleInc, "VisionSystem.Statistics", 10, 1, 3
 // For testing artificial slowdowns of the vision thread
 CONSOLE_VAR(u32, kVisionSystemSimulatedDelay_ms, "Vision.General", 0);
 
+// Run independent vision modes concurrently on the mode task graph's worker threads (false runs them one by one)
+CONSOLE_VAR(bool, kVisionSystemRunModesInParallel, "Vision.General", true);
+
 CONSOLE_VAR(u32, kCalibTargetType, "Vision.Calibration", (u32)CameraCalibrator::CalibTargetType::CHECKERBOARD);
 
 // The percentage of the width of the image that will remain after cropping
@@ -332,6 +336,11 @@ Result VisionSystem::Init(const Json::Value& config)
     const std::string dnnCachePath = Util::FileUtils::FullFilePath({cachePath, "neural_nets"});
 #   endif
     
+    // All models share one runner, and thus its pool of worker threads
+    s32 numWorkerThreads = 2;
+    JsonTools::GetValueOptional(neuralNetConfig, NeuralNets::JsonKeys::NumWorkerThreads, numWorkerThreads);
+    _neuralNetRunner.reset(new Vision::NeuralNetRunner(numWorkerThreads));
+    
     for(const auto& modelConfig : modelsConfig)
     {
       if(!modelConfig.isMember(NeuralNets::JsonKeys::NetworkName))
@@ -341,16 +350,9 @@ Result VisionSystem::Init(const Json::Value& config)
       }
       
       const std::string& name = modelConfig[NeuralNets::JsonKeys::NetworkName].asString();
-      auto addModelResult = _neuralNetRunners.emplace(name, new Vision::NeuralNetRunner());
-      if(!addModelResult.second)
-      {
-        PRINT_NAMED_ERROR("VisionSystem.Init.DuplicateNeuralNetModelName", "%s", name.c_str());
-        continue;
-      }
-      std::unique_ptr<Vision::NeuralNetRunner>& neuralNetRunner = addModelResult.first->second;
-      Result neuralNetResult = neuralNetRunner->Init(modelPath,
-                                                     dnnCachePath,
-                                                     modelConfig);
+      Result neuralNetResult = _neuralNetRunner->Init(modelPath,
+                                                      dnnCachePath,
+                                                      modelConfig);
       if(RESULT_OK != neuralNetResult)
       {
         PRINT_NAMED_ERROR("VisionSystem.Init.NeuralNetInitFailed", "Name: %s", name.c_str());
@@ -371,6 +373,11 @@ Result VisionSystem::Init(const Json::Value& config)
     return RESULT_FAIL;
   }
 
+  // Worker threads for running independent modes concurrently, in addition to the VisionSystem thread itself
+  s32 numModeThreads = 2;
+  JsonTools::GetValueOptional(config, "NumModeThreads", numModeThreads);
+  _modeTaskGraph.reset(new VisionTaskGraph(std::max(numModeThreads, 0)));
+  
   _modes.Clear();
   
   _clahe->setClipLimit(kClaheClipLimit);
@@ -782,7 +789,7 @@ Vision::Image BlackOutRects(const Vision::Image& img, const std::vector<Anki::Re
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result VisionSystem::DetectFaces(Vision::ImageCache& imageCache, std::vector<Anki::Rectangle<s32>>& detectionRects,
-                                 const bool useCropping)
+                                 const bool useCropping, Vision::DebugImageList<Vision::CompressedImage>& debugImages)
 {
   DEV_ASSERT(_faceTracker != nullptr, "VisionSystem.DetectFaces.NullFaceTracker");
  
@@ -826,16 +833,15 @@ Result VisionSystem::DetectFaces(Vision::ImageCache& imageCache, std::vector<Ank
     Vision::Image maskedImage = BlackOutRects(grayImage, detectionRects);
     
 #     if DEBUG_FACE_DETECTION
-    //_currentResult.debugImages.push_back({"MaskedFaceImage", maskedImage});
+    //debugImages.push_back({"MaskedFaceImage", maskedImage});
 #     endif
     
-    _faceTracker->Update(maskedImage, cropFactor, _currentResult.faces, _currentResult.updatedFaceIDs,
-                         _currentResult.debugImages);
+    _faceTracker->Update(maskedImage, cropFactor, _currentResult.faces, _currentResult.updatedFaceIDs, debugImages);
   }
   else
   {
     // Nothing already detected, so nothing to black out before looking for faces
-    _faceTracker->Update(grayImage, cropFactor, _currentResult.faces, _currentResult.updatedFaceIDs, _currentResult.debugImages);
+    _faceTracker->Update(grayImage, cropFactor, _currentResult.faces, _currentResult.updatedFaceIDs, debugImages);
   }
   
   for(auto faceIter = _currentResult.faces.begin(); faceIter != _currentResult.faces.end(); ++faceIter)
@@ -907,13 +913,13 @@ Result VisionSystem::DetectPets(Vision::ImageCache& imageCache,
 } // DetectPets()
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Result VisionSystem::DetectMotion(Vision::ImageCache& imageCache)
+Result VisionSystem::DetectMotion(Vision::ImageCache& imageCache, Vision::DebugImageList<Vision::CompressedImage>& debugImages)
 {
 
   Result result = RESULT_OK;
   
   _motionDetector->Detect(imageCache, _poseData, _prevPoseData,
-                          _currentResult.observedMotions, _currentResult.debugImages);
+                          _currentResult.observedMotions, debugImages);
   
   return result;
   
@@ -928,32 +934,32 @@ Result VisionSystem::DetectBrightColors(Vision::ImageCache& imageCache)
   return result;
 } // DetectBrightColors()
 
-Result VisionSystem::UpdateOverheadMap(Vision::ImageCache& imageCache)
+Result VisionSystem::UpdateOverheadMap(Vision::ImageCache& imageCache, Vision::DebugImageList<Vision::CompressedImage>& debugImages)
 {
   DEV_ASSERT(imageCache.HasColor(), "VisionSystem.UpdateOverheadMap.NoColor");
   const Vision::ImageRGB& image = imageCache.GetRGB();
-  Result result = _overheadMap->Update(image, _poseData, _currentResult.debugImages);
+  Result result = _overheadMap->Update(image, _poseData, debugImages);
   return result;
 }
 
-Result VisionSystem::UpdateGroundPlaneClassifier(Vision::ImageCache& imageCache)
+Result VisionSystem::UpdateGroundPlaneClassifier(Vision::ImageCache& imageCache, Vision::DebugImageList<Vision::CompressedImage>& debugImages)
 {
   DEV_ASSERT(imageCache.HasColor(), "VisionSystem.UpdateGroundPlaneClassifier.NoColor");
   const Vision::ImageRGB& image = imageCache.GetRGB();
-  Result result = _groundPlaneClassifier->Update(image, _poseData, _currentResult.debugImages,
+  Result result = _groundPlaneClassifier->Update(image, _poseData, debugImages,
                                                  _currentResult.visualObstacles);
   return result;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Result VisionSystem::DetectLaserPoints(Vision::ImageCache& imageCache)
+Result VisionSystem::DetectLaserPoints(Vision::ImageCache& imageCache, Vision::DebugImageList<Vision::CompressedImage>& debugImages)
 {
   const bool isDarkExposure = (Util::IsNear(_currentCameraParams.exposureTime_ms, GetMinCameraExposureTime_ms()) &&
                                Util::IsNear(_currentCameraParams.gain, GetMinCameraGain()));
   
   Result result = _laserPointDetector->Detect(imageCache, _poseData, isDarkExposure,
                                               _currentResult.laserPoints,
-                                              _currentResult.debugImages);
+                                              debugImages);
   
   return result;
 }
@@ -985,7 +991,8 @@ VisionMode VisionSystem::GetModeFromString(const std::string& str) const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result VisionSystem::ApplyCLAHE(Vision::ImageCache& imageCache,
                                 const MarkerDetectionCLAHE useCLAHE,
-                                Vision::Image& claheImage)
+                                Vision::Image& claheImage,
+                                Vision::DebugImageList<Vision::CompressedImage>& debugImages)
 {
   const Vision::ImageCacheSize whichSize = imageCache.GetSize(kMarkerDetector_ScaleMultiplier);
   
@@ -1065,7 +1072,6 @@ Result VisionSystem::ApplyCLAHE(Vision::ImageCache& imageCache,
 
   const Vision::Image& inputImageGray = imageCache.GetGray(whichSize);
     
-  Tic("CLAHE");
   _clahe->apply(inputImageGray.get_CvMat_(), claheImage.get_CvMat_());
   
   if(kPostClaheSmooth > 0)
@@ -1083,10 +1089,9 @@ Result VisionSystem::ApplyCLAHE(Vision::ImageCache& imageCache,
     claheImage.BoxFilter(temp, -kPostClaheSmooth);
     std::swap(claheImage, temp);
   }
-  Toc("CLAHE");
   
   if(DEBUG_DISPLAY_CLAHE_IMAGE) {
-    _currentResult.debugImages.emplace_back("ImageCLAHE", claheImage);
+    debugImages.emplace_back("ImageCLAHE", claheImage);
   }
   
   claheImage.SetTimestamp(inputImageGray.GetTimestamp()); // make sure to preserve timestamp!
@@ -1100,7 +1105,8 @@ Result VisionSystem::DetectMarkers(Vision::ImageCache& imageCache,
                                   const Vision::Image& claheImage,
                                   std::vector<Anki::Rectangle<s32>>& detectionRects,
                                   MarkerDetectionCLAHE useCLAHE,
-                                  const VisionPoseData& poseData)
+                                  const VisionPoseData& poseData,
+                                  ModeTaskOutput& output)
 {
   // Currently assuming we detect markers first, so we won't make use of anything already detected
   DEV_ASSERT(detectionRects.empty(), "VisionSystem.DetectMarkersWithCLAHE.ExpectingEmptyDetectionRects");
@@ -1199,13 +1205,13 @@ Result VisionSystem::DetectMarkers(Vision::ImageCache& imageCache,
       // NOTE: by definition of the Ready and Reset periods, we're guaranteed
       //  to have run MarkerDetection in the same frame we trigger a Reset
       DEV_ASSERT_MSG(shouldRunOnComposite, "VisionSystem.DetectMarkers.InvalidResetCallBeforeImageUsed","");
-      _currentResult.modesProcessed.Insert(VisionMode::Markers_Composite);
+      output.modesProcessed.Insert(VisionMode::Markers_Composite);
     }
   }
 
   #if(DEBUG_IMAGE_COMPOSITING)
   if(!dispCompositeImg.IsEmpty()) {
-    _currentResult.debugImages.emplace_back("ImageCompositing", dispCompositeImg);
+    output.debugImages.emplace_back("ImageCompositing", dispCompositeImg);
   }
   #endif
   
@@ -1221,7 +1227,7 @@ Result VisionSystem::DetectMarkers(Vision::ImageCache& imageCache,
   if(IsModeEnabled(VisionMode::Markers_FullFrame))
   {
     cropRect = Rectangle<s32>(0,0,imagePtrs.front()->GetNumCols(), imagePtrs.front()->GetNumRows());
-    _currentResult.modesProcessed.Insert(VisionMode::Markers_FullFrame);
+    output.modesProcessed.Insert(VisionMode::Markers_FullFrame);
   }
   else
   {
@@ -1241,8 +1247,8 @@ Result VisionSystem::DetectMarkers(Vision::ImageCache& imageCache,
     
     DEV_ASSERT(cropRect.Area() > 0, "VisionSystem.DetectMarkersWithCLAHE.EmptyCrop");
     
-    _currentResult.modesProcessed.Enable(VisionMode::Markers_FullWidth, !useHorizontalCycling);
-    _currentResult.modesProcessed.Enable(VisionMode::Markers_FullHeight, !useVariableHeight);
+    output.modesProcessed.Enable(VisionMode::Markers_FullWidth, !useHorizontalCycling);
+    output.modesProcessed.Enable(VisionMode::Markers_FullHeight, !useVariableHeight);
   }
   
   Result lastResult = RESULT_OK;
@@ -1268,12 +1274,12 @@ Result VisionSystem::DetectMarkers(Vision::ImageCache& imageCache,
         dispImg.DrawQuad(marker.GetImageCorners(), NamedColors::RED);
       }
       dispImg.DrawRect(Rectangle<s32>{0,0,cropRect.GetWidth(),cropRect.GetHeight()}, NamedColors::RED);
-      _currentResult.debugImages.emplace_back("CroppedMarkers", dispImg);
+      output.debugImages.emplace_back("CroppedMarkers", dispImg);
     }
   }
 
   const bool meterFromChargerOnly = IsModeEnabled(VisionMode::Markers_ChargerOnly);
-  _currentResult.modesProcessed.Enable(VisionMode::Markers_ChargerOnly, meterFromChargerOnly);
+  output.modesProcessed.Enable(VisionMode::Markers_ChargerOnly, meterFromChargerOnly);
   
   auto markerIter = _currentResult.observedMarkers.begin();
   while(markerIter != _currentResult.observedMarkers.end())
@@ -1365,19 +1371,28 @@ Result VisionSystem::DetectMarkers(Vision::ImageCache& imageCache,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void VisionSystem::CheckForNeuralNetResults()
 {
-  for(const auto& neuralNetRunner : _neuralNetRunners)
+  if(!_neuralNetRunner)
+  {
+    return;
+  }
+  
+  for(const auto& networkName : _neuralNetRunner->GetNetworkNames())
   {
-    const bool resultReady = neuralNetRunner.second->GetDetections(_currentResult.salientPoints);
+    // The detections are from an earlier image than the one in the cache: the one the model actually processed
+    TimeStamp_t imageTimestamp = 0;
+    Vision::ImageRGB processedImg;
+    const bool resultReady = _neuralNetRunner->GetDetections(networkName, _currentResult.salientPoints,
+                                                             imageTimestamp, &processedImg);
     if(resultReady)
     {
       PRINT_CH_DEBUG(kLogChannelName, "VisionSystem.CheckForNeuralNetResults.GotDetections",
                      "Network:%s NumSalientPoints:%zu",
-                     neuralNetRunner.first.c_str(), _currentResult.salientPoints.size());
+                     networkName.c_str(), _currentResult.salientPoints.size());
       
       std::set<VisionMode> modes;
-      const bool success = GetVisionModesForNeuralNet(neuralNetRunner.first, modes);
+      const bool success = GetVisionModesForNeuralNet(networkName, modes);
       if(ANKI_VERIFY(success, "VisionSystem.CheckForNeuralNetResults.NoModeForNetworkName", "Name: %s",
-                     neuralNetRunner.first.c_str()))
+                     networkName.c_str()))
       {
         
         for(auto & mode : modes)
@@ -1386,10 +1401,10 @@ void VisionSystem::CheckForNeuralNetResults()
         }
         
         if(IsModeEnabled(VisionMode::SaveImages) &&
-           !_neuralNetRunnerImage.IsEmpty() &&
-           _imageSaver->WantsToSave(_currentResult, _neuralNetRunnerImage.GetTimestamp()))
+           !processedImg.IsEmpty() &&
+           _imageSaver->WantsToSave(_currentResult, imageTimestamp))
         {
-          const Result saveResult = _imageSaver->Save(_neuralNetRunnerImage, _frameNumber);
+          const Result saveResult = _imageSaver->Save(processedImg, _frameNumber);
           if(RESULT_OK == saveResult)
           {
             _currentResult.modesProcessed.Insert(VisionMode::SaveImages);
@@ -1410,7 +1425,7 @@ void VisionSystem::CheckForNeuralNetResults()
         
         if(ANKI_DEV_CHEATS)
         {
-          AddFakeDetections(modes);
+          AddFakeDetections(modes, imageTimestamp);
         }
       }
     }
@@ -1418,7 +1433,7 @@ void VisionSystem::CheckForNeuralNetResults()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void VisionSystem::AddFakeDetections(const std::set<VisionMode>& modes)
+void VisionSystem::AddFakeDetections(const std::set<VisionMode>& modes, TimeStamp_t imageTimestamp)
 {
   // DEBUG: Randomly fake detections of hands and pets if this network was registered to those modes
   if(Util::IsFltGTZero(kFakeHandDetectionProbability) ||
@@ -1447,7 +1462,7 @@ void VisionSystem::AddFakeDetections(const std::set<VisionMode>& modes)
     for(const auto& type : fakeDetectionsToAdd)
     {
       // Simple full-image "classification" SalientPoint
-      Vision::SalientPoint salientPoint(u32(_neuralNetRunnerImage.GetTimestamp()),
+      Vision::SalientPoint salientPoint(u32(imageTimestamp),
                                         0.5f, 0.5f, 1.f, 1.f,
                                         type, EnumToString(type),
                                         {CladPoint2d{0.f,0.f}, CladPoint2d{0.f,1.f}, CladPoint2d{1.f,1.f}, CladPoint2d{1.f,0.f}},
@@ -1466,10 +1481,10 @@ void VisionSystem::UpdateRollingShutter(const VisionPoseData& poseData, const Vi
     return;
   }
 
-  Tic("RollingShutterComputePixelShifts");
+  // Note: no Tic/Toc here, this runs on a mode task's worker thread (as part of Markers) and the profiler isn't
+  // thread-safe. It is included in TotalModeTasks.
   s32 numRows = imageCache.GetNumRows(Vision::ImageCacheSize::Half);
   _rollingShutterCorrector.ComputePixelShifts(poseData, _prevPoseData, numRows);
-  Toc("RollingShutterComputePixelShifts");
   _lastRollingShutterCorrectionTime = imageCache.GetTimeStamp();
 }
 
@@ -1480,7 +1495,6 @@ Result VisionSystem::Update(const VisionSystemInput& input)
 
   _modes = input.modesToProcess;
   _futureModes = input.futureModesToProcess;
-  _imageCompressQuality = input.imageCompressQuality;
   
   return Update(input.poseData, *_imageCache);
 }
@@ -1538,17 +1552,6 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
   }
   
   // Begin image processing
-  // Apply CLAHE if enabled:
-  DEV_ASSERT(kUseCLAHE_u8 < Util::EnumToUnderlying(MarkerDetectionCLAHE::Count),
-             "VisionSystem.ApplyCLAHE.BadUseClaheVal");
-  MarkerDetectionCLAHE useCLAHE = static_cast<MarkerDetectionCLAHE>(kUseCLAHE_u8);
-  Vision::Image claheImage;
-  
-  // Note: this will do nothing and leave claheImage empty if CLAHE is disabled
-  // entirely or for this frame.
-  lastResult = ApplyCLAHE(imageCache, useCLAHE, claheImage);
-  ANKI_VERIFY(RESULT_OK == lastResult, "VisionSystem.Update.FailedCLAHE", "ApplyCLAHE supposedly has no failure mode");
-  
   if(IsModeEnabled(VisionMode::Stats))
   {
     Tic("TotalStats");
@@ -1557,10 +1560,47 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
     Toc("TotalStats");
   }
 
+  if(!IsModeEnabled(VisionMode::Markers_Composite) && 
+     _imageCompositor->GetNumImagesComposited() > 0) {
+    // Clears any leftover artifacts from prematurely cancelled ImageCompositing
+    // Check this here to avoid gating it on whether or not DetectMarkers
+    _imageCompositor->Reset();
+  }
+  
+  // The detectors below only read the image (and pose data), so they are added to a task graph and run concurrently
+  // when worker threads are available. Each one writes its own fields of _currentResult. The only thing they share
+  // is the ImageCache, which is safe to use from several threads. Anything that more than one mode writes (processed
+  // modes and debug images) goes into the task's ModeTaskOutput instead, and those are merged in the order tasks were
+  // added, so the result doesn't depend on which task finished first.
+  // NOTE: Tic/Toc is not thread safe, so the tasks are only timed as a whole.
+  DEV_ASSERT(_modeTaskGraph != nullptr, "VisionSystem.Update.NullModeTaskGraph");
+  DEV_ASSERT(kUseCLAHE_u8 < Util::EnumToUnderlying(MarkerDetectionCLAHE::Count),
+             "VisionSystem.ApplyCLAHE.BadUseClaheVal");
+  const MarkerDetectionCLAHE useCLAHE = static_cast<MarkerDetectionCLAHE>(kUseCLAHE_u8);
+  Vision::Image claheImage;
+  
   DetectionRectsByMode detectionsByMode;
-
-  bool anyModeFailures = false;
   
+  // Outputs of the tasks, in the order they are added (std::list so references handed to tasks stay valid)
+  std::list<ModeTaskOutput> modeTaskOutputs;
+  
+  auto addModeTask = [this,&modeTaskOutputs](const char* name,
+                                             std::function<Result(ModeTaskOutput&)>&& func,
+                                             const std::vector<VisionTaskGraph::TaskID>& dependencies = {})
+  {
+    modeTaskOutputs.emplace_back();
+    ModeTaskOutput& output = modeTaskOutputs.back();
+    return _modeTaskGraph->AddTask(name, [func = std::move(func), &output]() { return func(output); }, dependencies);
+  };
+  
+  // Apply CLAHE if enabled. Marker detection depends on this.
+  // Note: this will do nothing and leave claheImage empty if CLAHE is disabled
+  // entirely or for this frame.
+  const VisionTaskGraph::TaskID claheTask = addModeTask("CLAHE", [this,&imageCache,useCLAHE,&claheImage](ModeTaskOutput& output) {
+    const Result result = ApplyCLAHE(imageCache, useCLAHE, claheImage, output.debugImages);
+    ANKI_VERIFY(RESULT_OK == result, "VisionSystem.Update.FailedCLAHE", "ApplyCLAHE supposedly has no failure mode");
+    return RESULT_OK;
+  });
   
   if(IsModeEnabled(VisionMode::Markers))
   {
@@ -1578,116 +1618,137 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
                                                                                   DEG_TO_RAD(kHeadTurnSpeedThreshBlock_degs)));
       if(!wasRotatingTooFast)
       {
-        // Marker detection uses rolling shutter compensation
-        UpdateRollingShutter(poseData, imageCache);
-        
-        Tic("TotalMarkers");
-        lastResult = DetectMarkers(imageCache, claheImage, detectionsByMode[VisionMode::Markers], useCLAHE, poseData);
-        
-        if(RESULT_OK != lastResult) {
-          PRINT_NAMED_ERROR("VisionSystem.Update.DetectMarkersFailed", "");
-          anyModeFailures = true;
-        } else {
-          visionModesProcessed.Insert(VisionMode::Markers);
-          visionModesProcessed.Enable(VisionMode::Markers_FastRotation, allowWhileRotatingFast);
-        }
-        Toc("TotalMarkers");
+        auto& detectionRects = detectionsByMode[VisionMode::Markers];
+        addModeTask("Markers", [this,&imageCache,&claheImage,&detectionRects,useCLAHE,&poseData,allowWhileRotatingFast](ModeTaskOutput& output) {
+          // Marker detection uses rolling shutter compensation
+          UpdateRollingShutter(poseData, imageCache);
+          
+          const Result result = DetectMarkers(imageCache, claheImage, detectionRects, useCLAHE, poseData, output);
+          if(RESULT_OK != result) {
+            PRINT_NAMED_ERROR("VisionSystem.Update.DetectMarkersFailed", "");
+          } else {
+            output.modesProcessed.Insert(VisionMode::Markers);
+            output.modesProcessed.Enable(VisionMode::Markers_FastRotation, allowWhileRotatingFast);
+          }
+          return result;
+        }, {claheTask});
       }
     }
   }
   
-  if(!IsModeEnabled(VisionMode::Markers_Composite) && 
-     _imageCompositor->GetNumImagesComposited() > 0) {
-    // Clears any leftover artifacts from prematurely cancelled ImageCompositing
-    // Check this here to avoid gating it on whether or not DetectMarkers
-    _imageCompositor->Reset();
-  }
+  // The face and pet trackers are both built on the OKAO library, which is not documented to be safe to use
+  // from two threads at once, so pets wait for faces
+  std::vector<VisionTaskGraph::TaskID> petsDependencies;
   
   if(IsModeEnabled(VisionMode::Faces))
   {
-    const bool estimatingFacialExpression = IsModeEnabled(VisionMode::Faces_Expression);
-    _faceTracker->EnableEmotionDetection(estimatingFacialExpression);
-
-    const bool detectingSmile = IsModeEnabled(VisionMode::Faces_Smile);
-    _faceTracker->EnableSmileDetection(detectingSmile);
-
-    const bool detectingGaze = IsModeEnabled(VisionMode::Faces_Gaze);
-    _faceTracker->EnableGazeDetection(detectingGaze);
-
-    const bool detectingBlink = IsModeEnabled(VisionMode::Faces_Blink);
-    _faceTracker->EnableBlinkDetection(detectingBlink);
-
-    
-    Tic("TotalFaces");
     // NOTE: To use rolling shutter in DetectFaces, call UpdateRollingShutterHere
     // See: VIC-1417 
     // UpdateRollingShutter(poseData, imageCache);
-    const bool useCropping = IsModeEnabled(VisionMode::Faces_Crop);
-    if((lastResult = DetectFaces(imageCache, detectionsByMode[VisionMode::Faces], useCropping)) != RESULT_OK) {
-      PRINT_NAMED_ERROR("VisionSystem.Update.DetectFacesFailed", "");
-      anyModeFailures = true;
-    } else {
-      visionModesProcessed.Insert(VisionMode::Faces);
-      visionModesProcessed.Enable(VisionMode::Faces_Crop,          useCropping);
-      visionModesProcessed.Enable(VisionMode::Faces_Expression,    estimatingFacialExpression);
-      visionModesProcessed.Enable(VisionMode::Faces_Smile,         detectingSmile);
-      visionModesProcessed.Enable(VisionMode::Faces_Gaze,          detectingGaze);
-      visionModesProcessed.Enable(VisionMode::Faces_Blink,         detectingBlink);
-    }
-    Toc("TotalFaces");
+    auto& detectionRects = detectionsByMode[VisionMode::Faces];
+    const VisionTaskGraph::TaskID facesTask = addModeTask("Faces", [this,&imageCache,&detectionRects](ModeTaskOutput& output) {
+      const bool estimatingFacialExpression = IsModeEnabled(VisionMode::Faces_Expression);
+      _faceTracker->EnableEmotionDetection(estimatingFacialExpression);
+      
+      const bool detectingSmile = IsModeEnabled(VisionMode::Faces_Smile);
+      _faceTracker->EnableSmileDetection(detectingSmile);
+      
+      const bool detectingGaze = IsModeEnabled(VisionMode::Faces_Gaze);
+      _faceTracker->EnableGazeDetection(detectingGaze);
+      
+      const bool detectingBlink = IsModeEnabled(VisionMode::Faces_Blink);
+      _faceTracker->EnableBlinkDetection(detectingBlink);
+      
+      const bool useCropping = IsModeEnabled(VisionMode::Faces_Crop);
+      const Result result = DetectFaces(imageCache, detectionRects, useCropping, output.debugImages);
+      if(RESULT_OK != result) {
+        PRINT_NAMED_ERROR("VisionSystem.Update.DetectFacesFailed", "");
+      } else {
+        output.modesProcessed.Insert(VisionMode::Faces);
+        output.modesProcessed.Enable(VisionMode::Faces_Crop,          useCropping);
+        output.modesProcessed.Enable(VisionMode::Faces_Expression,    estimatingFacialExpression);
+        output.modesProcessed.Enable(VisionMode::Faces_Smile,         detectingSmile);
+        output.modesProcessed.Enable(VisionMode::Faces_Gaze,          detectingGaze);
+        output.modesProcessed.Enable(VisionMode::Faces_Blink,         detectingBlink);
+      }
+      return result;
+    });
+    
+    petsDependencies.push_back(facesTask);
   }
   
   if(IsModeEnabled(VisionMode::Pets))
   {
-    Tic("TotalPets");
-    if((lastResult = DetectPets(imageCache, detectionsByMode[VisionMode::Pets])) != RESULT_OK) {
-      PRINT_NAMED_ERROR("VisionSystem.Update.DetectPetsFailed", "");
-      anyModeFailures = true;
-    } else {
-      visionModesProcessed.Insert(VisionMode::Pets);
-    }
-    Toc("TotalPets");
+    auto& detectionRects = detectionsByMode[VisionMode::Pets];
+    addModeTask("Pets", [this,&imageCache,&detectionRects](ModeTaskOutput& output) {
+      const Result result = DetectPets(imageCache, detectionRects);
+      if(RESULT_OK != result) {
+        PRINT_NAMED_ERROR("VisionSystem.Update.DetectPetsFailed", "");
+      } else {
+        output.modesProcessed.Insert(VisionMode::Pets);
+      }
+      return result;
+    }, petsDependencies);
   }
   
   if(IsModeEnabled(VisionMode::Motion))
   {
-    Tic("TotalMotion");
-    if((lastResult = DetectMotion(imageCache)) != RESULT_OK) {
-      PRINT_NAMED_ERROR("VisionSystem.Update.DetectMotionFailed", "");
-      anyModeFailures = true;
-    } else {
-      visionModesProcessed.Insert(VisionMode::Motion);
+    addModeTask("Motion", [this,&imageCache](ModeTaskOutput& output) {
+      const Result result = DetectMotion(imageCache, output.debugImages);
+      if(RESULT_OK != result) {
+        PRINT_NAMED_ERROR("VisionSystem.Update.DetectMotionFailed", "");
+      } else {
+        output.modesProcessed.Insert(VisionMode::Motion);
+      }
+      return result;
+    });
+  }
+  
+  if(IsModeEnabled(VisionMode::Lasers))
+  {
+    // Skip laser point detection if the Laser FeatureGate is disabled.
+    // TODO: Remove this once laser feature is enabled (COZMO-11185)
+    if(_context->GetFeatureGate()->IsFeatureEnabled(FeatureType::Laser))
+    {
+      addModeTask("Lasers", [this,&imageCache](ModeTaskOutput& output) {
+        const Result result = DetectLaserPoints(imageCache, output.debugImages);
+        if(RESULT_OK != result) {
+          PRINT_NAMED_ERROR("VisionSystem.Update.DetectlaserPointsFailed", "");
+        } else {
+          output.modesProcessed.Insert(VisionMode::Lasers);
+        }
+        return result;
+      });
     }
-    Toc("TotalMotion");
   }
-
+  
   if(IsModeEnabled(VisionMode::BrightColors)){
     if (imageCache.HasColor()){
-      Tic("TotalBrightColors");
-      lastResult = DetectBrightColors(imageCache);
-      Toc("TotalBrightColors");
-      if (lastResult != RESULT_OK){
-        PRINT_NAMED_ERROR("VisionSystem.Update.DetectBrightColorsFailed","");
-        anyModeFailures = true;
-      } else {
-        visionModesProcessed.Insert(VisionMode::BrightColors);
-      }
+      addModeTask("BrightColors", [this,&imageCache](ModeTaskOutput& output) {
+        const Result result = DetectBrightColors(imageCache);
+        if (result != RESULT_OK){
+          PRINT_NAMED_ERROR("VisionSystem.Update.DetectBrightColorsFailed","");
+        } else {
+          output.modesProcessed.Insert(VisionMode::BrightColors);
+        }
+        return result;
+      });
     } else {
       PRINT_NAMED_WARNING("VisionSystem.Update.NoColorImage", "Could not process bright colors. No color image!");
     }
   }
+  
   // Disabling this while VisionMode::OverheadMap is disabled
   if (IsModeEnabled(VisionMode::OverheadMap))
   {
     if (imageCache.HasColor()) {
-      Tic("UpdateOverheadMap");
-      lastResult = UpdateOverheadMap(imageCache);
-      Toc("UpdateOverheadMap");
-      if (lastResult != RESULT_OK) {
-        anyModeFailures = true;
-      } else {
-        visionModesProcessed.Insert(VisionMode::OverheadMap);
-      }
+      addModeTask("OverheadMap", [this,&imageCache](ModeTaskOutput& output) {
+        const Result result = UpdateOverheadMap(imageCache, output.debugImages);
+        if (result == RESULT_OK) {
+          output.modesProcessed.Insert(VisionMode::OverheadMap);
+        }
+        return result;
+      });
     }
     else {
       PRINT_NAMED_WARNING("VisionSystem.Update.NoColorImage", "Could not process overhead map. No color image!");
@@ -1697,20 +1758,54 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
   if (IsModeEnabled(VisionMode::Obstacles))
   {
     if (imageCache.HasColor()) {
-      Tic("DetectVisualObstacles");
-      lastResult = UpdateGroundPlaneClassifier(imageCache);
-      Toc("DetectVisualObstacles");
-      if (lastResult != RESULT_OK) {
-        anyModeFailures = true;
-      } else {
-        visionModesProcessed.Insert(VisionMode::Obstacles);
-      }
+      addModeTask("Obstacles", [this,&imageCache](ModeTaskOutput& output) {
+        const Result result = UpdateGroundPlaneClassifier(imageCache, output.debugImages);
+        if (result == RESULT_OK) {
+          output.modesProcessed.Insert(VisionMode::Obstacles);
+        }
+        return result;
+      });
     }
     else {
       PRINT_NAMED_WARNING("VisionSystem.Update.NoColorImage", "Could not process visual obstacles. No color image!");
     }
   }
-
+  
+  // Check for illumination state
+  if(IsModeEnabled(VisionMode::Illumination) &&
+     !IsModeEnabled(VisionMode::AutoExp_Cycling)) // don't check for illumination if cycling exposure
+  {
+    addModeTask("Illumination", [this,&imageCache](ModeTaskOutput& output) {
+      const Result result = DetectIllumination(imageCache);
+      if (result != RESULT_OK) {
+        PRINT_NAMED_ERROR("VisionSystem.Update.DetectIlluminationFailed", "");
+      } else {
+        output.modesProcessed.Insert(VisionMode::Illumination);
+      }
+      return result;
+    });
+  }
+  
+  Tic("TotalModeTasks");
+  _modeTaskGraph->Run(kVisionSystemRunModesInParallel);
+  Toc("TotalModeTasks");
+  
+  bool anyModeFailures = false;
+  
+  auto outputIter = modeTaskOutputs.begin();
+  for(VisionTaskGraph::TaskID task = 0; task < _modeTaskGraph->GetNumTasks(); ++task, ++outputIter)
+  {
+    if(RESULT_OK != _modeTaskGraph->GetResult(task)) {
+      anyModeFailures = true;
+    }
+    visionModesProcessed.Insert(outputIter->modesProcessed.GetSet());
+    _currentResult.debugImages.splice(_currentResult.debugImages.end(), outputIter->debugImages);
+  }
+  _modeTaskGraph->Clear();
+  
+  // Modes below here use other modes' results or state not owned by a single mode, so they run serially, after
+  // all of the above have finished
+  
   if(IsModeEnabled(VisionMode::OverheadEdges))
   {
     Tic("TotalOverheadEdges");
@@ -1758,23 +1853,6 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
       visionModesProcessed.Insert(VisionMode::Calibration);
     }
   }
-  
-  if(IsModeEnabled(VisionMode::Lasers))
-  {
-    // Skip laser point detection if the Laser FeatureGate is disabled.
-    // TODO: Remove this once laser feature is enabled (COZMO-11185)
-    if(_context->GetFeatureGate()->IsFeatureEnabled(FeatureType::Laser))
-    {
-      Tic("TotalLasers");
-      if((lastResult = DetectLaserPoints(imageCache)) != RESULT_OK) {
-        PRINT_NAMED_ERROR("VisionSystem.Update.DetectlaserPointsFailed", "");
-        anyModeFailures = true;
-      } else {
-        visionModesProcessed.Insert(VisionMode::Lasers);
-      }
-      Toc("TotalLasers");
-    }
-  }
 
   // Check for any objects from the detector. It runs asynchronously, so these objects
   // will be from a different image than the one in the cache and will use their own
@@ -1799,42 +1877,20 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
   }
   
   // Run the set of required networks
-  for(const auto& networkName : networksToRun)
+  if(_neuralNetRunner && !networksToRun.empty())
   {
-    const bool started = _neuralNetRunners.at(networkName)->StartProcessingIfIdle(imageCache);
-    if(started)
+    // If saving is enabled, the models carry the entire image along so that it can be saved with the detections
+    // from it (copied since the cache reuses its memory for the next image). Otherwise the runner only keeps track
+    // of the timestamp, which is the normal case.
+    Vision::ImageRGB imageToSave;
+    if(IsModeEnabled(VisionMode::SaveImages))
     {
-      // Remember the timestamp of the image used to do object detection, or the entire image
-      // if saving is enabled
-      if(IsModeEnabled(VisionMode::SaveImages))
-      {
-        _neuralNetRunnerImage = imageCache.GetRGB(_imageSaver->GetParams().size);
-      }
-      else
-      {
-        // This is just a tiny optimization that doesn't bother storing all the image data if saving is
-        // not enabled (which is the normal case). So we just store the timestamp like the old code this replaces.
-        _neuralNetRunnerImage.Clear();
-        _neuralNetRunnerImage.SetTimestamp(imageCache.GetTimeStamp());
-      }
+      imageCache.GetRGB(_imageSaver->GetParams().size).CopyTo(imageToSave);
     }
+    _neuralNetRunner->StartProcessingIfIdle(networksToRun, imageCache,
+                                            imageToSave.IsEmpty() ? nullptr : &imageToSave);
   }
   
-  // Check for illumination state
-  if(IsModeEnabled(VisionMode::Illumination) &&
-     !IsModeEnabled(VisionMode::AutoExp_Cycling)) // don't check for illumination if cycling exposure
-  {
-    Tic("Illumination");
-    lastResult = DetectIllumination(imageCache);
-    Toc("Illumination");
-    if (lastResult != RESULT_OK) {
-      PRINT_NAMED_ERROR("VisionSystem.Update.DetectIlluminationFailed", "");
-      anyModeFailures = true;
-    } else {
-      visionModesProcessed.Insert(VisionMode::Illumination);
-    }
-  }
-
   UpdateMeteringRegions(imageCache.GetTimeStamp(), std::move(detectionsByMode));
   
   // NOTE: This should come after any detectors that add things to "detectionRects"
@@ -1899,7 +1955,9 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
   {
     Tic("Viz");
 
-    _currentResult.compressedDisplayImg.Compress(imageCache.GetRGB(), _imageCompressQuality);
+    // Compressing for display happens on VisionComponent's camera feed encoder thread. Shares the cached
+    // image rather than copying it, the cache leaves shared images alone when it is next Reset
+    _currentResult.displayImg = imageCache.GetRGB();
 
     Toc("Viz");
 
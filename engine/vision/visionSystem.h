@@ -85,6 +85,7 @@ namespace Vector {
   class Robot;
   class VizManager;
   class GroundPlaneClassifier;
+  class VisionTaskGraph;
   
   class VisionSystem : public Vision::Profiler
   {
@@ -242,12 +243,18 @@ namespace Vector {
     std::unique_ptr<MirrorModeManager>              _mirrorModeManager;
     std::unique_ptr<Vision::Benchmark>              _benchmark;
     
-    std::map<std::string, std::unique_ptr<Vision::NeuralNetRunner>> _neuralNetRunners;
+    std::unique_ptr<Vision::NeuralNetRunner>        _neuralNetRunner;
     
-    Vision::ImageRGB                                _neuralNetRunnerImage;
-
-    Vision::CompressedImage _compressedDisplayImg;
-    s32 _imageCompressQuality = 0;
+    // Runs independent modes on the same image concurrently, see Update()
+    std::unique_ptr<VisionTaskGraph>                _modeTaskGraph;
+    
+    // Output of a mode run by _modeTaskGraph which can't be written straight into _currentResult, because
+    // other modes running at the same time write the same fields. Merged into _currentResult afterwards.
+    struct ModeTaskOutput
+    {
+      VisionModeSet                                   modesProcessed;
+      Vision::DebugImageList<Vision::CompressedImage> debugImages;
+    };
     
     Result UpdatePoseData(const VisionPoseData& newPoseData);
     Radians GetCurrentHeadAngle();
@@ -268,13 +275,15 @@ namespace Vector {
     void UpdateRollingShutter(const VisionPoseData& poseData, const Vision::ImageCache& imageCache);
 
     // Uses grayscale
-    Result ApplyCLAHE(Vision::ImageCache& imageCache, const MarkerDetectionCLAHE useCLAHE, Vision::Image& claheImage);
+    Result ApplyCLAHE(Vision::ImageCache& imageCache, const MarkerDetectionCLAHE useCLAHE, Vision::Image& claheImage,
+                      Vision::DebugImageList<Vision::CompressedImage>& debugImages);
     
     Result DetectMarkers(Vision::ImageCache& imageCache,
                          const Vision::Image& claheImage,
                          std::vector<Anki::Rectangle<s32>>& detectionRects,
                          MarkerDetectionCLAHE useCLAHE,
-                         const VisionPoseData& poseData);
+                         const VisionPoseData& poseData,
+                         ModeTaskOutput& output);
     
     // Uses grayscale
     static u8 ComputeMean(Vision::ImageCache& imageCache, const s32 sampleInc);
@@ -292,19 +301,22 @@ namespace Vector {
     Result UpdateCameraParams(Vision::ImageCache& imageCache);
     
     // Will use color if not empty, or gray otherwise
-    Result DetectLaserPoints(Vision::ImageCache& imageCache);
+    Result DetectLaserPoints(Vision::ImageCache& imageCache,
+                             Vision::DebugImageList<Vision::CompressedImage>& debugImages);
 
     // Uses grayscale
     Result DetectFaces(Vision::ImageCache& imageCache,
                        std::vector<Anki::Rectangle<s32>>& detectionRects,
-                       const bool useCropping);
+                       const bool useCropping,
+                       Vision::DebugImageList<Vision::CompressedImage>& debugImages);
     
     // Uses grayscale
     Result DetectPets(Vision::ImageCache& imageCache,
                       std::vector<Anki::Rectangle<s32>>& ignoreROIs);
     
     // Will use color if not empty, or gray otherwise
-    Result DetectMotion(Vision::ImageCache& imageCache);
+    Result DetectMotion(Vision::ImageCache& imageCache,
+                        Vision::DebugImageList<Vision::CompressedImage>& debugImages);
 
     // Uses color
     Result DetectBrightColors(Vision::ImageCache& imageCache);
@@ -313,13 +325,15 @@ namespace Vector {
     Result DetectIllumination(Vision::ImageCache& imageCache);
 
     // Uses color
-    Result UpdateOverheadMap(Vision::ImageCache& image);
+    Result UpdateOverheadMap(Vision::ImageCache& image,
+                             Vision::DebugImageList<Vision::CompressedImage>& debugImages);
 
     // Uses colors
-    Result UpdateGroundPlaneClassifier(Vision::ImageCache& image);
+    Result UpdateGroundPlaneClassifier(Vision::ImageCache& image,
+                                       Vision::DebugImageList<Vision::CompressedImage>& debugImages);
     
     void CheckForNeuralNetResults();
-    void AddFakeDetections(const std::set<VisionMode>& modes); // For debugging
+    void AddFakeDetections(const std::set<VisionMode>& modes, TimeStamp_t imageTimestamp); // For debugging
     
     Result SaveSensorData() const;
 
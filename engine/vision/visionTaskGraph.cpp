@@ -0,0 +1,162 @@
+/**
+ * File: visionTaskGraph.cpp
+ *
+ * Description: Small dependency graph of tasks, run concurrently on a fixed pool of worker threads plus the
+ *              thread calling Run(). See header.
+ *
+ * Copyright: Anki, Inc. 2026
+ **/
+
+#include "engine/vision/visionTaskGraph.h"
+
+#include "util/cpuProfiler/cpuProfiler.h"
+#include "util/logging/logging.h"
+
+namespace Anki {
+namespace Vector {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+VisionTaskGraph::VisionTaskGraph(s32 numWorkerThreads)
+{
+  for(s32 i=0; i<numWorkerThreads; ++i)
+  {
+    _threads.emplace_back([this]() { RunWorker(); });
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+VisionTaskGraph::~VisionTaskGraph()
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _shouldStop = true;
+  }
+  _condition.notify_all();
+  for(auto& thread : _threads)
+  {
+    thread.join();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void VisionTaskGraph::Clear()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  DEV_ASSERT(_readyTasks.empty(), "VisionTaskGraph.Clear.TasksStillReady");
+  _tasks.clear();
+  _numFinished = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+VisionTaskGraph::TaskID VisionTaskGraph::AddTask(const char* name, TaskFunc&& func,
+                                                 const std::vector<TaskID>& dependencies)
+{
+  const TaskID id = _tasks.size();
+
+  Task task;
+  task.name = name;
+  task.func = std::move(func);
+  task.numDependencies = (s32)dependencies.size();
+  _tasks.emplace_back(std::move(task));
+
+  for(const TaskID dependency : dependencies)
+  {
+    // Requiring dependencies to already exist is what keeps the graph acyclic
+    DEV_ASSERT_MSG(dependency < id, "VisionTaskGraph.AddTask.UnknownDependency",
+                   "%s depends on task %zu, which has not been added", name, dependency);
+    _tasks[dependency].dependents.push_back(id);
+  }
+
+  return id;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void VisionTaskGraph::Run(bool runInParallel)
+{
+  if(!runInParallel || _threads.empty() || _tasks.size() < 2)
+  {
+    for(auto& task : _tasks)
+    {
+      ANKI_CPU_TRACE_SPAN("vision", task.name);
+      task.result = task.func();
+    }
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(_mutex);
+
+  _numFinished = 0;
+  for(TaskID id = 0; id < _tasks.size(); ++id)
+  {
+    Task& task = _tasks[id];
+    task.result = RESULT_FAIL;
+    task.numPending = task.numDependencies;
+    if(0 == task.numPending)
+    {
+      _readyTasks.insert(id);
+    }
+  }
+  _condition.notify_all();
+
+  // Help out instead of just waiting for the workers
+  while(_numFinished < _tasks.size())
+  {
+    if(_readyTasks.empty())
+    {
+      _condition.wait(lock);
+    }
+    else
+    {
+      RunNextReadyTask(lock);
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void VisionTaskGraph::RunWorker()
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  while(true)
+  {
+    _condition.wait(lock, [this]() { return _shouldStop || !_readyTasks.empty(); });
+    if(_shouldStop)
+    {
+      return;
+    }
+    RunNextReadyTask(lock);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void VisionTaskGraph::RunNextReadyTask(std::unique_lock<std::mutex>& lock)
+{
+  const TaskID id = *_readyTasks.begin();
+  _readyTasks.erase(_readyTasks.begin());
+
+  // Nothing else touches a task's func or result while it is running, and _tasks can't change during Run()
+  Task& task = _tasks[id];
+  lock.unlock();
+  Result result = RESULT_FAIL;
+  {
+    // Shows each mode on the thread that ran it in trace captures, which Tic/Toc can't do from here
+    ANKI_CPU_TRACE_SPAN("vision", task.name);
+    result = task.func();
+  }
+  lock.lock();
+
+  task.result = result;
+  for(const TaskID dependent : task.dependents)
+  {
+    if(0 == --_tasks[dependent].numPending)
+    {
+      _readyTasks.insert(dependent);
+    }
+  }
+  ++_numFinished;
+
+  // Wakes workers for newly ready tasks, and the thread in Run() if this was the last one
+  _condition.notify_all();
+}
+
+} // namespace Vector
+} // namespace Anki
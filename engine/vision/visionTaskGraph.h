@@ -0,0 +1,95 @@
+/**
+ * File: visionTaskGraph.h
+ *
+ * Description: Small dependency graph of tasks, run concurrently on a fixed pool of worker threads plus the
+ *              thread calling Run(). Used by VisionSystem to run independent vision modes on the same image
+ *              at the same time.
+ *
+ *              A task only starts once all of its dependencies have finished. Dependencies have to be added
+ *              before their dependents, so the order tasks are added in is always a valid order to run them
+ *              serially, which is what happens when there are no worker threads or parallel running is off.
+ *              When more tasks are ready than there are threads, the earliest-added one starts first.
+ *
+ * Copyright: Anki, Inc. 2026
+ **/
+
+#ifndef __Anki_Vector_VisionTaskGraph_H__
+#define __Anki_Vector_VisionTaskGraph_H__
+
+#include "coretech/common/shared/types.h"
+
+#include "util/helpers/noncopyable.h"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+
+class VisionTaskGraph : private Util::noncopyable
+{
+public:
+
+  using TaskID   = size_t;
+  using TaskFunc = std::function<Result()>;
+
+  // numWorkerThreads is in addition to the thread calling Run(). Zero means every task runs on that thread.
+  explicit VisionTaskGraph(s32 numWorkerThreads);
+
+  ~VisionTaskGraph();
+
+  s32 GetNumWorkerThreads() const { return (s32)_threads.size(); }
+
+  // Remove all tasks (and their results). Not to be called while Run() is in progress.
+  void Clear();
+
+  // Add a task which will not start until all of the given (previously added) tasks have finished.
+  // Returns the ID used to refer to it as a dependency and to get its result after Run().
+  TaskID AddTask(const char* name, TaskFunc&& func, const std::vector<TaskID>& dependencies = {});
+
+  // Run all tasks added since the last Clear() and return once every one of them has finished.
+  // With runInParallel=false, tasks run one after another on the calling thread, in the order they were added.
+  void Run(bool runInParallel = true);
+
+  size_t      GetNumTasks()         const { return _tasks.size(); }
+  const char* GetName(TaskID id)    const { return _tasks[id].name; }
+  Result      GetResult(TaskID id)  const { return _tasks[id].result; }
+
+private:
+
+  struct Task
+  {
+    const char*         name;
+    TaskFunc            func;
+    std::vector<TaskID> dependents;
+    s32                 numDependencies = 0;
+    s32                 numPending = 0;   // dependencies not yet finished during the current Run()
+    Result              result = RESULT_FAIL;
+  };
+
+  std::vector<Task> _tasks;
+
+  // Tasks whose dependencies have all finished, lowest ID (i.e. earliest added) first
+  std::set<TaskID>  _readyTasks;
+  size_t            _numFinished = 0;
+
+  std::vector<std::thread> _threads;
+  bool                     _shouldStop = false;
+  std::mutex               _mutex;
+  std::condition_variable  _condition;
+
+  void RunWorker();
+
+  // Pops the next ready task, runs it with the lock released, then marks any dependents that became ready
+  void RunNextReadyTask(std::unique_lock<std::mutex>& lock);
+
+}; // class VisionTaskGraph
+
+} // namespace Vector
+} // namespace Anki
+
+#endif // __Anki_Vector_VisionTaskGraph_H__
@@ -277,6 +277,33 @@ static void ListProfiledThreads( ConsoleFunctionContextRef context )
 }
 CONSOLE_FUNC( ListProfiledThreads, kCpuProfilerSection );
 
+
+static void StartTraceCapture( ConsoleFunctionContextRef context )
+{
+  context->channel->SetChannelName("CpuProfiler");
+
+  CpuTraceRecorder& traceRecorder = CpuTraceRecorder::GetInstance();
+  if (traceRecorder.StartCapture())
+  {
+    context->channel->WriteLog("Capturing trace to '%s'", traceRecorder.GetDirectory().c_str());
+  }
+  else
+  {
+    context->channel->WriteLog("Unable to start trace capture (already capturing?)");
+  }
+}
+CONSOLE_FUNC( StartTraceCapture, kCpuProfilerSection );
+
+
+static void StopTraceCapture( ConsoleFunctionContextRef context )
+{
+  context->channel->SetChannelName("CpuProfiler");
+
+  CpuTraceRecorder::GetInstance().StopCapture();
+  context->channel->WriteLog("Stopped trace capture");
+}
+CONSOLE_FUNC( StopTraceCapture, kCpuProfilerSection );
+
 #endif // REMOTE_CONSOLE_ENABLED
   
 } // end namespace Util
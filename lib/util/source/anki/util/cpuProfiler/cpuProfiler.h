@@ -20,6 +20,7 @@
 #include "util/cpuProfiler/cpuProfileSampleShared.h"
 #include "util/cpuProfiler/cpuThreadId.h"
 #include "util/cpuProfiler/cpuThreadProfiler.h"
+#include "util/cpuProfiler/cpuTraceRecorder.h"
 #include "util/logging/logging.h"
 #include <assert.h>
 #include <vector>
@@ -259,6 +260,11 @@
 
   #define ANKI_CPU_REMOVE_THIS_THREAD()         Anki::Util::CpuProfiler::RemoveCurrentThreadProfiler()
 
+  // Records a span in the trace capture (if one is running), e.g. for message dispatch. Unlike ANKI_CPU_PROFILE the
+  // name can be dynamic, but it must stay valid until the end of the scope.
+  #define ANKI_CPU_TRACE_SPAN(category, name) \
+    Anki::Util::ScopedCpuTraceSpan                ANKI_CPU_UNIQUE_VAR_NAME(scopedCpuTraceSpan)(category, name)
+
 #else  // ANKI_CPU_PROFILER_ENABLED
 
 
@@ -274,6 +280,8 @@
 
 #define ANKI_CPU_REMOVE_THIS_THREAD() 
 
+#define ANKI_CPU_TRACE_SPAN(category, name) 
+
 #endif // ANKI_CPU_PROFILER_ENABLED
 
 
@@ -97,7 +97,6 @@ public:
   void LogProfile(uint32_t threadIndex) const;
   
   void LogAllCalledSamples(uint32_t threadIndex, const std::vector<CpuProfileSampleShared*>& samplesCalledFromThread) const;
-  void SaveChromeTracingProfile(FILE* fp, uint32_t threadIndex) const;
   void PublishToWebService(const std::function<void(const Json::Value&)>& callback, const char* threadName, uint32_t threadIndex, const std::vector<CpuProfileSampleShared*>& samplesCalledFromThread) const;
 
   uint32_t GetTickNum() const { return _tickNum; }
@@ -12,6 +12,7 @@
 
 
 #include "util/cpuProfiler/cpuThreadProfiler.h"
+#include "util/cpuProfiler/cpuTraceRecorder.h"
 #include "util/console/consoleInterface.h"
 #include "util/logging/logging.h"
 
@@ -24,17 +25,18 @@ namespace Util {
 
 CONSOLE_VAR(bool, kProfilerLogSlowTicks, "CpuProfiler", false);
 
+// Ticks are written to traces by CpuTraceRecorder whenever a capture is running, whatever the output here.
+// TraceCaptureOnly turns off periodic logging so that it doesn't show up in the capture.
 enum class Output {
-  Console       = 0,
-  ChromeTracing = 1,
-  WebViz        = 2,
+  Console          = 0,
+  TraceCaptureOnly = 1,
+  WebViz           = 2,
 };
 
-CONSOLE_VAR_ENUM(int, kProfilerLogOutput, "CpuProfiler", 0, "Console,Chrome Tracing,WebViz");
+CONSOLE_VAR_ENUM(int, kProfilerLogOutput, "CpuProfiler", 0, "Console,Trace Capture Only,WebViz");
 
 double CpuThreadProfiler::sMinSampleDuration_ms = 0.01; // ignore trivial samples below this
 
-FILE* CpuThreadProfiler::_chromeTracingFile = nullptr;
 std::function<void(const Json::Value&)> CpuThreadProfiler::_webServiceCallback = nullptr;
 
 CpuThreadProfiler::CpuThreadProfiler()
@@ -81,22 +83,6 @@ void CpuThreadProfiler::Init(CpuThreadId threadId, uint32_t threadIndex, const c
 }
   
 
-void CpuThreadProfiler::SetChromeTracingFile(const char* tracingFile) {
-  if (_chromeTracingFile) {
-    fclose(_chromeTracingFile);
-    _chromeTracingFile = nullptr;
-  }
-
-  _chromeTracingFile = fopen(tracingFile, "w");
-  if (_chromeTracingFile) {
-    fprintf(_chromeTracingFile, "{\"displayTimeUnit\": \"ms\",");
-    fprintf(_chromeTracingFile, "\"ts_epoch\": %lld,", std::chrono::duration_cast<std::chrono::milliseconds>(CpuProfileClock::now().time_since_epoch()).count());
-    fprintf(_chromeTracingFile, "\"app_epoch\": %lld,\n", std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
-    fprintf(_chromeTracingFile, "\"traceEvents\": [");
-  }
-}
-
-
 void CpuThreadProfiler::SendToWebVizCallback(const std::function<void(const Json::Value&)>& callback) {
   _webServiceCallback = callback;
 }
@@ -120,6 +106,12 @@ void CpuThreadProfiler::EndTick()
 {
   _currentProfile.EndTick();
   
+  CpuTraceRecorder& traceRecorder = CpuTraceRecorder::GetInstance();
+  if (traceRecorder.IsCapturing())
+  {
+    traceRecorder.AddTick(GetThreadName(), _currentProfile);
+  }
+  
   const double tickDuration = _currentProfile.GetTickDuration();
   const bool isSlowTick = (tickDuration > _maxTickTime_ms);
   const bool shouldLogTickFreq = (_logFrequency != kLogFrequencyNever) &&
@@ -181,8 +173,6 @@ void CpuThreadProfiler::LogProfile() const
                   GetTimeSinceBase_ms(_currentProfile.GetStartTimePoint()),
                   GetTimeSinceBase_ms(_currentProfile.GetEndTimePoint()));
     _currentProfile.LogProfile(_threadIndex);
-  } else if (kProfilerLogOutput == (int)Output::ChromeTracing) {
-      _currentProfile.SaveChromeTracingProfile(_chromeTracingFile, _threadIndex);
   }
 }
   
@@ -55,7 +55,6 @@ public:
   void Init(CpuThreadId threadId, uint32_t threadIndex, const char* threadName, double maxTickTime_ms,
             uint32_t logFrequency, const CpuProfileClock::time_point& baseTimePoint, uint32_t sampleCount = 512);
   
-  static void SetChromeTracingFile(const char* tracingFile);
   static void SendToWebVizCallback(const std::function<void(const Json::Value&)>& callback);
   void ReuseThread(CpuThreadId threadId);
   
@@ -133,7 +132,6 @@ private:
   void WarnOfTinyProfileSample(const CpuProfileSampleShared& sharedData, double duration_ms);
   
   static double sMinSampleDuration_ms; // ignore trivial samples below this
-  static FILE* _chromeTracingFile;
   static std::function<void(const Json::Value&)> _webServiceCallback;
   std::vector<CpuProfileSampleShared*>  _samplesCalledFromThread;
   const char*                 _threadName;
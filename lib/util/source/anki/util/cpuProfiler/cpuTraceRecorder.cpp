@@ -0,0 +1,288 @@
+/**
+ * File: cpuTraceRecorder
+ *
+ * Description: Continuous recording of CpuProfiler ticks and samples, plus any other spans (messages, behaviors,
+ *              vision), to Chrome trace event files
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+
+#include "util/cpuProfiler/cpuTraceRecorder.h"
+#include "util/cpuProfiler/cpuThreadId.h"
+#include "util/cpuProfiler/cpuThreadProfile.h"
+#include "util/logging/logging.h"
+#include "util/logging/rollingFileLogger.h"
+
+#include <type_traits>
+#include <unistd.h>
+
+#if ANKI_CPU_PROFILER_ENABLED
+
+#if defined(__linux__) && !defined(ANDROID)
+  #include <sys/syscall.h>
+#else
+  #include <pthread.h>
+#endif
+
+namespace Anki {
+namespace Util {
+
+namespace {
+
+// Events are batched up and handed to the file logger's queue at the end of each tick, or sooner if this much builds up
+constexpr size_t kPendingWriteSize = 16 * 1024;
+
+uint64_t GetTraceThreadId()
+{
+#if defined(ANDROID)
+  return (uint64_t)gettid();
+#elif defined(__linux__)
+  return (uint64_t)syscall(SYS_gettid);
+#else
+  uint64_t tid;
+  pthread_threadid_np(NULL, &tid);
+  return tid;
+#endif
+}
+
+void AppendEscaped(std::string& out, const char* str)
+{
+  for (const char* c = str; *c != '\0'; ++c)
+  {
+    switch (*c)
+    {
+      case '"':  out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n";  break;
+      case '\t': out += "\\t";  break;
+      default:
+        if ((unsigned char)*c >= 0x20)
+        {
+          out += *c;
+        }
+        break;
+    }
+  }
+}
+
+} // end anonymous namespace
+
+
+CpuTraceRecorder& CpuTraceRecorder::GetInstance()
+{
+  static CpuTraceRecorder sInstance;
+  return sInstance;
+}
+
+
+CpuTraceRecorder::~CpuTraceRecorder()
+{
+  StopCapture();
+}
+
+
+void CpuTraceRecorder::Init(const std::string& directory, const std::string& processName)
+{
+  DEV_ASSERT(!IsCapturing(), "CpuTraceRecorder.Init.AlreadyCapturing");
+  _directory = directory;
+  _processName = processName;
+  _pid = (int)getpid();
+}
+
+
+bool CpuTraceRecorder::StartCapture()
+{
+  if (_directory.empty())
+  {
+    PRINT_NAMED_WARNING("CpuTraceRecorder.StartCapture.NotInitialized", "No capture directory set");
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_fileLogger)
+  {
+    return false;
+  }
+
+  // Traces use the monotonic clock, which all processes on the device share, so that captures line up
+  if (std::is_same<CpuProfileClock, std::chrono::steady_clock>::value)
+  {
+    _clockOffset = CpuProfileClock::duration(0);
+  }
+  else
+  {
+    _clockOffset = std::chrono::duration_cast<CpuProfileClock::duration>(std::chrono::steady_clock::now().time_since_epoch())
+                   - CpuProfileClock::now().time_since_epoch();
+  }
+
+  _threadNames.clear();
+  _pending.clear();
+  _fileLogger.reset(new RollingFileLogger(Dispatch::create_queue, _directory, "-" + _processName + ".json"));
+  _fileLogger->SetFileHeaderFunc([this] { return GetFileHeader(); });
+  _isCapturing = true;
+
+  PRINT_CH_INFO("CpuProfiler", "CpuTraceRecorder.StartCapture", "Capturing %s to '%s'",
+                _processName.c_str(), _directory.c_str());
+  return true;
+}
+
+
+void CpuTraceRecorder::StopCapture()
+{
+  std::unique_ptr<RollingFileLogger> fileLogger;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_fileLogger)
+    {
+      return;
+    }
+    _isCapturing = false;
+    _pending += "\n]\n";
+    WritePending(true);
+    fileLogger = std::move(_fileLogger);
+  }
+
+  // Destroying the logger drops any writes still queued, so wait for them first. This has to happen outside of
+  // _mutex, as the file header (written on the logger's queue) takes it.
+  fileLogger->Flush();
+  fileLogger.reset();
+
+  PRINT_CH_INFO("CpuProfiler", "CpuTraceRecorder.StopCapture", "Stopped capturing %s", _processName.c_str());
+}
+
+
+void CpuTraceRecorder::AddTick(const char* threadName, const CpuThreadProfile& profile)
+{
+  const uint64_t tid = GetTraceThreadId();
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!_fileLogger)
+  {
+    return;
+  }
+
+  AppendThreadNameIfNew(tid, threadName);
+
+  char buffer[128];
+  snprintf(buffer, sizeof(buffer), ",\n{\"ph\":\"X\",\"cat\":\"tick\",\"name\":\"Tick\",\"pid\":%d,\"tid\":%llu,"
+           "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"tick\":%u}}",
+           _pid, (unsigned long long)tid,
+           GetTimestamp_ns(profile.GetStartTimePoint()) * 0.001,
+           CalcDuration_ms(profile.GetStartTimePoint(), profile.GetEndTimePoint()) * 1000.0,
+           profile.GetTickNum());
+  _pending += buffer;
+
+  for (size_t i = 0; i < profile.GetSampleCount(); ++i)
+  {
+    const CpuProfileSample& sample = profile.GetSample(i);
+    AppendSpan(tid, "cpu", sample.GetName(), sample.GetStartTimePoint(), sample.GetEndTimePoint());
+  }
+
+  WritePending(true);
+}
+
+
+void CpuTraceRecorder::AddSpan(const char* category, const char* name,
+                               const CpuProfileClock::time_point& start,
+                               const CpuProfileClock::time_point& end)
+{
+  const uint64_t tid = GetTraceThreadId();
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!_fileLogger)
+  {
+    return;
+  }
+
+  if (_threadNames.find(tid) == _threadNames.end())
+  {
+    AppendThreadNameIfNew(tid, GetCurrentThreadName().c_str());
+  }
+  AppendSpan(tid, category, name, start, end);
+  WritePending(false);
+}
+
+
+void CpuTraceRecorder::AppendSpan(uint64_t tid, const char* category, const char* name,
+                                  const CpuProfileClock::time_point& start,
+                                  const CpuProfileClock::time_point& end)
+{
+  _pending += ",\n{\"ph\":\"X\",\"cat\":\"";
+  _pending += category;
+  _pending += "\",\"name\":\"";
+  AppendEscaped(_pending, name);
+
+  char buffer[96];
+  snprintf(buffer, sizeof(buffer), "\",\"pid\":%d,\"tid\":%llu,\"ts\":%.3f,\"dur\":%.3f}",
+           _pid, (unsigned long long)tid, GetTimestamp_ns(start) * 0.001, CalcDuration_ms(start, end) * 1000.0);
+  _pending += buffer;
+}
+
+
+void CpuTraceRecorder::AppendThreadNameIfNew(uint64_t tid, const char* threadName)
+{
+  auto it = _threadNames.find(tid);
+  if ((it != _threadNames.end()) && (it->second == threadName))
+  {
+    return;
+  }
+  _threadNames[tid] = threadName;
+
+  _pending += ",\n";
+  AppendMetadata(_pending, tid, "thread_name", threadName);
+}
+
+
+void CpuTraceRecorder::AppendMetadata(std::string& out, uint64_t tid, const char* metadataName,
+                                      const std::string& value) const
+{
+  char buffer[96];
+  snprintf(buffer, sizeof(buffer), "{\"ph\":\"M\",\"name\":\"%s\",\"pid\":%d,\"tid\":%llu,\"args\":{\"name\":\"",
+           metadataName, _pid, (unsigned long long)tid);
+  out += buffer;
+  AppendEscaped(out, value.c_str());
+  out += "\"}}";
+}
+
+
+void CpuTraceRecorder::WritePending(bool force)
+{
+  if (!_pending.empty() && (force || (_pending.size() >= kPendingWriteSize)))
+  {
+    _fileLogger->Write(std::move(_pending));
+    _pending.clear();
+  }
+}
+
+
+std::string CpuTraceRecorder::GetFileHeader() const
+{
+  // Every file (including ones started when a long capture rolls over) names the process and all threads seen so far,
+  // so each can be opened on its own. Only the last file of a capture is closed with ']', which the trace viewers
+  // don't require.
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  std::string header = "[\n";
+  AppendMetadata(header, 0, "process_name", _processName);
+  for (const auto& entry : _threadNames)
+  {
+    header += ",\n";
+    AppendMetadata(header, entry.first, "thread_name", entry.second);
+  }
+  return header;
+}
+
+
+int64_t CpuTraceRecorder::GetTimestamp_ns(const CpuProfileClock::time_point& timePoint) const
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(timePoint.time_since_epoch() + _clockOffset).count();
+}
+
+
+} // end namespace Util
+} // end namespace Anki
+
+
+#endif // ANKI_CPU_PROFILER_ENABLED
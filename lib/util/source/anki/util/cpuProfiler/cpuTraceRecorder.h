@@ -0,0 +1,140 @@
+/**
+ * File: cpuTraceRecorder
+ *
+ * Description: Continuous recording of CpuProfiler ticks and samples, plus any other spans (messages, behaviors,
+ *              vision), to Chrome trace event files that open in chrome://tracing or ui.perfetto.dev.
+ *              Timestamps are taken from the monotonic clock shared by every process on the device, and each
+ *              process shows up under its own pid, so captures from vic-engine and vic-anim can be loaded together
+ *              and line up with each other.
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+
+#ifndef __Util_CpuProfiler_CpuTraceRecorder_H__
+#define __Util_CpuProfiler_CpuTraceRecorder_H__
+
+
+#include "util/cpuProfiler/cpuProfilerClock.h"
+#include "util/cpuProfiler/cpuProfilerSettings.h"
+#include "util/helpers/noncopyable.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+
+#if ANKI_CPU_PROFILER_ENABLED
+
+
+namespace Anki {
+namespace Util {
+
+class CpuThreadProfile;
+class RollingFileLogger;
+
+
+class CpuTraceRecorder : noncopyable
+{
+public:
+
+  static CpuTraceRecorder& GetInstance();
+
+  // Captures are written to directory, with processName used for the file names and to label the process in the
+  // trace. Call once at startup, before any capture is started.
+  void Init(const std::string& directory, const std::string& processName);
+
+  // Returns false if a capture is already running or Init() hasn't been called
+  bool StartCapture();
+  void StopCapture();
+
+  bool IsCapturing() const { return _isCapturing.load(std::memory_order_relaxed); }
+
+  const std::string& GetDirectory() const { return _directory; }
+
+  // Called by CpuThreadProfiler at the end of every tick while capturing
+  void AddTick(const char* threadName, const CpuThreadProfile& profile);
+
+  // Adds a span on the calling thread. Strings are copied, so they only need to live until this returns.
+  void AddSpan(const char* category, const char* name,
+               const CpuProfileClock::time_point& start,
+               const CpuProfileClock::time_point& end);
+
+private:
+
+  CpuTraceRecorder() = default;
+  ~CpuTraceRecorder();
+
+  void AppendSpan(uint64_t tid, const char* category, const char* name,
+                  const CpuProfileClock::time_point& start,
+                  const CpuProfileClock::time_point& end);
+  void AppendThreadNameIfNew(uint64_t tid, const char* threadName);
+  void AppendMetadata(std::string& out, uint64_t tid, const char* metadataName, const std::string& value) const;
+  void WritePending(bool force);
+  std::string GetFileHeader() const;
+
+  int64_t GetTimestamp_ns(const CpuProfileClock::time_point& timePoint) const;
+
+  std::string _directory;
+  std::string _processName;
+  int         _pid = 0;
+
+  // Everything below is guarded by _mutex, other than the fast IsCapturing() check
+  mutable std::mutex                         _mutex;
+  std::atomic<bool>                          _isCapturing{false};
+  std::unique_ptr<RollingFileLogger>         _fileLogger;
+  std::string                                _pending; // events not yet handed to _fileLogger
+  std::unordered_map<uint64_t, std::string>  _threadNames;
+  CpuProfileClock::duration                  _clockOffset{0}; // from CpuProfileClock to the monotonic clock
+};
+
+
+// Records a span from construction to destruction, if a capture is running
+class ScopedCpuTraceSpan
+{
+public:
+
+  ScopedCpuTraceSpan(const char* category, const char* name)
+    : _category(category)
+    , _name(name)
+    , _active(CpuTraceRecorder::GetInstance().IsCapturing())
+  {
+    if (_active)
+    {
+      _startTime = CpuProfileClock::now();
+    }
+  }
+
+  ScopedCpuTraceSpan(const char* category, const std::string& name)
+    : ScopedCpuTraceSpan(category, name.c_str())
+  {
+  }
+
+  ~ScopedCpuTraceSpan()
+  {
+    if (_active)
+    {
+      CpuTraceRecorder::GetInstance().AddSpan(_category, _name, _startTime, CpuProfileClock::now());
+    }
+  }
+
+private:
+
+  const char*                 _category;
+  const char*                 _name;
+  CpuProfileClock::time_point _startTime;
+  bool                        _active;
+};
+
+
+} // end namespace Util
+} // end namespace Anki
+
+
+#endif // ANKI_CPU_PROFILER_ENABLED
+
+
+#endif // __Util_CpuProfiler_CpuTraceRecorder_H__
@@ -17,8 +17,13 @@
 #include "util/entityComponent/componentTypeEnumMap.h"
 #include "util/helpers/fullEnumToValueArrayChecker.h"
 #include "util/logging/logging.h"
+#include "util/stats/recentPercentiles.h"
+#include "util/threading/workStealingPool.h"
 
+#include <algorithm>
+#include <chrono>
 #include <map>
+#include <mutex>
 #include <set>
 
 #if !defined(ANKI_PROFILE_DEPENDENCY_MANAGED_ENTITY)
@@ -32,6 +37,22 @@ namespace Vector {
 class Robot;
 }
 
+// Opt-in scheduling for DependencyManagedEntity::UpdateComponents
+struct DependencyManagedUpdateSettings
+{
+  // If set, runs of consecutive components in the update order that flag themselves as update thread safe, and
+  // don't access each other, are updated at the same time on this pool. Every other component is still updated on
+  // its own, in order. Otherwise all components are updated serially
+  Util::WorkStealingPool* pool = nullptr;
+
+  // Warn the first time each component accesses another component through the entity during its update
+  // without having declared it as an update dependency or additional accessible component
+  bool checkUndeclaredAccess = false;
+
+  // Time every component's update - see DependencyManagedEntity::GetUpdateTimes
+  bool timeUpdates = false;
+};
+
 template<typename EnumType>
 class DependencyManagedEntity
 {
@@ -64,6 +85,24 @@ public:
   // Update all components in their declared dependency order
   void UpdateComponents();
 
+  // Change how UpdateComponents schedules the components - see DependencyManagedUpdateSettings
+  void SetUpdateSettings(const DependencyManagedUpdateSettings& settings) { _updateSettings = settings; }
+
+  // (updating component, accessed component) pairs found so far by checkUndeclaredAccess
+  std::set<std::pair<EnumType, EnumType>> GetUndeclaredAccesses() const;
+
+  // How long each component's updates took, in update order, while timeUpdates is set. Components nested in
+  // other entities are part of the time of the component that owns their entity
+  static constexpr uint32_t kNumRecentUpdateTimes = 256;
+  struct ComponentUpdateTime {
+    explicit ComponentUpdateTime(EnumType id) : id(id), recent_ms(kNumRecentUpdateTimes) {}
+    EnumType id;
+    std::chrono::steady_clock::time_point lastStart;
+    float lastDuration_ms = 0.f;
+    Util::Stats::RecentPercentiles recent_ms;
+  };
+  const std::vector<ComponentUpdateTime>& GetUpdateTimes() const { return _updateTimes; }
+
   template<typename T>
   bool HasComponent() const {
     EnumType enumID = EnumType::Count;
@@ -76,6 +115,7 @@ public:
   T& GetComponent() const {
     EnumType enumID = EnumType::Count;
     GetComponentIDForType<EnumType,T>(enumID);
+    CheckAccess(enumID);
     return GetComponent(enumID). template GetComponent<T>();
   }
 
@@ -83,6 +123,7 @@ public:
   T* GetComponentPtr() const {
     EnumType enumID = EnumType::Count;
     GetComponentIDForType<EnumType,T>(enumID);
+    CheckAccess(enumID);
     return GetComponent(enumID). template GetComponentPtr<T>();
   }
 
@@ -104,6 +145,27 @@ private:
   std::vector<std::pair<ComponentPtrWrapper,DependentComponents>> _cachedInitOrder;
   std::vector<std::pair<ComponentPtrWrapper,DependentComponents>> _cachedUpdateOrder;
 
+  // _cachedUpdateOrder split into batches of consecutive components, as indices into it. The components of a batch
+  // may be updated at the same time as each other, so only thread safe components that don't access each other
+  // share one
+  std::vector<std::vector<size_t>> _cachedUpdateBatches;
+
+  DependencyManagedUpdateSettings _updateSettings;
+
+  // one per entry of _cachedUpdateOrder
+  std::vector<ComponentUpdateTime> _updateTimes;
+
+  // The component being updated on this thread, while checking for undeclared accesses
+  struct UpdatingComponent {
+    EnumType id;
+    const DependentComponents* accessibleComps;
+    DependencyManagedEntity<EnumType>* entity;
+  };
+  static thread_local const UpdatingComponent* sUpdatingComponent;
+
+  // guarded by GetUndeclaredAccessMutex, since components in the same batch may record them at the same time
+  std::set<std::pair<EnumType, EnumType>> _undeclaredAccesses;
+
   using OrderedDependentVector = std::vector<ComponentPtrWrapper>;
 
 
@@ -135,8 +197,34 @@ private:
 
   // Create a component map based on the set of desired components passed in
   DependentComponents BuildDependentComponentsMap(std::set<EnumType>&& desiredComps);
+
+  // Split _cachedUpdateOrder into _cachedUpdateBatches
+  void BuildUpdateBatches();
+
+  // Update the component at the given index of _cachedUpdateOrder
+  void UpdateComponent(size_t index);
+
+  // Record the access if the component being updated on this thread (if any) didn't declare it
+  static void CheckAccess(EnumType enumID) {
+    if (sUpdatingComponent != nullptr) {
+      RecordAccess(*sUpdatingComponent, enumID);
+    }
+  }
+  static void RecordAccess(const UpdatingComponent& updatingComp, EnumType enumID);
+
+  static std::mutex& GetUndeclaredAccessMutex() {
+    static std::mutex mutex;
+    return mutex;
+  }
 };
 
+template<typename EnumType>
+thread_local const typename DependencyManagedEntity<EnumType>::UpdatingComponent*
+  DependencyManagedEntity<EnumType>::sUpdatingComponent = nullptr;
+
+template<typename EnumType>
+constexpr uint32_t DependencyManagedEntity<EnumType>::kNumRecentUpdateTimes;
+
 ////////
 // Templated Function Definitions
 ////////
@@ -314,11 +402,149 @@ void DependencyManagedEntity<EnumType>::UpdateComponents()
       DependentComponents comps = BuildDependentComponentsMap(std::move(componentNames));
       _cachedUpdateOrder.push_back(std::make_pair(ptrWrapper, std::move(comps)));
     }
+    BuildUpdateBatches();
+
+    for (const auto& entry: _cachedUpdateOrder) {
+      EnumType type;
+      entry.first._ptr->GetTypeDependent(type);
+      _updateTimes.emplace_back(type);
+    }
   }
   // Update components;
-  for (auto& entry: _cachedUpdateOrder) {
+  Util::WorkStealingPool* pool = _updateSettings.pool;
+  if (pool == nullptr) {
+    for (size_t index = 0; index < _cachedUpdateOrder.size(); ++index) {
+      UpdateComponent(index);
+    }
+    return;
+  }
+
+  // Batches are in update order, so components are updated in the same order as without a pool, except that the
+  // ones in a batch run at the same time
+  for (const auto& batch: _cachedUpdateBatches) {
+    if (batch.size() > 1) {
+      Util::WorkStealingPool::TaskGroup group;
+      for (const size_t index: batch) {
+        pool->Run(group, [this, index] { UpdateComponent(index); });
+      }
+      pool->Wait(group);
+    } else {
+      UpdateComponent(batch.front());
+    }
+  }
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<typename EnumType>
+void DependencyManagedEntity<EnumType>::BuildUpdateBatches()
+{
+  // A thread safe component joins the previous batch if that one is thread safe too and none of its components may
+  // access this one or be accessed by it. Update dependencies are accessible components, so a component is never
+  // batched with one it depends on. Additional accessible components aren't ordered, so they have to be checked both
+  // ways
+  _cachedUpdateBatches.clear();
+  bool isLastBatchThreadSafe = false;
+  for (size_t index = 0; index < _cachedUpdateOrder.size(); ++index) {
+    const auto& entry = _cachedUpdateOrder[index];
+    const bool isThreadSafe = entry.first._ptr->IsUpdateThreadSafe();
+    bool joinsLastBatch = isThreadSafe && isLastBatchThreadSafe;
+    if (joinsLastBatch) {
+      EnumType type;
+      entry.first._ptr->GetTypeDependent(type);
+      for (const size_t otherIndex: _cachedUpdateBatches.back()) {
+        const auto& otherEntry = _cachedUpdateOrder[otherIndex];
+        EnumType otherType;
+        otherEntry.first._ptr->GetTypeDependent(otherType);
+        const bool accessesOther = (entry.second._components.find(otherType) != entry.second._components.end());
+        const bool accessedByOther = (otherEntry.second._components.find(type) != otherEntry.second._components.end());
+        if (accessesOther || accessedByOther) {
+          joinsLastBatch = false;
+          break;
+        }
+      }
+    }
+
+    if (joinsLastBatch) {
+      _cachedUpdateBatches.back().push_back(index);
+    } else {
+      _cachedUpdateBatches.push_back({index});
+      isLastBatchThreadSafe = isThreadSafe;
+    }
+  }
+
+  #if ANKI_PROFILE_DEPENDENCY_MANAGED_ENTITY
+  for (size_t i = 0; i < _cachedUpdateBatches.size(); ++i) {
+    LOG_CH_DEBUG("DependencyManagedEntity",
+                 "BuildUpdateBatches",
+                 "Batch %zu: %zu components",
+                 i,
+                 _cachedUpdateBatches[i].size());
+  }
+  #endif
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<typename EnumType>
+void DependencyManagedEntity<EnumType>::UpdateComponent(size_t index)
+{
+  using Clock = std::chrono::steady_clock;
+  auto& entry = _cachedUpdateOrder[index];
+  const bool timeUpdate = _updateSettings.timeUpdates;
+  const Clock::time_point start = timeUpdate ? Clock::now() : Clock::time_point();
+
+  if (_updateSettings.checkUndeclaredAccess) {
+    UpdatingComponent updatingComp;
+    entry.first._ptr->GetTypeDependent(updatingComp.id);
+    updatingComp.accessibleComps = &entry.second;
+    updatingComp.entity = this;
+
+    // nested entities of the same type would be updated from within this component's update
+    const UpdatingComponent* prevUpdatingComp = sUpdatingComponent;
+    sUpdatingComponent = &updatingComp;
     entry.first._ptr->UpdateDependent(entry.second);
+    sUpdatingComponent = prevUpdatingComp;
+  } else {
+    entry.first._ptr->UpdateDependent(entry.second);
+  }
+
+  if (timeUpdate) {
+    // each index is only ever updated by one thread at a time
+    auto& updateTime = _updateTimes[index];
+    updateTime.lastStart = start;
+    updateTime.lastDuration_ms = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    updateTime.recent_ms += updateTime.lastDuration_ms;
+  }
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<typename EnumType>
+void DependencyManagedEntity<EnumType>::RecordAccess(const UpdatingComponent& updatingComp, EnumType enumID)
+{
+  const auto& accessibleComps = updatingComp.accessibleComps->_components;
+  if ((enumID == updatingComp.id) || (accessibleComps.find(enumID) != accessibleComps.end())) {
+    return;
   }
+
+  std::lock_guard<std::mutex> lock(GetUndeclaredAccessMutex());
+  const bool isNewAccess = updatingComp.entity->_undeclaredAccesses.insert(std::make_pair(updatingComp.id, enumID)).second;
+  if (isNewAccess) {
+    LOG_WARNING("DependencyManagedEntity.UndeclaredAccess",
+                "%s accessed %s during its update without declaring it",
+                GetComponentStringForID<EnumType>(updatingComp.id).c_str(),
+                GetComponentStringForID<EnumType>(enumID).c_str());
+  }
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<typename EnumType>
+auto DependencyManagedEntity<EnumType>::GetUndeclaredAccesses() const -> std::set<std::pair<EnumType, EnumType>>
+{
+  std::lock_guard<std::mutex> lock(GetUndeclaredAccessMutex());
+  return _undeclaredAccesses;
 }
 
 
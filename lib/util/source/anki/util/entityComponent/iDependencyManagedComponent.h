@@ -86,6 +86,11 @@ public:
 
   virtual void UpdateDependent(const DependencyManagedEntity<EnumType>& dependentComps) {};
 
+  // Only override if UpdateDependent touches nothing but this component and the components it declares
+  // above - if the entity has an update pool, the component may then be updated on another thread at the
+  // same time as the thread safe components next to it in the update order
+  virtual bool IsUpdateThreadSafe() const { return false; }
+
   template<typename T>
   T& GetComponent() const {
     EnumType enumID = EnumType::Count;
@@ -0,0 +1,195 @@
+/**
+ * File: util/logging/binaryLogRecord.h
+ *
+ * Description: The part of binary logging that runs at each logging call site: encoding a message's arguments into
+ *              a record and handing it to gBinaryLogger. Kept apart from binaryLogger.h so that logging.h (and so
+ *              every file that logs) doesn't pull in BinaryLogger and its threading headers.
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#ifndef __Util_Logging_BinaryLogRecord_H_
+#define __Util_Logging_BinaryLogRecord_H_
+
+#include "util/logging/logtypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace Anki {
+namespace Util {
+
+class BinaryLogger;
+
+// One per logging call site, created the first time that site logs while binary logging is on. Records refer to the
+// site by ID, so channel, name and format are written to the log once rather than with every message.
+// channel, name and format must point to string literals.
+struct BinaryLogSite
+{
+  BinaryLogSite(LogLevel level, const char* channel, const char* name, const char* format);
+
+  const LogLevel    level;
+  const char* const channel;
+  const char* const name;
+  const char* const format;
+  const uint32_t    id;
+};
+
+namespace BinaryLogDetail {
+
+// Records are built on the logging thread's stack; longer string arguments are truncated to fit
+constexpr size_t kMaxRecordSize = 1024;
+
+// Record header: u16 size, u8 kind, u32 site ID, u64 time (ns since epoch), s32 tick count, u8 number of args
+constexpr size_t kMessageHeaderSize = 2 + 1 + 4 + 8 + 4 + 1;
+
+enum RecordKind : uint8_t {
+  kSiteRecord    = 1,
+  kMessageRecord = 2,
+  kDroppedRecord = 3,
+};
+
+enum class ArgType : uint8_t {
+  Int,
+  UInt,
+  Double,
+  String,
+  Pointer,
+};
+
+class RecordWriter
+{
+public:
+  RecordWriter(uint8_t* buffer, size_t capacity) : _buffer(buffer), _capacity(capacity), _size(kMessageHeaderSize) { }
+
+  // Header fields other than the number of args are filled in by BinaryLogger::Push
+  void SetNumArgs(uint8_t numArgs) { _buffer[kMessageHeaderSize - 1] = numArgs; }
+  size_t GetSize() const { return _size; }
+
+  void PutInt(ArgType type, uint8_t size, uint64_t value)
+  {
+    if (Reserve(1 + 1 + sizeof(value))) {
+      Put(static_cast<uint8_t>(type));
+      Put(size);
+      Put(value);
+    }
+  }
+
+  void PutDouble(double value)
+  {
+    if (Reserve(1 + sizeof(value))) {
+      Put(static_cast<uint8_t>(ArgType::Double));
+      Put(value);
+    }
+  }
+
+  void PutPointer(uint64_t value)
+  {
+    if (Reserve(1 + sizeof(value))) {
+      Put(static_cast<uint8_t>(ArgType::Pointer));
+      Put(value);
+    }
+  }
+
+  void PutString(const char* str)
+  {
+    if (str == nullptr) {
+      str = "(null)";
+    }
+    const size_t kOverhead = 1 + sizeof(uint16_t);
+    if (Reserve(kOverhead)) {
+      const size_t len = strnlen(str, _capacity - _size - kOverhead);
+      Put(static_cast<uint8_t>(ArgType::String));
+      Put(static_cast<uint16_t>(len));
+      memcpy(_buffer + _size, str, len);
+      _size += len;
+    }
+  }
+
+private:
+  // If an argument doesn't fit, it is left out and shows up as missing when formatted
+  bool Reserve(size_t size) const { return _size + size <= _capacity; }
+
+  template<typename T>
+  void Put(const T& value)
+  {
+    memcpy(_buffer + _size, &value, sizeof(value));
+    _size += sizeof(value);
+  }
+
+  uint8_t* _buffer;
+  size_t   _capacity;
+  size_t   _size;
+};
+
+// Encode overloads for everything printf-style formats take
+inline void Encode(RecordWriter& writer, const char* str) { writer.PutString(str); }
+inline void Encode(RecordWriter& writer, char* str) { writer.PutString(str); }
+inline void Encode(RecordWriter& writer, std::nullptr_t) { writer.PutPointer(0); }
+
+template<typename T>
+inline void Encode(RecordWriter& writer, T* ptr)
+{
+  writer.PutPointer(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)));
+}
+
+template<typename T>
+inline typename std::enable_if<std::is_integral<T>::value>::type Encode(RecordWriter& writer, T value)
+{
+  if (std::is_signed<T>::value) {
+    writer.PutInt(ArgType::Int, sizeof(T), static_cast<uint64_t>(static_cast<int64_t>(value)));
+  } else {
+    writer.PutInt(ArgType::UInt, sizeof(T), static_cast<uint64_t>(value));
+  }
+}
+
+template<typename T>
+inline typename std::enable_if<std::is_enum<T>::value>::type Encode(RecordWriter& writer, T value)
+{
+  writer.PutInt(ArgType::Int, sizeof(T), static_cast<uint64_t>(static_cast<int64_t>(value)));
+}
+
+template<typename T>
+inline typename std::enable_if<std::is_floating_point<T>::value>::type Encode(RecordWriter& writer, T value)
+{
+  writer.PutDouble(static_cast<double>(value));
+}
+
+// Copies a finished record into the calling thread's buffer in logger (defined in binaryLogger.cpp)
+void Push(BinaryLogger& logger, const BinaryLogSite& site, uint8_t* record, size_t size);
+
+template<typename... Args>
+void Log(BinaryLogger& logger, const BinaryLogSite& site, Args... args)
+{
+  uint8_t record[kMaxRecordSize];
+  RecordWriter writer(record, sizeof(record));
+  writer.SetNumArgs(sizeof...(Args));
+  using Expand = int[];
+  (void)Expand{0, (Encode(writer, args), 0)...};
+  Push(logger, site, record, writer.GetSize());
+}
+
+} // namespace BinaryLogDetail
+
+} // namespace Util
+} // namespace Anki
+
+
+//
+// Used by the info/debug logging macros in logging.h, which declares gBinaryLogger. Binary logging only applies to
+// call sites whose channel, name and format are compile time constants, since only those can be referred to by a
+// static site ID.
+//
+#define ANKI_BINARY_LOG_ACTIVE(channel, name, format) \
+  (::Anki::Util::gBinaryLogger != nullptr &&          \
+   __builtin_constant_p(channel) && __builtin_constant_p(name) && __builtin_constant_p(format))
+
+#define ANKI_BINARY_LOG(level, channel, name, format, ...) do { \
+  static const ::Anki::Util::BinaryLogSite ANKI_BINARY_LOG_site(level, channel, name, format); \
+  ::Anki::Util::BinaryLogDetail::Log(*::Anki::Util::gBinaryLogger, ANKI_BINARY_LOG_site, ##__VA_ARGS__); \
+} while(0)
+
+#endif // __Util_Logging_BinaryLogRecord_H_
@@ -0,0 +1,719 @@
+/**
+ * File: util/logging/binaryLogger.cpp
+ *
+ * Description: Low overhead mode for info/debug logging from tick threads. See binaryLogger.h
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "util/logging/binaryLogger.h"
+#include "util/logging/iLoggerProvider.h"
+#include "util/logging/iTickTimeProvider.h"
+#include "util/logging/logging.h"
+#include "util/logging/rollingFileLogger.h"
+#include "util/threading/threadPriority.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace Anki {
+namespace Util {
+
+BinaryLogger* gBinaryLogger = nullptr;
+
+namespace {
+
+// Each binary log file starts with this, followed by a site record for every site seen so far
+constexpr char     kFileMagic[] = {'A', 'N', 'K', 'I', 'B', 'L', 'O', 'G'};
+constexpr uint32_t kFileVersion = 1;
+constexpr size_t   kFileHeaderSize = sizeof(kFileMagic) + sizeof(kFileVersion);
+
+const char* const kFileExtension = ".blog";
+
+// Offsets of the message record header fields, see kMessageHeaderSize
+constexpr size_t kSizeOffset    = 0;
+constexpr size_t kKindOffset    = 2;
+constexpr size_t kSiteIdOffset  = 3;
+constexpr size_t kTimeOffset    = 7;
+constexpr size_t kTickOffset    = 15;
+constexpr size_t kNumArgsOffset = 19;
+
+// Longest channel, name or format stored in a site record
+constexpr size_t kMaxSiteStringLength = 4096;
+
+std::atomic<uint32_t> sNextInstanceId{0};
+
+// Every site registered by the logging macros, indexed by ID. Sites are never unregistered, since they're static.
+std::mutex& GetSitesMutex()
+{
+  static std::mutex sSitesMutex;
+  return sSitesMutex;
+}
+
+std::vector<const BinaryLogSite*>& GetSites()
+{
+  static std::vector<const BinaryLogSite*> sSites;
+  return sSites;
+}
+
+uint32_t RegisterSite(const BinaryLogSite* site)
+{
+  std::lock_guard<std::mutex> lock(GetSitesMutex());
+  auto& sites = GetSites();
+  sites.push_back(site);
+  return static_cast<uint32_t>(sites.size() - 1);
+}
+
+// Appends the sites registered after the ones already in sites
+void GetNewSites(std::vector<const BinaryLogSite*>& sites)
+{
+  std::lock_guard<std::mutex> lock(GetSitesMutex());
+  const auto& allSites = GetSites();
+  sites.insert(sites.end(), allSites.begin() + sites.size(), allSites.end());
+}
+
+size_t RoundUpToPowerOfTwo(size_t size)
+{
+  size_t result = 1;
+  while (result < size) {
+    result <<= 1;
+  }
+  return result;
+}
+
+uint64_t GetTime_ns()
+{
+  const auto sinceEpoch = std::chrono::system_clock::now().time_since_epoch();
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(sinceEpoch).count());
+}
+
+template<typename T>
+void Append(std::string& out, const T& value)
+{
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void AppendString(std::string& out, const char* str)
+{
+  const size_t len = strnlen(str, kMaxSiteStringLength);
+  Append(out, static_cast<uint16_t>(len));
+  out.append(str, len);
+}
+
+void AppendSiteRecord(std::string& out, const BinaryLogSite& site)
+{
+  const size_t start = out.size();
+  Append(out, static_cast<uint16_t>(0));
+  Append(out, static_cast<uint8_t>(BinaryLogDetail::kSiteRecord));
+  Append(out, site.id);
+  Append(out, static_cast<uint8_t>(site.level));
+  AppendString(out, site.channel);
+  AppendString(out, site.name);
+  AppendString(out, site.format);
+  const uint16_t size = static_cast<uint16_t>(out.size() - start);
+  memcpy(&out[start + kSizeOffset], &size, sizeof(size));
+}
+
+void AppendDroppedRecord(std::string& out, uint32_t numDropped, uint64_t time_ns)
+{
+  const uint16_t size = sizeof(uint16_t) + sizeof(uint8_t) + sizeof(numDropped) + sizeof(time_ns);
+  Append(out, size);
+  Append(out, static_cast<uint8_t>(BinaryLogDetail::kDroppedRecord));
+  Append(out, numDropped);
+  Append(out, time_ns);
+}
+
+// Bounds checked reads from a single record
+class RecordReader
+{
+public:
+  RecordReader(const uint8_t* data, size_t size, size_t pos) : _data(data), _size(size), _pos(pos) { }
+
+  bool AtEnd() const { return _pos >= _size; }
+
+  template<typename T>
+  bool Get(T& value)
+  {
+    if (_size - _pos < sizeof(value)) {
+      return false;
+    }
+    memcpy(&value, _data + _pos, sizeof(value));
+    _pos += sizeof(value);
+    return true;
+  }
+
+  bool GetString(std::string& str)
+  {
+    uint16_t len = 0;
+    if (!Get(len) || (_size - _pos < len)) {
+      return false;
+    }
+    str.assign(reinterpret_cast<const char*>(_data + _pos), len);
+    _pos += len;
+    return true;
+  }
+
+private:
+  const uint8_t* _data;
+  size_t         _size;
+  size_t         _pos;
+};
+
+// Decodes the arguments following a message record header. Arguments that didn't fit in the record when it was
+// logged are simply absent.
+bool DecodeArgs(const uint8_t* record, size_t size, std::vector<BinaryLogArg>& args)
+{
+  args.clear();
+  RecordReader reader(record, size, BinaryLogDetail::kMessageHeaderSize);
+  const uint8_t numArgs = record[kNumArgsOffset];
+  while (!reader.AtEnd() && (args.size() < numArgs)) {
+    uint8_t type = 0;
+    if (!reader.Get(type)) {
+      return false;
+    }
+
+    args.emplace_back();
+    BinaryLogArg& arg = args.back();
+    arg.type = static_cast<BinaryLogArg::Type>(type);
+    bool ok = false;
+    switch (arg.type) {
+      case BinaryLogArg::Type::Int:
+        ok = reader.Get(arg.size) && reader.Get(arg.i);
+        break;
+      case BinaryLogArg::Type::UInt:
+        ok = reader.Get(arg.size) && reader.Get(arg.u);
+        break;
+      case BinaryLogArg::Type::Double:
+        ok = reader.Get(arg.d);
+        break;
+      case BinaryLogArg::Type::String:
+        ok = reader.GetString(arg.str);
+        break;
+      case BinaryLogArg::Type::Pointer:
+        ok = reader.Get(arg.u);
+        break;
+    }
+    if (!ok) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void PrependTickCount(std::string& text, int32_t tickCount)
+{
+  if (tickCount >= 0) {
+    char prefix[32];
+    snprintf(prefix, sizeof(prefix), "(tc%04d) ", tickCount);
+    text.insert(0, prefix);
+  }
+}
+
+// The format specs passed in are built by Format() from the message's format string, which is a literal at the
+// logging call site and was checked against its arguments by the compiler there
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+#pragma GCC diagnostic ignored "-Wformat-security"
+template<typename T>
+void AppendFormatted(std::string& out, const std::string& spec, T value)
+{
+  char buffer[256];
+  const int len = snprintf(buffer, sizeof(buffer), spec.c_str(), value);
+  if (len < 0) {
+    return;
+  }
+  if (static_cast<size_t>(len) < sizeof(buffer)) {
+    out.append(buffer, len);
+  } else {
+    const size_t start = out.size();
+    out.resize(start + len + 1);
+    snprintf(&out[start], len + 1, spec.c_str(), value);
+    out.resize(start + len);
+  }
+}
+#pragma GCC diagnostic pop
+
+int64_t GetSigned(const BinaryLogArg& arg)
+{
+  switch (arg.type) {
+    case BinaryLogArg::Type::Int:    return arg.i;
+    case BinaryLogArg::Type::Double: return static_cast<int64_t>(arg.d);
+    default:                         return static_cast<int64_t>(arg.u);
+  }
+}
+
+uint64_t GetUnsigned(const BinaryLogArg& arg)
+{
+  uint64_t value = 0;
+  switch (arg.type) {
+    case BinaryLogArg::Type::Int:    value = static_cast<uint64_t>(arg.i); break;
+    case BinaryLogArg::Type::Double: value = static_cast<uint64_t>(arg.d); break;
+    default:                         value = arg.u; break;
+  }
+  // Sign extended negative values print as their original width, like printf would
+  if ((arg.size > 0) && (arg.size < sizeof(value))) {
+    value &= (uint64_t(1) << (8 * arg.size)) - 1;
+  }
+  return value;
+}
+
+double GetDouble(const BinaryLogArg& arg)
+{
+  switch (arg.type) {
+    case BinaryLogArg::Type::Double: return arg.d;
+    case BinaryLogArg::Type::Int:    return static_cast<double>(arg.i);
+    default:                         return static_cast<double>(arg.u);
+  }
+}
+
+} // namespace
+
+
+BinaryLogSite::BinaryLogSite(LogLevel level, const char* channel, const char* name, const char* format)
+: level(level)
+, channel(channel)
+, name(name)
+, format(format)
+, id(RegisterSite(this))
+{
+}
+
+
+// Lock-free byte ring written by one logging thread and read by the drainer
+struct BinaryLogger::ThreadBuffer
+{
+  explicit ThreadBuffer(size_t capacity) : data(capacity), mask(capacity - 1) { }
+
+  bool Write(const uint8_t* record, size_t size)
+  {
+    const uint64_t writePos = writeIndex.load(std::memory_order_relaxed);
+    const uint64_t readPos = readIndex.load(std::memory_order_acquire);
+    if (data.size() - (writePos - readPos) < size) {
+      return false;
+    }
+    const size_t start = writePos & mask;
+    const size_t firstPart = std::min(size, data.size() - start);
+    memcpy(&data[start], record, firstPart);
+    memcpy(&data[0], record + firstPart, size - firstPart);
+    writeIndex.store(writePos + size, std::memory_order_release);
+    return true;
+  }
+
+  // Appends everything written so far to out
+  void Read(std::string& out)
+  {
+    const uint64_t readPos = readIndex.load(std::memory_order_relaxed);
+    const uint64_t writePos = writeIndex.load(std::memory_order_acquire);
+    const size_t size = static_cast<size_t>(writePos - readPos);
+    const size_t start = readPos & mask;
+    const size_t firstPart = std::min(size, data.size() - start);
+    out.append(reinterpret_cast<const char*>(&data[start]), firstPart);
+    out.append(reinterpret_cast<const char*>(&data[0]), size - firstPart);
+    readIndex.store(writePos, std::memory_order_release);
+  }
+
+  std::vector<uint8_t>  data;
+  const size_t          mask;
+  std::atomic<uint64_t> writeIndex{0};
+  std::atomic<uint64_t> readIndex{0};
+  std::atomic<uint32_t> numDropped{0};
+};
+
+
+BinaryLogger::BinaryLogger(const std::string& baseDirectory,
+                           bool forwardToLoggerProvider,
+                           size_t threadBufferSize,
+                           uint32_t drainPeriod_ms)
+: _instanceId(++sNextInstanceId)
+, _threadBufferSize(RoundUpToPowerOfTwo(std::max(threadBufferSize, BinaryLogDetail::kMaxRecordSize)))
+, _drainPeriod_ms(drainPeriod_ms)
+, _forwardToLoggerProvider(forwardToLoggerProvider)
+, _fileLogger(new RollingFileLogger(nullptr, baseDirectory, kFileExtension))
+{
+  // Every file has to be readable on its own, so each one starts with all the sites written so far
+  _fileLogger->SetFileHeaderFunc([this] { return GetFileHeader(); });
+
+  _drainerThread = std::thread(&BinaryLogger::RunDrainer, this);
+}
+
+BinaryLogger::~BinaryLogger()
+{
+  if (gBinaryLogger == this) {
+    gBinaryLogger = nullptr;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_drainerMutex);
+    _stopDrainer = true;
+  }
+  _drainerCondition.notify_one();
+  if (_drainerThread.joinable()) {
+    _drainerThread.join();
+  }
+
+  Flush();
+}
+
+void BinaryLogDetail::Push(BinaryLogger& logger, const BinaryLogSite& site, uint8_t* record, size_t size)
+{
+  logger.Push(site, record, size);
+}
+
+void BinaryLogger::Push(const BinaryLogSite& site, uint8_t* record, size_t size)
+{
+  const uint16_t recordSize = static_cast<uint16_t>(size);
+  const uint8_t kind = BinaryLogDetail::kMessageRecord;
+  const uint64_t time_ns = GetTime_ns();
+  const int32_t tickCount = (gTickTimeProvider != nullptr) ? static_cast<int32_t>(gTickTimeProvider->GetTickCount()) : -1;
+  memcpy(record + kSizeOffset, &recordSize, sizeof(recordSize));
+  memcpy(record + kKindOffset, &kind, sizeof(kind));
+  memcpy(record + kSiteIdOffset, &site.id, sizeof(site.id));
+  memcpy(record + kTimeOffset, &time_ns, sizeof(time_ns));
+  memcpy(record + kTickOffset, &tickCount, sizeof(tickCount));
+
+  ThreadBuffer* buffer = GetThreadBuffer();
+  if (!buffer->Write(record, size)) {
+    buffer->numDropped.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+BinaryLogger::ThreadBuffer* BinaryLogger::GetThreadBuffer()
+{
+  // The instance ID makes sure a thread that outlives one logger gets a new buffer from the next
+  static thread_local uint32_t tInstanceId = 0;
+  static thread_local std::shared_ptr<ThreadBuffer> tBuffer;
+  if (tInstanceId != _instanceId) {
+    tBuffer = std::make_shared<ThreadBuffer>(_threadBufferSize);
+    tInstanceId = _instanceId;
+    std::lock_guard<std::mutex> lock(_threadBuffersMutex);
+    _threadBuffers.push_back(tBuffer);
+  }
+  return tBuffer.get();
+}
+
+void BinaryLogger::RunDrainer()
+{
+  Anki::Util::SetThreadName(pthread_self(), "BinaryLogger");
+
+  std::unique_lock<std::mutex> lock(_drainerMutex);
+  while (!_stopDrainer) {
+    _drainerCondition.wait_for(lock, std::chrono::milliseconds(_drainPeriod_ms));
+    if (!_stopDrainer) {
+      lock.unlock();
+      Drain();
+      lock.lock();
+    }
+  }
+}
+
+void BinaryLogger::Flush()
+{
+  Drain();
+  _fileLogger->Flush();
+}
+
+void BinaryLogger::Drain()
+{
+  std::lock_guard<std::mutex> drainLock(_drainMutex);
+
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  {
+    std::lock_guard<std::mutex> lock(_threadBuffersMutex);
+    buffers = _threadBuffers;
+    // A buffer referenced only by _threadBuffers and the copy belongs to a thread that has exited. It still gets
+    // drained one last time below.
+    _threadBuffers.erase(std::remove_if(_threadBuffers.begin(), _threadBuffers.end(),
+                                        [](const std::shared_ptr<ThreadBuffer>& buffer) {
+                                          return buffer.use_count() == 2;
+                                        }),
+                         _threadBuffers.end());
+  }
+
+  _drained.clear();
+  uint32_t numDropped = 0;
+  for (const auto& buffer : buffers) {
+    buffer->Read(_drained);
+    numDropped += buffer->numDropped.exchange(0, std::memory_order_relaxed);
+  }
+
+  // Each thread's messages are in order already; interleave them by time
+  _drainedMessages.clear();
+  const uint8_t* drainedData = reinterpret_cast<const uint8_t*>(_drained.data());
+  for (size_t offset = 0; offset < _drained.size(); ) {
+    uint16_t size = 0;
+    uint64_t time_ns = 0;
+    memcpy(&size, drainedData + offset + kSizeOffset, sizeof(size));
+    memcpy(&time_ns, drainedData + offset + kTimeOffset, sizeof(time_ns));
+    _drainedMessages.emplace_back(time_ns, offset);
+    offset += size;
+  }
+  std::stable_sort(_drainedMessages.begin(), _drainedMessages.end(),
+                   [](const std::pair<uint64_t, size_t>& lhs, const std::pair<uint64_t, size_t>& rhs) {
+                     return lhs.first < rhs.first;
+                   });
+
+  // Sites are registered before their first message is pushed, so every site referenced above is known by now
+  const size_t numSitesWritten = _sites.size();
+  GetNewSites(_sites);
+
+  if (_drainedMessages.empty() && (numDropped == 0) && (numSitesWritten == _sites.size())) {
+    return;
+  }
+
+  std::string batch;
+  batch.reserve(_drained.size() + 64);
+  for (size_t i = numSitesWritten; i < _sites.size(); ++i) {
+    AppendSiteRecord(batch, *_sites[i]);
+  }
+
+  for (const auto& message : _drainedMessages) {
+    const uint8_t* record = drainedData + message.second;
+    uint16_t size = 0;
+    memcpy(&size, record + kSizeOffset, sizeof(size));
+    batch.append(reinterpret_cast<const char*>(record), size);
+    if (_forwardToLoggerProvider) {
+      ForwardMessage(record, size);
+    }
+  }
+
+  if (numDropped > 0) {
+    AppendDroppedRecord(batch, numDropped, GetTime_ns());
+    ILoggerProvider* loggerProvider = gLoggerProvider;
+    if (loggerProvider != nullptr) {
+      const std::string text = std::to_string(numDropped) + " messages dropped, thread buffers were full";
+      loggerProvider->PrintLogW("BinaryLogger.DroppedMessages", {}, text.c_str());
+    }
+  }
+
+  _fileLogger->Write(std::move(batch));
+}
+
+void BinaryLogger::ForwardMessage(const uint8_t* record, size_t size)
+{
+  ILoggerProvider* loggerProvider = gLoggerProvider;
+  if (loggerProvider == nullptr) {
+    return;
+  }
+
+  uint32_t siteId = 0;
+  int32_t tickCount = -1;
+  memcpy(&siteId, record + kSiteIdOffset, sizeof(siteId));
+  memcpy(&tickCount, record + kTickOffset, sizeof(tickCount));
+  if (siteId >= _sites.size()) {
+    return;
+  }
+  const BinaryLogSite& site = *_sites[siteId];
+
+  DecodeArgs(record, size, _args);
+  std::string text = Format(site.format, _args);
+  PrependTickCount(text, tickCount);
+
+  if (site.level == LOG_LEVEL_DEBUG) {
+    loggerProvider->PrintChanneledLogD(site.channel, site.name, {}, text.c_str());
+  } else {
+    loggerProvider->PrintChanneledLogI(site.channel, site.name, {}, text.c_str());
+  }
+}
+
+std::string BinaryLogger::GetFileHeader() const
+{
+  // Called by _fileLogger from Drain, with _drainMutex held
+  std::string header(kFileMagic, sizeof(kFileMagic));
+  Append(header, kFileVersion);
+  for (const BinaryLogSite* site : _sites) {
+    AppendSiteRecord(header, *site);
+  }
+  return header;
+}
+
+std::string BinaryLogger::Format(const char* format, const std::vector<BinaryLogArg>& args)
+{
+  std::string out;
+  size_t argIndex = 0;
+  auto nextArg = [&args, &argIndex]() -> const BinaryLogArg* {
+    return (argIndex < args.size()) ? &args[argIndex++] : nullptr;
+  };
+
+  const char* p = format;
+  while (*p != '\0') {
+    if (*p != '%') {
+      out += *p++;
+      continue;
+    }
+
+    const char* specStart = p++;
+    if (*p == '%') {
+      out += '%';
+      ++p;
+      continue;
+    }
+
+    // Rebuild the conversion spec with the length modifier replaced to match how the argument was stored
+    std::string spec = "%";
+    while ((*p != '\0') && (strchr("-+ #0", *p) != nullptr)) {
+      spec += *p++;
+    }
+    auto appendNumber = [&p, &spec, &nextArg]() {
+      if (*p == '*') {
+        ++p;
+        const BinaryLogArg* arg = nextArg();
+        spec += std::to_string((arg != nullptr) ? GetSigned(*arg) : 0);
+      } else {
+        while ((*p >= '0') && (*p <= '9')) {
+          spec += *p++;
+        }
+      }
+    };
+    appendNumber(); // Width
+    if (*p == '.') {
+      spec += *p++;
+      appendNumber(); // Precision
+    }
+    while ((*p != '\0') && (strchr("hljztLq", *p) != nullptr)) {
+      ++p;
+    }
+
+    const char conversion = *p;
+    if (conversion == '\0') {
+      out.append(specStart);
+      break;
+    }
+    ++p;
+
+    if (strchr("diuoxXcfFeEgGaAspn", conversion) == nullptr) {
+      out.append(specStart, p - specStart);
+      continue;
+    }
+
+    const BinaryLogArg* arg = nextArg();
+    if (conversion == 'n') {
+      continue;
+    }
+    if (arg == nullptr) {
+      out += "<missing>";
+      continue;
+    }
+
+    switch (conversion) {
+      case 'd':
+      case 'i':
+        AppendFormatted(out, spec + "lld", static_cast<long long>(GetSigned(*arg)));
+        break;
+      case 'u':
+      case 'o':
+      case 'x':
+      case 'X':
+        AppendFormatted(out, spec + "ll" + conversion, static_cast<unsigned long long>(GetUnsigned(*arg)));
+        break;
+      case 'c':
+        AppendFormatted(out, spec + conversion, static_cast<int>(GetSigned(*arg)));
+        break;
+      case 's':
+        AppendFormatted(out, spec + conversion, (arg->type == BinaryLogArg::Type::String) ? arg->str.c_str() : "<bad arg>");
+        break;
+      case 'p':
+        AppendFormatted(out, spec + conversion, reinterpret_cast<void*>(static_cast<uintptr_t>(arg->u)));
+        break;
+      default:
+        AppendFormatted(out, spec + conversion, GetDouble(*arg));
+        break;
+    }
+  }
+
+  return out;
+}
+
+
+bool BinaryLogReader::Read(const uint8_t* data, size_t size, const MessageFunc& messageFunc)
+{
+  size_t pos = 0;
+  while (pos < size) {
+    // Files can be concatenated, so there may be a file header anywhere
+    if ((size - pos >= kFileHeaderSize) && (memcmp(data + pos, kFileMagic, sizeof(kFileMagic)) == 0)) {
+      uint32_t version = 0;
+      memcpy(&version, data + pos + sizeof(kFileMagic), sizeof(version));
+      if (version != kFileVersion) {
+        return false;
+      }
+      pos += kFileHeaderSize;
+      continue;
+    }
+
+    uint16_t recordSize = 0;
+    uint8_t kind = 0;
+    if (size - pos < sizeof(recordSize) + sizeof(kind)) {
+      return false;
+    }
+    memcpy(&recordSize, data + pos + kSizeOffset, sizeof(recordSize));
+    memcpy(&kind, data + pos + kKindOffset, sizeof(kind));
+    if ((recordSize < sizeof(recordSize) + sizeof(kind)) || (recordSize > size - pos)) {
+      return false;
+    }
+
+    const uint8_t* record = data + pos;
+    RecordReader reader(record, recordSize, kKindOffset + sizeof(kind));
+    switch (kind) {
+      case BinaryLogDetail::kSiteRecord:
+      {
+        uint32_t id = 0;
+        uint8_t level = 0;
+        Site site;
+        if (!reader.Get(id) || !reader.Get(level) ||
+            !reader.GetString(site.channel) || !reader.GetString(site.name) || !reader.GetString(site.format)) {
+          return false;
+        }
+        site.level = static_cast<LogLevel>(level);
+        _sites[id] = std::move(site);
+        break;
+      }
+
+      case BinaryLogDetail::kMessageRecord:
+      {
+        if (recordSize < BinaryLogDetail::kMessageHeaderSize) {
+          return false;
+        }
+        uint32_t siteId = 0;
+        uint64_t time_ns = 0;
+        int32_t tickCount = -1;
+        memcpy(&siteId, record + kSiteIdOffset, sizeof(siteId));
+        memcpy(&time_ns, record + kTimeOffset, sizeof(time_ns));
+        memcpy(&tickCount, record + kTickOffset, sizeof(tickCount));
+
+        const auto siteIt = _sites.find(siteId);
+        if ((siteIt == _sites.end()) || !DecodeArgs(record, recordSize, _args)) {
+          return false;
+        }
+        const Site& site = siteIt->second;
+        std::string text = BinaryLogger::Format(site.format.c_str(), _args);
+        PrependTickCount(text, tickCount);
+        messageFunc(Message{site.level, site.channel, site.name, std::move(text), time_ns, tickCount});
+        break;
+      }
+
+      case BinaryLogDetail::kDroppedRecord:
+      {
+        static const std::string kChannel = "BinaryLogger";
+        static const std::string kName = "BinaryLogger.DroppedMessages";
+        uint32_t numDropped = 0;
+        uint64_t time_ns = 0;
+        if (!reader.Get(numDropped) || !reader.Get(time_ns)) {
+          return false;
+        }
+        std::string text = std::to_string(numDropped) + " messages dropped, thread buffers were full";
+        messageFunc(Message{LOG_LEVEL_WARN, kChannel, kName, std::move(text), time_ns, -1});
+        break;
+      }
+
+      default:
+        return false;
+    }
+
+    pos += recordSize;
+  }
+  return true;
+}
+
+} // namespace Util
+} // namespace Anki
@@ -0,0 +1,158 @@
+/**
+ * File: util/logging/binaryLogger.h
+ *
+ * Description: Low overhead mode for info/debug logging from tick threads. While gBinaryLogger is set, the logging
+ *              macros record a static format ID plus the raw arguments into a lock-free ring buffer owned by the
+ *              calling thread, instead of formatting the message and going through gLoggerProvider. A background
+ *              thread drains the buffers, writes the binary records to a RollingFileLogger and, if asked to, formats
+ *              them and forwards them to gLoggerProvider. vic-log-decode turns the binary files back into text.
+ *
+ *              Errors and warnings are never deferred, so they still reach the log right away (e.g. before a crash).
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#ifndef __Util_Logging_BinaryLogger_H_
+#define __Util_Logging_BinaryLogger_H_
+
+#include "util/helpers/noncopyable.h"
+#include "util/logging/binaryLogRecord.h"
+#include "util/logging/logtypes.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Anki {
+namespace Util {
+
+class RollingFileLogger;
+
+// Logging macros use this when set. Owned by whoever created it (vic-engine / vic-anim main).
+extern BinaryLogger* gBinaryLogger;
+
+// An argument as read back from a binary record
+struct BinaryLogArg
+{
+  using Type = BinaryLogDetail::ArgType;
+
+  Type        type = Type::Int;
+  uint8_t     size = 0; // sizeof the original argument, for Int and UInt
+  int64_t     i    = 0;
+  uint64_t    u    = 0;
+  double      d    = 0.0;
+  std::string str;
+};
+
+
+class BinaryLogger : noncopyable
+{
+public:
+  // Each thread that logs gets a buffer of this many bytes (rounded up to a power of two). Messages logged while its
+  // buffer is full are dropped and counted, rather than blocking the thread.
+  static constexpr size_t   kDefaultThreadBufferSize = 64 * 1024;
+  static constexpr uint32_t kDefaultDrainPeriod_ms   = 50;
+
+  // Binary logs are written to files in baseDirectory. If forwardToLoggerProvider is true, drained messages are also
+  // formatted and passed on to gLoggerProvider, so they still show up in the regular log (with some delay).
+  BinaryLogger(const std::string& baseDirectory,
+               bool forwardToLoggerProvider,
+               size_t threadBufferSize = kDefaultThreadBufferSize,
+               uint32_t drainPeriod_ms = kDefaultDrainPeriod_ms);
+  ~BinaryLogger();
+
+  // What the logging macros end up calling
+  template<typename... Args>
+  void Log(const BinaryLogSite& site, Args... args)
+  {
+    BinaryLogDetail::Log(*this, site, args...);
+  }
+
+  // Drain every thread's buffer and flush the file. Blocks until done; can be called from any thread.
+  void Flush();
+
+  // printf-style formatting of a message from its format string and decoded arguments
+  static std::string Format(const char* format, const std::vector<BinaryLogArg>& args);
+
+private:
+  struct ThreadBuffer;
+
+  friend void BinaryLogDetail::Push(BinaryLogger& logger, const BinaryLogSite& site, uint8_t* record, size_t size);
+  void Push(const BinaryLogSite& site, uint8_t* record, size_t size);
+  ThreadBuffer* GetThreadBuffer();
+
+  void RunDrainer();
+  void Drain();
+  void ForwardMessage(const uint8_t* record, size_t size);
+  std::string GetFileHeader() const;
+
+  const uint32_t _instanceId;
+  const size_t   _threadBufferSize;
+  const uint32_t _drainPeriod_ms;
+  const bool     _forwardToLoggerProvider;
+
+  // Shared with the thread_local reference of the thread that logs into each, so exited threads can be detected
+  std::mutex                                 _threadBuffersMutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> _threadBuffers;
+
+  // Only the drainer thread (or Flush) reads the buffers and writes the file, one at a time
+  std::mutex                         _drainMutex;
+  std::unique_ptr<RollingFileLogger> _fileLogger;
+  std::vector<const BinaryLogSite*>  _sites; // Copy of the sites written to the log so far
+  std::string                        _drained;
+  std::vector<std::pair<uint64_t, size_t>> _drainedMessages; // (time, offset into _drained)
+  std::vector<BinaryLogArg>          _args;
+
+  std::mutex              _drainerMutex;
+  std::condition_variable _drainerCondition;
+  bool                    _stopDrainer = false;
+  std::thread             _drainerThread;
+};
+
+
+// Reads binary log files back, for vic-log-decode
+class BinaryLogReader
+{
+public:
+  struct Message
+  {
+    LogLevel           level;
+    const std::string& channel;
+    const std::string& name;
+    std::string        text;
+    uint64_t           time_ns;   // Since the epoch, when the message was logged
+    int32_t            tickCount; // -1 if there was no tick time provider
+  };
+
+  using MessageFunc = std::function<void(const Message&)>;
+
+  // Decodes the contents of a binary log file (or several concatenated), calling messageFunc for each message in the
+  // order they were written. Returns false if the data is malformed, after calling messageFunc for everything before.
+  bool Read(const uint8_t* data, size_t size, const MessageFunc& messageFunc);
+
+private:
+  struct Site
+  {
+    LogLevel    level;
+    std::string channel;
+    std::string name;
+    std::string format;
+  };
+
+  std::unordered_map<uint32_t, Site> _sites;
+  std::vector<BinaryLogArg>          _args;
+};
+
+} // namespace Util
+} // namespace Anki
+
+#endif // __Util_Logging_BinaryLogger_H_
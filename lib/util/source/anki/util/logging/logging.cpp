@@ -18,6 +18,7 @@
  **/
 
 #include "util/logging/logging.h"
+#include "util/logging/binaryLogger.h"
 #include "util/logging/iTickTimeProvider.h"
 #include "util/logging/iLoggerProvider.h"
 #include "util/logging/channelFilter.h"
@@ -433,6 +434,10 @@ bool sVerifyFailedReturnFalse(const char* file, int line, const char* name, cons
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void sLogFlush()
 {
+  // Deferred messages go to gLoggerProvider (if forwarded) and the binary log, so they come first
+  if (nullptr != gBinaryLogger) {
+    gBinaryLogger->Flush();
+  }
   if (nullptr == gLoggerProvider) {
     return;
   }
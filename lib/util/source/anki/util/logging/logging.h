@@ -22,6 +22,7 @@
 #define __Util_Logging_Logging_H_
 
 #include "util/global/globalDefinitions.h"
+#include "util/logging/binaryLogRecord.h"
 #include "util/logging/callstack.h"
 #include "util/logging/logtypes.h"
 
@@ -54,12 +55,14 @@ class ITickTimeProvider;
 class ILoggerProvider;
 class ChannelFilter;
 class IEventProvider;
+class BinaryLogger;
 
 std::string HexDump(const void *value, const size_t len, char delimiter);
 
 extern ITickTimeProvider* gTickTimeProvider;
 extern ILoggerProvider* gLoggerProvider;
 extern IEventProvider* gEventProvider;
+extern BinaryLogger* gBinaryLogger;
 
 // Accessors for global error flag for unit testing
 void sSetErrG();            // Sets errG to true
@@ -221,6 +224,8 @@ __attribute__((noreturn)) void sAbort();
     snprintf(PRINT_LOG_VAR_logString, MAX_LOG_STRING_LEN, format, ##__VA_ARGS__); \
     tracelog(TRACE_INFO, "%s %s", name, PRINT_LOG_VAR_logString);       \
     ::Anki::Util::sChanneledInfoF(name, name, {}, "%s", PRINT_LOG_VAR_logString); \
+  } else if(ANKI_BINARY_LOG_ACTIVE(name, name, format)) { \
+    ANKI_BINARY_LOG(::Anki::Util::LOG_LEVEL_INFO, name, name, format, ##__VA_ARGS__); \
   } else { \
     ::Anki::Util::sChanneledInfoF(name, name, {}, format, ##__VA_ARGS__); \
   } \
@@ -234,6 +239,8 @@ __attribute__((noreturn)) void sAbort();
     snprintf(PRINT_LOG_VAR_logString, MAX_LOG_STRING_LEN, format, ##__VA_ARGS__); \
     tracelog(TRACE_DEBUG, "%s %s", name, PRINT_LOG_VAR_logString); \
     ::Anki::Util::sChanneledDebugF(name, name, {}, "%s", PRINT_LOG_VAR_logString); \
+  } else if(ANKI_BINARY_LOG_ACTIVE(name, name, format)) { \
+    ANKI_BINARY_LOG(::Anki::Util::LOG_LEVEL_DEBUG, name, name, format, ##__VA_ARGS__); \
   } else { \
     ::Anki::Util::sChanneledDebugF(name, name, {}, format, ##__VA_ARGS__); \
   } \
@@ -302,6 +309,8 @@ __attribute__((noreturn)) void sAbort();
     snprintf(PRINT_LOG_VAR_logString, MAX_LOG_STRING_LEN, format, ##__VA_ARGS__); \
     tracelog(TRACE_INFO, "%s %s %s", channel, name, PRINT_LOG_VAR_logString); \
     ::Anki::Util::sChanneledInfoF(channel, name, {}, "%s", PRINT_LOG_VAR_logString); \
+  } else if(ANKI_BINARY_LOG_ACTIVE(channel, name, format)) { \
+    ANKI_BINARY_LOG(::Anki::Util::LOG_LEVEL_INFO, channel, name, format, ##__VA_ARGS__); \
   } else { \
     ::Anki::Util::sChanneledInfoF(channel, name, {}, format, ##__VA_ARGS__); \
   } \
@@ -315,6 +324,8 @@ __attribute__((noreturn)) void sAbort();
     snprintf(PRINT_LOG_VAR_logString, MAX_LOG_STRING_LEN, format, ##__VA_ARGS__); \
     tracelog(TRACE_DEBUG, "%s %s %s", channel, name, PRINT_LOG_VAR_logString); \
     ::Anki::Util::sChanneledDebugF(channel, name, {}, "%s", PRINT_LOG_VAR_logString); \
+  } else if(ANKI_BINARY_LOG_ACTIVE(channel, name, format)) { \
+    ANKI_BINARY_LOG(::Anki::Util::LOG_LEVEL_DEBUG, channel, name, format, ##__VA_ARGS__); \
   } else { \
     ::Anki::Util::sChanneledDebugF(channel, name, {}, format, ##__VA_ARGS__); \
   } \
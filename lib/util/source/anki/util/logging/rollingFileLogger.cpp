@@ -81,6 +81,13 @@ void RollingFileLogger::WriteInternal(const std::string& message)
   {
     RollLogFile();
     _numBytesWritten = 0;
+
+    if (_fileHeaderFunc && _currentLogFileHandle.is_open())
+    {
+      const std::string header = _fileHeaderFunc();
+      _currentLogFileHandle << header;
+      _numBytesWritten += header.length();
+    }
   }
   
   assert(_currentLogFileHandle);
@@ -17,6 +17,7 @@
 
 #include <fstream>
 #include <cstdlib>
+#include <functional>
 #include <string>
 
 namespace Anki {
@@ -25,6 +26,7 @@ namespace Util {
 class RollingFileLogger : noncopyable {
 public:
   using ClockType = std::chrono::steady_clock;
+  using FileHeaderFunc = std::function<std::string()>;
 
   static constexpr std::size_t  kDefaultMaxFileSize = 1024 * 1024 * 20;
   static const char * const     kDefaultFileExtension;
@@ -37,6 +39,9 @@ public:
   
   void Write(std::string message);
   void Flush();
+
+  // If set, the string returned is written at the start of every new log file. Called on the thread doing the writes.
+  void SetFileHeaderFunc(FileHeaderFunc fileHeaderFunc) { _fileHeaderFunc = std::move(fileHeaderFunc); }
   
   static std::string GetDateTimeString(const ClockType::time_point& time);
   static time_t GetTimeT(const ClockType::time_point& time);
@@ -53,6 +58,7 @@ private:
   std::size_t       _maxFileSize;
   std::size_t       _numBytesWritten = 0;
   std::ofstream     _currentLogFileHandle;
+  FileHeaderFunc    _fileHeaderFunc;
   
   void WriteInternal(const std::string& message);
   void FlushInternal();
@@ -93,6 +93,8 @@ protected:
                                 const int dumpBufferOffset,
                                 const int lineIndex) = 0;
   void DumpFiles();
+  // Process specific breakdown of where tick time has recently gone (e.g. per component)
+  virtual void DumpTickBreakdown(std::string* resultStr) {}
   void DumpLine(const DumpType dumpType,
                 int dumpBufferOffset,
                 FILE* fd,
@@ -131,6 +133,7 @@ protected:
     DUMP_RESPONSE_STRING,
     DUMP_RESPONSE_CSV_SINCE,
     DUMP_FILES,
+    DUMP_TICK_BREAKDOWN,
     WAIT_SECONDS,
     WAIT_TICKS,
   } CommandType;
@@ -632,6 +632,11 @@ int PerfMetric::ParseCommands(std::string& queryString)
       PerfMetricCommand cmd(DUMP_FILES);
       cmds.push_back(cmd);
     }
+    else if (current == "dumptickbreakdown")
+    {
+      PerfMetricCommand cmd(DUMP_TICK_BREAKDOWN);
+      cmds.push_back(cmd);
+    }
     else
     {
       // Commands that have arguments:
@@ -728,6 +733,9 @@ void PerfMetric::ExecuteQueuedCommands(std::string* resultStr)
       case DUMP_FILES:
         DumpFiles();
         break;
+      case DUMP_TICK_BREAKDOWN:
+        DumpTickBreakdown(resultStr);
+        break;
       case WAIT_SECONDS:
         WaitSeconds(cmd._waitSeconds);
         break;
@@ -0,0 +1,77 @@
+/**
+ * File: recentPercentiles.cpp
+ *
+ * Description: keeps the last N samples so that percentiles (median, 90th, 99th, etc) of recent values can be
+ *              calculated on demand
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+
+#include "util/stats/recentPercentiles.h"
+#include "util/math/math.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace Anki {
+namespace Util {
+namespace Stats {
+
+
+RecentPercentiles::RecentPercentiles(uint32_t maxValuesToTrack)
+  : _nextIndex(0)
+  , _maxValuesToTrack(std::max(maxValuesToTrack, 1u))
+{
+  _values.reserve(_maxValuesToTrack);
+}
+
+
+void RecentPercentiles::Clear()
+{
+  _values.clear();
+  _nextIndex = 0;
+}
+
+
+void RecentPercentiles::AddStat(const float v)
+{
+  if (_values.size() < _maxValuesToTrack)
+  {
+    _values.push_back(v);
+  }
+  else
+  {
+    _values[_nextIndex] = v;
+  }
+  _nextIndex = (_nextIndex + 1) % _maxValuesToTrack;
+}
+
+
+float RecentPercentiles::GetPercentile(const float percentile) const
+{
+  if (_values.empty())
+  {
+    return 0.0f;
+  }
+
+  const float clampedPercentile = Util::Clamp(percentile, 0.0f, 1.0f);
+  const size_t index = (size_t)std::round(clampedPercentile * (float)(_values.size() - 1));
+
+  _partitioned = _values;
+  std::nth_element(_partitioned.begin(), _partitioned.begin() + index, _partitioned.end());
+  return _partitioned[index];
+}
+
+
+float RecentPercentiles::GetMax() const
+{
+  return _values.empty() ? 0.0f : *std::max_element(_values.begin(), _values.end());
+}
+
+
+} // end namespace Stats
+} // end namespace Util
+} // end namespace Anki
@@ -0,0 +1,65 @@
+/**
+ * File: recentPercentiles.h
+ *
+ * Description: keeps the last N samples so that percentiles (median, 90th, 99th, etc) of recent values can be
+ *              calculated on demand
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+
+#ifndef __Util_Stats_RecentPercentiles_H__
+#define __Util_Stats_RecentPercentiles_H__
+
+
+#include <stdint.h>
+#include <vector>
+
+
+namespace Anki {
+namespace Util {
+namespace Stats {
+
+class RecentPercentiles
+{
+public:
+
+  explicit RecentPercentiles(uint32_t maxValuesToTrack);
+
+  void Clear();
+
+  // Once maxValuesToTrack values have been added, each new one replaces the oldest
+  void AddStat(const float v);
+  RecentPercentiles& operator+=(const float v)
+  {
+    AddStat(v);
+    return *this;
+  }
+
+  // Value at the given percentile (0..1) of the tracked values: the one that would be at round(percentile * (num-1))
+  // if they were sorted. Returns 0 if there are no values. Runs in linear time, so call it sparingly
+  float GetPercentile(const float percentile) const;
+
+  float GetMedian() const { return GetPercentile(0.5f); }
+  float GetMax()    const;
+
+  uint32_t GetNum() const { return (uint32_t)_values.size(); }
+  uint32_t GetMaxValuesToTrack() const { return _maxValuesToTrack; }
+
+private:
+
+  // oldest value is at _nextIndex once full
+  std::vector<float>  _values;
+  uint32_t            _nextIndex;
+  uint32_t            _maxValuesToTrack;
+
+  // scratch space for GetPercentile, so that it doesn't reallocate every call
+  mutable std::vector<float> _partitioned;
+};
+
+} // end namespace Stats
+} // end namespace Util
+} // end namespace Anki
+
+#endif // __Util_Stats_RecentPercentiles_H__
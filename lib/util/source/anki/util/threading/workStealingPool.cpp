@@ -0,0 +1,177 @@
+/**
+ * File: workStealingPool.cpp
+ *
+ * Description: Fixed set of worker threads that run short tasks, each with its own queue. See header for details.
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "util/threading/workStealingPool.h"
+#include "util/threading/threadPriority.h"
+#include "util/logging/logging.h"
+
+#include <pthread.h>
+
+namespace Anki {
+namespace Util {
+
+namespace {
+// pool and queue owned by the worker running on this thread, if any
+thread_local const WorkStealingPool* sWorkerPool = nullptr;
+thread_local size_t sWorkerQueueIndex = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+WorkStealingPool::WorkStealingPool(size_t numThreads, const std::string& name)
+: _numQueued(0)
+{
+  for (size_t i = 0; i <= numThreads; ++i) {
+    _queues.emplace_back(new TaskQueue());
+  }
+
+  _threads.reserve(numThreads);
+  for (size_t i = 0; i < numThreads; ++i) {
+    _threads.emplace_back(&WorkStealingPool::WorkerLoop, this, i, name + std::to_string(i));
+  }
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+WorkStealingPool::~WorkStealingPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(_sleepMutex);
+    _stop = true;
+  }
+  _sleepCondition.notify_all();
+
+  for (auto& thread : _threads) {
+    thread.join();
+  }
+
+  // without workers, nobody else would run what's left
+  QueuedTask queuedTask;
+  while (FindTask(GetQueueIndexForThisThread(), queuedTask)) {
+    Execute(queuedTask);
+  }
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void WorkStealingPool::Run(TaskGroup& group, Task task)
+{
+  ++group._numPending;
+
+  TaskQueue& queue = *_queues[GetQueueIndexForThisThread()];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(QueuedTask{std::move(task), &group});
+    // counted while the queue is still locked, so a thread taking the task can't count it off first and
+    // wrap the unsigned count
+    ++_numQueued;
+  }
+
+  // lock so that the wakeup can't be missed by a thread that is about to sleep
+  { std::lock_guard<std::mutex> lock(_sleepMutex); }
+  _sleepCondition.notify_one();
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void WorkStealingPool::Wait(TaskGroup& group)
+{
+  const size_t queueIndex = GetQueueIndexForThisThread();
+  QueuedTask queuedTask;
+  while (!group.IsDone())
+  {
+    if (FindTask(queueIndex, queuedTask)) {
+      Execute(queuedTask);
+      continue;
+    }
+
+    // the rest of the group is running on other threads
+    std::unique_lock<std::mutex> lock(_sleepMutex);
+    _sleepCondition.wait(lock, [this, &group] { return group.IsDone() || (_numQueued.load() > 0); });
+  }
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t WorkStealingPool::GetQueueIndexForThisThread() const
+{
+  return (sWorkerPool == this) ? sWorkerQueueIndex : _threads.size();
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool WorkStealingPool::FindTask(size_t queueIndex, QueuedTask& outTask)
+{
+  const size_t numQueues = _queues.size();
+  for (size_t i = 0; i < numQueues; ++i)
+  {
+    TaskQueue& queue = *_queues[(queueIndex + i) % numQueues];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+      continue;
+    }
+
+    // the newest task of our own queue is the most likely to still be in cache, the oldest task of someone
+    // else's is the least likely to be needed by its owner soon
+    if (i == 0) {
+      outTask = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      outTask = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+    --_numQueued;
+    return true;
+  }
+  return false;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void WorkStealingPool::Execute(QueuedTask& queuedTask)
+{
+  queuedTask.task();
+  queuedTask.task = nullptr;
+
+  TaskGroup* group = queuedTask.group;
+  DEV_ASSERT(group->_numPending.load() > 0, "WorkStealingPool.Execute.GroupNotPending");
+  if (--group->_numPending == 0) {
+    // wake whoever is waiting on the group
+    { std::lock_guard<std::mutex> lock(_sleepMutex); }
+    _sleepCondition.notify_all();
+  }
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void WorkStealingPool::WorkerLoop(size_t queueIndex, std::string threadName)
+{
+  SetThreadName(pthread_self(), threadName);
+  sWorkerPool = this;
+  sWorkerQueueIndex = queueIndex;
+
+  QueuedTask queuedTask;
+  while (true)
+  {
+    if (FindTask(queueIndex, queuedTask)) {
+      Execute(queuedTask);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(_sleepMutex);
+    _sleepCondition.wait(lock, [this] { return _stop || (_numQueued.load() > 0); });
+    if (_stop && (_numQueued.load() == 0)) {
+      break;
+    }
+  }
+
+  sWorkerPool = nullptr;
+}
+
+} // namespace Util
+} // namespace Anki
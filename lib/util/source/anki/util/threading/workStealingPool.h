@@ -0,0 +1,105 @@
+/**
+ * File: workStealingPool.h
+ *
+ * Description: Fixed set of worker threads that run short tasks, each with its own queue. Idle workers steal
+ * from the other queues, and a thread waiting on a group of tasks runs queued tasks itself until the group is
+ * done, so tasks can safely wait on tasks of their own (no thread ever blocks while there's work queued).
+ *
+ * Example:
+ *
+ * Util::WorkStealingPool pool(2, "MyPool");
+ * Util::WorkStealingPool::TaskGroup group;
+ * for (auto& item : items) {
+ *   pool.Run(group, [&item] { item.Update(); });
+ * }
+ * pool.Wait(group);
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#ifndef __Util_Threading_WorkStealingPool_H__
+#define __Util_Threading_WorkStealingPool_H__
+
+#include "util/helpers/noncopyable.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Anki {
+namespace Util {
+
+class WorkStealingPool : private noncopyable
+{
+public:
+  using Task = std::function<void()>;
+
+  // Tasks that are waited on together. A group must outlive the tasks that were run on it
+  class TaskGroup : private noncopyable
+  {
+  public:
+    TaskGroup() : _numPending(0) { }
+    bool IsDone() const { return (_numPending.load() == 0); }
+  private:
+    friend class WorkStealingPool;
+    std::atomic<size_t> _numPending;
+  };
+
+  // numThreads can be zero, in which case all tasks run on the threads that wait for them
+  WorkStealingPool(size_t numThreads, const std::string& name);
+
+  // runs any tasks still queued, then joins the workers
+  ~WorkStealingPool();
+
+  size_t GetNumThreads() const { return _threads.size(); }
+
+  // Queue a task. When called from one of this pool's workers, the task goes to that worker's queue
+  void Run(TaskGroup& group, Task task);
+
+  // Return once every task run on the group has finished, running queued tasks (from any group) meanwhile
+  void Wait(TaskGroup& group);
+
+private:
+
+  struct QueuedTask {
+    Task       task;
+    TaskGroup* group;
+  };
+
+  struct TaskQueue {
+    std::mutex             mutex;
+    std::deque<QueuedTask> tasks;
+  };
+
+  // Queue of the calling thread: its own if it's one of the workers, otherwise the shared one
+  size_t GetQueueIndexForThisThread() const;
+
+  // Newest task of the given queue first, then the oldest task of every other queue
+  bool FindTask(size_t queueIndex, QueuedTask& outTask);
+
+  void Execute(QueuedTask& queuedTask);
+
+  void WorkerLoop(size_t queueIndex, std::string threadName);
+
+  // one queue per worker, plus one shared by every other thread (the last one)
+  std::vector<std::unique_ptr<TaskQueue>> _queues;
+  std::vector<std::thread>                _threads;
+
+  // idle threads sleep until a task is queued, a group is done, or the pool is stopping
+  std::mutex              _sleepMutex;
+  std::condition_variable _sleepCondition;
+  std::atomic<size_t>     _numQueued;
+  bool                    _stop = false;
+};
+
+} // namespace Util
+} // namespace Anki
+
+#endif // __Util_Threading_WorkStealingPool_H__
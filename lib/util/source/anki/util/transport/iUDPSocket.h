@@ -15,7 +15,8 @@
 #define __NetworkService_iUDPSocket_H__
 
 
-#include <sys/socket.h> // for socklen_t
+#include <assert.h>
+#include <sys/socket.h> // for socklen_t, msghdr
 #include <netinet/in.h>
 #include <stdint.h>
 
@@ -29,6 +30,15 @@ namespace Anki {
 namespace Util {
 
 
+  // One message for SendMessages / ReceiveMessages - laid out like Linux's mmsghdr so that a socket can hand an
+  // array of them straight to sendmmsg / recvmmsg. length is the number of bytes sent / received for the message
+  struct UDPMessage
+  {
+    msghdr        header;
+    unsigned int  length;
+  };
+
+
   class IUDPSocket
   {
   public:
@@ -43,6 +53,41 @@ namespace Util {
     virtual int CloseSocket(int socketId) = 0;
     virtual ssize_t SendTo(int socketId, const void* messageData, size_t messageDataSize, int flags, const sockaddr* destSockAddress, socklen_t destSockAddressLength) = 0;
     virtual ssize_t ReceiveMessage(int socketId, msghdr* messageHeader, int flags) = 0;
+    
+    // Send / receive up to numMessages in one go, returns the number of messages sent / received, or -1 (and sets errno)
+    // if the first one failed. The default just makes one SendTo / ReceiveMessage call per message, each message must
+    // have a single iovec
+    virtual int SendMessages(int socketId, UDPMessage* messages, unsigned int numMessages, int flags)
+    {
+      for (unsigned int i=0; i < numMessages; ++i)
+      {
+        msghdr& header = messages[i].header;
+        assert(header.msg_iovlen == 1);
+        const ssize_t sentBytes = SendTo(socketId, header.msg_iov[0].iov_base, header.msg_iov[0].iov_len, flags,
+                                         static_cast<const sockaddr*>(header.msg_name), header.msg_namelen);
+        if (sentBytes < 0)
+        {
+          return (i > 0) ? static_cast<int>(i) : -1;
+        }
+        messages[i].length = static_cast<unsigned int>(sentBytes);
+      }
+      return static_cast<int>(numMessages);
+    }
+    
+    virtual int ReceiveMessages(int socketId, UDPMessage* messages, unsigned int numMessages, int flags)
+    {
+      for (unsigned int i=0; i < numMessages; ++i)
+      {
+        const ssize_t receivedBytes = ReceiveMessage(socketId, &messages[i].header, flags);
+        if (receivedBytes < 0)
+        {
+          return (i > 0) ? static_cast<int>(i) : -1;
+        }
+        messages[i].length = static_cast<unsigned int>(receivedBytes);
+      }
+      return static_cast<int>(numMessages);
+    }
+    
     virtual uint32_t GetLocalIpAddress() = 0;
     virtual struct in6_addr GetLocalIpv6LinkLocalAddress() = 0;
     
@@ -39,6 +39,10 @@ public:
   virtual void Update() = 0;
   virtual void Print() const = 0;
 
+  // Sends made between these may be held back and handed to the socket together at EndSendBatch (calls can nest)
+  virtual void BeginSendBatch() {}
+  virtual void EndSendBatch() {}
+
   void SetDataReceiver(INetTransportDataReceiver* dataReceiver) { _dataReceiver = dataReceiver; }
 
 protected:
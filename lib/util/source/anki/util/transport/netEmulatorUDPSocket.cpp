@@ -373,6 +373,13 @@ ssize_t NetEmulatorUDPSocket::SendTo(int socketId, const void* messageData, size
 }
 
 
+int NetEmulatorUDPSocket::SendMessages(int socketId, UDPMessage* messages, unsigned int numMessages, int flags)
+{
+  // Like SendTo, sends aren't emulated (it's all done on receipt) so let the wrapped socket batch them
+  return _udpSocketImpl->SendMessages(socketId, messages, numMessages, flags);
+}
+
+
 ssize_t NetEmulatorUDPSocket::ReceiveMessage(int socketId, msghdr* messageHeader, int flags)
 {
   const msghdr inMessageHeader = *messageHeader;
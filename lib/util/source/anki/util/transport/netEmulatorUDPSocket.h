@@ -102,6 +102,7 @@ public:
   virtual int CloseSocket(int socketId) override;
   virtual ssize_t SendTo(int socketId, const void* messageData, size_t messageDataSize, int flags, const sockaddr* destSockAddress, socklen_t destSockAddressLength) override;
   virtual ssize_t ReceiveMessage(int socketId, msghdr* messageHeader, int flags) override;
+  virtual int SendMessages(int socketId, UDPMessage* messages, unsigned int numMessages, int flags) override;
   virtual uint32_t GetLocalIpAddress() override;
   virtual struct in6_addr GetLocalIpv6LinkLocalAddress() override;
   virtual bool IsEmulator() const override { return true; }
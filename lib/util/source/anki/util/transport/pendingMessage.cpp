@@ -27,9 +27,11 @@ PendingMessage::PendingMessage()
   , _lastSentTime(kNetTimeStampZero)
   , _message(nullptr)
   , _messageSize(0)
+  , _numTimesSent(0)
   , _sequenceNumber(k_InvalidReliableSeqId)
   , _messageType(eRMT_Invalid)
   , _flushPacket(false)
+  , _isSelectivelyAcked(false)
 {
 }
 
@@ -52,9 +54,11 @@ void PendingMessage::Set(const SrcBufferSet& srcBuffers, EReliableMessageType me
   _lastSentTime   = kNetTimeStampZero;
   _message        = srcBuffers.CreateCombinedBuffer();
   _messageSize    = srcBuffers.CalculateTotalSize();
+  _numTimesSent   = 0;
   _sequenceNumber = seqId;
   _messageType    = messageType;
   _flushPacket    = flushPacket;
+  _isSelectivelyAcked = false;
   
   // seqId == invalid implies unreliable message, this must be in sync with reliability of type
   // (otherwise multi-messages will incorrectly determine if that message contributes to the seqId increment)
@@ -81,6 +85,7 @@ void PendingMessage::UpdateLatestSentTime(NetTimeStamp newVal)
     _firstSentTime = newVal;
   }
   _lastSentTime = newVal;
+  ++_numTimesSent;
 }
 
 
@@ -53,8 +53,13 @@ public:
   NetTimeStamp          GetFirstSentTime() const { return _firstSentTime; }
   NetTimeStamp          GetLastSentTime()  const { return _lastSentTime; }
   bool                  HasBeenSent() const      { return (_lastSentTime != kNetTimeStampZero); }
+  uint32_t              GetNumTimesSent() const  { return _numTimesSent; }
   void                  UpdateLatestSentTime(NetTimeStamp newVal);
   
+  // the other end has told us it received this message, but is still waiting on an earlier one
+  bool                  IsSelectivelyAcked() const { return _isSelectivelyAcked; }
+  void                  SetSelectivelyAcked()      { _isSelectivelyAcked = true; }
+  
   bool                  ShouldFlushPacket() const { return _flushPacket; }
   
 private:
@@ -69,9 +74,11 @@ private:
   NetTimeStamp        _lastSentTime;       // Most recent time that message was sent over a socket
   uint8_t*            _message;
   uint32_t            _messageSize;
+  uint32_t            _numTimesSent;
   ReliableSequenceId  _sequenceNumber;
   uint8_t             _messageType;
   bool                _flushPacket; // is the message important enough to send even without a full packet of stuff
+  bool                _isSelectivelyAcked;
 };
 
 
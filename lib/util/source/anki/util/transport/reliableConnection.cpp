@@ -45,11 +45,18 @@ NetTimeStamp ReliableConnection::sMaxTimeSinceLastSend = sTimeBetweenResendsInMS
 NetTimeStamp ReliableConnection::sConnectionTimeoutInMS = 5000.0;
 NetTimeStamp ReliableConnection::sPacketSeparationIntervalInMS = kNetTimeStampZero;
 NetTimeStamp ReliableConnection::sMinExpectedPacketAckTimeMS = 1.0;
+NetTimeStamp ReliableConnection::sMinTimeBetweenResendsInMS = 10.0;
+NetTimeStamp ReliableConnection::sMaxTimeBetweenResendsInMS = 1000.0;
 uint32_t ReliableConnection::sMaxPingRoundTripsToTrack = 20; // Smaller number means more recent & responsive but jittery value
 uint32_t ReliableConnection::sMaxAckRoundTripsToTrack = 100;
 uint32_t ReliableConnection::sMaxPacketsToReSendOnUpdate = 3;
 uint32_t ReliableConnection::sMaxBytesFreeInAFullPacket = 0;
 bool     ReliableConnection::sSendSeparatePingMessages = true;
+bool     ReliableConnection::sSendSelectiveAcks = true;
+bool     ReliableConnection::sUseAckRoundTripForResends = true;
+
+constexpr uint32_t ReliableConnection::kMaxOutOfOrderMessages;
+constexpr uint32_t ReliableConnection::kSelectiveAckPayloadSize;
 bool     ReliableConnection::sSendPacketsImmediately = true;
 
 typedef uint8_t  MultiSubMessageType;
@@ -63,6 +70,7 @@ ReliableConnection::ReliableConnection(const TransportAddress& inTransportAddres
   , _nextOutSequenceId( k_MinReliableSeqId )
   , _lastInAckedMessageId( k_InvalidReliableSeqId )
   , _nextInSequenceId( k_MinReliableSeqId )
+  , _outOfOrderMessagesStart(0)
   , _latestMessageSentTime(kNetTimeStampZero)
   , _latestRecvTime( GetCurrentNetTimeStamp() )
   , _latestPingSentTime( kNetTimeStampZero )
@@ -74,6 +82,9 @@ ReliableConnection::ReliableConnection(const TransportAddress& inTransportAddres
   , _queuedTimes_ms(ReliableConnection::sMaxAckRoundTripsToTrack)         // Track same number as Ack as they're comparable stats
   , _pingRoundTripTimes(ReliableConnection::sMaxPingRoundTripsToTrack)
   , _ackRoundTripTimes(ReliableConnection::sMaxAckRoundTripsToTrack)
+  , _smoothedAckRoundTripTime(kNetTimeStampZero)
+  , _ackRoundTripTimeVariation(kNetTimeStampZero)
+  , _hasAckRoundTripTimeEstimate(false)
 #if ENABLE_RC_PACKET_TIME_DIAGNOSTICS
   , _timesBetweenIncomingPackets(200)
   , _timesBetweenNewIncomingPackets(200)
@@ -167,7 +178,92 @@ bool ReliableConnection::IsNextInSequenceId(ReliableSequenceId sequenceNum) cons
 
 void ReliableConnection::AdvanceNextInSequenceId()
 {
+  // the slot for the old next message is re-used for the furthest message ahead of the new one
+  OutOfOrderMessage& oldNextMessage = GetOutOfOrderMessage(0);
+  oldNextMessage._message.clear();
+  oldNextMessage._isReceived = false;
+
   _nextInSequenceId = NextSequenceId(_nextInSequenceId);
+  _outOfOrderMessagesStart = (_outOfOrderMessagesStart + 1) % _outOfOrderMessages.size();
+}
+
+
+ReliableConnection::OutOfOrderMessage& ReliableConnection::GetOutOfOrderMessage(uint32_t seqOffset)
+{
+  assert(seqOffset < _outOfOrderMessages.size());
+  return _outOfOrderMessages[(_outOfOrderMessagesStart + seqOffset) % _outOfOrderMessages.size()];
+}
+
+
+const ReliableConnection::OutOfOrderMessage& ReliableConnection::GetOutOfOrderMessage(uint32_t seqOffset) const
+{
+  assert(seqOffset < _outOfOrderMessages.size());
+  return _outOfOrderMessages[(_outOfOrderMessagesStart + seqOffset) % _outOfOrderMessages.size()];
+}
+
+
+bool ReliableConnection::IsMissingAnyInRange(ReliableSequenceId minSeqId, ReliableSequenceId maxSeqId) const
+{
+  if (IsWaitingForAnyInRange(minSeqId, maxSeqId))
+  {
+    return true;
+  }
+
+  ReliableSequenceId seqId = _nextInSequenceId;
+  for (uint32_t seqOffset = 1; seqOffset <= kMaxOutOfOrderMessages; ++seqOffset)
+  {
+    seqId = NextSequenceId(seqId);
+    if (IsSequenceIdInRange(seqId, minSeqId, maxSeqId) && !GetOutOfOrderMessage(seqOffset)._isReceived)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+bool ReliableConnection::StoreOutOfOrderMessage(const uint8_t* message, uint32_t messageSize, uint8_t messageType, ReliableSequenceId seqId)
+{
+  assert(!IsNextInSequenceId(seqId));
+
+  // anything we've already had is a long way "ahead" after looping around, so is rejected with the too-far ahead ones
+  const uint32_t seqOffset = SequenceIdDistance(_nextInSequenceId, seqId);
+  if ((seqOffset == 0) || (seqOffset > kMaxOutOfOrderMessages))
+  {
+    return false;
+  }
+
+  OutOfOrderMessage& outOfOrderMessage = GetOutOfOrderMessage(seqOffset);
+  if (outOfOrderMessage._isReceived)
+  {
+    return false;
+  }
+
+  outOfOrderMessage._message.assign(message, message + messageSize);
+  outOfOrderMessage._messageType = messageType;
+  outOfOrderMessage._isReceived  = true;
+
+  ANKI_NET_PRINT_VERBOSE("ReliableConnection.StoreOutOfOrderMessage", "%p '%s' Storing message %u (%u ahead of %u)",
+                         this, _transportAddress.ToString().c_str(), seqId, seqOffset, _nextInSequenceId);
+
+  return true;
+}
+
+
+bool ReliableConnection::PopNextInSequenceMessage(std::vector<uint8_t>& outMessage, uint8_t& outMessageType)
+{
+  OutOfOrderMessage& nextMessage = GetOutOfOrderMessage(0);
+  if (!nextMessage._isReceived)
+  {
+    return false;
+  }
+
+  outMessage.swap(nextMessage._message);
+  outMessageType = nextMessage._messageType;
+  AdvanceNextInSequenceId();
+
+  return true;
 }
 
 
@@ -187,9 +283,11 @@ bool ReliableConnection::UpdateLastAckedMessage(ReliableSequenceId seqId)
       PendingMessage* readMessage = _pendingMessageList[0];
       assert(readMessage->IsReliable() && (readMessage->GetLastSentTime() > kNetTimeStampZero));
       
-      // use time since the first time we sent this message, we don't know which send attempt is being acked
-      const NetTimeStamp timeForMessageToBeAcked = currentNetTimeStamp - readMessage->GetFirstSentTime();
-      _ackRoundTripTimes.AddStat(timeForMessageToBeAcked);
+      if (!readMessage->IsSelectivelyAcked())
+      {
+        // (selectively acked messages already added their round trip time when that ack arrived)
+        AddAckRoundTripTime(readMessage, currentNetTimeStamp);
+      }
       
       delete readMessage;
       _pendingMessageList.erase( _pendingMessageList.begin() );
@@ -340,6 +438,128 @@ void ReliableConnection::ReceivePing(ReliableTransport* reliableTransport, const
 }
 
 
+struct SelectiveAckPayload
+{
+  SelectiveAckPayload(const uint8_t* message, uint32_t messageSize)
+  {
+    const uint32_t bytesToCopy = (messageSize > GetPayloadSize()) ? GetPayloadSize() : messageSize;
+    assert(bytesToCopy == GetPayloadSize());
+    memcpy(this, message, bytesToCopy);
+  }
+  
+  SelectiveAckPayload(ReliableSequenceId lastReceivedId, uint32_t receivedAfterGap)
+    : _lastReceivedId(lastReceivedId)
+    , _padding(0)
+    , _receivedAfterGap(receivedAfterGap)
+  {
+  }
+  
+  static constexpr uint32_t GetPayloadSize()
+  {
+    return sizeof(SelectiveAckPayload);
+  }
+  
+  ReliableSequenceId _lastReceivedId;   // 2  // every message up to and including this one has been received
+  uint16_t           _padding;          // 2
+  uint32_t           _receivedAfterGap; // 4  // bit N set = message (_lastReceivedId + 2 + N) has also been received
+};
+static_assert(sizeof(SelectiveAckPayload) == ReliableConnection::kSelectiveAckPayloadSize, "Expected size mismatch, check layout and padding" );
+static_assert(ReliableConnection::kMaxOutOfOrderMessages == 32, "SelectiveAckPayload has 1 bit per out of order message" );
+
+
+uint32_t ReliableConnection::FillSelectiveAckPayload(uint8_t* outPayload, uint32_t payloadCapacity) const
+{
+  if (!sSendSelectiveAcks || (payloadCapacity < SelectiveAckPayload::GetPayloadSize()))
+  {
+    return 0;
+  }
+  
+  uint32_t receivedAfterGap = 0;
+  for (uint32_t i=0; i < kMaxOutOfOrderMessages; ++i)
+  {
+    if (GetOutOfOrderMessage(i + 1)._isReceived)
+    {
+      receivedAfterGap |= (1u << i);
+    }
+  }
+  
+  if (receivedAfterGap == 0)
+  {
+    return 0;
+  }
+  
+  const SelectiveAckPayload ackPayload(PreviousSequenceId(_nextInSequenceId), receivedAfterGap);
+  memcpy(outPayload, &ackPayload, ackPayload.GetPayloadSize());
+  return ackPayload.GetPayloadSize();
+}
+
+
+void ReliableConnection::SendAck(ReliableTransport* reliableTransport)
+{
+  uint8_t ackPayload[kSelectiveAckPayloadSize];
+  const uint32_t ackPayloadSize = FillSelectiveAckPayload(ackPayload, sizeof(ackPayload));
+  
+  // without a payload it's a plain ACK (the header says what we've received)
+  reliableTransport->SendMessage(false, _transportAddress, (ackPayloadSize > 0) ? ackPayload : nullptr, ackPayloadSize,
+                                 eRMT_ACK, true);
+}
+
+
+uint32_t ReliableConnection::GetNumSelectivelyAckedMessages() const
+{
+  uint32_t numSelectivelyAcked = 0;
+  for (const PendingMessage* pendingMessage : _pendingMessageList)
+  {
+    if (pendingMessage->IsSelectivelyAcked())
+    {
+      ++numSelectivelyAcked;
+    }
+  }
+  return numSelectivelyAcked;
+}
+
+
+bool ReliableConnection::ReceiveSelectiveAck(const uint8_t* message, uint32_t messageSize)
+{
+  if (messageSize < SelectiveAckPayload::GetPayloadSize())
+  {
+    PRINT_NAMED_WARNING("ReliableConnection.ReceiveSelectiveAck.TooSmall", "%u byte ack payload (expected %u)",
+                        messageSize, SelectiveAckPayload::GetPayloadSize());
+    return false;
+  }
+  
+  const SelectiveAckPayload ackPayload(message, messageSize);
+  if ((ackPayload._lastReceivedId < k_MinReliableSeqId) || (ackPayload._lastReceivedId > k_MaxReliableSeqId))
+  {
+    PRINT_NAMED_WARNING("ReliableConnection.ReceiveSelectiveAck.BadId", "Invalid last received id %u", ackPayload._lastReceivedId);
+    return false;
+  }
+  
+  const NetTimeStamp currentNetTimeStamp = GetCurrentNetTimeStamp();
+  bool ackedAnyMessages = false;
+  
+  for (PendingMessage* pendingMessage : _pendingMessageList)
+  {
+    if (!pendingMessage->IsReliable() || !pendingMessage->HasBeenSent() || pendingMessage->IsSelectivelyAcked())
+    {
+      continue;
+    }
+    
+    // bit 0 is 2 after the last received id (as the one straight after it must be missing)
+    const uint32_t seqOffset = SequenceIdDistance(ackPayload._lastReceivedId, pendingMessage->GetSequenceId());
+    if ((seqOffset >= 2) && (seqOffset < (kMaxOutOfOrderMessages + 2)) &&
+        ((ackPayload._receivedAfterGap & (1u << (seqOffset - 2))) != 0))
+    {
+      AddAckRoundTripTime(pendingMessage, currentNetTimeStamp);
+      pendingMessage->SetSelectivelyAcked();
+      ackedAnyMessages = true;
+    }
+  }
+  
+  return ackedAnyMessages;
+}
+
+
 void ReliableConnection::AckMessage(ReliableSequenceId seqId)
 {
   #if ENABLE_RC_PACKET_TIME_DIAGNOSTICS
@@ -375,6 +595,44 @@ void ReliableConnection::AckMessage(ReliableSequenceId seqId)
 }
 
 
+void ReliableConnection::AddAckRoundTripTime(const PendingMessage* ackedMessage, NetTimeStamp currentTime)
+{
+  // use time since the first time we sent this message, we don't know which send attempt is being acked
+  const NetTimeStamp timeForMessageToBeAcked = currentTime - ackedMessage->GetFirstSentTime();
+  _ackRoundTripTimes.AddStat(timeForMessageToBeAcked);
+  
+  // Only a message that was sent once tells us the actual round trip time, so only those drive the re-send timer
+  // (smoothed with the same gains as TCP's retransmission timer)
+  if (ackedMessage->GetNumTimesSent() == 1)
+  {
+    if (_hasAckRoundTripTimeEstimate)
+    {
+      const NetTimeStamp error = timeForMessageToBeAcked - _smoothedAckRoundTripTime;
+      _ackRoundTripTimeVariation += 0.25 * ((error < 0.0 ? -error : error) - _ackRoundTripTimeVariation);
+      _smoothedAckRoundTripTime  += 0.125 * error;
+    }
+    else
+    {
+      _smoothedAckRoundTripTime  = timeForMessageToBeAcked;
+      _ackRoundTripTimeVariation = 0.5 * timeForMessageToBeAcked;
+      _hasAckRoundTripTimeEstimate = true;
+    }
+  }
+}
+
+
+NetTimeStamp ReliableConnection::GetTimeBetweenResends() const
+{
+  if (!sUseAckRoundTripForResends || !_hasAckRoundTripTimeEstimate)
+  {
+    return sTimeBetweenResendsInMS;
+  }
+  
+  const NetTimeStamp timeBetweenResends = _smoothedAckRoundTripTime + (4.0 * _ackRoundTripTimeVariation);
+  return Clamp(timeBetweenResends, sMinTimeBetweenResendsInMS, sMaxTimeBetweenResendsInMS);
+}
+
+
 void ReliableConnection::NotifyAckingMessageSent()
 {
 #if ENABLE_RC_PACKET_TIME_DIAGNOSTICS
@@ -416,6 +674,7 @@ size_t ReliableConnection::SendUnAckedMessages(ReliableTransport* reliableTransp
   const uint32_t maxPayloadPerMessage = reliableTransport->MaxTotalBytesPerMessage();
 
   const PendingMessage* firstPendingMessage = _pendingMessageList[firstToSend];
+  assert(!firstPendingMessage->IsSelectivelyAcked());
 
   size_t   numMessagesToSend = 1;
   uint32_t numBytesToSend = firstPendingMessage->GetMessageSize();
@@ -430,6 +689,11 @@ size_t ReliableConnection::SendUnAckedMessages(ReliableTransport* reliableTransp
   for (size_t i=(firstToSend+1); i < pendingMessageListSize; ++i)
   {
     const PendingMessage* pendingMessage = _pendingMessageList[i];
+    if (pendingMessage->IsSelectivelyAcked())
+    {
+      // the other end already has this one (and the ids in a packet have to be consecutive, so stop here)
+      break;
+    }
 
     const uint32_t numBytesToSendIfAdded = numBytesToSend + k_ExtraBytesPerMultiSubMessage + pendingMessage->GetMessageSize();
     if (numBytesToSendIfAdded <= maxPayloadPerMessage)
@@ -466,6 +730,10 @@ size_t ReliableConnection::SendUnAckedMessages(ReliableTransport* reliableTransp
   while (firstToSend > 0)
   {
     const PendingMessage* pendingMessage = _pendingMessageList[firstToSend - 1];
+    if (pendingMessage->IsSelectivelyAcked())
+    {
+      break;
+    }
     
     const uint32_t numBytesToSendIfAdded = numBytesToSend + k_ExtraBytesPerMultiSubMessage + pendingMessage->GetMessageSize();
     if (numBytesToSendIfAdded <= maxPayloadPerMessage)
@@ -749,6 +1017,12 @@ uint32_t ReliableConnection::SendUnAckedPackets(ReliableTransport* reliableTrans
 
       firstToSend += numMessagesSentThisPacket;
       numPacketsSent++;
+      
+      // skip over any that the other end already has
+      while ((firstToSend < _pendingMessageList.size()) && _pendingMessageList[firstToSend]->IsSelectivelyAcked())
+      {
+        ++firstToSend;
+      }
     }
   } while((numMessagesSentThisPacket > 0) && (numPacketsSent < maxPacketsToSend));
 
@@ -770,12 +1044,18 @@ bool ReliableConnection::IsPacketWorthSending(const ReliableTransport* reliableT
   }
   
   const uint32_t minBytesForFullPacket = reliableTransport->MaxTotalBytesPerMessage() - sMaxBytesFreeInAFullPacket;
+  // don't wait longer for a full packet than we'd wait to re-send
+  const NetTimeStamp maxTimeSinceLastSend = Min(sMaxTimeSinceLastSend, GetTimeBetweenResends() - 1.0);
   
   uint32_t numBytesToSend = 0;
   const size_t pendingMessageListSize = _pendingMessageList.size();
   for (size_t i=firstToSend; i < pendingMessageListSize; ++i)
   {
     const PendingMessage* pendingMessage = _pendingMessageList[i];
+    if (pendingMessage->IsSelectivelyAcked())
+    {
+      continue;
+    }
     
     if (pendingMessage->ShouldFlushPacket())
     {
@@ -784,7 +1064,7 @@ bool ReliableConnection::IsPacketWorthSending(const ReliableTransport* reliableT
     
     const NetTimeStamp lastSentTime = pendingMessage->GetLastSentTime();
     
-    if ((lastSentTime > kNetTimeStampZero) && (currentTime > (lastSentTime + sMaxTimeSinceLastSend)))
+    if ((lastSentTime > kNetTimeStampZero) && (currentTime > (lastSentTime + maxTimeSinceLastSend)))
     {
       // This message has been sent once, but long enough ago to resend - just send it
       return true;
@@ -818,13 +1098,21 @@ uint32_t ReliableConnection::SendOptimalUnAckedPackets(ReliableTransport* reliab
   // Treat "never been sent" messages as if they'd been sent just long enough ago to require re-sending - this means
   // that really old un-acked messages are still re-sent first, but that new messages will have a good chance to be sent
   
-  const NetTimeStamp neverSentTime = currentTime - (sTimeBetweenResendsInMS + 1.0);
+  const NetTimeStamp timeBetweenResends = GetTimeBetweenResends();
+  const NetTimeStamp neverSentTime = currentTime - (timeBetweenResends + 1.0);
   const NetTimeStamp shouldBeAckedTime = _latestRecvTime - sMinExpectedPacketAckTimeMS; // anything sent before this date should be acked
   NetTimeStamp lastSentTimeForOldestMessage = kNetTimeStampZero;
   
+  bool foundMessageToSend = false;
   size_t oldestMessageIdx = 0;
   for (size_t i=0; i < _pendingMessageList.size(); ++i)
   {
+    if (_pendingMessageList[i]->IsSelectivelyAcked())
+    {
+      // only the messages the other end is still missing need re-sending
+      continue;
+    }
+    
     NetTimeStamp messageSentTime = _pendingMessageList[i]->GetLastSentTime();
     if (messageSentTime == kNetTimeStampZero)
     {
@@ -835,19 +1123,21 @@ uint32_t ReliableConnection::SendOptimalUnAckedPackets(ReliableTransport* reliab
     {
       // message was sent long enough ago that it should ideally have been acked in the last received message
       // this suggests that it wasn't received, so prioritize re-sending ASAP
-      messageSentTime -= sTimeBetweenResendsInMS;
+      messageSentTime -= timeBetweenResends;
     }
     
-    if ((i==0) || (messageSentTime < lastSentTimeForOldestMessage))
+    if (!foundMessageToSend || (messageSentTime < lastSentTimeForOldestMessage))
     {
       lastSentTimeForOldestMessage = messageSentTime;
       oldestMessageIdx = i;
+      foundMessageToSend = true;
     }
   }
   
   uint32_t numPacketsSent = 0;
   
-  if (IsPacketWorthSending(reliableTransport, currentTime, oldestMessageIdx) && (currentTime > (lastSentTimeForOldestMessage + sTimeBetweenResendsInMS)))
+  if (foundMessageToSend && IsPacketWorthSending(reliableTransport, currentTime, oldestMessageIdx) &&
+      (currentTime > (lastSentTimeForOldestMessage + timeBetweenResends)))
   {
     // Re-send any un-acked messages starting with oldestMessageIdx, up to maxPacketsToSend combined packets
     
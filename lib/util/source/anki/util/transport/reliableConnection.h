@@ -14,6 +14,7 @@
 #define __NetworkService_ReliableConnection_H__
 
 
+#include <array>
 #include <vector>
 #include "util/global/globalDefinitions.h"
 #include "util/transport/netTimeStamp.h"
@@ -59,12 +60,34 @@ public:
 
   void AdvanceNextInSequenceId();
 
+  // Reliable messages that arrive ahead of the one we're waiting for are held on to (up to kMaxOutOfOrderMessages
+  // ahead) so that the other end only needs to re-send the missing ones
+  static constexpr uint32_t kMaxOutOfOrderMessages = 32;
+  // true if any message in the range is the next one, or one ahead of it that we haven't already stored
+  bool IsMissingAnyInRange(ReliableSequenceId minSeqId, ReliableSequenceId maxSeqId) const;
+  // returns true if the message was new (i.e. not a repeat, and close enough to the next one to be stored)
+  bool StoreOutOfOrderMessage(const uint8_t* message, uint32_t messageSize, uint8_t messageType, ReliableSequenceId seqId);
+  // if the next message had already arrived out of order, hands it back and advances past it
+  bool PopNextInSequenceMessage(std::vector<uint8_t>& outMessage, uint8_t& outMessageType);
+
   void SendPing(ReliableTransport* reliableTransport, NetTimeStamp incomingPingTime = kNetTimeStampZero, bool isReply = false);
   void ReceivePing(ReliableTransport* reliableTransport, const uint8_t* message, uint32_t messageSize);
 
   void AckMessage(ReliableSequenceId seqId);              // i.e. we're saying "yes, we saw up to that message"
   void NotifyAckingMessageSent();             // whenever we send an outbound message that can ack something new
 
+  // Sends an ACK, listing any messages we're holding on to after a missing one when sSendSelectiveAcks is set
+  void SendAck(ReliableTransport* reliableTransport);
+  // FillSelectiveAckPayload: writes the list of messages we're holding on to after a missing one that SendAck sends
+  //     returns the payload size, or 0 if there's nothing to list (so a plain ACK is sent)
+  static constexpr uint32_t kSelectiveAckPayloadSize = 8;
+  uint32_t FillSelectiveAckPayload(uint8_t* outPayload, uint32_t payloadCapacity) const;
+  // ReceiveSelectiveAck: the other end listed messages it received after one it's still missing, so we stop re-sending them
+  //     returns true if any messages were newly acked
+  bool ReceiveSelectiveAck(const uint8_t* message, uint32_t messageSize);
+  // number of our un-acked messages that the other end has listed in a selective ack
+  uint32_t GetNumSelectivelyAckedMessages() const;
+
   // UpdateLastAckedMessage: i.e. we heard the other end say "yes, we saw up to that message"
   //     returns true if that updated the reliable queue (i.e. newer messages can now be sent/
   bool UpdateLastAckedMessage(ReliableSequenceId seqId);
@@ -86,12 +109,16 @@ public:
   static NetTimeStamp GetConnectionTimeoutInMS()  { return sConnectionTimeoutInMS; }
   static NetTimeStamp GetPacketSeparationIntervalInMS()  { return sPacketSeparationIntervalInMS; }
   static NetTimeStamp GetMinExpectedPacketAckTimeMS()    { return sMinExpectedPacketAckTimeMS; }
+  static NetTimeStamp GetMinTimeBetweenResendsInMS()     { return sMinTimeBetweenResendsInMS; }
+  static NetTimeStamp GetMaxTimeBetweenResendsInMS()     { return sMaxTimeBetweenResendsInMS; }
   static void SetTimeBetweenPingsInMS(NetTimeStamp newVal)   { sTimeBetweenPingsInMS = newVal; }
   static void SetTimeBetweenResendsInMS(NetTimeStamp newVal) { sTimeBetweenResendsInMS = newVal; }
   static void SetMaxTimeSinceLastSend(NetTimeStamp newVal)   { sMaxTimeSinceLastSend = newVal; }
   static void SetConnectionTimeoutInMS(NetTimeStamp newVal)  { sConnectionTimeoutInMS = newVal; }
   static void SetPacketSeparationIntervalInMS(NetTimeStamp newVal)  { sPacketSeparationIntervalInMS = newVal; }
   static void SetMinExpectedPacketAckTimeMS(NetTimeStamp newVal)    { sMinExpectedPacketAckTimeMS = newVal; }
+  static void SetMinTimeBetweenResendsInMS(NetTimeStamp newVal)     { sMinTimeBetweenResendsInMS = newVal; }
+  static void SetMaxTimeBetweenResendsInMS(NetTimeStamp newVal)     { sMaxTimeBetweenResendsInMS = newVal; }
 
   static uint32_t GetMaxPingRoundTripsToTrack()                { return sMaxPingRoundTripsToTrack; }
   static uint32_t GetMaxAckRoundTripsToTrack()                { return sMaxAckRoundTripsToTrack; }
@@ -108,6 +135,17 @@ public:
   static void  SetSendPacketsImmediately(bool newVal)  { sSendPacketsImmediately = newVal; }
   static bool  GetSendPacketsImmediately()             { return sSendPacketsImmediately; }
 
+  static void  SetSendSelectiveAcks(bool newVal)  { sSendSelectiveAcks = newVal; }
+  static bool  GetSendSelectiveAcks()             { return sSendSelectiveAcks; }
+
+  // When set, the time between re-sends comes from the ack round trip times (clamped to the min/max above) instead
+  // of always being sTimeBetweenResendsInMS
+  static void  SetUseAckRoundTripForResends(bool newVal)  { sUseAckRoundTripForResends = newVal; }
+  static bool  GetUseAckRoundTripForResends()             { return sUseAckRoundTripForResends; }
+
+  // current time to wait for an ack before re-sending a message
+  NetTimeStamp GetTimeBetweenResends() const;
+
   // Percentage of the pings we sent that other side has confirmed - likely to always be 1 ping down as the reply won't have arrived yet
   float GetPingAckedPercentage() const { return (_numPingsSent          > 0) ? (100.0f * float(_numPingsSentThatArrived) / float(_numPingsSent         )) : 0.0f; }
   // Percentage of the pings the other side says they sent towards us that we've received
@@ -161,6 +199,20 @@ private:
   typedef std::vector<PendingMessage*> PendingMessageList;
   void      DestroyPendingMessageList(PendingMessageList& messageList);
 
+  // Add the round trip time for a message the other end has just told us it received
+  void AddAckRoundTripTime(const PendingMessage* ackedMessage, NetTimeStamp currentTime);
+
+  struct OutOfOrderMessage
+  {
+    std::vector<uint8_t> _message;
+    uint8_t              _messageType = eRMT_Invalid;
+    bool                 _isReceived  = false;
+  };
+
+  // slot for the message seqOffset after _nextInSequenceId (slot 0 is _nextInSequenceId itself)
+  OutOfOrderMessage&       GetOutOfOrderMessage(uint32_t seqOffset);
+  const OutOfOrderMessage& GetOutOfOrderMessage(uint32_t seqOffset) const;
+
   // ============================== Static Member Vars ==============================
 
   static NetTimeStamp sTimeBetweenPingsInMS;
@@ -175,8 +227,12 @@ private:
   static uint32_t sMaxAckRoundTripsToTrack;
   static uint32_t sMaxPacketsToReSendOnUpdate;
   static uint32_t sMaxBytesFreeInAFullPacket;
+  static NetTimeStamp sMinTimeBetweenResendsInMS;
+  static NetTimeStamp sMaxTimeBetweenResendsInMS;
   static bool sSendSeparatePingMessages;
   static bool sSendPacketsImmediately;
+  static bool sSendSelectiveAcks;
+  static bool sUseAckRoundTripForResends;
 
   // ============================== Member Vars ==============================
 
@@ -195,6 +251,10 @@ private:
   ReliableSequenceId          _lastInAckedMessageId;  // the last message we've acknowledged receiving
   ReliableSequenceId          _nextInSequenceId;
 
+  // ring buffer of messages that arrived ahead of _nextInSequenceId, _outOfOrderMessagesStart is the slot for _nextInSequenceId
+  std::array<OutOfOrderMessage, kMaxOutOfOrderMessages + 1> _outOfOrderMessages;
+  uint32_t                    _outOfOrderMessagesStart;
+
   NetTimeStamp                _latestMessageSentTime;
   NetTimeStamp                _latestRecvTime;
 
@@ -209,6 +269,12 @@ private:
 
   Stats::RecentStatsAccumulator _pingRoundTripTimes;     // Round trip times for a ping to be sent and bounced back
   Stats::RecentStatsAccumulator _ackRoundTripTimes;      // Time between first sending a message over a socket, and it being acknowledged by other end
+
+  // Smoothed ack round trip time and its variation, from messages that were only sent once (so we know which send was
+  // acked) - used for GetTimeBetweenResends()
+  NetTimeStamp                _smoothedAckRoundTripTime;
+  NetTimeStamp                _ackRoundTripTimeVariation;
+  bool                        _hasAckRoundTripTimeEstimate;
   
 #if ENABLE_RC_PACKET_TIME_DIAGNOSTICS
   Stats::RecentStatsAccumulator _timesBetweenIncomingPackets;    // times between _any_ incoming packets
@@ -73,5 +73,23 @@ bool IsSequenceIdInRange(ReliableSequenceId seqId, ReliableSequenceId minSeqId,
 }
 
 
+uint32_t SequenceIdDistance(ReliableSequenceId fromSeqId, ReliableSequenceId toSeqId)
+{
+  assert ((fromSeqId >= k_MinReliableSeqId) && (fromSeqId <= k_MaxReliableSeqId));
+  assert ((toSeqId >= k_MinReliableSeqId) && (toSeqId <= k_MaxReliableSeqId));
+  
+  if (toSeqId >= fromSeqId)
+  {
+    // not looped
+    return (toSeqId - fromSeqId);
+  }
+  else
+  {
+    // Ids have looped around
+    return (toSeqId - k_MinReliableSeqId) + (k_MaxReliableSeqId - fromSeqId) + 1;
+  }
+}
+
+
 } // end namespace Util
 } // end namespace Anki
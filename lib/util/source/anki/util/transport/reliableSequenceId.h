@@ -35,6 +35,8 @@ static const ReliableSequenceId k_MaxReliableSeqId = 65534;
 ReliableSequenceId PreviousSequenceId(ReliableSequenceId inSeqId);
 ReliableSequenceId NextSequenceId(ReliableSequenceId inSeqId);
 bool IsSequenceIdInRange(ReliableSequenceId seqId, ReliableSequenceId minSeqId, ReliableSequenceId maxSeqId);
+// number of NextSequenceId steps it takes to get from fromSeqId to toSeqId (allowing for the ids looping around)
+uint32_t SequenceIdDistance(ReliableSequenceId fromSeqId, ReliableSequenceId toSeqId);
 
 #ifdef __cplusplus
 } // end extern "C"
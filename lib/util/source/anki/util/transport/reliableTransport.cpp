@@ -15,6 +15,7 @@
 #include "util/debug/messageDebugging.h"
 #include "util/helpers/assertHelpers.h"
 #include "util/logging/logging.h"
+#include "util/math/numericCast.h"
 #include "util/transport/connectionStats.h"
 #include "util/transport/iUnreliableTransport.h"
 #include "util/transport/reliableConnection.h"
@@ -386,23 +387,44 @@ unsigned int ReliableTransport::FillAddressFromAdvertisement(TransportAddress& a
 }
 
 
-void ReliableTransport::HandleSubMessage(const uint8_t* innerMessage, uint32_t innerMessageSize, uint8_t messageType, ReliableSequenceId reliableSequenceId, ReliableConnection* connectionInfo, const TransportAddress& sourceAddress)
+bool ReliableTransport::HandleSubMessage(const uint8_t* innerMessage, uint32_t innerMessageSize, uint8_t messageType, ReliableSequenceId reliableSequenceId, ReliableConnection* connectionInfo, const TransportAddress& sourceAddress)
 {
   const bool isReliable = (reliableSequenceId != k_InvalidReliableSeqId);
-  const bool isNextReliable = isReliable && connectionInfo->IsNextInSequenceId(reliableSequenceId);
-  const bool ignoreMessage = isReliable && !isNextReliable; // message is a repeat or out of order
-
-  connectionInfo->AddRecvMessageStats(innerMessageSize, isReliable, !ignoreMessage);
   
-  if (isNextReliable)
+  if (isReliable && !connectionInfo->IsNextInSequenceId(reliableSequenceId))
   {
-    connectionInfo->AdvanceNextInSequenceId();
+    // message is a repeat or out of order - keep any we haven't seen yet until the ones before them arrive
+    const bool isNewMessage = connectionInfo->StoreOutOfOrderMessage(innerMessage, innerMessageSize, messageType, reliableSequenceId);
+    connectionInfo->AddRecvMessageStats(innerMessageSize, isReliable, isNewMessage);
+    return true;
   }
-  else if (ignoreMessage)
+  
+  connectionInfo->AddRecvMessageStats(innerMessageSize, isReliable, true);
+  
+  if (!isReliable)
   {
-    return;
+    return DispatchSubMessage(innerMessage, innerMessageSize, messageType, connectionInfo, sourceAddress);
   }
   
+  connectionInfo->AdvanceNextInSequenceId();
+  bool isConnectionValid = DispatchSubMessage(innerMessage, innerMessageSize, messageType, connectionInfo, sourceAddress);
+  
+  // pass on any messages that arrived early and are now next in sequence
+  std::vector<uint8_t> storedMessage;
+  uint8_t storedMessageType = eRMT_Invalid;
+  while (isConnectionValid && connectionInfo->PopNextInSequenceMessage(storedMessage, storedMessageType))
+  {
+    const uint8_t* storedMessageData = storedMessage.empty() ? nullptr : storedMessage.data();
+    isConnectionValid = DispatchSubMessage(storedMessageData, Anki::Util::numeric_cast<uint32_t>(storedMessage.size()),
+                                           storedMessageType, connectionInfo, sourceAddress);
+  }
+  
+  return isConnectionValid;
+}
+
+
+bool ReliableTransport::DispatchSubMessage(const uint8_t* innerMessage, uint32_t innerMessageSize, uint8_t messageType, ReliableConnection* connectionInfo, const TransportAddress& sourceAddress)
+{
   switch (messageType)
   {
     case eRMT_ConnectionRequest:
@@ -425,7 +447,7 @@ void ReliableTransport::HandleSubMessage(const uint8_t* innerMessage, uint32_t i
         _dataReceiver->ReceiveData(INetTransportDataReceiver::OnDisconnected, 0, sourceAddress);
       }
       DeleteConnection(sourceAddress);
-      break;
+      return false;
     case eRMT_SingleReliableMessage:
     case eRMT_SingleUnreliableMessage:
       if (_dataReceiver)
@@ -457,7 +479,15 @@ void ReliableTransport::HandleSubMessage(const uint8_t* innerMessage, uint32_t i
       assert(0); // should be handled purely at ReceiveData, and never embedded as a sub-message
       break;
     case eRMT_ACK:
-      // Ack id is already handled for all messages from the header earlier - nothing left to do!
+      // Ack id is already handled for all messages from the header earlier, any payload lists messages received after a gap
+      if ((innerMessageSize > 0) && connectionInfo->ReceiveSelectiveAck(innerMessage, innerMessageSize))
+      {
+        // stopped re-sending some messages - give connection a chance to send the ones still missing now
+        if (sMaxPacketsToReSendOnAck > 0)
+        {
+          connectionInfo->SendOptimalUnAckedPackets(this, sMaxPacketsToReSendOnAck);
+        }
+      }
       break;
     case eRMT_Ping:
       connectionInfo->ReceivePing(this, innerMessage, innerMessageSize);
@@ -466,6 +496,8 @@ void ReliableTransport::HandleSubMessage(const uint8_t* innerMessage, uint32_t i
       PRINT_NAMED_ERROR("ReliableTransport.Sub.BadType", "unknown reliable message type: %u", messageType);
       break;
   }
+  
+  return true;
 }
 
 
@@ -525,10 +557,20 @@ void ReliableTransport::ReceiveData(const uint8_t* buffer, unsigned int size, co
       }
       
       bool anyMessagesToReceive = true;
+      bool anyReliableMessagesToReceive = false;
       
       if (isReliable)
       {
-        anyMessagesToReceive = connectionInfo->IsWaitingForAnyInRange(minSeqId, maxSeqId);
+        const bool isWaitingForAnyInRange = connectionInfo->IsWaitingForAnyInRange(minSeqId, maxSeqId);
+        anyReliableMessagesToReceive = isWaitingForAnyInRange || connectionInfo->IsMissingAnyInRange(minSeqId, maxSeqId);
+        anyMessagesToReceive = anyReliableMessagesToReceive;
+        
+        if (!isWaitingForAnyInRange)
+        {
+          _transportStats.AddRecvError(eME_OutOfOrder);
+          ANKI_NET_PRINT_VERBOSE("ReliableTransport.Recv.OutOfOrder", "ReceiveData - %s out of order messages %u..%u (waiting for %u)",
+                                 anyReliableMessagesToReceive ? "Storing" : "Ignoring", minSeqId, maxSeqId, connectionInfo->GetNextInSequenceId() );
+        }
         
         if (!anyMessagesToReceive)
         {
@@ -539,9 +581,6 @@ void ReliableTransport::ReceiveData(const uint8_t* buffer, unsigned int size, co
           }
           else
           {
-            _transportStats.AddRecvError(eME_OutOfOrder);
-            ANKI_NET_PRINT_VERBOSE("ReliableTransport.Recv.OutOfOrder", "ReceiveData - Ignoring out of order messages %u..%u (waiting for %u)", minSeqId, maxSeqId, connectionInfo->GetNextInSequenceId() );
-            
             #if !ENABLE_RC_PACKET_TIME_DIAGNOSTICS
             {
               // We only early-out if we're not interestd on the stats on each message
@@ -553,15 +592,13 @@ void ReliableTransport::ReceiveData(const uint8_t* buffer, unsigned int size, co
         else
         {
           assert(reliablePacketHeader->GetType() != eRMT_ACK);
-          connectionInfo->AckMessage(maxSeqId);
-          if (sSendAckOnReceipt)
-          {
-            SendMessage(false, sourceAddress, nullptr, 0, eRMT_ACK, true);
-          }
         }
       }
       
       connectionInfo->AddRecvPacketStats(size, anyMessagesToReceive);
+      
+      const ReliableSequenceId nextInSequenceIdBefore = connectionInfo->GetNextInSequenceId();
+      bool isConnectionValid = true;
 
       if (isMultipleMessages)
       {
@@ -600,20 +637,39 @@ void ReliableTransport::ReceiveData(const uint8_t* buffer, unsigned int size, co
           const uint8_t* subMessageData = (subMessageSize == 0) ? nullptr : &innerMessage[bytesProcessed];
           bytesProcessed += subMessageSize;
           
-          HandleSubMessage(subMessageData, subMessageSize, subMessageType, subMessageSeqId, connectionInfo, sourceAddress);
+          isConnectionValid = HandleSubMessage(subMessageData, subMessageSize, subMessageType, subMessageSeqId, connectionInfo, sourceAddress);
+          if (!isConnectionValid)
+          {
+            // connection was closed by that message, nothing left to give the rest to
+            break;
+          }
           
           if (isSubMessageReliable)
           {
             reliableSequenceId = NextSequenceId(reliableSequenceId);
           }
         }
-        assert(bytesProcessed == innerMessageSize);
-        assert(!isReliable || (reliableSequenceId == NextSequenceId(maxSeqId)));
+        assert(!isConnectionValid || (bytesProcessed == innerMessageSize));
+        assert(!isConnectionValid || !isReliable || (reliableSequenceId == NextSequenceId(maxSeqId)));
       }
       else
       {
         assert(minSeqId == maxSeqId);
-        HandleSubMessage(innerMessage, innerMessageSize, messageType, minSeqId, connectionInfo, sourceAddress);
+        isConnectionValid = HandleSubMessage(innerMessage, innerMessageSize, messageType, minSeqId, connectionInfo, sourceAddress);
+      }
+      
+      if (isConnectionValid && anyReliableMessagesToReceive)
+      {
+        // Ack now that we know how far the new messages (and any stored ones they were waiting for) got us
+        const ReliableSequenceId nextInSequenceId = connectionInfo->GetNextInSequenceId();
+        if (nextInSequenceId != nextInSequenceIdBefore)
+        {
+          connectionInfo->AckMessage(PreviousSequenceId(nextInSequenceId));
+        }
+        if (sSendAckOnReceipt)
+        {
+          connectionInfo->SendAck(this);
+        }
       }
     }
     else
@@ -713,6 +769,9 @@ void ReliableTransport::Update()
   }
   #endif // ENABLE_RT_UPDATE_TIME_DIAGNOSTICS
   
+  // acks for anything received, and any re-sends they trigger, go out together with the connections' own sends below
+  _unreliable->BeginSendBatch();
+  
   _unreliable->Update();
   
   for (ReliableConnectionMap::iterator it = _reliableConnectionMap.begin(); it != _reliableConnectionMap.end(); )
@@ -748,6 +807,8 @@ void ReliableTransport::Update()
     }
   }
   
+  _unreliable->EndSendBatch();
+  
 #if ANKI_NET_MESSAGE_LOGGING_ENABLED
   if (kPrintNetworkStats)
   {
@@ -23,6 +23,7 @@
 #include "util/transport/srcBufferSet.h"
 #include "util/transport/transportAddress.h"
 #include <assert.h>
+#include <stddef.h>
 #include <string>
 #include <strings.h>
 #include <sys/socket.h>
@@ -37,6 +38,13 @@
 #include <ifaddrs.h>
 #endif
 
+// sendmmsg / recvmmsg are Linux only (and only in Android's libc from API 21)
+#if defined(__linux__) && (!defined(__ANDROID__) || (__ANDROID_API__ >= 21))
+  #define ANKI_UDP_HAS_MMSG 1
+#else
+  #define ANKI_UDP_HAS_MMSG 0
+#endif
+
 namespace Anki {
 namespace Util {
   
@@ -59,6 +67,44 @@ static const size_t   kMaxNetMessageSize = 1472; // Assuming a an MTU of 1500, m
 
 static const uint8_t  kDefaultHeaderPrefix[4] = {'A', 'N', 'K', 02}; // Prefix is equivalent to 'A''N''K'02 in Little Endian - i.e. "ANKI Drive 2", i.e. Overdrive
 static const int      kDefaultPort = 47817;
+
+
+// ============================== UDPTransport::MessageBatch ========================================
+
+
+// Messages (and the buffers and addresses they point at) queued to send, or to receive into, with one socket call
+struct UDPTransport::MessageBatch
+{
+  MessageBatch()
+  {
+    memset(messages, 0, sizeof(messages));
+    for (uint32_t i=0; i < kMaxMessagesPerBatch; ++i)
+    {
+      iovecs[i].iov_base = buffers[i];
+      iovecs[i].iov_len  = sizeof(buffers[i]);
+      messages[i].header.msg_iov    = &iovecs[i];
+      messages[i].header.msg_iovlen = 1;
+      messages[i].header.msg_name   = &addresses[i];
+    }
+  }
+
+  // ready message i for receiving into (recv calls overwrite the name length and flags)
+  void ResetForReceive(uint32_t i)
+  {
+    memset(&addresses[i], 0, sizeof(addresses[i]));
+    iovecs[i].iov_len  = sizeof(buffers[i]);
+    messages[i].header.msg_namelen = sizeof(addresses[i]);
+    messages[i].header.msg_flags   = 0;
+    messages[i].length = 0;
+  }
+
+  UDPMessage        messages[kMaxMessagesPerBatch];
+  iovec             iovecs[kMaxMessagesPerBatch];
+  sockaddr_storage  addresses[kMaxMessagesPerBatch];
+  uint8_t           buffers[kMaxMessagesPerBatch][kMaxNetMessageSize];
+  uint32_t          numMessages = 0;
+};
+
   
 // ============================== PosixUDPSocket ========================================
 
@@ -104,6 +150,22 @@ public:
     return recvmsg(socketId, messageHeader, flags);
   }
 
+#if ANKI_UDP_HAS_MMSG
+  static_assert(sizeof(UDPMessage) == sizeof(mmsghdr), "UDPMessage must match mmsghdr");
+  static_assert(offsetof(UDPMessage, header) == offsetof(mmsghdr, msg_hdr), "UDPMessage must match mmsghdr");
+  static_assert(offsetof(UDPMessage, length) == offsetof(mmsghdr, msg_len), "UDPMessage must match mmsghdr");
+
+  virtual int SendMessages(int socketId, UDPMessage* messages, unsigned int numMessages, int flags) override
+  {
+    return sendmmsg(socketId, reinterpret_cast<mmsghdr*>(messages), numMessages, flags);
+  }
+
+  virtual int ReceiveMessages(int socketId, UDPMessage* messages, unsigned int numMessages, int flags) override
+  {
+    return recvmmsg(socketId, reinterpret_cast<mmsghdr*>(messages), numMessages, flags, nullptr);
+  }
+#endif // ANKI_UDP_HAS_MMSG
+
   virtual uint32_t GetLocalIpAddress() override
   {
     uint32_t ipAddress = _ipRetriever->GetIpAddress();
@@ -377,6 +439,9 @@ UDPTransport::UDPTransport(sa_family_t family)
   , _transportStats("UDP")
   , _udpSocketImpl(nullptr)
   , _lastSendErrorPrinted(kNetTimeStampZero)
+  , _sendBatch(new MessageBatch())
+  , _recvBatch(new MessageBatch())
+  , _sendBatchDepth(0)
   , _family(family)
   , _socketId(-1)
   , _port(kDefaultPort)
@@ -673,6 +738,9 @@ bool UDPTransport::CloseSocket()
     return false;
   }
 
+  // anything queued was meant for this socket
+  FlushSendBatch();
+
   const int closeResult = _udpSocketImpl->CloseSocket(_socketId);
   if (closeResult < 0)
   {
@@ -756,6 +824,31 @@ ssize_t UDPTransport::SendDataToSockAddress(const sockaddr& destSockAddress, uin
 {
   socklen_t destSockAddressLength = destSockAddressLengthIn;
   
+  if (_sendBatchDepth > 0)
+  {
+    // Build the packet straight into the batch, it's sent (and any failure reported) when the batch is flushed
+    if (_sendBatch->numMessages >= kMaxMessagesPerBatch)
+    {
+      FlushSendBatch();
+    }
+    
+    const uint32_t i = _sendBatch->numMessages;
+    assert(destSockAddressLength <= sizeof(_sendBatch->addresses[i]));
+    
+    uint32_t bufferWithHeaderSize = BuildPacket(_sendBatch->buffers[i], sizeof(_sendBatch->buffers[i]), srcBuffers);
+    
+    ANKI_NET_MESSAGE_VERBOSE(("UDP Send", GetAnkiPacketHeaderDescriptor(), _sendBatch->buffers[i], bufferWithHeaderSize, &srcBuffers));
+    
+    _transportStats.AddSentMessage(bufferWithHeaderSize);
+    
+    memcpy(&_sendBatch->addresses[i], &destSockAddress, destSockAddressLength);
+    _sendBatch->iovecs[i].iov_len = bufferWithHeaderSize;
+    _sendBatch->messages[i].header.msg_namelen = destSockAddressLength;
+    ++_sendBatch->numMessages;
+    
+    return bufferWithHeaderSize;
+  }
+  
   uint8_t bufferWithHeader[kMaxNetMessageSize];
   uint32_t bufferWithHeaderSize = BuildPacket(bufferWithHeader, sizeof(bufferWithHeader), srcBuffers);
  
@@ -823,19 +916,80 @@ void UDPTransport::SendData(const TransportAddress& destAddress, const SrcBuffer
 
   if (isValidIpAddress && (sendRes < 0))
   {
-    _transportStats.AddSendError(eME_SendFailed);
-        
-    // when send fails it usually fails for every send (i.e. every few ms), so we throttle the warning
-    // to avoid spamming
-        
-    const NetTimeStamp now = GetCurrentNetTimeStamp();
-    const NetTimeStamp kMinSendWarningSpacingMs = 30000.0;
-    if (kEnableVerboseNetworkLogging || (_lastSendErrorPrinted == kNetTimeStampZero) ||
-        (now > (_lastSendErrorPrinted + kMinSendWarningSpacingMs)))
+    ReportSendFailure(destAddress, sendRes);
+  }
+}
+
+
+void UDPTransport::ReportSendFailure(const TransportAddress& destAddress, ssize_t sendRes)
+{
+  _transportStats.AddSendError(eME_SendFailed);
+  
+  // when send fails it usually fails for every send (i.e. every few ms), so we throttle the warning
+  // to avoid spamming
+  
+  const NetTimeStamp now = GetCurrentNetTimeStamp();
+  const NetTimeStamp kMinSendWarningSpacingMs = 30000.0;
+  if (kEnableVerboseNetworkLogging || (_lastSendErrorPrinted == kNetTimeStampZero) ||
+      (now > (_lastSendErrorPrinted + kMinSendWarningSpacingMs)))
+  {
+    PRINT_NAMED_WARNING("UDPTransport.SendFailed", "sendto '%s' returned %zd, errno = %d '%s' (%u sends failed), now = %.1f",
+                        destAddress.ToString().c_str(), sendRes, errno, strerror(errno), _transportStats.GetSentStats().GetErrorCount(eME_SendFailed), now);
+    _lastSendErrorPrinted = now;
+  }
+}
+
+
+void UDPTransport::BeginSendBatch()
+{
+  ++_sendBatchDepth;
+}
+
+
+void UDPTransport::EndSendBatch()
+{
+  assert(_sendBatchDepth > 0);
+  --_sendBatchDepth;
+  if (_sendBatchDepth == 0)
+  {
+    FlushSendBatch();
+  }
+}
+
+
+void UDPTransport::FlushSendBatch()
+{
+  const uint32_t numMessages = _sendBatch->numMessages;
+  _sendBatch->numMessages = 0;
+  
+  if (_socketId < 0)
+  {
+    // socket was closed since these were queued, nowhere to send them
+    return;
+  }
+  
+  uint32_t numSent = 0;
+  while (numSent < numMessages)
+  {
+    const int sendRes = _udpSocketImpl->SendMessages(_socketId, &_sendBatch->messages[numSent], numMessages - numSent, 0);
+    if (sendRes > 0)
+    {
+      for (uint32_t i = numSent; i < (numSent + sendRes); ++i)
+      {
+        if (_sendBatch->messages[i].length != _sendBatch->iovecs[i].iov_len)
+        {
+          // Not an error code, but the wrong send size!?
+          PRINT_NAMED_ERROR("UDPTransport.SentWrongNumBytes",
+                            "sentBytes %u != bufferSize %zu", _sendBatch->messages[i].length, _sendBatch->iovecs[i].iov_len);
+        }
+      }
+      numSent += sendRes;
+    }
+    else
     {
-          PRINT_NAMED_WARNING("UDPTransport.SendFailed", "sendto '%s' returned %zd, errno = %d '%s' (%u sends failed), now = %.1f",
-                              destAddress.ToString().c_str(), sendRes, errno, strerror(errno), _transportStats.GetSentStats().GetErrorCount(eME_SendFailed), now);
-          _lastSendErrorPrinted = now;
+      // report and skip the message that failed, the rest may still go (e.g. they're to a different address)
+      ReportSendFailure(TransportAddress(_sendBatch->addresses[numSent]), sendRes);
+      ++numSent;
     }
   }
 }
@@ -905,41 +1059,45 @@ void UDPTransport::HandleReceivedMessage(const uint8_t* buffer, uint32_t bufferL
 }
 
   
-bool UDPTransport::TryToReadMessage()
+bool UDPTransport::TryToReadMessages()
 {
-  // buffer for receiving message data
-  uint8_t buffer[kMaxNetMessageSize];
-
-  sockaddr_storage srcSockAddressStorage;
-  memset(&srcSockAddressStorage, 0, sizeof(srcSockAddressStorage));
-  
-  const int kNumIoVecs = 1;
-  iovec iov[kNumIoVecs];
-  iov[0].iov_base = buffer;
-  iov[0].iov_len  = sizeof(buffer);
-  
-  msghdr message;
-  memset(&message, 0, sizeof(message));
-  message.msg_name       = &srcSockAddressStorage;
-  message.msg_namelen    = sizeof(srcSockAddressStorage);
-  message.msg_iov        = iov;
-  message.msg_iovlen     = kNumIoVecs;
-  message.msg_control    = 0;
-  message.msg_controllen = 0;
+  MessageBatch& batch = *_recvBatch;
+  for (uint32_t i=0; i < kMaxMessagesPerBatch; ++i)
+  {
+    batch.ResetForReceive(i);
+  }
   
-  ssize_t bytesReceived = _udpSocketImpl->ReceiveMessage(_socketId, &message, MSG_DONTWAIT);
-
-  const bool wasTruncated = (message.msg_flags & MSG_TRUNC);
+  const int numReceived = _udpSocketImpl->ReceiveMessages(_socketId, batch.messages, kMaxMessagesPerBatch, MSG_DONTWAIT);
 
-  if (bytesReceived > 0)
+  if (numReceived > 0)
   {
-    assert(bytesReceived <= kMaxNetMessageSize);
-    assert(srcSockAddressStorage.ss_family == _family);
-
-    TransportAddress sourceTransportAddress(srcSockAddressStorage);
-    HandleReceivedMessage(buffer, static_cast<uint32_t>(bytesReceived), sourceTransportAddress, wasTruncated);
+    for (uint32_t i=0; i < static_cast<uint32_t>(numReceived); ++i)
+    {
+      const msghdr& message = batch.messages[i].header;
+      const uint32_t bytesReceived = batch.messages[i].length;
+      const bool wasTruncated = (message.msg_flags & MSG_TRUNC);
+      
+      if (bytesReceived == 0)
+      {
+        // nothing to handle (a single read would have retried rather than report an empty message)
+        continue;
+      }
+      
+      assert(bytesReceived <= kMaxNetMessageSize);
+      assert(batch.addresses[i].ss_family == _family);
+      
+      TransportAddress sourceTransportAddress(batch.addresses[i]);
+      HandleReceivedMessage(batch.buffers[i], bytesReceived, sourceTransportAddress, wasTruncated);
+      
+      if (_socketId < 0)
+      {
+        // handling the message closed the socket, the rest were for it
+        return false;
+      }
+    }
     
-    return true;
+    // a partial batch means the queue was emptied
+    return (static_cast<uint32_t>(numReceived) == kMaxMessagesPerBatch);
   }
   else
   {
@@ -947,8 +1105,8 @@ bool UDPTransport::TryToReadMessage()
     {
       // This is a warning, not an error, because it sometimes happens in a normal disconnection flow.
       PRINT_NAMED_WARNING("UDPTransport.ReadFailed",
-                          "recvmsg(_socketId = %d _port = %d) returned %zd, errno = %d '%s'",
-                          _socketId, _port, bytesReceived, errno, strerror(errno));
+                          "recvmsg(_socketId = %d _port = %d) returned %d, errno = %d '%s'",
+                          _socketId, _port, numReceived, errno, strerror(errno));
     }
     
     if (ENOTCONN == errno)
@@ -1036,10 +1194,12 @@ void UDPTransport::Update()
   
   UpdateSocketImplForNetEmulation();
   
-  // .. keep reading messages until the queue is empty
-  while (TryToReadMessage())
+  // .. keep reading messages until the queue is empty, anything sent in response goes out together afterwards
+  BeginSendBatch();
+  while (TryToReadMessages())
   {
   }
+  EndSendBatch();
 }
   
   
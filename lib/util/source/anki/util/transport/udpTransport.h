@@ -17,11 +17,13 @@
 #include "util/transport/netTimeStamp.h"
 #include "util/transport/transportStats.h"
 #include <assert.h>
+#include <memory>
 #include <sys/socket.h>
 
 struct sockaddr;
 struct sockaddr_in;
 struct sockaddr_in6;
+struct sockaddr_storage;
 
 
 namespace Anki {
@@ -51,6 +53,8 @@ public:
   virtual uint32_t MaxTotalBytesPerMessage() const override;
   virtual void Update() override;
   virtual void Print() const override;
+  virtual void BeginSendBatch() override;
+  virtual void EndSendBatch() override;
 
   void ResetSocket();
 
@@ -102,6 +106,11 @@ public:
 
 private:
 
+  // Max messages handed to the socket in one SendMessages / ReceiveMessages call
+  static constexpr uint32_t kMaxMessagesPerBatch = 16;
+
+  struct MessageBatch;
+
   void    FreeSocketImpl();
   void    UpdateSocketImplForNetEmulation();
   
@@ -114,12 +123,14 @@ private:
     return SendDataToSockAddress(reinterpret_cast<const sockaddr&>(destSockAddress), destSockAddressLength, srcBuffers);
   }
   ssize_t SendDataToSockAddress(const sockaddr& destSockAddress, uint32_t destSockAddressLength, const SrcBufferSet& srcBuffers);
+  void    FlushSendBatch();
+  void    ReportSendFailure(const TransportAddress& destAddress, ssize_t sendRes);
 
   bool    OpenSocket(int port);
   bool    CloseSocket();
 
   void    HandleReceivedMessage(const uint8_t* buffer, uint32_t bufferLength, const TransportAddress& sourceAddress, bool wasTruncated);
-  bool    TryToReadMessage();
+  bool    TryToReadMessages();
 
   unsigned int GetWifiInterfaceIndex() const;
 
@@ -135,6 +146,10 @@ private:
   IUDPSocket*     _udpSocketImpl;
   NetTimeStamp    _lastSendErrorPrinted;
 
+  std::unique_ptr<MessageBatch> _sendBatch;
+  std::unique_ptr<MessageBatch> _recvBatch;
+  uint32_t        _sendBatchDepth;
+
   const sa_family_t _family;
   int             _socketId;
   int             _port;
@@ -17,9 +17,11 @@
 #include "util/logging/logging.h"
 #include "util/math/math.h"
 #include "util/transport/fakeUDPSocket.h"
+#include "util/transport/iUnreliableTransport.h"
 #include "util/transport/netEmulatorUDPSocket.h"
 #include "util/transport/reliableConnection.h"
 #include "util/transport/reliableTransport.h"
+#include "util/transport/srcBufferSet.h"
 #include "util/transport/transportAddress.h"
 #include "util/transport/udpTransport.h"
 #include <arpa/inet.h>
@@ -966,3 +968,339 @@ TEST_F(ReliableTransportTest, MixUnreliableAndReliableCozmo)
   InitCozmoNetSettings();
   MixUnreliableAndReliableTest();
 }
+
+
+// Sent by ThroughputAndLatencyTest, padded out to a typical small message size
+struct IndexedTestMessage
+{
+  uint32_t      index;
+  uint8_t       padding[60];
+};
+
+
+struct NetworkProfile
+{
+  const char* name;
+  uint32_t    minLatencyInMS;
+  uint32_t    maxLatencyInMS;
+  float       packetLossPercentage;
+};
+
+
+// Sets whether ReliableConnection sends selective acks, and puts the old setting back when it goes out of scope
+class ScopedSendSelectiveAcks
+{
+public:
+  explicit ScopedSendSelectiveAcks(bool sendSelectiveAcks)
+    : _oldSendSelectiveAcks(ReliableConnection::GetSendSelectiveAcks())
+  {
+    ReliableConnection::SetSendSelectiveAcks(sendSelectiveAcks);
+  }
+  
+  ~ScopedSendSelectiveAcks()
+  {
+    ReliableConnection::SetSendSelectiveAcks(_oldSendSelectiveAcks);
+  }
+  
+private:
+  const bool _oldSendSelectiveAcks;
+};
+
+
+static void ThroughputAndLatencyTest(const NetworkProfile& profile, bool sendSelectiveAcks)
+{
+  // Streams a steady burst of small reliable messages from host1 to client2 over an emulated network, and checks that
+  // every one arrives exactly once and in order
+  
+  InitOverdriveNetSettings();
+  const ScopedSendSelectiveAcks scopedSendSelectiveAcks(sendSelectiveAcks);
+  
+  TestClientWrappers3 testClientWrappers;
+  TestClientWrapper& host1   = testClientWrappers._host1;
+  TestClientWrapper& client2 = testClientWrappers._client2;
+  
+  host1._emulatorSocket.SetLatencyRangeInMS(profile.minLatencyInMS, profile.maxLatencyInMS);
+  client2._emulatorSocket.SetLatencyRangeInMS(profile.minLatencyInMS, profile.maxLatencyInMS);
+  host1._emulatorSocket.SetRandomPacketLossPercentage(profile.packetLossPercentage);
+  client2._emulatorSocket.SetRandomPacketLossPercentage(profile.packetLossPercentage);
+  
+  host1._reliableTransport.StartHost();
+  client2._reliableTransport.StartClient();
+  
+  const uint32_t k_MaxTimeForTest = 20000; // = 20 seconds
+  
+  host1._reliableTransport.Connect(client2.GetTransportAddress());
+  WaitUntilDoneOrMaxTime(25, k_MaxTimeForTest, [&] { return (host1._dataReceiver.GetNumConnections() == 1) && (client2._dataReceiver.GetNumConnections() == 1); } );
+  ASSERT_EQ(client2._dataReceiver.GetNumConnections(), 1);
+  
+  // 10 messages every 5ms, a busy stream of state updates
+  const uint32_t k_NumMessages = 400;
+  const uint32_t k_MessagesPerBurst = 10;
+  const uint32_t k_TimeBetweenBurstsInMS = 5;
+  for (uint32_t i=0; i < k_NumMessages; ++i)
+  {
+    IndexedTestMessage message;
+    memset(&message, 0, sizeof(message));
+    message.index = i;
+    host1._reliableTransport.SendData(true, client2.GetTransportAddress(), reinterpret_cast<const uint8_t*>(&message), sizeof(message));
+    
+    if (((i + 1) % k_MessagesPerBurst) == 0)
+    {
+      usleep(k_TimeBetweenBurstsInMS * 1000);
+    }
+  }
+  
+  WaitUntilDoneOrMaxTime(1, k_MaxTimeForTest, [&] { return (client2._dataReceiver.GetNumMessagesReceived() >= k_NumMessages); } );
+  
+  ASSERT_EQ( client2._dataReceiver.GetNumMessagesReceived(), k_NumMessages );
+  ASSERT_EQ( client2._dataReceiver.GetNumBytesReceived(), k_NumMessages * sizeof(IndexedTestMessage) );
+  
+  {
+    const std::vector<uint8_t>& receivedBytes = client2._dataReceiver.LockAndGetReceivedBytes();
+    for (uint32_t i=0; i < k_NumMessages; ++i)
+    {
+      IndexedTestMessage message;
+      memcpy(&message, &receivedBytes[i * sizeof(IndexedTestMessage)], sizeof(message));
+      EXPECT_EQ(message.index, i); // every message arrives exactly once and in order
+    }
+    client2._dataReceiver.Unlock();
+  }
+}
+
+
+static const NetworkProfile kCleanNetwork  = {"Clean",           1,   2,  0.0f};
+static const NetworkProfile kLossyNetwork  = {"Lossy",           20,  40, 5.0f};
+static const NetworkProfile kJitterNetwork = {"Lossy+Jitter",    5,  150, 15.0f};
+
+
+TEST_F(ReliableTransportTest, ThroughputAndLatencyClean)
+{
+  ThroughputAndLatencyTest(kCleanNetwork, false);
+  ThroughputAndLatencyTest(kCleanNetwork, true);
+}
+
+
+TEST_F(ReliableTransportTest, ThroughputAndLatencyLossy)
+{
+  ThroughputAndLatencyTest(kLossyNetwork, false);
+  ThroughputAndLatencyTest(kLossyNetwork, true);
+}
+
+
+TEST_F(ReliableTransportTest, ThroughputAndLatencyLossyJitter)
+{
+  ThroughputAndLatencyTest(kJitterNetwork, false);
+  ThroughputAndLatencyTest(kJitterNetwork, true);
+}
+
+
+// Only counts what's sent through it, so that a ReliableConnection can be driven directly
+class CountingUnreliableTransport : public IUnreliableTransport
+{
+public:
+  virtual void SendData(const TransportAddress& destAddress, const SrcBufferSet& srcBuffers) override { ++_numPacketsSent; }
+  virtual void StartHost() override {}
+  virtual void StopHost() override {}
+  virtual void StartClient() override {}
+  virtual void StopClient() override {}
+  virtual void FillAdvertisementBytes(AdvertisementBytes& bytes) override {}
+  virtual unsigned int FillAddressFromAdvertisement(TransportAddress& address, const uint8_t* buffer, unsigned int size) override { return 0; }
+  virtual uint32_t MaxTotalBytesPerMessage() const override { return 1400; }
+  virtual void Update() override {}
+  virtual void Print() const override {}
+  
+  uint32_t _numPacketsSent = 0;
+};
+
+
+// A ReliableConnection sending over a CountingUnreliableTransport
+struct TestSender
+{
+  TestSender()
+    : _dataReceiver("Sender", MakeTestIp(1))
+    , _reliableTransport(&_unreliableTransport, &_dataReceiver)
+    , _connection(TransportAddress(MakeTestIp(2), 1234))
+  {
+  }
+  
+  ~TestSender()
+  {
+    _reliableTransport.KillThread();
+  }
+  
+  // queues and sends a reliable message for each of the numMessages ids from firstSeqId on (each message is its id)
+  void SendMessages(ReliableSequenceId firstSeqId, uint32_t numMessages)
+  {
+    ReliableSequenceId seqId = firstSeqId;
+    for (uint32_t i=0; i < numMessages; ++i)
+    {
+      SrcBufferSet srcBuffers;
+      srcBuffers.AddBuffer( SizedSrcBuffer(reinterpret_cast<const uint8_t*>(&seqId), sizeof(seqId)) );
+      _connection.AddMessage(srcBuffers, eRMT_SingleReliableMessage, seqId, true, kNetTimeStampZero);
+      seqId = NextSequenceId(seqId);
+    }
+    _connection.SendOptimalUnAckedPackets(&_reliableTransport, numMessages);
+  }
+  
+  CountingUnreliableTransport   _unreliableTransport;
+  TestNetTransportDataReceiver  _dataReceiver;
+  ReliableTransport             _reliableTransport;
+  ReliableConnection            _connection;
+};
+
+
+static void AdvanceTestReceiverTo(ReliableConnection& receiver, ReliableSequenceId nextInSequenceId)
+{
+  while (receiver.GetNextInSequenceId() != nextInSequenceId)
+  {
+    receiver.AdvanceNextInSequenceId();
+  }
+}
+
+
+static bool StoreTestMessage(ReliableConnection& receiver, ReliableSequenceId seqId)
+{
+  return receiver.StoreOutOfOrderMessage(reinterpret_cast<const uint8_t*>(&seqId), sizeof(seqId), eRMT_SingleReliableMessage, seqId);
+}
+
+
+// returns the id of the message that was popped, or k_InvalidReliableSeqId if there wasn't one
+static ReliableSequenceId PopTestMessage(ReliableConnection& receiver)
+{
+  std::vector<uint8_t> message;
+  uint8_t messageType = eRMT_Invalid;
+  if (!receiver.PopNextInSequenceMessage(message, messageType))
+  {
+    return k_InvalidReliableSeqId;
+  }
+  
+  EXPECT_EQ(messageType, eRMT_SingleReliableMessage);
+  ReliableSequenceId seqId = k_InvalidReliableSeqId;
+  EXPECT_EQ(message.size(), sizeof(seqId));
+  memcpy(&seqId, message.data(), std::min(message.size(), sizeof(seqId)));
+  return seqId;
+}
+
+
+static bool SendSelectiveAck(const ReliableConnection& receiver, ReliableConnection& sender)
+{
+  uint8_t ackPayload[ReliableConnection::kSelectiveAckPayloadSize];
+  const uint32_t ackPayloadSize = receiver.FillSelectiveAckPayload(ackPayload, sizeof(ackPayload));
+  EXPECT_EQ(ackPayloadSize, ReliableConnection::kSelectiveAckPayloadSize);
+  return sender.ReceiveSelectiveAck(ackPayload, ackPayloadSize);
+}
+
+
+TEST_F(ReliableTransportTest, SelectiveAckAcrossSequenceIdWrap)
+{
+  const ScopedSendSelectiveAcks scopedSendSelectiveAcks(true);
+  
+  // Waiting for the 2nd to last id, with everything up to id 2 after the wrap arriving, then 4 after a 2nd gap
+  ReliableConnection receiver(TransportAddress(MakeTestIp(1), 1234));
+  AdvanceTestReceiverTo(receiver, k_MaxReliableSeqId - 1);
+  EXPECT_TRUE(StoreTestMessage(receiver, k_MaxReliableSeqId));
+  EXPECT_TRUE(StoreTestMessage(receiver, 1));
+  EXPECT_TRUE(StoreTestMessage(receiver, 2));
+  EXPECT_TRUE(StoreTestMessage(receiver, 4));
+  
+  EXPECT_TRUE(receiver.IsMissingAnyInRange(k_MaxReliableSeqId - 1, k_MaxReliableSeqId));
+  EXPECT_FALSE(receiver.IsMissingAnyInRange(k_MaxReliableSeqId, 2));
+  EXPECT_TRUE(receiver.IsMissingAnyInRange(2, 4));
+  
+  TestSender sender;
+  sender.SendMessages(k_MaxReliableSeqId - 1, 7);
+  EXPECT_GT(sender._unreliableTransport._numPacketsSent, 0);
+  
+  EXPECT_TRUE(SendSelectiveAck(receiver, sender._connection));
+  EXPECT_EQ(sender._connection.GetNumSelectivelyAckedMessages(), 4);
+  
+  // Filling the first gap hands back the stored messages in order, across the wrap
+  receiver.AdvanceNextInSequenceId();
+  EXPECT_EQ(PopTestMessage(receiver), k_MaxReliableSeqId);
+  EXPECT_EQ(PopTestMessage(receiver), 1);
+  EXPECT_EQ(PopTestMessage(receiver), 2);
+  EXPECT_EQ(PopTestMessage(receiver), k_InvalidReliableSeqId);
+  EXPECT_EQ(receiver.GetNextInSequenceId(), 3);
+  
+  // Only 4 is still listed, which the sender already knew about
+  EXPECT_FALSE(SendSelectiveAck(receiver, sender._connection));
+  EXPECT_TRUE(sender._connection.UpdateLastAckedMessage(2));
+  EXPECT_EQ(sender._connection.GetNumSelectivelyAckedMessages(), 1);
+}
+
+
+TEST_F(ReliableTransportTest, OutOfOrderMessagesFillingTheRing)
+{
+  const ScopedSendSelectiveAcks scopedSendSelectiveAcks(true);
+  const uint32_t kMaxOutOfOrder = ReliableConnection::kMaxOutOfOrderMessages;
+  
+  // Everything up to kMaxOutOfOrder ahead of the missing message is stored, anything further ahead is dropped
+  ReliableConnection receiver(TransportAddress(MakeTestIp(1), 1234));
+  for (uint32_t i=1; i <= kMaxOutOfOrder; ++i)
+  {
+    EXPECT_TRUE(StoreTestMessage(receiver, k_MinReliableSeqId + i));
+  }
+  EXPECT_FALSE(StoreTestMessage(receiver, k_MinReliableSeqId + kMaxOutOfOrder + 1));
+  EXPECT_FALSE(StoreTestMessage(receiver, k_MinReliableSeqId + 1)); // repeat
+  EXPECT_TRUE(receiver.IsMissingAnyInRange(k_MinReliableSeqId, k_MinReliableSeqId + kMaxOutOfOrder));
+  EXPECT_FALSE(receiver.IsMissingAnyInRange(k_MinReliableSeqId + 1, k_MinReliableSeqId + kMaxOutOfOrder));
+  
+  // Every bit of the selective ack is set, and neither end of the range is acked
+  TestSender sender;
+  sender.SendMessages(k_MinReliableSeqId, kMaxOutOfOrder + 2);
+  EXPECT_TRUE(SendSelectiveAck(receiver, sender._connection));
+  EXPECT_EQ(sender._connection.GetNumSelectivelyAckedMessages(), kMaxOutOfOrder);
+  
+  // Once the missing message arrives, the whole ring is handed back and the slots are reused for the messages after it
+  receiver.AdvanceNextInSequenceId();
+  for (uint32_t i=1; i <= kMaxOutOfOrder; ++i)
+  {
+    EXPECT_EQ(PopTestMessage(receiver), k_MinReliableSeqId + i);
+  }
+  EXPECT_EQ(PopTestMessage(receiver), k_InvalidReliableSeqId);
+  
+  const ReliableSequenceId nextInSequenceId = receiver.GetNextInSequenceId();
+  EXPECT_EQ(nextInSequenceId, k_MinReliableSeqId + kMaxOutOfOrder + 1);
+  EXPECT_FALSE(StoreTestMessage(receiver, k_MinReliableSeqId + kMaxOutOfOrder)); // already handed back
+  EXPECT_TRUE(StoreTestMessage(receiver, nextInSequenceId + kMaxOutOfOrder));
+  EXPECT_FALSE(StoreTestMessage(receiver, nextInSequenceId + kMaxOutOfOrder + 1));
+}
+
+
+TEST_F(ReliableTransportTest, DuplicateSelectiveAcks)
+{
+  const ScopedSendSelectiveAcks scopedSendSelectiveAcks(true);
+  
+  ReliableConnection receiver(TransportAddress(MakeTestIp(1), 1234));
+  EXPECT_TRUE(StoreTestMessage(receiver, 3));
+  EXPECT_TRUE(StoreTestMessage(receiver, 5));
+  
+  TestSender sender;
+  sender.SendMessages(k_MinReliableSeqId, 5);
+  ReliableConnection& senderConnection = sender._connection;
+  
+  EXPECT_TRUE(SendSelectiveAck(receiver, senderConnection));
+  EXPECT_EQ(senderConnection.GetNumSelectivelyAckedMessages(), 2);
+  EXPECT_EQ(senderConnection.GetAckRoundTripStats().GetNum(), 2);
+  
+  // The same ack again (e.g. a re-sent or duplicated packet) changes nothing, and adds no round trip times
+  EXPECT_FALSE(SendSelectiveAck(receiver, senderConnection));
+  EXPECT_EQ(senderConnection.GetNumSelectivelyAckedMessages(), 2);
+  EXPECT_EQ(senderConnection.GetAckRoundTripStats().GetNum(), 2);
+  
+  // An ack that lists one more only acks that one
+  EXPECT_TRUE(StoreTestMessage(receiver, 4));
+  EXPECT_TRUE(SendSelectiveAck(receiver, senderConnection));
+  EXPECT_EQ(senderConnection.GetNumSelectivelyAckedMessages(), 3);
+  EXPECT_EQ(senderConnection.GetAckRoundTripStats().GetNum(), 3);
+  
+  // Messages that were selectively acked don't add their round trip time again when the cumulative ack arrives
+  EXPECT_TRUE(senderConnection.UpdateLastAckedMessage(5));
+  EXPECT_EQ(senderConnection.GetNumSelectivelyAckedMessages(), 0);
+  EXPECT_EQ(senderConnection.GetAckRoundTripStats().GetNum(), 5);
+  
+  // Nothing is listed while selective acks are off
+  const ScopedSendSelectiveAcks noSelectiveAcks(false);
+  uint8_t ackPayload[ReliableConnection::kSelectiveAckPayloadSize];
+  EXPECT_EQ(receiver.FillSelectiveAckPayload(ackPayload, sizeof(ackPayload)), 0);
+}
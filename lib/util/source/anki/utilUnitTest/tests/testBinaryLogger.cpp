@@ -0,0 +1,158 @@
+/**
+ * File: testBinaryLogger
+ *
+ * Description: Unit tests for BinaryLogger
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ * --gtest_filter=BinaryLogger*
+ **/
+
+
+#include "util/fileUtils/fileUtils.h"
+#include "util/helpers/includeGTest.h"
+#include "util/logging/binaryLogger.h"
+#include "util/logging/logging.h"
+
+#include <thread>
+
+using namespace Anki::Util;
+
+namespace {
+
+BinaryLogArg IntArg(int64_t value, uint8_t size = 4)
+{
+  BinaryLogArg arg;
+  arg.type = BinaryLogArg::Type::Int;
+  arg.size = size;
+  arg.i = value;
+  return arg;
+}
+
+BinaryLogArg DoubleArg(double value)
+{
+  BinaryLogArg arg;
+  arg.type = BinaryLogArg::Type::Double;
+  arg.d = value;
+  return arg;
+}
+
+BinaryLogArg StringArg(const std::string& value)
+{
+  BinaryLogArg arg;
+  arg.type = BinaryLogArg::Type::String;
+  arg.str = value;
+  return arg;
+}
+
+}
+
+
+TEST(BinaryLogger, Format)
+{
+  EXPECT_EQ(BinaryLogger::Format("no args 100%%", {}), "no args 100%");
+  EXPECT_EQ(BinaryLogger::Format("%d %5.2f %s", {IntArg(-7), DoubleArg(3.14159), StringArg("abc")}), "-7  3.14 abc");
+  EXPECT_EQ(BinaryLogger::Format("%03d|%-4s|%llu", {IntArg(5), StringArg("x"), IntArg(12, 8)}), "005|x   |12");
+  EXPECT_EQ(BinaryLogger::Format("%*d %.*f", {IntArg(4), IntArg(1), IntArg(2), DoubleArg(0.5)}), "   1 0.50");
+
+  // Negative values printed as unsigned keep the width of the original argument
+  EXPECT_EQ(BinaryLogger::Format("%x %u", {IntArg(-1, 1), IntArg(-1, 4)}), "ff 4294967295");
+
+  EXPECT_EQ(BinaryLogger::Format("%d %d", {IntArg(1)}), "1 <missing>");
+}
+
+TEST(BinaryLogger, LogAndRead)
+{
+  const std::string path = "/tmp/testBinaryLogger";
+  FileUtils::RemoveDirectory(path);
+
+  const int kNumThreads = 4;
+  const int kNumMessages = 100;
+  {
+    BinaryLogger logger(path, false);
+
+    // Sites have to outlive every logger, like the static ones the logging macros create
+    static const BinaryLogSite site(LOG_LEVEL_INFO, "TestChannel", "BinaryLogger.Test", "thread %d message %d %s %.1f");
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kNumThreads; ++t) {
+      threads.emplace_back([&logger, t] {
+        for (int i = 0; i < kNumMessages; ++i) {
+          logger.Log(site, t, i, "text", 1.5f);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    logger.Flush();
+  }
+
+  const auto files = FileUtils::FilesInDirectory(path, true);
+  ASSERT_EQ(files.size(), 1);
+  const auto data = FileUtils::ReadFileAsBinary(files.front());
+
+  std::vector<int> nextMessage(kNumThreads, 0);
+  int numRead = 0;
+  uint64_t prevTime_ns = 0;
+  BinaryLogReader reader;
+  const bool ok = reader.Read(data.data(), data.size(), [&](const BinaryLogReader::Message& message) {
+    EXPECT_EQ(message.level, LOG_LEVEL_INFO);
+    EXPECT_EQ(message.channel, "TestChannel");
+    EXPECT_EQ(message.name, "BinaryLogger.Test");
+    EXPECT_GE(message.time_ns, prevTime_ns);
+    prevTime_ns = message.time_ns;
+
+    // Each thread's messages come out in order
+    int t = -1;
+    int i = -1;
+    ASSERT_EQ(sscanf(message.text.c_str(), "thread %d message %d", &t, &i), 2);
+    ASSERT_GE(t, 0);
+    ASSERT_LT(t, kNumThreads);
+    EXPECT_EQ(i, nextMessage[t]);
+    nextMessage[t] = i + 1;
+    EXPECT_EQ(message.text, "thread " + std::to_string(t) + " message " + std::to_string(i) + " text 1.5");
+    ++numRead;
+  });
+  EXPECT_TRUE(ok);
+  EXPECT_EQ(numRead, kNumThreads * kNumMessages);
+
+  FileUtils::RemoveDirectory(path);
+}
+
+TEST(BinaryLogger, DropsWhenFull)
+{
+  const std::string path = "/tmp/testBinaryLoggerDrops";
+  FileUtils::RemoveDirectory(path);
+
+  // Minimum buffer size and a drain period long enough that nothing is drained until Flush
+  const int kNumMessages = 1000;
+  {
+    BinaryLogger logger(path, false, 0, 60 * 1000);
+    static const BinaryLogSite site(LOG_LEVEL_DEBUG, "TestChannel", "BinaryLogger.Drops", "message %d");
+    for (int i = 0; i < kNumMessages; ++i) {
+      logger.Log(site, i);
+    }
+    logger.Flush();
+  }
+
+  const auto files = FileUtils::FilesInDirectory(path, true);
+  ASSERT_EQ(files.size(), 1);
+  const auto data = FileUtils::ReadFileAsBinary(files.front());
+
+  int numMessages = 0;
+  int numDropped = 0;
+  BinaryLogReader reader;
+  EXPECT_TRUE(reader.Read(data.data(), data.size(), [&](const BinaryLogReader::Message& message) {
+    if (message.level == LOG_LEVEL_WARN) {
+      numDropped += std::stoi(message.text);
+    } else {
+      EXPECT_EQ(message.text, "message " + std::to_string(numMessages));
+      ++numMessages;
+    }
+  }));
+  EXPECT_GT(numMessages, 0);
+  EXPECT_GT(numDropped, 0);
+  EXPECT_EQ(numMessages + numDropped, kNumMessages);
+
+  FileUtils::RemoveDirectory(path);
+}
@@ -14,8 +14,11 @@
 
 #include "util/console/consoleInterface.h"
 #include "util/cpuProfiler/cpuProfiler.h"
+#include "util/fileUtils/fileUtils.h"
 #include "util/helpers/includeGTest.h"
 
+#include "json/json.h"
+
 #include <thread>
 
 #if ANKI_PROFILING_ENABLED
@@ -440,4 +443,93 @@ TEST(CpuProfiler, MultiThreadedWithMain)
   }
 }
 
+
+TEST(CpuProfiler, TraceCapture)
+{
+  Anki::Util::CpuProfiler& cpuProfiler = Anki::Util::CpuProfiler::GetInstance();
+  cpuProfiler.Reset();
+  // Don't throw any samples out based on time (otherwise results depend on machine speed)
+  Anki::Util::CpuThreadProfiler::SetMinSampleDuration_ms(-0.01);
+
+  const std::string path = "/tmp/testCpuTraceRecorder";
+  Anki::Util::FileUtils::RemoveDirectory(path);
+
+  Anki::Util::CpuTraceRecorder& traceRecorder = Anki::Util::CpuTraceRecorder::GetInstance();
+  traceRecorder.Init(path, "testProcess");
+
+  FakeMainA(); // not captured
+
+  ASSERT_TRUE(traceRecorder.StartCapture());
+  EXPECT_TRUE(traceRecorder.IsCapturing());
+  EXPECT_FALSE(traceRecorder.StartCapture());
+
+  FakeMainA();
+  {
+    const std::string spanName = "Test\"Span\"";
+    ANKI_CPU_TRACE_SPAN("message", spanName);
+  }
+
+  traceRecorder.StopCapture();
+  EXPECT_FALSE(traceRecorder.IsCapturing());
+
+  FakeMainA(); // not captured
+
+  const auto files = Anki::Util::FileUtils::FilesInDirectory(path, true);
+  ASSERT_EQ(files.size(), 1);
+
+  Json::Value trace;
+  Json::Reader reader;
+  ASSERT_TRUE(reader.parse(Anki::Util::FileUtils::ReadFile(files.front()), trace));
+  ASSERT_TRUE(trace.isArray());
+
+  int numTicks = 0;
+  int numMainA = 0;
+  int numSpans = 0;
+  bool hasProcessName = false;
+  bool hasThreadName = false;
+  double tickStart_us = 0.0;
+  double spanStart_us = 0.0;
+  for (const auto& event : trace)
+  {
+    const std::string phase = event["ph"].asString();
+    const std::string name = event["name"].asString();
+    if (phase == "M")
+    {
+      hasProcessName |= (name == "process_name") && (event["args"]["name"].asString() == "testProcess");
+      hasThreadName  |= (name == "thread_name") && (event["args"]["name"].asString() == "MainThreadA");
+    }
+    else
+    {
+      EXPECT_EQ(phase, "X");
+      EXPECT_GE(event["dur"].asDouble(), 0.0);
+      if (name == "Tick")
+      {
+        EXPECT_EQ(event["cat"].asString(), "tick");
+        tickStart_us = event["ts"].asDouble();
+        ++numTicks;
+      }
+      else if (name == "FakeMainA")
+      {
+        EXPECT_EQ(event["cat"].asString(), "cpu");
+        ++numMainA;
+      }
+      else if (name == "Test\"Span\"")
+      {
+        EXPECT_EQ(event["cat"].asString(), "message");
+        spanStart_us = event["ts"].asDouble();
+        ++numSpans;
+      }
+    }
+  }
+
+  EXPECT_TRUE(hasProcessName);
+  EXPECT_TRUE(hasThreadName);
+  EXPECT_EQ(numTicks, 1);
+  EXPECT_EQ(numMainA, 1);
+  EXPECT_EQ(numSpans, 1);
+  EXPECT_GT(spanStart_us, tickStart_us);
+
+  Anki::Util::FileUtils::RemoveDirectory(path);
+}
+
 #endif // ANKI_PROFILING_ENABLED
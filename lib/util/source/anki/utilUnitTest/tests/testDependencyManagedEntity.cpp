@@ -0,0 +1,473 @@
+/**
+ * File: testDependencyManagedEntity.cpp
+ *
+ * Description: Unit tests for DependencyManagedEntity update scheduling, and a comparison of serial and
+ *              parallel update times as the number of components grows
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ * --gtest_filter=DependencyManagedEntity*
+ **/
+
+
+#include "util/helpers/includeGTest.h"
+#include "util/entityComponent/dependencyManagedEntity.h"
+#include "util/logging/logging.h"
+#include "util/threading/workStealingPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Anki {
+
+enum class TestComponentID {
+  C0, C1, C2, C3, C4, C5, C6, C7, C8, C9, C10, C11, C12, C13, C14, C15,
+  Count
+};
+
+template<>
+std::string GetComponentStringForID<TestComponentID>(TestComponentID enumID)
+{
+  return "C" + std::to_string((int) enumID);
+}
+
+} // namespace Anki
+
+using namespace Anki;
+
+namespace {
+
+using TestEntity = DependencyManagedEntity<TestComponentID>;
+
+class TestComponentBase;
+
+// Shared by all components of a test
+struct UpdateLog
+{
+  std::vector<const TestComponentBase*> components;
+  std::atomic_int numRunning{0};
+  std::atomic_int maxRunning{0};
+  std::atomic_int numOutOfOrder{0};
+  std::chrono::microseconds updateTime{0};
+
+  // the order updates started in
+  std::mutex updateOrderMutex;
+  std::vector<TestComponentID> updateOrder;
+};
+
+class TestComponentBase : public IDependencyManagedComponent<TestComponentID>
+{
+public:
+  template<typename T>
+  TestComponentBase(T* derivedPtr, TestComponentID id) : IDependencyManagedComponent<TestComponentID>(derivedPtr, id) { }
+
+  std::set<TestComponentID> updateDependencies;
+  std::set<TestComponentID> additionalAccessible;
+  std::set<TestComponentID> undeclaredAccesses;
+  bool isThreadSafe = false;
+  UpdateLog* log = nullptr;
+  const TestEntity* entity = nullptr;
+  std::atomic_int numUpdates{0};
+
+  virtual void GetUpdateDependencies(std::set<TestComponentID>& dependencies) const override {
+    dependencies.insert(updateDependencies.begin(), updateDependencies.end());
+  }
+  virtual void AdditionalUpdateAccessibleComponents(std::set<TestComponentID>& components) const override {
+    components.insert(additionalAccessible.begin(), additionalAccessible.end());
+  }
+  virtual bool IsUpdateThreadSafe() const override { return isThreadSafe; }
+
+  virtual void UpdateDependent(const TestEntity& dependentComps) override;
+};
+
+template<TestComponentID ID>
+class TestComponent : public TestComponentBase
+{
+public:
+  TestComponent() : TestComponentBase(this, ID) { }
+};
+
+} // namespace
+
+namespace Anki {
+#define LINK_TEST_COMPONENT(id) \
+template<> \
+void GetComponentIDForType<TestComponentID, TestComponent<TestComponentID::id>>(TestComponentID& enumToSet) { \
+  enumToSet = TestComponentID::id; \
+}
+LINK_TEST_COMPONENT(C0)  LINK_TEST_COMPONENT(C1)  LINK_TEST_COMPONENT(C2)  LINK_TEST_COMPONENT(C3)
+LINK_TEST_COMPONENT(C4)  LINK_TEST_COMPONENT(C5)  LINK_TEST_COMPONENT(C6)  LINK_TEST_COMPONENT(C7)
+LINK_TEST_COMPONENT(C8)  LINK_TEST_COMPONENT(C9)  LINK_TEST_COMPONENT(C10) LINK_TEST_COMPONENT(C11)
+LINK_TEST_COMPONENT(C12) LINK_TEST_COMPONENT(C13) LINK_TEST_COMPONENT(C14) LINK_TEST_COMPONENT(C15)
+#undef LINK_TEST_COMPONENT
+
+} // namespace Anki
+
+namespace {
+
+// access a component through the full entity, the way components reach each other through the robot
+template<TestComponentID ID>
+void AccessComponent(const TestEntity& entity)
+{
+  entity.GetComponent<TestComponent<ID>>();
+}
+
+using AccessFunc = void(*)(const TestEntity&);
+const AccessFunc kAccessFuncs[] = {
+  &AccessComponent<TestComponentID::C0>,  &AccessComponent<TestComponentID::C1>,
+  &AccessComponent<TestComponentID::C2>,  &AccessComponent<TestComponentID::C3>,
+  &AccessComponent<TestComponentID::C4>,  &AccessComponent<TestComponentID::C5>,
+  &AccessComponent<TestComponentID::C6>,  &AccessComponent<TestComponentID::C7>,
+  &AccessComponent<TestComponentID::C8>,  &AccessComponent<TestComponentID::C9>,
+  &AccessComponent<TestComponentID::C10>, &AccessComponent<TestComponentID::C11>,
+  &AccessComponent<TestComponentID::C12>, &AccessComponent<TestComponentID::C13>,
+  &AccessComponent<TestComponentID::C14>, &AccessComponent<TestComponentID::C15>,
+};
+
+void TestComponentBase::UpdateDependent(const TestEntity& dependentComps)
+{
+  const int running = ++log->numRunning;
+  int prevMax = log->maxRunning.load();
+  while ((running > prevMax) && !log->maxRunning.compare_exchange_weak(prevMax, running)) { }
+
+  {
+    TestComponentID id;
+    GetTypeDependent(id);
+    std::lock_guard<std::mutex> lock(log->updateOrderMutex);
+    log->updateOrder.push_back(id);
+  }
+
+  // every dependency has already been updated this tick
+  const int updateIdx = numUpdates.load();
+  for (const auto dependency : updateDependencies) {
+    if (log->components[(int) dependency]->numUpdates.load() != (updateIdx + 1)) {
+      ++log->numOutOfOrder;
+    }
+  }
+
+  for (const auto accessed : undeclaredAccesses) {
+    kAccessFuncs[(int) accessed](*entity);
+  }
+
+  if (log->updateTime.count() > 0) {
+    // stand in for real work, without needing a free core the way busy waiting would
+    std::this_thread::sleep_for(log->updateTime);
+  }
+
+  ++numUpdates;
+  --log->numRunning;
+}
+
+template<TestComponentID ID>
+TestComponentBase* AddTestComponent(TestEntity& entity, UpdateLog& log)
+{
+  auto* component = new TestComponent<ID>();
+  component->log = &log;
+  component->entity = &entity;
+  entity.AddDependentComponent(ID, component);
+  return component;
+}
+
+// Adds numComponents components to the entity, C0 first
+std::vector<TestComponentBase*> AddTestComponents(TestEntity& entity, UpdateLog& log, size_t numComponents)
+{
+  using AddFunc = TestComponentBase*(*)(TestEntity&, UpdateLog&);
+  const AddFunc addFuncs[] = {
+    &AddTestComponent<TestComponentID::C0>,  &AddTestComponent<TestComponentID::C1>,
+    &AddTestComponent<TestComponentID::C2>,  &AddTestComponent<TestComponentID::C3>,
+    &AddTestComponent<TestComponentID::C4>,  &AddTestComponent<TestComponentID::C5>,
+    &AddTestComponent<TestComponentID::C6>,  &AddTestComponent<TestComponentID::C7>,
+    &AddTestComponent<TestComponentID::C8>,  &AddTestComponent<TestComponentID::C9>,
+    &AddTestComponent<TestComponentID::C10>, &AddTestComponent<TestComponentID::C11>,
+    &AddTestComponent<TestComponentID::C12>, &AddTestComponent<TestComponentID::C13>,
+    &AddTestComponent<TestComponentID::C14>, &AddTestComponent<TestComponentID::C15>,
+  };
+  std::vector<TestComponentBase*> components;
+  for (size_t i = 0; i < numComponents; ++i) {
+    components.push_back(addFuncs[i](entity, log));
+  }
+  log.components.assign(components.begin(), components.end());
+  return components;
+}
+
+// Batches, when all are thread safe: C0, C1, C2. C3 (C0), C4 (C1), C5 (C0, C2). C6 (C3, C4), C7 (C5)
+void AddDiamondDependencies(const std::vector<TestComponentBase*>& components)
+{
+  components[3]->updateDependencies = {TestComponentID::C0};
+  components[4]->updateDependencies = {TestComponentID::C1};
+  components[5]->updateDependencies = {TestComponentID::C0, TestComponentID::C2};
+  components[6]->updateDependencies = {TestComponentID::C3, TestComponentID::C4};
+  components[7]->updateDependencies = {TestComponentID::C5};
+}
+
+} // namespace
+
+
+TEST(DependencyManagedEntity, SerialUpdateByDefault)
+{
+  TestEntity entity;
+  UpdateLog log;
+  const auto components = AddTestComponents(entity, log, 8);
+  AddDiamondDependencies(components);
+  for (auto* component : components) {
+    component->isThreadSafe = true;
+  }
+
+  // thread safe components are still updated one at a time without a pool
+  for (int tick = 0; tick < 10; ++tick) {
+    entity.UpdateComponents();
+  }
+  for (auto* component : components) {
+    EXPECT_EQ(10, component->numUpdates.load());
+  }
+  EXPECT_EQ(0, log.numOutOfOrder.load());
+  EXPECT_EQ(1, log.maxRunning.load());
+}
+
+TEST(DependencyManagedEntity, ParallelBatchesKeepDependencyOrder)
+{
+  Util::WorkStealingPool pool(3, "TestPool");
+
+  TestEntity entity;
+  UpdateLog log;
+  log.updateTime = std::chrono::microseconds(200);
+  const auto components = AddTestComponents(entity, log, 8);
+  AddDiamondDependencies(components);
+  for (auto* component : components) {
+    component->isThreadSafe = true;
+  }
+
+  DependencyManagedUpdateSettings settings;
+  settings.pool = &pool;
+  entity.SetUpdateSettings(settings);
+
+  for (int tick = 0; tick < 50; ++tick) {
+    entity.UpdateComponents();
+  }
+  for (auto* component : components) {
+    EXPECT_EQ(50, component->numUpdates.load());
+  }
+  EXPECT_EQ(0, log.numOutOfOrder.load());
+  EXPECT_GT(log.maxRunning.load(), 1);
+  EXPECT_LE(log.maxRunning.load(), 3); // the widest batch
+}
+
+TEST(DependencyManagedEntity, OnlyIndependentThreadSafeComponentsRunConcurrently)
+{
+  Util::WorkStealingPool pool(3, "TestPool");
+  DependencyManagedUpdateSettings settings;
+  settings.pool = &pool;
+
+  // components that don't flag themselves thread safe are updated one at a time
+  {
+    TestEntity entity;
+    UpdateLog log;
+    log.updateTime = std::chrono::microseconds(200);
+    AddTestComponents(entity, log, 4);
+    entity.SetUpdateSettings(settings);
+    for (int tick = 0; tick < 20; ++tick) {
+      entity.UpdateComponents();
+    }
+    EXPECT_EQ(1, log.maxRunning.load());
+  }
+
+  // neither can components that may access each other, even if neither depends on the other
+  {
+    TestEntity entity;
+    UpdateLog log;
+    log.updateTime = std::chrono::microseconds(200);
+    const auto components = AddTestComponents(entity, log, 2);
+    components[0]->isThreadSafe = true;
+    components[1]->isThreadSafe = true;
+    components[1]->additionalAccessible = {TestComponentID::C0};
+    entity.SetUpdateSettings(settings);
+    for (int tick = 0; tick < 20; ++tick) {
+      entity.UpdateComponents();
+    }
+    EXPECT_EQ(1, log.maxRunning.load());
+  }
+}
+
+TEST(DependencyManagedEntity, SerialComponentsKeepPoolLessOrder)
+{
+  Util::WorkStealingPool pool(3, "TestPool");
+
+  // Update order C0 .. C5. Only C3 and C4 can share a batch: C1 is on its own between two serial components
+  auto addComponents = [](TestEntity& entity, UpdateLog& log) {
+    const auto components = AddTestComponents(entity, log, 6);
+    components[1]->isThreadSafe = true;
+    components[2]->updateDependencies = {TestComponentID::C0};
+    components[3]->isThreadSafe = true;
+    components[4]->isThreadSafe = true;
+    components[4]->updateDependencies = {TestComponentID::C1};
+    return components;
+  };
+
+  TestEntity poolLessEntity;
+  UpdateLog poolLessLog;
+  addComponents(poolLessEntity, poolLessLog);
+  poolLessEntity.UpdateComponents();
+  const std::vector<TestComponentID> poolLessOrder = poolLessLog.updateOrder;
+  ASSERT_EQ(6, poolLessOrder.size());
+
+  TestEntity entity;
+  UpdateLog log;
+  log.updateTime = std::chrono::microseconds(200);
+  const auto components = addComponents(entity, log);
+  DependencyManagedUpdateSettings settings;
+  settings.pool = &pool;
+  entity.SetUpdateSettings(settings);
+
+  constexpr int kNumTicks = 20;
+  for (int tick = 0; tick < kNumTicks; ++tick) {
+    entity.UpdateComponents();
+  }
+  ASSERT_EQ(kNumTicks * poolLessOrder.size(), log.updateOrder.size());
+
+  // every component that isn't thread safe is updated at exactly its pool-less position, so everything updated
+  // before it without the pool is still updated before it
+  for (int tick = 0; tick < kNumTicks; ++tick) {
+    for (size_t i = 0; i < poolLessOrder.size(); ++i) {
+      if (!components[(int) poolLessOrder[i]]->isThreadSafe) {
+        EXPECT_EQ(poolLessOrder[i], log.updateOrder[tick * poolLessOrder.size() + i]) << "tick " << tick;
+      }
+    }
+  }
+  EXPECT_EQ(0, log.numOutOfOrder.load());
+  EXPECT_EQ(2, log.maxRunning.load());
+}
+
+TEST(DependencyManagedEntity, CheckUndeclaredAccess)
+{
+  Util::WorkStealingPool pool(2, "TestPool");
+
+  TestEntity entity;
+  UpdateLog log;
+  const auto components = AddTestComponents(entity, log, 4);
+  components[1]->updateDependencies = {TestComponentID::C0};
+  components[2]->additionalAccessible = {TestComponentID::C3};
+  for (auto* component : components) {
+    component->isThreadSafe = true;
+    component->undeclaredAccesses = {TestComponentID::C0, TestComponentID::C3};
+  }
+
+  // nothing is checked unless asked to
+  entity.UpdateComponents();
+  EXPECT_TRUE(entity.GetUndeclaredAccesses().empty());
+
+  for (Util::WorkStealingPool* updatePool : {(Util::WorkStealingPool*) nullptr, &pool}) {
+    DependencyManagedUpdateSettings settings;
+    settings.pool = updatePool;
+    settings.checkUndeclaredAccess = true;
+    entity.SetUpdateSettings(settings);
+    entity.UpdateComponents();
+
+    // accessing yourself or a declared component is fine
+    const std::set<std::pair<TestComponentID, TestComponentID>> expected = {
+      {TestComponentID::C0, TestComponentID::C3},
+      {TestComponentID::C1, TestComponentID::C3},
+      {TestComponentID::C2, TestComponentID::C0},
+      {TestComponentID::C3, TestComponentID::C0},
+    };
+    EXPECT_EQ(expected, entity.GetUndeclaredAccesses());
+  }
+
+  // accesses from outside of an update are never flagged
+  entity.GetComponent<TestComponent<TestComponentID::C3>>();
+  EXPECT_EQ(4, entity.GetUndeclaredAccesses().size());
+}
+
+TEST(DependencyManagedEntity, UpdateTimeByComponentCount)
+{
+  // Independent components all land in one batch, so with a pool the update time should grow with the
+  // number of components divided by the number of threads, instead of with the number of components
+  using Clock = std::chrono::steady_clock;
+  Util::WorkStealingPool pool(3, "TestPool");
+  constexpr int kNumTicks = 10;
+
+  for (const size_t numComponents : {4, 8, 16})
+  {
+    double tickTime_ms[2] = {0.0, 0.0};
+    for (const bool useParallel : {false, true})
+    {
+      TestEntity entity;
+      UpdateLog log;
+      log.updateTime = std::chrono::microseconds(500);
+      const auto components = AddTestComponents(entity, log, numComponents);
+      // a chain across the first few components, so that there's more than one batch
+      components[1]->updateDependencies = {TestComponentID::C0};
+      components[2]->updateDependencies = {TestComponentID::C1};
+      for (auto* component : components) {
+        component->isThreadSafe = true;
+      }
+
+      DependencyManagedUpdateSettings settings;
+      settings.pool = useParallel ? &pool : nullptr;
+      entity.SetUpdateSettings(settings);
+      entity.UpdateComponents(); // builds the cached order
+
+      const auto start = Clock::now();
+      for (int tick = 0; tick < kNumTicks; ++tick) {
+        entity.UpdateComponents();
+      }
+      tickTime_ms[useParallel] = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / kNumTicks;
+      EXPECT_EQ(0, log.numOutOfOrder.load());
+    }
+
+    PRINT_NAMED_INFO("DependencyManagedEntity.UpdateTimeByComponentCount",
+                     "%zu components: serial %.2fms/tick, parallel batches %.2fms/tick",
+                     numComponents, tickTime_ms[0], tickTime_ms[1]);
+    EXPECT_LT(tickTime_ms[1], tickTime_ms[0]);
+  }
+}
+
+TEST(DependencyManagedEntity, TimeUpdates)
+{
+  Util::WorkStealingPool pool(2, "TestPool");
+
+  for (Util::WorkStealingPool* updatePool : {(Util::WorkStealingPool*) nullptr, &pool}) {
+    TestEntity entity;
+    UpdateLog log;
+    log.updateTime = std::chrono::microseconds(1000);
+    const auto components = AddTestComponents(entity, log, 3);
+    components[2]->updateDependencies = {TestComponentID::C0};
+    for (auto* component : components) {
+      component->isThreadSafe = true;
+    }
+
+    // nothing is timed unless asked to
+    entity.UpdateComponents();
+    ASSERT_EQ(3, entity.GetUpdateTimes().size());
+    for (const auto& updateTime : entity.GetUpdateTimes()) {
+      EXPECT_EQ(0.f, updateTime.lastDuration_ms);
+      EXPECT_EQ(0, updateTime.recent_ms.GetNum());
+    }
+
+    DependencyManagedUpdateSettings settings;
+    settings.pool = updatePool;
+    settings.timeUpdates = true;
+    entity.SetUpdateSettings(settings);
+    for (int tick = 0; tick < 5; ++tick) {
+      entity.UpdateComponents();
+    }
+
+    // update times are in update order, so dependencies come first
+    const auto& updateTimes = entity.GetUpdateTimes();
+    const auto c0 = std::find_if(updateTimes.begin(), updateTimes.end(), [](const auto& t) { return t.id == TestComponentID::C0; });
+    const auto c2 = std::find_if(updateTimes.begin(), updateTimes.end(), [](const auto& t) { return t.id == TestComponentID::C2; });
+    ASSERT_TRUE((c0 != updateTimes.end()) && (c2 != updateTimes.end()));
+    EXPECT_LT(c0, c2);
+    EXPECT_GE(c2->lastStart, c0->lastStart + std::chrono::microseconds(1000));
+
+    for (const auto& updateTime : updateTimes) {
+      EXPECT_GE(updateTime.lastDuration_ms, 1.f);
+      EXPECT_EQ(5, updateTime.recent_ms.GetNum());
+      EXPECT_GE(updateTime.recent_ms.GetPercentile(0.f), 1.f);
+      EXPECT_GE(updateTime.recent_ms.GetMax(), updateTime.recent_ms.GetMedian());
+    }
+  }
+}
@@ -0,0 +1,73 @@
+/**
+ * File: testRecentPercentiles.cpp
+ *
+ * Description: Unit tests for RecentPercentiles
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ * --gtest_filter=RecentPercentiles*
+ **/
+
+
+#include "util/helpers/includeGTest.h"
+#include "util/stats/recentPercentiles.h"
+
+
+using namespace Anki::Util::Stats;
+
+
+TEST(RecentPercentiles, Empty)
+{
+  RecentPercentiles percentiles(10);
+  EXPECT_EQ(0, percentiles.GetNum());
+  EXPECT_EQ(10, percentiles.GetMaxValuesToTrack());
+  EXPECT_EQ(0.0f, percentiles.GetMedian());
+  EXPECT_EQ(0.0f, percentiles.GetMax());
+}
+
+
+TEST(RecentPercentiles, Percentiles)
+{
+  RecentPercentiles percentiles(101);
+
+  // 0..100, added out of order
+  for (int i = 0; i <= 100; ++i)
+  {
+    percentiles += (float)((i * 37) % 101);
+  }
+  EXPECT_EQ(101, percentiles.GetNum());
+
+  EXPECT_FLOAT_EQ(0.0f,   percentiles.GetPercentile(0.0f));
+  EXPECT_FLOAT_EQ(50.0f,  percentiles.GetMedian());
+  EXPECT_FLOAT_EQ(90.0f,  percentiles.GetPercentile(0.9f));
+  EXPECT_FLOAT_EQ(99.0f,  percentiles.GetPercentile(0.99f));
+  EXPECT_FLOAT_EQ(100.0f, percentiles.GetPercentile(1.0f));
+  EXPECT_FLOAT_EQ(100.0f, percentiles.GetMax());
+
+  // out of range percentiles are clamped
+  EXPECT_FLOAT_EQ(0.0f,   percentiles.GetPercentile(-1.0f));
+  EXPECT_FLOAT_EQ(100.0f, percentiles.GetPercentile(2.0f));
+}
+
+
+TEST(RecentPercentiles, OnlyRecentValues)
+{
+  RecentPercentiles percentiles(4);
+
+  percentiles.AddStat(100.0f);
+  percentiles.AddStat(1.0f);
+  percentiles.AddStat(2.0f);
+  percentiles.AddStat(3.0f);
+  EXPECT_FLOAT_EQ(100.0f, percentiles.GetMax());
+
+  // the 100 is the oldest, so it's the first to go
+  percentiles.AddStat(4.0f);
+  EXPECT_EQ(4, percentiles.GetNum());
+  EXPECT_FLOAT_EQ(4.0f, percentiles.GetMax());
+  EXPECT_FLOAT_EQ(1.0f, percentiles.GetPercentile(0.0f));
+
+  percentiles.Clear();
+  EXPECT_EQ(0, percentiles.GetNum());
+  percentiles.AddStat(7.0f);
+  EXPECT_FLOAT_EQ(7.0f, percentiles.GetMedian());
+}
@@ -0,0 +1,103 @@
+/**
+ * File: testWorkStealingPool.cpp
+ *
+ * Description: Unit tests for WorkStealingPool
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ * --gtest_filter=WorkStealingPool*
+ **/
+
+
+#include "util/helpers/includeGTest.h"
+#include "util/threading/workStealingPool.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace Anki::Util;
+
+TEST(WorkStealingPool, RunsEveryTask)
+{
+  for (const size_t numThreads : {0, 1, 4})
+  {
+    WorkStealingPool pool(numThreads, "TestPool");
+    EXPECT_EQ(numThreads, pool.GetNumThreads());
+
+    // waiting on an empty group returns right away
+    WorkStealingPool::TaskGroup emptyGroup;
+    pool.Wait(emptyGroup);
+    EXPECT_TRUE(emptyGroup.IsDone());
+
+    std::atomic_int count(0);
+    WorkStealingPool::TaskGroup group;
+    for (int i = 0; i < 1000; ++i) {
+      pool.Run(group, [&count] { ++count; });
+    }
+    pool.Wait(group);
+    EXPECT_TRUE(group.IsDone());
+    EXPECT_EQ(1000, count.load());
+  }
+}
+
+TEST(WorkStealingPool, TasksCanWaitOnTasks)
+{
+  // every task waits on tasks of its own, which would deadlock if waiting threads didn't run queued tasks
+  for (const size_t numThreads : {0, 1, 3})
+  {
+    WorkStealingPool pool(numThreads, "TestPool");
+
+    std::atomic_int count(0);
+    WorkStealingPool::TaskGroup group;
+    for (int i = 0; i < 8; ++i) {
+      pool.Run(group, [&pool, &count] {
+        WorkStealingPool::TaskGroup innerGroup;
+        for (int j = 0; j < 8; ++j) {
+          pool.Run(innerGroup, [&count] { ++count; });
+        }
+        pool.Wait(innerGroup);
+        EXPECT_TRUE(innerGroup.IsDone());
+      });
+    }
+    pool.Wait(group);
+    EXPECT_EQ(64, count.load());
+  }
+}
+
+TEST(WorkStealingPool, RunsTasksConcurrently)
+{
+  WorkStealingPool pool(3, "TestPool");
+
+  std::atomic_int numRunning(0);
+  std::atomic_int maxRunning(0);
+  WorkStealingPool::TaskGroup group;
+  for (int i = 0; i < 8; ++i) {
+    pool.Run(group, [&numRunning, &maxRunning] {
+      const int running = ++numRunning;
+      int prevMax = maxRunning.load();
+      while ((running > prevMax) && !maxRunning.compare_exchange_weak(prevMax, running)) { }
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      --numRunning;
+    });
+  }
+  pool.Wait(group);
+
+  // three workers plus the waiting thread
+  EXPECT_GT(maxRunning.load(), 1);
+  EXPECT_LE(maxRunning.load(), 4);
+}
+
+TEST(WorkStealingPool, DestructorRunsQueuedTasks)
+{
+  std::atomic_int count(0);
+  WorkStealingPool::TaskGroup group;
+  {
+    WorkStealingPool pool(2, "TestPool");
+    for (int i = 0; i < 100; ++i) {
+      pool.Run(group, [&count] { ++count; });
+    }
+  }
+  EXPECT_TRUE(group.IsDone());
+  EXPECT_EQ(100, count.load());
+}
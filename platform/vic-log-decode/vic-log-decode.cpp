@@ -0,0 +1,89 @@
+/**
+* File: vic-log-decode.cpp
+*
+* Description: Prints binary log files written by Util::BinaryLogger (VIC_BINARY_LOGGING) as text
+*
+* Copyright: Anki, inc. 2026
+*
+*/
+
+#include "util/logging/binaryLogger.h"
+
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* const kLevelNames[] = {"DEBUG", "INFO", "EVENT", "WARN", "ERROR"};
+
+void error(const char * cmd, const char * str)
+{
+  fprintf(stderr, "%s: %s\n", cmd, str);
+}
+
+void usage(const char * cmd)
+{
+  fprintf(stderr, "Usage: %s file [file ...]\n", cmd);
+}
+
+void print(const Anki::Util::BinaryLogReader::Message& message)
+{
+  const time_t seconds = static_cast<time_t>(message.time_ns / 1000000000);
+  const unsigned int millis = static_cast<unsigned int>((message.time_ns / 1000000) % 1000);
+  struct tm localTime;
+  localtime_r(&seconds, &localTime);
+  char timeBuffer[32];
+  strftime(timeBuffer, sizeof(timeBuffer), "%m-%d %H:%M:%S", &localTime);
+
+  const size_t level = static_cast<size_t>(message.level);
+  const char* levelName = (level < sizeof(kLevelNames) / sizeof(kLevelNames[0])) ? kLevelNames[level] : "?";
+
+  printf("%s.%03u %s [@%s] %s: %s\n", timeBuffer, millis, levelName,
+         message.channel.c_str(), message.name.c_str(), message.text.c_str());
+}
+
+}
+
+int main(int argc, const char * argv[])
+{
+  std::vector<std::string> files;
+
+  // Process command line
+  for (int i = 1; i < argc; ++i) {
+    const std::string & arg = argv[i];
+    if (arg == "-h" || arg == "--help") {
+      usage(argv[0]);
+      exit(0);
+    }
+    files.push_back(arg);
+  }
+
+  if (files.empty()) {
+    error(argv[0], "No files given");
+    usage(argv[0]);
+    exit(1);
+  }
+
+  // Each file starts with every site known when it was created, so files can be decoded on their own
+  int result = 0;
+  for (const auto & file : files) {
+    std::ifstream stream(file, std::ios::binary);
+    if (!stream) {
+      error(argv[0], ("Unable to open " + file).c_str());
+      result = 1;
+      continue;
+    }
+    const std::vector<uint8_t> data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+    Anki::Util::BinaryLogReader reader;
+    if (!reader.Read(data.data(), data.size(), print)) {
+      error(argv[0], ("Malformed or truncated data in " + file).c_str());
+      result = 1;
+    }
+  }
+
+  return result;
+}
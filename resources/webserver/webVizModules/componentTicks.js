@@ -0,0 +1,129 @@
+/**
+ * File: componentTicks.js
+ *
+ * Description: Flame view of the last tick in which a component went over its update budget, and a table of
+ *              every component's recent update time percentiles
+ *
+ * Copyright: Anki, Inc. 2026
+ **/
+
+(function(myMethods, sendData) {
+
+  var canvasWidth = 1200;
+  var rowHeight = 22;
+  var numRows = 3; // robot, AI and behavior components
+
+  var percentilesTable;
+
+  function drawOverrun(data) {
+    var canvas = $('#componentTicksCanvas')[0];
+    var context = canvas.getContext("2d");
+    context.clearRect(0, 0, canvas.width, canvas.height);
+
+    var tickLength_ms = 0;
+    data.spans.forEach(function(span) {
+      tickLength_ms = Math.max(tickLength_ms, span.start_ms + span.duration_ms);
+    });
+    if (tickLength_ms <= 0) {
+      return;
+    }
+    var pxPerMs = canvasWidth / tickLength_ms;
+
+    context.font = "normal 12px Arial";
+    context.textBaseline = "middle";
+    context.textAlign = "start";
+    data.spans.forEach(function(span) {
+      var x = span.start_ms * pxPerMs;
+      var width = Math.max(span.duration_ms * pxPerMs, 1);
+      var y = span.depth * rowHeight;
+      var overBudget = (span.duration_ms > span.budget_ms);
+
+      context.fillStyle = overBudget ? "#e0443e" : "#8fbce6";
+      context.fillRect(x, y, width, rowHeight - 2);
+
+      // only label the spans that have room for it
+      var label = span.name.substring(span.name.indexOf('.') + 1) + " " + span.duration_ms.toFixed(2) + "ms";
+      if (context.measureText(label).width < width - 4) {
+        context.fillStyle = "#000000";
+        context.fillText(label, x + 2, y + rowHeight / 2);
+      }
+    });
+
+    var overBudgetNames = data.spans.filter(function(span) {
+      return span.duration_ms > span.budget_ms;
+    }).map(function(span) {
+      return span.name + " (" + span.duration_ms.toFixed(2) + " / " + span.budget_ms.toFixed(2) + "ms)";
+    });
+    $('#componentTicksOverrunInfo').text('Last overrun at ' + data.time_s.toFixed(1) + 's, tick of ' +
+                                         tickLength_ms.toFixed(2) + 'ms: ' + overBudgetNames.join(', '));
+  }
+
+  function updatePercentiles(data) {
+    var rows = data.components.map(function(comp) {
+      return [comp.name,
+              comp.budget_ms.toFixed(2),
+              comp.p50_ms.toFixed(3),
+              comp.p90_ms.toFixed(3),
+              comp.p99_ms.toFixed(3),
+              comp.max_ms.toFixed(3)];
+    });
+    percentilesTable.clear();
+    percentilesTable.rows.add(rows);
+    percentilesTable.draw(false);
+  }
+
+  myMethods.init = function(elem) {
+
+    if ( location.port != '8888' ) {
+      $('<h3>You must use this tab with the engine process (port 8888)</h3>').appendTo(elem);
+      return;
+    }
+
+    $('<h3>Last tick with a component over budget</h3>').appendTo(elem);
+    $('<div id="componentTicksOverrunInfo">No component has gone over budget yet</div>').appendTo(elem);
+    $('<canvas></canvas>', {id: 'componentTicksCanvas'}).appendTo(elem);
+    var canvas = $('#componentTicksCanvas')[0];
+    canvas.width = canvasWidth;
+    canvas.height = numRows * rowHeight;
+
+    $('<h3>Recent update times (ms)</h3>').appendTo(elem);
+    var table = $('<table id="componentTicksTable" class="display" width="100%"></table>').appendTo(elem);
+    percentilesTable = table.DataTable({
+      columns: [
+        { title: "Component" },
+        { title: "Budget" },
+        { title: "P50" },
+        { title: "P90" },
+        { title: "P99" },
+        { title: "Max" }
+      ],
+      order: [[ 4, "desc" ]],
+      paging: false,
+      searching: true
+    });
+  };
+
+  myMethods.onData = function(data, elem) {
+    if ( location.port != '8888' ) {
+      return;
+    }
+    if (data.type == "overrun") {
+      drawOverrun(data);
+    } else if (data.type == "percentiles") {
+      updatePercentiles(data);
+    }
+  };
+
+  myMethods.update = function(dt, elem) {
+  };
+
+  myMethods.getStyles = function() {
+    return `
+      #componentTicksCanvas {
+        border: 1px solid #cccccc;
+        margin: 5px 0px 15px 0px;
+      }
+    `;
+  };
+
+})(moduleMethods, moduleSendDataFunc);
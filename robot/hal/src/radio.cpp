@@ -17,7 +17,7 @@
 #include <stdio.h>
 #include <string>
 
-#include "coretech/messaging/shared/LocalUdpServer.h"
+#include "coretech/messaging/shared/LocalTransport.h"
 #include "coretech/messaging/shared/socketConstants.h"
 
 #define ARRAY_SIZE(inArray)   (sizeof(inArray) / sizeof((inArray)[0]))
@@ -30,7 +30,7 @@ namespace Anki {
       const size_t RECV_BUFFER_SIZE = 1024 * 4;
 
       // For communications with basestation
-      LocalUdpServer server;
+      LocalTransportServer server;
 
       u8 recvBuf_[RECV_BUFFER_SIZE];
       size_t recvBufSize_ = 0;
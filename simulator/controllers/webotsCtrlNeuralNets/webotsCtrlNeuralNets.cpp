@@ -56,6 +56,12 @@ protected:
     _shouldStop = (rc == -1);
   }
   
+  virtual bool CanWaitForImages() const override
+  {
+    // Simulation time only advances when we step, so never block waiting for images
+    return false;
+  }
+  
 private:
   webots::Supervisor _webotsSupervisor;
   std::unique_ptr<Util::PrintfLoggerProvider> _logger;
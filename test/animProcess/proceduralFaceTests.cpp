@@ -8,6 +8,7 @@
 #include "coretech/common/shared/types.h"
 #include "coretech/common/shared/array2d_impl.h"
 #include "cannedAnimLib/proceduralFace/proceduralFaceDrawer.h"
+#include "util/console/consoleInterface.h"
 #include "util/random/randomGenerator.h"
 #include "util/fileUtils/fileUtils.h"
 
@@ -15,6 +16,13 @@
 #define DISPLAY_FAILURES 0
 #define SAVE_FAILURE_DIFFS 0
 
+namespace Anki {
+namespace Vector {
+  CONSOLE_VAR_EXTERN(bool, kProcFace_DirtyRegions);
+  CONSOLE_VAR_EXTERN(s32, kProcFace_NoiseNumFrames);
+}
+}
+
 using namespace Anki;
 using namespace Anki::Vector;
 
@@ -297,3 +305,91 @@ TEST(ProceduralFace, RenderParamsCheck)
   testFaceAgainstStoredVersion(procFace, Util::FileUtils::FullFilePath({resourcePath, "test", "animProcessTests", "anim_eyes_neutral_hotspot.png"}));
 
 } // TEST(ProceduralFace, RenderParamsCheck)
+
+
+// Render a sequence of faces with and without dirty region tracking and make sure the output is identical
+TEST(ProceduralFace, DirtyRegionsMatchFullRender)
+{
+  ProceduralFace neutral;
+  neutral.SetFromValues({ 9.169665777907909, 0.0, 1.2143329245079946, 0.9052803986393223, 0.0, 0.5, 0.5, 0.5, 0.5, 0.5, 0.5, 0.5, 0.5, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 },
+                        { -10.206374337270427, 0.0, 1.2220369812777003, 0.9052803986393223, 0.0, 0.5, 0.5, 0.5, 0.5, 0.5, 0.5, 0.5, 0.5, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 },
+                        0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f);
+
+  // Idle frames, single eye changes, a blink, whole face changes and a color change
+  std::vector<ProceduralFace> faces(3, neutral);
+  for(int i=1; i<=3; ++i) {
+    ProceduralFace face = neutral;
+    face.SetParameter(ProceduralFace::Left, ProceduralFace::Parameter::EyeCenterX, -4.f*i);
+    face.SetParameter(ProceduralFace::Left, ProceduralFace::Parameter::UpperLidY, 0.1f*i);
+    faces.push_back(face);
+  }
+  for(int i=1; i<=3; ++i) {
+    ProceduralFace face = faces.back();
+    face.SetParameter(ProceduralFace::Right, ProceduralFace::Parameter::EyeScaleY, 1.f - 0.2f*i);
+    faces.push_back(face);
+  }
+  {
+    ProceduralFace face = faces.back();
+    BlinkState blinkState;
+    TimeStamp_t offset;
+    while(ProceduralFaceDrawer::GetNextBlinkFrame(face, blinkState, offset)) {
+      faces.push_back(face);
+    }
+    faces.push_back(face);
+  }
+  for(int i=1; i<=3; ++i) {
+    ProceduralFace face = neutral;
+    face.LookAt(10.f*i, -5.f*i, 100.f, 100.f);
+    faces.push_back(face);
+    faces.push_back(face);
+  }
+  {
+    ProceduralFace face = neutral;
+    face.SetFaceAngle(10.f);
+    faces.push_back(face);
+    faces.push_back(face);
+  }
+  const size_t colorChangeIndex = faces.size();
+  faces.push_back(neutral);
+  faces.push_back(neutral);
+
+  // The noise image cycles on every frame, so use a single one to get the same output in both passes
+  const s32 origNoiseNumFrames = kProcFace_NoiseNumFrames;
+  const bool origDirtyRegions = kProcFace_DirtyRegions;
+  kProcFace_NoiseNumFrames = 1;
+
+  Util::RandomGenerator rng(1);
+
+  auto renderAll = [&](std::vector<Vision::ImageRGB565>& images) {
+    ProceduralFace::ResetHueToDefault();
+    for(size_t i=0; i<faces.size(); ++i) {
+      if(i == colorChangeIndex) {
+        ProceduralFace::SetHue(0.8f);
+      }
+      Vision::ImageRGB565 img;
+      ProceduralFaceDrawer::DrawFace(faces[i], rng, img);
+      images.push_back(img);
+    }
+    ProceduralFace::ResetHueToDefault();
+  };
+
+  std::vector<Vision::ImageRGB565> fullImages;
+  kProcFace_DirtyRegions = false;
+  renderAll(fullImages);
+
+  std::vector<Vision::ImageRGB565> dirtyImages;
+  kProcFace_DirtyRegions = true;
+  renderAll(dirtyImages);
+
+  kProcFace_NoiseNumFrames = origNoiseNumFrames;
+  kProcFace_DirtyRegions = origDirtyRegions;
+
+  ASSERT_EQ(fullImages.size(), dirtyImages.size());
+  for(size_t i=0; i<fullImages.size(); ++i) {
+    SCOPED_TRACE(i);
+    ASSERT_EQ(fullImages[i].GetNumElements(), dirtyImages[i].GetNumElements());
+    EXPECT_EQ(0, memcmp(fullImages[i].GetDataPointer(), dirtyImages[i].GetDataPointer(),
+                        fullImages[i].GetNumElements() * sizeof(Vision::PixelRGB565)));
+  }
+
+} // TEST(ProceduralFace, DirtyRegionsMatchFullRender)
@@ -22,6 +22,8 @@
 
 #include "util/fileUtils/fileUtils.h"
 
+#include <algorithm>
+
 using namespace Anki;
 using namespace Vector;
 
@@ -174,3 +176,133 @@ TEST(AnimationTest, AnimationCopying)
   
 } // AnimationTest.AnimationCopying
 
+
+
+// Make sure animations which are only indexed at load time and decoded on demand match fully loaded ones, including
+// after they have been freed and decoded again
+TEST(AnimationTest, LazyAnimationLoading)
+{
+  const auto kPathToDevData = "assets/dev_animation_data";
+  const auto fullPath = cozmoContext->GetDataPlatform()->GetResourcePath(kPathToDevData);
+  const bool useFullPath = true;
+  const bool shouldRecurse = false;
+
+  Robot robot(0, cozmoContext);
+  auto platform = cozmoContext->GetDataPlatform();
+  auto spriteSequenceContainer = robot.GetComponent<DataAccessorComponent>().GetSpriteSequenceContainer();
+  std::atomic<float> loadingCompleteRatio(0);
+  std::atomic<bool>  abortLoad(false);
+
+  const std::vector<const char*> binExt = {"bin"};
+  CannedAnimationLoader::AnimDirInfo binaryFileInfo;
+  binaryFileInfo.jsonFiles = Util::FileUtils::FilesInDirectory(fullPath, useFullPath, binExt, shouldRecurse);
+
+  CannedAnimationContainer binaryAnimContainer;
+  {
+    CannedAnimationLoader animLoader(platform,
+                                     spriteSequenceContainer,
+                                     loadingCompleteRatio, abortLoad);
+    animLoader.LoadAnimationsIntoContainer(binaryFileInfo, &binaryAnimContainer);
+  }
+
+  const size_t kMaxDecodedAnims = 4;
+  CannedAnimationContainer lazyAnimContainer;
+  lazyAnimContainer.EnableLazyLoading(spriteSequenceContainer, kMaxDecodedAnims);
+  {
+    CannedAnimationLoader animLoader(platform,
+                                     spriteSequenceContainer,
+                                     loadingCompleteRatio, abortLoad);
+    animLoader.LoadAnimationsIntoContainer(binaryFileInfo, &lazyAnimContainer);
+  }
+  EXPECT_EQ(0u, lazyAnimContainer.GetNumDecodedLazyAnimations());
+
+  auto binaryAnimNames = binaryAnimContainer.GetAnimationNames();
+  auto lazyAnimNames = lazyAnimContainer.GetAnimationNames();
+  std::sort(binaryAnimNames.begin(), binaryAnimNames.end());
+  std::sort(lazyAnimNames.begin(), lazyAnimNames.end());
+  EXPECT_EQ(binaryAnimNames, lazyAnimNames);
+
+  // go through everything twice, so that animations get freed and decoded again if there are enough of them
+  for(int pass = 0; pass < 2; ++pass) {
+    for(const auto& name: binaryAnimNames){
+      Animation* binaryAnim = binaryAnimContainer.GetAnimation(name);
+      Animation* lazyAnim   = lazyAnimContainer.GetAnimation(name);
+      ASSERT_TRUE(binaryAnim != nullptr);
+      ASSERT_TRUE(lazyAnim != nullptr);
+
+      EXPECT_TRUE(*binaryAnim == *lazyAnim) << "Lazily loaded animation " << name << " does not match";
+      EXPECT_LE(lazyAnimContainer.GetNumDecodedLazyAnimations(), kMaxDecodedAnims);
+    }
+  }
+
+} // AnimationTest.LazyAnimationLoading
+
+
+// The anim streamer pins the animation it is streaming. Make sure looking up enough other animations to force
+// evictions while it "streams" doesn't free it, and that it can be freed again once it's unpinned
+TEST(AnimationTest, LazyAnimationPinnedWhileStreaming)
+{
+  const auto kPathToDevData = "assets/dev_animation_data";
+  const auto fullPath = cozmoContext->GetDataPlatform()->GetResourcePath(kPathToDevData);
+  const bool useFullPath = true;
+  const bool shouldRecurse = false;
+
+  Robot robot(0, cozmoContext);
+  auto platform = cozmoContext->GetDataPlatform();
+  auto spriteSequenceContainer = robot.GetComponent<DataAccessorComponent>().GetSpriteSequenceContainer();
+  std::atomic<float> loadingCompleteRatio(0);
+  std::atomic<bool>  abortLoad(false);
+
+  const std::vector<const char*> binExt = {"bin"};
+  CannedAnimationLoader::AnimDirInfo binaryFileInfo;
+  binaryFileInfo.jsonFiles = Util::FileUtils::FilesInDirectory(fullPath, useFullPath, binExt, shouldRecurse);
+
+  const size_t kMaxDecodedAnims = 4;
+  CannedAnimationContainer lazyAnimContainer;
+  lazyAnimContainer.EnableLazyLoading(spriteSequenceContainer, kMaxDecodedAnims);
+  {
+    CannedAnimationLoader animLoader(platform,
+                                     spriteSequenceContainer,
+                                     loadingCompleteRatio, abortLoad);
+    animLoader.LoadAnimationsIntoContainer(binaryFileInfo, &lazyAnimContainer);
+  }
+
+  auto animNames = lazyAnimContainer.GetAnimationNames();
+  std::sort(animNames.begin(), animNames.end());
+  ASSERT_GT(animNames.size(), kMaxDecodedAnims + 1) << "Not enough animations to force evictions";
+
+  // What the streamer does when it starts streaming an animation: pin it, pinned twice to check pins are counted
+  const std::string& streamingName = animNames.front();
+  lazyAnimContainer.PinAnimation(streamingName);
+  lazyAnimContainer.PinAnimation(streamingName);
+  const Animation* streamingAnim = lazyAnimContainer.GetAnimation(streamingName);
+  ASSERT_TRUE(streamingAnim != nullptr);
+  const Animation streamingAnimCopy(*streamingAnim);
+
+  // Look up every other animation, more than enough to evict anything that isn't pinned
+  const auto lookUpOthers = [&]() {
+    for(size_t i = 1; i < animNames.size(); ++i) {
+      EXPECT_TRUE(lazyAnimContainer.GetAnimation(animNames[i]) != nullptr);
+      EXPECT_LE(lazyAnimContainer.GetNumDecodedLazyAnimations(), kMaxDecodedAnims);
+    }
+  };
+
+  lookUpOthers();
+  EXPECT_EQ(streamingAnim, lazyAnimContainer.GetAnimation(streamingName));
+  EXPECT_TRUE(streamingAnimCopy == *streamingAnim);
+
+  lazyAnimContainer.UnpinAnimation(streamingName);
+  lookUpOthers();
+  EXPECT_EQ(streamingAnim, lazyAnimContainer.GetAnimation(streamingName));
+  EXPECT_TRUE(streamingAnimCopy == *streamingAnim);
+
+  // Done streaming. It is the most recently used animation now, and gets freed once enough others are looked up
+  lazyAnimContainer.UnpinAnimation(streamingName);
+  EXPECT_LE(lazyAnimContainer.GetNumDecodedLazyAnimations(), kMaxDecodedAnims);
+  lookUpOthers();
+
+  const Animation* redecodedAnim = lazyAnimContainer.GetAnimation(streamingName);
+  ASSERT_TRUE(redecodedAnim != nullptr);
+  EXPECT_TRUE(streamingAnimCopy == *redecodedAnim);
+
+} // AnimationTest.LazyAnimationPinnedWhileStreaming
@@ -0,0 +1,67 @@
+/**
+ * File: testCubeAccelComponent.cpp
+ *
+ * Description: Unit tests for CubeAccelComponent
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ * --gtest_filter=CubeAccelComponent*
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "engine/blockWorld/blockWorld.h"
+#include "engine/components/cubes/cubeAccelComponent.h"
+#include "engine/components/cubes/cubeAccelListeners/iCubeAccelListener.h"
+#include "engine/cozmoContext.h"
+#include "engine/robot.h"
+
+#include <memory>
+#include <thread>
+
+extern Anki::Vector::CozmoContext* cozmoContext;
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+namespace {
+
+class TestAccelListener : public CubeAccelListeners::ICubeAccelListener
+{
+protected:
+  virtual void InitInternal(const ActiveAccel& accel) override { }
+  virtual void UpdateInternal(const ActiveAccel& accel) override { }
+};
+
+}
+
+// The component flags itself update thread safe, so it may be updated on a component update pool thread
+TEST(CubeAccelComponent, UpdateOnPoolThread)
+{
+  Robot robot(1, cozmoContext);
+  auto& cubeAccel = robot.GetComponent<CubeAccelComponent>();
+  EXPECT_TRUE(cubeAccel.IsUpdateThreadSafe());
+
+  const ObjectID objectID = robot.GetBlockWorld().AddConnectedBlock(0, "AA:AA:AA:AA:AA:AA", ObjectType::Block_LIGHTCUBE1);
+  ASSERT_TRUE(objectID.IsSet());
+
+  auto usedListener = std::make_shared<TestAccelListener>();
+  auto unusedListener = std::make_shared<TestAccelListener>();
+  ASSERT_TRUE(cubeAccel.AddListener(objectID, usedListener));
+  ASSERT_TRUE(cubeAccel.AddListener(objectID, unusedListener));
+  EXPECT_EQ(2, usedListener.use_count());
+
+  std::weak_ptr<TestAccelListener> unusedListenerRef = unusedListener;
+  unusedListener.reset();
+  EXPECT_FALSE(unusedListenerRef.expired());
+
+  // Updated off the engine thread, and with no other components at all since the update touches none
+  RobotCompMap noComponents;
+  std::thread updateThread([&cubeAccel, &noComponents] { cubeAccel.UpdateDependent(noComponents); });
+  updateThread.join();
+
+  // Only the listener that nobody else holds is removed
+  EXPECT_TRUE(unusedListenerRef.expired());
+  EXPECT_EQ(2, usedListener.use_count());
+}
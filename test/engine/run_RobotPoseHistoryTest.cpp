@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
 
+#include "anki/cozmo/shared/cozmoConfig.h"
+
 #include "coretech/common/engine/math/pose.h"
 #include "coretech/common/shared/types.h"
 
@@ -7,6 +9,9 @@
 
 #include "engine/robot.h"
 
+#include <set>
+#include <vector>
+
 #define private public
 #define protected public
 
@@ -238,18 +243,23 @@ TEST(RobotStateHistory, GroundTruthPose)
   
   
   // 4) Check that there are no computed poses in history
-  HistRobotState *hrs = nullptr;
-  ASSERT_TRUE(hist.GetComputedStateAt(t3, &hrs) == RESULT_FAIL);
+  HistRobotState hrs;
+  ASSERT_TRUE(hist.GetComputedStateAt(t3, hrs) == RESULT_FAIL);
   
   // Compute pose at t3 again but this time insert it as well
-  ASSERT_TRUE(hist.ComputeAndInsertStateAt(t3, t, &hrs) == RESULT_OK);
-  ASSERT_TRUE(hrs != nullptr);
+  HistStateKey key = 0;
+  ASSERT_TRUE(hist.ComputeAndInsertStateAt(t3, t, hrs, &key) == RESULT_OK);
+  ASSERT_TRUE(hist.IsValidKey(key));
   
   // Get the computed pose.
-  // Should be the exact same as rps.
-  HistRobotState *hrs2 = nullptr;
-  ASSERT_TRUE(hist.GetComputedStateAt(t3, &hrs2) == RESULT_OK);
-  ASSERT_TRUE(hrs == hrs2);
+  // Should be the exact same as the one stored in history.
+  HistRobotState hrs2;
+  HistStateKey key2 = 0;
+  ASSERT_TRUE(hist.GetComputedStateAt(t3, hrs2, &key2) == RESULT_OK);
+  ASSERT_EQ(key, key2);
+  ASSERT_TRUE(hrs2.GetPose() == hrs.GetPose());
+  ASSERT_TRUE(hist.GetComputedState(key) != nullptr);
+  ASSERT_TRUE(hist.GetComputedState(key)->GetPose() == hrs.GetPose());
   
   // 5) Get latest vision only pose
   ASSERT_TRUE(hist.GetLatestVisionOnlyState(t, histState) == RESULT_OK);
@@ -278,25 +288,212 @@ TEST(RobotStateHistory, CullToWindowSizeTest)
     
     if (t % 1000 == 0) {
       RobotTimeStamp_t actualTime;
-      HistRobotState *statePtr;
-      hist.ComputeAndInsertStateAt(t, actualTime, &statePtr);
+      HistRobotState computedState;
+      hist.ComputeAndInsertStateAt(t, actualTime, computedState);
     }
   }
 
-  printf("CullToWindowSizeTest: raw %zu, vis %zu, comp %zu, keyByTs %zu, tsByKey %zu\n",
-         hist._states.size(),
-         hist._visStates.size(),
-         hist._computedStates.size(),
-         hist._keyByTsMap.size(),
-         hist._tsByKeyMap.size());
-
   
   // Verify that history stays at size no larger than 3s
   ASSERT_TRUE(hist._states.size() == 31);
   
   ASSERT_TRUE(hist._visStates.size() == 0);
   ASSERT_TRUE(hist._computedStates.size() == 3);
-  ASSERT_TRUE(hist._keyByTsMap.size() == 3);
-  ASSERT_TRUE(hist._tsByKeyMap.size() == 3);
   
+  // Only the keys of the remaining computed states are valid
+  for (size_t i=0; i<hist._computedStates.size(); ++i) {
+    ASSERT_TRUE(hist.IsValidKey(hist._computedStates[i].key));
+  }
+  ASSERT_FALSE(hist.IsValidKey(hist._computedStates[0].key - 1));
+  ASSERT_FALSE(hist.IsValidKey(0));
+  
+}
+
+TEST(RobotStateHistory, OutOfOrderStates)
+{
+  using namespace Anki;
+  using namespace Vector;
+  
+  HistStateBuffer buffer(4);
+  HistRobotState histState;
+  
+  // Out of order inserts keep entries sorted, duplicates are rejected
+  ASSERT_EQ(0, buffer.Insert(20, histState));
+  ASSERT_EQ(1, buffer.Insert(40, histState));
+  ASSERT_EQ(1, buffer.Insert(30, histState));
+  ASSERT_EQ(0, buffer.Insert(10, histState));
+  ASSERT_EQ(buffer.size(), buffer.Insert(30, histState));
+  ASSERT_EQ(4, buffer.size());
+  
+  ASSERT_EQ(1, buffer.Find(20));
+  ASSERT_EQ(buffer.size(), buffer.Find(25));
+  ASSERT_EQ(2, buffer.LowerBound(25));
+  ASSERT_EQ(0, buffer.LowerBound(0));
+  ASSERT_EQ(buffer.size(), buffer.LowerBound(50));
+  
+  // When full, the oldest entry makes room
+  ASSERT_EQ(3, buffer.Insert(50, histState));
+  ASSERT_EQ(4, buffer.size());
+  ASSERT_EQ(20, buffer.front().t);
+  ASSERT_EQ(50, buffer.back().t);
+  
+  // ...unless the new one would be the oldest
+  ASSERT_EQ(buffer.size(), buffer.Insert(5, histState));
+  ASSERT_EQ(20, buffer.front().t);
+  
+  buffer.EraseBefore(40);
+  ASSERT_EQ(2, buffer.size());
+  ASSERT_EQ(40, buffer.front().t);
+  
+  // Growing keeps entries, in the same slots
+  const u32 slot = buffer.GetSlot(1);
+  buffer.Reserve(8);
+  ASSERT_EQ(8, buffer.capacity());
+  ASSERT_EQ(2, buffer.size());
+  ASSERT_EQ(50, buffer.back().t);
+  ASSERT_EQ(slot, buffer.GetSlot(1));
+  
+  // Entries don't move when others are inserted before them
+  const HistStateBuffer::Entry* entry = &buffer.back();
+  ASSERT_EQ(0, buffer.Insert(35, histState));
+  ASSERT_EQ(1, buffer.Insert(38, histState));
+  ASSERT_EQ(3, buffer.Insert(45, histState));
+  ASSERT_EQ(1, buffer.Insert(36, histState));
+  ASSERT_EQ(6, buffer.size());
+  ASSERT_EQ(entry, &buffer.back());
+  for (size_t i=1; i<buffer.size(); ++i) {
+    ASSERT_LT(buffer[i-1].t, buffer[i].t);
+  }
+}
+
+TEST(RobotStateHistory, StoredStatesAreStableParents)
+{
+  using namespace Anki;
+  using namespace Vector;
+  
+  RobotStateHistory hist;
+  RobotState state(Robot::GetDefaultRobotState());
+  
+  for (TimeStamp_t t = 0; t <= 1000; t += 10) {
+    const Pose3d pose(0.001f * t, Z_AXIS_3D(), Vec3f(0.1f * t, 0.f, 0.f), origin);
+    ASSERT_EQ(RESULT_OK, hist.AddRawOdomState(t, HistRobotState(pose, state, proxSensorValid)));
+  }
+  
+  // Parent a camera-like pose to a stored computed state, the way Robot::GetHistoricalCameraPose() does
+  RobotTimeStamp_t t;
+  HistRobotState computedState;
+  HistStateKey key = 0;
+  ASSERT_EQ(RESULT_OK, hist.ComputeAndInsertStateAt(500, t, computedState, &key));
+  const HistRobotState* storedState = hist.GetComputedState(key);
+  ASSERT_TRUE(storedState != nullptr);
+  Pose3d camPose(0, Z_AXIS_3D(), Vec3f(10.f, 0.f, 20.f));
+  camPose.SetParent(storedState->GetPose());
+  const Pose3d camPoseWrtOrigin = camPose.GetWithRespectToRoot();
+  
+  // Computed states inserted before and after it don't move it
+  for (TimeStamp_t tc = 10; tc <= 990; tc += 20) {
+    HistRobotState otherState;
+    ASSERT_EQ(RESULT_OK, hist.ComputeAndInsertStateAt(tc, t, otherState));
+  }
+  ASSERT_EQ(storedState, hist.GetComputedState(key));
+  ASSERT_TRUE(camPose.GetWithRespectToRoot().IsSameAs(camPoseWrtOrigin, DIST_EQ_THRESH, ANGLE_EQ_THRESH));
+  
+  // Updating the stored state moves the camera with it
+  const Pose3d newPose(0, Z_AXIS_3D(), Vec3f(100.f, 100.f, 0.f), origin);
+  ASSERT_EQ(RESULT_OK, hist.UpdateComputedStatePose(key, 1, newPose, 0.f, 0.f));
+  ASSERT_TRUE(camPose.GetWithRespectToRoot().IsSameAs(Pose3d(0, Z_AXIS_3D(), Vec3f(110.f, 100.f, 20.f), origin),
+                                                      DIST_EQ_THRESH, ANGLE_EQ_THRESH));
+  const Pose3d updatedCamPoseWrtOrigin = camPose.GetWithRespectToRoot();
+  
+  // Once culled, its key is no longer valid and its slot is reused, but not underneath the camera
+  for (TimeStamp_t tr = 1010; tr <= 5000; tr += 10) {
+    const Pose3d pose(0.f, Z_AXIS_3D(), Vec3f(-0.1f * tr, 0.f, 0.f), origin);
+    ASSERT_EQ(RESULT_OK, hist.AddRawOdomState(tr, HistRobotState(pose, state, proxSensorValid)));
+    HistRobotState otherState;
+    ASSERT_EQ(RESULT_OK, hist.ComputeAndInsertStateAt(tr, t, otherState));
+  }
+  ASSERT_FALSE(hist.IsValidKey(key));
+  ASSERT_TRUE(hist.GetComputedState(key) == nullptr);
+  ASSERT_EQ(RESULT_FAIL, hist.UpdateComputedStatePose(key, 1, newPose, 0.f, 0.f));
+  ASSERT_TRUE(camPose.GetWithRespectToRoot().IsSameAs(updatedCamPoseWrtOrigin, DIST_EQ_THRESH, ANGLE_EQ_THRESH));
+}
+
+TEST(RobotStateHistory, Replay)
+{
+  using namespace Anki;
+  using namespace Vector;
+  
+  // Replays a state stream like the one recorded on the robot: a raw state every state message,
+  // a vision-based state when a mat marker is seen (which bumps the pose frame), and
+  // ComputeAndInsertStateAt() for every processed image, a bit behind the latest state.
+  const u32 kStatePeriod_ms = ROBOT_TIME_STEP_MS * STATE_MESSAGE_FREQUENCY;
+  const u32 kImagePeriod_ms = 65;
+  const u32 kImageLatency_ms = 100;
+  const u32 kMarkerPeriod_ms = 2000;
+  const u32 kDuration_ms = 60 * 1000;
+  
+  RobotStateHistory hist;
+  RobotState state(Robot::GetDefaultRobotState());
+  PoseFrameID_t frameID = 0;
+  
+  u32 numQueries = 0;
+  u32 numFailedQueries = 0;
+  
+  const size_t rawCapacity = hist._states.capacity();
+  const size_t computedCapacity = hist._computedStates.capacity();
+  
+  std::vector<HistStateKey> keys;
+  u32 nextImageTime_ms = kImageLatency_ms;
+  for (u32 t = 0; t < kDuration_ms; t += kStatePeriod_ms) {
+    const f32 angle = 0.001f * t;
+    const Pose3d pose(angle, Z_AXIS_3D(), Vec3f(0.01f * t, 0.f, 0.f), origin);
+    
+    if (t > 0 && t % kMarkerPeriod_ms == 0) {
+      HistRobotState visState(pose, state, proxSensorValid);
+      visState.SetPose(frameID+1, pose, 0.f, 0.f);
+      ASSERT_EQ(RESULT_OK, hist.AddVisionOnlyState(t - kStatePeriod_ms, visState));
+      ++frameID;
+    }
+    
+    state.pose_frame_id = frameID;
+    ASSERT_EQ(RESULT_OK, hist.AddRawOdomState(t, HistRobotState(pose, state, proxSensorValid)));
+    
+    while (nextImageTime_ms + kImageLatency_ms <= t) {
+      RobotTimeStamp_t actualTime;
+      HistRobotState computedState;
+      HistStateKey key = 0;
+      if (RESULT_OK != hist.ComputeAndInsertStateAt(nextImageTime_ms, actualTime, computedState, &key, true) ||
+          !hist.IsValidKey(key)) {
+        ++numFailedQueries;
+      } else {
+        ASSERT_EQ(nextImageTime_ms, actualTime);
+        keys.push_back(key);
+      }
+      ++numQueries;
+      nextImageTime_ms += kImagePeriod_ms;
+    }
+  }
+  
+  // Every image within the window got a state, except those straddling a frame change
+  const u32 numFrameChanges = kDuration_ms / kMarkerPeriod_ms - 1;
+  ASSERT_GT(numQueries, 900);
+  ASSERT_LE(numFailedQueries, numFrameChanges);
+  
+  // Buffers never grow past their window
+  ASSERT_EQ(rawCapacity, hist._states.capacity());
+  ASSERT_EQ(computedCapacity, hist._computedStates.capacity());
+  ASSERT_LE(hist.GetNumRawStates(), rawCapacity);
+  
+  // Keys are unique, and only those still in the window are valid
+  const std::set<HistStateKey> uniqueKeys(keys.begin(), keys.end());
+  ASSERT_EQ(keys.size(), uniqueKeys.size());
+  size_t numValidKeys = 0;
+  for (const HistStateKey key : keys) {
+    if (hist.IsValidKey(key)) {
+      ++numValidKeys;
+    }
+  }
+  ASSERT_EQ(hist._computedStates.size(), numValidKeys);
+  ASSERT_TRUE(hist.IsValidKey(keys.back()));
+  ASSERT_FALSE(hist.IsValidKey(keys.front()));
 }
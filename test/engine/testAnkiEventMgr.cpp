@@ -0,0 +1,179 @@
+/**
+ * File: testAnkiEventMgr.cpp
+ *
+ * Description: Unit tests for AnkiEventMgr dispatch, and for broadcasting events without copying their data
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ * --gtest_filter=AnkiEventMgr.*
+ **/
+
+#include "gtest/gtest.h"
+#include "engine/events/ankiEventMgr.h"
+
+#include <string>
+#include <vector>
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+namespace {
+
+// looks like a CLAD union to the event manager: a one byte Tag enum and a payload that lives on the heap
+enum class TestMessageTag : uint8_t {
+  Ping,
+  Pong,
+  State,
+  INVALID = 255
+};
+
+struct TestMessage
+{
+  using Tag = TestMessageTag;
+
+  TestMessage(Tag tag, size_t payloadSize) : tag(tag), payload(payloadSize, 0xAB) { }
+  TestMessage(const TestMessage& other) : tag(other.tag), payload(other.payload) { ++sNumCopies; }
+  Tag GetTag() const { return tag; }
+
+  Tag tag;
+  std::vector<uint8_t> payload;
+
+  // number of times any message has been copied, i.e. had its payload copied to the heap
+  static size_t sNumCopies;
+};
+
+size_t TestMessage::sNumCopies = 0;
+
+using TestEvent = AnkiEvent<TestMessage>;
+
+static_assert(NumDenseEventTypes<TestMessage>::value == 256, "CLAD style messages should use a handler table");
+static_assert(NumDenseEventTypes<std::string>::value == 0, "Other data types should only use the hash map");
+
+}
+
+TEST(AnkiEventMgr, DispatchByType)
+{
+  AnkiEventMgr<TestMessage> eventMgr;
+
+  int numPings = 0;
+  int numPongs = 0;
+  int numFarAway = 0;
+  Signal::SmartHandle pingHandle = eventMgr.Subscribe((uint32_t) TestMessageTag::Ping, [&numPings](const TestEvent& event) {
+    EXPECT_EQ(TestMessageTag::Ping, event.GetData().GetTag());
+    ++numPings;
+  });
+  Signal::SmartHandle pongHandle = eventMgr.Subscribe((uint32_t) TestMessageTag::Pong, [&numPongs](const TestEvent&) { ++numPongs; });
+
+  // types that don't fit in the table still work
+  const uint32_t kFarAwayType = 1000;
+  Signal::SmartHandle farHandle = eventMgr.Subscribe(kFarAwayType, [&numFarAway](const TestEvent&) { ++numFarAway; });
+
+  const TestMessage ping(TestMessageTag::Ping, 16);
+  const TestMessage pong(TestMessageTag::Pong, 16);
+  eventMgr.Broadcast(TestEvent((uint32_t) TestMessageTag::Ping, ping));
+  eventMgr.Broadcast(1.0, (uint32_t) TestMessageTag::Ping, ping);
+  eventMgr.Broadcast(1.0, (uint32_t) TestMessageTag::Pong, pong);
+  eventMgr.Broadcast(1.0, (uint32_t) TestMessageTag::State, pong); // nobody listening
+  eventMgr.Broadcast(1.0, kFarAwayType, pong);
+  EXPECT_EQ(2, numPings);
+  EXPECT_EQ(1, numPongs);
+  EXPECT_EQ(1, numFarAway);
+
+  // releasing the handle unsubscribes
+  pingHandle = nullptr;
+  eventMgr.Broadcast(1.0, (uint32_t) TestMessageTag::Ping, ping);
+  EXPECT_EQ(2, numPings);
+
+  eventMgr.UnsubscribeAll();
+  eventMgr.Broadcast(1.0, (uint32_t) TestMessageTag::Pong, pong);
+  eventMgr.Broadcast(1.0, kFarAwayType, pong);
+  EXPECT_EQ(1, numPongs);
+  EXPECT_EQ(1, numFarAway);
+
+  // data types without tags go through the hash map
+  AnkiEventMgr<std::string> stringEventMgr;
+  std::string received;
+  Signal::SmartHandle stringHandle = stringEventMgr.Subscribe(7, [&received](const AnkiEvent<std::string>& event) {
+    received = event.GetData();
+  });
+  stringEventMgr.Broadcast(0.0, 7, std::string("hello"));
+  EXPECT_EQ("hello", received);
+}
+
+TEST(AnkiEventMgr, KeptEventsOwnTheirData)
+{
+  // handlers can keep a copy of a borrowed event after the broadcast, so the copy must not point at the caller's data
+  AnkiEventMgr<TestMessage> eventMgr;
+
+  std::vector<TestEvent> keptEvents;
+  Signal::SmartHandle handle = eventMgr.Subscribe((uint32_t) TestMessageTag::State, [&keptEvents](const TestEvent& event) {
+    EXPECT_FALSE(event.OwnsData());
+    keptEvents.push_back(event);
+  });
+
+  {
+    TestMessage state(TestMessageTag::State, 32);
+    TestMessage::sNumCopies = 0;
+    eventMgr.Broadcast(2.5, (uint32_t) TestMessageTag::State, state);
+    EXPECT_EQ(1, TestMessage::sNumCopies);
+
+    // changing the original afterwards shouldn't affect the copy either
+    state.payload.assign(32, 0);
+  }
+
+  ASSERT_EQ(1, keptEvents.size());
+  const TestEvent& kept = keptEvents.front();
+  EXPECT_TRUE(kept.OwnsData());
+  EXPECT_EQ(2.5, kept.GetCurrentTime());
+  EXPECT_EQ((uint32_t) TestMessageTag::State, kept.GetType());
+  ASSERT_EQ(32, kept.GetData().payload.size());
+  EXPECT_EQ(0xAB, kept.GetData().payload.back());
+
+  // copies of an owning event share its data
+  const TestEvent copy = kept;
+  EXPECT_EQ(&kept.GetData(), &copy.GetData());
+}
+
+TEST(AnkiEventMgr, BroadcastsWithoutCopyingData)
+{
+  AnkiEventMgr<TestMessage> eventMgr;
+
+  // a few handlers per tag, like the robot state and vision messages have
+  size_t numBytesHandled = 0;
+  std::vector<Signal::SmartHandle> handles;
+  for (const TestMessageTag tag : {TestMessageTag::Ping, TestMessageTag::Pong, TestMessageTag::State}) {
+    for (int i = 0; i < 3; ++i) {
+      handles.push_back(eventMgr.Subscribe((uint32_t) tag, [&numBytesHandled](const TestEvent& event) {
+        EXPECT_FALSE(event.OwnsData());
+        numBytesHandled += event.GetData().payload.size();
+      }));
+    }
+  }
+
+  const std::vector<TestMessage> messages = {
+    TestMessage(TestMessageTag::Ping, 8),
+    TestMessage(TestMessageTag::Pong, 64),
+    TestMessage(TestMessageTag::State, 256),
+  };
+
+  TestMessage::sNumCopies = 0;
+  for (const TestMessage& msg : messages) {
+    eventMgr.Broadcast(0.0, (uint32_t) msg.GetTag(), msg);
+  }
+  EXPECT_EQ(0, TestMessage::sNumCopies);
+  EXPECT_EQ(3 * (8 + 64 + 256), numBytesHandled);
+
+  // events built by the caller copy the data into the event, once, however many handlers there are
+  handles.clear();
+  for (const TestMessage& msg : messages) {
+    for (int i = 0; i < 3; ++i) {
+      handles.push_back(eventMgr.Subscribe((uint32_t) msg.GetTag(), [](const TestEvent& event) {
+        EXPECT_TRUE(event.OwnsData());
+      }));
+    }
+  }
+  for (const TestMessage& msg : messages) {
+    eventMgr.Broadcast(TestEvent(0.0, (uint32_t) msg.GetTag(), msg));
+  }
+  EXPECT_EQ(messages.size(), TestMessage::sNumCopies);
+}
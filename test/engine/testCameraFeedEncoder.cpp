@@ -0,0 +1,149 @@
+/**
+ * File: testCameraFeedEncoder.cpp
+ *
+ * Description: Unit tests for the camera feed encoder's latest-frame-wins handoff, chunking and quality controller
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ * --gtest_filter=CameraFeedEncoder.*
+ **/
+
+#include "gtest/gtest.h"
+#include "engine/components/cameraFeedEncoder.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+namespace {
+
+Vision::ImageRGB MakeImage(TimeStamp_t timestamp)
+{
+  Vision::ImageRGB img(360, 640);
+  img.FillWith(Vision::PixelRGB(timestamp % 255, 128, 64));
+  img.SetTimestamp(timestamp);
+  return img;
+}
+
+// Wait for the encoder thread to finish the last image submitted
+const EncodedCameraImage* WaitForEncodedImage(CameraFeedEncoder& encoder)
+{
+  for(int i = 0; i < 1000; ++i)
+  {
+    const EncodedCameraImage* encoded = encoder.TakeEncodedImage();
+    if(nullptr != encoded)
+    {
+      return encoded;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return nullptr;
+}
+
+}
+
+TEST(CameraFeedEncoder, ChunksForEachConsumer)
+{
+  CameraFeedEncoder encoder;
+
+  encoder.SubmitImage(MakeImage(100), 3, true, true);
+  const EncodedCameraImage* encoded = WaitForEncodedImage(encoder);
+  ASSERT_NE(nullptr, encoded);
+
+  const size_t numBytes = encoded->image.GetCompressedBuffer().size();
+  ASSERT_GT(numBytes, 0);
+  EXPECT_EQ(100, encoded->image.GetTimestamp());
+
+  const u32 kChunkSize = static_cast<u32>(ImageConstants::IMAGE_CHUNK_SIZE);
+  const u32 expectedNumChunks = (numBytes + kChunkSize - 1) / kChunkSize;
+  EXPECT_EQ(expectedNumChunks, encoded->numCladChunks);
+  EXPECT_EQ(expectedNumChunks, encoded->numProtoChunks);
+
+  size_t numChunkedBytes = 0;
+  for(u32 i = 0; i < encoded->numCladChunks; ++i)
+  {
+    const ImageChunk& chunk = encoded->cladChunks[i];
+    EXPECT_EQ(i, chunk.chunkId);
+    EXPECT_EQ(expectedNumChunks, chunk.imageChunkCount);
+    EXPECT_EQ(3, chunk.displayIndex);
+    EXPECT_EQ(100, chunk.frameTimeStamp);
+    numChunkedBytes += chunk.data.size();
+  }
+  EXPECT_EQ(numBytes, numChunkedBytes);
+
+  // Nothing new was submitted
+  EXPECT_EQ(nullptr, encoder.TakeEncodedImage());
+
+  // Only the consumers asked for get chunks
+  encoder.SubmitImage(MakeImage(200), 3, false, true);
+  encoded = WaitForEncodedImage(encoder);
+  ASSERT_NE(nullptr, encoded);
+  EXPECT_EQ(0, encoded->numCladChunks);
+  EXPECT_GT(encoded->numProtoChunks, 0);
+}
+
+TEST(CameraFeedEncoder, LatestImageWins)
+{
+  CameraFeedEncoder encoder;
+
+  // Submit faster than anything is taken, only the newest image should come out and nothing should queue up
+  const TimeStamp_t kNumImages = 30;
+  for(TimeStamp_t t = 1; t <= kNumImages; ++t)
+  {
+    encoder.SubmitImage(MakeImage(t * 66), 0, true, false);
+  }
+
+  const EncodedCameraImage* encoded = nullptr;
+  for(int i = 0; i < 1000; ++i)
+  {
+    encoded = encoder.TakeEncodedImage();
+    if(nullptr != encoded && encoded->image.GetTimestamp() == kNumImages * 66)
+    {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_NE(nullptr, encoded);
+  EXPECT_EQ(kNumImages * 66, encoded->image.GetTimestamp());
+  EXPECT_GT(encoder.GetNumSkippedImages(), 0);
+}
+
+TEST(CameraFeedEncoder, QualityController)
+{
+  CameraFeedQualityController controller;
+  EXPECT_EQ(0, controller.GetLevelIndex());
+  EXPECT_FALSE(controller.GetLevel().halfResolution);
+
+  // A single backlogged frame is not enough to step down
+  EXPECT_FALSE(controller.AddFrame(true));
+  for(u32 i = 0; i < CameraFeedQualityController::kWindowSize; ++i)
+  {
+    EXPECT_FALSE(controller.AddFrame(false));
+  }
+  EXPECT_FALSE(controller.AddFrame(true));
+  EXPECT_EQ(0, controller.GetLevelIndex());
+
+  // A second one within the window is
+  EXPECT_TRUE(controller.AddFrame(true));
+  EXPECT_EQ(1, controller.GetLevelIndex());
+  EXPECT_LT(controller.GetLevel().quality, CameraFeedQualityController::kLevels[0].quality);
+
+  // Step back up after enough good frames in a row
+  for(u32 i = 0; i < CameraFeedQualityController::kGoodFramesToStepUp - 1; ++i)
+  {
+    EXPECT_FALSE(controller.AddFrame(false));
+  }
+  EXPECT_TRUE(controller.AddFrame(false));
+  EXPECT_EQ(0, controller.GetLevelIndex());
+
+  // Sustained backlog bottoms out at the lowest level, at half resolution
+  for(int i = 0; i < 100; ++i)
+  {
+    controller.AddFrame(true);
+  }
+  EXPECT_EQ(CameraFeedQualityController::kNumLevels - 1, controller.GetLevelIndex());
+  EXPECT_TRUE(controller.GetLevel().halfResolution);
+  EXPECT_FALSE(controller.AddFrame(true));
+}
@@ -21,6 +21,7 @@
 #include "engine/navMap/memoryMap/data/memoryMapData_Cliff.h"
 #include "engine/navMap/memoryMap/data/memoryMapData_ProxObstacle.h"
 #include "engine/navMap/memoryMap/memoryMapTypes.h"
+#include "engine/navMap/quadTree/quadTree.h"
 #include "engine/robot.h"
 
 using namespace Anki;
@@ -186,3 +187,121 @@ TEST( TestNavMap, FillBorder)
   
 }
 
+TEST( TestNavMap, NodePoolConsistency)
+{
+  // checks that the node pool stays consistent with the tree structure while nodes are constantly being subdivided
+  // and merged, and that blocks released by a merge are recycled instead of growing the pool
+  size_t numLiveNodes = 0;
+  QuadTree quadTree( [&numLiveNodes] (const QuadTreeNode*) { --numLiveNodes; },
+                     [] (const QuadTreeNode*, const NodeContent&) {} );
+  
+  const MemoryMapDataPtr clearData    = MemoryMapData( EContentType::ClearOfObstacle, 0 ).Clone();
+  const MemoryMapDataPtr obstacleData = MemoryMapData( EContentType::ObstacleUnrecognized, 0 ).Clone();
+  
+  // insert small rotated quads scattered over a ~2m x 2m area, so that the root has to expand and nodes are
+  // repeatedly subdivided and merged back
+  auto insertQuads = [&] () {
+    constexpr int kNumInserts = 5000;
+    for ( int i = 0; i < kNumInserts; ++i )
+    {
+      const float x = (i * 37) % 1800 - 900.0f;
+      const float y = (i * 53) % 1800 - 900.0f;
+      const FastPolygon poly( {{x, y}, {x + 40, y + 5}, {x + 35, y + 45}, {x, y + 40}} );
+      const MemoryMapDataPtr& data = (i % 3) ? clearData : obstacleData;
+      quadTree.Insert( poly, [&data] (const NodeContent&) { return NodeContent(data); } );
+    }
+  };
+  
+  auto countNodes = [&quadTree] () {
+    size_t numNodes = 0;
+    quadTree.Fold( [&numNodes] (const QuadTreeNode& node) { ++numNodes; } );
+    return numNodes;
+  };
+  
+  insertQuads();
+  
+  // every node but the root lives in the pool
+  EXPECT_EQ( countNodes(), quadTree.GetNumNodes() + 1 );
+  EXPECT_LE( quadTree.GetNumNodes(), quadTree.GetNumReservedNodes() );
+  
+  // merging everything back into a single node should return all blocks to the pool
+  numLiveNodes = quadTree.GetNumNodes();
+  quadTree.Transform( RealNumbers2f(), [&clearData] (const NodeContent&) { return NodeContent(clearData); } );
+  EXPECT_EQ( 0, quadTree.GetNumNodes() );
+  EXPECT_EQ( 0, numLiveNodes );
+  
+  // the same inserts again (into the already expanded root) are built out of the recycled blocks
+  const size_t numReservedNodes = quadTree.GetNumReservedNodes();
+  insertQuads();
+  EXPECT_EQ( countNodes(), quadTree.GetNumNodes() + 1 );
+  EXPECT_EQ( numReservedNodes, quadTree.GetNumReservedNodes() );
+}
+
+TEST( TestNavMap, RasterRayQueries)
+{
+  // ray queries by content type are answered from the processor's raster, and should match the results of searching
+  // the quad tree with the equivalent predicate, including after the root has expanded or shifted
+  MemoryMap memoryMap;
+
+  const EContentType kTypes[] = { EContentType::ClearOfObstacle, EContentType::ClearOfCliff,
+                                  EContentType::ObstacleUnrecognized, EContentType::InterestingEdge,
+                                  EContentType::NotInterestingEdge, EContentType::Unknown };
+  const EContentTypePackedType kQueries[] = {
+    EContentTypeToFlag(EContentType::ObstacleUnrecognized) | EContentTypeToFlag(EContentType::InterestingEdge),
+    EContentTypeToFlag(EContentType::ClearOfCliff),
+    EContentTypeToFlag(EContentType::Unknown),
+    0
+  };
+
+  constexpr float kExtent_mm = 400.0f;
+  const auto getPoint = [] (int i, float offset_x) {
+    return Point2f( (i * 37) % (int) kExtent_mm + offset_x, (i * 53) % (int) kExtent_mm - kExtent_mm * 0.5f );
+  };
+
+  size_t numRays = 0;
+  size_t numHits = 0;
+  for ( int i = 0; i < 600; ++i )
+  {
+    // move the inserts towards +x halfway through, so that the root has to keep growing that way
+    const float offset_x = (i < 300) ? -kExtent_mm * 0.5f : kExtent_mm;
+    if ( (i % 300) == 0 ) {
+      // cover the whole area first, so that none of the rays leave the root
+      const float x0 = offset_x;
+      const float x1 = offset_x + kExtent_mm + 70.0f;
+      const float y0 = -kExtent_mm * 0.5f;
+      const float y1 = kExtent_mm * 0.5f + 70.0f;
+      memoryMap.Insert( FastPolygon( {{x0, y0}, {x1, y0}, {x1, y1}, {x0, y1}} ),
+                        MemoryMapData( EContentType::ClearOfObstacle, 0 ) );
+    }
+    const Point2f p = getPoint(i, offset_x);
+    const float w = 10.0f + (i * 7) % 60;
+    const FastPolygon poly( {{p.x(), p.y()}, {p.x() + w, p.y()}, {p.x() + w, p.y() + w}, {p.x(), p.y() + w}} );
+    memoryMap.Insert( poly, MemoryMapData( kTypes[i % 6], 0 ) );
+
+    if ( (i % 20) == 19 )
+    {
+      const Point2f start = getPoint(i * 3, offset_x);
+      std::vector<Point2f> ends;
+      for ( int j = 0; j < 30; ++j ) {
+        ends.push_back( getPoint(i + j * 11, offset_x) );
+      }
+
+      for ( const EContentTypePackedType types : kQueries )
+      {
+        const std::vector<bool> fromTree = memoryMap.AnyOf( start, ends,
+          [types] (MemoryMapDataConstPtr data) { return IsInEContentTypePackedType(data->type, types); } );
+        const std::vector<bool> fromRaster = memoryMap.AnyOf( start, ends, types );
+        ASSERT_EQ( fromTree.size(), fromRaster.size() );
+        for ( size_t k = 0; k < fromTree.size(); ++k ) {
+          EXPECT_EQ( fromTree[k], fromRaster[k] ) << "insert " << i << " ray " << k << " types " << types;
+          numHits += fromRaster[k] ? 1 : 0;
+        }
+        numRays += fromTree.size();
+      }
+    }
+  }
+
+  // make sure the test actually exercised both outcomes
+  EXPECT_GT( numHits, 0 );
+  EXPECT_LT( numHits, numRays );
+}
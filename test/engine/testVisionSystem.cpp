@@ -22,10 +22,16 @@
 #include "engine/robotDataLoader.h"
 #include "engine/vision/visionSystem.h"
 #include "engine/vision/laserPointDetector.h"
+#include "engine/vision/motionDetector.h"
+#include "engine/vision/motionDetectorKernels.h"
+#include "engine/vision/visionPoseData.h"
+#include "engine/vision/visionTaskGraph.h"
+#include "engine/unitTestKey.h"
 #include "anki/cozmo/shared/cozmoConfig.h"
 
 #include "coretech/neuralnets/neuralNetJsonKeys.h"
 
+#include "coretech/vision/engine/camera.h"
 #include "coretech/vision/engine/imageCache.h"
 #include "coretech/vision/engine/neuralNetRunner.h"
 #include "coretech/vision/shared/MarkerCodeDefinitions.h"
@@ -42,6 +48,12 @@
 
 #include "coretech/common/engine/colorRGBA.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
 
 extern Anki::Vector::CozmoContext* cozmoContext;
 
@@ -749,6 +761,309 @@ GTEST_TEST(LaserPointDetector, LaserDetect)
 
 } // LaserPointDetector
 
+// Replays consecutive frames of stored video clips through the motion detector's kernels and checks that the
+// vectorized versions give exactly the same ratio images and motion centroids as the plain reference code (or, for
+// the robot's original Neon ratio test, only differ where a ratio is right at the threshold)
+GTEST_TEST(MotionDetector, ReplayFramePairs)
+{
+  using namespace Anki;
+  namespace Kernels = Vector::MotionDetectorKernels;
+
+  // The MotionDetector's default parameters
+  const u8  kMinBrightness = 10;
+  const f32 kRatioThreshold = 1.25f;
+  const u32 kBlurFilterSize = 5;
+  const f32 kPercentile = 0.5f;
+
+  // Reference for CountMotionInRow + GetPercentileBin: sort the coordinates of all motion pixels
+  auto getReferenceCentroid = [kPercentile](const Vision::Image& motion, Point2f& centroid) {
+    std::vector<s32> xValues, yValues;
+    for(s32 y=0; y<motion.GetNumRows(); ++y) {
+      const u8* motionRow = motion.GetRow(y);
+      for(s32 x=0; x<motion.GetNumCols(); ++x) {
+        if(motionRow[x] != 0) {
+          xValues.push_back(x);
+          yValues.push_back(y);
+        }
+      }
+    }
+    if(!xValues.empty()) {
+      const size_t index = std::round(kPercentile * (f32)(xValues.size()-1));
+      std::nth_element(xValues.begin(), xValues.begin() + index, xValues.end());
+      std::nth_element(yValues.begin(), yValues.begin() + index, yValues.end());
+      centroid = Point2f(xValues[index], yValues[index]);
+    }
+    return xValues.size();
+  };
+
+  auto getCentroid = [kPercentile](const Vision::Image& motion, Point2f& centroid) {
+    std::vector<s32> xCounts(motion.GetNumCols(), 0);
+    std::vector<s32> yCounts(motion.GetNumRows(), 0);
+    size_t area = 0;
+    for(s32 y=0; y<motion.GetNumRows(); ++y) {
+      yCounts[y] = Kernels::CountMotionInRow(motion.GetRow(y), nullptr, motion.GetNumCols(), xCounts.data());
+      area += yCounts[y];
+    }
+    if(area > 0) {
+      centroid = Point2f(Kernels::GetPercentileBin(xCounts.data(), motion.GetNumCols(), area, kPercentile),
+                         Kernels::GetPercentileBin(yCounts.data(), motion.GetNumRows(), area, kPercentile));
+    }
+    return area;
+  };
+
+  // The original Neon ratio test multiplies by a reciprocal estimate, which is accurate to about 1 part in 256. So
+  // wherever its ratio image differs from the reference, some channel's exact ratio must be that close to the threshold
+  const bool kExact = Kernels::RatioTestMatchesReference();
+  auto expectSameRatioImage = [kExact,kRatioThreshold](const u8* image, const u8* prevImage, s32 numChannels,
+                                                       const Vision::Image& ratioRef, const Vision::Image& ratio,
+                                                       const std::string& file) {
+    const s32 numPixels = ratio.GetNumElements();
+    if(kExact) {
+      EXPECT_EQ(0, memcmp(ratioRef.GetDataPointer(), ratio.GetDataPointer(), numPixels)) << file;
+      return;
+    }
+    for(s32 i=0; i<numPixels; ++i) {
+      if(ratio.GetDataPointer()[i] == ratioRef.GetDataPointer()[i]) {
+        continue;
+      }
+      bool nearThreshold = false;
+      for(s32 c=0; c<numChannels; ++c) {
+        const u8 p1 = image[numChannels*i + c];
+        const u8 p2 = prevImage[numChannels*i + c];
+        const f32 exactRatio = (f32)std::max(p1, p2) / std::max(1.f, (f32)std::min(p1, p2));
+        nearThreshold |= (std::abs(exactRatio - kRatioThreshold) <= kRatioThreshold / 128.f);
+      }
+      EXPECT_TRUE(nearThreshold) << file << " pixel " << i;
+    }
+  };
+
+  const std::string testDir = cozmoContext->GetDataPlatform()->pathToResource(Util::Data::Scope::Resources,
+                                                                              "test/faceRecVideoTests/andrew");
+  std::vector<std::string> clipDirs;
+  Util::FileUtils::ListAllDirectories(testDir, clipDirs);
+  ASSERT_FALSE(clipDirs.empty());
+
+  s32 numPairs = 0;
+  s32 numWithMotion = 0;
+
+  for(const auto& clipDir : clipDirs)
+  {
+    std::vector<std::string> files = Util::FileUtils::FilesInDirectory(Util::FileUtils::FullFilePath({testDir, clipDir}),
+                                                                       true, ".jpg", false);
+    std::sort(files.begin(), files.end());
+
+    Vision::Image prevGray;
+    Vision::ImageRGB prevColor;
+    for(const auto& file : files)
+    {
+      Vision::Image gray;
+      ASSERT_EQ(RESULT_OK, gray.Load(file));
+      gray.BoxFilter(gray, kBlurFilterSize);
+
+      // Make a color frame with a different gain per channel, so that the channels don't always agree
+      Vision::ImageRGB color(gray.GetNumRows(), gray.GetNumCols());
+      for(s32 i=0; i<gray.GetNumRows(); ++i) {
+        const u8* grayRow = gray.GetRow(i);
+        Vision::PixelRGB* colorRow = color.GetRow(i);
+        for(s32 j=0; j<gray.GetNumCols(); ++j) {
+          colorRow[j] = Vision::PixelRGB(grayRow[j], (grayRow[j] * 3) / 4, std::min(255, (grayRow[j] * 5) / 4));
+        }
+      }
+
+      if(!prevGray.IsEmpty())
+      {
+        ASSERT_TRUE(gray.IsContinuous() && prevGray.IsContinuous() && color.IsContinuous() && prevColor.IsContinuous());
+        const s32 numPixels = gray.GetNumElements();
+        Vision::Image ratio(gray.GetNumRows(), gray.GetNumCols());
+        Vision::Image ratioRef(gray.GetNumRows(), gray.GetNumCols());
+        Vision::Image ratioColor(gray.GetNumRows(), gray.GetNumCols());
+        Vision::Image ratioColorRef(gray.GetNumRows(), gray.GetNumCols());
+
+        const s32 numAbove = Kernels::RatioTestGray(gray.GetDataPointer(), prevGray.GetDataPointer(), numPixels,
+                                                    kMinBrightness, kRatioThreshold, ratio.GetDataPointer());
+        const s32 numAboveColor = Kernels::RatioTestRGB(reinterpret_cast<const u8*>(color.GetDataPointer()),
+                                                        reinterpret_cast<const u8*>(prevColor.GetDataPointer()),
+                                                        numPixels, kMinBrightness, kRatioThreshold,
+                                                        ratioColor.GetDataPointer());
+
+        const s32 numAboveRef = Kernels::RatioTestGrayReference(gray.GetDataPointer(), prevGray.GetDataPointer(),
+                                                                numPixels, kMinBrightness, kRatioThreshold,
+                                                                ratioRef.GetDataPointer());
+        const s32 numAboveColorRef = Kernels::RatioTestRGBReference(reinterpret_cast<const u8*>(color.GetDataPointer()),
+                                                                    reinterpret_cast<const u8*>(prevColor.GetDataPointer()),
+                                                                    numPixels, kMinBrightness, kRatioThreshold,
+                                                                    ratioColorRef.GetDataPointer());
+        if(kExact) {
+          EXPECT_EQ(numAboveRef, numAbove) << file;
+          EXPECT_EQ(numAboveColorRef, numAboveColor) << file;
+        }
+        expectSameRatioImage(gray.GetDataPointer(), prevGray.GetDataPointer(), 1, ratioRef, ratio, file);
+        expectSameRatioImage(reinterpret_cast<const u8*>(color.GetDataPointer()),
+                             reinterpret_cast<const u8*>(prevColor.GetDataPointer()), 3, ratioColorRef, ratioColor, file);
+
+        // The centroids are checked on the ratio images computed above, so that they match even where those don't
+        Point2f centroid, centroidColor;
+        const size_t area = getCentroid(ratio, centroid);
+        const size_t areaColor = getCentroid(ratioColor, centroidColor);
+        Point2f centroidRef, centroidColorRef;
+        const size_t areaRef = getReferenceCentroid(ratio, centroidRef);
+        const size_t areaColorRef = getReferenceCentroid(ratioColor, centroidColorRef);
+        EXPECT_EQ((size_t)numAbove, area) << file;
+        EXPECT_EQ((size_t)numAboveColor, areaColor) << file;
+
+        EXPECT_EQ(areaRef, area) << file;
+        EXPECT_EQ(areaColorRef, areaColor) << file;
+        if(area > 0) {
+          EXPECT_EQ(centroidRef.x(), centroid.x()) << file;
+          EXPECT_EQ(centroidRef.y(), centroid.y()) << file;
+          ++numWithMotion;
+        }
+        if(areaColor > 0) {
+          EXPECT_EQ(centroidColorRef.x(), centroidColor.x()) << file;
+          EXPECT_EQ(centroidColorRef.y(), centroidColor.y()) << file;
+        }
+        ++numPairs;
+      }
+
+      std::swap(prevGray, gray);
+      std::swap(prevColor, color);
+    }
+  }
+
+  EXPECT_GT(numPairs, 0);
+  EXPECT_GT(numWithMotion, 0);
+
+} // MotionDetector
+
+namespace Anki {
+namespace Vector {
+
+// Replays the stored video clips through two MotionDetectors, one using the vectorized kernels and one using the
+// reference kernels and the original sort-based centroid, and checks that they report exactly the same motion
+GTEST_TEST(MotionDetector, SameDetectionsAsReference)
+{
+  // The robot's original Neon ratio test isn't exact, so small differences would carry through to every field.
+  // ReplayFramePairs checks it instead
+  if(!MotionDetectorKernels::RatioTestMatchesReference()) {
+    return;
+  }
+
+  const Json::Value config = cozmoContext->GetDataLoader()->GetRobotVisionConfig();
+
+  Vision::Camera camera;
+  camera.SetCalibration(std::make_shared<Vision::CameraCalibration>(240,320,290.f,290.f,160.f,120.f,0.f));
+
+  // Ground plane homography for a camera 40mm above the ground, looking along the robot's x axis and pitched down
+  // 25 degrees. That puts the whole ground plane ROI in the bottom of the half resolution image, so motion there
+  // also goes through the masked ground plane centroid
+  const f32 kPitch_rad = DEG_TO_RAD(25.f);
+  const f32 kHeight_mm = 40.f;
+  const Matrix_3x3f K{
+    145.f,   0.f, 80.f,
+      0.f, 145.f, 60.f,
+      0.f,   0.f,  1.f};
+  const Matrix_3x3f Rt{
+    0.f,                   -1.f, 0.f,
+    -std::sin(kPitch_rad),  0.f, kHeight_mm * std::cos(kPitch_rad),
+    std::cos(kPitch_rad),   0.f, kHeight_mm * std::sin(kPitch_rad)};
+
+  // The robot doesn't move, so every frame is compared with the one before
+  VisionPoseData poseData;
+  poseData.cameraPose.SetParent(poseData.histState.GetPose());
+  poseData.groundPlaneVisible = true;
+  poseData.groundPlaneHomography = K * Rt;
+
+  const std::string testDir = cozmoContext->GetDataPlatform()->pathToResource(Util::Data::Scope::Resources,
+                                                                              "test/faceRecVideoTests/andrew");
+  std::vector<std::string> clipDirs;
+  Util::FileUtils::ListAllDirectories(testDir, clipDirs);
+  std::sort(clipDirs.begin(), clipDirs.end());
+  ASSERT_FALSE(clipDirs.empty());
+
+  for(const bool useColor : {false, true})
+  {
+    MotionDetector detector(camera, nullptr, config);
+    MotionDetector referenceDetector(camera, nullptr, config);
+    referenceDetector.SetUseReferenceKernels(true, UnitTestKey());
+
+    TimeStamp_t timestamp = 0;
+    s32 numDetections = 0;
+    for(const auto& clipDir : clipDirs)
+    {
+      std::vector<std::string> files = Util::FileUtils::FilesInDirectory(Util::FileUtils::FullFilePath({testDir, clipDir}),
+                                                                         true, ".jpg", false);
+      std::sort(files.begin(), files.end());
+
+      for(const auto& file : files)
+      {
+        Vision::Image gray;
+        ASSERT_EQ(RESULT_OK, gray.Load(file));
+
+        // Far enough apart that the detectors never skip a frame for having just seen motion
+        timestamp += 1000;
+
+        Vision::ImageCache imageCache;
+        if(useColor)
+        {
+          // Different gains per channel, so that the channels don't always agree
+          Vision::ImageRGB color(gray.GetNumRows(), gray.GetNumCols());
+          for(s32 i=0; i<gray.GetNumRows(); ++i) {
+            const u8* grayRow = gray.GetRow(i);
+            Vision::PixelRGB* colorRow = color.GetRow(i);
+            for(s32 j=0; j<gray.GetNumCols(); ++j) {
+              colorRow[j] = Vision::PixelRGB(grayRow[j], (grayRow[j] * 3) / 4, std::min(255, (grayRow[j] * 5) / 4));
+            }
+          }
+          color.SetTimestamp(timestamp);
+          imageCache.Reset(color);
+        }
+        else
+        {
+          gray.SetTimestamp(timestamp);
+          imageCache.Reset(gray);
+        }
+
+        std::list<ExternalInterface::RobotObservedMotion> motions, referenceMotions;
+        Vision::DebugImageList<Vision::CompressedImage> debugImages;
+        ASSERT_EQ(RESULT_OK, detector.Detect(imageCache, poseData, poseData, motions, debugImages));
+        ASSERT_EQ(RESULT_OK, referenceDetector.Detect(imageCache, poseData, poseData, referenceMotions, debugImages));
+
+        ASSERT_EQ(referenceMotions.size(), motions.size()) << file;
+        auto referenceIter = referenceMotions.begin();
+        for(const auto& motion : motions)
+        {
+          const auto& reference = *referenceIter++;
+          EXPECT_EQ(reference.timestamp,       motion.timestamp) << file;
+          EXPECT_EQ(reference.img_area,        motion.img_area) << file;
+          EXPECT_EQ(reference.img_x,           motion.img_x) << file;
+          EXPECT_EQ(reference.img_y,           motion.img_y) << file;
+          EXPECT_EQ(reference.ground_area,     motion.ground_area) << file;
+          EXPECT_EQ(reference.ground_x,        motion.ground_x) << file;
+          EXPECT_EQ(reference.ground_y,        motion.ground_y) << file;
+          EXPECT_EQ(reference.top_img_area,    motion.top_img_area) << file;
+          EXPECT_EQ(reference.top_img_x,       motion.top_img_x) << file;
+          EXPECT_EQ(reference.top_img_y,       motion.top_img_y) << file;
+          EXPECT_EQ(reference.bottom_img_area, motion.bottom_img_area) << file;
+          EXPECT_EQ(reference.bottom_img_x,    motion.bottom_img_x) << file;
+          EXPECT_EQ(reference.bottom_img_y,    motion.bottom_img_y) << file;
+          EXPECT_EQ(reference.left_img_area,   motion.left_img_area) << file;
+          EXPECT_EQ(reference.left_img_x,      motion.left_img_x) << file;
+          EXPECT_EQ(reference.left_img_y,      motion.left_img_y) << file;
+          EXPECT_EQ(reference.right_img_area,  motion.right_img_area) << file;
+          EXPECT_EQ(reference.right_img_x,     motion.right_img_x) << file;
+          EXPECT_EQ(reference.right_img_y,     motion.right_img_y) << file;
+        }
+        numDetections += motions.size();
+      }
+    }
+
+    EXPECT_GT(numDetections, 0) << (useColor ? "color" : "gray");
+  }
+}
+
+} // namespace Vector
+} // namespace Anki
+
 // This test is meant to avoid checking in a vision_config.json or code changes that break the ability to load
 // the neural net model(s) successfully.
 GTEST_TEST(NeuralNets, InitFromConfig)
@@ -769,11 +1084,12 @@ GTEST_TEST(NeuralNets, InitFromConfig)
   const std::string modelPath = Util::FileUtils::FullFilePath({dataPath, "dnn_models"});
   const std::string dnnCachePath = Util::FileUtils::FullFilePath({cachePath, "neural_nets"});
   
-  // Make sure "NeuralNetRunner" load succeeds for each model, given all the current params in vision_config.json
+  // Make sure "NeuralNetRunner" load succeeds for each model, given all the current params in vision_config.json,
+  // with all of them sharing one runner like VisionSystem does
   ASSERT_TRUE(allModelsConfig.isArray());
+  Vision::NeuralNetRunner neuralNetRunner;
   for(const auto& modelConfig : allModelsConfig)
   {
-    Vision::NeuralNetRunner neuralNetRunner;
     const Result loadRunnerResult = neuralNetRunner.Init(modelPath, dnnCachePath, modelConfig);
     ASSERT_EQ(RESULT_OK, loadRunnerResult);
     
@@ -790,6 +1106,11 @@ GTEST_TEST(NeuralNets, InitFromConfig)
     const std::string fullModelPath = Util::FileUtils::FullFilePath({modelPath, modelFileName});
     ASSERT_TRUE(Util::FileUtils::FileExists(fullModelPath));
   }
+  
+  ASSERT_EQ(allModelsConfig.size(), neuralNetRunner.GetNetworkNames().size());
+  
+  // Loading the same model twice into one runner is an error
+  ASSERT_NE(RESULT_OK, neuralNetRunner.Init(modelPath, dnnCachePath, allModelsConfig[0]));
 }
 
 GTEST_TEST(VisionModeSet, BasicFunctionality)
@@ -875,3 +1196,72 @@ GTEST_TEST(VisionModeSet, BasicFunctionality)
   //const std::vector<int> foo{1,2,3};
   //set1.Insert(bob);
 }
+
+GTEST_TEST(VisionTaskGraph, DependenciesAndResults)
+{
+  using namespace Anki::Vector;
+  
+  VisionTaskGraph graph(3);
+  ASSERT_EQ(3, graph.GetNumWorkerThreads());
+  
+  // Run both in parallel and serially, many times to shake out ordering problems
+  for(s32 iter=0; iter<200; ++iter)
+  {
+    const bool runInParallel = (iter % 2 == 0);
+    
+    std::atomic<s32> numFinished{0};
+    s32 finishOrder[5] = {0};
+    auto makeTask = [&numFinished, &finishOrder](s32 index, Anki::Result result) {
+      return [&numFinished, &finishOrder, index, result]() {
+        std::this_thread::sleep_for(std::chrono::microseconds(100 * (index % 3)));
+        finishOrder[index] = ++numFinished;
+        return result;
+      };
+    };
+    
+    const auto clahe   = graph.AddTask("CLAHE",   makeTask(0, Anki::RESULT_OK));
+    const auto markers = graph.AddTask("Markers", makeTask(1, Anki::RESULT_OK), {clahe});
+    const auto faces   = graph.AddTask("Faces",   makeTask(2, Anki::RESULT_FAIL));
+    const auto pets    = graph.AddTask("Pets",    makeTask(3, Anki::RESULT_OK), {faces});
+    const auto motion  = graph.AddTask("Motion",  makeTask(4, Anki::RESULT_OK));
+    ASSERT_EQ(5, graph.GetNumTasks());
+    
+    graph.Run(runInParallel);
+    
+    // Everything ran exactly once, dependents after their dependencies
+    ASSERT_EQ(5, numFinished);
+    ASSERT_GT(finishOrder[markers], finishOrder[clahe]);
+    ASSERT_GT(finishOrder[pets], finishOrder[faces]);
+    
+    // A failed dependency does not stop its dependents from running
+    ASSERT_EQ(Anki::RESULT_OK,   graph.GetResult(clahe));
+    ASSERT_EQ(Anki::RESULT_OK,   graph.GetResult(markers));
+    ASSERT_EQ(Anki::RESULT_FAIL, graph.GetResult(faces));
+    ASSERT_EQ(Anki::RESULT_OK,   graph.GetResult(pets));
+    ASSERT_EQ(Anki::RESULT_OK,   graph.GetResult(motion));
+    ASSERT_STREQ("Pets", graph.GetName(pets));
+    
+    if(!runInParallel)
+    {
+      // Serial runs go in the order tasks were added
+      for(s32 i=0; i<5; ++i)
+      {
+        ASSERT_EQ(i+1, finishOrder[i]);
+      }
+    }
+    
+    graph.Clear();
+    ASSERT_EQ(0, graph.GetNumTasks());
+  }
+  
+  // With no worker threads, Run() still runs everything (on this thread)
+  VisionTaskGraph serialGraph(0);
+  const std::thread::id thisThread = std::this_thread::get_id();
+  bool ranOnThisThread = false;
+  serialGraph.AddTask("Task", [&ranOnThisThread, thisThread]() {
+    ranOnThisThread = (std::this_thread::get_id() == thisThread);
+    return Anki::RESULT_OK;
+  });
+  serialGraph.Run();
+  ASSERT_TRUE(ranOnThisThread);
+}
@@ -0,0 +1,167 @@
+/**
+ * File: testWebSocketOutboxes.cpp
+ *
+ * Description: Unit tests for the per-client queues of messages that WebService sends to websocket clients
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ * --gtest_filter=WebSocketOutboxes*
+ **/
+
+#include "webServerProcess/src/webSocketOutboxes.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+using namespace Anki::Vector::WebService;
+
+namespace {
+
+// Only used as keys, never dereferenced
+const mg_connection* GetConnection(int index)
+{
+  static char connections[4];
+  return reinterpret_cast<const mg_connection*>(&connections[index]);
+}
+
+WebSocketOutboxes::MessagePtr MakeMessage(int value, const std::string& snapshotModule = "")
+{
+  auto message = std::make_shared<WebSocketOutboxes::Message>();
+  message->snapshotModule = snapshotModule;
+  message->payloads.resize(1);
+  message->payloads[0]["value"] = value;
+  return message;
+}
+
+// Drains conn, returning the values in the order they were written
+std::vector<int> Drain(WebSocketOutboxes& outboxes, const mg_connection* conn)
+{
+  std::vector<int> values;
+  outboxes.Drain(conn, [&values](const std::string& str) {
+    Json::Reader reader;
+    Json::Value payload;
+    EXPECT_TRUE(reader.parse(str, payload));
+    values.push_back(payload["value"].asInt());
+  });
+  return values;
+}
+
+}
+
+TEST(WebSocketOutboxes, SendsInOrderPerConnection)
+{
+  WebSocketOutboxes outboxes;
+  const mg_connection* conn1 = GetConnection(0);
+  const mg_connection* conn2 = GetConnection(1);
+  outboxes.AddConnection(conn1);
+  outboxes.AddConnection(conn2);
+
+  // Only the first push to an outbox that isn't being drained asks for a drain
+  EXPECT_TRUE(outboxes.Push(conn1, MakeMessage(1)));
+  EXPECT_FALSE(outboxes.Push(conn1, MakeMessage(2)));
+  EXPECT_TRUE(outboxes.Push(conn2, MakeMessage(10)));
+
+  // The same message is shared by both clients and encoded once
+  const auto shared = MakeMessage(3);
+  EXPECT_FALSE(outboxes.Push(conn1, shared));
+  EXPECT_FALSE(outboxes.Push(conn2, shared));
+  EXPECT_EQ(3, outboxes.GetNumQueued(conn1));
+  EXPECT_EQ(2, outboxes.GetNumQueued(conn2));
+
+  EXPECT_EQ((std::vector<int>{1, 2, 3}), Drain(outboxes, conn1));
+  EXPECT_EQ(1, shared->encoded.size());
+  EXPECT_EQ((std::vector<int>{10, 3}), Drain(outboxes, conn2));
+  EXPECT_EQ(1, shared->encoded.size());
+
+  // Drained outboxes ask for a drain again
+  EXPECT_EQ(0, outboxes.GetNumQueued(conn1));
+  EXPECT_TRUE(outboxes.Push(conn1, MakeMessage(4)));
+
+  // Messages pushed while draining are written by the same drain, after what was already queued
+  std::vector<int> values;
+  outboxes.Drain(conn1, [&outboxes, &values, conn1](const std::string& str) {
+    Json::Reader reader;
+    Json::Value payload;
+    reader.parse(str, payload);
+    values.push_back(payload["value"].asInt());
+    if( values.size() == 1 ) {
+      EXPECT_FALSE(outboxes.Push(conn1, MakeMessage(5)));
+    }
+  });
+  EXPECT_EQ((std::vector<int>{4, 5}), values);
+}
+
+TEST(WebSocketOutboxes, DropsWhenFull)
+{
+  WebSocketOutboxes outboxes;
+  const mg_connection* conn = GetConnection(0);
+  outboxes.AddConnection(conn);
+
+  const int kNumMessages = WebSocketOutboxes::kMaxQueuedMessages + 10;
+  for( int i = 0; i < kNumMessages; ++i ) {
+    outboxes.Push(conn, MakeMessage(i));
+  }
+  EXPECT_EQ(WebSocketOutboxes::kMaxQueuedMessages, outboxes.GetNumQueued(conn));
+  EXPECT_EQ(10, outboxes.GetNumDropped(conn));
+
+  // Snapshots still get in, replacing an older unsent snapshot of the same module
+  outboxes.Push(conn, MakeMessage(-1, "navmap"));
+  outboxes.Push(conn, MakeMessage(-2, "navmap"));
+  EXPECT_EQ(WebSocketOutboxes::kMaxQueuedMessages + 1, outboxes.GetNumQueued(conn));
+
+  // The newest messages are the ones dropped
+  const std::vector<int> values = Drain(outboxes, conn);
+  ASSERT_EQ(WebSocketOutboxes::kMaxQueuedMessages + 1, values.size());
+  for( size_t i = 0; i < WebSocketOutboxes::kMaxQueuedMessages; ++i ) {
+    EXPECT_EQ((int)i, values[i]);
+  }
+  EXPECT_EQ(-2, values.back());
+
+  // Counting starts over once the client has caught up
+  EXPECT_EQ(0, outboxes.GetNumDropped(conn));
+  EXPECT_TRUE(outboxes.Push(conn, MakeMessage(0)));
+  EXPECT_EQ(1, outboxes.GetNumQueued(conn));
+}
+
+TEST(WebSocketOutboxes, DisconnectWhileQueued)
+{
+  WebSocketOutboxes outboxes;
+  const mg_connection* conn1 = GetConnection(0);
+  const mg_connection* conn2 = GetConnection(1);
+  outboxes.AddConnection(conn1);
+  outboxes.AddConnection(conn2);
+
+  const auto message = MakeMessage(1);
+  EXPECT_TRUE(outboxes.Push(conn1, message));
+  EXPECT_TRUE(outboxes.Push(conn2, message));
+  EXPECT_EQ(3, message.use_count());
+
+  // The drain scheduled for conn1 runs after it closed, it writes nothing and the queued message is released
+  outboxes.RemoveConnection(conn1);
+  EXPECT_EQ(2, message.use_count());
+  EXPECT_TRUE(Drain(outboxes, conn1).empty());
+  EXPECT_FALSE(outboxes.Push(conn1, MakeMessage(2)));
+  EXPECT_EQ(0, outboxes.GetNumQueued(conn1));
+
+  // Closing mid-drain stops it after the message being written
+  EXPECT_FALSE(outboxes.Push(conn2, MakeMessage(2)));
+  EXPECT_FALSE(outboxes.Push(conn2, MakeMessage(3)));
+  std::vector<int> values;
+  outboxes.Drain(conn2, [&outboxes, &values, conn2](const std::string& str) {
+    Json::Reader reader;
+    Json::Value payload;
+    reader.parse(str, payload);
+    values.push_back(payload["value"].asInt());
+    outboxes.RemoveConnection(conn2);
+  });
+  EXPECT_EQ((std::vector<int>{1}), values);
+  EXPECT_EQ(1, message.use_count());
+
+  // A new connection that reuses the pointer starts out empty
+  outboxes.AddConnection(conn2);
+  EXPECT_EQ(0, outboxes.GetNumQueued(conn2));
+  EXPECT_TRUE(outboxes.Push(conn2, MakeMessage(4)));
+  EXPECT_EQ((std::vector<int>{4}), Drain(outboxes, conn2));
+}
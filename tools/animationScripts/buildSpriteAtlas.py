@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+"""
+Builds the pre-decoded sprite atlas that Vision::SpriteAtlas memory maps at boot, so that
+sprites don't have to be decoded from PNG while animations are playing.
+
+Every PNG under the given sprite directories is stored with its path relative to the resources
+directory, as raw 8 bit gray (grayscale PNGs) or RGBA8888 with opaque alpha (everything else,
+matching how the engine loads color sprites). PNGs that can't be converted exactly are left out,
+and are still decoded on demand.
+
+Example:
+  buildSpriteAtlas.py --resources-dir _build/vicos/Release/data/assets/cozmo_resources
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+from PIL import Image
+
+# Must match Vision::SpriteAtlas::kFormatVersion and the layout described in spriteAtlas.h
+FORMAT_VERSION = 1
+MAGIC = b"AKSA"
+HEADER_FORMAT = "<4sIII"
+ENTRY_FORMAT = "<IIQQiiII"
+PIXEL_DATA_ALIGNMENT = 16
+
+FORMAT_GRAY8 = 0
+FORMAT_RGBA8888 = 1
+
+DEFAULT_SPRITE_DIRS = [
+    "assets/sprites/independentSprites",
+    "assets/sprites/spriteSequences",
+    "config/devOnlySprites/independentSprites",
+    "config/devOnlySprites/spriteSequences",
+]
+
+DEFAULT_OUTPUT = "assets/sprites/spriteAtlas.bin"
+
+
+def decode_sprite(full_path):
+    "Returns (format, rows, cols, pixel bytes), or None if the sprite should be left as a PNG"
+    img = Image.open(full_path)
+    if img.mode in ("L", "LA"):
+        gray = img.convert("L") if img.mode == "LA" else img
+        return FORMAT_GRAY8, gray.height, gray.width, gray.tobytes()
+    if img.mode in ("RGB", "RGBA", "P"):
+        rgba = img.convert("RGB").convert("RGBA")
+        return FORMAT_RGBA8888, rgba.height, rgba.width, rgba.tobytes()
+    return None
+
+
+def find_sprites(resources_dir, sprite_dirs):
+    "Yields paths of all PNGs, relative to resources_dir"
+    for sprite_dir in sprite_dirs:
+        for root, _, files in os.walk(os.path.join(resources_dir, sprite_dir)):
+            for file_name in files:
+                if file_name.lower().endswith(".png"):
+                    yield os.path.relpath(os.path.join(root, file_name), resources_dir)
+
+
+def build_atlas(resources_dir, sprite_dirs):
+    sprites = []
+    for rel_path in find_sprites(resources_dir, sprite_dirs):
+        full_path = os.path.join(resources_dir, rel_path)
+        decoded = decode_sprite(full_path)
+        if decoded is None:
+            print("Skipping %s (unsupported mode)" % rel_path)
+            continue
+        sprites.append((rel_path.replace(os.sep, "/").encode("utf-8"), os.path.getsize(full_path), decoded))
+
+    # Entries are binary searched by path
+    sprites.sort(key=lambda sprite: sprite[0])
+
+    num_entries = len(sprites)
+    path_offset = struct.calcsize(HEADER_FORMAT) + num_entries * struct.calcsize(ENTRY_FORMAT)
+    data_offset = path_offset + sum(len(sprite[0]) for sprite in sprites)
+
+    entries = bytearray()
+    paths = bytearray()
+    pixel_data = bytearray()
+    for path, file_size, (pixel_format, rows, cols, pixels) in sprites:
+        padding = -(data_offset + len(pixel_data)) % PIXEL_DATA_ALIGNMENT
+        pixel_data += b"\0" * padding
+        entries += struct.pack(ENTRY_FORMAT, path_offset + len(paths), len(path), file_size,
+                               data_offset + len(pixel_data), rows, cols, pixel_format, 0)
+        paths += path
+        pixel_data += pixels
+
+    header = struct.pack(HEADER_FORMAT, MAGIC, FORMAT_VERSION, num_entries, 0)
+    return num_entries, header + bytes(entries) + bytes(paths) + bytes(pixel_data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build the pre-decoded sprite atlas")
+    parser.add_argument("--resources-dir", required=True,
+                        help="resources directory that sprite paths are relative to")
+    parser.add_argument("--sprite-dir", action="append", dest="sprite_dirs",
+                        help="directory of sprites, relative to the resources dir (repeatable)")
+    parser.add_argument("--output", default=None,
+                        help="atlas file to write (default: <resources-dir>/%s)" % DEFAULT_OUTPUT)
+    args = parser.parse_args()
+
+    sprite_dirs = args.sprite_dirs or DEFAULT_SPRITE_DIRS
+    output = args.output or os.path.join(args.resources_dir, DEFAULT_OUTPUT)
+
+    num_entries, atlas = build_atlas(args.resources_dir, sprite_dirs)
+
+    tmp_output = output + ".tmp"
+    with open(tmp_output, "wb") as f:
+        f.write(atlas)
+    os.replace(tmp_output, output)
+
+    print("Wrote %d sprites (%d bytes) to %s" % (num_entries, len(atlas), output))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -24,6 +24,7 @@
 #endif
 
 #include "coretech/common/engine/utils/data/dataPlatform.h"
+#include "util/cpuProfiler/cpuTraceRecorder.h"
 #include "util/logging/logging.h"
 #include "util/console/consoleSystem.h"
 #include "util/console/consoleChannel.h"
@@ -723,6 +724,37 @@ static int GetPerfStats(struct mg_connection *conn, void *cbdata)
 }
 
 
+#if ANKI_CPU_PROFILER_ENABLED
+// Starts (?start) or stops (?stop) a CpuProfiler trace capture in this process, and replies with the capture status.
+// Captures from each process go to the same directory and share a clock, so they can be loaded side by side.
+static int TraceCapture(struct mg_connection *conn, void *cbdata)
+{
+  const struct mg_request_info* info = mg_get_request_info(conn);
+  const std::string query = (info->query_string != nullptr) ? info->query_string : "";
+
+  Anki::Util::CpuTraceRecorder& traceRecorder = Anki::Util::CpuTraceRecorder::GetInstance();
+  if (query == "start") {
+    traceRecorder.StartCapture();
+  }
+  else if (query == "stop") {
+    traceRecorder.StopCapture();
+  }
+
+  mg_printf(conn,
+            "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nConnection: "
+            "close\r\n\r\n");
+
+  Json::Value status;
+  status["capturing"] = traceRecorder.IsCapturing();
+  status["directory"] = traceRecorder.GetDirectory();
+  std::stringstream ss;
+  ss << status;
+  mg_printf(conn, "%s", ss.str().c_str());
+  return 1;
+}
+#endif // ANKI_CPU_PROFILER_ENABLED
+
+
 #ifndef SIMULATOR
 
 static int SystemCtl(struct mg_connection *conn, void *cbdata)
@@ -971,6 +1003,9 @@ void WebService::Start(Anki::Util::Data::DataPlatform* platform, const Json::Val
   mg_set_request_handler(_ctx, "/getinitialconfig", GetInitialConfig, 0);
   mg_set_request_handler(_ctx, "/getmainrobotinfo", GetMainRobotInfo, 0);
   mg_set_request_handler(_ctx, "/getperfstats", GetPerfStats, 0);
+#if ANKI_CPU_PROFILER_ENABLED
+  mg_set_request_handler(_ctx, "/tracecapture", TraceCapture, 0);
+#endif
 #ifndef SIMULATOR
   mg_set_request_handler(_ctx, "/systemctl", SystemCtl, 0);
   mg_set_request_handler(_ctx, "/getprocessstatus", GetProcessStatus, 0);
@@ -1237,6 +1272,18 @@ void WebService::Stop()
 #endif
   }
   _ctx = nullptr;
+
+  // take the queue first so that nothing more is queued, then stop it without holding the lock, since the
+  // sender thread needs it to finish what it is doing
+  Util::Dispatch::Queue* dispatchQueue = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(s_wsConnectionsMutex);
+    std::swap(dispatchQueue, _dispatchQueue);
+  }
+  if (dispatchQueue != nullptr) {
+    Util::Dispatch::Stop(dispatchQueue);
+    Util::Dispatch::Release(dispatchQueue);
+  }
 }
 
 
@@ -1476,18 +1523,49 @@ void WebService::GenerateConsoleVarsUI(std::string& page, const std::string& cat
 
 
 void WebService::SendToWebSockets(const std::string& moduleName, const Json::Value& data) const
+{
+  // don't copy data unless there is >= 1 client for this module
+  if( IsWebVizClientSubscribed( moduleName ) ) {
+    auto message = std::make_shared<WebSocketOutboxes::Message>();
+    message->payloads.resize(1);
+    message->payloads[0]["module"] = moduleName;
+    message->payloads[0]["data"] = data;
+    SendToSubscribers(moduleName, message);
+  }
+}
+
+void WebService::SendToWebSockets(const std::string& moduleName, Json::Value&& data) const
+{
+  if( IsWebVizClientSubscribed( moduleName ) ) {
+    auto message = std::make_shared<WebSocketOutboxes::Message>();
+    message->payloads.resize(1);
+    message->payloads[0]["module"] = moduleName;
+    message->payloads[0]["data"] = std::move(data);
+    SendToSubscribers(moduleName, message);
+  }
+}
+
+void WebService::SendSnapshotToWebViz(const std::string& moduleName, std::vector<Json::Value>&& messages) const
+{
+  if( IsWebVizClientSubscribed( moduleName ) ) {
+    auto message = std::make_shared<WebSocketOutboxes::Message>();
+    message->snapshotModule = moduleName;
+    message->payloads.resize(messages.size());
+    for( size_t i = 0; i < messages.size(); ++i ) {
+      message->payloads[i]["module"] = moduleName;
+      message->payloads[i]["data"] = std::move(messages[i]);
+    }
+    SendToSubscribers(moduleName, message);
+  }
+  messages.clear();
+}
+
+void WebService::SendToSubscribers(const std::string& moduleName, const WebSocketOutboxes::MessagePtr& message) const
 {
   std::lock_guard<std::mutex> lock(s_wsConnectionsMutex);
-  Json::Value payload;
-  bool hasAssigned = false; // don't copy payload unless there is >= 1 client for this module
   for( const auto& connData : _webSocketConnections ) {
     if( connData.subscribedModules.find( moduleName ) != connData.subscribedModules.end() ) {
-      if( !hasAssigned ) {
-        payload["module"] = moduleName;
-        payload["data"] = data;
-        hasAssigned = true;
-      }
-      SendToWebSocket(connData.conn, payload);
+      Enqueue(connData.conn, message);
     }
   }
 }
@@ -1568,17 +1646,27 @@ void WebService::HandleWebSocketsClose(const struct mg_connection* conn, void* c
 }
 
 
-// This is always called in the main thread (whether we're sending or receiving)
+// the caller must hold s_wsConnectionsMutex
 void WebService::SendToWebSocket(struct mg_connection* conn, const Json::Value& data) const
 {
-  // Dispatch work onto another thread (note we copy 'data' by value here)
-  Util::Dispatch::Async(_dispatchQueue, [conn, data] {
-    std::stringstream ss;
-    ss << data;
-    const std::string& str = ss.str();
+  auto message = std::make_shared<WebSocketOutboxes::Message>();
+  message->payloads.push_back(data);
+  Enqueue(conn, message);
+}
 
-    mg_websocket_write(conn, WebSocketsTypeText, str.c_str(), str.size());
-  });
+void WebService::Enqueue(struct mg_connection* conn, const WebSocketOutboxes::MessagePtr& message) const
+{
+  if( _dispatchQueue == nullptr ) {
+    return; // stopped
+  }
+
+  if( _outboxes.Push(conn, message) ) {
+    Util::Dispatch::Async(_dispatchQueue, [this, conn] {
+      _outboxes.Drain(conn, [conn](const std::string& str) {
+        mg_websocket_write(conn, WebSocketsTypeText, str.c_str(), str.size());
+      });
+    });
+  }
 }
 
 
@@ -1594,6 +1682,7 @@ void WebService::OnOpenWebSocket(struct mg_connection* conn)
   std::lock_guard<std::mutex> lock(s_wsConnectionsMutex);
   _webSocketConnections.push_back({});
   _webSocketConnections.back().conn = conn;
+  _outboxes.AddConnection(conn);
 }
 
 void WebService::OnReceiveWebSocket(struct mg_connection* conn, const Json::Value& data)
@@ -1660,6 +1749,9 @@ void WebService::OnCloseWebSocket(const struct mg_connection* conn)
   auto& data = *it;
   std::swap(data, _webSocketConnections.back());
   _webSocketConnections.pop_back();
+
+  // anything still queued for it is dropped, and a drain that is running stops writing to it
+  _outboxes.RemoveConnection(conn);
 }
 
 } // namespace WebService
@@ -1696,6 +1788,14 @@ namespace WebService {
   {
   }
 
+  void WebService::SendToWebSockets(const std::string& /*moduleName*/, Json::Value&& /*data*/) const
+  {
+  }
+
+  void WebService::SendSnapshotToWebViz(const std::string& /*moduleName*/, std::vector<Json::Value>&& /*messages*/) const
+  {
+  }
+
   bool WebService::IsWebVizClientSubscribed(const std::string& /*moduleName*/) const
   {
     return false;
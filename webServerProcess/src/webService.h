@@ -16,6 +16,7 @@
 #include "civetweb/include/civetweb.h"
 
 #include "json/json.h"
+#include "webSocketOutboxes.h"
 
 #include <string>
 #include <vector>
@@ -60,10 +61,18 @@ public:
   void Update();
   void Stop();
   
-  // send data to any client subscribed to moduleName
+  // send data to any client subscribed to moduleName. This only queues the data: it is encoded and written to
+  // each client by the sender thread, so it is cheap enough to call from the engine tick
   void SendToWebSockets(const std::string& moduleName, const Json::Value& data) const;
+  void SendToWebSockets(const std::string& moduleName, Json::Value&& data) const;
   
   inline void SendToWebViz(const std::string& moduleName, const Json::Value& data) const { SendToWebSockets(moduleName, data); }
+  inline void SendToWebViz(const std::string& moduleName, Json::Value&& data) const { SendToWebSockets(moduleName, std::move(data)); }
+  
+  // for modules that send their complete state every time (e.g. the nav map): the messages are sent together,
+  // and replace any earlier snapshot of moduleName that a client hasn't received yet, so that a client that
+  // can't keep up skips stale states instead of falling further and further behind
+  void SendSnapshotToWebViz(const std::string& moduleName, std::vector<Json::Value>&& messages) const;
   
   // returns true if a client has subscribed to a given module name (or any module if empty)
   bool IsWebVizClientSubscribed(const std::string& moduleName = {}) const;
@@ -163,6 +172,9 @@ private:
   void OnCloseWebSocket(const struct mg_connection* conn);
 
   void SendToWebSocket(struct mg_connection* conn, const Json::Value& data) const;
+  void SendToSubscribers(const std::string& moduleName, const WebSocketOutboxes::MessagePtr& message) const;
+  // the caller must hold s_wsConnectionsMutex, which also guards _dispatchQueue
+  void Enqueue(struct mg_connection* conn, const WebSocketOutboxes::MessagePtr& message) const;
 
   // todo: OTA update somehow?
 
@@ -171,6 +183,9 @@ private:
   std::vector<WebSocketConnectionData> _webSocketConnections;
   mutable std::mutex s_wsConnectionsMutex;
 
+  // mutable because sending (which is const) queues messages in the outboxes
+  mutable WebSocketOutboxes _outboxes;
+
   std::string _consoleVarsUIHTMLTemplate;
 
   std::vector<Request*> _requests;
@@ -0,0 +1,127 @@
+/**
+ * File: webSocketOutboxes.cpp
+ *
+ * Description: Messages waiting to be written to each websocket client
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#include "webSocketOutboxes.h"
+
+#include "util/logging/logging.h"
+
+#include <algorithm>
+
+#define LOG_CHANNEL "WebService"
+
+namespace Anki {
+namespace Vector {
+namespace WebService {
+
+constexpr size_t WebSocketOutboxes::kMaxQueuedMessages;
+
+void WebSocketOutboxes::AddConnection(const mg_connection* conn)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _outboxes[conn] = Outbox();
+}
+
+void WebSocketOutboxes::RemoveConnection(const mg_connection* conn)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _outboxes.erase(conn);
+}
+
+bool WebSocketOutboxes::Push(const mg_connection* conn, const MessagePtr& message)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _outboxes.find(conn);
+  if( it == _outboxes.end() ) {
+    return false; // closed
+  }
+
+  Outbox& outbox = it->second;
+  auto& messages = outbox.messages;
+  if( !message->snapshotModule.empty() ) {
+    // the client hasn't received the previous snapshot yet, so it never will
+    messages.erase(std::remove_if(messages.begin(), messages.end(), [&message](const MessagePtr& queued) {
+      return queued->snapshotModule == message->snapshotModule;
+    }), messages.end());
+  }
+  else if( messages.size() >= kMaxQueuedMessages ) {
+    if( outbox.numDropped++ == 0 ) {
+      LOG_WARNING("WebSocketOutboxes.Push.ClientNotKeepingUp",
+                  "Dropping messages until a websocket client catches up with %zu queued messages",
+                  messages.size());
+    }
+    return false;
+  }
+  messages.push_back(message);
+
+  // a running Drain takes everything queued, so it only needs scheduling when there isn't one
+  if( outbox.isDraining ) {
+    return false;
+  }
+  outbox.isDraining = true;
+  return true;
+}
+
+void WebSocketOutboxes::Drain(const mg_connection* conn, const WriteFunc& writeFunc)
+{
+  Json::FastWriter writer;
+  writer.omitEndingLineFeed();
+
+  while( true ) {
+    MessagePtr message;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      auto it = _outboxes.find(conn);
+      if( it == _outboxes.end() ) {
+        return; // closed
+      }
+      Outbox& outbox = it->second;
+      if( outbox.messages.empty() ) {
+        if( outbox.numDropped > 0 ) {
+          LOG_INFO("WebSocketOutboxes.Drain.ClientCaughtUp", "Dropped %zu messages", outbox.numDropped);
+          outbox.numDropped = 0;
+        }
+        outbox.isDraining = false;
+        return;
+      }
+      message = std::move(outbox.messages.front());
+      outbox.messages.pop_front();
+    }
+
+    // encode once for every client that the message is sent to. Compact, since the larger styled json was
+    // a good part of the cost of writing to clients
+    if( message->encoded.empty() ) {
+      message->encoded.reserve(message->payloads.size());
+      for( const auto& payload : message->payloads ) {
+        message->encoded.push_back(writer.write(payload));
+      }
+    }
+
+    for( const auto& str : message->encoded ) {
+      writeFunc(str);
+    }
+  }
+}
+
+size_t WebSocketOutboxes::GetNumQueued(const mg_connection* conn) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _outboxes.find(conn);
+  return (it == _outboxes.end() ? 0 : it->second.messages.size());
+}
+
+size_t WebSocketOutboxes::GetNumDropped(const mg_connection* conn) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _outboxes.find(conn);
+  return (it == _outboxes.end() ? 0 : it->second.numDropped);
+}
+
+} // namespace WebService
+} // namespace Vector
+} // namespace Anki
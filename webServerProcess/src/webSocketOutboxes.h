@@ -0,0 +1,80 @@
+/**
+ * File: webSocketOutboxes.h
+ *
+ * Description: Messages waiting to be written to each websocket client. WebService queues messages from whatever
+ *              thread sends them, and its sender thread drains each client's outbox in order, so a slow client
+ *              only holds up its own messages. Full outboxes drop messages instead of growing without bound.
+ *
+ * Copyright: Anki, Inc. 2026
+ *
+ **/
+
+#ifndef __WebServerProcess_Src_WebSocketOutboxes_H__
+#define __WebServerProcess_Src_WebSocketOutboxes_H__
+
+#include "json/json.h"
+#include "util/helpers/noncopyable.h"
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct mg_connection;
+
+namespace Anki {
+namespace Vector {
+namespace WebService {
+
+class WebSocketOutboxes : private Util::noncopyable
+{
+public:
+
+  // One or more payloads queued for clients, shared by all the clients it is sent to
+  struct Message {
+    std::string snapshotModule; // set for snapshots, which replace older unsent snapshots of the same module
+    std::vector<Json::Value> payloads;
+    mutable std::vector<std::string> encoded; // encoded lazily, only ever touched by the thread draining
+  };
+  using MessagePtr = std::shared_ptr<const Message>;
+
+  // Messages queued for a client that isn't keeping up, after which further (non-snapshot) messages are dropped
+  static constexpr size_t kMaxQueuedMessages = 256;
+
+  void AddConnection(const mg_connection* conn);
+
+  // Drops anything still queued for conn. A Drain that is running or scheduled for conn writes nothing more
+  void RemoveConnection(const mg_connection* conn);
+
+  // Queues message for conn. Returns true if the caller needs to schedule a Drain of conn, i.e. one isn't already
+  // running or scheduled
+  bool Push(const mg_connection* conn, const MessagePtr& message);
+
+  // Encodes and writes everything queued for conn, in order, including anything pushed while draining. Only call
+  // it from one thread at a time
+  using WriteFunc = std::function<void(const std::string& str)>;
+  void Drain(const mg_connection* conn, const WriteFunc& writeFunc);
+
+  size_t GetNumQueued(const mg_connection* conn) const;
+  size_t GetNumDropped(const mg_connection* conn) const;
+
+private:
+
+  struct Outbox {
+    std::deque<MessagePtr> messages;
+    bool isDraining = false; // a Drain is running or scheduled
+    size_t numDropped = 0;   // messages dropped since the outbox last overflowed
+  };
+
+  mutable std::mutex _mutex;
+  std::unordered_map<const mg_connection*, Outbox> _outboxes;
+};
+
+} // namespace WebService
+} // namespace Vector
+} // namespace Anki
+
+#endif // __WebServerProcess_Src_WebSocketOutboxes_H__
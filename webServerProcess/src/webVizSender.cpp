@@ -35,7 +35,7 @@ WebVizSender::~WebVizSender()
 #if !ANKI_NO_WEBSERVER_ENABLED
   DEV_ASSERT(_webService != nullptr, "WebVizSender.Dtor.NullWebService");
   if( !_data.empty() ) {
-    _webService->SendToWebViz(_module, _data);
+    _webService->SendToWebViz(_module, std::move(_data));
   }
 #endif
 }